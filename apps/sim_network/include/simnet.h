@@ -0,0 +1,177 @@
+/**
+********************************************************************************
+\file   simnet.h
+
+\brief  Definitions for the network simulator
+
+This file contains the definitions of the discrete-event network simulator. The
+simulator implements the function tables of the simulation interface and runs
+an MN and a number of CNs in a single process on virtual time.
+
+\ingroup module_sim_network
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2017, B&R Industrial Automation GmbH
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+#ifndef _INC_simnet_H_
+#define _INC_simnet_H_
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <sim.h>
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define SIMNET_MAX_NODE_ID                  254             ///< Highest node ID which can be simulated
+
+#define SIMNET_TIME_US                      1000ULL         ///< One microsecond of virtual time
+#define SIMNET_TIME_MS                      1000000ULL      ///< One millisecond of virtual time
+#define SIMNET_TIME_S                       1000000000ULL   ///< One second of virtual time
+
+//------------------------------------------------------------------------------
+// typedef
+//------------------------------------------------------------------------------
+/// Virtual time of the simulation [ns]
+typedef UINT64 tSimNetTime;
+
+/**
+\brief Link parameters
+
+The structure describes the link between a node and the simulated hub or
+switch. A frame passes the link of the sender and the link of every receiver.
+*/
+typedef struct
+{
+    UINT32              delay;                  ///< Propagation delay of the link [ns]
+    UINT32              jitter;                 ///< Maximum random delay added to each frame [ns]
+    UINT32              lossPpm;                ///< Probability that a frame is lost on the link [ppm]
+} tSimNetLinkParam;
+
+/**
+\brief Simulator parameters
+*/
+typedef struct
+{
+    UINT64              seed;                   ///< Seed of the pseudo random number generator
+    UINT32              processInterval;        ///< Interval of the background processing of idle nodes [ns]
+    BOOL                fRxFilter;              ///< Deliver only frames which match the Rx filters of a node
+    BOOL                fSwitch;                ///< Connect the nodes by a store-and-forward switch instead of a hub
+    BOOL                fTrace;                 ///< Print the debug traces of the stacks
+    const char*         pTempDir;               ///< Directory for the private module copies (NULL = /tmp)
+} tSimNetParam;
+
+/**
+\brief Node parameters
+*/
+typedef struct
+{
+    UINT                nodeId;                 ///< POWERLINK node ID (C_ADR_MN_DEF_NODE_ID for the MN)
+    const char*         pModuleFile;            ///< File name of the node module
+    const char*         pCdcFile;               ///< Concise device configuration file (MN only, may be NULL)
+    UINT32              cycleLen;               ///< Cycle length [us]
+    UINT                sdoWindowSize;          ///< SDO sequence layer window size (0 = stack default)
+    tSimNetLinkParam    linkParam;              ///< Link parameters of the node
+} tSimNetNodeParam;
+
+/**
+\brief Node statistics
+*/
+typedef struct
+{
+    tNmtState           nmtState;               ///< Current NMT state
+    tSimNetTime         operationalTime;        ///< Virtual time the node became operational (0 = never)
+    UINT64              txFrameCount;           ///< Number of transmitted frames
+    UINT64              txByteCount;            ///< Number of transmitted bytes
+    UINT64              asyncTxFrameCount;      ///< Number of transmitted ASnd and non-POWERLINK frames
+    UINT64              asyncTxByteCount;       ///< Number of transmitted ASnd and non-POWERLINK bytes
+    UINT64              ethTxFrameCount;        ///< Number of transmitted non-POWERLINK frames
+    UINT64              ethTxByteCount;         ///< Number of transmitted non-POWERLINK bytes
+    UINT64              rxFrameCount;           ///< Number of received frames
+    UINT64              rxByteCount;            ///< Number of received bytes
+    UINT64              filteredFrameCount;     ///< Number of frames discarded by the Rx filters
+    UINT64              lostFrameCount;         ///< Number of frames lost on the link of the node
+    UINT64              dispatchCount;          ///< Number of calls into the stack of the node
+    UINT64              cpuTime;                ///< Host CPU time spent in the stack of the node [ns]
+    UINT64              sdoTransferCount;       ///< Number of SDO transfers of the node finished successfully
+    UINT64              sdoAbortCount;          ///< Number of SDO transfers of the node which failed
+    UINT64              sdoByteCount;           ///< Number of bytes transferred by the finished SDO transfers
+    UINT32              sdoAbortCode;           ///< Abort code of the last failed SDO transfer
+} tSimNetNodeStatistics;
+
+/**
+\brief Simulator statistics
+*/
+typedef struct
+{
+    tSimNetTime         time;                   ///< Current virtual time
+    tSimNetTime         startTime;              ///< Virtual time of the last statistics reset
+    UINT64              eventCount;             ///< Number of processed simulation events
+    UINT64              frameCount;             ///< Number of frames sent to the network
+    UINT64              cycleCount;             ///< Number of SoC frames sent to the network
+    UINT64              asyncFrameCount;        ///< Number of ASnd and non-POWERLINK frames sent to the network
+    UINT64              asyncByteCount;         ///< Number of ASnd and non-POWERLINK bytes sent to the network
+    UINT64              cpuTime;                ///< Host CPU time spent in the stacks of all nodes [ns]
+} tSimNetStatistics;
+
+//------------------------------------------------------------------------------
+// function prototypes
+//------------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+tOplkError  simnet_init(const tSimNetParam* pParam_p);
+void        simnet_exit(void);
+tOplkError  simnet_addNode(const tSimNetNodeParam* pNodeParam_p);
+tOplkError  simnet_setLinkParam(UINT nodeId_p,
+                                const tSimNetLinkParam* pLinkParam_p);
+tOplkError  simnet_run(tSimNetTime duration_p);
+tSimNetTime simnet_getTime(void);
+BOOL        simnet_isOperational(void);
+tOplkError  simnet_getNodeStatistics(UINT nodeId_p,
+                                     tSimNetNodeStatistics* pStatistics_p);
+void        simnet_getStatistics(tSimNetStatistics* pStatistics_p);
+void        simnet_resetStatistics(void);
+tOplkError  simnet_writeObject(UINT nodeId_p,
+                               UINT targetNodeId_p,
+                               UINT index_p,
+                               UINT subindex_p,
+                               void* pData_p,
+                               UINT size_p);
+BOOL        simnet_isSdoRunning(UINT nodeId_p);
+tOplkError  simnet_sendEthFrame(UINT nodeId_p,
+                                const void* pFrame_p,
+                                UINT size_p);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _INC_simnet_H_ */
@@ -0,0 +1,136 @@
+/**
+********************************************************************************
+\file   simnode.h
+
+\brief  Definitions for the simulated node module
+
+This file contains the definitions of the interface between the network
+simulator and a simulated node. A simulated node is a shared module which
+contains a complete openPOWERLINK stack built for the simulation interface
+together with its object dictionary. The network simulator loads a private
+copy of the module for every node, therefore every node gets its own set of
+stack instance variables.
+
+\ingroup module_sim_network
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2017, B&R Industrial Automation GmbH
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+#ifndef _INC_simnode_H_
+#define _INC_simnode_H_
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <sim.h>
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define SIMNODE_FUNC_INIT                   "simnode_init"
+#define SIMNODE_FUNC_EXIT                   "simnode_exit"
+#define SIMNODE_FUNC_PROCESS                "simnode_process"
+#define SIMNODE_FUNC_USER_TIMER_CALLBACK    "simnode_userTimerCallback"
+#define SIMNODE_FUNC_WRITE_OBJECT           "simnode_writeObject"
+#define SIMNODE_FUNC_SEND_ETH_FRAME         "simnode_sendEthFrame"
+
+//------------------------------------------------------------------------------
+// typedef
+//------------------------------------------------------------------------------
+/**
+\brief Simulated node initialization parameters
+
+The structure contains the parameters which are passed to a simulated node
+when its stack is initialized.
+*/
+typedef struct
+{
+    tSimulationInstanceHdl  simHdl;                 ///< Handle of the simulated stack instance
+    UINT                    nodeId;                 ///< POWERLINK node ID
+    UINT8                   aMacAddr[6];            ///< MAC address of the node
+    UINT32                  cycleLen;               ///< Cycle length [us]
+    const char*             pCdcFile;               ///< Concise device configuration file (MN only, may be NULL)
+    UINT                    sdoWindowSize;          ///< SDO sequence layer window size (0 = stack default)
+    tEdrvFunctions          edrvFunctions;          ///< Ethernet driver functions of the simulator
+    tHresTimerFunctions     hresTimerFunctions;     ///< High-resolution timer functions of the simulator
+    tTimerFunctions         timerFunctions;         ///< User timer functions of the simulator
+    tTargetFunctions        targetFunctions;        ///< Target functions of the simulator
+    tTraceFunctions         traceFunctions;         ///< Trace functions of the simulator
+    tApiEventFunctions      apiEventFunctions;      ///< API event functions of the simulator
+    tProcessSyncFunctions   processSyncFunctions;   ///< Process sync functions of the simulator
+} tSimNodeInitParam;
+
+/// Function type of \ref simnode_init
+typedef tOplkError (*tSimNodeInitFunc)(const tSimNodeInitParam* pInitParam_p);
+
+/// Function type of \ref simnode_exit
+typedef void (*tSimNodeExitFunc)(void);
+
+/// Function type of \ref simnode_process
+typedef tOplkError (*tSimNodeProcessFunc)(void);
+
+/// Function type of \ref simnode_userTimerCallback
+typedef void (*tSimNodeUserTimerCallbackFunc)(tTimerHdl timerHdl_p,
+                                              tTimerArg argument_p);
+
+/// Function type of \ref simnode_writeObject
+typedef tOplkError (*tSimNodeWriteObjectFunc)(UINT nodeId_p,
+                                              UINT index_p,
+                                              UINT subindex_p,
+                                              void* pData_p,
+                                              UINT size_p);
+
+/// Function type of \ref simnode_sendEthFrame
+typedef tOplkError (*tSimNodeSendEthFrameFunc)(const void* pFrame_p,
+                                               UINT size_p);
+
+//------------------------------------------------------------------------------
+// function prototypes
+//------------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+tOplkError simnode_init(const tSimNodeInitParam* pInitParam_p);
+void       simnode_exit(void);
+tOplkError simnode_process(void);
+void       simnode_userTimerCallback(tTimerHdl timerHdl_p,
+                                     tTimerArg argument_p);
+tOplkError simnode_writeObject(UINT nodeId_p,
+                               UINT index_p,
+                               UINT subindex_p,
+                               void* pData_p,
+                               UINT size_p);
+tOplkError simnode_sendEthFrame(const void* pFrame_p,
+                                UINT size_p);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _INC_simnode_H_ */
@@ -0,0 +1,1036 @@
+/**
+********************************************************************************
+\file   main.c
+
+\brief  Main file of the network simulation runner
+
+This file contains the main file of the network simulation runner. It sets up
+an MN and a number of CNs in the network simulator, boots the network on
+virtual time and measures the boot time, the host CPU time per POWERLINK cycle
+and the asynchronous throughput. As the simulation runs on virtual time with a
+seeded pseudo random number generator, the virtual times of two runs with the
+same parameters are identical.
+
+\ingroup module_sim_network
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2017, B&R Industrial Automation GmbH
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <simnet.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define DEFAULT_MN_MODULE           "./simnode-mn.so"
+#define DEFAULT_CN_MODULE           "./simnode-cn.so"
+#define DEFAULT_CDC_FILE            "mnobd.cdc"
+#define DEFAULT_NODES               "1,32,110"
+#define DEFAULT_CYCLE_LEN           50000       // [us], as configured by the default CDC
+#define DEFAULT_BOOT_TIMEOUT        60          // [s]
+#define DEFAULT_MEASURE_TIME        10          // [s]
+#define DEFAULT_PROCESS_INTERVAL    1000000     // [ns]
+
+#define MN_NODE_ID                  0xF0        // C_ADR_MN_DEF_NODE_ID
+#define SDO_OBJECT_INDEX            0x1F22      // Concise DCF of the MN, accepts domains of any size
+#define SDO_POLL_INTERVAL           (100 * SIMNET_TIME_US)
+#define ETH_POLL_INTERVAL           (100 * SIMNET_TIME_US)
+#define ETH_ETHERTYPE               0x88B5      // IEEE 802 local experimental EtherType
+#define ETH_HEADER_SIZE             14
+#define ETH_MAX_FRAME_SIZE          1514        // C_DLL_MAX_ETH_FRAME
+
+// Parameters of the generated CDC, they match the Demo_3CN project
+#define CDC_MAX_SIZE                ((SIMNET_MAX_NODE_ID + 1) * 512)
+#define CDC_MN_PDO_CHANNELS         40          // PDO channels of the CiA302-4_MN object dictionary
+#define CDC_MN_RX_INDEX             0xA4C0      // UNSIGNED8 array of the MN, mapped by the RPDOs
+#define CDC_MN_TX_INDEX             0xA040      // UNSIGNED8 array of the MN, mapped by the TPDOs
+#define CDC_CN_RX_INDEX             0x6200      // Digital outputs of the CiA401_CN
+#define CDC_CN_TX_INDEX             0x6000      // Digital inputs of the CiA401_CN
+#define CDC_CONF_DATE               0x00003124  // Configuration date (0x1F26 of the MN, 0x1020/1 of the CN)
+#define CDC_CONF_TIME               0x03735955  // Configuration time (0x1F27 of the MN, 0x1020/2 of the CN)
+#define CDC_NODE_ASSIGNMENT         0x00000007  // Node exists, is a CN, may be started
+#define CDC_NODE_ASSIGNMENT_VALID   0x80000007  // ... and its configuration is valid
+#define CDC_PRES_TIMEOUT            200000      // [ns]
+#define CDC_ASYNC_SLOT_TIMEOUT      500000      // [ns]
+#define CDC_LOSS_OF_FRAME_TOLERANCE 50000000    // [ns]
+#define CDC_PAYLOAD_LIMIT           36          // [byte]
+#define CDC_MN_CNT_THRESHOLD        0x28        // Error counter thresholds of the MN (0x1C02/3, 0x1C09)
+#define CDC_CN_CNT_THRESHOLD        0x50        // Error counter thresholds of the CN (0x1C0B/3, 0x1C0D/3)
+
+// PDO mapping entry of one UNSIGNED8 at offset 0
+#define CDC_MAPPING(index, subindex) \
+    ((UINT64)(index) | ((UINT64)(subindex) << 16) | ((UINT64)8 << 48))
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+typedef struct
+{
+    const char*         pMnModule;
+    const char*         pCnModule;
+    const char*         pCdcFile;
+    BOOL                fGenerateCdc;
+    BOOL                afCn[SIMNET_MAX_NODE_ID + 1];
+    UINT32              cycleLen;
+    tSimNetLinkParam    linkParam;
+    UINT64              seed;
+    UINT32              bootTimeout;
+    UINT32              measureTime;
+    UINT32              sdoSize;
+    UINT                sdoWindowSize;
+    UINT32              ethSize;
+    BOOL                fMeasureLoss;
+    UINT32              measureLossPpm;
+    BOOL                fRxFilter;
+    BOOL                fSwitch;
+    BOOL                fTrace;
+} tOptions;
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static int  getOptions(int argc_p,
+                       char* const argv_p[],
+                       tOptions* pOpts_p);
+static int  parseNodeList(const char* pList_p,
+                          BOOL* afCn_p);
+static int  generateCdc(const tOptions* pOpts_p);
+static UINT generateCnCdc(const tOptions* pOpts_p,
+                          UINT8* pCdc_p);
+static UINT8* writeCdcEntry(UINT8* pPos_p,
+                            UINT16 index_p,
+                            UINT8 subindex_p,
+                            UINT64 value_p,
+                            UINT32 size_p);
+static void writeLe(UINT8* pPos_p,
+                    UINT64 value_p,
+                    UINT size_p);
+static BOOL boot(const tOptions* pOpts_p);
+static void measure(const tOptions* pOpts_p);
+static void measureSdo(const tOptions* pOpts_p);
+static void measureEth(const tOptions* pOpts_p);
+static void printNodeStatistics(const tOptions* pOpts_p);
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Main function
+
+The function implements the main function of the network simulation runner.
+
+\param[in]      argc                Number of arguments
+\param[in]      argv                Pointer to argument strings
+
+\return Returns an exit code
+\retval 0                           Measurement finished
+\retval 1                           Setup failed or the network did not boot
+
+\ingroup module_sim_network
+*/
+//------------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+    tOplkError          ret;
+    tOptions            opts;
+    tSimNetParam        simParam;
+    tSimNetNodeParam    nodeParam;
+    UINT                nodeId;
+    int                 exitCode = 1;
+
+    if (getOptions(argc, argv, &opts) != 0)
+        return 1;
+
+    if (opts.fGenerateCdc && (generateCdc(&opts) != 0))
+        return 1;
+
+    memset(&simParam, 0, sizeof(simParam));
+    simParam.seed = opts.seed;
+    simParam.processInterval = DEFAULT_PROCESS_INTERVAL;
+    simParam.fRxFilter = opts.fRxFilter;
+    simParam.fSwitch = opts.fSwitch;
+    simParam.fTrace = opts.fTrace;
+
+    ret = simnet_init(&simParam);
+    if (ret != kErrorOk)
+    {
+        fprintf(stderr, "simnet_init() failed (0x%04X)\n", ret);
+        return 1;
+    }
+
+    // The CNs are started first, so they are listening when the MN starts
+    memset(&nodeParam, 0, sizeof(nodeParam));
+    nodeParam.cycleLen = opts.cycleLen;
+    nodeParam.sdoWindowSize = opts.sdoWindowSize;
+    nodeParam.linkParam = opts.linkParam;
+
+    for (nodeId = 1; nodeId <= SIMNET_MAX_NODE_ID; nodeId++)
+    {
+        if (!opts.afCn[nodeId])
+            continue;
+
+        nodeParam.nodeId = nodeId;
+        nodeParam.pModuleFile = opts.pCnModule;
+        nodeParam.pCdcFile = NULL;
+        ret = simnet_addNode(&nodeParam);
+        if (ret != kErrorOk)
+            goto Exit;
+    }
+
+    nodeParam.nodeId = MN_NODE_ID;
+    nodeParam.pModuleFile = opts.pMnModule;
+    nodeParam.pCdcFile = opts.pCdcFile;
+    ret = simnet_addNode(&nodeParam);
+    if (ret != kErrorOk)
+        goto Exit;
+
+    if (!boot(&opts))
+    {
+        printNodeStatistics(&opts);
+        goto Exit;
+    }
+
+    if (opts.fMeasureLoss)
+    {
+        nodeParam.linkParam.lossPpm = opts.measureLossPpm;
+        for (nodeId = 1; nodeId <= SIMNET_MAX_NODE_ID; nodeId++)
+        {
+            if (opts.afCn[nodeId] || (nodeId == MN_NODE_ID))
+                simnet_setLinkParam(nodeId, &nodeParam.linkParam);
+        }
+    }
+
+    if (opts.sdoSize != 0)
+        measureSdo(&opts);
+    else if (opts.ethSize != 0)
+        measureEth(&opts);
+    else
+        measure(&opts);
+
+    exitCode = 0;
+
+Exit:
+    simnet_exit();
+    return exitCode;
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get command line parameters
+
+The function parses the supplied command line parameters and stores the
+options at pOpts_p.
+
+\param[in]      argc_p              Argument count.
+\param[in]      argv_p              Pointer to arguments.
+\param[out]     pOpts_p             Pointer to store options
+
+\return The function returns the parsing status.
+\retval 0                           Successfully parsed
+\retval -1                          Parsing error
+*/
+//------------------------------------------------------------------------------
+static int getOptions(int argc_p,
+                      char* const argv_p[],
+                      tOptions* pOpts_p)
+{
+    int opt;
+
+    /* setup default parameters */
+    memset(pOpts_p, 0, sizeof(*pOpts_p));
+    pOpts_p->pMnModule = DEFAULT_MN_MODULE;
+    pOpts_p->pCnModule = DEFAULT_CN_MODULE;
+    pOpts_p->pCdcFile = DEFAULT_CDC_FILE;
+    pOpts_p->cycleLen = DEFAULT_CYCLE_LEN;
+    pOpts_p->bootTimeout = DEFAULT_BOOT_TIMEOUT;
+    pOpts_p->measureTime = DEFAULT_MEASURE_TIME;
+    pOpts_p->fRxFilter = TRUE;
+    parseNodeList(DEFAULT_NODES, pOpts_p->afCn);
+
+    /* get command line parameters */
+    while ((opt = getopt(argc_p, argv_p, "m:k:c:g:n:y:d:j:l:L:s:b:t:S:W:E:Fxv")) != -1)
+    {
+        switch (opt)
+        {
+            case 'm':
+                pOpts_p->pMnModule = optarg;
+                break;
+
+            case 'k':
+                pOpts_p->pCnModule = optarg;
+                break;
+
+            case 'c':
+                pOpts_p->pCdcFile = optarg;
+                break;
+
+            case 'g':
+                pOpts_p->pCdcFile = optarg;
+                pOpts_p->fGenerateCdc = TRUE;
+                break;
+
+            case 'n':
+                if (parseNodeList(optarg, pOpts_p->afCn) != 0)
+                {
+                    fprintf(stderr, "Invalid node list '%s'\n", optarg);
+                    return -1;
+                }
+                break;
+
+            case 'y':
+                pOpts_p->cycleLen = (UINT32)strtoul(optarg, NULL, 0);
+                break;
+
+            case 'd':
+                pOpts_p->linkParam.delay = (UINT32)strtoul(optarg, NULL, 0);
+                break;
+
+            case 'j':
+                pOpts_p->linkParam.jitter = (UINT32)strtoul(optarg, NULL, 0);
+                break;
+
+            case 'l':
+                pOpts_p->linkParam.lossPpm = (UINT32)strtoul(optarg, NULL, 0);
+                break;
+
+            case 'L':
+                pOpts_p->fMeasureLoss = TRUE;
+                pOpts_p->measureLossPpm = (UINT32)strtoul(optarg, NULL, 0);
+                break;
+
+            case 's':
+                pOpts_p->seed = strtoull(optarg, NULL, 0);
+                break;
+
+            case 'b':
+                pOpts_p->bootTimeout = (UINT32)strtoul(optarg, NULL, 0);
+                break;
+
+            case 't':
+                pOpts_p->measureTime = (UINT32)strtoul(optarg, NULL, 0);
+                break;
+
+            case 'S':
+                pOpts_p->sdoSize = (UINT32)strtoul(optarg, NULL, 0);
+                break;
+
+            case 'W':
+                pOpts_p->sdoWindowSize = (UINT)strtoul(optarg, NULL, 0);
+                break;
+
+            case 'E':
+                pOpts_p->ethSize = (UINT32)strtoul(optarg, NULL, 0);
+                break;
+
+            case 'F':
+                pOpts_p->fRxFilter = FALSE;
+                break;
+
+            case 'x':
+                pOpts_p->fSwitch = TRUE;
+                break;
+
+            case 'v':
+                pOpts_p->fTrace = TRUE;
+                break;
+
+            default: /* '?' */
+                printf("Usage: %s [-m MN-MODULE] [-k CN-MODULE] [-c CDC-FILE] [-g CDC-FILE]\n"
+                       "          [-n NODES] [-y CYCLE] [-d DELAY] [-j JITTER] [-l LOSS] [-L LOSS] [-s SEED]\n"
+                       "          [-b BOOT-TIMEOUT] [-t TIME] [-S SDO-SIZE] [-W SDO-WINDOW]\n"
+                       "          [-E FRAME-SIZE] [-F] [-x] [-v]\n",
+                       argv_p[0]);
+                printf(" -m MN-MODULE: Node module of the MN (default: %s)\n", DEFAULT_MN_MODULE);
+                printf(" -k CN-MODULE: Node module of the CNs (default: %s)\n", DEFAULT_CN_MODULE);
+                printf(" -c CDC-FILE: Concise device configuration of the MN (default: %s)\n", DEFAULT_CDC_FILE);
+                printf(" -g CDC-FILE: Generate a CDC for the CNs of NODES and CYCLE, store it in CDC-FILE and use it\n");
+                printf(" -n NODES: Node IDs of the CNs, e.g. 1,32,110 or 1-10 (default: %s)\n", DEFAULT_NODES);
+                printf("          All CNs must be configured in the CDC (see -g), otherwise they never become operational.\n");
+                printf(" -y CYCLE: Cycle length in us, overridden by the CDC (default: %u)\n", DEFAULT_CYCLE_LEN);
+                printf(" -d DELAY: Delay of each link in ns\n");
+                printf(" -j JITTER: Maximum random delay of each link in ns\n");
+                printf(" -l LOSS: Frame loss of each link in ppm\n");
+                printf(" -L LOSS: Frame loss of each link in ppm after the boot-up (default: LOSS of -l)\n");
+                printf(" -s SEED: Seed of the pseudo random number generator\n");
+                printf(" -b BOOT-TIMEOUT: Virtual time allowed for the boot-up in s (default: %u)\n", DEFAULT_BOOT_TIMEOUT);
+                printf(" -t TIME: Virtual time of the measurement in s (default: %u)\n", DEFAULT_MEASURE_TIME);
+                printf(" -S SDO-SIZE: Measure the SDO throughput instead: the first CN writes\n"
+                       "          SDO-SIZE bytes to object 0x%04X of the MN repeatedly\n", SDO_OBJECT_INDEX);
+                printf(" -W SDO-WINDOW: SDO sequence layer window size of all nodes (default: stack default)\n");
+                printf(" -E FRAME-SIZE: Measure the virtual Ethernet throughput instead: the first CN\n"
+                       "          sends broadcast frames of FRAME-SIZE bytes as fast as its queue accepts them\n");
+                printf(" -F: Deliver all frames to all nodes (disable the Rx filters)\n");
+                printf(" -x: Connect the nodes by a store-and-forward switch instead of a hub\n");
+                printf(" -v: Print the debug traces of the stacks\n");
+                return -1;
+        }
+    }
+
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Parse a list of CN node IDs
+
+The list consists of node IDs and node ID ranges separated by commas, e.g.
+"1,32,100-110".
+
+\param[in]      pList_p             Node list.
+\param[out]     afCn_p              Array of flags, indexed by the node ID.
+
+\return The function returns 0 if the list is valid, otherwise -1.
+*/
+//------------------------------------------------------------------------------
+static int parseNodeList(const char* pList_p,
+                         BOOL* afCn_p)
+{
+    const char* pPos = pList_p;
+    char*       pEnd;
+    ULONG       first;
+    ULONG       last;
+
+    memset(afCn_p, 0, sizeof(BOOL) * (SIMNET_MAX_NODE_ID + 1));
+
+    while (*pPos != '\0')
+    {
+        first = strtoul(pPos, &pEnd, 0);
+        if (pEnd == pPos)
+            return -1;
+
+        last = first;
+        if (*pEnd == '-')
+        {
+            pPos = pEnd + 1;
+            last = strtoul(pPos, &pEnd, 0);
+            if (pEnd == pPos)
+                return -1;
+        }
+
+        // The CN node IDs range from 1 to 239
+        if ((first == 0) || (first > last) || (last >= MN_NODE_ID))
+            return -1;
+
+        for (; first <= last; first++)
+            afCn_p[first] = TRUE;
+
+        if (*pEnd == ',')
+            pEnd++;
+        else if (*pEnd != '\0')
+            return -1;
+
+        pPos = pEnd;
+    }
+
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Generate a CDC for the simulated network
+
+The function generates the concise device configuration of the MN for the CNs
+of the node list and stores it in the CDC file. It configures the network like
+the Demo_3CN project of openCONFIGURATOR, but for any number of CNs and the
+cycle length of the options. The MN exchanges one byte with the first
+CDC_MN_PDO_CHANNELS CNs by PDO, the further CNs are operated without PDOs
+mapped by the MN.
+
+\param[in]      pOpts_p             Pointer to the options.
+
+\return The function returns 0 if the CDC was stored, otherwise -1.
+*/
+//------------------------------------------------------------------------------
+static int generateCdc(const tOptions* pOpts_p)
+{
+    UINT8*  pCdc;
+    UINT8*  pPos;
+    UINT8   aCnCdc[256];
+    UINT    cnCdcSize;
+    UINT    aChannelNodeId[CDC_MN_PDO_CHANNELS];
+    UINT    channelCount = 0;
+    UINT    entryCount = 0;
+    UINT    channel;
+    UINT    nodeId;
+    FILE*   pFile;
+    int     result = -1;
+
+    pCdc = (UINT8*)malloc(CDC_MAX_SIZE);
+    if (pCdc == NULL)
+    {
+        fprintf(stderr, "Couldn't allocate the CDC buffer\n");
+        return -1;
+    }
+
+    cnCdcSize = generateCnCdc(pOpts_p, aCnCdc);
+
+    // The number of entries is written at the end
+    pPos = pCdc + 4;
+
+    for (nodeId = 1; nodeId < MN_NODE_ID; nodeId++)
+    {
+        if (!pOpts_p->afCn[nodeId])
+            continue;
+
+        pPos = writeCdcEntry(pPos, 0x1F81, (UINT8)nodeId, CDC_NODE_ASSIGNMENT, 4);
+        entryCount++;
+
+        if (channelCount < CDC_MN_PDO_CHANNELS)
+            aChannelNodeId[channelCount++] = nodeId;
+    }
+
+    // The mappings are disabled before they are changed
+    for (channel = 0; channel < channelCount; channel++)
+    {
+        pPos = writeCdcEntry(pPos, (UINT16)(0x1600 + channel), 0, 0, 1);
+        pPos = writeCdcEntry(pPos, (UINT16)(0x1A00 + channel), 0, 0, 1);
+        entryCount += 2;
+    }
+
+    pPos = writeCdcEntry(pPos, 0x1006, 0, pOpts_p->cycleLen, 4);
+    pPos = writeCdcEntry(pPos, 0x1C02, 3, CDC_MN_CNT_THRESHOLD, 4);
+    pPos = writeCdcEntry(pPos, 0x1C14, 0, CDC_LOSS_OF_FRAME_TOLERANCE, 4);
+    pPos = writeCdcEntry(pPos, 0x1F8A, 2, CDC_ASYNC_SLOT_TIMEOUT, 4);
+    entryCount += 4;
+
+    for (nodeId = 1; nodeId < MN_NODE_ID; nodeId++)
+    {
+        if (!pOpts_p->afCn[nodeId])
+            continue;
+
+        pPos = writeCdcEntry(pPos, 0x1C09, (UINT8)nodeId, CDC_MN_CNT_THRESHOLD, 4);
+        pPos = writeCdcEntry(pPos, 0x1F26, (UINT8)nodeId, CDC_CONF_DATE, 4);
+        pPos = writeCdcEntry(pPos, 0x1F27, (UINT8)nodeId, CDC_CONF_TIME, 4);
+        pPos = writeCdcEntry(pPos, 0x1F92, (UINT8)nodeId, CDC_PRES_TIMEOUT, 4);
+        entryCount += 4;
+    }
+
+    for (channel = 0; channel < channelCount; channel++)
+    {
+        pPos = writeCdcEntry(pPos, (UINT16)(0x1400 + channel), 1, aChannelNodeId[channel], 1);
+        pPos = writeCdcEntry(pPos, (UINT16)(0x1600 + channel), 1,
+                             CDC_MAPPING(CDC_MN_RX_INDEX, channel + 1), 8);
+        pPos = writeCdcEntry(pPos, (UINT16)(0x1800 + channel), 1, aChannelNodeId[channel], 1);
+        pPos = writeCdcEntry(pPos, (UINT16)(0x1A00 + channel), 1,
+                             CDC_MAPPING(CDC_MN_TX_INDEX, channel + 1), 8);
+        entryCount += 4;
+    }
+
+    for (channel = 0; channel < channelCount; channel++)
+    {
+        pPos = writeCdcEntry(pPos, (UINT16)(0x1600 + channel), 0, 1, 1);
+        pPos = writeCdcEntry(pPos, (UINT16)(0x1A00 + channel), 0, 1, 1);
+        entryCount += 2;
+    }
+
+    for (nodeId = 1; nodeId < MN_NODE_ID; nodeId++)
+    {
+        if (!pOpts_p->afCn[nodeId])
+            continue;
+
+        pPos = writeCdcEntry(pPos, 0x1F22, (UINT8)nodeId, 0, cnCdcSize);
+        memcpy(pPos, aCnCdc, cnCdcSize);
+        pPos += cnCdcSize;
+        entryCount++;
+    }
+
+    for (nodeId = 1; nodeId < MN_NODE_ID; nodeId++)
+    {
+        if (!pOpts_p->afCn[nodeId])
+            continue;
+
+        pPos = writeCdcEntry(pPos, 0x1F81, (UINT8)nodeId, CDC_NODE_ASSIGNMENT_VALID, 4);
+        entryCount++;
+    }
+
+    writeLe(pCdc, entryCount, 4);
+
+    pFile = fopen(pOpts_p->pCdcFile, "wb");
+    if (pFile == NULL)
+    {
+        fprintf(stderr, "Couldn't create the CDC file '%s'\n", pOpts_p->pCdcFile);
+        goto Exit;
+    }
+
+    if (fwrite(pCdc, (size_t)(pPos - pCdc), 1, pFile) == 1)
+        result = 0;
+    else
+        fprintf(stderr, "Couldn't write the CDC file '%s'\n", pOpts_p->pCdcFile);
+
+    if (fclose(pFile) != 0)
+        result = -1;
+
+Exit:
+    free(pCdc);
+    return result;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Generate the CDC of a CN
+
+The function generates the concise DCF which the MN downloads to each CN
+(object 0x1F22). All CNs get the same configuration.
+
+\param[in]      pOpts_p             Pointer to the options.
+\param[out]     pCdc_p              Buffer for the concise DCF.
+
+\return The function returns the size of the concise DCF.
+*/
+//------------------------------------------------------------------------------
+static UINT generateCnCdc(const tOptions* pOpts_p,
+                          UINT8* pCdc_p)
+{
+    UINT8*  pPos = pCdc_p + 4;
+
+    pPos = writeCdcEntry(pPos, 0x1600, 0, 0, 1);
+    pPos = writeCdcEntry(pPos, 0x1A00, 0, 0, 1);
+    pPos = writeCdcEntry(pPos, 0x1006, 0, pOpts_p->cycleLen, 4);
+    pPos = writeCdcEntry(pPos, 0x1020, 1, CDC_CONF_DATE, 4);
+    pPos = writeCdcEntry(pPos, 0x1020, 2, CDC_CONF_TIME, 4);
+    pPos = writeCdcEntry(pPos, 0x1C0B, 3, CDC_CN_CNT_THRESHOLD, 4);
+    pPos = writeCdcEntry(pPos, 0x1C0D, 3, CDC_CN_CNT_THRESHOLD, 4);
+    pPos = writeCdcEntry(pPos, 0x1C14, 0, CDC_LOSS_OF_FRAME_TOLERANCE, 4);
+    pPos = writeCdcEntry(pPos, 0x1F98, 4, CDC_PAYLOAD_LIMIT, 2);
+    pPos = writeCdcEntry(pPos, 0x1F98, 5, CDC_PAYLOAD_LIMIT, 2);
+    pPos = writeCdcEntry(pPos, 0x1600, 1, CDC_MAPPING(CDC_CN_RX_INDEX, 1), 8);
+    pPos = writeCdcEntry(pPos, 0x1A00, 1, CDC_MAPPING(CDC_CN_TX_INDEX, 1), 8);
+    pPos = writeCdcEntry(pPos, 0x1600, 0, 1, 1);
+    pPos = writeCdcEntry(pPos, 0x1A00, 0, 1, 1);
+
+    writeLe(pCdc_p, 14, 4);
+
+    return (UINT)(pPos - pCdc_p);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Write a CDC entry
+
+The function writes the header of a CDC entry and, for entries up to 8 bytes,
+the value in little endian byte order. The data of larger entries has to be
+written by the caller.
+
+\param[in]      pPos_p              Position of the entry in the CDC.
+\param[in]      index_p             Object index.
+\param[in]      subindex_p          Object sub-index.
+\param[in]      value_p             Value of the entry.
+\param[in]      size_p              Size of the entry data.
+
+\return The function returns the position of the entry data if the caller has
+        to write it, otherwise the position behind the entry.
+*/
+//------------------------------------------------------------------------------
+static UINT8* writeCdcEntry(UINT8* pPos_p,
+                            UINT16 index_p,
+                            UINT8 subindex_p,
+                            UINT64 value_p,
+                            UINT32 size_p)
+{
+    writeLe(pPos_p, index_p, 2);
+    pPos_p[2] = subindex_p;
+    writeLe(pPos_p + 3, size_p, 4);
+    pPos_p += 7;
+
+    if (size_p > 8)
+        return pPos_p;
+
+    writeLe(pPos_p, value_p, size_p);
+    return pPos_p + size_p;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Write a value in little endian byte order
+
+\param[out]     pPos_p              Destination of the value.
+\param[in]      value_p             Value.
+\param[in]      size_p              Size of the value in bytes.
+*/
+//------------------------------------------------------------------------------
+static void writeLe(UINT8* pPos_p,
+                    UINT64 value_p,
+                    UINT size_p)
+{
+    UINT    i;
+
+    for (i = 0; i < size_p; i++)
+        pPos_p[i] = (UINT8)(value_p >> (8 * i));
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Boot the network
+
+The function runs the simulation until all nodes are operational and prints
+the boot time of the MN and of the CNs.
+
+\param[in]      pOpts_p             Pointer to the options.
+
+\return The function returns TRUE if all nodes became operational within the
+        boot timeout.
+*/
+//------------------------------------------------------------------------------
+static BOOL boot(const tOptions* pOpts_p)
+{
+    tSimNetNodeStatistics   statistics;
+    tSimNetTime             timeout;
+    tSimNetTime             cnBootTime = 0;
+    UINT                    nodeId;
+
+    timeout = simnet_getTime() + ((tSimNetTime)pOpts_p->bootTimeout * SIMNET_TIME_S);
+
+    while (!simnet_isOperational())
+    {
+        if (simnet_getTime() >= timeout)
+        {
+            fprintf(stderr, "The network did not boot within %u s\n", pOpts_p->bootTimeout);
+            return FALSE;
+        }
+
+        simnet_run(SIMNET_TIME_MS);
+    }
+
+    for (nodeId = 1; nodeId < MN_NODE_ID; nodeId++)
+    {
+        if (!pOpts_p->afCn[nodeId])
+            continue;
+
+        simnet_getNodeStatistics(nodeId, &statistics);
+        if (statistics.operationalTime > cnBootTime)
+            cnBootTime = statistics.operationalTime;
+    }
+
+    simnet_getNodeStatistics(MN_NODE_ID, &statistics);
+
+    printf("Boot time MN:  %10.3f ms\n", (double)statistics.operationalTime / SIMNET_TIME_MS);
+    printf("Boot time CNs: %10.3f ms\n", (double)cnBootTime / SIMNET_TIME_MS);
+
+    return TRUE;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Measure the operational network
+
+The function runs the operational network for the measurement time and prints
+the host CPU time per cycle and the asynchronous throughput.
+
+\param[in]      pOpts_p             Pointer to the options.
+*/
+//------------------------------------------------------------------------------
+static void measure(const tOptions* pOpts_p)
+{
+    tSimNetStatistics   statistics;
+    double              seconds;
+
+    simnet_resetStatistics();
+    simnet_run((tSimNetTime)pOpts_p->measureTime * SIMNET_TIME_S);
+    simnet_getStatistics(&statistics);
+
+    seconds = (double)(statistics.time - statistics.startTime) / SIMNET_TIME_S;
+
+    printf("Virtual time:  %10.3f s\n", seconds);
+    printf("Events:        %10llu\n", (unsigned long long)statistics.eventCount);
+    printf("Frames:        %10llu\n", (unsigned long long)statistics.frameCount);
+    printf("Cycles:        %10llu\n", (unsigned long long)statistics.cycleCount);
+
+    if (statistics.cycleCount != 0)
+    {
+        printf("CPU per cycle: %10.3f us\n",
+               (double)statistics.cpuTime / (double)statistics.cycleCount / SIMNET_TIME_US);
+    }
+
+    if (seconds > 0.0)
+    {
+        printf("Async:         %10.1f frames/s %10.1f bytes/s\n",
+               (double)statistics.asyncFrameCount / seconds,
+               (double)statistics.asyncByteCount / seconds);
+    }
+
+    printNodeStatistics(pOpts_p);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Measure the SDO throughput
+
+The function lets the first CN write a buffer of the configured size to the
+object SDO_OBJECT_INDEX of the MN by segmented SDO transfers. A new transfer
+is started as soon as the previous one is finished. The sub-index is the node
+ID of a node which is not simulated, therefore the configuration of the
+simulated CNs is not affected. The function prints the number of transfers
+and the throughput in virtual time.
+
+\param[in]      pOpts_p             Pointer to the options.
+*/
+//------------------------------------------------------------------------------
+static void measureSdo(const tOptions* pOpts_p)
+{
+    tSimNetNodeStatistics   statistics;
+    tSimNetTime             startTime;
+    tOplkError              ret;
+    double                  seconds;
+    UINT8*                  pData;
+    UINT                    nodeId;
+    UINT                    subindex;
+    UINT32                  i;
+
+    for (nodeId = 1; (nodeId < MN_NODE_ID) && !pOpts_p->afCn[nodeId]; nodeId++)
+        ;
+
+    for (subindex = MN_NODE_ID - 1; (subindex > 0) && pOpts_p->afCn[subindex]; subindex--)
+        ;
+
+    if ((nodeId == MN_NODE_ID) || (subindex == 0))
+    {
+        fprintf(stderr, "The SDO measurement needs at least one CN\n");
+        return;
+    }
+
+    pData = (UINT8*)malloc(pOpts_p->sdoSize);
+    if (pData == NULL)
+    {
+        fprintf(stderr, "Couldn't allocate %u bytes of SDO data\n", pOpts_p->sdoSize);
+        return;
+    }
+
+    for (i = 0; i < pOpts_p->sdoSize; i++)
+        pData[i] = (UINT8)i;
+
+    simnet_resetStatistics();
+    startTime = simnet_getTime();
+
+    while (simnet_getTime() < startTime + ((tSimNetTime)pOpts_p->measureTime * SIMNET_TIME_S))
+    {
+        if (!simnet_isSdoRunning(nodeId))
+        {
+            ret = simnet_writeObject(nodeId, MN_NODE_ID, SDO_OBJECT_INDEX, subindex,
+                                     pData, pOpts_p->sdoSize);
+            if (ret != kErrorOk)
+            {
+                fprintf(stderr, "Node %u: SDO write failed (0x%04X)\n", nodeId, ret);
+                break;
+            }
+        }
+
+        simnet_run(SDO_POLL_INTERVAL);
+    }
+
+    // Only finished transfers are counted
+    simnet_getNodeStatistics(nodeId, &statistics);
+    seconds = (double)(simnet_getTime() - startTime) / SIMNET_TIME_S;
+
+    printf("Virtual time:  %10.3f s\n", seconds);
+    printf("SDO transfers: %10llu (%u bytes each, node %u -> 0x%04X/%u)\n",
+           (unsigned long long)statistics.sdoTransferCount,
+           pOpts_p->sdoSize,
+           nodeId,
+           SDO_OBJECT_INDEX,
+           subindex);
+    printf("SDO aborts:    %10llu (last abort code 0x%08X)\n",
+           (unsigned long long)statistics.sdoAbortCount,
+           statistics.sdoAbortCode);
+
+    if (seconds > 0.0)
+        printf("SDO:           %10.1f bytes/s\n", (double)statistics.sdoByteCount / seconds);
+
+    printNodeStatistics(pOpts_p);
+
+    // A running transfer still references the data
+    while (simnet_isSdoRunning(nodeId))
+        simnet_run(SDO_POLL_INTERVAL);
+
+    free(pData);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Measure the virtual Ethernet throughput
+
+The function lets the first CN send non-POWERLINK broadcast frames of the
+configured size. The virtual Ethernet queue of the node is refilled every
+ETH_POLL_INTERVAL until it is full, so the throughput is only limited by the
+asynchronous slots the MN assigns to the node. The function prints the number
+of sent frames and the throughput in virtual time.
+
+\param[in]      pOpts_p             Pointer to the options.
+*/
+//------------------------------------------------------------------------------
+static void measureEth(const tOptions* pOpts_p)
+{
+    tSimNetNodeStatistics   statistics;
+    tSimNetTime             startTime;
+    tOplkError              ret = kErrorOk;
+    double                  seconds;
+    UINT8                   aFrame[ETH_MAX_FRAME_SIZE];
+    UINT64                  queuedCount = 0;
+    UINT                    nodeId;
+    UINT32                  i;
+
+    for (nodeId = 1; (nodeId < MN_NODE_ID) && !pOpts_p->afCn[nodeId]; nodeId++)
+        ;
+
+    if (nodeId == MN_NODE_ID)
+    {
+        fprintf(stderr, "The Ethernet measurement needs at least one CN\n");
+        return;
+    }
+
+    if ((pOpts_p->ethSize <= ETH_HEADER_SIZE) || (pOpts_p->ethSize > sizeof(aFrame)))
+    {
+        fprintf(stderr, "The frame size must be between %u and %u bytes\n",
+                ETH_HEADER_SIZE + 1,
+                (UINT)sizeof(aFrame));
+        return;
+    }
+
+    // Broadcast destination, the source address is filled in by the stack
+    memset(aFrame, 0xFF, 6);
+    memset(&aFrame[6], 0, 6);
+    aFrame[12] = (UINT8)(ETH_ETHERTYPE >> 8);
+    aFrame[13] = (UINT8)ETH_ETHERTYPE;
+    for (i = ETH_HEADER_SIZE; i < pOpts_p->ethSize; i++)
+        aFrame[i] = (UINT8)i;
+
+    simnet_resetStatistics();
+    simnet_getNodeStatistics(nodeId, &statistics);
+    startTime = simnet_getTime();
+
+    while (simnet_getTime() < startTime + ((tSimNetTime)pOpts_p->measureTime * SIMNET_TIME_S))
+    {
+        do
+        {
+            ret = simnet_sendEthFrame(nodeId, aFrame, pOpts_p->ethSize);
+            if (ret == kErrorOk)
+                queuedCount++;
+        } while (ret == kErrorOk);
+
+        if (ret != kErrorDllAsyncTxBufferFull)
+        {
+            fprintf(stderr, "Node %u: Ethernet send failed (0x%04X)\n", nodeId, ret);
+            break;
+        }
+
+        simnet_run(ETH_POLL_INTERVAL);
+    }
+
+    simnet_getNodeStatistics(nodeId, &statistics);
+    seconds = (double)(simnet_getTime() - startTime) / SIMNET_TIME_S;
+
+    printf("Virtual time:  %10.3f s\n", seconds);
+    printf("Eth frames:    %10llu sent, %llu queued (%u bytes each, node %u)\n",
+           (unsigned long long)statistics.ethTxFrameCount,
+           (unsigned long long)queuedCount,
+           pOpts_p->ethSize,
+           nodeId);
+
+    if (seconds > 0.0)
+    {
+        printf("Eth:           %10.1f frames/s %10.1f bytes/s\n",
+               (double)statistics.ethTxFrameCount / seconds,
+               (double)statistics.ethTxByteCount / seconds);
+    }
+
+    printNodeStatistics(pOpts_p);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Print the statistics of all nodes
+
+\param[in]      pOpts_p             Pointer to the options.
+*/
+//------------------------------------------------------------------------------
+static void printNodeStatistics(const tOptions* pOpts_p)
+{
+    tSimNetNodeStatistics   statistics;
+    UINT                    nodeId;
+
+    printf("\nNode  NMT state    Tx frames     Tx async     Rx frames     Filtered         Lost    CPU [ms]\n");
+
+    for (nodeId = 1; nodeId <= SIMNET_MAX_NODE_ID; nodeId++)
+    {
+        if (!pOpts_p->afCn[nodeId] && (nodeId != MN_NODE_ID))
+            continue;
+
+        if (simnet_getNodeStatistics(nodeId, &statistics) != kErrorOk)
+            continue;
+
+        printf("%4u     0x%04X %12llu %12llu  %12llu %12llu %12llu %11.3f\n",
+               nodeId,
+               statistics.nmtState,
+               (unsigned long long)statistics.txFrameCount,
+               (unsigned long long)statistics.asyncTxFrameCount,
+               (unsigned long long)statistics.rxFrameCount,
+               (unsigned long long)statistics.filteredFrameCount,
+               (unsigned long long)statistics.lostFrameCount,
+               (double)statistics.cpuTime / SIMNET_TIME_MS);
+    }
+}
+
+/// \}
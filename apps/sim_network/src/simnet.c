@@ -0,0 +1,2428 @@
+/**
+********************************************************************************
+\file   simnet.c
+
+\brief  Discrete-event network simulator
+
+This file contains the implementation of the network simulator. It implements
+the function tables of the simulation interface for every simulated node and
+connects the nodes by a virtual hub or store-and-forward switch. All nodes are executed in the calling
+thread on virtual time, therefore a simulation run only depends on its
+parameters and the seed of the pseudo random number generator.
+
+Every node is a private copy of a node module (see \ref simnode.h) which
+contains a complete openPOWERLINK stack. The simulator keeps a single event
+queue ordered by virtual time which contains the frames in flight, the
+expirations of the high-resolution and user timers of all nodes and the
+background processing of the nodes.
+
+\ingroup module_sim_network
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2017, B&R Industrial Automation GmbH
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <simnet.h>
+#include <simnode.h>
+#include <oplk/frame.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <time.h>
+#include <errno.h>
+#include <dlfcn.h>
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define SIMNET_BIT_TIME                 10          // Duration of one bit on a 100 Mbit/s link [ns]
+#define SIMNET_FRAME_OVERHEAD           24          // Preamble, SFD, CRC and inter-frame gap [byte]
+#define SIMNET_MIN_FRAME_SIZE           60          // Minimum Ethernet frame size without CRC [byte]
+#define SIMNET_MAX_FRAME_SIZE           1536        // Maximum supported frame size [byte]
+#define SIMNET_FILTER_SIZE              22          // Size of the Rx filter values and masks [byte]
+
+#define SIMNET_HRES_TIMER_MIN_PERIOD    1000        // Minimum period of continuous high-resolution timers [ns]
+
+#define SIMNET_TIMER_INDEX_BITS         20          // Number of timer handle bits used for the timer index
+#define SIMNET_TIMER_INDEX_MASK         ((1UL << SIMNET_TIMER_INDEX_BITS) - 1)
+#define SIMNET_TIMER_POOL_GROW          16          // Number of timers added when a timer pool is exhausted
+
+#define SIMNET_EVENT_QUEUE_GROW         1024        // Number of events added when the event queue is full
+
+#define SIMNET_DEFAULT_SEED             0x5DEECE66DULL
+#define SIMNET_DEFAULT_TEMP_DIR         "/tmp"
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+/**
+\brief Simulation event types
+*/
+typedef enum
+{
+    kSimNetEventFrame           = 0,        ///< A frame arrives at a node
+    kSimNetEventTxDone          = 1,        ///< A frame of a node has been transmitted
+    kSimNetEventHresTimer       = 2,        ///< A high-resolution timer of a node expires
+    kSimNetEventUserTimer       = 3,        ///< A user timer of a node expires
+    kSimNetEventProcess         = 4,        ///< Background processing of a node
+} eSimNetEventType;
+
+/**
+\brief Simulation event type data type
+
+Data type for the enumerator \ref eSimNetEventType.
+*/
+typedef UINT32 tSimNetEventType;
+
+/**
+\brief Frame in flight
+
+The frame data is shared by all receivers of a frame.
+*/
+typedef struct
+{
+    UINT                refCount;                   ///< Number of pending deliveries
+    size_t              size;                       ///< Size of the frame (without CRC)
+    UINT8               aData[];                    ///< Frame data
+} tSimNetFrame;
+
+/**
+\brief Simulation event
+*/
+typedef struct
+{
+    tSimNetTime         time;                       ///< Virtual time of the event
+    UINT64              seq;                        ///< Sequence number (orders events with equal time)
+    tSimNetEventType    type;                       ///< Type of the event
+    UINT                nodeId;                     ///< Node the event belongs to
+    union
+    {
+        tSimNetFrame*   pFrame;                     ///< Received frame (kSimNetEventFrame)
+        tEdrvTxBuffer*  pTxBuffer;                  ///< Transmitted buffer (kSimNetEventTxDone)
+        tTimerHdl       timerHdl;                   ///< Expired timer (kSimNetEventHresTimer, kSimNetEventUserTimer)
+    } arg;
+} tSimNetEvent;
+
+/**
+\brief Simulated timer
+
+The structure is used for the high-resolution timers as well as for the user
+timers of a node.
+*/
+typedef struct
+{
+    BOOL                fUsed;                      ///< Timer is running
+    UINT32              generation;                 ///< Incremented whenever the timer is freed
+    UINT                nextFree;                   ///< Index + 1 of the next free timer (0 = none)
+    tTimerHdl           timerHdl;                   ///< Handle of the running timer
+    UINT64              eventSeq;                   ///< Sequence number of the scheduled expiration
+    ULONGLONG           period;                     ///< Period of a continuous timer [ns]
+    BOOL                fContinue;                  ///< Timer is continuous
+    tTimerkCallback     pfnCallback;                ///< Callback of a high-resolution timer
+    ULONG               argument;                   ///< Argument of a high-resolution timer
+    tTimerArg           userArg;                    ///< Argument of a user timer
+} tSimNetTimer;
+
+/**
+\brief Timer pool of a node
+*/
+typedef struct
+{
+    tSimNetTimer*       aTimer;                     ///< Array of timers
+    UINT                count;                      ///< Number of timers in the array
+    UINT                firstFree;                  ///< Index + 1 of the first free timer (0 = none)
+} tSimNetTimerPool;
+
+/**
+\brief Simulated node
+*/
+typedef struct
+{
+    BOOL                            fUsed;                  ///< Node is simulated
+    UINT                            nodeId;                 ///< POWERLINK node ID
+    UINT8                           aMacAddr[6];            ///< MAC address
+    tSimNetLinkParam                linkParam;              ///< Link parameters
+    void*                           pModule;                ///< Handle of the private module copy
+    tSimNodeExitFunc                pfnExit;                ///< Exit function of the module
+    tSimNodeProcessFunc             pfnProcess;             ///< Process function of the module
+    tSimNodeUserTimerCallbackFunc   pfnUserTimerCallback;   ///< User timer callback of the module
+    tSimNodeWriteObjectFunc         pfnWriteObject;         ///< SDO write function of the module
+    tSimNodeSendEthFrameFunc        pfnSendEthFrame;        ///< Virtual Ethernet send function of the module
+    BOOL                            fSdoRunning;            ///< An SDO transfer of the node is running
+    tEdrvRxHandler                  pfnRxHandler;           ///< Rx handler of the Ethernet driver
+    const tEdrvFilter*              pFilter;                ///< Rx filter table of the Ethernet driver
+    UINT                            filterCount;            ///< Number of Rx filter entries
+    tSimNetTime                     txBusyUntil;            ///< The link of the node is busy until this time
+    tSimNetTime                     lastRxTime;             ///< Arrival time of the last frame (keeps the frame order)
+    tSimNetTime                     portBusyUntil;          ///< The switch port of the node is busy until this time
+    tSimNetTimerPool                hresTimers;             ///< High-resolution timers
+    tSimNetTimerPool                userTimers;             ///< User timers
+    tSimNetNodeStatistics           statistics;             ///< Node statistics
+} tSimNetNode;
+
+/**
+\brief Instance of the network simulator
+*/
+typedef struct
+{
+    BOOL                fInitialized;                       ///< Simulator is initialized
+    tSimNetParam        param;                              ///< Simulator parameters
+    tSimNetNode         aNode[SIMNET_MAX_NODE_ID + 1];      ///< Nodes indexed by their node ID
+    tSimNetEvent*       aEvent;                             ///< Event queue (binary heap)
+    UINT                eventCount;                         ///< Number of queued events
+    UINT                eventQueueSize;                     ///< Size of the event queue
+    UINT64              nextSeq;                            ///< Next event sequence number
+    tSimNetTime         now;                                ///< Current virtual time
+    UINT64              randomState;                        ///< State of the pseudo random number generator
+    tSimNetStatistics   statistics;                         ///< Simulator statistics
+    UINT8               aRxBuffer[SIMNET_MAX_FRAME_SIZE];   ///< Rx buffer passed to the receiving node
+} tSimNetInstance;
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static tSimNetInstance  instance_l;
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+// simulation interface functions
+static tOplkError   edrvInit(tSimulationInstanceHdl simHdl_p,
+                             const tEdrvInitParam* pEdrvInitParam_p);
+static tOplkError   edrvExit(tSimulationInstanceHdl simHdl_p);
+static const UINT8* edrvGetMacAddr(tSimulationInstanceHdl simHdl_p);
+static tOplkError   edrvSendTxBuffer(tSimulationInstanceHdl simHdl_p,
+                                     tEdrvTxBuffer* pBuffer_p);
+static tOplkError   edrvAllocTxBuffer(tSimulationInstanceHdl simHdl_p,
+                                      tEdrvTxBuffer* pBuffer_p);
+static tOplkError   edrvFreeTxBuffer(tSimulationInstanceHdl simHdl_p,
+                                     tEdrvTxBuffer* pBuffer_p);
+static tOplkError   edrvChangeRxFilter(tSimulationInstanceHdl simHdl_p,
+                                       tEdrvFilter* pFilter_p,
+                                       UINT count_p,
+                                       UINT entryChanged_p,
+                                       UINT changeFlags_p);
+static tOplkError   edrvMulticast(tSimulationInstanceHdl simHdl_p,
+                                  const UINT8* pMacAddr_p);
+static tOplkError   hresTimerInitExit(tSimulationInstanceHdl simHdl_p);
+static tOplkError   hresTimerModify(tSimulationInstanceHdl simHdl_p,
+                                    tTimerHdl* pTimerHdl_p,
+                                    ULONGLONG time_p,
+                                    tTimerkCallback pfnCallback_p,
+                                    ULONG argument_p,
+                                    BOOL fContinue_p);
+static tOplkError   hresTimerDelete(tSimulationInstanceHdl simHdl_p,
+                                    tTimerHdl* pTimerHdl_p);
+static tOplkError   userTimerInitExit(tSimulationInstanceHdl simHdl_p);
+static tOplkError   userTimerSet(tSimulationInstanceHdl simHdl_p,
+                                 tTimerHdl* pTimerHdl_p,
+                                 ULONG timeInMs_p,
+                                 tTimerArg argument_p);
+static tOplkError   userTimerModify(tSimulationInstanceHdl simHdl_p,
+                                    tTimerHdl* pTimerHdl_p,
+                                    ULONG timeInMs_p,
+                                    tTimerArg argument_p);
+static tOplkError   userTimerDelete(tSimulationInstanceHdl simHdl_p,
+                                    tTimerHdl* pTimerHdl_p);
+static BOOL         userTimerIsActive(tSimulationInstanceHdl simHdl_p,
+                                      tTimerHdl timerHdl_p);
+static tOplkError   targetInitExit(tSimulationInstanceHdl simHdl_p);
+static void         targetMsleep(tSimulationInstanceHdl simHdl_p,
+                                 UINT32 milliSeconds_p);
+static tOplkError   targetSetIp(tSimulationInstanceHdl simHdl_p,
+                                const char* ifName_p,
+                                UINT32 ipAddress_p,
+                                UINT32 subnetMask_p,
+                                UINT16 mtu_p);
+static tOplkError   targetSetDefaultGateway(tSimulationInstanceHdl simHdl_p,
+                                            UINT32 defaultGateway_p);
+static UINT32       targetGetTick(tSimulationInstanceHdl simHdl_p);
+static tOplkError   targetSetLed(tSimulationInstanceHdl simHdl_p,
+                                 tLedType ledType_p,
+                                 BOOL fLedOn_p);
+static void         traceMessage(tSimulationInstanceHdl simHdl_p,
+                                 const char* pMessage_p);
+static tOplkError   apiEvent(tSimulationInstanceHdl simHdl_p,
+                             tOplkApiEventType eventType_p,
+                             const tOplkApiEventArg* pEventArg_p,
+                             void* pUserArg_p);
+static tOplkError   processSync(tSimulationInstanceHdl simHdl_p);
+
+// node handling
+static tSimNetNode* getNode(tSimulationInstanceHdl simHdl_p);
+static tSimNetNode* getNodeByMacAddr(const UINT8* pMacAddr_p);
+static tOplkError   loadModule(tSimNetNode* pNode_p,
+                               const char* pModuleFile_p,
+                               tSimNodeInitFunc* ppfnInit_p);
+static void         removeNode(tSimNetNode* pNode_p);
+static void         initNodeFunctions(tSimNodeInitParam* pInitParam_p);
+
+// hub and switch
+static tSimNetTime  getFrameDuration(size_t size_p);
+static BOOL         isFrameAccepted(const tSimNetNode* pNode_p,
+                                    const UINT8* pData_p,
+                                    size_t size_p);
+static BOOL         isFrameLost(const tSimNetLinkParam* pLinkParam_p);
+static UINT32       getJitter(const tSimNetLinkParam* pLinkParam_p);
+static UINT16       getEtherType(const UINT8* pData_p);
+static void         countTxFrame(tSimNetNode* pNode_p,
+                                 const UINT8* pData_p,
+                                 size_t size_p);
+static void         receiveFrame(tSimNetNode* pNode_p,
+                                 const tSimNetFrame* pFrame_p);
+static UINT64       getRandom(void);
+
+// timers
+static tSimNetTimer* allocTimer(tSimNetTimerPool* pPool_p);
+static void          freeTimer(tSimNetTimerPool* pPool_p,
+                               tSimNetTimer* pTimer_p);
+static tSimNetTimer* getTimer(const tSimNetTimerPool* pPool_p,
+                              tTimerHdl timerHdl_p);
+static void          scheduleTimer(tSimNetNode* pNode_p,
+                                   tSimNetTimer* pTimer_p,
+                                   tSimNetEventType type_p,
+                                   tSimNetTime time_p);
+static BOOL          expireHresTimer(tSimNetNode* pNode_p,
+                                     const tSimNetEvent* pEvent_p);
+static BOOL          expireUserTimer(tSimNetNode* pNode_p,
+                                     const tSimNetEvent* pEvent_p);
+
+// event queue
+static UINT64       pushEvent(const tSimNetEvent* pEvent_p);
+static void         popEvent(tSimNetEvent* pEvent_p);
+static BOOL         isEventBefore(const tSimNetEvent* pEvent1_p,
+                                  const tSimNetEvent* pEvent2_p);
+static void         processEvent(const tSimNetEvent* pEvent_p);
+static UINT64       getCpuTime(void);
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Initialize the network simulator
+
+The function initializes the network simulator. The virtual time starts at 0.
+
+\param[in]      pParam_p            Pointer to the simulator parameters.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_sim_network
+*/
+//------------------------------------------------------------------------------
+tOplkError simnet_init(const tSimNetParam* pParam_p)
+{
+    if ((pParam_p == NULL) || instance_l.fInitialized)
+        return kErrorInvalidOperation;
+
+    memset(&instance_l, 0, sizeof(instance_l));
+    instance_l.param = *pParam_p;
+    if (instance_l.param.pTempDir == NULL)
+        instance_l.param.pTempDir = SIMNET_DEFAULT_TEMP_DIR;
+
+    // The xorshift generator must not be seeded with 0
+    instance_l.randomState = (pParam_p->seed != 0) ? pParam_p->seed : SIMNET_DEFAULT_SEED;
+
+    instance_l.fInitialized = TRUE;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Shut down the network simulator
+
+The function shuts down the stacks of all nodes, unloads their modules and
+discards all pending events.
+
+\ingroup module_sim_network
+*/
+//------------------------------------------------------------------------------
+void simnet_exit(void)
+{
+    tSimNetEvent    event;
+    UINT            nodeId;
+
+    if (!instance_l.fInitialized)
+        return;
+
+    for (nodeId = 0; nodeId <= SIMNET_MAX_NODE_ID; nodeId++)
+    {
+        if (instance_l.aNode[nodeId].fUsed)
+            removeNode(&instance_l.aNode[nodeId]);
+    }
+
+    while (instance_l.eventCount > 0)
+    {
+        popEvent(&event);
+        if ((event.type == kSimNetEventFrame) && (--event.arg.pFrame->refCount == 0))
+            free(event.arg.pFrame);
+    }
+
+    free(instance_l.aEvent);
+    instance_l.aEvent = NULL;
+    instance_l.eventQueueSize = 0;
+    instance_l.fInitialized = FALSE;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Add a node to the simulation
+
+The function loads a private copy of the node module, connects the stack of the
+node to the simulator and starts it at the current virtual time.
+
+\param[in]      pNodeParam_p        Pointer to the node parameters.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_sim_network
+*/
+//------------------------------------------------------------------------------
+tOplkError simnet_addNode(const tSimNetNodeParam* pNodeParam_p)
+{
+    tOplkError          ret;
+    tSimNetNode*        pNode;
+    tSimNodeInitFunc    pfnInit;
+    tSimNodeInitParam   initParam;
+    tSimNetEvent        event;
+    UINT64              cpuTime;
+
+    if (!instance_l.fInitialized)
+        return kErrorInvalidOperation;
+
+    if ((pNodeParam_p == NULL) ||
+        (pNodeParam_p->nodeId == 0) ||
+        (pNodeParam_p->nodeId > SIMNET_MAX_NODE_ID) ||
+        (pNodeParam_p->pModuleFile == NULL))
+        return kErrorApiInvalidParam;
+
+    pNode = &instance_l.aNode[pNodeParam_p->nodeId];
+    if (pNode->fUsed)
+        return kErrorApiInvalidParam;
+
+    memset(pNode, 0, sizeof(*pNode));
+    pNode->nodeId = pNodeParam_p->nodeId;
+    pNode->linkParam = pNodeParam_p->linkParam;
+    pNode->aMacAddr[0] = 0x00;
+    pNode->aMacAddr[1] = 0x60;
+    pNode->aMacAddr[2] = 0x65;
+    pNode->aMacAddr[3] = 0x00;
+    pNode->aMacAddr[4] = 0x00;
+    pNode->aMacAddr[5] = (UINT8)pNodeParam_p->nodeId;
+    pNode->statistics.nmtState = kNmtGsOff;
+
+    ret = loadModule(pNode, pNodeParam_p->pModuleFile, &pfnInit);
+    if (ret != kErrorOk)
+        return ret;
+
+    // The stack calls the simulator already during its initialization
+    pNode->fUsed = TRUE;
+
+    memset(&initParam, 0, sizeof(initParam));
+    initParam.simHdl = pNode->nodeId;
+    initParam.nodeId = pNode->nodeId;
+    memcpy(initParam.aMacAddr, pNode->aMacAddr, sizeof(initParam.aMacAddr));
+    initParam.cycleLen = pNodeParam_p->cycleLen;
+    initParam.pCdcFile = pNodeParam_p->pCdcFile;
+    initParam.sdoWindowSize = pNodeParam_p->sdoWindowSize;
+    initNodeFunctions(&initParam);
+
+    cpuTime = getCpuTime();
+    ret = pfnInit(&initParam);
+    cpuTime = getCpuTime() - cpuTime;
+    pNode->statistics.cpuTime += cpuTime;
+    pNode->statistics.dispatchCount++;
+    instance_l.statistics.cpuTime += cpuTime;
+
+    if (ret != kErrorOk)
+    {
+        fprintf(stderr, "Node %u: initialization failed (0x%04X)\n", pNode->nodeId, ret);
+        pNode->pfnExit = NULL;          // The module has already cleaned up
+        removeNode(pNode);
+        return ret;
+    }
+
+    if (instance_l.param.processInterval != 0)
+    {
+        memset(&event, 0, sizeof(event));
+        event.time = instance_l.now + instance_l.param.processInterval;
+        event.type = kSimNetEventProcess;
+        event.nodeId = pNode->nodeId;
+        pushEvent(&event);
+    }
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Change the link parameters of a node
+
+The new parameters apply to the frames which are sent afterwards, e.g. to
+measure the behavior on a lossy link after an undisturbed boot-up.
+
+\param[in]      nodeId_p            Node ID of the node.
+\param[in]      pLinkParam_p        Pointer to the link parameters.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_sim_network
+*/
+//------------------------------------------------------------------------------
+tOplkError simnet_setLinkParam(UINT nodeId_p,
+                               const tSimNetLinkParam* pLinkParam_p)
+{
+    if ((pLinkParam_p == NULL) ||
+        (nodeId_p > SIMNET_MAX_NODE_ID) ||
+        !instance_l.aNode[nodeId_p].fUsed)
+        return kErrorApiInvalidParam;
+
+    instance_l.aNode[nodeId_p].linkParam = *pLinkParam_p;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Run the simulation
+
+The function processes all events up to the given virtual time span. After the
+call the virtual time has advanced by exactly this time span.
+
+\param[in]      duration_p          Virtual time span to be simulated [ns].
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_sim_network
+*/
+//------------------------------------------------------------------------------
+tOplkError simnet_run(tSimNetTime duration_p)
+{
+    tSimNetTime     endTime;
+    tSimNetEvent    event;
+
+    if (!instance_l.fInitialized)
+        return kErrorInvalidOperation;
+
+    endTime = instance_l.now + duration_p;
+
+    while ((instance_l.eventCount > 0) && (instance_l.aEvent[0].time <= endTime))
+    {
+        popEvent(&event);
+        instance_l.now = event.time;
+        instance_l.statistics.eventCount++;
+        processEvent(&event);
+    }
+
+    instance_l.now = endTime;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get the virtual time
+
+\return The function returns the current virtual time [ns].
+
+\ingroup module_sim_network
+*/
+//------------------------------------------------------------------------------
+tSimNetTime simnet_getTime(void)
+{
+    return instance_l.now;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Check if all nodes are operational
+
+\return The function returns TRUE if all nodes are in the NMT state
+        operational, otherwise FALSE.
+
+\ingroup module_sim_network
+*/
+//------------------------------------------------------------------------------
+BOOL simnet_isOperational(void)
+{
+    UINT    nodeId;
+    BOOL    fNodeFound = FALSE;
+
+    for (nodeId = 0; nodeId <= SIMNET_MAX_NODE_ID; nodeId++)
+    {
+        if (!instance_l.aNode[nodeId].fUsed)
+            continue;
+
+        if ((instance_l.aNode[nodeId].statistics.nmtState != kNmtMsOperational) &&
+            (instance_l.aNode[nodeId].statistics.nmtState != kNmtCsOperational))
+            return FALSE;
+
+        fNodeFound = TRUE;
+    }
+
+    return fNodeFound;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get the statistics of a node
+
+\param[in]      nodeId_p            Node ID of the node.
+\param[out]     pStatistics_p       Pointer to store the statistics.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_sim_network
+*/
+//------------------------------------------------------------------------------
+tOplkError simnet_getNodeStatistics(UINT nodeId_p,
+                                    tSimNetNodeStatistics* pStatistics_p)
+{
+    if ((pStatistics_p == NULL) ||
+        (nodeId_p > SIMNET_MAX_NODE_ID) ||
+        !instance_l.aNode[nodeId_p].fUsed)
+        return kErrorApiInvalidParam;
+
+    *pStatistics_p = instance_l.aNode[nodeId_p].statistics;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get the simulator statistics
+
+\param[out]     pStatistics_p       Pointer to store the statistics.
+
+\ingroup module_sim_network
+*/
+//------------------------------------------------------------------------------
+void simnet_getStatistics(tSimNetStatistics* pStatistics_p)
+{
+    if (pStatistics_p == NULL)
+        return;
+
+    *pStatistics_p = instance_l.statistics;
+    pStatistics_p->time = instance_l.now;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Reset the statistics
+
+The function resets the counters of the simulator and of all nodes, e.g. to
+measure a steady state after the boot-up. The NMT states and the times the
+nodes became operational are kept.
+
+\ingroup module_sim_network
+*/
+//------------------------------------------------------------------------------
+void simnet_resetStatistics(void)
+{
+    tSimNetNodeStatistics*  pStatistics;
+    tNmtState               nmtState;
+    tSimNetTime             operationalTime;
+    UINT                    nodeId;
+
+    for (nodeId = 0; nodeId <= SIMNET_MAX_NODE_ID; nodeId++)
+    {
+        pStatistics = &instance_l.aNode[nodeId].statistics;
+        nmtState = pStatistics->nmtState;
+        operationalTime = pStatistics->operationalTime;
+        memset(pStatistics, 0, sizeof(*pStatistics));
+        pStatistics->nmtState = nmtState;
+        pStatistics->operationalTime = operationalTime;
+    }
+
+    memset(&instance_l.statistics, 0, sizeof(instance_l.statistics));
+    instance_l.statistics.startTime = instance_l.now;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Write an object of a remote node by SDO
+
+The function starts an SDO write transfer from a simulated node to another
+node. Only one transfer per node may be running. The simulation must be run
+until \ref simnet_isSdoRunning returns FALSE, afterwards the result is
+contained in the node statistics.
+
+\param[in]      nodeId_p            Node ID of the node which performs the transfer.
+\param[in]      targetNodeId_p      Node ID of the node whose object is written.
+\param[in]      index_p             Index of the object.
+\param[in]      subindex_p          Sub-index of the object.
+\param[in]      pData_p             Pointer to the data. It must stay valid
+                                    until the transfer is finished.
+\param[in]      size_p              Size of the data.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_sim_network
+*/
+//------------------------------------------------------------------------------
+tOplkError simnet_writeObject(UINT nodeId_p,
+                              UINT targetNodeId_p,
+                              UINT index_p,
+                              UINT subindex_p,
+                              void* pData_p,
+                              UINT size_p)
+{
+    tOplkError      ret;
+    tSimNetNode*    pNode;
+    UINT64          cpuTime;
+
+    if (!instance_l.fInitialized)
+        return kErrorInvalidOperation;
+
+    if ((nodeId_p > SIMNET_MAX_NODE_ID) ||
+        !instance_l.aNode[nodeId_p].fUsed ||
+        instance_l.aNode[nodeId_p].fSdoRunning)
+        return kErrorApiInvalidParam;
+
+    pNode = &instance_l.aNode[nodeId_p];
+
+    // The finished event may already be delivered during the call
+    pNode->fSdoRunning = TRUE;
+
+    cpuTime = getCpuTime();
+    ret = pNode->pfnWriteObject(targetNodeId_p, index_p, subindex_p, pData_p, size_p);
+    pNode->pfnProcess();
+    cpuTime = getCpuTime() - cpuTime;
+    pNode->statistics.cpuTime += cpuTime;
+    pNode->statistics.dispatchCount++;
+    instance_l.statistics.cpuTime += cpuTime;
+
+    // If the sequence layer still waits for the acknowledge of the previous
+    // transfer, the command layer starts the transfer as soon as it arrives.
+    if ((ret == kErrorApiTaskDeferred) || (ret == kErrorSdoSeqConnectionBusy))
+        return kErrorOk;
+
+    // A local access is finished already
+    pNode->fSdoRunning = FALSE;
+    if (ret == kErrorOk)
+    {
+        pNode->statistics.sdoTransferCount++;
+        pNode->statistics.sdoByteCount += size_p;
+    }
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Check if an SDO transfer of a node is running
+
+\param[in]      nodeId_p            Node ID of the node.
+
+\return The function returns TRUE if an SDO transfer started by
+        \ref simnet_writeObject is still running, otherwise FALSE.
+
+\ingroup module_sim_network
+*/
+//------------------------------------------------------------------------------
+BOOL simnet_isSdoRunning(UINT nodeId_p)
+{
+    if ((nodeId_p > SIMNET_MAX_NODE_ID) || !instance_l.aNode[nodeId_p].fUsed)
+        return FALSE;
+
+    return instance_l.aNode[nodeId_p].fSdoRunning;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Send a non-POWERLINK Ethernet frame from a node
+
+The function passes the frame to the virtual Ethernet queue of a simulated
+node. The frame is copied, it is sent in one of the next asynchronous slots of
+the node when the simulation is run.
+
+\param[in]      nodeId_p            Node ID of the sending node.
+\param[in]      pFrame_p            Pointer to the complete Ethernet frame.
+\param[in]      size_p              Size of the frame.
+
+\return The function returns a tOplkError error code.
+\retval kErrorDllAsyncTxBufferFull  The virtual Ethernet queue of the node is full.
+
+\ingroup module_sim_network
+*/
+//------------------------------------------------------------------------------
+tOplkError simnet_sendEthFrame(UINT nodeId_p,
+                               const void* pFrame_p,
+                               UINT size_p)
+{
+    tOplkError      ret;
+    tSimNetNode*    pNode;
+    UINT64          cpuTime;
+
+    if (!instance_l.fInitialized)
+        return kErrorInvalidOperation;
+
+    if ((nodeId_p > SIMNET_MAX_NODE_ID) || !instance_l.aNode[nodeId_p].fUsed)
+        return kErrorApiInvalidParam;
+
+    pNode = &instance_l.aNode[nodeId_p];
+
+    cpuTime = getCpuTime();
+    ret = pNode->pfnSendEthFrame(pFrame_p, size_p);
+    pNode->pfnProcess();
+    cpuTime = getCpuTime() - cpuTime;
+    pNode->statistics.cpuTime += cpuTime;
+    pNode->statistics.dispatchCount++;
+    instance_l.statistics.cpuTime += cpuTime;
+
+    return ret;
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Initialize the Ethernet driver of a node
+
+\param[in]      simHdl_p            Handle of the simulated node.
+\param[in]      pEdrvInitParam_p    Ethernet driver initialization parameters.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError edrvInit(tSimulationInstanceHdl simHdl_p,
+                           const tEdrvInitParam* pEdrvInitParam_p)
+{
+    tSimNetNode*    pNode = getNode(simHdl_p);
+
+    if ((pNode == NULL) || (pEdrvInitParam_p == NULL))
+        return kErrorEdrvInit;
+
+    pNode->pfnRxHandler = pEdrvInitParam_p->pfnRxHandler;
+    pNode->pFilter = NULL;
+    pNode->filterCount = 0;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Shut down the Ethernet driver of a node
+
+\param[in]      simHdl_p            Handle of the simulated node.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError edrvExit(tSimulationInstanceHdl simHdl_p)
+{
+    tSimNetNode*    pNode = getNode(simHdl_p);
+
+    if (pNode == NULL)
+        return kErrorEdrvInvalidParam;
+
+    pNode->pfnRxHandler = NULL;
+    pNode->pFilter = NULL;
+    pNode->filterCount = 0;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get the MAC address of a node
+
+\param[in]      simHdl_p            Handle of the simulated node.
+
+\return The function returns a pointer to the MAC address.
+*/
+//------------------------------------------------------------------------------
+static const UINT8* edrvGetMacAddr(tSimulationInstanceHdl simHdl_p)
+{
+    tSimNetNode*    pNode = getNode(simHdl_p);
+
+    if (pNode == NULL)
+        return NULL;
+
+    return pNode->aMacAddr;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Send a frame to the hub or switch
+
+The frame occupies the link of the sender for its transmission time. It is
+delivered to every other node whose Rx filters accept it, after the delays of
+the link of the sender and of the link of the receiver. A frame can be lost on
+the link of the sender (then no node receives it) or on the link of a receiver.
+
+The hub repeats the frame to all ports while it is received. The switch
+forwards the frame after it has been received completely. It transmits the
+frames of each port one after another and forwards unicast frames only to the
+port of the addressed node, if it is simulated.
+
+\param[in]      simHdl_p            Handle of the simulated node.
+\param[in,out]  pBuffer_p           Tx buffer descriptor.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError edrvSendTxBuffer(tSimulationInstanceHdl simHdl_p,
+                                   tEdrvTxBuffer* pBuffer_p)
+{
+    tSimNetNode*    pNode = getNode(simHdl_p);
+    tSimNetNode*    pReceiver;
+    tSimNetFrame*   pFrame;
+    tSimNetEvent    event;
+    tSimNetTime     startTime;
+    tSimNetTime     endTime;
+    tSimNetTime     switchRxTime = 0;
+    tSimNetTime     duration;
+    size_t          size;
+    UINT            nodeId;
+    BOOL            fUnicast = FALSE;
+
+    if ((pNode == NULL) || (pBuffer_p == NULL) || (pBuffer_p->pBuffer == NULL))
+        return kErrorEdrvInvalidParam;
+
+    size = pBuffer_p->txFrameSize;
+    if (size > SIMNET_MAX_FRAME_SIZE)
+        return kErrorEdrvInvalidParam;
+
+    // Frames of a node are transmitted one after another
+    startTime = (pNode->txBusyUntil > instance_l.now) ? pNode->txBusyUntil : instance_l.now;
+    duration = getFrameDuration(size);
+    endTime = startTime + duration;
+    pNode->txBusyUntil = endTime;
+    pBuffer_p->txTimeStampNs = startTime;
+
+    countTxFrame(pNode, (const UINT8*)pBuffer_p->pBuffer, size);
+
+    memset(&event, 0, sizeof(event));
+    if (pBuffer_p->pfnTxHandler != NULL)
+    {
+        event.time = endTime;
+        event.type = kSimNetEventTxDone;
+        event.nodeId = pNode->nodeId;
+        event.arg.pTxBuffer = pBuffer_p;
+        pushEvent(&event);
+    }
+
+    if (isFrameLost(&pNode->linkParam))
+    {
+        pNode->statistics.lostFrameCount++;
+        return kErrorOk;
+    }
+
+    pFrame = (tSimNetFrame*)malloc(sizeof(tSimNetFrame) + size);
+    if (pFrame == NULL)
+        return kErrorNoResource;
+
+    pFrame->refCount = 0;
+    pFrame->size = size;
+    memcpy(pFrame->aData, pBuffer_p->pBuffer, size);
+
+    if (instance_l.param.fSwitch)
+    {
+        switchRxTime = endTime + pNode->linkParam.delay + getJitter(&pNode->linkParam);
+        fUnicast = ((pFrame->aData[0] & 0x01) == 0) && (getNodeByMacAddr(pFrame->aData) != NULL);
+    }
+
+    for (nodeId = 0; nodeId <= SIMNET_MAX_NODE_ID; nodeId++)
+    {
+        pReceiver = &instance_l.aNode[nodeId];
+        if (!pReceiver->fUsed || (pReceiver == pNode) || (pReceiver->pfnRxHandler == NULL))
+            continue;
+
+        if (instance_l.param.fSwitch && fUnicast &&
+            (memcmp(pFrame->aData, pReceiver->aMacAddr, sizeof(pReceiver->aMacAddr)) != 0))
+            continue;
+
+        if (instance_l.param.fRxFilter && !isFrameAccepted(pReceiver, pFrame->aData, size))
+        {
+            pReceiver->statistics.filteredFrameCount++;
+            continue;
+        }
+
+        if (isFrameLost(&pReceiver->linkParam))
+        {
+            pReceiver->statistics.lostFrameCount++;
+            continue;
+        }
+
+        if (instance_l.param.fSwitch)
+        {
+            // The frames of a switch port are transmitted one after another
+            if (pReceiver->portBusyUntil > switchRxTime)
+                event.time = pReceiver->portBusyUntil + duration;
+            else
+                event.time = switchRxTime + duration;
+
+            pReceiver->portBusyUntil = event.time;
+        }
+        else
+            event.time = endTime + pNode->linkParam.delay + getJitter(&pNode->linkParam);
+
+        event.time += pReceiver->linkParam.delay + getJitter(&pReceiver->linkParam);
+
+        // Jitter must not reorder the frames on a link
+        if (event.time < pReceiver->lastRxTime)
+            event.time = pReceiver->lastRxTime;
+        pReceiver->lastRxTime = event.time;
+
+        event.type = kSimNetEventFrame;
+        event.nodeId = nodeId;
+        event.arg.pFrame = pFrame;
+        pFrame->refCount++;
+        pushEvent(&event);
+    }
+
+    if (pFrame->refCount == 0)
+        free(pFrame);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Allocate a Tx buffer of a node
+
+\param[in]      simHdl_p            Handle of the simulated node.
+\param[in,out]  pBuffer_p           Tx buffer descriptor.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError edrvAllocTxBuffer(tSimulationInstanceHdl simHdl_p,
+                                    tEdrvTxBuffer* pBuffer_p)
+{
+    if ((getNode(simHdl_p) == NULL) ||
+        (pBuffer_p == NULL) ||
+        (pBuffer_p->maxBufferSize == 0) ||
+        (pBuffer_p->maxBufferSize > SIMNET_MAX_FRAME_SIZE))
+        return kErrorEdrvInvalidParam;
+
+    pBuffer_p->pBuffer = malloc(pBuffer_p->maxBufferSize);
+    if (pBuffer_p->pBuffer == NULL)
+        return kErrorEdrvNoFreeBufEntry;
+
+    memset(pBuffer_p->pBuffer, 0, pBuffer_p->maxBufferSize);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Free a Tx buffer of a node
+
+Pending Tx completions of the buffer are discarded.
+
+\param[in]      simHdl_p            Handle of the simulated node.
+\param[in,out]  pBuffer_p           Tx buffer descriptor.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError edrvFreeTxBuffer(tSimulationInstanceHdl simHdl_p,
+                                   tEdrvTxBuffer* pBuffer_p)
+{
+    UINT    i;
+
+    if ((getNode(simHdl_p) == NULL) || (pBuffer_p == NULL))
+        return kErrorEdrvInvalidParam;
+
+    for (i = 0; i < instance_l.eventCount; i++)
+    {
+        if ((instance_l.aEvent[i].type == kSimNetEventTxDone) &&
+            (instance_l.aEvent[i].arg.pTxBuffer == pBuffer_p))
+            instance_l.aEvent[i].arg.pTxBuffer = NULL;
+    }
+
+    free(pBuffer_p->pBuffer);
+    pBuffer_p->pBuffer = NULL;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Change the Rx filters of a node
+
+The simulator evaluates the filter table of the data link layer directly when
+a frame arrives, therefore only its location is stored.
+
+\param[in]      simHdl_p            Handle of the simulated node.
+\param[in]      pFilter_p           Base pointer of the Rx filter array.
+\param[in]      count_p             Number of Rx filter array entries.
+\param[in]      entryChanged_p      Index of the changed Rx filter entry.
+\param[in]      changeFlags_p       Changed Rx filter properties.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError edrvChangeRxFilter(tSimulationInstanceHdl simHdl_p,
+                                     tEdrvFilter* pFilter_p,
+                                     UINT count_p,
+                                     UINT entryChanged_p,
+                                     UINT changeFlags_p)
+{
+    tSimNetNode*    pNode = getNode(simHdl_p);
+
+    UNUSED_PARAMETER(entryChanged_p);
+    UNUSED_PARAMETER(changeFlags_p);
+
+    if (pNode == NULL)
+        return kErrorEdrvInvalidParam;
+
+    pNode->pFilter = pFilter_p;
+    pNode->filterCount = (pFilter_p != NULL) ? count_p : 0;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Set or clear a multicast address of a node
+
+Multicast frames are selected by the Rx filters, therefore nothing needs to be
+done here.
+
+\param[in]      simHdl_p            Handle of the simulated node.
+\param[in]      pMacAddr_p          Multicast address.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError edrvMulticast(tSimulationInstanceHdl simHdl_p,
+                                const UINT8* pMacAddr_p)
+{
+    UNUSED_PARAMETER(pMacAddr_p);
+
+    return (getNode(simHdl_p) != NULL) ? kErrorOk : kErrorEdrvInvalidParam;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Initialize or shut down the high-resolution timers of a node
+
+\param[in]      simHdl_p            Handle of the simulated node.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError hresTimerInitExit(tSimulationInstanceHdl simHdl_p)
+{
+    return (getNode(simHdl_p) != NULL) ? kErrorOk : kErrorTimerNoTimerCreated;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Start or restart a high-resolution timer of a node
+
+\param[in]      simHdl_p            Handle of the simulated node.
+\param[in,out]  pTimerHdl_p         Pointer to the timer handle.
+\param[in]      time_p              Relative timeout [ns].
+\param[in]      pfnCallback_p       Callback function.
+\param[in]      argument_p          User-specific argument.
+\param[in]      fContinue_p         TRUE for a continuous timer.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError hresTimerModify(tSimulationInstanceHdl simHdl_p,
+                                  tTimerHdl* pTimerHdl_p,
+                                  ULONGLONG time_p,
+                                  tTimerkCallback pfnCallback_p,
+                                  ULONG argument_p,
+                                  BOOL fContinue_p)
+{
+    tSimNetNode*    pNode = getNode(simHdl_p);
+    tSimNetTimer*   pTimer;
+
+    if ((pNode == NULL) || (pTimerHdl_p == NULL))
+        return kErrorTimerInvalidHandle;
+
+    pTimer = getTimer(&pNode->hresTimers, *pTimerHdl_p);
+    if (pTimer == NULL)
+    {
+        pTimer = allocTimer(&pNode->hresTimers);
+        if (pTimer == NULL)
+            return kErrorTimerNoTimerCreated;
+    }
+
+    if (fContinue_p && (time_p < SIMNET_HRES_TIMER_MIN_PERIOD))
+        time_p = SIMNET_HRES_TIMER_MIN_PERIOD;
+
+    pTimer->pfnCallback = pfnCallback_p;
+    pTimer->argument = argument_p;
+    pTimer->fContinue = fContinue_p;
+    pTimer->period = time_p;
+    scheduleTimer(pNode, pTimer, kSimNetEventHresTimer, instance_l.now + time_p);
+
+    *pTimerHdl_p = pTimer->timerHdl;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Delete a high-resolution timer of a node
+
+\param[in]      simHdl_p            Handle of the simulated node.
+\param[in,out]  pTimerHdl_p         Pointer to the timer handle.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError hresTimerDelete(tSimulationInstanceHdl simHdl_p,
+                                  tTimerHdl* pTimerHdl_p)
+{
+    tSimNetNode*    pNode = getNode(simHdl_p);
+    tSimNetTimer*   pTimer;
+
+    if ((pNode == NULL) || (pTimerHdl_p == NULL))
+        return kErrorTimerInvalidHandle;
+
+    pTimer = getTimer(&pNode->hresTimers, *pTimerHdl_p);
+    if (pTimer != NULL)
+        freeTimer(&pNode->hresTimers, pTimer);
+
+    *pTimerHdl_p = 0;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Initialize or shut down the user timers of a node
+
+\param[in]      simHdl_p            Handle of the simulated node.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError userTimerInitExit(tSimulationInstanceHdl simHdl_p)
+{
+    return (getNode(simHdl_p) != NULL) ? kErrorOk : kErrorTimerNoTimerCreated;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Start a user timer of a node
+
+\param[in]      simHdl_p            Handle of the simulated node.
+\param[out]     pTimerHdl_p         Pointer to store the timer handle.
+\param[in]      timeInMs_p          Timeout [ms].
+\param[in]      argument_p          Timer argument.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError userTimerSet(tSimulationInstanceHdl simHdl_p,
+                               tTimerHdl* pTimerHdl_p,
+                               ULONG timeInMs_p,
+                               tTimerArg argument_p)
+{
+    tSimNetNode*    pNode = getNode(simHdl_p);
+    tSimNetTimer*   pTimer;
+
+    if ((pNode == NULL) || (pTimerHdl_p == NULL))
+        return kErrorTimerInvalidHandle;
+
+    pTimer = allocTimer(&pNode->userTimers);
+    if (pTimer == NULL)
+        return kErrorTimerNoTimerCreated;
+
+    pTimer->userArg = argument_p;
+    scheduleTimer(pNode, pTimer, kSimNetEventUserTimer,
+                  instance_l.now + ((tSimNetTime)timeInMs_p * SIMNET_TIME_MS));
+
+    *pTimerHdl_p = pTimer->timerHdl;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Restart a user timer of a node
+
+If the timer has already expired or has been deleted, a new timer is started.
+
+\param[in]      simHdl_p            Handle of the simulated node.
+\param[in,out]  pTimerHdl_p         Pointer to the timer handle.
+\param[in]      timeInMs_p          Timeout [ms].
+\param[in]      argument_p          Timer argument.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError userTimerModify(tSimulationInstanceHdl simHdl_p,
+                                  tTimerHdl* pTimerHdl_p,
+                                  ULONG timeInMs_p,
+                                  tTimerArg argument_p)
+{
+    tSimNetNode*    pNode = getNode(simHdl_p);
+    tSimNetTimer*   pTimer;
+
+    if ((pNode == NULL) || (pTimerHdl_p == NULL))
+        return kErrorTimerInvalidHandle;
+
+    pTimer = getTimer(&pNode->userTimers, *pTimerHdl_p);
+    if (pTimer == NULL)
+        return userTimerSet(simHdl_p, pTimerHdl_p, timeInMs_p, argument_p);
+
+    pTimer->userArg = argument_p;
+    scheduleTimer(pNode, pTimer, kSimNetEventUserTimer,
+                  instance_l.now + ((tSimNetTime)timeInMs_p * SIMNET_TIME_MS));
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Delete a user timer of a node
+
+\param[in]      simHdl_p            Handle of the simulated node.
+\param[in,out]  pTimerHdl_p         Pointer to the timer handle.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError userTimerDelete(tSimulationInstanceHdl simHdl_p,
+                                  tTimerHdl* pTimerHdl_p)
+{
+    tSimNetNode*    pNode = getNode(simHdl_p);
+    tSimNetTimer*   pTimer;
+
+    if ((pNode == NULL) || (pTimerHdl_p == NULL))
+        return kErrorTimerInvalidHandle;
+
+    pTimer = getTimer(&pNode->userTimers, *pTimerHdl_p);
+    if (pTimer != NULL)
+        freeTimer(&pNode->userTimers, pTimer);
+
+    *pTimerHdl_p = 0;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Check if a user timer of a node is running
+
+\param[in]      simHdl_p            Handle of the simulated node.
+\param[in]      timerHdl_p          Timer handle.
+
+\return The function returns TRUE if the timer is running.
+*/
+//------------------------------------------------------------------------------
+static BOOL userTimerIsActive(tSimulationInstanceHdl simHdl_p,
+                              tTimerHdl timerHdl_p)
+{
+    tSimNetNode*    pNode = getNode(simHdl_p);
+
+    if (pNode == NULL)
+        return FALSE;
+
+    return (getTimer(&pNode->userTimers, timerHdl_p) != NULL);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Initialize or shut down the target functions of a node
+
+\param[in]      simHdl_p            Handle of the simulated node.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError targetInitExit(tSimulationInstanceHdl simHdl_p)
+{
+    return (getNode(simHdl_p) != NULL) ? kErrorOk : kErrorNoResource;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Sleep function of a node
+
+All nodes are executed in the same thread, therefore a node cannot wait for
+other nodes. The call returns immediately without advancing the virtual time.
+
+\param[in]      simHdl_p            Handle of the simulated node.
+\param[in]      milliSeconds_p      Number of milliseconds to sleep.
+*/
+//------------------------------------------------------------------------------
+static void targetMsleep(tSimulationInstanceHdl simHdl_p,
+                         UINT32 milliSeconds_p)
+{
+    UNUSED_PARAMETER(simHdl_p);
+    UNUSED_PARAMETER(milliSeconds_p);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Set the IP address of a node
+
+The simulated nodes have no IP stack, therefore the call is ignored.
+
+\param[in]      simHdl_p            Handle of the simulated node.
+\param[in]      ifName_p            Name of the Ethernet interface.
+\param[in]      ipAddress_p         IP address.
+\param[in]      subnetMask_p        Subnet mask.
+\param[in]      mtu_p               MTU.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError targetSetIp(tSimulationInstanceHdl simHdl_p,
+                              const char* ifName_p,
+                              UINT32 ipAddress_p,
+                              UINT32 subnetMask_p,
+                              UINT16 mtu_p)
+{
+    UNUSED_PARAMETER(ifName_p);
+    UNUSED_PARAMETER(ipAddress_p);
+    UNUSED_PARAMETER(subnetMask_p);
+    UNUSED_PARAMETER(mtu_p);
+
+    return (getNode(simHdl_p) != NULL) ? kErrorOk : kErrorNoResource;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Set the default gateway of a node
+
+The simulated nodes have no IP stack, therefore the call is ignored.
+
+\param[in]      simHdl_p            Handle of the simulated node.
+\param[in]      defaultGateway_p    Default gateway.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError targetSetDefaultGateway(tSimulationInstanceHdl simHdl_p,
+                                          UINT32 defaultGateway_p)
+{
+    UNUSED_PARAMETER(defaultGateway_p);
+
+    return (getNode(simHdl_p) != NULL) ? kErrorOk : kErrorNoResource;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get the tick count of a node
+
+\param[in]      simHdl_p            Handle of the simulated node.
+
+\return The function returns the virtual time in milliseconds.
+*/
+//------------------------------------------------------------------------------
+static UINT32 targetGetTick(tSimulationInstanceHdl simHdl_p)
+{
+    UNUSED_PARAMETER(simHdl_p);
+
+    return (UINT32)(instance_l.now / SIMNET_TIME_MS);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Set an LED of a node
+
+\param[in]      simHdl_p            Handle of the simulated node.
+\param[in]      ledType_p           LED to be set.
+\param[in]      fLedOn_p            TRUE to switch the LED on.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError targetSetLed(tSimulationInstanceHdl simHdl_p,
+                               tLedType ledType_p,
+                               BOOL fLedOn_p)
+{
+    UNUSED_PARAMETER(ledType_p);
+    UNUSED_PARAMETER(fLedOn_p);
+
+    return (getNode(simHdl_p) != NULL) ? kErrorOk : kErrorNoResource;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Print a trace message of a node
+
+\param[in]      simHdl_p            Handle of the simulated node.
+\param[in]      pMessage_p          Trace message.
+*/
+//------------------------------------------------------------------------------
+static void traceMessage(tSimulationInstanceHdl simHdl_p,
+                         const char* pMessage_p)
+{
+    if (!instance_l.param.fTrace || (pMessage_p == NULL))
+        return;
+
+    printf("%4llu.%06llu [%3u] %s",
+           (unsigned long long)(instance_l.now / SIMNET_TIME_S),
+           (unsigned long long)((instance_l.now % SIMNET_TIME_S) / SIMNET_TIME_US),
+           (UINT)simHdl_p,
+           pMessage_p);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  API event callback of a node
+
+The function tracks the NMT state and the SDO transfers of the node and
+reports critical errors.
+
+\param[in]      simHdl_p            Handle of the simulated node.
+\param[in]      eventType_p         Type of the event.
+\param[in]      pEventArg_p         Pointer to the event argument.
+\param[in]      pUserArg_p          Pointer to the user defined argument.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError apiEvent(tSimulationInstanceHdl simHdl_p,
+                           tOplkApiEventType eventType_p,
+                           const tOplkApiEventArg* pEventArg_p,
+                           void* pUserArg_p)
+{
+    tSimNetNode*    pNode = getNode(simHdl_p);
+
+    UNUSED_PARAMETER(pUserArg_p);
+
+    if ((pNode == NULL) || (pEventArg_p == NULL))
+        return kErrorOk;
+
+    switch (eventType_p)
+    {
+        case kOplkApiEventNmtStateChange:
+            pNode->statistics.nmtState = pEventArg_p->nmtStateChange.newNmtState;
+            if (((pNode->statistics.nmtState == kNmtMsOperational) ||
+                 (pNode->statistics.nmtState == kNmtCsOperational)) &&
+                (pNode->statistics.operationalTime == 0))
+                pNode->statistics.operationalTime = instance_l.now;
+            break;
+
+        case kOplkApiEventSdo:
+            if (!pNode->fSdoRunning)
+                break;
+
+            pNode->fSdoRunning = FALSE;
+            if ((pEventArg_p->sdoInfo.sdoComConState == kSdoComTransferFinished) &&
+                (pEventArg_p->sdoInfo.abortCode == 0))
+            {
+                pNode->statistics.sdoTransferCount++;
+                pNode->statistics.sdoByteCount += pEventArg_p->sdoInfo.transferredBytes;
+            }
+            else
+            {
+                pNode->statistics.sdoAbortCount++;
+                pNode->statistics.sdoAbortCode = pEventArg_p->sdoInfo.abortCode;
+            }
+            break;
+
+        case kOplkApiEventCriticalError:
+            fprintf(stderr, "Node %u: critical error 0x%04X\n",
+                    pNode->nodeId,
+                    pEventArg_p->internalError.oplkError);
+            break;
+
+        default:
+            break;
+    }
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Process sync callback of a node
+
+The simulated nodes have no process image, therefore nothing is exchanged.
+
+\param[in]      simHdl_p            Handle of the simulated node.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError processSync(tSimulationInstanceHdl simHdl_p)
+{
+    UNUSED_PARAMETER(simHdl_p);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get a simulated node
+
+\param[in]      simHdl_p            Handle of the simulated node.
+
+\return The function returns a pointer to the node or NULL if the handle is
+        invalid.
+*/
+//------------------------------------------------------------------------------
+static tSimNetNode* getNode(tSimulationInstanceHdl simHdl_p)
+{
+    if ((simHdl_p > SIMNET_MAX_NODE_ID) || !instance_l.aNode[simHdl_p].fUsed)
+        return NULL;
+
+    return &instance_l.aNode[simHdl_p];
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get the node with a MAC address
+
+\param[in]      pMacAddr_p          MAC address.
+
+\return The function returns a pointer to the node or NULL if no simulated node
+        has the MAC address.
+*/
+//------------------------------------------------------------------------------
+static tSimNetNode* getNodeByMacAddr(const UINT8* pMacAddr_p)
+{
+    UINT    nodeId;
+
+    for (nodeId = 0; nodeId <= SIMNET_MAX_NODE_ID; nodeId++)
+    {
+        if (instance_l.aNode[nodeId].fUsed &&
+            (memcmp(instance_l.aNode[nodeId].aMacAddr, pMacAddr_p, 6) == 0))
+            return &instance_l.aNode[nodeId];
+    }
+
+    return NULL;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Load a private copy of a node module
+
+The dynamic loader maps a file only once, therefore the module is copied to a
+temporary file which is loaded and removed again. Every node gets its own
+copy of all stack instance variables this way.
+
+\param[in,out]  pNode_p             Pointer to the node.
+\param[in]      pModuleFile_p       File name of the node module.
+\param[out]     ppfnInit_p          Pointer to store the init function of the
+                                    module.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError loadModule(tSimNetNode* pNode_p,
+                             const char* pModuleFile_p,
+                             tSimNodeInitFunc* ppfnInit_p)
+{
+    char        aFileName[256];
+    char        aBuffer[4096];
+    int         fdIn;
+    int         fdOut;
+    ssize_t     count;
+    BOOL        fCopied = TRUE;
+
+    snprintf(aFileName, sizeof(aFileName), "%s/simnode-%03u-XXXXXX",
+             instance_l.param.pTempDir,
+             pNode_p->nodeId);
+
+    fdIn = open(pModuleFile_p, O_RDONLY);
+    if (fdIn < 0)
+    {
+        fprintf(stderr, "Couldn't open node module %s (%s)\n", pModuleFile_p, strerror(errno));
+        return kErrorNoResource;
+    }
+
+    fdOut = mkstemp(aFileName);
+    if (fdOut < 0)
+    {
+        fprintf(stderr, "Couldn't create %s (%s)\n", aFileName, strerror(errno));
+        close(fdIn);
+        return kErrorNoResource;
+    }
+
+    while ((count = read(fdIn, aBuffer, sizeof(aBuffer))) > 0)
+    {
+        if (write(fdOut, aBuffer, (size_t)count) != count)
+        {
+            fCopied = FALSE;
+            break;
+        }
+    }
+
+    if (count < 0)
+        fCopied = FALSE;
+
+    close(fdIn);
+    close(fdOut);
+
+    if (fCopied)
+        pNode_p->pModule = dlopen(aFileName, RTLD_NOW | RTLD_LOCAL);
+
+    unlink(aFileName);
+
+    if (pNode_p->pModule == NULL)
+    {
+        fprintf(stderr, "Couldn't load node module %s (%s)\n",
+                pModuleFile_p,
+                fCopied ? dlerror() : strerror(errno));
+        return kErrorNoResource;
+    }
+
+    // POSIX guarantees that function pointers can be converted this way
+    *(void**)ppfnInit_p = dlsym(pNode_p->pModule, SIMNODE_FUNC_INIT);
+    *(void**)&pNode_p->pfnExit = dlsym(pNode_p->pModule, SIMNODE_FUNC_EXIT);
+    *(void**)&pNode_p->pfnProcess = dlsym(pNode_p->pModule, SIMNODE_FUNC_PROCESS);
+    *(void**)&pNode_p->pfnUserTimerCallback = dlsym(pNode_p->pModule, SIMNODE_FUNC_USER_TIMER_CALLBACK);
+    *(void**)&pNode_p->pfnWriteObject = dlsym(pNode_p->pModule, SIMNODE_FUNC_WRITE_OBJECT);
+    *(void**)&pNode_p->pfnSendEthFrame = dlsym(pNode_p->pModule, SIMNODE_FUNC_SEND_ETH_FRAME);
+
+    if ((*ppfnInit_p == NULL) ||
+        (pNode_p->pfnExit == NULL) ||
+        (pNode_p->pfnProcess == NULL) ||
+        (pNode_p->pfnUserTimerCallback == NULL) ||
+        (pNode_p->pfnWriteObject == NULL) ||
+        (pNode_p->pfnSendEthFrame == NULL))
+    {
+        fprintf(stderr, "%s is no node module\n", pModuleFile_p);
+        dlclose(pNode_p->pModule);
+        pNode_p->pModule = NULL;
+        return kErrorNoResource;
+    }
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Remove a node from the simulation
+
+The function shuts down the stack of the node and unloads its module. Pending
+events of the node are discarded when they become due.
+
+\param[in,out]  pNode_p             Pointer to the node.
+*/
+//------------------------------------------------------------------------------
+static void removeNode(tSimNetNode* pNode_p)
+{
+    if (pNode_p->pfnExit != NULL)
+        pNode_p->pfnExit();
+
+    if (pNode_p->pModule != NULL)
+        dlclose(pNode_p->pModule);
+
+    free(pNode_p->hresTimers.aTimer);
+    free(pNode_p->userTimers.aTimer);
+
+    memset(pNode_p, 0, sizeof(*pNode_p));
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Set up the simulation interface functions of a node
+
+\param[out]     pInitParam_p        Pointer to the node initialization parameters.
+*/
+//------------------------------------------------------------------------------
+static void initNodeFunctions(tSimNodeInitParam* pInitParam_p)
+{
+    pInitParam_p->edrvFunctions.pfnInit = edrvInit;
+    pInitParam_p->edrvFunctions.pfnExit = edrvExit;
+    pInitParam_p->edrvFunctions.pfnGetMacAddr = edrvGetMacAddr;
+    pInitParam_p->edrvFunctions.pfnSendTxBuffer = edrvSendTxBuffer;
+    pInitParam_p->edrvFunctions.pfnAllocTxBuffer = edrvAllocTxBuffer;
+    pInitParam_p->edrvFunctions.pfnFreeTxBuffer = edrvFreeTxBuffer;
+    pInitParam_p->edrvFunctions.pfnChangeRxFilter = edrvChangeRxFilter;
+    pInitParam_p->edrvFunctions.pfnSetMulticastMacAddr = edrvMulticast;
+    pInitParam_p->edrvFunctions.pfnClearMulticastMacAddr = edrvMulticast;
+
+    pInitParam_p->hresTimerFunctions.pfnInitHresTimer = hresTimerInitExit;
+    pInitParam_p->hresTimerFunctions.pfnExitHresTimer = hresTimerInitExit;
+    pInitParam_p->hresTimerFunctions.pfnModifyHresTimer = hresTimerModify;
+    pInitParam_p->hresTimerFunctions.pfnDeleteHresTimer = hresTimerDelete;
+
+    pInitParam_p->timerFunctions.pfnInitTimer = userTimerInitExit;
+    pInitParam_p->timerFunctions.pfnExitTimer = userTimerInitExit;
+    pInitParam_p->timerFunctions.pfnSetTimer = userTimerSet;
+    pInitParam_p->timerFunctions.pfnModifyTimer = userTimerModify;
+    pInitParam_p->timerFunctions.pfnDeleteTimer = userTimerDelete;
+    pInitParam_p->timerFunctions.pfnIsTimerActive = userTimerIsActive;
+
+    pInitParam_p->targetFunctions.pfnInit = targetInitExit;
+    pInitParam_p->targetFunctions.pfnExit = targetInitExit;
+    pInitParam_p->targetFunctions.pfnMsleep = targetMsleep;
+    pInitParam_p->targetFunctions.pfnSetIp = targetSetIp;
+    pInitParam_p->targetFunctions.pfnSetDefaultGateway = targetSetDefaultGateway;
+    pInitParam_p->targetFunctions.pfnGetTick = targetGetTick;
+    pInitParam_p->targetFunctions.pfnSetLed = targetSetLed;
+
+    pInitParam_p->traceFunctions.pfnTrace = traceMessage;
+
+    pInitParam_p->apiEventFunctions.pfnCbEvent = apiEvent;
+
+    pInitParam_p->processSyncFunctions.pfnCbProcessSync = processSync;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get the transmission time of a frame
+
+\param[in]      size_p              Size of the frame (without CRC).
+
+\return The function returns the time the frame occupies the link [ns].
+*/
+//------------------------------------------------------------------------------
+static tSimNetTime getFrameDuration(size_t size_p)
+{
+    if (size_p < SIMNET_MIN_FRAME_SIZE)
+        size_p = SIMNET_MIN_FRAME_SIZE;
+
+    return (tSimNetTime)(size_p + SIMNET_FRAME_OVERHEAD) * 8 * SIMNET_BIT_TIME;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Check if a frame passes the Rx filters of a node
+
+The Rx filters are evaluated like the Linux Ethernet drivers do it: An entry is
+used if it is enabled or if it carries an auto-response frame, because the
+data link layer handles auto-responses in software. The MN additionally
+receives all PRes frames.
+
+\param[in]      pNode_p             Pointer to the receiving node.
+\param[in]      pData_p             Pointer to the frame data.
+\param[in]      size_p              Size of the frame.
+
+\return The function returns TRUE if the frame is accepted.
+*/
+//------------------------------------------------------------------------------
+static BOOL isFrameAccepted(const tSimNetNode* pNode_p,
+                            const UINT8* pData_p,
+                            size_t size_p)
+{
+    const tEdrvFilter*  pFilter;
+    UINT                entry;
+    UINT                offset;
+
+    if ((pNode_p->nodeId == C_ADR_MN_DEF_NODE_ID) &&
+        (size_p > 14) &&
+        (getEtherType(pData_p) == C_DLL_ETHERTYPE_EPL) &&
+        (pData_p[14] == kMsgTypePres))
+        return TRUE;
+
+    for (entry = 0; entry < pNode_p->filterCount; entry++)
+    {
+        pFilter = &pNode_p->pFilter[entry];
+        if (!pFilter->fEnable && (pFilter->pTxBuffer == NULL))
+            continue;
+
+        for (offset = 0; offset < SIMNET_FILTER_SIZE; offset++)
+        {
+            if (pFilter->aFilterMask[offset] == 0)
+                continue;
+
+            if ((offset >= size_p) ||
+                ((pData_p[offset] & pFilter->aFilterMask[offset]) !=
+                 (pFilter->aFilterValue[offset] & pFilter->aFilterMask[offset])))
+                break;
+        }
+
+        if (offset == SIMNET_FILTER_SIZE)
+            return TRUE;
+    }
+
+    return FALSE;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Decide if a frame is lost on a link
+
+\param[in]      pLinkParam_p        Pointer to the link parameters.
+
+\return The function returns TRUE if the frame is lost.
+*/
+//------------------------------------------------------------------------------
+static BOOL isFrameLost(const tSimNetLinkParam* pLinkParam_p)
+{
+    if (pLinkParam_p->lossPpm == 0)
+        return FALSE;
+
+    return ((getRandom() % 1000000) < pLinkParam_p->lossPpm);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get the random delay of a frame on a link
+
+\param[in]      pLinkParam_p        Pointer to the link parameters.
+
+\return The function returns the random delay [ns].
+*/
+//------------------------------------------------------------------------------
+static UINT32 getJitter(const tSimNetLinkParam* pLinkParam_p)
+{
+    if (pLinkParam_p->jitter == 0)
+        return 0;
+
+    return (UINT32)(getRandom() % ((UINT64)pLinkParam_p->jitter + 1));
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get the Ethertype of a frame
+
+The simulator is not linked to a stack, therefore the frame is decoded here.
+
+\param[in]      pData_p             Pointer to the frame data.
+
+\return The function returns the Ethertype.
+*/
+//------------------------------------------------------------------------------
+static UINT16 getEtherType(const UINT8* pData_p)
+{
+    return (UINT16)((pData_p[12] << 8) | pData_p[13]);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Count a transmitted frame
+
+\param[in,out]  pNode_p             Pointer to the sending node.
+\param[in]      pData_p             Pointer to the frame data.
+\param[in]      size_p              Size of the frame.
+*/
+//------------------------------------------------------------------------------
+static void countTxFrame(tSimNetNode* pNode_p,
+                         const UINT8* pData_p,
+                         size_t size_p)
+{
+    BOOL    fPlkFrame;
+
+    pNode_p->statistics.txFrameCount++;
+    pNode_p->statistics.txByteCount += size_p;
+    instance_l.statistics.frameCount++;
+
+    fPlkFrame = ((size_p > 14) && (getEtherType(pData_p) == C_DLL_ETHERTYPE_EPL));
+
+    if (fPlkFrame && (pData_p[14] == kMsgTypeSoc))
+        instance_l.statistics.cycleCount++;
+
+    if (!fPlkFrame || (pData_p[14] == kMsgTypeAsnd))
+    {
+        pNode_p->statistics.asyncTxFrameCount++;
+        pNode_p->statistics.asyncTxByteCount += size_p;
+        instance_l.statistics.asyncFrameCount++;
+        instance_l.statistics.asyncByteCount += size_p;
+    }
+
+    if (!fPlkFrame)
+    {
+        pNode_p->statistics.ethTxFrameCount++;
+        pNode_p->statistics.ethTxByteCount += size_p;
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Pass a received frame to a node
+
+The frame is copied to a separate Rx buffer, because the frame data is shared
+by all receivers.
+
+\param[in,out]  pNode_p             Pointer to the receiving node.
+\param[in]      pFrame_p            Pointer to the frame.
+*/
+//------------------------------------------------------------------------------
+static void receiveFrame(tSimNetNode* pNode_p,
+                         const tSimNetFrame* pFrame_p)
+{
+    tEdrvRxBuffer   rxBuffer;
+    tTimestamp      timestamp;
+
+    if (pNode_p->pfnRxHandler == NULL)
+        return;
+
+    memcpy(instance_l.aRxBuffer, pFrame_p->aData, pFrame_p->size);
+
+    timestamp.timeStamp = (TIME_STAMP_T)instance_l.now;
+
+    rxBuffer.bufferInFrame = kEdrvBufferLastInFrame;
+    rxBuffer.rxFrameSize = pFrame_p->size;
+    rxBuffer.pBuffer = instance_l.aRxBuffer;
+    rxBuffer.pRxTimeStamp = &timestamp;
+
+    pNode_p->statistics.rxFrameCount++;
+    pNode_p->statistics.rxByteCount += pFrame_p->size;
+
+    pNode_p->pfnRxHandler(&rxBuffer);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get a pseudo random number
+
+The function implements a xorshift64* generator, so that a simulation run can
+be repeated with the same seed.
+
+\return The function returns a 64 bit pseudo random number.
+*/
+//------------------------------------------------------------------------------
+static UINT64 getRandom(void)
+{
+    UINT64  x = instance_l.randomState;
+
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    instance_l.randomState = x;
+
+    return x * 0x2545F4914F6CDD1DULL;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Allocate a timer
+
+The timer pool grows on demand. The timer handle contains the index of the
+timer and its generation, so that handles of freed timers become invalid.
+
+\param[in,out]  pPool_p             Pointer to the timer pool.
+
+\return The function returns a pointer to the timer or NULL if no memory is
+        available.
+*/
+//------------------------------------------------------------------------------
+static tSimNetTimer* allocTimer(tSimNetTimerPool* pPool_p)
+{
+    tSimNetTimer*   pTimer;
+    tSimNetTimer*   aTimer;
+    UINT            index;
+    UINT            count;
+
+    if (pPool_p->firstFree == 0)
+    {
+        count = pPool_p->count + SIMNET_TIMER_POOL_GROW;
+        if (count > SIMNET_TIMER_INDEX_MASK)
+            return NULL;
+
+        aTimer = (tSimNetTimer*)realloc(pPool_p->aTimer, count * sizeof(tSimNetTimer));
+        if (aTimer == NULL)
+            return NULL;
+
+        memset(&aTimer[pPool_p->count], 0, SIMNET_TIMER_POOL_GROW * sizeof(tSimNetTimer));
+        for (index = pPool_p->count; index < count; index++)
+            aTimer[index].nextFree = (index + 1 < count) ? (index + 2) : 0;
+
+        pPool_p->aTimer = aTimer;
+        pPool_p->firstFree = pPool_p->count + 1;
+        pPool_p->count = count;
+    }
+
+    index = pPool_p->firstFree - 1;
+    pTimer = &pPool_p->aTimer[index];
+    pPool_p->firstFree = pTimer->nextFree;
+
+    pTimer->fUsed = TRUE;
+    pTimer->nextFree = 0;
+    pTimer->timerHdl = ((tTimerHdl)pTimer->generation << SIMNET_TIMER_INDEX_BITS) | (index + 1);
+
+    return pTimer;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Free a timer
+
+A pending expiration of the timer is discarded when it becomes due.
+
+\param[in,out]  pPool_p             Pointer to the timer pool.
+\param[in,out]  pTimer_p            Pointer to the timer.
+*/
+//------------------------------------------------------------------------------
+static void freeTimer(tSimNetTimerPool* pPool_p,
+                      tSimNetTimer* pTimer_p)
+{
+    pTimer_p->fUsed = FALSE;
+    pTimer_p->generation++;
+    pTimer_p->timerHdl = 0;
+    pTimer_p->nextFree = pPool_p->firstFree;
+    pPool_p->firstFree = (UINT)(pTimer_p - pPool_p->aTimer) + 1;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get a running timer by its handle
+
+\param[in]      pPool_p             Pointer to the timer pool.
+\param[in]      timerHdl_p          Timer handle.
+
+\return The function returns a pointer to the timer or NULL if the handle is
+        invalid.
+*/
+//------------------------------------------------------------------------------
+static tSimNetTimer* getTimer(const tSimNetTimerPool* pPool_p,
+                              tTimerHdl timerHdl_p)
+{
+    UINT    index = (UINT)(timerHdl_p & SIMNET_TIMER_INDEX_MASK);
+
+    if ((index == 0) || (index > pPool_p->count))
+        return NULL;
+
+    if (!pPool_p->aTimer[index - 1].fUsed || (pPool_p->aTimer[index - 1].timerHdl != timerHdl_p))
+        return NULL;
+
+    return &pPool_p->aTimer[index - 1];
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Schedule the expiration of a timer
+
+A previously scheduled expiration of the timer becomes stale.
+
+\param[in]      pNode_p             Pointer to the node.
+\param[in,out]  pTimer_p            Pointer to the timer.
+\param[in]      type_p              Event type of the timer.
+\param[in]      time_p              Virtual time of the expiration.
+*/
+//------------------------------------------------------------------------------
+static void scheduleTimer(tSimNetNode* pNode_p,
+                          tSimNetTimer* pTimer_p,
+                          tSimNetEventType type_p,
+                          tSimNetTime time_p)
+{
+    tSimNetEvent    event;
+
+    memset(&event, 0, sizeof(event));
+    event.time = time_p;
+    event.type = type_p;
+    event.nodeId = pNode_p->nodeId;
+    event.arg.timerHdl = pTimer_p->timerHdl;
+
+    pTimer_p->eventSeq = pushEvent(&event);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Expire a high-resolution timer
+
+\param[in,out]  pNode_p             Pointer to the node.
+\param[in]      pEvent_p            Pointer to the expiration event.
+
+\return The function returns TRUE if the timer expired or FALSE if the event
+        was stale.
+*/
+//------------------------------------------------------------------------------
+static BOOL expireHresTimer(tSimNetNode* pNode_p,
+                            const tSimNetEvent* pEvent_p)
+{
+    tSimNetTimer*   pTimer;
+    tTimerEventArg  eventArg;
+    tTimerkCallback pfnCallback;
+
+    pTimer = getTimer(&pNode_p->hresTimers, pEvent_p->arg.timerHdl);
+    if ((pTimer == NULL) || (pTimer->eventSeq != pEvent_p->seq))
+        return FALSE;
+
+    memset(&eventArg, 0, sizeof(eventArg));
+    eventArg.timerHdl.handle = pTimer->timerHdl;
+    eventArg.argument.value = (UINT32)pTimer->argument;
+    pfnCallback = pTimer->pfnCallback;
+
+    if (pTimer->fContinue)
+        scheduleTimer(pNode_p, pTimer, kSimNetEventHresTimer, pEvent_p->time + pTimer->period);
+    else
+        freeTimer(&pNode_p->hresTimers, pTimer);
+
+    if (pfnCallback != NULL)
+        pfnCallback(&eventArg);
+
+    return TRUE;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Expire a user timer
+
+\param[in,out]  pNode_p             Pointer to the node.
+\param[in]      pEvent_p            Pointer to the expiration event.
+
+\return The function returns TRUE if the timer expired or FALSE if the event
+        was stale.
+*/
+//------------------------------------------------------------------------------
+static BOOL expireUserTimer(tSimNetNode* pNode_p,
+                            const tSimNetEvent* pEvent_p)
+{
+    tSimNetTimer*   pTimer;
+    tTimerHdl       timerHdl;
+    tTimerArg       userArg;
+
+    pTimer = getTimer(&pNode_p->userTimers, pEvent_p->arg.timerHdl);
+    if ((pTimer == NULL) || (pTimer->eventSeq != pEvent_p->seq))
+        return FALSE;
+
+    timerHdl = pTimer->timerHdl;
+    userArg = pTimer->userArg;
+    freeTimer(&pNode_p->userTimers, pTimer);
+
+    pNode_p->pfnUserTimerCallback(timerHdl, userArg);
+
+    return TRUE;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Add an event to the event queue
+
+\param[in]      pEvent_p            Pointer to the event. The sequence number
+                                    is assigned by the function.
+
+\return The function returns the sequence number of the event.
+*/
+//------------------------------------------------------------------------------
+static UINT64 pushEvent(const tSimNetEvent* pEvent_p)
+{
+    tSimNetEvent*   aEvent;
+    tSimNetEvent    event;
+    UINT            index;
+    UINT            parent;
+
+    if (instance_l.eventCount == instance_l.eventQueueSize)
+    {
+        aEvent = (tSimNetEvent*)realloc(instance_l.aEvent,
+                                        (instance_l.eventQueueSize + SIMNET_EVENT_QUEUE_GROW) *
+                                        sizeof(tSimNetEvent));
+        if (aEvent == NULL)
+        {
+            // The simulation cannot continue deterministically without the event
+            fprintf(stderr, "%s(): out of memory\n", __func__);
+            abort();
+        }
+
+        instance_l.aEvent = aEvent;
+        instance_l.eventQueueSize += SIMNET_EVENT_QUEUE_GROW;
+    }
+
+    event = *pEvent_p;
+    event.seq = instance_l.nextSeq++;
+
+    index = instance_l.eventCount++;
+    while (index > 0)
+    {
+        parent = (index - 1) / 2;
+        if (!isEventBefore(&event, &instance_l.aEvent[parent]))
+            break;
+
+        instance_l.aEvent[index] = instance_l.aEvent[parent];
+        index = parent;
+    }
+
+    instance_l.aEvent[index] = event;
+
+    return event.seq;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Remove the earliest event from the event queue
+
+\param[out]     pEvent_p            Pointer to store the event.
+*/
+//------------------------------------------------------------------------------
+static void popEvent(tSimNetEvent* pEvent_p)
+{
+    tSimNetEvent    last;
+    UINT            index = 0;
+    UINT            child;
+
+    *pEvent_p = instance_l.aEvent[0];
+
+    last = instance_l.aEvent[--instance_l.eventCount];
+    for (;;)
+    {
+        child = (2 * index) + 1;
+        if (child >= instance_l.eventCount)
+            break;
+
+        if (((child + 1) < instance_l.eventCount) &&
+            isEventBefore(&instance_l.aEvent[child + 1], &instance_l.aEvent[child]))
+            child++;
+
+        if (!isEventBefore(&instance_l.aEvent[child], &last))
+            break;
+
+        instance_l.aEvent[index] = instance_l.aEvent[child];
+        index = child;
+    }
+
+    if (instance_l.eventCount > 0)
+        instance_l.aEvent[index] = last;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Compare two events
+
+Events with the same time are ordered by their sequence number, so that the
+order of processing never depends on the heap layout.
+
+\param[in]      pEvent1_p           Pointer to the first event.
+\param[in]      pEvent2_p           Pointer to the second event.
+
+\return The function returns TRUE if the first event is processed before the
+        second one.
+*/
+//------------------------------------------------------------------------------
+static BOOL isEventBefore(const tSimNetEvent* pEvent1_p,
+                          const tSimNetEvent* pEvent2_p)
+{
+    if (pEvent1_p->time != pEvent2_p->time)
+        return (pEvent1_p->time < pEvent2_p->time);
+
+    return (pEvent1_p->seq < pEvent2_p->seq);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Process an event
+
+The function passes the event to its node. Afterwards the background
+processing of the node is executed, like the main loop of an application would
+do it. The host CPU time spent in the node is added to its statistics.
+
+\param[in]      pEvent_p            Pointer to the event.
+*/
+//------------------------------------------------------------------------------
+static void processEvent(const tSimNetEvent* pEvent_p)
+{
+    tSimNetNode*    pNode = &instance_l.aNode[pEvent_p->nodeId];
+    tSimNetFrame*   pFrame = NULL;
+    tSimNetEvent    event;
+    UINT64          cpuTime;
+    BOOL            fDispatched = TRUE;
+
+    if (pEvent_p->type == kSimNetEventFrame)
+        pFrame = pEvent_p->arg.pFrame;
+
+    if (!pNode->fUsed)
+        goto Exit;
+
+    cpuTime = getCpuTime();
+
+    switch (pEvent_p->type)
+    {
+        case kSimNetEventFrame:
+            receiveFrame(pNode, pFrame);
+            break;
+
+        case kSimNetEventTxDone:
+            if ((pEvent_p->arg.pTxBuffer != NULL) && (pEvent_p->arg.pTxBuffer->pfnTxHandler != NULL))
+                pEvent_p->arg.pTxBuffer->pfnTxHandler(pEvent_p->arg.pTxBuffer);
+            else
+                fDispatched = FALSE;
+            break;
+
+        case kSimNetEventHresTimer:
+            fDispatched = expireHresTimer(pNode, pEvent_p);
+            break;
+
+        case kSimNetEventUserTimer:
+            fDispatched = expireUserTimer(pNode, pEvent_p);
+            break;
+
+        case kSimNetEventProcess:
+            event = *pEvent_p;
+            event.time += instance_l.param.processInterval;
+            pushEvent(&event);
+            break;
+
+        default:
+            fDispatched = FALSE;
+            break;
+    }
+
+    if (fDispatched)
+    {
+        pNode->pfnProcess();
+
+        cpuTime = getCpuTime() - cpuTime;
+        pNode->statistics.cpuTime += cpuTime;
+        pNode->statistics.dispatchCount++;
+        instance_l.statistics.cpuTime += cpuTime;
+    }
+
+Exit:
+    if ((pFrame != NULL) && (--pFrame->refCount == 0))
+        free(pFrame);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get the host CPU time of the simulation thread
+
+\return The function returns the CPU time [ns].
+*/
+//------------------------------------------------------------------------------
+static UINT64 getCpuTime(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+
+    return ((UINT64)ts.tv_sec * SIMNET_TIME_S) + (UINT64)ts.tv_nsec;
+}
+
+/// \}
@@ -0,0 +1,398 @@
+/**
+********************************************************************************
+\file   simnode.c
+
+\brief  Simulated node module
+
+This file contains the glue code of a simulated node. It is linked together
+with an openPOWERLINK stack library built for the simulation interface and an
+object dictionary into a shared module. The network simulator loads a private
+copy of this module for every simulated node and controls the node by the
+functions exported here.
+
+\ingroup module_sim_network
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2017, B&R Industrial Automation GmbH
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <oplk/oplk.h>
+#include <sim-api.h>
+#include <sim-apievent.h>
+#include <sim-edrv.h>
+#include <sim-hrestimer.h>
+#include <sim-processsync.h>
+#include <sim-target.h>
+#include <sim-timer.h>
+#include <sim-trace.h>
+
+#include <obdcreate/obdcreate.h>
+
+#include <simnode.h>
+
+#include <stdio.h>
+#include <string.h>
+#include <limits.h>
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define SIMNODE_IP_ADDR                     0xc0a86400      // 192.168.100.0
+#define SIMNODE_SUBNET_MASK                 0xFFFFFF00      // 255.255.255.0
+#define SIMNODE_DEFAULT_GATEWAY             0xC0A864FE      // 192.168.100.C_ADR_RT1_DEF_NODE_ID
+#define SIMNODE_DEV_NAME                    "simnet"        // Name of the simulated network interface
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static BOOL            fStackCreated_l = FALSE;
+static tSdoComConHdl   sdoComConHdl_l = 0;
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static BOOL setSimulationFunctions(const tSimNodeInitParam* pInitParam_p);
+static void unsetSimulationFunctions(void);
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Initialize the simulated node
+
+The function connects the stack of the node to the network simulator, creates
+the stack with its object dictionary and starts it by a software reset.
+
+\param[in]      pInitParam_p        Pointer to the initialization parameters.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_sim_network
+*/
+//------------------------------------------------------------------------------
+tOplkError simnode_init(const tSimNodeInitParam* pInitParam_p)
+{
+    tOplkError          ret;
+    tOplkApiInitParam   initParam;
+
+    if (pInitParam_p == NULL)
+        return kErrorApiInvalidParam;
+
+    if (!setSimulationFunctions(pInitParam_p))
+    {
+        unsetSimulationFunctions();
+        return kErrorApiInvalidParam;
+    }
+
+    ret = oplk_initialize();
+    if (ret != kErrorOk)
+        goto ExitUnset;
+
+    memset(&initParam, 0, sizeof(initParam));
+    initParam.sizeOfInitParam = sizeof(initParam);
+
+    initParam.nodeId = pInitParam_p->nodeId;
+    initParam.ipAddress = (0xFFFFFF00 & SIMNODE_IP_ADDR) | initParam.nodeId;
+    memcpy(initParam.aMacAddress, pInitParam_p->aMacAddr, sizeof(initParam.aMacAddress));
+    initParam.hwParam.pDevName = SIMNODE_DEV_NAME;
+
+    initParam.fAsyncOnly              = FALSE;
+    initParam.featureFlags            = UINT_MAX;
+    initParam.cycleLen                = pInitParam_p->cycleLen;
+    initParam.isochrTxMaxPayload      = 256;
+    initParam.isochrRxMaxPayload      = 1490;
+    initParam.presMaxLatency          = 50000;
+    initParam.preqActPayloadLimit     = 36;
+    initParam.presActPayloadLimit     = 36;
+    initParam.asndMaxLatency          = 150000;
+    initParam.multiplCylceCnt         = 0;
+    initParam.asyncMtu                = 1500;
+    initParam.prescaler               = 2;
+    initParam.lossOfFrameTolerance    = 500000;
+    initParam.asyncSlotTimeout        = 3000000;
+    initParam.waitSocPreq             = 1000;
+    initParam.deviceType              = UINT_MAX;
+    initParam.vendorId                = UINT_MAX;
+    initParam.productCode             = UINT_MAX;
+    initParam.revisionNumber          = UINT_MAX;
+    initParam.serialNumber            = UINT_MAX;
+
+    initParam.subnetMask              = SIMNODE_SUBNET_MASK;
+    initParam.defaultGateway          = SIMNODE_DEFAULT_GATEWAY;
+    sprintf((char*)initParam.sHostname, "%02x-%08x", initParam.nodeId, initParam.vendorId);
+    initParam.syncNodeId              = C_ADR_SYNC_ON_SOA;
+    initParam.fSyncOnPrcNode          = FALSE;
+
+    ret = obdcreate_initObd(&initParam.obdInitParam);
+    if (ret != kErrorOk)
+        goto ExitOplk;
+
+    // The event and the process sync callbacks are redirected to the simulator
+    ret = sim_oplkCreate(&initParam);
+    if (ret != kErrorOk)
+        goto ExitOplk;
+
+    fStackCreated_l = TRUE;
+    sdoComConHdl_l = 0;
+
+    if (pInitParam_p->sdoWindowSize != 0)
+    {
+        ret = oplk_setSdoWindowSize(pInitParam_p->sdoWindowSize);
+        if (ret != kErrorOk)
+            goto ExitDestroy;
+    }
+
+#if defined(CONFIG_INCLUDE_CFM)
+    if (pInitParam_p->pCdcFile != NULL)
+    {
+        ret = oplk_setCdcFilename(pInitParam_p->pCdcFile);
+        if (ret != kErrorOk)
+            goto ExitDestroy;
+    }
+#endif
+
+    ret = oplk_execNmtCommand(kNmtEventSwReset);
+    if (ret != kErrorOk)
+        goto ExitDestroy;
+
+    return kErrorOk;
+
+ExitDestroy:
+    oplk_destroy();
+    fStackCreated_l = FALSE;
+
+ExitOplk:
+    oplk_exit();
+
+ExitUnset:
+    unsetSimulationFunctions();
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Shut down the simulated node
+
+The function switches off the stack of the node, destroys it and disconnects
+it from the network simulator.
+
+\ingroup module_sim_network
+*/
+//------------------------------------------------------------------------------
+void simnode_exit(void)
+{
+    if (fStackCreated_l)
+    {
+        if (sdoComConHdl_l != 0)
+            oplk_freeSdoChannel(sdoComConHdl_l);
+
+        oplk_execNmtCommand(kNmtEventSwitchOff);
+        oplk_destroy();
+        oplk_exit();
+        fStackCreated_l = FALSE;
+    }
+
+    unsetSimulationFunctions();
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Process the simulated node
+
+The function executes the background processing of the stack (see
+\ref oplk_process). It is called by the network simulator in place of the
+main loop of an application.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_sim_network
+*/
+//------------------------------------------------------------------------------
+tOplkError simnode_process(void)
+{
+    if (!fStackCreated_l)
+        return kErrorApiNotInitialized;
+
+    return oplk_process();
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Signal an expired user timer to the simulated node
+
+\param[in]      timerHdl_p          Handle of the expired timer.
+\param[in]      argument_p          Argument the timer was set up with.
+
+\ingroup module_sim_network
+*/
+//------------------------------------------------------------------------------
+void simnode_userTimerCallback(tTimerHdl timerHdl_p,
+                               tTimerArg argument_p)
+{
+    sim_userTimerCallback(timerHdl_p, argument_p);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Write an object of a remote node
+
+The function starts an SDO write transfer via ASnd to the given node. All
+transfers of the node share one SDO connection which is kept open until the
+node is shut down. The end of the transfer is signaled by the API event
+\ref kOplkApiEventSdo.
+
+\param[in]      nodeId_p            Node ID of the target node.
+\param[in]      index_p             Index of the object.
+\param[in]      subindex_p          Sub-index of the object.
+\param[in]      pData_p             Pointer to the data. It must stay valid
+                                    until the transfer is finished.
+\param[in]      size_p              Size of the data.
+
+\return The function returns a tOplkError error code.
+\retval kErrorApiTaskDeferred       The transfer has been started.
+
+\ingroup module_sim_network
+*/
+//------------------------------------------------------------------------------
+tOplkError simnode_writeObject(UINT nodeId_p,
+                               UINT index_p,
+                               UINT subindex_p,
+                               void* pData_p,
+                               UINT size_p)
+{
+    if (!fStackCreated_l)
+        return kErrorApiNotInitialized;
+
+    return oplk_writeObject(&sdoComConHdl_l,
+                            nodeId_p,
+                            index_p,
+                            subindex_p,
+                            pData_p,
+                            size_p,
+                            kSdoTypeAsnd,
+                            NULL);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Send a non-POWERLINK Ethernet frame
+
+The function passes the frame to the virtual Ethernet queue of the stack. The
+frame is sent in one of the next asynchronous slots of the node.
+
+\param[in]      pFrame_p            Pointer to the complete Ethernet frame.
+\param[in]      size_p              Size of the frame.
+
+\return The function returns a tOplkError error code.
+\retval kErrorDllAsyncTxBufferFull  The virtual Ethernet queue is full.
+
+\ingroup module_sim_network
+*/
+//------------------------------------------------------------------------------
+tOplkError simnode_sendEthFrame(const void* pFrame_p,
+                                UINT size_p)
+{
+    if (!fStackCreated_l)
+        return kErrorApiNotInitialized;
+
+    return oplk_sendEthFrame((const tPlkFrame*)pFrame_p, size_p);
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Set all simulation interface functions
+
+\param[in]      pInitParam_p        Pointer to the initialization parameters.
+
+\return The function returns TRUE if all functions were set, otherwise FALSE.
+*/
+//------------------------------------------------------------------------------
+static BOOL setSimulationFunctions(const tSimNodeInitParam* pInitParam_p)
+{
+    tSimulationInstanceHdl  simHdl = pInitParam_p->simHdl;
+
+    return (sim_setEdrvFunctions(simHdl, pInitParam_p->edrvFunctions) &&
+            sim_setHresTimerFunctions(simHdl, pInitParam_p->hresTimerFunctions) &&
+            sim_setTimerFunctions(simHdl, pInitParam_p->timerFunctions) &&
+            sim_setTargetFunctions(simHdl, pInitParam_p->targetFunctions) &&
+            sim_setTraceFunctions(simHdl, pInitParam_p->traceFunctions) &&
+            sim_setApiEventFunctions(simHdl, pInitParam_p->apiEventFunctions) &&
+            sim_setProcessSyncFunctions(simHdl, pInitParam_p->processSyncFunctions));
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Unset all simulation interface functions
+*/
+//------------------------------------------------------------------------------
+static void unsetSimulationFunctions(void)
+{
+    sim_unsetEdrvFunctions();
+    sim_unsetHresTimerFunctions();
+    sim_unsetTimerFunctions();
+    sim_unsetTargetFunctions();
+    sim_unsetTraceFunctions();
+    sim_unsetApiEventFunctions();
+    sim_unsetProcessSyncFunctions();
+}
+
+/// \}
@@ -47,6 +47,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <console/console.h>
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
 #include <pthread.h>
 #include <errno.h>
@@ -80,6 +82,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // const defines
 //------------------------------------------------------------------------------
+#define THREAD_SPEC_FIELD_COUNT         5
+#define THREAD_SPEC_MAX_LENGTH          256
 
 //------------------------------------------------------------------------------
 // local types
@@ -90,9 +94,23 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 static char* pLogFile_l = NULL;
 
+static const char* const aThreadRoleName_l[kOplkThreadRoleCount] =
+{
+    "edrv", "hrtimer", "eventk", "eventu", "timeru", "sdoudp", "veth"
+};
+
+static const char* const aThreadPolicyName_l[] =
+{
+    "-", "other", "fifo", "rr"
+};
+
 //------------------------------------------------------------------------------
 // local function prototypes
 //------------------------------------------------------------------------------
+static int  parseThreadSpec(const char* pSpec_p);
+static int  parseCpuList(char* pCpuList_p, UINT64* pCpuMask_p);
+static int  readConfigFile(const char* pFileName_p);
+static void printThreadParameters(void);
 
 //============================================================================//
 //            P U B L I C   F U N C T I O N S                                 //
@@ -120,9 +138,10 @@ int main(int argc, char* argv[])
     BOOL                fExit;
     struct sched_param  schedParam;
     int                 opt;
+    BOOL                fThreadConfig = FALSE;
 
     /* get command line parameters */
-    while ((opt = getopt(argc, argv, "l:")) != -1)
+    while ((opt = getopt(argc, argv, "l:t:c:")) != -1)
     {
         switch (opt)
         {
@@ -130,8 +149,26 @@ int main(int argc, char* argv[])
                 pLogFile_l = optarg;
                 break;
 
+            case 't':
+                if (parseThreadSpec(optarg) != 0)
+                    goto Exit;
+                fThreadConfig = TRUE;
+                break;
+
+            case 'c':
+                if (readConfigFile(optarg) != 0)
+                    goto Exit;
+                fThreadConfig = TRUE;
+                break;
+
             default: /* '?' */
-                fprintf(stderr, "Usage: %s [-l LOGFILE]\n", argv[0]);
+                fprintf(stderr, "Usage: %s [-l LOGFILE] [-c CONFIGFILE] "
+                                "[-t ROLE:CPUS:POLICY:PRIORITY[:NAME]]...\n"
+                                "  ROLE:     edrv, hrtimer, eventk, eventu, timeru, sdoudp, veth\n"
+                                "  CPUS:     CPU list (e.g. 1,3 or 2-3) or - to keep the default\n"
+                                "  POLICY:   fifo, rr, other or - to keep the default\n"
+                                "  PRIORITY: real-time priority or 0 to keep the default\n",
+                        argv[0]);
                 goto Exit;
         }
     }
@@ -153,6 +190,9 @@ int main(int argc, char* argv[])
     }
 
 #if defined(SET_CPU_AFFINITY)
+    /* The threads inherit the affinity of the main thread, therefore a
+       configured thread placement is not restricted to the first CPU core */
+    if (!fThreadConfig)
     {
         /* binds all openPOWERLINK threads to the first CPU core */
         cpu_set_t   affinity;
@@ -180,6 +220,7 @@ int main(int argc, char* argv[])
 
     // initialize POWERLINK stack
     printf("Running...\n");
+    printf("Press t to show the thread settings, ESC to exit\n");
 
     fExit = FALSE;
     while (!fExit)
@@ -188,8 +229,19 @@ int main(int argc, char* argv[])
         if (console_kbhit())
         {
             cKey = (char)console_getch();
-            if (cKey == 0x1B)
-                fExit = TRUE;
+            switch (cKey)
+            {
+                case 't':
+                    printThreadParameters();
+                    break;
+
+                case 0x1B:
+                    fExit = TRUE;
+                    break;
+
+                default:
+                    break;
+            }
         }
         else
         {
@@ -205,3 +257,262 @@ Exit:
     printf("Exiting\n");
     return ret;
 }
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Parse a thread specification
+
+The function parses a thread specification of the form
+ROLE:CPUS:POLICY:PRIORITY[:NAME] and configures the thread parameters of the
+role accordingly. The parameters are applied when the threads of the role are
+started.
+
+\param[in]      pSpec_p             Thread specification string.
+
+\return Returns 0 on success, otherwise -1.
+*/
+//------------------------------------------------------------------------------
+static int parseThreadSpec(const char* pSpec_p)
+{
+    char                    aSpec[THREAD_SPEC_MAX_LENGTH];
+    char*                   apField[THREAD_SPEC_FIELD_COUNT];
+    char*                   pPos;
+    char*                   pEnd;
+    UINT                    fieldCount;
+    UINT                    role;
+    UINT                    policy;
+    unsigned long           priority;
+    tOplkThreadParameters   threadParam;
+
+    if (strlen(pSpec_p) >= sizeof(aSpec))
+    {
+        fprintf(stderr, "Thread specification too long: %s\n", pSpec_p);
+        return -1;
+    }
+
+    strcpy(aSpec, pSpec_p);
+
+    // Split the specification into its fields
+    fieldCount = 0;
+    pPos = aSpec;
+    while ((pPos != NULL) && (fieldCount < THREAD_SPEC_FIELD_COUNT))
+    {
+        apField[fieldCount++] = pPos;
+        pPos = strchr(pPos, ':');
+        if (pPos != NULL)
+            *pPos++ = '\0';
+    }
+
+    if ((fieldCount < (THREAD_SPEC_FIELD_COUNT - 1)) || (pPos != NULL))
+    {
+        fprintf(stderr, "Invalid thread specification: %s\n", pSpec_p);
+        return -1;
+    }
+
+    memset(&threadParam, 0, sizeof(threadParam));
+
+    for (role = 0; role < kOplkThreadRoleCount; role++)
+    {
+        if (strcmp(apField[0], aThreadRoleName_l[role]) == 0)
+            break;
+    }
+
+    if (role == kOplkThreadRoleCount)
+    {
+        fprintf(stderr, "Invalid thread role: %s\n", apField[0]);
+        return -1;
+    }
+
+    if (parseCpuList(apField[1], &threadParam.cpuMask) != 0)
+    {
+        fprintf(stderr, "Invalid CPU list: %s\n", apField[1]);
+        return -1;
+    }
+
+    for (policy = 0; policy < (sizeof(aThreadPolicyName_l) / sizeof(aThreadPolicyName_l[0])); policy++)
+    {
+        if (strcmp(apField[2], aThreadPolicyName_l[policy]) == 0)
+            break;
+    }
+
+    if (policy == (sizeof(aThreadPolicyName_l) / sizeof(aThreadPolicyName_l[0])))
+    {
+        fprintf(stderr, "Invalid scheduling policy: %s\n", apField[2]);
+        return -1;
+    }
+
+    threadParam.policy = (tOplkThreadPolicy)policy;
+
+    priority = strtoul(apField[3], &pEnd, 0);
+    if ((*apField[3] == '\0') || (*pEnd != '\0') || (priority > 99))
+    {
+        fprintf(stderr, "Invalid thread priority: %s\n", apField[3]);
+        return -1;
+    }
+
+    threadParam.priority = (UINT)priority;
+
+    if (fieldCount == THREAD_SPEC_FIELD_COUNT)
+    {
+        strncpy(threadParam.aName, apField[4], OPLK_THREAD_NAME_LENGTH - 1);
+        threadParam.aName[OPLK_THREAD_NAME_LENGTH - 1] = '\0';
+    }
+
+    if (target_setThreadParameters((tOplkThreadRole)role, &threadParam) != kErrorOk)
+    {
+        fprintf(stderr, "Couldn't set thread parameters: %s\n", pSpec_p);
+        return -1;
+    }
+
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Parse a CPU list
+
+The function converts a CPU list (e.g. "0,2-3") into a CPU mask. A "-" keeps
+the inherited CPU affinity and results in an empty mask.
+
+\param[in]      pCpuList_p          CPU list string. The string is modified.
+\param[out]     pCpuMask_p          Pointer to store the CPU mask.
+
+\return Returns 0 on success, otherwise -1.
+*/
+//------------------------------------------------------------------------------
+static int parseCpuList(char* pCpuList_p, UINT64* pCpuMask_p)
+{
+    char*           pToken;
+    char*           pSave;
+    char*           pEnd;
+    unsigned long   first;
+    unsigned long   last;
+
+    *pCpuMask_p = 0;
+
+    if (strcmp(pCpuList_p, "-") == 0)
+        return 0;
+
+    for (pToken = strtok_r(pCpuList_p, ",", &pSave);
+         pToken != NULL;
+         pToken = strtok_r(NULL, ",", &pSave))
+    {
+        first = strtoul(pToken, &pEnd, 10);
+        if (pEnd == pToken)
+            return -1;
+
+        last = first;
+        if (*pEnd == '-')
+        {
+            pToken = pEnd + 1;
+            last = strtoul(pToken, &pEnd, 10);
+            if (pEnd == pToken)
+                return -1;
+        }
+
+        if ((*pEnd != '\0') || (first > last) || (last >= 64))
+            return -1;
+
+        for (; first <= last; first++)
+            *pCpuMask_p |= (UINT64)1 << first;
+    }
+
+    return (*pCpuMask_p != 0) ? 0 : -1;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Read a thread configuration file
+
+The function reads a configuration file which contains one thread
+specification (see \ref parseThreadSpec) per line. Empty lines and lines
+starting with '#' are ignored.
+
+\param[in]      pFileName_p         File name of the configuration file.
+
+\return Returns 0 on success, otherwise -1.
+*/
+//------------------------------------------------------------------------------
+static int readConfigFile(const char* pFileName_p)
+{
+    FILE*   pFile;
+    char    aLine[THREAD_SPEC_MAX_LENGTH];
+    char*   pSpec;
+    char*   pEnd;
+    int     ret = 0;
+
+    pFile = fopen(pFileName_p, "r");
+    if (pFile == NULL)
+    {
+        fprintf(stderr, "Couldn't open configuration file %s! (%s)\n",
+                pFileName_p,
+                strerror(errno));
+        return -1;
+    }
+
+    while ((ret == 0) && (fgets(aLine, sizeof(aLine), pFile) != NULL))
+    {
+        // Strip leading and trailing white space
+        pSpec = aLine;
+        while ((*pSpec == ' ') || (*pSpec == '\t'))
+            pSpec++;
+
+        pEnd = pSpec + strlen(pSpec);
+        while ((pEnd > pSpec) &&
+               ((pEnd[-1] == '\n') || (pEnd[-1] == '\r') ||
+                (pEnd[-1] == ' ') || (pEnd[-1] == '\t')))
+        {
+            pEnd--;
+        }
+        *pEnd = '\0';
+
+        if ((*pSpec == '\0') || (*pSpec == '#'))
+            continue;
+
+        ret = parseThreadSpec(pSpec);
+    }
+
+    fclose(pFile);
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Print achieved thread parameters
+
+The function prints the CPU affinity, the scheduling and the name which have
+actually been achieved by the threads of all roles.
+*/
+//------------------------------------------------------------------------------
+static void printThreadParameters(void)
+{
+    tOplkThreadParameters   threadParam;
+    UINT                    role;
+
+    printf("\n%-8s %-18s %-6s %-8s %s\n", "Role", "CPU mask", "Policy", "Priority", "Name");
+    for (role = 0; role < kOplkThreadRoleCount; role++)
+    {
+        if (target_getThreadParameters((tOplkThreadRole)role, &threadParam) != kErrorOk)
+        {
+            printf("%-8s (not running)\n", aThreadRoleName_l[role]);
+            continue;
+        }
+
+        printf("%-8s 0x%016llx %-6s %-8u %s\n",
+               aThreadRoleName_l[role],
+               (unsigned long long)threadParam.cpuMask,
+               (threadParam.policy < (sizeof(aThreadPolicyName_l) / sizeof(aThreadPolicyName_l[0]))) ?
+                   aThreadPolicyName_l[threadParam.policy] : "?",
+               threadParam.priority,
+               threadParam.aName);
+    }
+}
+
+/// \}
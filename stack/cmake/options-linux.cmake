@@ -62,6 +62,8 @@ OPTION (CFG_COMPILE_SHARED_LIBRARY              "Build openPOWERLINK library as
 # Options for library features
 
 OPTION (CFG_USE_PCAP_EDRV                       "Compile openPOWERLINK library with pcap edrv" OFF)
+OPTION (CFG_USE_RAWSOCK_MMAP_EDRV               "Compile openPOWERLINK library with memory mapped (PACKET_MMAP) raw socket edrv" OFF)
+OPTION (CFG_USE_HRESTIMER_HYBRID                "Compile openPOWERLINK library with the single thread sleep/spin high-resolution timer" OFF)
 OPTION (CFG_INCLUDE_MN_REDUNDANCY               "Compile MN redundancy functions into MN libraries" OFF)
 CMAKE_DEPENDENT_OPTION (CFG_STORE_RESTORE       "Support storing of OD in non-volatile memory (file system)" ON
                                                 "CFG_COMPILE_LIB_CN OR CFG_COMPILE_LIB_CNAPP_USERINTF OR CFG_COMPILE_LIB_CNAPP_KERNELINTF" OFF)
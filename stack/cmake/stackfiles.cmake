@@ -462,20 +462,35 @@ SET(PDO_KCAL_DUALPROCSHM_SOURCES
 ################################################################################
 # Kernel Ethernet
 
+SET(HRESTIMER_LINUXUSER_SOURCES
+    ${KERNEL_SOURCE_DIR}/timer/hrestimer-posix.c
+    )
+
+SET(HRESTIMER_LINUXUSER_HYBRID_SOURCES
+    ${KERNEL_SOURCE_DIR}/timer/hrestimer-posix_hybrid.c
+    )
+
 SET(HARDWARE_DRIVER_LINUXUSER_SOURCES
     ${KERNEL_SOURCE_DIR}/veth/veth-linuxuser.c
-    ${KERNEL_SOURCE_DIR}/timer/hrestimer-posix.c
     ${EDRV_SOURCE_DIR}/edrvcyclic.c
+    ${EDRV_SOURCE_DIR}/edrvbpf.c
     ${EDRV_SOURCE_DIR}/edrv-pcap_linux.c
     )
 
 SET(HARDWARE_DRIVER_LINUXUSERRAWSOCKET_SOURCES
     ${KERNEL_SOURCE_DIR}/veth/veth-linuxuser.c
-    ${KERNEL_SOURCE_DIR}/timer/hrestimer-posix.c
     ${EDRV_SOURCE_DIR}/edrvcyclic.c
+    ${EDRV_SOURCE_DIR}/edrvbpf.c
     ${EDRV_SOURCE_DIR}/edrv-rawsock_linux.c
     )
 
+SET(HARDWARE_DRIVER_LINUXUSERRAWSOCKETMMAP_SOURCES
+    ${KERNEL_SOURCE_DIR}/veth/veth-linuxuser.c
+    ${EDRV_SOURCE_DIR}/edrvcyclic.c
+    ${EDRV_SOURCE_DIR}/edrvbpf.c
+    ${EDRV_SOURCE_DIR}/edrv-rawsockmmap_linux.c
+    )
+
 SET(HARDWARE_DRIVER_WINDOWS_SOURCES
     ${EDRV_SOURCE_DIR}/edrvcyclic.c
     ${EDRV_SOURCE_DIR}/edrv-pcap_win.c
@@ -632,6 +647,7 @@ IF (CFG_COMPILE_LIB_MNAPP_ZYNQINTF OR CFG_COMPILE_LIB_CNAPP_ZYNQINTF OR
     SET(TARGET_LINUX_SOURCES
         ${ARCH_SOURCE_DIR}/linux/target-linux.c
         ${ARCH_SOURCE_DIR}/linux/target-mutex.c
+        ${ARCH_SOURCE_DIR}/linux/target-thread.c
         ${ARCH_SOURCE_DIR}/linux/netif-linux.c
         ${ARCH_SOURCE_DIR}/linux/lock-linuxdualproc.c
         )
@@ -639,6 +655,7 @@ ELSE ()
     SET(TARGET_LINUX_SOURCES
         ${ARCH_SOURCE_DIR}/linux/target-linux.c
         ${ARCH_SOURCE_DIR}/linux/target-mutex.c
+        ${ARCH_SOURCE_DIR}/linux/target-thread.c
         ${ARCH_SOURCE_DIR}/linux/netif-linux.c
         )
 ENDIF ()
@@ -45,9 +45,17 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 #define NR_OF_CIRC_BUFFERS              20
 #define CIRCBUF_BLOCK_ALIGNMENT         4
+#define CIRCBUF_CACHE_LINE_SIZE         64
 
 #undef  DEBUG_CIRCBUF_SIZE_CHECK                // Add debug code for retrieving maximum used buffer size
 
+// Number of 32 bit words in front of the lock-free positions of the header
+#ifdef DEBUG_CIRCBUF_SIZE_CHECK
+#define CIRCBUF_HEADER_WORD_COUNT       7
+#else
+#define CIRCBUF_HEADER_WORD_COUNT       6
+#endif
+
 //------------------------------------------------------------------------------
 // typedef
 //------------------------------------------------------------------------------
@@ -74,6 +82,22 @@ Data type for the enumerator \ref eCircBufError.
 */
 typedef UINT32 tCircBufError;
 
+/**
+*  \brief Lock-free buffer position
+*
+*  The struct defines the position of one side (producer or consumer) of a
+*  circular buffer which is accessed in lock-free mode. Each position is only
+*  modified by its owner and occupies a cache line of its own, so that the
+*  producer and the consumer never write to the same cache line.
+*/
+typedef struct
+{
+    UINT32              offset;             ///< The read or write offset
+    UINT32              byteCount;          ///< Number of bytes passed so far (wraps around)
+    UINT32              blockCount;         ///< Number of blocks passed so far (wraps around)
+    UINT8               aPadding[CIRCBUF_CACHE_LINE_SIZE - (3 * sizeof(UINT32))];
+} tCircBufPosition;
+
 /**
 *  \brief Header for circular buffer
 *
@@ -91,6 +115,10 @@ typedef struct
 #ifdef DEBUG_CIRCBUF_SIZE_CHECK
     UINT32              maxSize;            ///< Maximum used space in circular buffer
 #endif
+    UINT32              fLockFree;          ///< Buffer is accessed lock-free by a single producer and a single consumer
+    UINT8               aPadding[CIRCBUF_CACHE_LINE_SIZE - (CIRCBUF_HEADER_WORD_COUNT * sizeof(UINT32))];
+    tCircBufPosition    writePos;           ///< Lock-free write position (modified by the producer only)
+    tCircBufPosition    readPos;            ///< Lock-free read position (modified by the consumer only)
 } tCircBufHeader;
 
 /**
@@ -105,6 +133,7 @@ typedef struct
     void*               pCircBuf;                   ///< Pointer to the circular buffer
     void*               pCircBufArchInstance;       ///< Pointer to architecture specific stuff
     UINT8               bufferId;                   ///< The id of the circular buffer
+    BOOL                fLockFree;                  ///< Buffer is accessed without locking
     VOIDFUNCPTR         pfnSigCb;                   ///< Pointer to the signaling callback function
 } tCircBufInstance;
 
@@ -68,6 +68,10 @@ typedef enum
     kCtrlWriteFileChunk         = 0x0008,   ///< Write file chunk to kernel stack
     kCtrlReconfigFactoryImage   = 0x0009,   ///< Reconfigure kernel stack with factory image
     kCtrlReconfigUpdateImage    = 0x000A,   ///< Reconfigure kernel stack with update image
+    kCtrlGetTimerStatistics     = 0x000B,   ///< Store high-resolution timer statistics in the statistics buffer
+    kCtrlResetTimerStatistics   = 0x000C,   ///< Reset high-resolution timer statistics
+    kCtrlGetCycleStatistics     = 0x000D,   ///< Store cycle statistics in the statistics buffer
+    kCtrlResetCycleStatistics   = 0x000E,   ///< Reset cycle statistics
 } eCtrlCmdType;
 
 /**
@@ -115,6 +119,18 @@ typedef struct
     char            aNetIfName[128];    ///< Device name of the network interface
 } tCtrlInitParam;
 
+/**
+\brief Statistics buffer
+
+The following union defines the buffer used to transfer statistics from the
+kernel to the user stack.
+*/
+typedef union
+{
+    tOplkApiTimerStatistics timerStatistics;    ///< High-resolution timer statistics
+    tOplkApiCycleStatistics cycleStatistics;    ///< Cycle statistics of the cyclic Ethernet driver
+} tCtrlStatistics;
+
 //------------------------------------------------------------------------------
 // function prototypes
 //------------------------------------------------------------------------------
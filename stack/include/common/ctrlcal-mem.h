@@ -79,6 +79,7 @@ typedef struct
     tOplkApiFileChunkDesc   fileChunkDesc;  ///< File chunk descriptor
     UINT8                   aFileChunkBuffer[CONFIG_CTRL_FILE_CHUNK_SIZE];
                                             ///< File chunk transfer buffer
+    tCtrlStatistics         statistics;     ///< Statistics transfer buffer (last member, only accessed by CALs mapping the whole buffer)
 } tCtrlBuf;
 
 //------------------------------------------------------------------------------
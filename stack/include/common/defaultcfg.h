@@ -65,6 +65,18 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define CONFIG_EVENT_SIZE_CIRCBUF_USER_INTERNAL         32768               // Default size for user-internal event queue
 #endif
 
+#ifndef CONFIG_EVENT_DRAIN_MAX_EVENTS
+#define CONFIG_EVENT_DRAIN_MAX_EVENTS                   32                  // Maximum number of events processed per event thread wakeup
+#endif
+
+#ifndef CONFIG_EVENT_DRAIN_WEIGHT_HIGH
+#define CONFIG_EVENT_DRAIN_WEIGHT_HIGH                  4                   // Events taken from the high-priority queue per round-robin round
+#endif
+
+#ifndef CONFIG_EVENT_DRAIN_WEIGHT_LOW
+#define CONFIG_EVENT_DRAIN_WEIGHT_LOW                   1                   // Events taken from the low-priority queue per round-robin round
+#endif
+
 #ifndef CONFIG_DLLCAL_SIZE_CIRCBUF_CN_REQ_NMT
 #define CONFIG_DLLCAL_SIZE_CIRCBUF_CN_REQ_NMT           2048                // Default size for NMT request queue
 #endif
@@ -85,6 +97,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define CONFIG_DLLCAL_BUFFER_SIZE_TX_VETH               32768               // Default size for virtual Ethernet Tx queue
 #endif
 
+#ifndef CONFIG_CIRCBUF_LOCKFREE_BUFFERS
+#define CONFIG_CIRCBUF_LOCKFREE_BUFFERS                 0                   // Bit mask of circular buffer IDs accessed lock-free (single producer/single consumer only)
+#endif
+
 #ifndef CONFIG_CTRL_FILE_CHUNK_SIZE
 #define CONFIG_CTRL_FILE_CHUNK_SIZE                     1024
 #endif
@@ -259,8 +275,16 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define CONFIG_EDRV_AUTO_RESPONSE_DELAY                 FALSE
 #endif
 
+#ifndef CONFIG_EDRV_CYCLIC_USE_STATISTICS
+#define CONFIG_EDRV_CYCLIC_USE_STATISTICS               FALSE               // collect cycle timing histograms in edrvcyclic
+#endif
+
 #ifndef CONFIG_PDO_SETUP_WAIT_TIME
 #define CONFIG_PDO_SETUP_WAIT_TIME                      500
 #endif
 
+#ifndef CONFIG_PDO_USE_COMPILED_MAPPING
+#define CONFIG_PDO_USE_COMPILED_MAPPING                 TRUE                // lower PDO mappings to merged copy operations
+#endif
+
 #endif /* _INC_common_defaultcfg_H_ */
@@ -119,6 +119,11 @@ typedef struct
 This structure specifies a PDO channel buffer. Each PDO channel has got an
 offset in the buffers, and specifies the currently used buffer for consuming
 data, producing data and a clean buffer.
+
+RXPDO channels which are received in the same frame share the buffer indices
+of the frame channel, i.e. the channel of the frame with the lowest channel ID.
+Thus, all channels of a frame are published and consumed with a single buffer
+exchange and the consumer never sees channels of different frames.
 */
 typedef struct
 {
@@ -127,6 +132,7 @@ typedef struct
     OPLK_ATOMIC_T       writeBuf;               ///< Current buffer to produce data to
     OPLK_ATOMIC_T       cleanBuf;               ///< Current clean (i.e. unused) buffer
     UINT8               newData;                ///< Flag indicating whether new data has been produced
+    UINT8               frameChannelId;         ///< Channel whose buffer indices are used for all RXPDO channels of the same frame
 } tPdoBufferInfo;
 
 /**
@@ -44,6 +44,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <common/oplkinc.h>
 #include <common/led.h>
 
+#if ((TARGET_SYSTEM == _LINUX_) && !defined(__KERNEL__))
+#include <pthread.h>
+#endif
+
 //------------------------------------------------------------------------------
 // const defines
 //------------------------------------------------------------------------------
@@ -98,6 +102,21 @@ tOplkError target_enumerateNetworkInterfaces(tNetIfId* pInterfaces_p,
 tOplkError target_getSystemTime(tNetTime* pNetTime_p, BOOL* pValidSystemTime_p);
 #endif
 
+/* functions for thread configuration */
+#if ((TARGET_SYSTEM == _LINUX_) && !defined(__KERNEL__))
+tOplkError target_setThreadParameters(tOplkThreadRole role_p,
+                                      const tOplkThreadParameters* pThreadParam_p);
+tOplkError target_getThreadParameters(tOplkThreadRole role_p,
+                                      tOplkThreadParameters* pThreadParam_p);
+tOplkError target_registerThread(tOplkThreadRole role_p,
+                                 pthread_t thread_p,
+                                 tOplkThreadPolicy defaultPolicy_p,
+                                 UINT defaultPriority_p,
+                                 const char* pDefaultName_p);
+void       target_unregisterThread(tOplkThreadRole role_p,
+                                   pthread_t thread_p);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -69,6 +69,8 @@ tCtrlKernelStatus ctrlkcal_getStatus(void);
 void              ctrlkcal_updateHeartbeat(UINT16 heartbeat_p);
 tOplkError        ctrlkcal_readInitParam(tCtrlInitParam* pInitParam_p);
 void              ctrlkcal_storeInitParam(const tCtrlInitParam* pInitParam_p);
+tOplkError        ctrlkcal_storeStatistics(const void* pStatistics_p,
+                                           size_t size_p);
 tOplkError        ctrlkcal_readFileChunk(tOplkApiFileChunkDesc* pDesc_p,
                                          size_t bufferSize_p,
                                          void* pBuffer_p);
@@ -67,6 +67,61 @@ typedef struct
     UINT        maxRxFrameCount;                            ///< Max number of frames in the RX queue
 } tDllkCalStatistics;
 
+/**
+\brief Asynchronous request queues of the MN scheduler
+
+This enumeration lists the request queues among which the MN assigns the
+asynchronous phases.
+*/
+typedef enum
+{
+    kDllkCalAsyncSchedQueueCnGen    = 0,    ///< Generic priority requests of the CNs
+    kDllkCalAsyncSchedQueueCnNmt    = 1,    ///< NMT priority requests of the CNs
+    kDllkCalAsyncSchedQueueMnGenNmt = 2,    ///< Generic and NMT priority requests of the MN
+    kDllkCalAsyncSchedQueueMnIdent  = 3,    ///< IdentRequests issued by the MN
+    kDllkCalAsyncSchedQueueMnStatus = 4,    ///< StatusRequests issued by the MN
+    kDllkCalAsyncSchedQueueMnSync   = 5,    ///< SyncRequests issued by the MN
+    kDllkCalAsyncSchedQueueCount,           ///< Dummy enum to get queue count
+} eDllkCalAsyncSchedQueue;
+
+/**
+\brief Asynchronous request queue data type
+
+Data type for the enumerator \ref eDllkCalAsyncSchedQueue.
+*/
+typedef UINT32 tDllkCalAsyncSchedQueue;
+
+/**
+\brief Statistics of one asynchronous request queue
+
+Waiting times are counted in asynchronous phases which have been assigned
+since the queue was served the last time.
+*/
+typedef struct
+{
+    UINT        weight;                                     ///< Number of consecutive grants per scheduling round
+    UINT        curDepth;                                   ///< Number of pending requests
+    UINT        grantCount;                                 ///< Number of granted asynchronous phases
+    UINT        forcedGrantCount;                           ///< Number of grants forced by the starvation bound
+    UINT        curWait;                                    ///< Current waiting time of the queue
+    UINT        maxWait;                                    ///< Max waiting time of a granted request
+    UINT        waitSum;                                    ///< Sum of the waiting times of all granted requests
+} tDllkCalAsyncSchedQueueStatistics;
+
+/**
+\brief Statistics of the MN asynchronous scheduler
+
+This structure defines the statistic data of the scheduler which assigns the
+asynchronous phases of the MN.
+*/
+typedef struct
+{
+    UINT                                slotCount;          ///< Number of scheduled asynchronous phases
+    UINT                                idleCount;          ///< Number of asynchronous phases without request
+    tDllkCalAsyncSchedQueueStatistics   aQueue[kDllkCalAsyncSchedQueueCount]; ///< Statistics of the request queues
+    UINT                                aCnGrantCount[254]; ///< Number of granted requests of each CN
+} tDllkCalAsyncSchedStatistics;
+
 //------------------------------------------------------------------------------
 // function prototypes
 //------------------------------------------------------------------------------
@@ -87,6 +142,10 @@ tOplkError dllkcal_getAsyncTxFrame(void* pFrame_p,
 tOplkError dllkcal_asyncFrameReceived(tFrameInfo* pFrameInfo_p) SECTION_DLLKCAL_ASYNCRX;
 tOplkError dllkcal_nmtCmdReceived(const tNmtCommandService* pNmtCommand_p);
 tOplkError dllkcal_sendAsyncFrame(tFrameInfo* pFrameInfo_p, tDllAsyncReqPriority priority_p);
+tOplkError dllkcal_sendAsyncFrames(tFrameInfo* pFrameInfo_p,
+                                   UINT count_p,
+                                   tDllAsyncReqPriority priority_p,
+                                   UINT* pSentCount_p);
 tOplkError dllkcal_writeAsyncFrame(tFrameInfo* pFrameInfo_p, tDllCalQueue dllQueue_p);
 tOplkError dllkcal_clearAsyncBuffer(void);
 tOplkError dllkcal_getStatistics(tDllkCalStatistics** ppStatistics);
@@ -108,6 +167,9 @@ tOplkError dllkcal_setAsyncPendingRequests(UINT nodeId_p,
 tOplkError dllkcal_ackAsyncRequest(UINT nodeId_p,
                                    tDllReqServiceId reqServiceId_p)
                                    SECTION_DLLKCAL_GETPENREQ;
+tOplkError dllkcal_setAsyncSchedWeight(tDllkCalAsyncSchedQueue queue_p,
+                                       UINT weight_p);
+tOplkError dllkcal_getAsyncSchedStatistics(tDllkCalAsyncSchedStatistics** ppStatistics_p);
 #endif /* defined(CONFIG_INCLUDE_NMT_MN) */
 
 #ifdef __cplusplus
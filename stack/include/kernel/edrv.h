@@ -82,6 +82,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define EDRV_USE_TTTX                                   FALSE
 #endif
 
+#ifndef EDRV_USE_TX_BATCH
+#define EDRV_USE_TX_BATCH                               FALSE
+#endif
+
 //------------------------------------------------------------------------------
 // Type definitions
 //------------------------------------------------------------------------------
@@ -164,6 +168,7 @@ struct sEdrvTxBuffer
     tEdrvTxBufferNumber txBufferNumber;     ///< Edrv Tx buffer number
     void*               pBuffer;            ///< Pointer to the Tx buffer
     size_t              maxBufferSize;      ///< Maximum size of the Tx buffer
+    UINT64              txTimeStampNs;      ///< Tx time stamp of the last transmission [ns] (0 if not supported)
 };
 
 /**
@@ -242,6 +247,11 @@ tOplkError   edrv_updateTxBuffer(tEdrvTxBuffer* pBuffer_p);
 tOplkError   edrv_getMacTime(UINT64* pCurtime_p);
 #endif
 
+#if (EDRV_USE_TX_BATCH != FALSE)
+tOplkError   edrv_beginTxBatch(void);
+tOplkError   edrv_endTxBatch(void);
+#endif
+
 #if (CONFIG_EDRV_USE_DIAGNOSTICS != FALSE)
 int          edrv_getDiagnostics(char* pBuffer_p, size_t size_p);
 #endif
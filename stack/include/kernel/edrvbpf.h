@@ -0,0 +1,141 @@
+/**
+********************************************************************************
+\file   kernel/edrvbpf.h
+
+\brief  Definitions for the BPF Rx filter compiler of the Linux Ethernet drivers
+
+This file contains the definitions for the module which translates the Rx
+filter table of the data link layer into a classic BPF program.
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2017, B&R Industrial Automation GmbH
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+#ifndef _INC_kernel_edrvbpf_H_
+#define _INC_kernel_edrvbpf_H_
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <common/oplkinc.h>
+#include <kernel/edrv.h>
+
+#include <linux/filter.h>
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#ifndef EDRV_BPF_MAX_INSN_COUNT
+#define EDRV_BPF_MAX_INSN_COUNT                 512
+#endif
+
+#ifndef EDRV_BPF_MAX_FILTER_COUNT
+#define EDRV_BPF_MAX_FILTER_COUNT               64
+#endif
+
+#define EDRV_BPF_FILTER_SIZE                    22          ///< Size of filter value and mask
+#define EDRV_BPF_ACCEPT                         0x40000     ///< Return value for accepted frames (snap length)
+#define EDRV_BPF_REJECT                         0           ///< Return value for rejected frames
+
+//------------------------------------------------------------------------------
+// typedef
+//------------------------------------------------------------------------------
+/**
+\brief Compiled BPF Rx filter program
+
+This structure holds a classic BPF program which has been generated from an
+Rx filter table. The instruction layout is identical to struct bpf_insn of
+libpcap, therefore the program can be attached to raw sockets as well as to
+pcap handles.
+*/
+typedef struct
+{
+    UINT                insnCount;                              ///< Number of valid instructions
+    struct sock_filter  aInsn[EDRV_BPF_MAX_INSN_COUNT];         ///< BPF instructions
+} tEdrvBpfProgram;
+
+/**
+\brief Cached Rx filter entry
+
+This structure holds the part of an Rx filter entry which is relevant for the
+generated BPF program.
+*/
+typedef struct
+{
+    BOOL                fRequired;                              ///< Frames matching the entry are passed
+    UINT8               aValue[EDRV_BPF_FILTER_SIZE];           ///< Masked filter value
+    UINT8               aMask[EDRV_BPF_FILTER_SIZE];            ///< Filter mask
+} tEdrvBpfFilterEntry;
+
+/**
+\brief Rx filter cache
+
+This structure holds the Rx filter table the current BPF program has been
+generated from, the program itself and a work buffer for generating a new
+program. The Ethernet drivers keep it in their instance, so that the program
+is only regenerated if the filter table has changed in a relevant way, and
+no program has to be placed on the stack.
+*/
+typedef struct
+{
+    BOOL                fValid;                                 ///< The cached filter table is valid
+    UINT                filterCount;                            ///< Number of cached filter entries
+    tEdrvBpfFilterEntry aFilter[EDRV_BPF_MAX_FILTER_COUNT];     ///< Cached filter entries
+    tEdrvBpfProgram     program;                                ///< Currently attached program
+    tEdrvBpfProgram     newProgram;                             ///< Work buffer for a new program
+} tEdrvBpfFilterCache;
+
+//------------------------------------------------------------------------------
+// function prototypes
+//------------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+tOplkError edrvbpf_compileFilters(const tEdrvFilter* pFilter_p,
+                                  UINT count_p,
+                                  const UINT8* pSrcMacAddr_p,
+                                  tEdrvBpfProgram* pProgram_p);
+BOOL       edrvbpf_isEqual(const tEdrvBpfProgram* pProgram1_p,
+                           const tEdrvBpfProgram* pProgram2_p);
+BOOL       edrvbpf_updateFilterCache(tEdrvBpfFilterCache* pCache_p,
+                                     const tEdrvFilter* pFilter_p,
+                                     UINT count_p);
+tOplkError edrvbpf_attachToSocket(int sock_p,
+                                  const tEdrvBpfProgram* pProgram_p);
+tOplkError edrvbpf_detachFromSocket(int sock_p);
+tOplkError edrvbpf_updateSocketFilter(int sock_p,
+                                      const tEdrvFilter* pFilter_p,
+                                      UINT count_p,
+                                      const UINT8* pSrcMacAddr_p,
+                                      tEdrvBpfFilterCache* pCache_p);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _INC_kernel_edrvbpf_H_ */
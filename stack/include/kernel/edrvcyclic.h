@@ -117,6 +117,11 @@ tOplkError edrvcyclic_regErrorHandler(tEdrvCyclicCbError pfnEdrvCyclicCbError_p)
 tOplkError edrvcyclic_getDiagnostics(const tEdrvCyclicDiagnostics** ppDiagnostics_p);
 #endif
 
+#if (CONFIG_EDRV_CYCLIC_USE_STATISTICS != FALSE)
+tOplkError edrvcyclic_getStatistics(tOplkApiCycleStatistics* pStatistics_p);
+tOplkError edrvcyclic_resetStatistics(void);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
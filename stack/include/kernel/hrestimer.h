@@ -47,6 +47,9 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // const defines
 //------------------------------------------------------------------------------
+#ifndef CONFIG_HRESTIMER_USE_STATISTICS
+#define CONFIG_HRESTIMER_USE_STATISTICS                 FALSE
+#endif
 
 //------------------------------------------------------------------------------
 // typedef
@@ -88,6 +91,11 @@ tOplkError hrestimer_deleteTimer(tTimerHdl* pTimerHdl_p);
 void       hrestimer_controlExtSyncIrq(BOOL fEnable_p);
 void       hrestimer_setExtSyncIrqTime(tTimestamp time_p);
 
+#if (CONFIG_HRESTIMER_USE_STATISTICS != FALSE)
+tOplkError hrestimer_getStatistics(tOplkApiTimerStatistics* pStatistics_p);
+tOplkError hrestimer_resetStatistics(void);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -50,6 +50,18 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // typedef
 //------------------------------------------------------------------------------
+/**
+\brief RXPDO write descriptor
+
+This structure describes a received RXPDO which is written to the PDO memory
+by pdokcal_writeRxPdoChannels().
+*/
+typedef struct
+{
+    const void*         pPayload;               ///< Pointer to the PDO payload in the received frame
+    UINT16              pdoSize;                ///< Size of the PDO
+    UINT8               channelId;              ///< Channel ID of the PDO
+} tPdokcalRxPdoDesc;
 
 //------------------------------------------------------------------------------
 // function prototypes
@@ -75,10 +87,9 @@ tOplkError pdokcal_initPdoMem(const tPdoChannelSetup* pPdoChannels,
                               size_t txPdoMemSize_p);
 void       pdokcal_cleanupPdoMem(void);
 tOplkError pdokcal_getPdoMemRegion(void** ppPdoMemBase, size_t* pPdoMemSize_p);
-tOplkError pdokcal_writeRxPdo(UINT8 channelId_p,
-                              const void* pPayload_p,
-                              UINT16 pdoSize_p)
-                              SECTION_PDOKCAL_WRITE_RPDO;
+tOplkError pdokcal_writeRxPdoChannels(const tPdokcalRxPdoDesc* pRxPdo_p,
+                                      UINT rxPdoCount_p)
+                                      SECTION_PDOKCAL_WRITE_RPDO;
 tOplkError pdokcal_readTxPdo(UINT8 channelId_p,
                              void* pPayload_p,
                              UINT16 pdoSize_p)
@@ -64,6 +64,7 @@ typedef struct
     tOplkError          error;                  ///< Error which occurred
     size_t              totalNumberOfBytes;     ///< Total number of bytes to transfer
     size_t              bytesDownloaded;        ///< Number of already downloaded bytes
+    size_t              bytesSkipped;           ///< Number of bytes skipped by a differential download because the CN already holds them
 } tCfmEventCnProgress;
 
 #endif /* _INC_oplk_cfm_H_ */
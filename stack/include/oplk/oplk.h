@@ -58,6 +58,12 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define OPLK_MAX_ETH_DEVICE_NAME    64
 #define OPLK_MAX_ETH_DEVICE_DESC    256
 
+#define OPLK_HISTOGRAM_SUB_BUCKET_BITS  3       ///< Number of bits used for the linear sub-buckets of each power of two
+#define OPLK_HISTOGRAM_BUCKET_COUNT     ((32 - OPLK_HISTOGRAM_SUB_BUCKET_BITS + 1) << OPLK_HISTOGRAM_SUB_BUCKET_BITS)
+
+#define OPLK_TIMER_LATENCY_HISTOGRAM_SIZE       32      ///< Number of buckets of the timer wake-up latency histogram
+#define OPLK_TIMER_LATENCY_HISTOGRAM_RESOLUTION 1000    ///< Width of a timer wake-up latency histogram bucket in ns
+
 //------------------------------------------------------------------------------
 // typedef
 //------------------------------------------------------------------------------
@@ -532,6 +538,118 @@ typedef struct
     BOOL            fValidRelTime;                  ///< TRUE if relative time is validated
 } tOplkApiSocTimeInfo;
 
+/**
+\brief  Log-linear histogram
+
+This structure provides a histogram with logarithmically growing bucket sizes.
+Values below 2^\ref OPLK_HISTOGRAM_SUB_BUCKET_BITS are counted in their own
+bucket. Every following power of two range [2^m, 2^(m+1)) is divided into
+2^\ref OPLK_HISTOGRAM_SUB_BUCKET_BITS linear sub-buckets. Thus, the relative
+error of a bucket is bounded by 2^-\ref OPLK_HISTOGRAM_SUB_BUCKET_BITS over the
+whole 32 bit value range. A value v >= 2^s (s = sub-bucket bits) with most
+significant bit m is counted in bucket ((m - s + 1) << s) + ((v >> (m - s)) & (2^s - 1)).
+*/
+typedef struct
+{
+    UINT64          sampleCount;                    ///< Number of recorded values
+    UINT64          sum;                            ///< Sum of all recorded values
+    UINT32          minValue;                       ///< Minimum recorded value
+    UINT32          maxValue;                       ///< Maximum recorded value
+    UINT32          aBucket[OPLK_HISTOGRAM_BUCKET_COUNT]; ///< Bucket counters
+} tOplkApiHistogram;
+
+/**
+\brief  Cycle statistics structure
+
+This structure provides the timing statistics of the cyclic frame transmission
+of an MN. All values are given in ns.
+*/
+typedef struct
+{
+    UINT32              cycleTimeNs;                ///< Configured cycle time
+    tOplkApiHistogram   cycleJitter;                ///< Deviation of the measured cycle time from the configured one
+    tOplkApiHistogram   txSlotSpacing;              ///< Time between consecutive timer triggered frame transmissions
+    tOplkApiHistogram   syncCbExecTime;             ///< Execution time of the sync callback
+} tOplkApiCycleStatistics;
+
+/**
+\brief  Timer statistics structure
+
+This structure provides the wake-up latency of the high-resolution timers of
+the kernel stack, i.e. the time between the deadline of a timer and the call of
+its callback function. All values are given in ns.
+*/
+typedef struct
+{
+    UINT64          expiryCount;                    ///< Number of timer expiries
+    UINT32          minLatency;                     ///< Minimum wake-up latency
+    UINT32          maxLatency;                     ///< Maximum wake-up latency
+    UINT64          latencySum;                     ///< Sum of all wake-up latencies
+    UINT32          aHistogram[OPLK_TIMER_LATENCY_HISTOGRAM_SIZE]; ///< Latency histogram, the last bucket counts all larger latencies
+} tOplkApiTimerStatistics;
+
+/**
+\brief  Thread roles
+
+This enumeration lists the roles of the threads started by the openPOWERLINK
+stack on Linux. The scheduling of all threads of a role can be configured with
+\ref oplk_setThreadParameters.
+*/
+typedef enum
+{
+    kOplkThreadRoleEdrvRx           = 0,            ///< Receive thread of the Ethernet driver (oplk-edrv*)
+    kOplkThreadRoleHresTimer        = 1,            ///< High-resolution cycle timer thread (oplk-hrtimer)
+    kOplkThreadRoleEventKernel      = 2,            ///< Kernel event thread (oplk-eventk)
+    kOplkThreadRoleEventUser        = 3,            ///< User event threads (oplk-eventu*)
+    kOplkThreadRoleTimerUser        = 4,            ///< User timer thread (oplk-timeru)
+    kOplkThreadRoleSdoUdp           = 5,            ///< SDO/UDP receive thread (oplk-sdoudp)
+    kOplkThreadRoleVeth             = 6,            ///< Virtual Ethernet thread (oplk-veth)
+    kOplkThreadRoleCount,                           ///< Dummy enum to get the number of roles
+} eOplkThreadRole;
+
+/**
+\brief Thread role data type
+
+Data type for the enumerator \ref eOplkThreadRole.
+*/
+typedef UINT32 tOplkThreadRole;
+
+/**
+\brief  Thread scheduling policies
+
+This enumeration lists the scheduling policies of a stack thread.
+*/
+typedef enum
+{
+    kOplkThreadPolicyDefault        = 0,            ///< Keep the default policy of the thread
+    kOplkThreadPolicyOther          = 1,            ///< Normal scheduling (SCHED_OTHER)
+    kOplkThreadPolicyFifo           = 2,            ///< Real-time FIFO scheduling (SCHED_FIFO)
+    kOplkThreadPolicyRr             = 3,            ///< Real-time round-robin scheduling (SCHED_RR)
+} eOplkThreadPolicy;
+
+/**
+\brief Thread policy data type
+
+Data type for the enumerator \ref eOplkThreadPolicy.
+*/
+typedef UINT32 tOplkThreadPolicy;
+
+#define OPLK_THREAD_NAME_LENGTH     16              ///< Maximum length of a thread name including the terminating zero
+
+/**
+\brief  Thread parameters
+
+This structure describes the CPU affinity, the scheduling and the name of the
+threads of a role. Zero or empty members keep the defaults of the stack.
+*/
+typedef struct
+{
+    UINT64              cpuMask;                    ///< CPUs the threads may run on (bit n selects CPU n), 0 keeps the inherited affinity
+    tOplkThreadPolicy   policy;                     ///< Scheduling policy
+    UINT                priority;                   ///< Real-time priority, 0 keeps the default priority of the thread
+    char                aName[OPLK_THREAD_NAME_LENGTH]; ///< Thread name, an empty string keeps the default name
+} tOplkThreadParameters;
+
 //------------------------------------------------------------------------------
 // function prototypes
 //------------------------------------------------------------------------------
@@ -592,6 +710,7 @@ OPLKDLLEXPORT tOplkError oplk_enableUserObdAccess(BOOL fEnable_p);
 OPLKDLLEXPORT tOplkError oplk_freeSdoChannel(tSdoComConHdl sdoComConHdl_p);
 OPLKDLLEXPORT tOplkError oplk_abortSdo(tSdoComConHdl sdoComConHdl_p,
                                        UINT32 abortCode_p);
+OPLKDLLEXPORT tOplkError oplk_setSdoWindowSize(UINT windowSize_p);
 OPLKDLLEXPORT tOplkError oplk_readLocalObject(UINT index_p,
                                               UINT subindex_p,
                                               void* pDstData_p,
@@ -626,6 +745,14 @@ OPLKDLLEXPORT const char* oplk_getVersionString(void);
 OPLKDLLEXPORT UINT32 oplk_getStackConfiguration(void);
 OPLKDLLEXPORT tOplkError oplk_getStackInfo(tOplkApiStackInfo* pStackInfo_p);
 OPLKDLLEXPORT tOplkError oplk_getSocTime(tOplkApiSocTimeInfo* pTimeInfo_p);
+OPLKDLLEXPORT tOplkError oplk_getCycleStatistics(tOplkApiCycleStatistics* pStatistics_p);
+OPLKDLLEXPORT tOplkError oplk_resetCycleStatistics(void);
+OPLKDLLEXPORT tOplkError oplk_getTimerStatistics(tOplkApiTimerStatistics* pStatistics_p);
+OPLKDLLEXPORT tOplkError oplk_resetTimerStatistics(void);
+OPLKDLLEXPORT tOplkError oplk_setThreadParameters(tOplkThreadRole role_p,
+                                                  const tOplkThreadParameters* pThreadParam_p);
+OPLKDLLEXPORT tOplkError oplk_getThreadParameters(tOplkThreadRole role_p,
+                                                  tOplkThreadParameters* pThreadParam_p);
 OPLKDLLEXPORT tOplkError oplk_exchangeAppPdoIn(void);
 OPLKDLLEXPORT tOplkError oplk_exchangeAppPdoOut(void);
 
@@ -643,6 +770,7 @@ OPLKDLLEXPORT tOplkError oplk_exchangeProcessImageIn(void);
 OPLKDLLEXPORT tOplkError oplk_exchangeProcessImageOut(void);
 OPLKDLLEXPORT void* oplk_getProcessImageIn(void);
 OPLKDLLEXPORT void* oplk_getProcessImageOut(void);
+OPLKDLLEXPORT tOplkError oplk_enableProcessImageZeroCopy(BOOL fEnable_p);
 
 // objdict specific process image functions
 OPLKDLLEXPORT OPLK_DEPRECATED tOplkError oplk_setupProcessImage(void);
@@ -49,7 +49,12 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 // size for complete SDO send frame (without CRC)
 // valid range: [C_DLL_MIN_ASYNC_MTU .. C_DLL_MAX_ASYNC_MTU] + Eth. header
+// It must not exceed the asynchronous MTU of the network (0x1F98/08).
+#ifdef CONFIG_SDO_MAX_TX_FRAME_SIZE
+#define SDO_MAX_TX_FRAME_SIZE           CONFIG_SDO_MAX_TX_FRAME_SIZE
+#else
 #define SDO_MAX_TX_FRAME_SIZE           314
+#endif
 
 
 //------------------------------------------------------------------------------
@@ -96,7 +96,11 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define OPLK_DCACHE_INVALIDATE(addr, len)   ((void)0)
 
 // Target memory barrier function
-#define OPLK_MEMBAR()               ((void)0)
+#ifndef __KERNEL__
+#define OPLK_MEMBAR()               __sync_synchronize()
+#else
+#define OPLK_MEMBAR()               mb()
+#endif
 
 // Target lock
 #define OPLK_LOCK_T                 UINT8
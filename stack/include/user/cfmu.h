@@ -66,6 +66,7 @@ extern "C"
 tOplkError cfmu_init(tCfmCbEventCnProgress pfnCbEventCnProgress_p,
                      tCfmCbEventCnResult pfnCbEventCnResult_p);
 tOplkError cfmu_exit(void);
+tOplkError cfmu_linkDefaultConciseDcf(UINT nodeId_p);
 tOplkError cfmu_processNodeEvent(UINT nodeId_p,
                                  tNmtNodeEvent nodeEvent_p,
                                  tNmtState nmtState_p);
@@ -77,6 +77,10 @@ UINT32       ctrlu_getFeatureFlags(void);
 tOplkError   ctrlu_writeFileChunk(const tOplkApiFileChunkDesc* pDesc_p,
                                   const void* pBuffer_p);
 size_t       ctrlu_getMaxFileChunkSize(void);
+tOplkError   ctrlu_getTimerStatistics(tOplkApiTimerStatistics* pStatistics_p);
+tOplkError   ctrlu_resetTimerStatistics(void);
+tOplkError   ctrlu_getCycleStatistics(tOplkApiCycleStatistics* pStatistics_p);
+tOplkError   ctrlu_resetCycleStatistics(void);
 
 #ifdef __cplusplus
 }
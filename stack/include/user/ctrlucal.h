@@ -70,6 +70,8 @@ UINT16           ctrlucal_getStatus(void);
 UINT16           ctrlucal_getHeartbeat(void);
 void             ctrlucal_storeInitParam(const tCtrlInitParam* pInitParam_p);
 tOplkError       ctrlucal_readInitParam(tCtrlInitParam* pInitParam_p);
+tOplkError       ctrlucal_readStatistics(void* pStatistics_p,
+                                         size_t size_p);
 tOplkError       ctrlucal_writeFileBuffer(const tOplkApiFileChunkDesc* pDesc_p,
                                           const void* pBuffer_p);
 size_t           ctrlucal_getFileBufferSize(void);
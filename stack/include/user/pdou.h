@@ -89,6 +89,9 @@ tOplkError pdou_cbNmtStateChange(tEventNmtStateChange nmtStateChange_p);
 
 tOplkError pdou_copyRxPdoToPi(void);
 tOplkError pdou_copyTxPdoFromPi(void);
+tOplkError pdou_getRxPdoImage(const void* pImage_p,
+                              size_t imageSize_p,
+                              void** ppPdo_p);
 tOplkError pdou_registerEventPdoChangeCb(tPdoCbEventPdoChange pfnCbEventPdoChange_p);
 
 #ifdef __cplusplus
@@ -72,6 +72,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define CONFIG_SDO_MAX_CONNECTION_COM           5
 #endif
 
+#define SDO_COM_CON_CACHE_SIZE                  (2 * CONFIG_SDO_MAX_CONNECTION_COM)
+
 //------------------------------------------------------------------------------
 // typedef
 //------------------------------------------------------------------------------
@@ -251,6 +253,7 @@ This structure describes a SDO command layer instance
 typedef struct
 {
     tSdoComCon          sdoComCon[CONFIG_SDO_MAX_CONNECTION_COM];   ///< Array to store command layer connections
+    tSdoComConHdl       aConHdlCache[SDO_COM_CON_CACHE_SIZE];       ///< Last used command layer handle for sequence layer handles (validated on use)
 #if defined(CONFIG_INCLUDE_SDOS)
     tSdoComConHdl       sdoObdConCounter;                           ///< OD connection handle counter for object accesses
     tComdLayerObdCb     pfnProcessObdWrite;                         ///< OD callback function for WriteByIndex processing
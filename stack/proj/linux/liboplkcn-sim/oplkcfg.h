@@ -62,6 +62,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define CONFIG_INCLUDE_SDOC
 #define CONFIG_INCLUDE_SDO_ASND
 #define CONFIG_INCLUDE_SDO_RW_MULTIPLE
+#define CONFIG_INCLUDE_VETH
 #define CONFIG_INCLUDE_MASND
 #define CONFIG_INCLUDE_LEDK
 
@@ -128,6 +129,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // SDO module specific defines
 //==============================================================================
 
+// allow large SDO windows, e.g. for the throughput measurements of the simulator
+#define CONFIG_SDO_SEQ_HISTORY_SIZE                 31
 
 //==============================================================================
 // Trace defines
@@ -123,6 +123,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define CONFIG_OBD_CALC_OD_SIGNATURE                TRUE
 #endif
 
+// Switch this define to TRUE if the OD entries should be accessed through
+// a lookup table built at initialization instead of searching the OD
+#define CONFIG_OBD_USE_LOOKUP_TABLE                 TRUE
+
 //==============================================================================
 // Timer module specific defines
 //==============================================================================
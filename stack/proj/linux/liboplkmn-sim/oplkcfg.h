@@ -63,6 +63,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define CONFIG_INCLUDE_SDOC
 #define CONFIG_INCLUDE_SDO_ASND
 #define CONFIG_INCLUDE_SDO_RW_MULTIPLE
+#define CONFIG_INCLUDE_VETH
 #define CONFIG_INCLUDE_CFM
 #define CONFIG_INCLUDE_PRES_FORWARD
 #define CONFIG_INCLUDE_LEDK
@@ -135,6 +136,9 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define CONFIG_SDO_MAX_CONNECTION_COM               100
 #define CONFIG_SDO_MAX_CONNECTION_UDP               50
 
+// allow large SDO windows, e.g. for the throughput measurements of the simulator
+#define CONFIG_SDO_SEQ_HISTORY_SIZE                 31
+
 //==============================================================================
 // Trace defines
 //==============================================================================
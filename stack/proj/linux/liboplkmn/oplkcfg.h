@@ -78,6 +78,11 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #define CONFIG_DLLCAL_QUEUE                         CIRCBUF_QUEUE
 
+// The MN ident and status request queues are only written by the kernel event
+// thread and only read by the DLL, so they are accessed without locking.
+#define CONFIG_CIRCBUF_LOCKFREE_BUFFERS             ((1UL << CIRCBUF_DLLCAL_CN_REQ_IDENT) | \
+                                                     (1UL << CIRCBUF_DLLCAL_CN_REQ_STATUS))
+
 #define CONFIG_VETH_SET_DEFAULT_GATEWAY             FALSE
 
 #define CONFIG_CHECK_HEARTBEAT_PERIOD               1000        // 1000 ms
@@ -92,6 +97,9 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // switch this define to TRUE to include Edrv diagnostic functions
 #define CONFIG_EDRV_USE_DIAGNOSTICS                 FALSE
 
+// switch this define to TRUE to collect cycle timing histograms (oplk_getCycleStatistics())
+#define CONFIG_EDRV_CYCLIC_USE_STATISTICS           TRUE
+
 //==============================================================================
 // Data Link Layer (DLL) specific defines
 //==============================================================================
@@ -121,12 +129,17 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #if defined(CONFIG_INCLUDE_CFM)
 #define CONFIG_OBD_DEF_CONCISEDCF_FILENAME          "mnobd.cdc"
 #define CONFIG_CFM_CONFIGURE_CYCLE_LENGTH           TRUE
+#define CONFIG_CFM_DIFFERENTIAL_DOWNLOAD            TRUE
 #endif
 
 // Configure if the range from 0xA000 is used for mapping client objects.
 // openCONFIGURATOR uses this range for mapping objects.
 #define CONFIG_OBD_INCLUDE_A000_TO_DEVICE_PART      TRUE
 
+// Switch this define to TRUE if the OD entries should be accessed through
+// a lookup table built at initialization instead of searching the OD
+#define CONFIG_OBD_USE_LOOKUP_TABLE                 TRUE
+
 //==============================================================================
 // Timer module specific defines
 //==============================================================================
@@ -144,4 +157,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define CONFIG_SDO_MAX_CONNECTION_COM               100
 #define CONFIG_SDO_MAX_CONNECTION_UDP               50
 
+// allow large SDO windows for segmented downloads to CNs
+#define CONFIG_SDO_SEQ_HISTORY_SIZE                 31
+
 #endif // _INC_oplkcfg_H_
@@ -72,6 +72,11 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #define CONFIG_DLLCAL_QUEUE                         CIRCBUF_QUEUE
 
+// The MN ident and status request queues are only written by the kernel event
+// thread and only read by the DLL, so they are accessed without locking.
+#define CONFIG_CIRCBUF_LOCKFREE_BUFFERS             ((1UL << CIRCBUF_DLLCAL_CN_REQ_IDENT) | \
+                                                     (1UL << CIRCBUF_DLLCAL_CN_REQ_STATUS))
+
 //==============================================================================
 // Ethernet driver (Edrv) specific defines
 //==============================================================================
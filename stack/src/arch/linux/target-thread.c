@@ -0,0 +1,459 @@
+/**
+********************************************************************************
+\file   linux/target-thread.c
+
+\brief  Architecture specific thread configuration
+
+This file contains the configuration of the threads started by the
+openPOWERLINK stack in Linux userspace. Every thread registers itself with its
+role. The CPU affinity, the scheduling and the name configured for a role are
+applied to all threads of this role.
+
+\ingroup module_target
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2017, B&R Industrial Automation GmbH
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <common/oplkinc.h>
+#include <common/target.h>
+
+#include <pthread.h>
+#include <sched.h>
+#include <string.h>
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define TARGET_THREAD_MAX_PER_ROLE      2       // The user event CAL of the dual processor shm interface uses two threads
+
+#if (defined(__GLIBC__) && (__GLIBC__ >= 2) && (__GLIBC_MINOR__ >= 12))
+#define TARGET_THREAD_USE_NAME
+#endif
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+/**
+\brief Registered thread
+
+The structure describes a running stack thread and its default settings.
+*/
+typedef struct
+{
+    BOOL                    fUsed;                          ///< Entry is used by a running thread
+    pthread_t               thread;                         ///< Thread handle
+    tOplkThreadPolicy       defaultPolicy;                  ///< Default scheduling policy of the thread
+    UINT                    defaultPriority;                ///< Default priority of the thread
+    char                    aDefaultName[OPLK_THREAD_NAME_LENGTH]; ///< Default name of the thread
+} tTargetThread;
+
+/**
+\brief Thread role
+
+The structure contains the configuration and the running threads of a role.
+*/
+typedef struct
+{
+    tOplkThreadParameters   param;                          ///< Configured thread parameters
+    tTargetThread           aThread[TARGET_THREAD_MAX_PER_ROLE]; ///< Running threads of the role
+} tTargetThreadRole;
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static tTargetThreadRole    aThreadRole_l[kOplkThreadRoleCount];
+static pthread_mutex_t      threadMutex_l = PTHREAD_MUTEX_INITIALIZER;
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static tOplkError applyThreadParameters(const tOplkThreadParameters* pThreadParam_p,
+                                        const tTargetThread* pThread_p);
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief    Set thread parameters of a role
+
+The function stores the thread parameters of the specified role. They are
+applied to the threads of this role which are already running and to all
+threads of this role started later on.
+
+\param[in]      role_p              Thread role to be configured.
+\param[in]      pThreadParam_p      Pointer to the thread parameters.
+
+\return The function returns a tOplkError error code.
+\retval kErrorOk                    The parameters were stored and applied.
+\retval kErrorNoResource            The parameters could not be applied to a
+                                    running thread.
+
+\ingroup module_target
+*/
+//------------------------------------------------------------------------------
+tOplkError target_setThreadParameters(tOplkThreadRole role_p,
+                                      const tOplkThreadParameters* pThreadParam_p)
+{
+    tOplkError          ret = kErrorOk;
+    tTargetThreadRole*  pRole;
+    UINT                i;
+
+    if ((role_p >= kOplkThreadRoleCount) || (pThreadParam_p == NULL))
+        return kErrorInvalidOperation;
+
+    pRole = &aThreadRole_l[role_p];
+
+    pthread_mutex_lock(&threadMutex_l);
+
+    pRole->param = *pThreadParam_p;
+    pRole->param.aName[OPLK_THREAD_NAME_LENGTH - 1] = '\0';
+
+    for (i = 0; i < TARGET_THREAD_MAX_PER_ROLE; i++)
+    {
+        if (pRole->aThread[i].fUsed &&
+            (applyThreadParameters(&pRole->param, &pRole->aThread[i]) != kErrorOk))
+        {
+            ret = kErrorNoResource;
+        }
+    }
+
+    pthread_mutex_unlock(&threadMutex_l);
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief    Get thread parameters of a role
+
+The function returns the CPU affinity, the scheduling and the name which have
+actually been achieved by the first running thread of the specified role.
+
+\param[in]      role_p              Thread role to be queried.
+\param[out]     pThreadParam_p      Pointer to store the thread parameters.
+
+\return The function returns a tOplkError error code.
+\retval kErrorOk                    The parameters were returned.
+\retval kErrorIllegalInstance       No thread of the role is running.
+
+\ingroup module_target
+*/
+//------------------------------------------------------------------------------
+tOplkError target_getThreadParameters(tOplkThreadRole role_p,
+                                      tOplkThreadParameters* pThreadParam_p)
+{
+    tOplkError          ret = kErrorIllegalInstance;
+    tTargetThreadRole*  pRole;
+    pthread_t           thread;
+    struct sched_param  schedParam;
+    int                 policy;
+    cpu_set_t           cpuSet;
+    UINT                i;
+
+    if ((role_p >= kOplkThreadRoleCount) || (pThreadParam_p == NULL))
+        return kErrorInvalidOperation;
+
+    pRole = &aThreadRole_l[role_p];
+
+    pthread_mutex_lock(&threadMutex_l);
+
+    for (i = 0; i < TARGET_THREAD_MAX_PER_ROLE; i++)
+    {
+        if (!pRole->aThread[i].fUsed)
+            continue;
+
+        thread = pRole->aThread[i].thread;
+        if (pthread_getschedparam(thread, &policy, &schedParam) != 0)
+            break;
+
+        memset(pThreadParam_p, 0, sizeof(*pThreadParam_p));
+        switch (policy)
+        {
+            case SCHED_FIFO:
+                pThreadParam_p->policy = kOplkThreadPolicyFifo;
+                pThreadParam_p->priority = schedParam.sched_priority;
+                break;
+
+            case SCHED_RR:
+                pThreadParam_p->policy = kOplkThreadPolicyRr;
+                pThreadParam_p->priority = schedParam.sched_priority;
+                break;
+
+            default:
+                pThreadParam_p->policy = kOplkThreadPolicyOther;
+                break;
+        }
+
+        CPU_ZERO(&cpuSet);
+        if (pthread_getaffinity_np(thread, sizeof(cpuSet), &cpuSet) == 0)
+        {
+            UINT    cpu;
+
+            for (cpu = 0; cpu < 64; cpu++)
+            {
+                if (CPU_ISSET(cpu, &cpuSet))
+                    pThreadParam_p->cpuMask |= (UINT64)1 << cpu;
+            }
+        }
+
+#if defined(TARGET_THREAD_USE_NAME)
+        pthread_getname_np(thread, pThreadParam_p->aName, sizeof(pThreadParam_p->aName));
+#else
+        strncpy(pThreadParam_p->aName, pRole->aThread[i].aDefaultName, sizeof(pThreadParam_p->aName) - 1);
+#endif
+
+        ret = kErrorOk;
+        break;
+    }
+
+    pthread_mutex_unlock(&threadMutex_l);
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief    Register a stack thread
+
+The function registers a newly created stack thread with its role. The thread
+parameters configured for the role are applied to the thread. Parameters which
+are not configured are taken from the given defaults.
+
+\param[in]      role_p              Role of the thread.
+\param[in]      thread_p            Handle of the thread.
+\param[in]      defaultPolicy_p     Default scheduling policy of the thread.
+                                    kOplkThreadPolicyDefault keeps the inherited
+                                    policy.
+\param[in]      defaultPriority_p   Default real-time priority of the thread.
+\param[in]      pDefaultName_p      Default name of the thread.
+
+\return The function returns a tOplkError error code.
+\retval kErrorOk                    The thread was registered and configured.
+\retval kErrorNoResource            The thread could not be configured.
+
+\ingroup module_target
+*/
+//------------------------------------------------------------------------------
+tOplkError target_registerThread(tOplkThreadRole role_p,
+                                 pthread_t thread_p,
+                                 tOplkThreadPolicy defaultPolicy_p,
+                                 UINT defaultPriority_p,
+                                 const char* pDefaultName_p)
+{
+    tOplkError          ret;
+    tTargetThread       thread;
+    tTargetThread*      pFreeEntry = NULL;
+    UINT                i;
+
+    if (role_p >= kOplkThreadRoleCount)
+        return kErrorInvalidOperation;
+
+    memset(&thread, 0, sizeof(thread));
+    thread.fUsed = TRUE;
+    thread.thread = thread_p;
+    thread.defaultPolicy = defaultPolicy_p;
+    thread.defaultPriority = defaultPriority_p;
+    strncpy(thread.aDefaultName, pDefaultName_p, sizeof(thread.aDefaultName) - 1);
+
+    pthread_mutex_lock(&threadMutex_l);
+
+    ret = applyThreadParameters(&aThreadRole_l[role_p].param, &thread);
+
+    for (i = 0; i < TARGET_THREAD_MAX_PER_ROLE; i++)
+    {
+        if (!aThreadRole_l[role_p].aThread[i].fUsed)
+        {
+            pFreeEntry = &aThreadRole_l[role_p].aThread[i];
+            break;
+        }
+    }
+
+    // A thread which does not fit is configured but cannot be reconfigured later
+    if (pFreeEntry != NULL)
+        *pFreeEntry = thread;
+
+    pthread_mutex_unlock(&threadMutex_l);
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief    Unregister a stack thread
+
+The function removes a stack thread from its role. It must be called before
+the thread is joined.
+
+\param[in]      role_p              Role of the thread.
+\param[in]      thread_p            Handle of the thread.
+
+\ingroup module_target
+*/
+//------------------------------------------------------------------------------
+void target_unregisterThread(tOplkThreadRole role_p,
+                             pthread_t thread_p)
+{
+    UINT    i;
+
+    if (role_p >= kOplkThreadRoleCount)
+        return;
+
+    pthread_mutex_lock(&threadMutex_l);
+
+    for (i = 0; i < TARGET_THREAD_MAX_PER_ROLE; i++)
+    {
+        if (aThreadRole_l[role_p].aThread[i].fUsed &&
+            pthread_equal(aThreadRole_l[role_p].aThread[i].thread, thread_p))
+        {
+            aThreadRole_l[role_p].aThread[i].fUsed = FALSE;
+        }
+    }
+
+    pthread_mutex_unlock(&threadMutex_l);
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief    Apply thread parameters
+
+The function applies the configured thread parameters to a thread. Parameters
+which are not configured are taken from the defaults of the thread.
+
+\param[in]      pThreadParam_p      Pointer to the configured thread parameters.
+\param[in]      pThread_p           Pointer to the thread.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError applyThreadParameters(const tOplkThreadParameters* pThreadParam_p,
+                                        const tTargetThread* pThread_p)
+{
+    tOplkError          ret = kErrorOk;
+    tOplkThreadPolicy   policy;
+    struct sched_param  schedParam;
+    cpu_set_t           cpuSet;
+    UINT                cpu;
+    int                 result;
+
+    policy = (pThreadParam_p->policy != kOplkThreadPolicyDefault) ? pThreadParam_p->policy
+                                                                   : pThread_p->defaultPolicy;
+
+    memset(&schedParam, 0, sizeof(schedParam));
+    if (policy != kOplkThreadPolicyOther)
+    {
+        schedParam.sched_priority = (pThreadParam_p->priority != 0) ? pThreadParam_p->priority
+                                                                     : pThread_p->defaultPriority;
+    }
+
+    switch (policy)
+    {
+        case kOplkThreadPolicyOther:
+            result = pthread_setschedparam(pThread_p->thread, SCHED_OTHER, &schedParam);
+            break;
+
+        case kOplkThreadPolicyFifo:
+            result = pthread_setschedparam(pThread_p->thread, SCHED_FIFO, &schedParam);
+            break;
+
+        case kOplkThreadPolicyRr:
+            result = pthread_setschedparam(pThread_p->thread, SCHED_RR, &schedParam);
+            break;
+
+        default:
+            result = 0;
+            break;
+    }
+
+    if (result != 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s(): couldn't set thread scheduling parameters of %s! %d\n",
+                              __func__,
+                              pThread_p->aDefaultName,
+                              schedParam.sched_priority);
+        ret = kErrorNoResource;
+    }
+
+    if (pThreadParam_p->cpuMask != 0)
+    {
+        CPU_ZERO(&cpuSet);
+        for (cpu = 0; cpu < 64; cpu++)
+        {
+            if ((pThreadParam_p->cpuMask & ((UINT64)1 << cpu)) != 0)
+                CPU_SET(cpu, &cpuSet);
+        }
+
+        if (pthread_setaffinity_np(pThread_p->thread, sizeof(cpuSet), &cpuSet) != 0)
+        {
+            DEBUG_LVL_ERROR_TRACE("%s(): couldn't set CPU affinity of %s!\n",
+                                  __func__,
+                                  pThread_p->aDefaultName);
+            ret = kErrorNoResource;
+        }
+    }
+
+#if defined(TARGET_THREAD_USE_NAME)
+    pthread_setname_np(pThread_p->thread,
+                       (pThreadParam_p->aName[0] != '\0') ? pThreadParam_p->aName
+                                                          : pThread_p->aDefaultName);
+#endif
+
+    return ret;
+}
+
+/// \}
@@ -306,6 +306,55 @@ tOplkError target_getSystemTime(tNetTime* pNetTime_p, BOOL* pValidSystemTime_p)
 }
 #endif
 
+#if ((TARGET_SYSTEM == _LINUX_) && !defined(__KERNEL__))
+//------------------------------------------------------------------------------
+/**
+\brief  Set thread parameters of a thread role
+
+The simulated stack creates no threads, it is executed by the simulation
+environment. Therefore the thread configuration is not supported.
+
+\param[in]      role_p              The thread role to be configured.
+\param[in]      pThreadParam_p      Pointer to the thread parameters.
+
+\return The function returns kErrorApiNotSupported.
+
+\ingroup module_target
+*/
+//------------------------------------------------------------------------------
+tOplkError target_setThreadParameters(tOplkThreadRole role_p,
+                                      const tOplkThreadParameters* pThreadParam_p)
+{
+    UNUSED_PARAMETER(role_p);
+    UNUSED_PARAMETER(pThreadParam_p);
+
+    return kErrorApiNotSupported;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get achieved thread parameters of a thread role
+
+The simulated stack creates no threads (see \ref target_setThreadParameters).
+
+\param[in]      role_p              The thread role to be reported.
+\param[out]     pThreadParam_p      Pointer to store the thread parameters.
+
+\return The function returns kErrorApiNotSupported.
+
+\ingroup module_target
+*/
+//------------------------------------------------------------------------------
+tOplkError target_getThreadParameters(tOplkThreadRole role_p,
+                                      tOplkThreadParameters* pThreadParam_p)
+{
+    UNUSED_PARAMETER(role_p);
+    UNUSED_PARAMETER(pThreadParam_p);
+
+    return kErrorApiNotSupported;
+}
+#endif
+
 //============================================================================//
 //            P R I V A T E   F U N C T I O N S                               //
 //============================================================================//
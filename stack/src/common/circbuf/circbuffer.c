@@ -61,6 +61,13 @@ calling circbuf_connect(). The same applies for deinitialization.
 After all connected instances are disconnected by calling circbuf_disconnect(),
 the main instance can clean up and free the buffer by calling circbuf_free().
 
+Buffers which are selected in \ref CONFIG_CIRCBUF_LOCKFREE_BUFFERS are accessed
+without the lock. This is only allowed if exactly one instance writes to the
+buffer and exactly one instance reads from it. In this mode the producer and the
+consumer only modify their own position in the buffer header and publish it
+after the data with a memory barrier. Such a buffer may only be reset by its
+consumer, see circbuf_reset().
+
 *******************************************************************************/
 
 //------------------------------------------------------------------------------
@@ -68,6 +75,10 @@ the main instance can clean up and free the buffer by calling circbuf_free().
 //------------------------------------------------------------------------------
 #include "circbuf-arch.h"
 
+#ifndef __KERNEL__
+#include <stddef.h>
+#endif
+
 //============================================================================//
 //            G L O B A L   D E F I N I T I O N S                             //
 //============================================================================//
@@ -96,6 +107,11 @@ the main instance can clean up and free the buffer by calling circbuf_free().
 //------------------------------------------------------------------------------
 // local types
 //------------------------------------------------------------------------------
+// The lock-free positions must start on cache lines of their own, otherwise the
+// producer and the consumer share a cache line (compile time check).
+typedef char tCircBufHeaderLayoutCheck[((offsetof(tCircBufHeader, writePos) == CIRCBUF_CACHE_LINE_SIZE) &&
+                                        (offsetof(tCircBufHeader, readPos) == (2 * CIRCBUF_CACHE_LINE_SIZE)) &&
+                                        (sizeof(tCircBufHeader) == (3 * CIRCBUF_CACHE_LINE_SIZE))) ? 1 : -1];
 
 //------------------------------------------------------------------------------
 // local vars
@@ -104,6 +120,18 @@ the main instance can clean up and free the buffer by calling circbuf_free().
 //------------------------------------------------------------------------------
 // local function prototypes
 //------------------------------------------------------------------------------
+static tCircBufError beginWrite(tCircBufInstance* pInstance_p,
+                                UINT32 fullBlockSize_p,
+                                UINT32* pWriteOffset_p);
+static void          finishWrite(tCircBufInstance* pInstance_p,
+                                 UINT32 writeOffset_p,
+                                 UINT32 fullBlockSize_p);
+static tCircBufError beginRead(tCircBufInstance* pInstance_p,
+                               UINT32* pReadOffset_p);
+static void          finishRead(tCircBufInstance* pInstance_p,
+                                UINT32 readOffset_p,
+                                UINT32 fullBlockSize_p);
+static void          abortAccess(tCircBufInstance* pInstance_p);
 
 //============================================================================//
 //            P U B L I C   F U N C T I O N S                                 //
@@ -159,6 +187,10 @@ tCircBufError circbuf_alloc(UINT8 id_p, size_t size_p, tCircBufInstance** ppInst
 #ifdef DEBUG_CIRCBUF_SIZE_CHECK
     pInstance->pCircBufHeader->maxSize = 0;
 #endif
+    pInstance->pCircBufHeader->fLockFree = ((CONFIG_CIRCBUF_LOCKFREE_BUFFERS & (1UL << id_p)) != 0);
+    OPLK_MEMSET(&pInstance->pCircBufHeader->writePos, 0, sizeof(tCircBufPosition));
+    OPLK_MEMSET(&pInstance->pCircBufHeader->readPos, 0, sizeof(tCircBufPosition));
+    pInstance->fLockFree = (pInstance->pCircBufHeader->fLockFree != FALSE);
     pInstance->pfnSigCb = NULL;
 
     OPLK_DCACHE_FLUSH(pInstance->pCircBufHeader, sizeof(tCircBufHeader));
@@ -226,6 +258,14 @@ tCircBufError circbuf_connect(UINT8 id_p, tCircBufInstance** ppInstance_p)
         return kCircBufNoResource;
     }
 
+    // If all instances share one descriptor (noos), the buffer may be connected
+    // before it is allocated. circbuf_alloc() sets the mode in this case.
+    if (pInstance->pCircBufHeader != NULL)
+    {
+        OPLK_DCACHE_INVALIDATE(pInstance->pCircBufHeader, sizeof(tCircBufHeader));
+        pInstance->fLockFree = (pInstance->pCircBufHeader->fLockFree != FALSE);
+    }
+
     *ppInstance_p = pInstance;
 
     return kCircBufOk;
@@ -261,6 +301,11 @@ tCircBufError circbuf_disconnect(tCircBufInstance* pInstance_p)
 The function resets a circular buffer. The read and write pointer are set
 to the start address of the buffer.
 
+A lock-free buffer must only be reset by its consumer, because the lock does
+not exclude the other side. The function discards the blocks which have been
+written so far like a read does. The producer may continue writing during the
+reset, a block written concurrently is either discarded or kept completely.
+
 \param[in]      pInstance_p         Pointer to circular buffer instance to be reset.
 
 \ingroup module_lib_circbuf
@@ -269,18 +314,53 @@ to the start address of the buffer.
 void circbuf_reset(tCircBufInstance* pInstance_p)
 {
     tCircBufHeader*     pHeader;
+    const UINT8*        pCircBuf;
+    UINT32              writeByteCount;
+    UINT32              readOffset;
+    UINT32              dataSize;
+    UINT32              fullBlockSize;
 
     // Check parameter validity
     ASSERT(pInstance_p != NULL);
 
+    pHeader = pInstance_p->pCircBufHeader;
+
+    if (pInstance_p->fLockFree)
+    {
+        pCircBuf = (const UINT8*)pInstance_p->pCircBuf;
+
+        // The producer position can't be copied consistently while it is
+        // updated, therefore the blocks up to its byte count are skipped.
+        OPLK_DCACHE_INVALIDATE(&pHeader->writePos, sizeof(tCircBufPosition));
+        writeByteCount = pHeader->writePos.byteCount;
+
+        // Don't read block headers before the producer position
+        OPLK_MEMBAR();
+
+        readOffset = pHeader->readPos.offset;
+        while (pHeader->readPos.byteCount != writeByteCount)
+        {
+            OPLK_DCACHE_INVALIDATE((pCircBuf + readOffset), sizeof(UINT32));
+            dataSize = *(const UINT32*)(pCircBuf + readOffset);
+            fullBlockSize = ((dataSize + (CIRCBUF_BLOCK_ALIGNMENT - 1)) & ~(CIRCBUF_BLOCK_ALIGNMENT - 1)) +
+                            (UINT32)sizeof(UINT32);
+
+            readOffset = (readOffset + fullBlockSize) % pHeader->bufferSize;
+            finishRead(pInstance_p, readOffset, fullBlockSize);
+        }
+
+        return;
+    }
+
     circbuf_lock(pInstance_p);
     OPLK_DCACHE_INVALIDATE(pInstance_p->pCircBufHeader, sizeof(tCircBufHeader));
 
-    pHeader = pInstance_p->pCircBufHeader;
     pHeader->readOffset = 0;
     pHeader->writeOffset = 0;
     pHeader->freeSize = pHeader->bufferSize;
     pHeader->dataCount = 0;
+    OPLK_MEMSET(&pHeader->writePos, 0, sizeof(tCircBufPosition));
+    OPLK_MEMSET(&pHeader->readPos, 0, sizeof(tCircBufPosition));
 
     OPLK_DCACHE_FLUSH(pInstance_p->pCircBufHeader, sizeof(tCircBufHeader));
     circbuf_unlock(pInstance_p);
@@ -308,8 +388,10 @@ tCircBufError circbuf_writeData(tCircBufInstance* pInstance_p,
     UINT32              blockSize;
     UINT32              fullBlockSize;
     UINT32              chunkSize;
+    UINT32              writeOffset;
     tCircBufHeader*     pHeader;
     UINT8*              pCircBuf;
+    tCircBufError       ret;
 
     // Check parameter validity
     ASSERT(pInstance_p != NULL);
@@ -320,55 +402,42 @@ tCircBufError circbuf_writeData(tCircBufInstance* pInstance_p,
     blockSize     = ((UINT32)size_p + (CIRCBUF_BLOCK_ALIGNMENT - 1)) & ~(CIRCBUF_BLOCK_ALIGNMENT - 1);
     fullBlockSize = blockSize + (UINT32)sizeof(UINT32);
 
-    circbuf_lock(pInstance_p);
-
     pHeader = pInstance_p->pCircBufHeader;
     pCircBuf = (UINT8*)pInstance_p->pCircBuf;
 
-    OPLK_DCACHE_INVALIDATE(pHeader, sizeof(tCircBufHeader));
-    if (fullBlockSize > pHeader->freeSize)
-    {
-        circbuf_unlock(pInstance_p);
-        return kCircBufBufferFull;
-    }
+    ret = beginWrite(pInstance_p, fullBlockSize, &writeOffset);
+    if (ret != kCircBufOk)
+        return ret;
 
-    if (pHeader->writeOffset + fullBlockSize <= pHeader->bufferSize)
+    if (writeOffset + fullBlockSize <= pHeader->bufferSize)
     {
-        *(UINT32*)(pCircBuf + pHeader->writeOffset) = (UINT32)size_p;
+        *(UINT32*)(pCircBuf + writeOffset) = (UINT32)size_p;
 
-        OPLK_MEMCPY(pCircBuf + pHeader->writeOffset + sizeof(UINT32),
+        OPLK_MEMCPY(pCircBuf + writeOffset + sizeof(UINT32),
                     pData_p, size_p);
 
-        OPLK_DCACHE_FLUSH((pCircBuf + pHeader->writeOffset), fullBlockSize);
+        OPLK_DCACHE_FLUSH((pCircBuf + writeOffset), fullBlockSize);
 
-        if (pHeader->writeOffset + fullBlockSize == pHeader->bufferSize)
-            pHeader->writeOffset = 0;
+        if (writeOffset + fullBlockSize == pHeader->bufferSize)
+            writeOffset = 0;
         else
-            pHeader->writeOffset += fullBlockSize;
+            writeOffset += fullBlockSize;
     }
     else
     {
-        *(UINT32*)(pCircBuf + pHeader->writeOffset) = (UINT32)size_p;
-        chunkSize = pHeader->bufferSize - pHeader->writeOffset - (UINT32)sizeof(UINT32);
+        *(UINT32*)(pCircBuf + writeOffset) = (UINT32)size_p;
+        chunkSize = pHeader->bufferSize - writeOffset - (UINT32)sizeof(UINT32);
 
-        OPLK_MEMCPY(pCircBuf + pHeader->writeOffset + sizeof(UINT32),
+        OPLK_MEMCPY(pCircBuf + writeOffset + sizeof(UINT32),
                     pData_p, chunkSize);
-        OPLK_DCACHE_FLUSH((pCircBuf + pHeader->writeOffset), chunkSize + sizeof(UINT32));
+        OPLK_DCACHE_FLUSH((pCircBuf + writeOffset), chunkSize + sizeof(UINT32));
         OPLK_MEMCPY(pCircBuf, (const UINT8*)pData_p + chunkSize, size_p - chunkSize);
         OPLK_DCACHE_FLUSH((pCircBuf), (size_p - chunkSize));
 
-        pHeader->writeOffset = blockSize - chunkSize;
+        writeOffset = blockSize - chunkSize;
     }
-    pHeader->freeSize -= fullBlockSize;
-    pHeader->dataCount++;
 
-#ifdef DEBUG_CIRCBUF_SIZE_CHECK
-    if (pHeader->bufferSize - pHeader->freeSize > pHeader->maxSize)
-        pHeader->maxSize = pHeader->bufferSize - pHeader->freeSize;
-#endif
-    OPLK_DCACHE_FLUSH(pHeader, sizeof(tCircBufHeader));
-
-    circbuf_unlock(pInstance_p);
+    finishWrite(pInstance_p, writeOffset, fullBlockSize);
 
     if (pInstance_p->pfnSigCb != NULL)
     {
@@ -403,8 +472,10 @@ tCircBufError circbuf_writeMultipleData(tCircBufInstance* pInstance_p,
     UINT32              fullBlockSize;
     UINT32              chunkSize;
     UINT32              partSize;
+    UINT32              writeOffset;
     tCircBufHeader*     pHeader;
     UINT8*              pCircBuf;
+    tCircBufError       ret;
 
     // Check parameter validity
     ASSERT(pInstance_p != NULL);
@@ -420,73 +491,59 @@ tCircBufError circbuf_writeMultipleData(tCircBufInstance* pInstance_p,
     blockSize = ((UINT32)size_p + (UINT32)size2_p + (CIRCBUF_BLOCK_ALIGNMENT - 1)) & ~(CIRCBUF_BLOCK_ALIGNMENT - 1);
     fullBlockSize = blockSize + (UINT32)sizeof(UINT32);
 
-    //TRACE("%s() size:%d wroff:%d\n", __func__, pHeader->bufferSize, pHeader->writeOffset);
-    //TRACE("%s() ptr1:%p size1:%d ptr2:%p size2:%d\n", __func__, pData_p, size_p, pData2_p, size2_p);
-    circbuf_lock(pInstance_p);
-    OPLK_DCACHE_INVALIDATE(pHeader, sizeof(tCircBufHeader));
-    if (fullBlockSize > pHeader->freeSize)
-    {
-        circbuf_unlock(pInstance_p);
-        return kCircBufBufferFull;
-    }
+    ret = beginWrite(pInstance_p, fullBlockSize, &writeOffset);
+    if (ret != kCircBufOk)
+        return ret;
 
-    if (pHeader->writeOffset + fullBlockSize <= pHeader->bufferSize)
+    if (writeOffset + fullBlockSize <= pHeader->bufferSize)
     {
-        *(UINT32*)(pCircBuf + pHeader->writeOffset) = (UINT32)(size_p + size2_p);
+        *(UINT32*)(pCircBuf + writeOffset) = (UINT32)(size_p + size2_p);
 
-        OPLK_MEMCPY(pCircBuf + pHeader->writeOffset + sizeof(UINT32),
+        OPLK_MEMCPY(pCircBuf + writeOffset + sizeof(UINT32),
                     pData_p, size_p);
-        OPLK_MEMCPY(pCircBuf + pHeader->writeOffset + sizeof(UINT32) + size_p,
+        OPLK_MEMCPY(pCircBuf + writeOffset + sizeof(UINT32) + size_p,
                     pData2_p, size2_p);
 
-        OPLK_DCACHE_FLUSH((pCircBuf + pHeader->writeOffset), fullBlockSize);
+        OPLK_DCACHE_FLUSH((pCircBuf + writeOffset), fullBlockSize);
 
-        if (pHeader->writeOffset + fullBlockSize == pHeader->bufferSize)
-            pHeader->writeOffset = 0;
+        if (writeOffset + fullBlockSize == pHeader->bufferSize)
+            writeOffset = 0;
         else
-            pHeader->writeOffset += fullBlockSize;
+            writeOffset += fullBlockSize;
     }
     else
     {
         // we assume that there is at least size to store the size header
-        *(UINT32*)(pCircBuf + pHeader->writeOffset) = (UINT32)(size_p + size2_p);
-        chunkSize = pHeader->bufferSize - pHeader->writeOffset - (UINT32)sizeof(UINT32);
+        *(UINT32*)(pCircBuf + writeOffset) = (UINT32)(size_p + size2_p);
+        chunkSize = pHeader->bufferSize - writeOffset - (UINT32)sizeof(UINT32);
         if (size_p <= chunkSize)
         {
-            OPLK_MEMCPY(pCircBuf + pHeader->writeOffset + sizeof(UINT32),
+            OPLK_MEMCPY(pCircBuf + writeOffset + sizeof(UINT32),
                         pData_p, size_p);
             partSize = chunkSize - (UINT32)size_p;
-            OPLK_MEMCPY(pCircBuf + pHeader->writeOffset + size_p + sizeof(UINT32),
+            OPLK_MEMCPY(pCircBuf + writeOffset + size_p + sizeof(UINT32),
                         pData2_p, partSize);
 
-            OPLK_DCACHE_FLUSH((pCircBuf + pHeader->writeOffset), chunkSize + sizeof(UINT32));
+            OPLK_DCACHE_FLUSH((pCircBuf + writeOffset), chunkSize + sizeof(UINT32));
             OPLK_MEMCPY(pCircBuf, (const UINT8*)pData2_p + partSize, size2_p - partSize);
             OPLK_DCACHE_FLUSH((pCircBuf), size2_p - partSize);
         }
         else
         {
             partSize = (UINT32)size_p - chunkSize;
-            OPLK_MEMCPY(pCircBuf + pHeader->writeOffset + sizeof(UINT32),
+            OPLK_MEMCPY(pCircBuf + writeOffset + sizeof(UINT32),
                         pData_p, chunkSize);
-            OPLK_DCACHE_FLUSH((pCircBuf + pHeader->writeOffset), chunkSize + sizeof(UINT32));
+            OPLK_DCACHE_FLUSH((pCircBuf + writeOffset), chunkSize + sizeof(UINT32));
             OPLK_MEMCPY(pCircBuf, (const UINT8*)pData_p + chunkSize, partSize);
             OPLK_MEMCPY(pCircBuf + partSize, pData2_p, size2_p);
 
             OPLK_DCACHE_FLUSH((pCircBuf), partSize + size2_p);
         }
-        pHeader->writeOffset = blockSize - chunkSize;
-
+        writeOffset = blockSize - chunkSize;
     }
-    pHeader->freeSize -= fullBlockSize;
-    pHeader->dataCount++;
 
-#ifdef DEBUG_CIRCBUF_SIZE_CHECK
-    if (pHeader->bufferSize - pHeader->freeSize > pHeader->maxSize)
-        pHeader->maxSize = pHeader->bufferSize - pHeader->freeSize;
-#endif
-    OPLK_DCACHE_FLUSH(pHeader, sizeof(tCircBufHeader));
+    finishWrite(pInstance_p, writeOffset, fullBlockSize);
 
-    circbuf_unlock(pInstance_p);
     if (pInstance_p->pfnSigCb != NULL)
     {
         pInstance_p->pfnSigCb();
@@ -517,8 +574,10 @@ tCircBufError circbuf_readData(tCircBufInstance* pInstance_p, void* pData_p,
     UINT32              blockSize;
     UINT32              fullBlockSize;
     UINT32              chunkSize;
+    UINT32              readOffset;
     tCircBufHeader*     pHeader;
     UINT8*              pCircBuf;
+    tCircBufError       ret;
 
     // Check parameter validity
     ASSERT(pInstance_p != NULL);
@@ -530,57 +589,48 @@ tCircBufError circbuf_readData(tCircBufInstance* pInstance_p, void* pData_p,
     pHeader = pInstance_p->pCircBufHeader;
     pCircBuf = (UINT8*)pInstance_p->pCircBuf;
 
-    circbuf_lock(pInstance_p);
-
-    OPLK_DCACHE_INVALIDATE(pHeader, sizeof(tCircBufHeader));
-    if (pHeader->freeSize == pHeader->bufferSize)
-    {
-        circbuf_unlock(pInstance_p);
-        return kCircBufNoReadableData;
-    }
+    ret = beginRead(pInstance_p, &readOffset);
+    if (ret != kCircBufOk)
+        return ret;
 
-    OPLK_DCACHE_INVALIDATE((pCircBuf + pHeader->readOffset), sizeof(UINT32));
+    OPLK_DCACHE_INVALIDATE((pCircBuf + readOffset), sizeof(UINT32));
 
-    dataSize = *(const UINT32*)(pCircBuf + pHeader->readOffset);
+    dataSize = *(const UINT32*)(pCircBuf + readOffset);
     blockSize = (dataSize + (CIRCBUF_BLOCK_ALIGNMENT - 1)) & ~(CIRCBUF_BLOCK_ALIGNMENT - 1);
     fullBlockSize = blockSize + (UINT32)sizeof(UINT32);
 
     if (dataSize > size_p)
     {
-        circbuf_unlock(pInstance_p);
+        abortAccess(pInstance_p);
         return kCircBufReadsizeTooSmall;
     }
 
-    if (pHeader->readOffset + fullBlockSize <= pHeader->bufferSize)
+    if (readOffset + fullBlockSize <= pHeader->bufferSize)
     {
-        OPLK_DCACHE_INVALIDATE((pCircBuf + pHeader->readOffset + sizeof(UINT32)),
+        OPLK_DCACHE_INVALIDATE((pCircBuf + readOffset + sizeof(UINT32)),
                                  blockSize);
-        OPLK_MEMCPY(pData_p, pCircBuf + pHeader->readOffset + sizeof(UINT32),
+        OPLK_MEMCPY(pData_p, pCircBuf + readOffset + sizeof(UINT32),
                     dataSize);
-        if (pHeader->readOffset + fullBlockSize == pHeader->bufferSize)
-            pHeader->readOffset = 0;
+        if (readOffset + fullBlockSize == pHeader->bufferSize)
+            readOffset = 0;
         else
-            pHeader->readOffset += fullBlockSize;
+            readOffset += fullBlockSize;
     }
     else
     {
-        chunkSize = pHeader->bufferSize - pHeader->readOffset - (UINT32)sizeof(UINT32);
-        OPLK_DCACHE_INVALIDATE((pCircBuf + pHeader->readOffset + sizeof(UINT32)),
+        chunkSize = pHeader->bufferSize - readOffset - (UINT32)sizeof(UINT32);
+        OPLK_DCACHE_INVALIDATE((pCircBuf + readOffset + sizeof(UINT32)),
                                  chunkSize);
-        OPLK_MEMCPY(pData_p, pCircBuf + pHeader->readOffset + sizeof(UINT32),
+        OPLK_MEMCPY(pData_p, pCircBuf + readOffset + sizeof(UINT32),
                     chunkSize);
 
         OPLK_DCACHE_INVALIDATE(pCircBuf, dataSize - chunkSize);
 
         OPLK_MEMCPY((UINT8*)pData_p + chunkSize, pCircBuf, dataSize - chunkSize);
-        pHeader->readOffset = blockSize - chunkSize;
+        readOffset = blockSize - chunkSize;
     }
-    pHeader->freeSize += fullBlockSize;
-    pHeader->dataCount--;
-
-    OPLK_DCACHE_FLUSH(pHeader, sizeof(tCircBufHeader));
 
-    circbuf_unlock(pInstance_p);
+    finishRead(pInstance_p, readOffset, fullBlockSize);
 
     *pDataBlockSize_p = dataSize;
     return kCircBufOk;
@@ -590,7 +640,8 @@ tCircBufError circbuf_readData(tCircBufInstance* pInstance_p, void* pData_p,
 /**
 \brief  Get the available data count
 
-The function returns the available data count
+The function returns the available data count. A connected buffer which has
+not been allocated (see \ref circbuf_connect) contains no data.
 
 \param[in]      pInstance_p         Pointer to circular buffer instance.
 
@@ -607,6 +658,17 @@ UINT32 circbuf_getDataCount(const tCircBufInstance* pInstance_p)
     ASSERT(pInstance_p != NULL);
 
     pHeader = pInstance_p->pCircBufHeader;
+    if (pHeader == NULL)
+        return 0;
+
+    if (pInstance_p->fLockFree)
+    {
+        OPLK_DCACHE_INVALIDATE(&pHeader->writePos, sizeof(tCircBufPosition));
+        OPLK_DCACHE_INVALIDATE(&pHeader->readPos, sizeof(tCircBufPosition));
+
+        return pHeader->writePos.blockCount - pHeader->readPos.blockCount;
+    }
+
     OPLK_DCACHE_INVALIDATE(&pHeader->dataCount, sizeof(UINT32));
 
     return pHeader->dataCount;
@@ -664,4 +726,204 @@ tCircBufError circBuf_setSignaling(tCircBufInstance* pInstance_p, VOIDFUNCPTR pf
 /// \name Private Functions
 /// \{
 
+//------------------------------------------------------------------------------
+/**
+\brief  Start writing to a circular buffer
+
+The function prepares a write access to the circular buffer. For a locked
+buffer, the lock is taken and kept until finishWrite() or abortAccess() is
+called. For a lock-free buffer, only the consumer position is refreshed to
+determine the free space.
+
+\param[in]      pInstance_p         Pointer to circular buffer instance.
+\param[in]      fullBlockSize_p     Size of the block to be written including
+                                    the size header.
+\param[out]     pWriteOffset_p      Pointer to store the current write offset.
+
+\return The function returns a tCircBufError error code.
+*/
+//------------------------------------------------------------------------------
+static tCircBufError beginWrite(tCircBufInstance* pInstance_p,
+                                UINT32 fullBlockSize_p,
+                                UINT32* pWriteOffset_p)
+{
+    tCircBufHeader*     pHeader = pInstance_p->pCircBufHeader;
+    UINT32              freeSize;
+
+    if (pInstance_p->fLockFree)
+    {
+        // Only the consumer position can be changed by someone else
+        OPLK_DCACHE_INVALIDATE(&pHeader->readPos, sizeof(tCircBufPosition));
+        freeSize = pHeader->bufferSize -
+                   (pHeader->writePos.byteCount - pHeader->readPos.byteCount);
+        *pWriteOffset_p = pHeader->writePos.offset;
+    }
+    else
+    {
+        circbuf_lock(pInstance_p);
+        OPLK_DCACHE_INVALIDATE(pHeader, sizeof(tCircBufHeader));
+        freeSize = pHeader->freeSize;
+        *pWriteOffset_p = pHeader->writeOffset;
+    }
+
+    if (fullBlockSize_p > freeSize)
+    {
+        abortAccess(pInstance_p);
+        return kCircBufBufferFull;
+    }
+
+    return kCircBufOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Finish writing to a circular buffer
+
+The function publishes a block written to the circular buffer. For a lock-free
+buffer, the memory barrier ensures that the consumer sees the block data before
+it sees the updated producer position.
+
+\param[in]      pInstance_p         Pointer to circular buffer instance.
+\param[in]      writeOffset_p       The new write offset.
+\param[in]      fullBlockSize_p     Size of the written block including the
+                                    size header.
+*/
+//------------------------------------------------------------------------------
+static void finishWrite(tCircBufInstance* pInstance_p,
+                        UINT32 writeOffset_p,
+                        UINT32 fullBlockSize_p)
+{
+    tCircBufHeader*     pHeader = pInstance_p->pCircBufHeader;
+
+    if (pInstance_p->fLockFree)
+    {
+        OPLK_MEMBAR();
+
+        pHeader->writePos.offset = writeOffset_p;
+        pHeader->writePos.byteCount += fullBlockSize_p;
+        pHeader->writePos.blockCount++;
+
+#ifdef DEBUG_CIRCBUF_SIZE_CHECK
+        if (pHeader->writePos.byteCount - pHeader->readPos.byteCount > pHeader->maxSize)
+            pHeader->maxSize = pHeader->writePos.byteCount - pHeader->readPos.byteCount;
+#endif
+        OPLK_DCACHE_FLUSH(&pHeader->writePos, sizeof(tCircBufPosition));
+        return;
+    }
+
+    pHeader->writeOffset = writeOffset_p;
+    pHeader->freeSize -= fullBlockSize_p;
+    pHeader->dataCount++;
+
+#ifdef DEBUG_CIRCBUF_SIZE_CHECK
+    if (pHeader->bufferSize - pHeader->freeSize > pHeader->maxSize)
+        pHeader->maxSize = pHeader->bufferSize - pHeader->freeSize;
+#endif
+    OPLK_DCACHE_FLUSH(pHeader, sizeof(tCircBufHeader));
+
+    circbuf_unlock(pInstance_p);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Start reading from a circular buffer
+
+The function prepares a read access to the circular buffer. For a locked
+buffer, the lock is taken and kept until finishRead() or abortAccess() is
+called. For a lock-free buffer, only the producer position is refreshed to
+determine whether data is available.
+
+\param[in]      pInstance_p         Pointer to circular buffer instance.
+\param[out]     pReadOffset_p       Pointer to store the current read offset.
+
+\return The function returns a tCircBufError error code.
+*/
+//------------------------------------------------------------------------------
+static tCircBufError beginRead(tCircBufInstance* pInstance_p,
+                               UINT32* pReadOffset_p)
+{
+    tCircBufHeader*     pHeader = pInstance_p->pCircBufHeader;
+
+    if (pInstance_p->fLockFree)
+    {
+        // Only the producer position can be changed by someone else
+        OPLK_DCACHE_INVALIDATE(&pHeader->writePos, sizeof(tCircBufPosition));
+        if (pHeader->writePos.byteCount == pHeader->readPos.byteCount)
+            return kCircBufNoReadableData;
+
+        // Don't read block data before the producer position
+        OPLK_MEMBAR();
+        *pReadOffset_p = pHeader->readPos.offset;
+        return kCircBufOk;
+    }
+
+    circbuf_lock(pInstance_p);
+    OPLK_DCACHE_INVALIDATE(pHeader, sizeof(tCircBufHeader));
+    if (pHeader->freeSize == pHeader->bufferSize)
+    {
+        circbuf_unlock(pInstance_p);
+        return kCircBufNoReadableData;
+    }
+
+    *pReadOffset_p = pHeader->readOffset;
+    return kCircBufOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Finish reading from a circular buffer
+
+The function releases a block read from the circular buffer. For a lock-free
+buffer, the memory barrier ensures that the block has been read completely
+before the producer may reuse its space.
+
+\param[in]      pInstance_p         Pointer to circular buffer instance.
+\param[in]      readOffset_p        The new read offset.
+\param[in]      fullBlockSize_p     Size of the read block including the
+                                    size header.
+*/
+//------------------------------------------------------------------------------
+static void finishRead(tCircBufInstance* pInstance_p,
+                       UINT32 readOffset_p,
+                       UINT32 fullBlockSize_p)
+{
+    tCircBufHeader*     pHeader = pInstance_p->pCircBufHeader;
+
+    if (pInstance_p->fLockFree)
+    {
+        OPLK_MEMBAR();
+
+        pHeader->readPos.offset = readOffset_p;
+        pHeader->readPos.byteCount += fullBlockSize_p;
+        pHeader->readPos.blockCount++;
+
+        OPLK_DCACHE_FLUSH(&pHeader->readPos, sizeof(tCircBufPosition));
+        return;
+    }
+
+    pHeader->readOffset = readOffset_p;
+    pHeader->freeSize += fullBlockSize_p;
+    pHeader->dataCount--;
+
+    OPLK_DCACHE_FLUSH(pHeader, sizeof(tCircBufHeader));
+
+    circbuf_unlock(pInstance_p);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Abort an access to a circular buffer
+
+The function aborts a read or write access started with beginRead() or
+beginWrite() without changing the buffer.
+
+\param[in]      pInstance_p         Pointer to circular buffer instance.
+*/
+//------------------------------------------------------------------------------
+static void abortAccess(tCircBufInstance* pInstance_p)
+{
+    if (!pInstance_p->fLockFree)
+        circbuf_unlock(pInstance_p);
+}
+
 /// \}
@@ -114,6 +114,7 @@ typedef struct
     UINT16              heartbeat;          ///< Heartbeat counter
     UINT32              features;           ///< Features provided by the kernel stack
     tCtrlkExecuteCmdCb  pfnExecuteCmdCb;    ///< Command execution callback
+    tCtrlStatistics     statistics;         ///< Statistics transfer buffer
 } tCtrlkInstance;
 
 //------------------------------------------------------------------------------
@@ -127,6 +128,10 @@ static tCtrlkInstance   instance_l;
 static tOplkError initStack(void);
 static tOplkError shutdownStack(void);
 static void setupKernelFeatures(void);
+static tOplkError getTimerStatistics(void);
+static tOplkError resetTimerStatistics(void);
+static tOplkError getCycleStatistics(void);
+static tOplkError resetCycleStatistics(void);
 
 //============================================================================//
 //            P U B L I C   F U N C T I O N S                                 //
@@ -328,6 +333,34 @@ tOplkError ctrlk_executeCmd(tCtrlCmdType cmd_p,
             fExit = FALSE;
             break;
 
+        case kCtrlGetTimerStatistics:
+            retVal = getTimerStatistics();
+            *pRet_p = (UINT16)retVal;
+            status = kCtrlStatusUnchanged;
+            fExit = FALSE;
+            break;
+
+        case kCtrlResetTimerStatistics:
+            retVal = resetTimerStatistics();
+            *pRet_p = (UINT16)retVal;
+            status = kCtrlStatusUnchanged;
+            fExit = FALSE;
+            break;
+
+        case kCtrlGetCycleStatistics:
+            retVal = getCycleStatistics();
+            *pRet_p = (UINT16)retVal;
+            status = kCtrlStatusUnchanged;
+            fExit = FALSE;
+            break;
+
+        case kCtrlResetCycleStatistics:
+            retVal = resetCycleStatistics();
+            *pRet_p = (UINT16)retVal;
+            status = kCtrlStatusUnchanged;
+            fExit = FALSE;
+            break;
+
         default:
             DEBUG_LVL_ERROR_TRACE("%s() Unknown command %d\n", __func__, cmd_p);
             ret = kErrorGeneralError;
@@ -632,4 +665,92 @@ static void setupKernelFeatures(void)
 #endif
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Store the high-resolution timer statistics
+
+The function reads the statistics of the high-resolution timer module and
+stores them in the statistics transfer buffer of the control CAL.
+
+\return The function returns a tOplkError error code. If the high-resolution
+        timer does not collect statistics, kErrorApiNotSupported is returned.
+*/
+//------------------------------------------------------------------------------
+static tOplkError getTimerStatistics(void)
+{
+#if ((CONFIG_TIMER_USE_HIGHRES != FALSE) && (CONFIG_HRESTIMER_USE_STATISTICS != FALSE))
+    tOplkError  ret;
+
+    ret = hrestimer_getStatistics(&instance_l.statistics.timerStatistics);
+    if (ret != kErrorOk)
+        return ret;
+
+    return ctrlkcal_storeStatistics(&instance_l.statistics.timerStatistics,
+                                    sizeof(tOplkApiTimerStatistics));
+#else
+    return kErrorApiNotSupported;
+#endif
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Reset the high-resolution timer statistics
+
+\return The function returns a tOplkError error code. If the high-resolution
+        timer does not collect statistics, kErrorApiNotSupported is returned.
+*/
+//------------------------------------------------------------------------------
+static tOplkError resetTimerStatistics(void)
+{
+#if ((CONFIG_TIMER_USE_HIGHRES != FALSE) && (CONFIG_HRESTIMER_USE_STATISTICS != FALSE))
+    return hrestimer_resetStatistics();
+#else
+    return kErrorApiNotSupported;
+#endif
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Store the cycle statistics
+
+The function reads the cycle statistics of the cyclic Ethernet driver and
+stores them in the statistics transfer buffer of the control CAL.
+
+\return The function returns a tOplkError error code. If the cyclic Ethernet
+        driver does not collect statistics, kErrorApiNotSupported is returned.
+*/
+//------------------------------------------------------------------------------
+static tOplkError getCycleStatistics(void)
+{
+#if (defined(CONFIG_INCLUDE_NMT_MN) && (CONFIG_EDRV_CYCLIC_USE_STATISTICS != FALSE))
+    tOplkError  ret;
+
+    ret = edrvcyclic_getStatistics(&instance_l.statistics.cycleStatistics);
+    if (ret != kErrorOk)
+        return ret;
+
+    return ctrlkcal_storeStatistics(&instance_l.statistics.cycleStatistics,
+                                    sizeof(tOplkApiCycleStatistics));
+#else
+    return kErrorApiNotSupported;
+#endif
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Reset the cycle statistics
+
+\return The function returns a tOplkError error code. If the cyclic Ethernet
+        driver does not collect statistics, kErrorApiNotSupported is returned.
+*/
+//------------------------------------------------------------------------------
+static tOplkError resetCycleStatistics(void)
+{
+#if (defined(CONFIG_INCLUDE_NMT_MN) && (CONFIG_EDRV_CYCLIC_USE_STATISTICS != FALSE))
+    return edrvcyclic_resetStatistics();
+#else
+    return kErrorApiNotSupported;
+#endif
+}
+
 /// \}
@@ -55,7 +55,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // module global vars
 //------------------------------------------------------------------------------
-tCtrlInitParam kernelInitParam_g;
+tCtrlInitParam  kernelInitParam_g;
+tCtrlStatistics kernelStatistics_g;
 
 //------------------------------------------------------------------------------
 // global function prototypes
@@ -281,6 +282,35 @@ tOplkError ctrlkcal_readInitParam(tCtrlInitParam* pInitParam_p)
     return kErrorOk;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Store statistics for user stack
+
+The function stores statistics collected by the kernel stack in the statistics
+transfer buffer so that they can be read by the user stack.
+
+\param[in]      pStatistics_p       Pointer to the statistics to be stored.
+\param[in]      size_p              Size of the statistics.
+
+\return The function returns a tOplkError code.
+
+\ingroup module_ctrlkcal
+*/
+//------------------------------------------------------------------------------
+tOplkError ctrlkcal_storeStatistics(const void* pStatistics_p,
+                                    size_t size_p)
+{
+    // Check parameter validity
+    ASSERT(pStatistics_p != NULL);
+
+    if (size_p > sizeof(tCtrlStatistics))
+        return kErrorInvalidInstanceParam;
+
+    OPLK_MEMCPY(&kernelStatistics_g, pStatistics_p, size_p);
+
+    return kErrorOk;
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  Read file chunk
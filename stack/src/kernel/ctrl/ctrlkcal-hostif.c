@@ -336,6 +336,31 @@ tOplkError ctrlkcal_readInitParam(tCtrlInitParam* pInitParam_p)
     return kErrorOk;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Store statistics for user stack
+
+The function stores statistics collected by the kernel stack in the statistics
+transfer buffer so that they can be read by the user stack.
+
+\param[in]      pStatistics_p       Pointer to the statistics to be stored.
+\param[in]      size_p              Size of the statistics.
+
+\return The function returns a tOplkError code.
+
+\ingroup module_ctrlkcal
+*/
+//------------------------------------------------------------------------------
+tOplkError ctrlkcal_storeStatistics(const void* pStatistics_p,
+                                    size_t size_p)
+{
+    UNUSED_PARAMETER(pStatistics_p);
+    UNUSED_PARAMETER(size_p);
+
+    // This CAL is not supporting that feature -> return no resource available.
+    return kErrorNoResource;
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  Read file chunk
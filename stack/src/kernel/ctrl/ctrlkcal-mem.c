@@ -300,6 +300,37 @@ tOplkError ctrlkcal_readInitParam(tCtrlInitParam* pInitParam_p)
                             sizeof(tCtrlInitParam));
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Store statistics for user stack
+
+The function stores statistics collected by the kernel stack in the statistics
+transfer buffer so that they can be read by the user stack.
+
+\param[in]      pStatistics_p       Pointer to the statistics to be stored.
+\param[in]      size_p              Size of the statistics.
+
+\return The function returns a tOplkError code.
+
+\ingroup module_ctrlkcal
+*/
+//------------------------------------------------------------------------------
+tOplkError ctrlkcal_storeStatistics(const void* pStatistics_p,
+                                    size_t size_p)
+{
+    // Check parameter validity
+    ASSERT(pStatistics_p != NULL);
+
+    if (size_p > sizeof(tCtrlStatistics))
+        return kErrorInvalidInstanceParam;
+
+    ctrlcal_writeData(offsetof(tCtrlBuf, statistics),
+                      pStatistics_p,
+                      size_p);
+
+    return kErrorOk;
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  Read file chunk
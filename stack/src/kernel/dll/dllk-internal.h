@@ -121,6 +121,8 @@ void target_signalTracePoint(UINT8 tracePointNumber_p);
 
 #define DLLK_SOAREQ_COUNT           3
 
+#define DLLK_CN_NODE_INDEX_INVALID  0xFF    // node is not contained in node ID list
+
 // defines for tDllkInstance.updateTxFrame
 #define DLLK_UPDATE_NONE            0       // no update necessary
 #define DLLK_UPDATE_STATUS          1       // StatusRes needs update
@@ -209,6 +211,9 @@ typedef struct
 #if defined(CONFIG_INCLUDE_NMT_MN)
     tDllkNodeInfo*          pFirstNodeInfo;                         ///< Pointer to the first node information structure
     UINT8                   aCnNodeIdList[2][NMT_MAX_NODE_ID];      ///< Double-buffered node ID list
+    UINT8                   aCnNodeIndex[2][NMT_MAX_NODE_ID];       ///< Double-buffered index of each node (ID - 1) in the node ID list
+    UINT8                   aCnNodeIdCount[2];                      ///< Double-buffered number of entries in the node ID list
+    UINT8                   aPrcSlotEndIndex[2];                    ///< Double-buffered index of the PRC slot end marker in the node ID list
     UINT8                   curNodeIndex;                           ///< Current node index
     tEdrvTxBuffer**         ppTxBufferList;                         ///< Pointer to the TX buffer list
     UINT8                   syncLastSoaReq;                         ///< Sync last SoA request
@@ -82,9 +82,43 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // const defines
 //------------------------------------------------------------------------------
 #if defined(CONFIG_INCLUDE_NMT_MN)
-#define DLLKCAL_MAX_QUEUES  6   // CnGenReq, CnNmtReq, {MnGenReq, MnNmtReq}, MnIdentReq, MnStatusReq, SyncReq
-#else
-#define DLLKCAL_MAX_QUEUES  5   // CnGenReq, CnNmtReq, {MnGenReq, MnNmtReq}, MnIdentReq, MnStatusReq
+// Weights of the request queues, i.e. the number of consecutive asynchronous
+// phases a queue may use per scheduling round
+#ifndef CONFIG_DLLKCAL_ASYNC_SCHED_WEIGHT_CN_GEN
+#define CONFIG_DLLKCAL_ASYNC_SCHED_WEIGHT_CN_GEN        2
+#endif
+
+#ifndef CONFIG_DLLKCAL_ASYNC_SCHED_WEIGHT_CN_NMT
+#define CONFIG_DLLKCAL_ASYNC_SCHED_WEIGHT_CN_NMT        2
+#endif
+
+#ifndef CONFIG_DLLKCAL_ASYNC_SCHED_WEIGHT_MN_GENNMT
+#define CONFIG_DLLKCAL_ASYNC_SCHED_WEIGHT_MN_GENNMT     2
+#endif
+
+#ifndef CONFIG_DLLKCAL_ASYNC_SCHED_WEIGHT_MN_IDENT
+#define CONFIG_DLLKCAL_ASYNC_SCHED_WEIGHT_MN_IDENT      1
+#endif
+
+#ifndef CONFIG_DLLKCAL_ASYNC_SCHED_WEIGHT_MN_STATUS
+#define CONFIG_DLLKCAL_ASYNC_SCHED_WEIGHT_MN_STATUS     1
+#endif
+
+#ifndef CONFIG_DLLKCAL_ASYNC_SCHED_WEIGHT_MN_SYNC
+#define CONFIG_DLLKCAL_ASYNC_SCHED_WEIGHT_MN_SYNC       1
+#endif
+
+// Number of consecutive asynchronous phases a CN may use before the next CN
+// of the same queue is served
+#ifndef CONFIG_DLLKCAL_ASYNC_SCHED_NODE_QUANTUM
+#define CONFIG_DLLKCAL_ASYNC_SCHED_NODE_QUANTUM         1
+#endif
+
+// Number of asynchronous phases a pending queue waits at most before it is
+// served regardless of the round-robin position
+#ifndef CONFIG_DLLKCAL_ASYNC_SCHED_STARVATION_LIMIT
+#define CONFIG_DLLKCAL_ASYNC_SCHED_STARVATION_LIMIT     32
+#endif
 #endif
 
 //------------------------------------------------------------------------------
@@ -109,6 +143,61 @@ Data type for the enumerator \ref eDllkCalTxQueueSelect.
 */
 typedef UINT32 tDllkCalTxQueueSelect;
 
+#if defined(CONFIG_INCLUDE_NMT_MN)
+/**
+\brief Function type for getting the next request of a queue
+
+This function type is used by the asynchronous scheduler for fetching the next
+request of a request queue.
+*/
+typedef BOOL (*tDllkCalGetRequest)(tDllReqServiceId* pReqServiceId_p,
+                                   UINT* pNodeId_p,
+                                   tSoaPayload* pSoaPayload_p);
+
+/**
+\brief Ident/StatusRequest queue entry
+
+This structure contains an entry of the IdentRequest and StatusRequest queues.
+The generation identifies entries which have been queued before the queues were
+cleared.
+*/
+typedef struct
+{
+    UINT8                   nodeId;                 ///< Node ID of the CN
+    UINT8                   generation;             ///< Queue generation of the entry
+} tDllkCalNodeRequest;
+
+/**
+\brief Scheduling state of a request queue
+
+This structure contains the deficit round-robin state of a request queue.
+*/
+typedef struct
+{
+    UINT                    weight;                 ///< Number of consecutive grants per round
+    UINT                    deficit;                ///< Remaining grants of the current round
+    UINT                    waitCount;              ///< Asynchronous phases since the queue was served
+} tDllkCalSchedQueue;
+
+/**
+\brief CN request queue
+
+This structure contains a queue with the CNs which have pending asynchronous
+requests of one priority. Every CN is contained once and is served
+round-robin with the other CNs. If the scheduler releases a CN at the same time
+as the CN reports new requests, it may be contained twice for a short time, see
+unscheduleCnNode().
+*/
+typedef struct
+{
+    tCircBufInstance*       pQueue;                 ///< Queue with the node IDs of the CNs with pending requests
+    UINT                    aRequestCnt[254];       ///< Number of pending requests of each CN
+    UINT8                   aScheduled[254];        ///< CN is in the queue or is currently served
+    UINT                    curNodeId;              ///< Node ID of the currently served CN
+    UINT                    nodeDeficit;            ///< Remaining grants of the currently served CN
+} tDllkCalCnRequestQueue;
+#endif
+
 /**
 \brief Node instance
 
@@ -158,13 +247,17 @@ typedef struct
 #if defined(CONFIG_INCLUDE_NMT_MN)
     tCircBufInstance*       pQueueIdentReq;         ///< IdentRequest queue with the CN node IDs
     tCircBufInstance*       pQueueStatusReq;        ///< StatusRequest queue with the CN node IDs
+    UINT8                   aIdentReqQueued[C_ADR_BROADCAST];   ///< Queue generation of the node in the IdentRequest queue (0 = not queued)
+    UINT8                   aStatusReqQueued[C_ADR_BROADCAST];  ///< Queue generation of the node in the StatusRequest queue (0 = not queued)
+    volatile UINT8          queueGeneration;        ///< Queue generation, changed by dllkcal_clearAsyncQueues()
+    UINT8                   soaQueueGeneration;     ///< Queue generation the SoA path has cleared its state for
 
-    tCircBufInstance*       pQueueCnRequestNmt;     ///< Queue for NMT priority CN requests
-    UINT                    aCnRequestCntNmt[254];  ///< Array of requested frames in the NMT priority queues of each CN
-    tCircBufInstance*       pQueueCnRequestGen;     ///< Queue for generic priority CN requests
-    UINT                    aCnRequestCntGen[254];  ///< Array of requested frames in the generic priority queues of each CN
+    tDllkCalCnRequestQueue  cnRequestNmt;           ///< Queue for NMT priority CN requests
+    tDllkCalCnRequestQueue  cnRequestGen;           ///< Queue for generic priority CN requests
 
-    UINT                    nextRequestQueue;       ///< Number of next request queue to be scheduled
+    tDllkCalSchedQueue      aSchedQueue[kDllkCalAsyncSchedQueueCount];  ///< Scheduling state of the request queues
+    UINT                    curSchedQueue;          ///< Request queue served by the round-robin
+    tDllkCalAsyncSchedStatistics schedStatistics;   ///< Statistics of the asynchronous scheduler
 #endif
 
     tDllkNodeInstance       nodeInstance;           ///< Initialize the node instance
@@ -178,22 +271,63 @@ static tDllkCalInstance     instance_l;
 // local function prototypes
 //------------------------------------------------------------------------------
 #if defined(CONFIG_INCLUDE_NMT_MN)
-static BOOL getCnGenRequest(tDllReqServiceId* pReqServiceId_p, UINT* pNodeId_p);
-static BOOL getCnNmtRequest(tDllReqServiceId* pReqServiceId_p, UINT* pNodeId_p);
-static BOOL getMnGenNmtRequest(tDllReqServiceId* pReqServiceId_p, UINT* pNodeId_p);
-static BOOL getMnIdentRequest(tDllReqServiceId* pReqServiceId_p, UINT* pNodeId_p);
-static BOOL getMnStatusRequest(tDllReqServiceId* pReqServiceId_p, UINT* pNodeId_p);
+static BOOL getCnGenRequest(tDllReqServiceId* pReqServiceId_p,
+                            UINT* pNodeId_p,
+                            tSoaPayload* pSoaPayload_p);
+static BOOL getCnNmtRequest(tDllReqServiceId* pReqServiceId_p,
+                            UINT* pNodeId_p,
+                            tSoaPayload* pSoaPayload_p);
+static BOOL getMnGenNmtRequest(tDllReqServiceId* pReqServiceId_p,
+                               UINT* pNodeId_p,
+                               tSoaPayload* pSoaPayload_p);
+static BOOL getMnIdentRequest(tDllReqServiceId* pReqServiceId_p,
+                              UINT* pNodeId_p,
+                              tSoaPayload* pSoaPayload_p);
+static BOOL getMnStatusRequest(tDllReqServiceId* pReqServiceId_p,
+                               UINT* pNodeId_p,
+                               tSoaPayload* pSoaPayload_p);
 static BOOL getMnSyncRequest(tDllReqServiceId* pReqServiceId_p,
                              UINT* pNodeId_p,
                              tSoaPayload* pSoaPayload_p);
+static BOOL getNodeRequest(tCircBufInstance* pQueue_p,
+                           UINT8* aQueued_p,
+                           UINT* pNodeId_p);
+static BOOL getCnRequest(tDllkCalCnRequestQueue* pCnQueue_p,
+                         tDllReqServiceId reqServiceId_p,
+                         tDllReqServiceId* pReqServiceId_p,
+                         UINT* pNodeId_p);
+static void unscheduleCnNode(tDllkCalCnRequestQueue* pCnQueue_p,
+                             UINT nodeId_p,
+                             UINT requestCnt_p);
+static void clearSoaQueues(void);
+static UINT getStarvedQueue(void);
+static void grantRequest(UINT queue_p, BOOL fForced_p);
+static void resetCnRequestQueue(tDllkCalCnRequestQueue* pCnQueue_p);
+static UINT getCnRequestCount(const tDllkCalCnRequestQueue* pCnQueue_p);
 #endif
 
+static tOplkError insertAsyncFrame(tFrameInfo* pFrameInfo_p,
+                                   tDllAsyncReqPriority priority_p);
+static tOplkError postFillTxEvent(tDllAsyncReqPriority priority_p);
 static tOplkError sendGenericAsyncFrame(tFrameInfo* pFrameInfo_p);
 static tOplkError getGenericAsyncFrame(void* pFrame_p, size_t* pFrameSize_p);
 static tNmtEvent  commandTranslator(const tNmtCommandService* pNmtCommand_p);
 static BOOL       checkNodeIdList(const tNmtCommandService* pNmtCommand_p);
 static void       initNodeInstance(UINT nodeId_p);
 
+#if defined(CONFIG_INCLUDE_NMT_MN)
+// Request queues of the asynchronous scheduler, indexed by tDllkCalAsyncSchedQueue
+static const tDllkCalGetRequest aGetRequestFuncs_l[kDllkCalAsyncSchedQueueCount] =
+{
+    getCnGenRequest,
+    getCnNmtRequest,
+    getMnGenNmtRequest,
+    getMnIdentRequest,
+    getMnStatusRequest,
+    getMnSyncRequest
+};
+#endif
+
 //============================================================================//
 //            P U B L I C   F U N C T I O N S                                 //
 //============================================================================//
@@ -254,7 +388,7 @@ tOplkError dllkcal_init(void)
     }
     circErr = circbuf_alloc(CIRCBUF_DLLCAL_CN_REQ_NMT,
                             CONFIG_DLLCAL_SIZE_CIRCBUF_CN_REQ_NMT,
-                            &instance_l.pQueueCnRequestNmt);
+                            &instance_l.cnRequestNmt.pQueue);
     if (circErr != kCircBufOk)
     {
         DEBUG_LVL_ERROR_TRACE("%s() Allocate CIRCBUF_ASYNC_SCHED_NMT failed\n", __func__);
@@ -263,7 +397,7 @@ tOplkError dllkcal_init(void)
 
     circErr = circbuf_alloc(CIRCBUF_DLLCAL_CN_REQ_GEN,
                             CONFIG_DLLCAL_SIZE_CIRCBUF_CN_REQ_GEN,
-                            &instance_l.pQueueCnRequestGen);
+                            &instance_l.cnRequestGen.pQueue);
     if (circErr != kCircBufOk)
     {
         DEBUG_LVL_ERROR_TRACE("%s() Allocate CIRCBUF_ASYNC_SCHED_GEN failed\n", __func__);
@@ -287,6 +421,16 @@ tOplkError dllkcal_init(void)
         DEBUG_LVL_ERROR_TRACE("%s() Allocate CIRCBUF_DLLCAL_CN_REQ_STATUS failed\n", __func__);
         goto Exit;
     }
+
+    instance_l.queueGeneration = 1;
+    instance_l.soaQueueGeneration = 1;
+
+    instance_l.aSchedQueue[kDllkCalAsyncSchedQueueCnGen].weight = CONFIG_DLLKCAL_ASYNC_SCHED_WEIGHT_CN_GEN;
+    instance_l.aSchedQueue[kDllkCalAsyncSchedQueueCnNmt].weight = CONFIG_DLLKCAL_ASYNC_SCHED_WEIGHT_CN_NMT;
+    instance_l.aSchedQueue[kDllkCalAsyncSchedQueueMnGenNmt].weight = CONFIG_DLLKCAL_ASYNC_SCHED_WEIGHT_MN_GENNMT;
+    instance_l.aSchedQueue[kDllkCalAsyncSchedQueueMnIdent].weight = CONFIG_DLLKCAL_ASYNC_SCHED_WEIGHT_MN_IDENT;
+    instance_l.aSchedQueue[kDllkCalAsyncSchedQueueMnStatus].weight = CONFIG_DLLKCAL_ASYNC_SCHED_WEIGHT_MN_STATUS;
+    instance_l.aSchedQueue[kDllkCalAsyncSchedQueueMnSync].weight = CONFIG_DLLKCAL_ASYNC_SCHED_WEIGHT_MN_SYNC;
 #endif
 
 #if defined(CONFIG_INCLUDE_VETH)
@@ -320,11 +464,11 @@ tOplkError dllkcal_exit(void)
     tOplkError      ret = kErrorOk;
 
 #ifdef CONFIG_INCLUDE_NMT_MN
-    if (instance_l.pQueueCnRequestGen != NULL)
-        circbuf_free(instance_l.pQueueCnRequestGen);
+    if (instance_l.cnRequestGen.pQueue != NULL)
+        circbuf_free(instance_l.cnRequestGen.pQueue);
 
-    if (instance_l.pQueueCnRequestNmt != NULL)
-        circbuf_free(instance_l.pQueueCnRequestNmt);
+    if (instance_l.cnRequestNmt.pQueue != NULL)
+        circbuf_free(instance_l.cnRequestNmt.pQueue);
 
     if (instance_l.pQueueIdentReq != NULL)
         circbuf_free(instance_l.pQueueIdentReq);
@@ -665,37 +809,62 @@ priority.
 //------------------------------------------------------------------------------
 tOplkError dllkcal_sendAsyncFrame(tFrameInfo* pFrameInfo_p,
                                   tDllAsyncReqPriority priority_p)
+{
+    tOplkError  ret;
+
+    ret = insertAsyncFrame(pFrameInfo_p, priority_p);
+    if (ret != kErrorOk)
+        return ret;
+
+    return postFillTxEvent(priority_p);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Send a batch of asynchronous frames
+
+The function puts the given frames into the transmit queue with the specified
+priority. The frames are inserted in order until the queue is full. The DLL is
+informed about the new frames with a single event for the whole batch.
+
+\param[in]      pFrameInfo_p        Pointer to an array of frame info structures
+\param[in]      count_p             Number of frames in the array
+\param[in]      priority_p          Priority to send the frames with
+\param[out]     pSentCount_p        Pointer to store the number of frames which
+                                    have been inserted into the transmit queue.
+
+\return The function returns a tOplkError error code. If the transmit queue
+        runs full, kErrorDllAsyncTxBufferFull is returned and the remaining
+        frames are left to the caller.
+
+\ingroup module_dllkcal
+*/
+//------------------------------------------------------------------------------
+tOplkError dllkcal_sendAsyncFrames(tFrameInfo* pFrameInfo_p,
+                                   UINT count_p,
+                                   tDllAsyncReqPriority priority_p,
+                                   UINT* pSentCount_p)
 {
     tOplkError  ret = kErrorOk;
-    tEvent      event;
+    tOplkError  postRet;
+    UINT        sentCount;
 
-    switch (priority_p)
+    for (sentCount = 0; sentCount < count_p; sentCount++)
     {
-        case kDllAsyncReqPrioNmt:    // NMT request priority
-            ret = instance_l.pTxNmtFuncs->pfnInsertDataBlock(
-                                              instance_l.dllCalQueueTxNmt,
-                                              pFrameInfo_p->frame.pBuffer,
-                                              (size_t)pFrameInfo_p->frameSize);
-            break;
-
-        default:    // generic priority
-            ret = sendGenericAsyncFrame(pFrameInfo_p);
+        ret = insertAsyncFrame(&pFrameInfo_p[sentCount], priority_p);
+        if (ret != kErrorOk)
             break;
     }
 
-    if (ret != kErrorOk)
-        goto Exit;
-
-    // post event to DLL
-    event.eventSink = kEventSinkDllk;
-    event.eventType = kEventTypeDllkFillTx;
-    OPLK_MEMSET(&event.netTime, 0x00, sizeof(event.netTime));
-    event.eventArg.pEventArg = &priority_p;
-    event.eventArgSize = sizeof(priority_p);
+    *pSentCount_p = sentCount;
 
-    ret = eventk_postEvent(&event);
+    if (sentCount > 0)
+    {
+        postRet = postFillTxEvent(priority_p);
+        if (postRet != kErrorOk)
+            ret = postRet;
+    }
 
-Exit:
     return ret;
 }
 
@@ -799,6 +968,14 @@ tOplkError dllkcal_clearAsyncBuffer(void)
 
 The function clears the asynchronous transmit queues.
 
+The function is called by the event path while the SoA path may read the
+request queues concurrently. The Ident/StatusRequest queues are accessed
+lock-free and must not be reset by their producer. Therefore, the function
+only starts a new queue generation. The SoA path drops the entries of the
+previous generations and resets its scheduling state and the CN request queues
+before it assigns the next asynchronous phase. Requests which are issued after
+this function has returned are kept.
+
 \return The function returns a tOplkError error code.
 
 \ingroup module_dllkcal
@@ -808,6 +985,7 @@ The function clears the asynchronous transmit queues.
 tOplkError dllkcal_clearAsyncQueues(void)
 {
     tOplkError  ret = kErrorOk;
+    UINT8       generation;
 
     ret = instance_l.pTxSyncFuncs->pfnResetDataBlockQueue(instance_l.dllCalQueueTxSync);
     if (ret != kErrorOk)
@@ -815,13 +993,13 @@ tOplkError dllkcal_clearAsyncQueues(void)
         DEBUG_LVL_ERROR_TRACE("%s() Reset Sync Tx queue returned 0x%X\n", __func__, ret);
     }
 
-    // clear MN asynchronous queues
-    instance_l.nextRequestQueue = 0;
+    // generation 0 marks a node which is not queued
+    generation = instance_l.queueGeneration + 1;
+    if (generation == 0)
+        generation = 1;
 
-    circbuf_reset(instance_l.pQueueCnRequestGen);
-    circbuf_reset(instance_l.pQueueCnRequestNmt);
-    circbuf_reset(instance_l.pQueueIdentReq);
-    circbuf_reset(instance_l.pQueueStatusReq);
+    instance_l.queueGeneration = generation;
+    OPLK_MEMBAR();
 
     return ret;
 }
@@ -907,8 +1085,9 @@ tOplkError dllkcal_issueRequest(tDllReqServiceId service_p,
                                 UINT nodeId_p,
                                 UINT8 soaFlag1_p)
 {
-    tOplkError      ret = kErrorOk;
-    tCircBufError   err;
+    tOplkError          ret = kErrorOk;
+    tCircBufError       err;
+    tDllkCalNodeRequest request;
 
     if (soaFlag1_p != 0xFF)
     {
@@ -917,22 +1096,47 @@ tOplkError dllkcal_issueRequest(tDllReqServiceId service_p,
             goto Exit;
     }
 
+    if (nodeId_p >= C_ADR_BROADCAST)
+    {
+        ret = kErrorDllInvalidParam;
+        goto Exit;
+    }
+
     // add node to appropriate request queue
+    // A node which is already queued is not added again, one SoA serves all
+    // requests which have been issued meanwhile. This bounds the queues to one
+    // entry per node and generation even if the requests are issued faster
+    // than served.
+    // The flag is set before the node is written to the queue. The circular
+    // buffer publishes the entry after a memory barrier, thus, the SoA path
+    // which clears the flag after reading the entry always sees it set.
+    request.nodeId = (UINT8)nodeId_p;
+    request.generation = instance_l.queueGeneration;
     switch (service_p)
     {
         case kDllReqServiceIdent:
-            err = circbuf_writeData(instance_l.pQueueIdentReq, &nodeId_p, sizeof(nodeId_p));
+            if (instance_l.aIdentReqQueued[nodeId_p] == request.generation)
+                break;
+
+            instance_l.aIdentReqQueued[nodeId_p] = request.generation;
+            err = circbuf_writeData(instance_l.pQueueIdentReq, &request, sizeof(request));
             if (err != kCircBufOk)
             {   // queue is full
+                instance_l.aIdentReqQueued[nodeId_p] = 0;
                 ret = kErrorDllAsyncTxBufferFull;
                 goto Exit;
             }
             break;
 
         case kDllReqServiceStatus:
-            err = circbuf_writeData(instance_l.pQueueStatusReq, &nodeId_p, sizeof(nodeId_p));
+            if (instance_l.aStatusReqQueued[nodeId_p] == request.generation)
+                break;
+
+            instance_l.aStatusReqQueued[nodeId_p] = request.generation;
+            err = circbuf_writeData(instance_l.pQueueStatusReq, &request, sizeof(request));
             if (err != kCircBufOk)
             {   // queue is full
+                instance_l.aStatusReqQueued[nodeId_p] = 0;
                 ret = kErrorDllAsyncTxBufferFull;
                 goto Exit;
             }
@@ -952,7 +1156,9 @@ Exit:
 \brief Return next request for SoA
 
 The function returns the next request for SoA. It is called by the kernel
-DLL module.
+DLL module. The request queues are served by a deficit round-robin according
+to their weights. A queue which has not been served for more than
+CONFIG_DLLKCAL_ASYNC_SCHED_STARVATION_LIMIT asynchronous phases is preferred.
 
 \param[out]     pReqServiceId_p     Pointer to the request service ID of available
                                     request for MN NMT or generic request queue
@@ -973,8 +1179,10 @@ tOplkError dllkcal_getSoaRequest(tDllReqServiceId* pReqServiceId_p,
                                  UINT* pNodeId_p,
                                  tSoaPayload* pSoaPayload_p)
 {
-    tOplkError  ret = kErrorOk;
-    UINT        count;
+    tOplkError          ret = kErrorOk;
+    UINT                count;
+    UINT                queue;
+    tDllkCalSchedQueue* pSchedQueue;
 
 #if ((CONFIG_DLL_DEFERRED_RXFRAME_RELEASE_ASYNC != FALSE) && defined(CONFIG_EDRV_ASND_DEFERRED_RX_BUFFERS))
     UINT        rxCount = instance_l.asyncFrameReceived - instance_l.asyncFrameFreed;
@@ -991,42 +1199,56 @@ tOplkError dllkcal_getSoaRequest(tDllReqServiceId* pReqServiceId_p,
     }
 #endif
 
-    for (count = DLLKCAL_MAX_QUEUES; count > 0; count--)
+    // the queues have been cleared by dllkcal_clearAsyncQueues()
+    if (instance_l.soaQueueGeneration != instance_l.queueGeneration)
+        clearSoaQueues();
+
+    instance_l.schedStatistics.slotCount++;
+    for (queue = 0; queue < kDllkCalAsyncSchedQueueCount; queue++)
+        instance_l.aSchedQueue[queue].waitCount++;
+
+    // A queue which has waited too long is served out of order
+    queue = getStarvedQueue();
+    if (queue < kDllkCalAsyncSchedQueueCount)
     {
-        switch (instance_l.nextRequestQueue)
+        if (aGetRequestFuncs_l[queue](pReqServiceId_p, pNodeId_p, pSoaPayload_p) != FALSE)
         {
-            case 0:
-                if (getCnGenRequest(pReqServiceId_p, pNodeId_p) != FALSE)
-                    goto Exit;
-                break;
+            grantRequest(queue, TRUE);
+            goto Exit;
+        }
 
-            case 1:
-                if (getCnNmtRequest(pReqServiceId_p, pNodeId_p) != FALSE)
-                    goto Exit;
-                break;
+        instance_l.aSchedQueue[queue].waitCount = 0;
+    }
 
-            case 2:
-                if (getMnGenNmtRequest(pReqServiceId_p, pNodeId_p) != FALSE)
-                    goto Exit;
-                break;
+    // Deficit round-robin among the queues. Every asynchronous phase has the
+    // same cost, thus, a queue may use as many consecutive phases per round
+    // as its weight specifies.
+    for (count = kDllkCalAsyncSchedQueueCount; count > 0; count--)
+    {
+        queue = instance_l.curSchedQueue;
+        pSchedQueue = &instance_l.aSchedQueue[queue];
 
-            case 3:
-                if (getMnIdentRequest(pReqServiceId_p, pNodeId_p) != FALSE)
-                    goto Exit;
-                break;
+        if (pSchedQueue->deficit == 0)
+            pSchedQueue->deficit = pSchedQueue->weight;     // queue starts its turn
 
-            case 4:
-                if (getMnStatusRequest(pReqServiceId_p, pNodeId_p) != FALSE)
-                    goto Exit;
-                break;
+        if (aGetRequestFuncs_l[queue](pReqServiceId_p, pNodeId_p, pSoaPayload_p) != FALSE)
+        {
+            pSchedQueue->deficit--;
+            if (pSchedQueue->deficit == 0)
+                instance_l.curSchedQueue = (queue + 1) % kDllkCalAsyncSchedQueueCount;
 
-            case 5:
-                if (getMnSyncRequest(pReqServiceId_p, pNodeId_p, pSoaPayload_p) != FALSE)
-                    goto Exit;
-                break;
+            grantRequest(queue, FALSE);
+            goto Exit;
         }
+
+        // an empty queue loses its deficit and is not waiting
+        pSchedQueue->deficit = 0;
+        pSchedQueue->waitCount = 0;
+        instance_l.curSchedQueue = (queue + 1) % kDllkCalAsyncSchedQueueCount;
     }
 
+    instance_l.schedStatistics.idleCount++;
+
 Exit:
     return ret;
 }
@@ -1051,38 +1273,38 @@ tOplkError dllkcal_setAsyncPendingRequests(UINT nodeId_p,
                                            tDllAsyncReqPriority asyncReqPrio_p,
                                            UINT count_p)
 {
-    tOplkError          ret = kErrorOk;
-    tCircBufError       err;
-    UINT*               pLocalRequestCnt;
-    tCircBufInstance*   pTargetQueue;
+    tOplkError              ret = kErrorOk;
+    tCircBufError           err;
+    tDllkCalCnRequestQueue* pCnQueue;
 
-    // get local request count for the node and the target queue
+    // get the target queue
     switch (asyncReqPrio_p)
     {
         case kDllAsyncReqPrioNmt:
-            pLocalRequestCnt = &instance_l.aCnRequestCntNmt[nodeId_p-1];
-            pTargetQueue = instance_l.pQueueCnRequestNmt;
+            pCnQueue = &instance_l.cnRequestNmt;
             break;
 
         default:
-            pLocalRequestCnt = &instance_l.aCnRequestCntGen[nodeId_p-1];
-            pTargetQueue = instance_l.pQueueCnRequestGen;
+            pCnQueue = &instance_l.cnRequestGen;
             break;
     }
 
-    // compare the node request count with the locally stored one
-    if (*pLocalRequestCnt < count_p)
-    {
-        // The node has added some requests, but post only one for fair
-        // scheduling among the other nodes.
-        err = circbuf_writeData(pTargetQueue, &nodeId_p, sizeof(nodeId_p));
-        if (err == kCircBufOk)
-            (*pLocalRequestCnt)++; // increment locally only by successful post
-    }
-    else
+    pCnQueue->aRequestCnt[nodeId_p - 1] = count_p;
+
+    // The count has to be visible to the scheduler before the scheduled flag
+    // is checked, see unscheduleCnNode().
+    OPLK_MEMBAR();
+
+    // The node is posted only once for fair scheduling among the other nodes.
+    // It is posted again by the scheduler as long as it has pending requests.
+    // The flag is set before the node is posted, because the scheduler clears
+    // it as soon as it has read the node from the queue.
+    if ((count_p > 0) && (pCnQueue->aScheduled[nodeId_p - 1] == FALSE))
     {
-        // the node's request count is equal or less the local one
-        *pLocalRequestCnt = count_p;
+        pCnQueue->aScheduled[nodeId_p - 1] = TRUE;
+        err = circbuf_writeData(pCnQueue->pQueue, &nodeId_p, sizeof(nodeId_p));
+        if (err != kCircBufOk)
+            pCnQueue->aScheduled[nodeId_p - 1] = FALSE;
     }
 
     return ret;
@@ -1111,11 +1333,11 @@ tOplkError dllkcal_ackAsyncRequest(UINT nodeId_p, tDllReqServiceId reqServiceId_
     switch (reqServiceId_p)
     {
         case kDllReqServiceNmtRequest:
-            pLocalRequestCnt = &instance_l.aCnRequestCntNmt[nodeId_p-1];
+            pLocalRequestCnt = &instance_l.cnRequestNmt.aRequestCnt[nodeId_p - 1];
             break;
 
         case kDllReqServiceUnspecified:
-            pLocalRequestCnt = &instance_l.aCnRequestCntGen[nodeId_p-1];
+            pLocalRequestCnt = &instance_l.cnRequestGen.aRequestCnt[nodeId_p - 1];
             break;
 
         default:
@@ -1128,6 +1350,89 @@ tOplkError dllkcal_ackAsyncRequest(UINT nodeId_p, tDllReqServiceId reqServiceId_
 
     return ret;
 }
+
+//------------------------------------------------------------------------------
+/**
+\brief Set weight of an asynchronous request queue
+
+The function sets the number of consecutive asynchronous phases which the
+specified request queue may use per scheduling round.
+
+\param[in]      queue_p             Request queue to be configured.
+\param[in]      weight_p            Weight of the request queue (at least 1).
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_dllkcal
+*/
+//------------------------------------------------------------------------------
+tOplkError dllkcal_setAsyncSchedWeight(tDllkCalAsyncSchedQueue queue_p,
+                                       UINT weight_p)
+{
+    if ((queue_p >= kDllkCalAsyncSchedQueueCount) || (weight_p == 0))
+        return kErrorDllInvalidParam;
+
+    instance_l.aSchedQueue[queue_p].weight = weight_p;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief Get statistics of the asynchronous scheduler
+
+The function returns the statistics of the scheduler which assigns the
+asynchronous phases of the MN.
+
+\param[out]     ppStatistics_p      Pointer to store statistics pointer.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_dllkcal
+*/
+//------------------------------------------------------------------------------
+tOplkError dllkcal_getAsyncSchedStatistics(tDllkCalAsyncSchedStatistics** ppStatistics_p)
+{
+    tOplkError                          ret;
+    tDllkCalAsyncSchedQueueStatistics*  pQueueStatistics = instance_l.schedStatistics.aQueue;
+    tDllkCalStatistics*                 pStatistics;
+    UINT                                queue;
+    UINT                                frameCount;
+
+    for (queue = 0; queue < kDllkCalAsyncSchedQueueCount; queue++)
+    {
+        pQueueStatistics[queue].weight = instance_l.aSchedQueue[queue].weight;
+        pQueueStatistics[queue].curWait = instance_l.aSchedQueue[queue].waitCount;
+    }
+
+    pQueueStatistics[kDllkCalAsyncSchedQueueCnGen].curDepth = getCnRequestCount(&instance_l.cnRequestGen);
+    pQueueStatistics[kDllkCalAsyncSchedQueueCnNmt].curDepth = getCnRequestCount(&instance_l.cnRequestNmt);
+    pQueueStatistics[kDllkCalAsyncSchedQueueMnIdent].curDepth = circbuf_getDataCount(instance_l.pQueueIdentReq);
+    pQueueStatistics[kDllkCalAsyncSchedQueueMnStatus].curDepth = circbuf_getDataCount(instance_l.pQueueStatusReq);
+
+    // the own requests of the MN are the frames in its asynchronous Tx queues
+    ret = dllkcal_getStatistics(&pStatistics);
+    if (ret != kErrorOk)
+        return ret;
+
+    pQueueStatistics[kDllkCalAsyncSchedQueueMnGenNmt].curDepth = pStatistics->curTxFrameCountNmt +
+                                                                 pStatistics->curTxFrameCountGen;
+
+    frameCount = 0;
+    ret = instance_l.pTxSyncFuncs->pfnGetDataBlockCount(instance_l.dllCalQueueTxSync,
+                                                        &frameCount);
+    if (ret != kErrorOk)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() Get data count of Sync Tx queue returned 0x%X\n",
+                              __func__,
+                              ret);
+    }
+    pQueueStatistics[kDllkCalAsyncSchedQueueMnSync].curDepth = frameCount;
+
+    *ppStatistics_p = &instance_l.schedStatistics;
+
+    return ret;
+}
 #endif
 
 //============================================================================//
@@ -1146,41 +1451,23 @@ The function returns the next CN generic request.
 \param[out]     pReqServiceId_p     Pointer to store the next request.
 \param[out]     pNodeId_p           Pointer to store the node ID for the next
                                     request.
+\param[out]     pSoaPayload_p       Pointer to SoA payload (unused).
 
 \return Returns whether a request was found
 \retval TRUE                        A request was found
 \retval FALSE                       No request was found
 */
 //------------------------------------------------------------------------------
-static BOOL getCnGenRequest(tDllReqServiceId* pReqServiceId_p, UINT* pNodeId_p)
+static BOOL getCnGenRequest(tDllReqServiceId* pReqServiceId_p,
+                            UINT* pNodeId_p,
+                            tSoaPayload* pSoaPayload_p)
 {
-    tCircBufError   err;
-    UINT            rxNodeId;
-    size_t          size = sizeof(rxNodeId);
-
-    // next queue will be CnNmtReq queue
-    instance_l.nextRequestQueue = 1;
-
-    err = circbuf_readData(instance_l.pQueueCnRequestGen, &rxNodeId, size, &size);
-
-    switch (err)
-    {
-        case kCircBufOk:
-            if (instance_l.aCnRequestCntGen[rxNodeId-1] > 0)
-            {
-                *pNodeId_p = rxNodeId;
-                *pReqServiceId_p = kDllReqServiceUnspecified;
-                // dllkcal_ackAsyncRequest() will decrement the request count!
-
-                return TRUE;
-            }
-            // fall-trough
+    UNUSED_PARAMETER(pSoaPayload_p);
 
-        case kCircBufNoReadableData:
-        default:
-            // an empty or faulty queue has no requests
-            return FALSE;
-    }
+    return getCnRequest(&instance_l.cnRequestGen,
+                        kDllReqServiceUnspecified,
+                        pReqServiceId_p,
+                        pNodeId_p);
 }
 
 //------------------------------------------------------------------------------
@@ -1192,41 +1479,23 @@ The function returns the next CN NMT request.
 \param[out]     pReqServiceId_p     Pointer to store the next request.
 \param[out]     pNodeId_p           Pointer to store the node ID for the next
                                     request.
+\param[out]     pSoaPayload_p       Pointer to SoA payload (unused).
 
 \return Returns whether a request was found
 \retval TRUE                        A request was found
 \retval FALSE                       No request was found
 */
 //------------------------------------------------------------------------------
-static BOOL getCnNmtRequest(tDllReqServiceId* pReqServiceId_p, UINT* pNodeId_p)
+static BOOL getCnNmtRequest(tDllReqServiceId* pReqServiceId_p,
+                            UINT* pNodeId_p,
+                            tSoaPayload* pSoaPayload_p)
 {
-    tCircBufError   err;
-    UINT            rxNodeId;
-    size_t          size = sizeof(rxNodeId);
-
-    // next queue will be MnGenReq queue
-    instance_l.nextRequestQueue = 2;
+    UNUSED_PARAMETER(pSoaPayload_p);
 
-    err = circbuf_readData(instance_l.pQueueCnRequestNmt, &rxNodeId, size, &size);
-
-    switch (err)
-    {
-        case kCircBufOk:
-            if (instance_l.aCnRequestCntNmt[rxNodeId-1] > 0)
-            {
-                *pNodeId_p = rxNodeId;
-                *pReqServiceId_p = kDllReqServiceNmtRequest;
-                // dllkcal_ackAsyncRequest() will decrement the request count!
-
-                return TRUE;
-            }
-            // fall-trough
-
-        case kCircBufNoReadableData:
-        default:
-            // an empty or faulty queue has no requests
-            return FALSE;
-    }
+    return getCnRequest(&instance_l.cnRequestNmt,
+                        kDllReqServiceNmtRequest,
+                        pReqServiceId_p,
+                        pNodeId_p);
 }
 
 //------------------------------------------------------------------------------
@@ -1238,17 +1507,20 @@ The function returns the next MN Generic/NMT request.
 \param[out]     pReqServiceId_p     Pointer to store the next request.
 \param[out]     pNodeId_p           Pointer to store the node ID for the next
                                     request.
+\param[out]     pSoaPayload_p       Pointer to SoA payload (unused).
 
 \return Returns whether a request was found
 \retval TRUE                        A request was found
 \retval FALSE                       No request was found
 */
 //------------------------------------------------------------------------------
-static BOOL getMnGenNmtRequest(tDllReqServiceId* pReqServiceId_p, UINT* pNodeId_p)
+static BOOL getMnGenNmtRequest(tDllReqServiceId* pReqServiceId_p,
+                               UINT* pNodeId_p,
+                               tSoaPayload* pSoaPayload_p)
 {
+    UNUSED_PARAMETER(pSoaPayload_p);
+
     // MnNmtReq and MnGenReq
-    // next queue will be MnIdentReq queue
-    instance_l.nextRequestQueue = 3;
     if (*pReqServiceId_p != kDllReqServiceNo)
     {
         *pNodeId_p = C_ADR_INVALID;   // DLLk must exchange this with the actual node ID
@@ -1267,26 +1539,21 @@ The function returns the next MN ident request.
 \param[out]     pReqServiceId_p     Pointer to store the next request.
 \param[out]     pNodeId_p           Pointer to store the node ID for the next
                                     request.
+\param[out]     pSoaPayload_p       Pointer to SoA payload (unused).
 
 \return Returns whether a request was found
 \retval TRUE                        A request was found
 \retval FALSE                       No request was found
 */
 //------------------------------------------------------------------------------
-static BOOL getMnIdentRequest(tDllReqServiceId* pReqServiceId_p, UINT* pNodeId_p)
+static BOOL getMnIdentRequest(tDllReqServiceId* pReqServiceId_p,
+                              UINT* pNodeId_p,
+                              tSoaPayload* pSoaPayload_p)
 {
-    tCircBufError   err;
-    UINT            rxNodeId;
-    size_t          size = sizeof(rxNodeId);
-
-    // next queue will be MnStatusReq queue
-    instance_l.nextRequestQueue = 4;
-
-    err = circbuf_readData(instance_l.pQueueIdentReq, &rxNodeId, size, &size);
+    UNUSED_PARAMETER(pSoaPayload_p);
 
-    if (err == kCircBufOk)
-    {   // queue is not empty
-        *pNodeId_p = rxNodeId;
+    if (getNodeRequest(instance_l.pQueueIdentReq, instance_l.aIdentReqQueued, pNodeId_p))
+    {
         *pReqServiceId_p = kDllReqServiceIdent;
         return TRUE;
     }
@@ -1303,25 +1570,21 @@ The function returns the next MN status request.
 \param[out]     pReqServiceId_p     Pointer to store the next request.
 \param[out]     pNodeId_p           Pointer to store the node ID for the next
                                     request.
+\param[out]     pSoaPayload_p       Pointer to SoA payload (unused).
 
 \return Returns whether a request was found
 \retval TRUE                        A request was found
 \retval FALSE                       No request was found
 */
 //------------------------------------------------------------------------------
-static BOOL getMnStatusRequest(tDllReqServiceId* pReqServiceId_p, UINT* pNodeId_p)
+static BOOL getMnStatusRequest(tDllReqServiceId* pReqServiceId_p,
+                               UINT* pNodeId_p,
+                               tSoaPayload* pSoaPayload_p)
 {
-    tCircBufError   err;
-    UINT            rxNodeId;
-    size_t          size = sizeof(rxNodeId);
-
-    // next queue will be MnSyncReq queue
-    instance_l.nextRequestQueue = 5;
-    err = circbuf_readData(instance_l.pQueueStatusReq, &rxNodeId, size, &size);
+    UNUSED_PARAMETER(pSoaPayload_p);
 
-    if (err == kCircBufOk)
-    {   // queue is not empty
-        *pNodeId_p = rxNodeId;
+    if (getNodeRequest(instance_l.pQueueStatusReq, instance_l.aStatusReqQueued, pNodeId_p))
+    {
         *pReqServiceId_p = kDllReqServiceStatus;
         return TRUE;
     }
@@ -1329,6 +1592,50 @@ static BOOL getMnStatusRequest(tDllReqServiceId* pReqServiceId_p, UINT* pNodeId_
     return FALSE;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Get node of Ident/StatusRequest queue
+
+The function reads the next node from an IdentRequest or StatusRequest queue.
+Entries of a previous queue generation are dropped.
+
+\param[in]      pQueue_p            Pointer to the request queue.
+\param[in,out]  aQueued_p           Queue generation of the queued nodes.
+\param[out]     pNodeId_p           Pointer to store the node ID.
+
+\return Returns whether a node was found
+\retval TRUE                        A node was found
+\retval FALSE                       The queue is empty
+*/
+//------------------------------------------------------------------------------
+static BOOL getNodeRequest(tCircBufInstance* pQueue_p,
+                           UINT8* aQueued_p,
+                           UINT* pNodeId_p)
+{
+    tDllkCalNodeRequest request;
+    size_t              size = sizeof(request);
+
+    while (circbuf_readData(pQueue_p, &request, size, &size) == kCircBufOk)
+    {
+        // The flag is cleared after the entry has been read. A request which is
+        // issued in between is served by this SoA. A flag which has already been
+        // set for a newer generation is kept.
+        if (aQueued_p[request.nodeId] == request.generation)
+            aQueued_p[request.nodeId] = 0;
+
+        if (request.generation == instance_l.queueGeneration)
+        {
+            *pNodeId_p = request.nodeId;
+            return TRUE;
+        }
+
+        // the entry has been queued before the queues were cleared
+        size = sizeof(request);
+    }
+
+    return FALSE;
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  Get MN Sync request
@@ -1358,8 +1665,6 @@ static BOOL getMnSyncRequest(tDllReqServiceId* pReqServiceId_p,
     tDllSyncRequest     syncRequest;
     tDllNodeOpParam     nodeOpParam;
 
-    // next queue will be CnGenReq queue
-    instance_l.nextRequestQueue = 0;
     ret = instance_l.pTxSyncFuncs->pfnGetDataBlockCount(instance_l.dllCalQueueTxSync,
                                                         &syncReqCount);
     if (ret != kErrorOk)
@@ -1425,8 +1730,317 @@ static BOOL getMnSyncRequest(tDllReqServiceId* pReqServiceId_p,
     return FALSE;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Get request of a CN request queue
+
+The function returns the next request of the given CN request queue. The CNs
+with pending requests are served round-robin. Every CN may use
+CONFIG_DLLKCAL_ASYNC_SCHED_NODE_QUANTUM consecutive asynchronous phases before
+it is moved to the end of the queue.
+
+\param[in,out]  pCnQueue_p          Pointer to the CN request queue.
+\param[in]      reqServiceId_p      Request service ID of the queue.
+\param[out]     pReqServiceId_p     Pointer to store the next request.
+\param[out]     pNodeId_p           Pointer to store the node ID for the next
+                                    request.
+
+\return Returns whether a request was found
+\retval TRUE                        A request was found
+\retval FALSE                       No request was found
+*/
+//------------------------------------------------------------------------------
+static BOOL getCnRequest(tDllkCalCnRequestQueue* pCnQueue_p,
+                         tDllReqServiceId reqServiceId_p,
+                         tDllReqServiceId* pReqServiceId_p,
+                         UINT* pNodeId_p)
+{
+    tCircBufError   err;
+    UINT            nodeId = pCnQueue_p->curNodeId;
+    UINT            requestCnt;
+    size_t          size;
+
+    if ((nodeId != C_ADR_INVALID) && (pCnQueue_p->aRequestCnt[nodeId - 1] == 0))
+    {   // the current node has no more requests
+        unscheduleCnNode(pCnQueue_p, nodeId, 0);
+        nodeId = C_ADR_INVALID;
+    }
+
+    while (nodeId == C_ADR_INVALID)
+    {
+        size = sizeof(nodeId);
+        err = circbuf_readData(pCnQueue_p->pQueue, &nodeId, size, &size);
+        if (err != kCircBufOk)
+        {   // an empty or faulty queue has no requests
+            pCnQueue_p->curNodeId = C_ADR_INVALID;
+            return FALSE;
+        }
+
+        if (pCnQueue_p->aRequestCnt[nodeId - 1] == 0)
+        {   // the requests of the node have been served in the meantime
+            unscheduleCnNode(pCnQueue_p, nodeId, 0);
+            nodeId = C_ADR_INVALID;
+        }
+        else
+        {
+            pCnQueue_p->nodeDeficit = CONFIG_DLLKCAL_ASYNC_SCHED_NODE_QUANTUM;
+        }
+    }
+
+    *pNodeId_p = nodeId;
+    *pReqServiceId_p = reqServiceId_p;
+    // dllkcal_ackAsyncRequest() will decrement the request count!
+
+    instance_l.schedStatistics.aCnGrantCount[nodeId - 1]++;
+    pCnQueue_p->nodeDeficit--;
+    pCnQueue_p->curNodeId = C_ADR_INVALID;
+
+    requestCnt = pCnQueue_p->aRequestCnt[nodeId - 1];
+    if (requestCnt <= 1)
+    {   // last request, the node is posted again when it reports new ones
+        unscheduleCnNode(pCnQueue_p, nodeId, requestCnt);
+    }
+    else if (pCnQueue_p->nodeDeficit == 0)
+    {   // move the node to the end of the queue
+        err = circbuf_writeData(pCnQueue_p->pQueue, &nodeId, sizeof(nodeId));
+        if (err != kCircBufOk)
+            pCnQueue_p->aScheduled[nodeId - 1] = FALSE;
+    }
+    else
+    {   // the node keeps the next asynchronous phase of this queue
+        pCnQueue_p->curNodeId = nodeId;
+    }
+
+    return TRUE;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Remove CN from the scheduling
+
+The function clears the scheduled flag of a CN which the scheduler does not post
+again. dllkcal_setAsyncPendingRequests() is called concurrently by the Rx path.
+If it has reported new requests after the scheduler checked the request count
+but before the flag is cleared, it has not posted the node. Therefore, the count
+is checked again after the flag has been cleared and the node is posted if new
+requests have been reported. If both sides see the update of the other one, the
+node is posted twice. The second entry is served like the first one and is
+dropped when the node has no more requests.
+
+\param[in,out]  pCnQueue_p          Pointer to the CN request queue.
+\param[in]      nodeId_p            Node ID of the CN.
+\param[in]      requestCnt_p        Request count the scheduler has decided on.
+*/
+//------------------------------------------------------------------------------
+static void unscheduleCnNode(tDllkCalCnRequestQueue* pCnQueue_p,
+                             UINT nodeId_p,
+                             UINT requestCnt_p)
+{
+    tCircBufError   err;
+
+    pCnQueue_p->aScheduled[nodeId_p - 1] = FALSE;
+    OPLK_MEMBAR();
+
+    if ((pCnQueue_p->aRequestCnt[nodeId_p - 1] > requestCnt_p) &&
+        (pCnQueue_p->aScheduled[nodeId_p - 1] == FALSE))
+    {
+        pCnQueue_p->aScheduled[nodeId_p - 1] = TRUE;
+        err = circbuf_writeData(pCnQueue_p->pQueue, &nodeId_p, sizeof(nodeId_p));
+        if (err != kCircBufOk)
+            pCnQueue_p->aScheduled[nodeId_p - 1] = FALSE;
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Clear the scheduling state of the SoA path
+
+The function resets the scheduling state and the CN request queues after
+dllkcal_clearAsyncQueues() has started a new queue generation. It is called
+by the SoA path, which owns this state. The Ident/StatusRequest queues are
+cleared while they are read, see getNodeRequest().
+*/
+//------------------------------------------------------------------------------
+static void clearSoaQueues(void)
+{
+    UINT    queue;
+
+    instance_l.soaQueueGeneration = instance_l.queueGeneration;
+
+    for (queue = 0; queue < kDllkCalAsyncSchedQueueCount; queue++)
+    {
+        instance_l.aSchedQueue[queue].deficit = 0;
+        instance_l.aSchedQueue[queue].waitCount = 0;
+    }
+    instance_l.curSchedQueue = 0;
+
+    resetCnRequestQueue(&instance_l.cnRequestGen);
+    resetCnRequestQueue(&instance_l.cnRequestNmt);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get starved request queue
+
+The function returns the request queue which has waited longest for more than
+CONFIG_DLLKCAL_ASYNC_SCHED_STARVATION_LIMIT asynchronous phases.
+
+\return The function returns the starved queue or kDllkCalAsyncSchedQueueCount
+        if no queue is starved.
+*/
+//------------------------------------------------------------------------------
+static UINT getStarvedQueue(void)
+{
+    UINT    queue;
+    UINT    starvedQueue = kDllkCalAsyncSchedQueueCount;
+    UINT    maxWaitCount = CONFIG_DLLKCAL_ASYNC_SCHED_STARVATION_LIMIT;
+
+    for (queue = 0; queue < kDllkCalAsyncSchedQueueCount; queue++)
+    {
+        if (instance_l.aSchedQueue[queue].waitCount > maxWaitCount)
+        {
+            maxWaitCount = instance_l.aSchedQueue[queue].waitCount;
+            starvedQueue = queue;
+        }
+    }
+
+    return starvedQueue;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Account granted request
+
+The function updates the waiting time and the statistics of a request queue
+which has been granted the next asynchronous phase.
+
+\param[in]      queue_p             Granted request queue.
+\param[in]      fForced_p           Grant has been forced by the starvation bound.
+*/
+//------------------------------------------------------------------------------
+static void grantRequest(UINT queue_p, BOOL fForced_p)
+{
+    tDllkCalAsyncSchedQueueStatistics*  pQueueStatistics = &instance_l.schedStatistics.aQueue[queue_p];
+    UINT                                waitCount;
+
+    // the current asynchronous phase is not part of the waiting time
+    waitCount = instance_l.aSchedQueue[queue_p].waitCount - 1;
+    instance_l.aSchedQueue[queue_p].waitCount = 0;
+
+    pQueueStatistics->grantCount++;
+    if (fForced_p != FALSE)
+        pQueueStatistics->forcedGrantCount++;
+
+    pQueueStatistics->waitSum += waitCount;
+    if (waitCount > pQueueStatistics->maxWait)
+        pQueueStatistics->maxWait = waitCount;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Reset CN request queue
+
+The function removes all nodes and requests from a CN request queue.
+
+\param[in,out]  pCnQueue_p          Pointer to the CN request queue.
+*/
+//------------------------------------------------------------------------------
+static void resetCnRequestQueue(tDllkCalCnRequestQueue* pCnQueue_p)
+{
+    circbuf_reset(pCnQueue_p->pQueue);
+
+    OPLK_MEMSET(pCnQueue_p->aRequestCnt, 0, sizeof(pCnQueue_p->aRequestCnt));
+    OPLK_MEMSET(pCnQueue_p->aScheduled, 0, sizeof(pCnQueue_p->aScheduled));
+    pCnQueue_p->curNodeId = C_ADR_INVALID;
+    pCnQueue_p->nodeDeficit = 0;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get request count of CN request queue
+
+The function returns the number of pending requests of all nodes in a CN
+request queue.
+
+\param[in]      pCnQueue_p          Pointer to the CN request queue.
+
+\return The function returns the number of pending requests.
+*/
+//------------------------------------------------------------------------------
+static UINT getCnRequestCount(const tDllkCalCnRequestQueue* pCnQueue_p)
+{
+    UINT    nodeIndex;
+    UINT    requestCount = 0;
+
+    for (nodeIndex = 0; nodeIndex < tabentries(pCnQueue_p->aRequestCnt); nodeIndex++)
+        requestCount += pCnQueue_p->aRequestCnt[nodeIndex];
+
+    return requestCount;
+}
+
 #endif
 
+//------------------------------------------------------------------------------
+/**
+\brief  Insert asynchronous frame into Tx queue
+
+This function inserts an asynchronous frame into the Tx queue of the given
+priority.
+
+\param[in]      pFrameInfo_p        Pointer to asynchronous frame. The frame size
+                                    includes the Ethernet header (14 bytes).
+\param[in]      priority_p          Priority to send frame with
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError insertAsyncFrame(tFrameInfo* pFrameInfo_p,
+                                   tDllAsyncReqPriority priority_p)
+{
+    tOplkError  ret;
+
+    switch (priority_p)
+    {
+        case kDllAsyncReqPrioNmt:    // NMT request priority
+            ret = instance_l.pTxNmtFuncs->pfnInsertDataBlock(
+                                              instance_l.dllCalQueueTxNmt,
+                                              pFrameInfo_p->frame.pBuffer,
+                                              (size_t)pFrameInfo_p->frameSize);
+            break;
+
+        default:    // generic priority
+            ret = sendGenericAsyncFrame(pFrameInfo_p);
+            break;
+    }
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Inform the DLL about new asynchronous frames
+
+The function posts a FillTx event to the kernel DLL module, so that the
+frames of the specified priority are forwarded to the Tx buffers.
+
+\param[in]      priority_p          Priority of the new frames
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError postFillTxEvent(tDllAsyncReqPriority priority_p)
+{
+    tEvent  event;
+
+    event.eventSink = kEventSinkDllk;
+    event.eventType = kEventTypeDllkFillTx;
+    OPLK_MEMSET(&event.netTime, 0x00, sizeof(event.netTime));
+    event.eventArg.pEventArg = &priority_p;
+    event.eventArgSize = sizeof(priority_p);
+
+    return eventk_postEvent(&event);
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  Send asynchronous frame
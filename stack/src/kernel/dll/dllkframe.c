@@ -2871,6 +2871,10 @@ the PRes frame. For all nodes between the one we received the last PRes and
 this node we issue a loss of PRes. The node information of the node will
 be stored at \p ppIntNodeInfo_p.
 
+The position of the node in the node ID list is taken from the index table
+which is built together with the list in dllknode_setupSyncPhase(), so the
+list does not need to be walked.
+
 \param[in]      nodeId_p            Node ID of node to search.
 \param[out]     ppIntNodeInfo_p     Location to store the pointer to the node information.
 \param[out]     pfPrcSlotFinished_p Pointer to store the flag for a finished poll response
@@ -2884,39 +2888,49 @@ static tOplkError searchNodeInfo(UINT nodeId_p,
                                  BOOL* pfPrcSlotFinished_p)
 {
     tOplkError      ret = kErrorOk;
-    UINT8           nextNodeIndex = dllkInstance_g.curNodeIndex;
-    UINT8*          pCnNodeId = &dllkInstance_g.aCnNodeIdList[dllkInstance_g.curTxBufferOffsetCycle][nextNodeIndex];
-    tDllkNodeInfo*  pIntNodeInfo = NULL;
-
-    while (*pCnNodeId != C_ADR_INVALID)
+    UINT            cycle = dllkInstance_g.curTxBufferOffsetCycle;
+    UINT8           curNodeIndex = dllkInstance_g.curNodeIndex;
+    const UINT8*    pCnNodeIdList = &dllkInstance_g.aCnNodeIdList[cycle][0];
+    UINT8           nodeIndex = DLLK_CN_NODE_INDEX_INVALID;
+    UINT8           prcSlotEndIndex = dllkInstance_g.aPrcSlotEndIndex[cycle];
+
+    // look up the position of the CN in the node ID list of the current cycle
+    if ((nodeId_p > C_ADR_INVALID) && (nodeId_p <= NMT_MAX_NODE_ID))
     {
-        if (*pCnNodeId == nodeId_p)
-        {   // CN found in list
-            nextNodeIndex = nextNodeIndex - dllkInstance_g.curNodeIndex;
-            dllkInstance_g.curNodeIndex += nextNodeIndex + 1;
+        nodeIndex = dllkInstance_g.aCnNodeIndex[cycle][nodeId_p - 1];
+        if ((nodeIndex < curNodeIndex) ||
+            (nodeIndex >= dllkInstance_g.aCnNodeIdCount[cycle]) ||
+            (pCnNodeIdList[nodeIndex] != nodeId_p))
+            nodeIndex = DLLK_CN_NODE_INDEX_INVALID;     // CN already processed or not in list
+    }
 
-            // issue error for each CN in list between last and current
-            for (pCnNodeId-- ; nextNodeIndex > 0; nextNodeIndex--, pCnNodeId--)
-            {
-                ret = dllknode_issueLossOfPres(*pCnNodeId);
-                if (ret != kErrorOk)
-                    return ret;
-            }
+    if (nodeIndex == DLLK_CN_NODE_INDEX_INVALID)
+    {   // CN not found in the remaining list
+        if ((prcSlotEndIndex != DLLK_CN_NODE_INDEX_INVALID) &&
+            (prcSlotEndIndex >= curNodeIndex))
+            *pfPrcSlotFinished_p = TRUE;            // PRC slot finished
 
-            pIntNodeInfo = dllknode_getNodeInfo(nodeId_p);
-            break;
-        }
-        else
-        {
-            if (*pCnNodeId == C_ADR_BROADCAST)
-                *pfPrcSlotFinished_p = TRUE;        // PRC slot finished
-        }
+        *ppIntNodeInfo_p = NULL;
+        return ret;
+    }
+
+    if ((prcSlotEndIndex != DLLK_CN_NODE_INDEX_INVALID) &&
+        (prcSlotEndIndex >= curNodeIndex) &&
+        (prcSlotEndIndex < nodeIndex))
+        *pfPrcSlotFinished_p = TRUE;                // PRC slot finished
 
-        pCnNodeId++;
-        nextNodeIndex++;
+    dllkInstance_g.curNodeIndex = nodeIndex + 1;
+
+    // issue error for each CN in list between last and current
+    while (nodeIndex > curNodeIndex)
+    {
+        nodeIndex--;
+        ret = dllknode_issueLossOfPres(pCnNodeIdList[nodeIndex]);
+        if (ret != kErrorOk)
+            return ret;
     }
 
-    *ppIntNodeInfo_p = pIntNodeInfo;
+    *ppIntNodeInfo_p = dllknode_getNodeInfo(nodeId_p);
 
     return ret;
 }
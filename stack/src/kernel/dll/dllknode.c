@@ -772,6 +772,8 @@ tOplkError dllknode_setupSyncPhase(tNmtState nmtState_p,
                                    UINT* pIndex_p)
 {
     tOplkError      ret = kErrorOk;
+    UINT8*          pCnNodeIdList;
+    UINT8*          pCnNodeIndex;
     UINT8*          pCnNodeId;
     UINT32          accFrameLenNs = 0;
     tPlkFrame*      pTxFrame;
@@ -791,7 +793,12 @@ tOplkError dllknode_setupSyncPhase(tNmtState nmtState_p,
         accFrameLenNs = C_DLL_T_PREAMBLE + C_DLL_T_MIN_FRAME + C_DLL_T_IFG;
     }
 
-    pCnNodeId = &dllkInstance_g.aCnNodeIdList[nextTxBufferOffset_p][0];
+    // The node ID list is accompanied by an index table, which allows
+    // searchNodeInfo() to locate a node without walking the list.
+    pCnNodeIdList = &dllkInstance_g.aCnNodeIdList[nextTxBufferOffset_p][0];
+    pCnNodeIndex = &dllkInstance_g.aCnNodeIndex[nextTxBufferOffset_p][0];
+    pCnNodeId = pCnNodeIdList;
+    dllkInstance_g.aPrcSlotEndIndex[nextTxBufferOffset_p] = DLLK_CN_NODE_INDEX_INVALID;
 
     if (nmtState_p != kNmtMsOperational)
         fReadyFlag_p = FALSE;
@@ -834,18 +841,21 @@ tOplkError dllknode_setupSyncPhase(tNmtState nmtState_p,
                     while (pIntPrcNodeInfo != NULL)
                     {
                         *pCnNodeId = (UINT8)pIntPrcNodeInfo->nodeId;
+                        pCnNodeIndex[pIntPrcNodeInfo->nodeId - 1] = (UINT8)(pCnNodeId - pCnNodeIdList);
                         pCnNodeId++;
                         *pNextTimeOffsetNs_p = pIntNodeInfo->presTimeoutNs;
                         pIntPrcNodeInfo = pIntPrcNodeInfo->pNextNodeInfo;
                     }
 
                     *pCnNodeId = C_ADR_BROADCAST;    // mark this entry as PRC slot finished
+                    dllkInstance_g.aPrcSlotEndIndex[nextTxBufferOffset_p] = (UINT8)(pCnNodeId - pCnNodeIdList);
                     pCnNodeId++;
                 }
             }
             else
             {   // PReq to CN
                 *pCnNodeId = (UINT8)pIntNodeInfo->nodeId;
+                pCnNodeIndex[pIntNodeInfo->nodeId - 1] = (UINT8)(pCnNodeId - pCnNodeIdList);
                 pCnNodeId++;
                 *pNextTimeOffsetNs_p = pIntNodeInfo->presTimeoutNs;
             }
@@ -865,6 +875,7 @@ tOplkError dllknode_setupSyncPhase(tNmtState nmtState_p,
         pIntNodeInfo = pIntNodeInfo->pNextNodeInfo;
     }
     *pCnNodeId = C_ADR_INVALID;    // mark last entry in node-ID list
+    dllkInstance_g.aCnNodeIdCount[nextTxBufferOffset_p] = (UINT8)(pCnNodeId - pCnNodeIdList);
 
     return ret;
 }
@@ -41,8 +41,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // includes
 //------------------------------------------------------------------------------
 #include <common/oplkinc.h>
+#include <common/target.h>
 #include <common/ftracedebug.h>
 #include <kernel/edrv.h>
+#include <kernel/edrvbpf.h>
 
 #include <unistd.h>
 #include <pcap.h>
@@ -99,6 +101,7 @@ typedef struct
     pcap_t*             pPcap;                              ///< Pointer to the pcap interface instance
     pcap_t*             pPcapThread;                        ///< Handle of the pcap packet handler thread
     pthread_t           hThread;                            ///< Handle of the worker thread
+    tEdrvBpfFilterCache rxFilterCache;                      ///< Rx filter table and BPF program set for the capture handle
 } tEdrvInstance;
 
 //------------------------------------------------------------------------------
@@ -134,8 +137,6 @@ This function initializes the Ethernet driver.
 //------------------------------------------------------------------------------
 tOplkError edrv_init(const tEdrvInitParam* pEdrvInitParam_p)
 {
-    struct sched_param  schedParam;
-
     // Check parameter validity
     ASSERT(pEdrvInitParam_p != NULL);
 
@@ -194,16 +195,15 @@ tOplkError edrv_init(const tEdrvInitParam* pEdrvInitParam_p)
         return kErrorEdrvInit;
     }
 
-    schedParam.sched_priority = CONFIG_THREAD_PRIORITY_MEDIUM;
-    if (pthread_setschedparam(edrvInstance_l.hThread, SCHED_FIFO, &schedParam) != 0)
+    if (target_registerThread(kOplkThreadRoleEdrvRx,
+                              edrvInstance_l.hThread,
+                              kOplkThreadPolicyFifo,
+                              CONFIG_THREAD_PRIORITY_MEDIUM,
+                              "oplk-edrvpcap") != kErrorOk)
     {
         DEBUG_LVL_ERROR_TRACE("%s() couldn't set thread scheduling parameters!\n", __func__);
     }
 
-#if (defined(__GLIBC__) && (__GLIBC__ >= 2) && (__GLIBC_MINOR__ >= 12))
-    pthread_setname_np(edrvInstance_l.hThread, "oplk-edrvpcap");
-#endif
-
     /* wait until thread is started */
     sem_wait(&edrvInstance_l.syncSem);
 
@@ -223,6 +223,8 @@ This function shuts down the Ethernet driver.
 //------------------------------------------------------------------------------
 tOplkError edrv_exit(void)
 {
+    target_unregisterThread(kOplkThreadRoleEdrvRx, edrvInstance_l.hThread);
+
     // End the pcap loop and wait for the worker thread to terminate
     pcap_breakloop(edrvInstance_l.pPcapThread);
     pthread_cancel(edrvInstance_l.hThread);
@@ -388,7 +390,11 @@ selects the Rx filter entry that shall be changed and \p changeFlags_p determine
 the property.
 If \p entryChanged_p is equal or larger count_p all Rx filters shall be changed.
 
-\note Rx filters are not supported by this driver!
+The Rx filter table is translated into a BPF program which is set for the
+pcap capture handle. Thus, frames which are not needed by the data link layer
+are already discarded by the kernel. The program is only regenerated if the
+table has changed in a relevant way. If the table doesn't fit into a program,
+all frames are accepted.
 
 \param[in,out]  pFilter_p           Base pointer of Rx filter array
 \param[in]      count_p             Number of Rx filter array entries
@@ -405,11 +411,51 @@ tOplkError edrv_changeRxFilter(tEdrvFilter* pFilter_p,
                                UINT entryChanged_p,
                                UINT changeFlags_p)
 {
-    UNUSED_PARAMETER(pFilter_p);
-    UNUSED_PARAMETER(count_p);
+    tEdrvBpfProgram*    pProgram = &edrvInstance_l.rxFilterCache.newProgram;
+    struct bpf_program  bpfProgram;
+
     UNUSED_PARAMETER(entryChanged_p);
     UNUSED_PARAMETER(changeFlags_p);
 
+    if (!edrvbpf_updateFilterCache(&edrvInstance_l.rxFilterCache, pFilter_p, count_p))
+        return kErrorOk;
+
+    // Own frames are captured for the Tx completion
+    if ((pFilter_p == NULL) || (count_p == 0) ||
+        (edrvbpf_compileFilters(pFilter_p,
+                                count_p,
+                                edrvInstance_l.initParam.aMacAddr,
+                                pProgram) != kErrorOk))
+    {
+        // Accept all frames
+        pProgram->insnCount = 1;
+        pProgram->aInsn[0].code = BPF_RET | BPF_K;
+        pProgram->aInsn[0].jt = 0;
+        pProgram->aInsn[0].jf = 0;
+        pProgram->aInsn[0].k = EDRV_BPF_ACCEPT;
+    }
+
+    if (edrvbpf_isEqual(pProgram, &edrvInstance_l.rxFilterCache.program))
+        return kErrorOk;
+
+    // The instruction layout of struct sock_filter and struct bpf_insn is identical
+    bpfProgram.bf_len = pProgram->insnCount;
+    bpfProgram.bf_insns = (struct bpf_insn*)pProgram->aInsn;
+    if (pcap_setfilter(edrvInstance_l.pPcapThread, &bpfProgram) < 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() pcap_setfilter failed (%s)\n",
+                              __func__,
+                              pcap_geterr(edrvInstance_l.pPcapThread));
+        // Force the regeneration with the next change
+        edrvInstance_l.rxFilterCache.fValid = FALSE;
+        return kErrorEdrvInit;
+    }
+
+    edrvInstance_l.rxFilterCache.program.insnCount = pProgram->insnCount;
+    OPLK_MEMCPY(edrvInstance_l.rxFilterCache.program.aInsn,
+                pProgram->aInsn,
+                pProgram->insnCount * sizeof(struct sock_filter));
+
     return kErrorOk;
 }
 
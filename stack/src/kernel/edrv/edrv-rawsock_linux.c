@@ -6,6 +6,14 @@
 
 This file contains the implementation of the Linux raw socket Ethernet driver.
 
+Transmitted frames are completed with the kernel's transmit time stamps
+(SO_TIMESTAMPING). Each frame gets a sequence number which the kernel returns
+together with the time stamp on the socket's error queue, so that the Tx
+handler is called when the frame has actually left the host. A frame whose
+time stamp doesn't arrive within \ref EDRV_TX_STAMP_TIMEOUT is completed
+without time stamp. If time stamping is not available, the Tx handler is called
+as soon as the frame has been passed to the kernel.
+
 \ingroup module_edrv
 *******************************************************************************/
 
@@ -41,14 +49,16 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // includes
 //------------------------------------------------------------------------------
 #include <common/oplkinc.h>
+#include <common/target.h>
 #include <common/ftracedebug.h>
 #include <kernel/edrv.h>
+#include <kernel/edrvbpf.h>
 
 #include <unistd.h>
 #include <string.h>
 #include <semaphore.h>
 #include <pthread.h>
-#include <sys/select.h>
+#include <poll.h>
 #include <sys/syscall.h>
 #include <sys/socket.h>
 #include <sys/ioctl.h>
@@ -59,7 +69,11 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <arpa/inet.h>
 #include <ifaddrs.h>
 #include <linux/if_packet.h>
+#include <linux/net_tstamp.h>
+#include <linux/errqueue.h>
+#include <linux/sockios.h>
 #include <sys/types.h>
+#include <time.h>
 
 //============================================================================//
 //            G L O B A L   D E F I N I T I O N S                             //
@@ -89,6 +103,13 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef PACKET_QDISC_BYPASS
 #define PACKET_QDISC_BYPASS     20
 #endif
+#ifndef PACKET_IGNORE_OUTGOING
+#define PACKET_IGNORE_OUTGOING  23
+#endif
+
+#define EDRV_TX_PENDING_COUNT   64          ///< Maximum number of frames waiting for Tx completion
+#define EDRV_RX_POLL_TIMEOUT    100         ///< Receive poll timeout [ms] for checking the thread exit condition
+#define EDRV_TX_STAMP_TIMEOUT   5           ///< Time [ms] after which a frame without Tx time stamp is completed
 //------------------------------------------------------------------------------
 // local types
 //------------------------------------------------------------------------------
@@ -100,11 +121,18 @@ This structure describes an instance of the Ethernet driver.
 typedef struct
 {
     tEdrvInitParam      initParam;                       ///< Init parameters
-    tEdrvTxBuffer*      pTransmittedTxBufferLastEntry;   ///< Pointer to the last entry of the transmitted TX buffer
-    tEdrvTxBuffer*      pTransmittedTxBufferFirstEntry;  ///< Pointer to the first entry of the transmitted Tx buffer
+    tEdrvTxBuffer*      apTxPending[EDRV_TX_PENDING_COUNT]; ///< Frames waiting for Tx completion, indexed by sequence number
+    UINT32              txIdNext;                        ///< Sequence number of the next transmitted frame
+    UINT32              txIdDone;                        ///< Sequence number of the oldest frame waiting for completion
+    UINT32              txIdKernelOffset;                ///< Difference between the kernel's and the driver's sequence numbers
+    UINT64              aTxPendingTimeMs[EDRV_TX_PENDING_COUNT]; ///< Send time of the frames waiting for Tx completion
+    BOOL                fTxTimestamping;                 ///< Tx completion is based on kernel time stamps
+    BOOL                fHwConfigChanged;                ///< The hardware time stamping configuration has to be restored on exit
+    struct hwtstamp_config hwConfigOrig;                 ///< Original hardware time stamping configuration of the interface
     pthread_mutex_t     mutex;                           ///< Mutex for locking of critical sections
     sem_t               syncSem;                         ///< Semaphore for signaling the start of the worker thread
     int                 sock;                            ///< Raw socket handle
+    tEdrvBpfFilterCache rxFilterCache;                   ///< Rx filter table and BPF program attached to the socket
     pthread_t           hThread;                         ///< Handle of the worker thread
     BOOL                fStartCommunication;             ///< Flag to indicate, that communication is started. Set to false on exit
     BOOL                fThreadIsExited;                 ///< Set by thread if already exited
@@ -122,6 +150,14 @@ static void     packetHandler(void* pParam_p,
                               const int frameSize_p,
                               void* pPktData_p);
 static void*    workerThread(void* pArgument_p);
+static void     setupTxTimestamping(tEdrvInstance* pInstance_p);
+static void     restoreHwTimestamping(tEdrvInstance* pInstance_p);
+static void     processTxCompletions(tEdrvInstance* pInstance_p);
+static void     expireTxBuffers(tEdrvInstance* pInstance_p);
+static UINT64   getMonotonicTimeMs(void);
+static void     completeTxBuffers(tEdrvInstance* pInstance_p,
+                                  UINT32 txId_p,
+                                  UINT64 timeStampNs_p);
 static void     getMacAdrs(const char* pIfName_p, UINT8* pMacAddr_p);
 static BOOL     getLinkStatus(const char* pIfName_p);
 
@@ -144,9 +180,9 @@ This function initializes the Ethernet driver.
 //------------------------------------------------------------------------------
 tOplkError edrv_init(const tEdrvInitParam* pEdrvInitParam_p)
 {
-    struct sched_param  schedParam;
     int                 result = 0;
     int                 sock_qdisc_bypass = 1;
+    int                 ignoreOutgoing = 1;
     struct sockaddr_ll  sock_addr;
     struct ifreq        ifr;
     int                 blockingMode = 0;
@@ -228,6 +264,14 @@ tOplkError edrv_init(const tEdrvInitParam* pEdrvInitParam_p)
         result = -1;
         DEBUG_LVL_ERROR_TRACE("%s() ioctl(SIOCGIFINDEX) fails. Error = %s\n", __func__, strerror(errno));
     }
+
+    // Own frames are not needed for Tx completion. Available since linux 4.20
+    if (setsockopt(edrvInstance_l.sock, SOL_PACKET, PACKET_IGNORE_OUTGOING, &ignoreOutgoing, sizeof(ignoreOutgoing)) != 0)
+    {
+        DEBUG_LVL_EDRV_TRACE("Couldn't set PACKET_IGNORE_OUTGOING socket option. Error = %s\n", strerror(errno));
+    }
+
+    setupTxTimestamping(&edrvInstance_l);
     sock_addr.sll_ifindex = ifr.ifr_ifindex;
 
 
@@ -240,6 +284,7 @@ tOplkError edrv_init(const tEdrvInitParam* pEdrvInitParam_p)
     }
     if (result < 0)
     {
+        restoreHwTimestamping(&edrvInstance_l);
         close(edrvInstance_l.sock);
         DEBUG_LVL_ERROR_TRACE("%s() Couldn't init ethernet adapter:%s", __func__, ifr.ifr_name);
         return kErrorEdrvInit;
@@ -258,16 +303,15 @@ tOplkError edrv_init(const tEdrvInitParam* pEdrvInitParam_p)
         return kErrorEdrvInit;
     }
 
-    schedParam.sched_priority = CONFIG_THREAD_PRIORITY_MEDIUM;
-    if (pthread_setschedparam(edrvInstance_l.hThread, SCHED_FIFO, &schedParam) != 0)
+    if (target_registerThread(kOplkThreadRoleEdrvRx,
+                              edrvInstance_l.hThread,
+                              kOplkThreadPolicyFifo,
+                              CONFIG_THREAD_PRIORITY_MEDIUM,
+                              "oplk-edrvrawsock") != kErrorOk)
     {
         DEBUG_LVL_ERROR_TRACE("%s() couldn't set thread scheduling parameters!\n", __func__);
     }
 
-#if (defined(__GLIBC__) && (__GLIBC__ >= 2) && (__GLIBC_MINOR__ >= 12))
-    pthread_setname_np(edrvInstance_l.hThread, "oplk-edrvrawsock");
-#endif
-
     // wait until thread is started
     sem_wait(&edrvInstance_l.syncSem);
 
@@ -287,6 +331,7 @@ This function shuts down the Ethernet driver.
 //------------------------------------------------------------------------------
 tOplkError edrv_exit(void)
 {
+    target_unregisterThread(kOplkThreadRoleEdrvRx, edrvInstance_l.hThread);
     edrvInstance_l.fStartCommunication = FALSE;
 
     // Wait to terminate thread safely
@@ -297,6 +342,8 @@ tOplkError edrv_exit(void)
 
     pthread_mutex_destroy(&edrvInstance_l.mutex);
 
+    restoreHwTimestamping(&edrvInstance_l);
+
     // Close the socket
     close(edrvInstance_l.sock);
 
@@ -337,7 +384,8 @@ This function sends the Tx buffer.
 //------------------------------------------------------------------------------
 tOplkError edrv_sendTxBuffer(tEdrvTxBuffer* pBuffer_p)
 {
-    int    sockRet;
+    int     sockRet;
+    UINT    slot;
 
     // Check parameter validity
     ASSERT(pBuffer_p != NULL);
@@ -356,30 +404,52 @@ tOplkError edrv_sendTxBuffer(tEdrvTxBuffer* pBuffer_p)
             pBuffer_p->pfnTxHandler(pBuffer_p);
         }
     }
-    else
+    else if (edrvInstance_l.fTxTimestamping)
     {
+        // The sequence number assigned by the kernel is the index of the frame
         pthread_mutex_lock(&edrvInstance_l.mutex);
-        if (edrvInstance_l.pTransmittedTxBufferLastEntry == NULL)
+        if ((edrvInstance_l.txIdNext - edrvInstance_l.txIdDone) >= EDRV_TX_PENDING_COUNT)
         {
-            edrvInstance_l.pTransmittedTxBufferLastEntry = pBuffer_p;
-            edrvInstance_l.pTransmittedTxBufferFirstEntry = pBuffer_p;
+            // Time stamps got lost, complete the oldest frame without time stamp
+            pthread_mutex_unlock(&edrvInstance_l.mutex);
+            DEBUG_LVL_EDRV_TRACE("%s() Tx completion is missing\n", __func__);
+            completeTxBuffers(&edrvInstance_l, edrvInstance_l.txIdDone, 0);
+            pthread_mutex_lock(&edrvInstance_l.mutex);
         }
-        else
+        slot = edrvInstance_l.txIdNext % EDRV_TX_PENDING_COUNT;
+        if (edrvInstance_l.apTxPending[slot] != NULL)
         {
-            edrvInstance_l.pTransmittedTxBufferLastEntry->txBufferNumber.pArg = pBuffer_p;
-            edrvInstance_l.pTransmittedTxBufferLastEntry = pBuffer_p;
+            pthread_mutex_unlock(&edrvInstance_l.mutex);
+            return kErrorEdrvNoFreeBufEntry;
         }
-        pthread_mutex_unlock(&edrvInstance_l.mutex);
 
         sockRet = send(edrvInstance_l.sock, (u_char*)pBuffer_p->pBuffer, (int)pBuffer_p->txFrameSize, 0);
         if (sockRet < 0)
         {
+            pthread_mutex_unlock(&edrvInstance_l.mutex);
             DEBUG_LVL_EDRV_TRACE("%s() send() returned %d\n", __func__, sockRet);
             return kErrorInvalidOperation;
         }
-        else
+
+        pBuffer_p->txBufferNumber.pArg = &edrvInstance_l;
+        edrvInstance_l.apTxPending[slot] = pBuffer_p;
+        edrvInstance_l.aTxPendingTimeMs[slot] = getMonotonicTimeMs();
+        edrvInstance_l.txIdNext++;
+        pthread_mutex_unlock(&edrvInstance_l.mutex);
+    }
+    else
+    {
+        sockRet = send(edrvInstance_l.sock, (u_char*)pBuffer_p->pBuffer, (int)pBuffer_p->txFrameSize, 0);
+        if (sockRet < 0)
         {
-            packetHandler((u_char*)&edrvInstance_l, sockRet, pBuffer_p->pBuffer);
+            DEBUG_LVL_EDRV_TRACE("%s() send() returned %d\n", __func__, sockRet);
+            return kErrorInvalidOperation;
+        }
+
+        pBuffer_p->txTimeStampNs = 0;
+        if (pBuffer_p->pfnTxHandler != NULL)
+        {
+            pBuffer_p->pfnTxHandler(pBuffer_p);
         }
     }
 
@@ -456,7 +526,9 @@ selects the Rx filter entry that shall be changed and \p changeFlags_p determine
 the property.
 If \p entryChanged_p is equal or larger count_p all Rx filters shall be changed.
 
-\note Rx filters are not supported by this driver!
+The Rx filter table is translated into a BPF program which is attached to the
+raw socket. Thus, frames which are not needed by the data link layer are
+already discarded by the kernel.
 
 \param[in,out]  pFilter_p           Base pointer of Rx filter array
 \param[in]      count_p             Number of Rx filter array entries
@@ -473,12 +545,16 @@ tOplkError edrv_changeRxFilter(tEdrvFilter* pFilter_p,
                                UINT entryChanged_p,
                                UINT changeFlags_p)
 {
-    UNUSED_PARAMETER(pFilter_p);
-    UNUSED_PARAMETER(count_p);
     UNUSED_PARAMETER(entryChanged_p);
     UNUSED_PARAMETER(changeFlags_p);
 
-    return kErrorOk;
+    // The program is regenerated from the whole filter table, so that the kernel
+    // can exchange the socket filter atomically.
+    return edrvbpf_updateSocketFilter(edrvInstance_l.sock,
+                                      pFilter_p,
+                                      count_p,
+                                      NULL,
+                                      &edrvInstance_l.rxFilterCache);
 }
 
 //------------------------------------------------------------------------------
@@ -559,63 +635,8 @@ static void packetHandler(void* pParam_p,
         pInstance->initParam.pfnRxHandler(&rxBuffer);
     }
     else
-    {   // self generated traffic
+    {   // self generated traffic, Tx completion is not derived from it
         FTRACE_MARKER("%s TX-receive", __func__);
-
-        if (pInstance->pTransmittedTxBufferFirstEntry != NULL)
-        {
-            tEdrvTxBuffer* pTxBuffer = pInstance->pTransmittedTxBufferFirstEntry;
-
-            if (pTxBuffer->pBuffer != NULL)
-            {
-                if (OPLK_MEMCMP(pPktData_p, pTxBuffer->pBuffer, 6) == 0)
-                {   // compare with packet buffer with destination MAC
-                    pthread_mutex_lock(&pInstance->mutex);
-                    pInstance->pTransmittedTxBufferFirstEntry = (tEdrvTxBuffer*)pInstance->pTransmittedTxBufferFirstEntry->txBufferNumber.pArg;
-                    if (pInstance->pTransmittedTxBufferFirstEntry == NULL)
-                    {
-                        pInstance->pTransmittedTxBufferLastEntry = NULL;
-                    }
-                    pthread_mutex_unlock(&pInstance->mutex);
-
-                    pTxBuffer->txBufferNumber.pArg = NULL;
-
-                    if (pTxBuffer->pfnTxHandler != NULL)
-                    {
-                        pTxBuffer->pfnTxHandler(pTxBuffer);
-                    }
-                }
-                else
-                {
-                    TRACE("%s: no matching TxB: DstMAC=%02X%02X%02X%02X%02X%02X\n",
-                          __func__,
-                          (UINT)((UINT8*)pPktData_p)[0],
-                          (UINT)((UINT8*)pPktData_p)[1],
-                          (UINT)((UINT8*)pPktData_p)[2],
-                          (UINT)((UINT8*)pPktData_p)[3],
-                          (UINT)((UINT8*)pPktData_p)[4],
-                          (UINT)((UINT8*)pPktData_p)[5]);
-                    TRACE("   current TxB %p: DstMAC=%02X%02X%02X%02X%02X%02X\n",
-                          (void*)pTxBuffer,
-                          (UINT)((UINT8*)(pTxBuffer->pBuffer))[0],
-                          (UINT)((UINT8*)(pTxBuffer->pBuffer))[1],
-                          (UINT)((UINT8*)(pTxBuffer->pBuffer))[2],
-                          (UINT)((UINT8*)(pTxBuffer->pBuffer))[3],
-                          (UINT)((UINT8*)(pTxBuffer->pBuffer))[4],
-                          (UINT)((UINT8*)(pTxBuffer->pBuffer))[5]);
-                }
-            }
-        }
-        else
-        {
-            TRACE("%s: no TxB: DstMAC=%02X%02X%02X%02X%02X%02X\n", __func__,
-                  ((UINT8*)pPktData_p)[0],
-                  ((UINT8*)pPktData_p)[1],
-                  ((UINT8*)pPktData_p)[2],
-                  ((UINT8*)pPktData_p)[3],
-                  ((UINT8*)pPktData_p)[4],
-                  ((UINT8*)pPktData_p)[5]);
-        }
     }
 }
 
@@ -624,6 +645,9 @@ static void packetHandler(void* pParam_p,
 \brief  Edrv worker thread
 
 This function implements the edrv worker thread. It is responsible to receive frames
+and to complete transmitted frames. While frames wait for their Tx time stamp,
+the thread wakes up every millisecond to complete frames whose time stamp got
+lost.
 
 \param[in,out]  pArgument_p         User specific pointer pointing to the instance structure
 
@@ -635,18 +659,38 @@ static void* workerThread(void* pArgument_p)
     tEdrvInstance*  pInstance = (tEdrvInstance*)pArgument_p;
     int             rawSockRet;
     u_char          aBuffer[EDRV_MAX_FRAME_SIZE];
+    struct pollfd   pollFd;
+    int             timeout;
 
     DEBUG_LVL_EDRV_TRACE("%s(): ThreadId:%ld\n", __func__, syscall(SYS_gettid));
 
+    pollFd.fd = pInstance->sock;
+    pollFd.events = POLLIN;
+
     // signal that thread is successfully started
     sem_post(&pInstance->syncSem);
 
     while (edrvInstance_l.fStartCommunication)
     {
-        rawSockRet = recvfrom(edrvInstance_l.sock, aBuffer, EDRV_MAX_FRAME_SIZE, 0, 0, 0);
-        if (rawSockRet > 0)
+        timeout = (pInstance->txIdNext != pInstance->txIdDone) ? 1 : EDRV_RX_POLL_TIMEOUT;
+
+        pollFd.revents = 0;
+        poll(&pollFd, 1, timeout);
+
+        if (pInstance->fTxTimestamping)
+            expireTxBuffers(pInstance);
+
+        // Tx time stamps are reported on the error queue
+        if ((pollFd.revents & POLLERR) != 0)
+            processTxCompletions(pInstance);
+
+        if ((pollFd.revents & POLLIN) != 0)
         {
-            packetHandler(pInstance, rawSockRet, aBuffer);
+            rawSockRet = recvfrom(pInstance->sock, aBuffer, EDRV_MAX_FRAME_SIZE, MSG_DONTWAIT, 0, 0);
+            if (rawSockRet > 0)
+            {
+                packetHandler(pInstance, rawSockRet, aBuffer);
+            }
         }
     }
     edrvInstance_l.fThreadIsExited = TRUE;
@@ -654,6 +698,296 @@ static void* workerThread(void* pArgument_p)
     return NULL;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Set up Tx time stamping
+
+This function enables transmit time stamps on the socket. Hardware time stamps
+are used if the network interface supports them. The current hardware
+configuration is read first, so that its Rx filter is kept and the original
+configuration can be restored on exit. Software time stamps are only requested
+if hardware time stamps are not available. If neither is available, Tx
+completion falls back to the point when the frame has been passed to the
+kernel.
+
+\param[in,out]  pInstance_p         Pointer to the instance structure
+*/
+//------------------------------------------------------------------------------
+static void setupTxTimestamping(tEdrvInstance* pInstance_p)
+{
+    struct hwtstamp_config  hwConfig;
+    struct ifreq            ifr;
+    int                     flags;
+    BOOL                    fHwTimestamping = FALSE;
+
+    OPLK_MEMSET(&ifr, 0, sizeof(ifr));
+    strncpy(ifr.ifr_name, pInstance_p->initParam.pDevName, IFNAMSIZ - 1);
+    ifr.ifr_data = (char*)&pInstance_p->hwConfigOrig;
+    if (ioctl(pInstance_p->sock, SIOCGHWTSTAMP, &ifr) == 0)
+    {
+        if (pInstance_p->hwConfigOrig.tx_type == HWTSTAMP_TX_ON)
+        {
+            fHwTimestamping = TRUE;
+        }
+        else
+        {
+            // Only enable Tx time stamps, the Rx filter may be used by others (e.g. PTP)
+            hwConfig = pInstance_p->hwConfigOrig;
+            hwConfig.tx_type = HWTSTAMP_TX_ON;
+            ifr.ifr_data = (char*)&hwConfig;
+            if (ioctl(pInstance_p->sock, SIOCSHWTSTAMP, &ifr) == 0)
+            {
+                fHwTimestamping = TRUE;
+                pInstance_p->fHwConfigChanged = TRUE;
+            }
+        }
+    }
+
+    if (fHwTimestamping)
+    {
+        flags = SOF_TIMESTAMPING_TX_HARDWARE | SOF_TIMESTAMPING_RAW_HARDWARE;
+        DEBUG_LVL_EDRV_TRACE("Hardware Tx time stamps are enabled\n");
+    }
+    else
+    {
+        flags = SOF_TIMESTAMPING_TX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE;
+        DEBUG_LVL_EDRV_TRACE("Software Tx time stamps are enabled\n");
+    }
+    flags |= SOF_TIMESTAMPING_OPT_ID | SOF_TIMESTAMPING_OPT_TSONLY;
+
+    if (setsockopt(pInstance_p->sock, SOL_SOCKET, SO_TIMESTAMPING, &flags, sizeof(flags)) != 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() Couldn't enable Tx time stamps, Tx completion is not confirmed. Error = %s\n",
+                              __func__,
+                              strerror(errno));
+        restoreHwTimestamping(pInstance_p);
+        pInstance_p->fTxTimestamping = FALSE;
+        return;
+    }
+
+    pInstance_p->fTxTimestamping = TRUE;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Restore hardware time stamping configuration
+
+This function restores the hardware time stamping configuration the interface
+had before setupTxTimestamping() changed it.
+
+\param[in,out]  pInstance_p         Pointer to the instance structure
+*/
+//------------------------------------------------------------------------------
+static void restoreHwTimestamping(tEdrvInstance* pInstance_p)
+{
+    struct ifreq    ifr;
+
+    if (!pInstance_p->fHwConfigChanged)
+        return;
+
+    OPLK_MEMSET(&ifr, 0, sizeof(ifr));
+    strncpy(ifr.ifr_name, pInstance_p->initParam.pDevName, IFNAMSIZ - 1);
+    ifr.ifr_data = (char*)&pInstance_p->hwConfigOrig;
+    if (ioctl(pInstance_p->sock, SIOCSHWTSTAMP, &ifr) != 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() Couldn't restore hardware time stamping. Error = %s\n",
+                              __func__,
+                              strerror(errno));
+    }
+
+    pInstance_p->fHwConfigChanged = FALSE;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Process Tx completions
+
+This function reads all Tx time stamps from the error queue of the socket and
+completes the according Tx buffers. The kernel's sequence number is taken from
+the error queue message (SOF_TIMESTAMPING_OPT_ID). If the kernel counted a
+frame which the driver didn't (e.g. a failed send() which already consumed a
+number), the driver's numbering is resynchronized to the kernel's.
+
+\param[in,out]  pInstance_p         Pointer to the instance structure
+*/
+//------------------------------------------------------------------------------
+static void processTxCompletions(tEdrvInstance* pInstance_p)
+{
+    struct msghdr               msg;
+    struct cmsghdr*             pCmsg;
+    const struct sock_extended_err* pExtErr;
+    const struct scm_timestamping*  pTimeStamps;
+    UINT8                       aControl[256];
+    UINT64                      timeStampNs;
+    UINT32                      txId;
+    BOOL                        fTxIdValid;
+
+    for (;;)
+    {
+        OPLK_MEMSET(&msg, 0, sizeof(msg));
+        msg.msg_control = aControl;
+        msg.msg_controllen = sizeof(aControl);
+
+        if (recvmsg(pInstance_p->sock, &msg, MSG_ERRQUEUE | MSG_DONTWAIT) < 0)
+            break;
+
+        timeStampNs = 0;
+        txId = 0;
+        fTxIdValid = FALSE;
+
+        for (pCmsg = CMSG_FIRSTHDR(&msg); pCmsg != NULL; pCmsg = CMSG_NXTHDR(&msg, pCmsg))
+        {
+            if ((pCmsg->cmsg_level == SOL_SOCKET) && (pCmsg->cmsg_type == SCM_TIMESTAMPING))
+            {
+                pTimeStamps = (const struct scm_timestamping*)CMSG_DATA(pCmsg);
+
+                // Index 2 holds the hardware, index 0 the software time stamp
+                if ((pTimeStamps->ts[2].tv_sec != 0) || (pTimeStamps->ts[2].tv_nsec != 0))
+                {
+                    timeStampNs = ((UINT64)pTimeStamps->ts[2].tv_sec * 1000000000ULL) +
+                                  (UINT64)pTimeStamps->ts[2].tv_nsec;
+                }
+                else
+                {
+                    timeStampNs = ((UINT64)pTimeStamps->ts[0].tv_sec * 1000000000ULL) +
+                                  (UINT64)pTimeStamps->ts[0].tv_nsec;
+                }
+            }
+            else if ((pCmsg->cmsg_level == SOL_PACKET) && (pCmsg->cmsg_type == PACKET_TX_TIMESTAMP))
+            {
+                pExtErr = (const struct sock_extended_err*)CMSG_DATA(pCmsg);
+                if ((pExtErr->ee_errno == ENOMSG) &&
+                    (pExtErr->ee_origin == SO_EE_ORIGIN_TIMESTAMPING))
+                {
+                    txId = pExtErr->ee_data;
+                    fTxIdValid = TRUE;
+                }
+            }
+        }
+
+        if (fTxIdValid)
+        {
+            txId -= pInstance_p->txIdKernelOffset;
+
+            pthread_mutex_lock(&pInstance_p->mutex);
+            if ((INT32)(txId - (pInstance_p->txIdNext - 1)) > 0)
+            {   // The time stamp belongs to the last frame sent
+                DEBUG_LVL_EDRV_TRACE("%s() Tx sequence number resynchronized by %u\n",
+                                     __func__,
+                                     txId - (pInstance_p->txIdNext - 1));
+                pInstance_p->txIdKernelOffset += txId - (pInstance_p->txIdNext - 1);
+                txId = pInstance_p->txIdNext - 1;
+            }
+            pthread_mutex_unlock(&pInstance_p->mutex);
+
+            completeTxBuffers(pInstance_p, txId, timeStampNs);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Expire Tx buffers
+
+This function completes all frames without time stamp which wait longer than
+\ref EDRV_TX_STAMP_TIMEOUT for their Tx time stamp.
+
+\param[in,out]  pInstance_p         Pointer to the instance structure
+*/
+//------------------------------------------------------------------------------
+static void expireTxBuffers(tEdrvInstance* pInstance_p)
+{
+    UINT64  now = getMonotonicTimeMs();
+    UINT32  txId;
+    BOOL    fExpired;
+
+    for (;;)
+    {
+        pthread_mutex_lock(&pInstance_p->mutex);
+        txId = pInstance_p->txIdDone;
+        fExpired = (txId != pInstance_p->txIdNext) &&
+                   ((now - pInstance_p->aTxPendingTimeMs[txId % EDRV_TX_PENDING_COUNT]) >= EDRV_TX_STAMP_TIMEOUT);
+        pthread_mutex_unlock(&pInstance_p->mutex);
+
+        if (!fExpired)
+            break;
+
+        DEBUG_LVL_EDRV_TRACE("%s() Tx time stamp of frame %u is lost\n", __func__, txId);
+        completeTxBuffers(pInstance_p, txId, 0);
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Complete Tx buffers
+
+This function completes the Tx buffer with the given sequence number. Frames
+are sent in order, so older frames without a time stamp are completed as well.
+Time stamps of already completed frames (e.g. a second time stamp of the same
+frame) are ignored.
+
+\param[in,out]  pInstance_p         Pointer to the instance structure
+\param[in]      txId_p              Sequence number of the transmitted frame
+\param[in]      timeStampNs_p       Tx time stamp of the frame [ns]
+*/
+//------------------------------------------------------------------------------
+static void completeTxBuffers(tEdrvInstance* pInstance_p,
+                              UINT32 txId_p,
+                              UINT64 timeStampNs_p)
+{
+    tEdrvTxBuffer*  pTxBuffer;
+    UINT32          txId;
+    UINT            slot;
+
+    for (;;)
+    {
+        pthread_mutex_lock(&pInstance_p->mutex);
+        txId = pInstance_p->txIdDone;
+        if ((txId == pInstance_p->txIdNext) || ((INT32)(txId_p - txId) < 0))
+        {
+            pthread_mutex_unlock(&pInstance_p->mutex);
+            break;
+        }
+
+        slot = txId % EDRV_TX_PENDING_COUNT;
+        pTxBuffer = pInstance_p->apTxPending[slot];
+        pInstance_p->apTxPending[slot] = NULL;
+        pInstance_p->txIdDone++;
+        pthread_mutex_unlock(&pInstance_p->mutex);
+
+        if (pTxBuffer == NULL)
+            continue;
+
+        FTRACE_MARKER("%s TX-complete", __func__);
+
+        pTxBuffer->txBufferNumber.pArg = NULL;
+        pTxBuffer->txTimeStampNs = (txId == txId_p) ? timeStampNs_p : 0;
+
+        if (pTxBuffer->pfnTxHandler != NULL)
+        {
+            pTxBuffer->pfnTxHandler(pTxBuffer);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get monotonic time
+
+This function returns the current time of the monotonic clock.
+
+\return The function returns the time in milliseconds.
+*/
+//------------------------------------------------------------------------------
+static UINT64 getMonotonicTimeMs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((UINT64)ts.tv_sec * 1000ULL) + ((UINT64)ts.tv_nsec / 1000000ULL);
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  Get Edrv MAC address
@@ -0,0 +1,1018 @@
+/**
+********************************************************************************
+\file   edrv-rawsockmmap_linux.c
+
+\brief  Implementation of Linux raw socket Ethernet driver using PACKET_MMAP
+
+This file contains the implementation of the Linux raw socket Ethernet driver
+which uses memory mapped receive and transmit rings (PACKET_RX_RING and
+PACKET_TX_RING) instead of one system call per frame.
+
+Received frames are passed to the DLL directly from the receive ring. After
+a wakeup, all frames available in the ring are processed before the driver
+waits again. Frames to be transmitted are copied into the transmit ring and
+the kernel is notified with a non-blocking send() call. Frames queued between
+edrv_beginTxBatch() and edrv_endTxBatch() share a single send() call. The link
+state is polled by the worker thread, so the transmit path needs no ioctl.
+
+\ingroup module_edrv
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2017, BE.services GmbH
+Copyright (c) 2017, B&R Industrial Automation GmbH
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <common/oplkinc.h>
+#include <common/target.h>
+#include <common/ftracedebug.h>
+#include <kernel/edrv.h>
+#include <kernel/edrvbpf.h>
+
+#include <unistd.h>
+#include <string.h>
+#include <semaphore.h>
+#include <pthread.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <sys/syscall.h>
+#include <sys/socket.h>
+#include <sys/ioctl.h>
+#include <netinet/in.h>
+#include <net/if.h>
+#include <errno.h>
+#include <arpa/inet.h>
+#include <linux/if_packet.h>
+#include <sys/types.h>
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define EDRV_MAX_FRAME_SIZE     0x0600
+#define PROTO_PLK               0x88AB
+#ifndef PACKET_QDISC_BYPASS
+#define PACKET_QDISC_BYPASS     20
+#endif
+
+#define EDRV_RING_FRAME_SIZE    2048        ///< Size of a ring slot (header and frame)
+#define EDRV_RX_RING_FRAMES     256         ///< Number of slots in the receive ring
+#define EDRV_TX_RING_FRAMES     64          ///< Number of slots in the transmit ring
+#define EDRV_RX_POLL_TIMEOUT    100         ///< Receive poll timeout [ms] for checking the thread exit condition
+#define EDRV_LINK_POLL_INTERVAL 100         ///< Interval [ms] for refreshing the cached link state
+
+// Offset of the frame data in a Tx ring slot
+#define EDRV_TX_DATA_OFFSET     (TPACKET2_HDRLEN - sizeof(struct sockaddr_ll))
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+/**
+\brief Structure describing a memory mapped packet ring
+
+This structure describes a receive or transmit ring shared with the kernel.
+*/
+typedef struct
+{
+    UINT8*              pBase;                           ///< Start address of the ring
+    UINT                frameCount;                      ///< Number of slots in the ring
+    UINT                index;                           ///< Index of the next slot to be used
+} tEdrvRing;
+
+/**
+\brief Structure describing an instance of the Edrv
+
+This structure describes an instance of the Ethernet driver.
+*/
+typedef struct
+{
+    tEdrvInitParam      initParam;                       ///< Init parameters
+    tEdrvTxBuffer*      pTransmittedTxBufferLastEntry;   ///< Pointer to the last entry of the transmitted TX buffer
+    tEdrvTxBuffer*      pTransmittedTxBufferFirstEntry;  ///< Pointer to the first entry of the transmitted Tx buffer
+    pthread_mutex_t     mutex;                           ///< Mutex for locking of critical sections
+    sem_t               syncSem;                         ///< Semaphore for signaling the start of the worker thread
+    int                 sock;                            ///< Raw socket handle
+    tEdrvBpfFilterCache rxFilterCache;                   ///< Rx filter table and BPF program attached to the socket
+    void*               pRingMem;                        ///< Memory mapped area containing the Rx and Tx ring
+    size_t              ringMemSize;                     ///< Size of the memory mapped area
+    tEdrvRing           rxRing;                          ///< Receive ring
+    tEdrvRing           txRing;                          ///< Transmit ring
+    pthread_t           hThread;                         ///< Handle of the worker thread
+    volatile BOOL       fLinkUp;                         ///< Cached link state, refreshed by the worker thread
+    BOOL                fTxBatchActive;                  ///< Flag to indicate, that Tx frames are collected for a single kick
+    UINT                txBatchCount;                    ///< Number of frames queued in the current Tx batch
+    tEdrvTxBuffer*      apTxBatch[EDRV_TX_RING_FRAMES];  ///< Frames queued in the current Tx batch
+    BOOL                fStartCommunication;             ///< Flag to indicate, that communication is started. Set to false on exit
+    BOOL                fThreadIsExited;                 ///< Set by thread if already exited
+} tEdrvInstance;
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static tEdrvInstance edrvInstance_l;
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static void     packetHandler(void* pParam_p,
+                              const int frameSize_p,
+                              void* pPktData_p);
+static void*    workerThread(void* pArgument_p);
+static int      setupRings(tEdrvInstance* pInstance_p);
+static void     freeRings(tEdrvInstance* pInstance_p);
+static void     getMacAdrs(const char* pIfName_p, UINT8* pMacAddr_p);
+static BOOL     getLinkStatus(const char* pIfName_p);
+static UINT64   getMonotonicTimeMs(void);
+static tOplkError kickTxRing(void);
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Ethernet driver initialization
+
+This function initializes the Ethernet driver.
+
+\param[in]      pEdrvInitParam_p    Edrv initialization parameters
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tOplkError edrv_init(const tEdrvInitParam* pEdrvInitParam_p)
+{
+    int                 result = 0;
+    int                 sock_qdisc_bypass = 1;
+    struct sockaddr_ll  sock_addr;
+    struct ifreq        ifr;
+
+    // Check parameter validity
+    ASSERT(pEdrvInitParam_p != NULL);
+
+    // Clear instance structure
+    OPLK_MEMSET(&edrvInstance_l, 0, sizeof(edrvInstance_l));
+
+    if (pEdrvInitParam_p->pDevName == NULL)
+        return kErrorEdrvInit;
+
+    // Save the init data
+    edrvInstance_l.initParam = *pEdrvInitParam_p;
+
+    edrvInstance_l.fStartCommunication = TRUE;
+    edrvInstance_l.fThreadIsExited = FALSE;
+
+    // If no MAC address was specified read MAC address of used
+    // Ethernet interface
+    if ((edrvInstance_l.initParam.aMacAddr[0] == 0) &&
+        (edrvInstance_l.initParam.aMacAddr[1] == 0) &&
+        (edrvInstance_l.initParam.aMacAddr[2] == 0) &&
+        (edrvInstance_l.initParam.aMacAddr[3] == 0) &&
+        (edrvInstance_l.initParam.aMacAddr[4] == 0) &&
+        (edrvInstance_l.initParam.aMacAddr[5] == 0))
+    {   // read MAC address from controller
+        getMacAdrs(edrvInstance_l.initParam.pDevName,
+                   edrvInstance_l.initParam.aMacAddr);
+    }
+    if (pthread_mutex_init(&edrvInstance_l.mutex, NULL) != 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() couldn't init mutex\n", __func__);
+        return kErrorEdrvInit;
+    }
+
+    edrvInstance_l.sock = socket(PF_PACKET, SOCK_RAW, htons(PROTO_PLK));
+    if (edrvInstance_l.sock < 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() cannot open socket. Error = %s\n", __func__, strerror(errno));
+        return kErrorEdrvInit;
+    }
+
+    // Set option PACKET_QDISC_BYPASS. It allows to transmit a frame faster through network stack. Available since linux 3.14
+    if (setsockopt(edrvInstance_l.sock, SOL_PACKET, PACKET_QDISC_BYPASS, &sock_qdisc_bypass, sizeof(sock_qdisc_bypass)) != 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() Couldn't set PACKET_QDISC_BYPASS socket option. Error = %s\n", __func__, strerror(errno));
+    }
+    else
+    {
+        DEBUG_LVL_EDRV_TRACE("Kernel qdisc bypass is enabled\n");
+    }
+
+    // The rings must be set up before the socket is bound
+    if (setupRings(&edrvInstance_l) != 0)
+        result = -1;
+
+    OPLK_MEMSET(&ifr, 0, sizeof(struct ifreq));
+    strncpy(ifr.ifr_name, edrvInstance_l.initParam.pDevName, IFNAMSIZ - 1);
+
+    if (ioctl(edrvInstance_l.sock, SIOCGIFFLAGS, &ifr) < 0)
+    {
+        result = -1;
+        DEBUG_LVL_ERROR_TRACE("%s() ioctl(SIOCGIFFLAGS) fails. Error = %s\n", __func__, strerror(errno));
+    }
+
+    ifr.ifr_flags = ifr.ifr_flags | IFF_PROMISC;
+    if (ioctl(edrvInstance_l.sock, SIOCSIFFLAGS, &ifr))
+    {
+        result = -1;
+        DEBUG_LVL_ERROR_TRACE("%s() ioctl(SIOCSIFFLAGS) with IFF_PROMISC fails. Error = %s\n", __func__, strerror(errno));
+    }
+
+    if (ioctl(edrvInstance_l.sock, SIOCGIFINDEX, &ifr) != 0)
+    {
+        result = -1;
+        DEBUG_LVL_ERROR_TRACE("%s() ioctl(SIOCGIFINDEX) fails. Error = %s\n", __func__, strerror(errno));
+    }
+
+    OPLK_MEMSET(&sock_addr, 0, sizeof(sock_addr));
+    sock_addr.sll_ifindex = ifr.ifr_ifindex;
+    sock_addr.sll_family = AF_PACKET;
+    sock_addr.sll_protocol = htons(PROTO_PLK);
+    if (bind(edrvInstance_l.sock, (struct sockaddr*)&sock_addr, sizeof(sock_addr)) != 0)
+    {
+        result = -1;
+        DEBUG_LVL_ERROR_TRACE("%s() bind fails. Error = %s\n", __func__, strerror(errno));
+    }
+    if (result < 0)
+    {
+        freeRings(&edrvInstance_l);
+        close(edrvInstance_l.sock);
+        DEBUG_LVL_ERROR_TRACE("%s() Couldn't init ethernet adapter:%s", __func__, ifr.ifr_name);
+        return kErrorEdrvInit;
+    }
+
+    // The worker thread keeps the link state up to date from now on
+    edrvInstance_l.fLinkUp = getLinkStatus(edrvInstance_l.initParam.pDevName);
+
+    if (sem_init(&edrvInstance_l.syncSem, 0, 0) != 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() couldn't init semaphore\n", __func__);
+        return kErrorEdrvInit;
+    }
+
+    if (pthread_create(&edrvInstance_l.hThread, NULL,
+                       workerThread, &edrvInstance_l) != 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() Couldn't create worker thread!\n", __func__);
+        return kErrorEdrvInit;
+    }
+
+    if (target_registerThread(kOplkThreadRoleEdrvRx,
+                              edrvInstance_l.hThread,
+                              kOplkThreadPolicyFifo,
+                              CONFIG_THREAD_PRIORITY_MEDIUM,
+                              "oplk-edrvmmap") != kErrorOk)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() couldn't set thread scheduling parameters!\n", __func__);
+    }
+
+    // wait until thread is started
+    sem_wait(&edrvInstance_l.syncSem);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Shut down Ethernet driver
+
+This function shuts down the Ethernet driver.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tOplkError edrv_exit(void)
+{
+    edrvInstance_l.fStartCommunication = FALSE;
+
+    target_unregisterThread(kOplkThreadRoleEdrvRx, edrvInstance_l.hThread);
+
+    // Wait to terminate thread safely
+    usleep(100000);
+
+    if (!edrvInstance_l.fThreadIsExited)
+        pthread_cancel(edrvInstance_l.hThread);
+
+    pthread_join(edrvInstance_l.hThread, NULL);
+
+    pthread_mutex_destroy(&edrvInstance_l.mutex);
+
+    // Release the rings and close the socket
+    freeRings(&edrvInstance_l);
+    close(edrvInstance_l.sock);
+
+    // Clear instance structure
+    OPLK_MEMSET(&edrvInstance_l, 0, sizeof(edrvInstance_l));
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get MAC address
+
+This function returns the MAC address of the Ethernet controller
+
+\return The function returns a pointer to the MAC address.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+const UINT8* edrv_getMacAddr(void)
+{
+    return edrvInstance_l.initParam.aMacAddr;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Send Tx buffer
+
+This function sends the Tx buffer. The frame is copied into the next slot of
+the transmit ring and the kernel is triggered to send it. If a Tx batch is
+active, the kernel is triggered by edrv_endTxBatch() instead.
+
+\param[in,out]  pBuffer_p           Tx buffer descriptor
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tOplkError edrv_sendTxBuffer(tEdrvTxBuffer* pBuffer_p)
+{
+    volatile struct tpacket2_hdr*   pHdr;
+    tEdrvRing*                      pTxRing = &edrvInstance_l.txRing;
+    tOplkError                      ret;
+
+    // Check parameter validity
+    ASSERT(pBuffer_p != NULL);
+
+    FTRACE_MARKER("%s", __func__);
+
+    if (pBuffer_p->txBufferNumber.pArg != NULL)
+        return kErrorInvalidOperation;
+
+    if (!edrvInstance_l.fLinkUp)
+    {
+        /* If there is no link, we pretend that the packet is sent and immediately call
+         * tx handler. Otherwise the stack would hang! */
+        if (pBuffer_p->pfnTxHandler != NULL)
+        {
+            pBuffer_p->pfnTxHandler(pBuffer_p);
+        }
+    }
+    else
+    {
+        pthread_mutex_lock(&edrvInstance_l.mutex);
+
+        pHdr = (volatile struct tpacket2_hdr*)(pTxRing->pBase + (pTxRing->index * EDRV_RING_FRAME_SIZE));
+        if ((pHdr->tp_status != TP_STATUS_AVAILABLE) &&
+            (pHdr->tp_status != TP_STATUS_WRONG_FORMAT))
+        {
+            pthread_mutex_unlock(&edrvInstance_l.mutex);
+            DEBUG_LVL_EDRV_TRACE("%s() Tx ring is full\n", __func__);
+            return kErrorEdrvNoFreeBufEntry;
+        }
+
+        OPLK_MEMCPY((UINT8*)pHdr + EDRV_TX_DATA_OFFSET, pBuffer_p->pBuffer, pBuffer_p->txFrameSize);
+        pHdr->tp_len = (UINT32)pBuffer_p->txFrameSize;
+
+        // The frame data must be visible before the slot is handed to the kernel
+        OPLK_MEMBAR();
+        pHdr->tp_status = TP_STATUS_SEND_REQUEST;
+        pTxRing->index = (pTxRing->index + 1) % pTxRing->frameCount;
+
+        if (edrvInstance_l.pTransmittedTxBufferLastEntry == NULL)
+        {
+            edrvInstance_l.pTransmittedTxBufferLastEntry = pBuffer_p;
+            edrvInstance_l.pTransmittedTxBufferFirstEntry = pBuffer_p;
+        }
+        else
+        {
+            edrvInstance_l.pTransmittedTxBufferLastEntry->txBufferNumber.pArg = pBuffer_p;
+            edrvInstance_l.pTransmittedTxBufferLastEntry = pBuffer_p;
+        }
+        pthread_mutex_unlock(&edrvInstance_l.mutex);
+
+        if (edrvInstance_l.fTxBatchActive &&
+            (edrvInstance_l.txBatchCount < EDRV_TX_RING_FRAMES))
+        {   // The kernel is triggered once at the end of the batch
+            edrvInstance_l.apTxBatch[edrvInstance_l.txBatchCount] = pBuffer_p;
+            edrvInstance_l.txBatchCount++;
+            return kErrorOk;
+        }
+
+        // Trigger transmission of all pending slots without waiting for completion
+        ret = kickTxRing();
+        if (ret != kErrorOk)
+            return ret;
+
+        packetHandler((u_char*)&edrvInstance_l, (int)pBuffer_p->txFrameSize, pBuffer_p->pBuffer);
+    }
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Begin Tx batch
+
+This function starts collecting Tx frames. Frames passed to edrv_sendTxBuffer()
+are only queued in the transmit ring until edrv_endTxBatch() is called.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tOplkError edrv_beginTxBatch(void)
+{
+    edrvInstance_l.txBatchCount = 0;
+    edrvInstance_l.fTxBatchActive = TRUE;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  End Tx batch
+
+This function triggers the transmission of all frames queued since
+edrv_beginTxBatch() with a single send() call and completes their Tx buffers.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tOplkError edrv_endTxBatch(void)
+{
+    tOplkError      ret = kErrorOk;
+    tEdrvTxBuffer*  pTxBuffer;
+    UINT            index;
+
+    edrvInstance_l.fTxBatchActive = FALSE;
+
+    if (edrvInstance_l.txBatchCount == 0)
+        return kErrorOk;
+
+    ret = kickTxRing();
+    if (ret == kErrorOk)
+    {
+        for (index = 0; index < edrvInstance_l.txBatchCount; index++)
+        {
+            pTxBuffer = edrvInstance_l.apTxBatch[index];
+            packetHandler((u_char*)&edrvInstance_l, (int)pTxBuffer->txFrameSize, pTxBuffer->pBuffer);
+        }
+    }
+
+    edrvInstance_l.txBatchCount = 0;
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Allocate Tx buffer
+
+This function allocates a Tx buffer.
+
+\param[in,out]  pBuffer_p           Tx buffer descriptor
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tOplkError edrv_allocTxBuffer(tEdrvTxBuffer* pBuffer_p)
+{
+    // Check parameter validity
+    ASSERT(pBuffer_p != NULL);
+
+    if (pBuffer_p->maxBufferSize > EDRV_MAX_FRAME_SIZE)
+        return kErrorEdrvNoFreeBufEntry;
+
+    // allocate buffer with malloc
+    pBuffer_p->pBuffer = OPLK_MALLOC(pBuffer_p->maxBufferSize);
+    if (pBuffer_p->pBuffer == NULL)
+        return kErrorEdrvNoFreeBufEntry;
+
+    pBuffer_p->txBufferNumber.pArg = NULL;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Free Tx buffer
+
+This function releases the Tx buffer.
+
+\param[in,out]  pBuffer_p           Tx buffer descriptor
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tOplkError edrv_freeTxBuffer(tEdrvTxBuffer* pBuffer_p)
+{
+    void*   pBuffer;
+
+    // Check parameter validity
+    ASSERT(pBuffer_p != NULL);
+
+    pBuffer = pBuffer_p->pBuffer;
+
+    // mark buffer as free, before actually freeing it
+    pBuffer_p->pBuffer = NULL;
+
+    OPLK_FREE(pBuffer);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Change Rx filter setup
+
+This function changes the Rx filter setup. The parameter entryChanged_p
+selects the Rx filter entry that shall be changed and \p changeFlags_p determines
+the property.
+If \p entryChanged_p is equal or larger count_p all Rx filters shall be changed.
+
+The Rx filter table is translated into a BPF program which is attached to the
+raw socket. Thus, frames which are not needed by the data link layer are
+already discarded by the kernel.
+
+\param[in,out]  pFilter_p           Base pointer of Rx filter array
+\param[in]      count_p             Number of Rx filter array entries
+\param[in]      entryChanged_p      Index of Rx filter entry that shall be changed
+\param[in]      changeFlags_p       Bit mask that selects the changing Rx filter property
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tOplkError edrv_changeRxFilter(tEdrvFilter* pFilter_p,
+                               UINT count_p,
+                               UINT entryChanged_p,
+                               UINT changeFlags_p)
+{
+    UNUSED_PARAMETER(entryChanged_p);
+    UNUSED_PARAMETER(changeFlags_p);
+
+    // The program is regenerated from the whole filter table, so that the kernel
+    // can exchange the socket filter atomically. Own frames are not needed,
+    // the Tx completion is signaled right after the transmit ring is kicked.
+    return edrvbpf_updateSocketFilter(edrvInstance_l.sock,
+                                      pFilter_p,
+                                      count_p,
+                                      NULL,
+                                      &edrvInstance_l.rxFilterCache);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Clear multicast address entry
+
+This function removes the multicast entry from the Ethernet controller.
+
+\note The multicast filters are not supported by this driver.
+
+\param[in]      pMacAddr_p          Multicast address
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tOplkError edrv_clearRxMulticastMacAddr(const UINT8* pMacAddr_p)
+{
+    UNUSED_PARAMETER(pMacAddr_p);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Set multicast address entry
+
+This function sets a multicast entry into the Ethernet controller.
+
+\note The multicast filters are not supported by this driver.
+
+\param[in]      pMacAddr_p          Multicast address.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tOplkError edrv_setRxMulticastMacAddr(const UINT8* pMacAddr_p)
+{
+    UNUSED_PARAMETER(pMacAddr_p);
+
+    return kErrorOk;
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Edrv packet handler
+
+This function is the packet handler forwarding the frames to the dllk.
+
+\param[in,out]  pParam_p            User specific pointer pointing to the instance structure
+\param[in]      frameSize_p         Framesize information
+\param[in]      pPktData_p          Packet buffer
+*/
+//------------------------------------------------------------------------------
+static void packetHandler(void* pParam_p,
+                          const int frameSize_p,
+                          void* pPktData_p)
+{
+    tEdrvInstance*  pInstance = (tEdrvInstance*)pParam_p;
+    tEdrvRxBuffer   rxBuffer;
+
+    if (OPLK_MEMCMP((UINT8*)pPktData_p + 6, pInstance->initParam.aMacAddr, 6) != 0)
+    {   // filter out self generated traffic
+        rxBuffer.bufferInFrame = kEdrvBufferLastInFrame;
+        rxBuffer.rxFrameSize = frameSize_p;
+        rxBuffer.pBuffer = pPktData_p;
+
+        FTRACE_MARKER("%s RX", __func__);
+        pInstance->initParam.pfnRxHandler(&rxBuffer);
+    }
+    else
+    {   // self generated traffic
+        FTRACE_MARKER("%s TX-receive", __func__);
+
+        if (pInstance->pTransmittedTxBufferFirstEntry != NULL)
+        {
+            tEdrvTxBuffer* pTxBuffer = pInstance->pTransmittedTxBufferFirstEntry;
+
+            if (pTxBuffer->pBuffer != NULL)
+            {
+                if (OPLK_MEMCMP(pPktData_p, pTxBuffer->pBuffer, 6) == 0)
+                {   // compare with packet buffer with destination MAC
+                    pthread_mutex_lock(&pInstance->mutex);
+                    pInstance->pTransmittedTxBufferFirstEntry = (tEdrvTxBuffer*)pInstance->pTransmittedTxBufferFirstEntry->txBufferNumber.pArg;
+                    if (pInstance->pTransmittedTxBufferFirstEntry == NULL)
+                    {
+                        pInstance->pTransmittedTxBufferLastEntry = NULL;
+                    }
+                    pthread_mutex_unlock(&pInstance->mutex);
+
+                    pTxBuffer->txBufferNumber.pArg = NULL;
+
+                    if (pTxBuffer->pfnTxHandler != NULL)
+                    {
+                        pTxBuffer->pfnTxHandler(pTxBuffer);
+                    }
+                }
+                else
+                {
+                    TRACE("%s: no matching TxB: DstMAC=%02X%02X%02X%02X%02X%02X\n",
+                          __func__,
+                          (UINT)((UINT8*)pPktData_p)[0],
+                          (UINT)((UINT8*)pPktData_p)[1],
+                          (UINT)((UINT8*)pPktData_p)[2],
+                          (UINT)((UINT8*)pPktData_p)[3],
+                          (UINT)((UINT8*)pPktData_p)[4],
+                          (UINT)((UINT8*)pPktData_p)[5]);
+                    TRACE("   current TxB %p: DstMAC=%02X%02X%02X%02X%02X%02X\n",
+                          (void*)pTxBuffer,
+                          (UINT)((UINT8*)(pTxBuffer->pBuffer))[0],
+                          (UINT)((UINT8*)(pTxBuffer->pBuffer))[1],
+                          (UINT)((UINT8*)(pTxBuffer->pBuffer))[2],
+                          (UINT)((UINT8*)(pTxBuffer->pBuffer))[3],
+                          (UINT)((UINT8*)(pTxBuffer->pBuffer))[4],
+                          (UINT)((UINT8*)(pTxBuffer->pBuffer))[5]);
+                }
+            }
+        }
+        else
+        {
+            TRACE("%s: no TxB: DstMAC=%02X%02X%02X%02X%02X%02X\n", __func__,
+                  ((UINT8*)pPktData_p)[0],
+                  ((UINT8*)pPktData_p)[1],
+                  ((UINT8*)pPktData_p)[2],
+                  ((UINT8*)pPktData_p)[3],
+                  ((UINT8*)pPktData_p)[4],
+                  ((UINT8*)pPktData_p)[5]);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Edrv worker thread
+
+This function implements the edrv worker thread. It is responsible to receive
+frames. All frames available in the receive ring are handed to the dllk
+directly from the ring before the thread waits for new frames. The thread also
+refreshes the cached link state every \ref EDRV_LINK_POLL_INTERVAL ms.
+
+\param[in,out]  pArgument_p         User specific pointer pointing to the instance structure
+
+\return The function returns a thread error code.
+*/
+//------------------------------------------------------------------------------
+static void* workerThread(void* pArgument_p)
+{
+    tEdrvInstance*                  pInstance = (tEdrvInstance*)pArgument_p;
+    tEdrvRing*                      pRxRing = &pInstance->rxRing;
+    volatile struct tpacket2_hdr*   pHdr;
+    struct pollfd                   pollFd;
+    UINT64                          nextLinkPoll = 0;
+    UINT64                          now;
+
+    DEBUG_LVL_EDRV_TRACE("%s(): ThreadId:%ld\n", __func__, syscall(SYS_gettid));
+
+    pollFd.fd = pInstance->sock;
+    pollFd.events = POLLIN | POLLERR;
+
+    // signal that thread is successfully started
+    sem_post(&pInstance->syncSem);
+
+    while (pInstance->fStartCommunication)
+    {
+        now = getMonotonicTimeMs();
+        if (now >= nextLinkPoll)
+        {
+            pInstance->fLinkUp = getLinkStatus(pInstance->initParam.pDevName);
+            nextLinkPoll = now + EDRV_LINK_POLL_INTERVAL;
+        }
+
+        pHdr = (volatile struct tpacket2_hdr*)(pRxRing->pBase + (pRxRing->index * EDRV_RING_FRAME_SIZE));
+        if ((pHdr->tp_status & TP_STATUS_USER) == 0)
+        {
+            pollFd.revents = 0;
+            poll(&pollFd, 1, EDRV_RX_POLL_TIMEOUT);
+            continue;
+        }
+
+        // Don't read the frame before its status
+        OPLK_MEMBAR();
+        packetHandler(pInstance, (int)pHdr->tp_snaplen, (UINT8*)pHdr + pHdr->tp_mac);
+
+        // Return the slot to the kernel after the frame has been processed
+        OPLK_MEMBAR();
+        pHdr->tp_status = TP_STATUS_KERNEL;
+        pRxRing->index = (pRxRing->index + 1) % pRxRing->frameCount;
+    }
+    pInstance->fThreadIsExited = TRUE;
+
+    return NULL;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Set up the packet rings
+
+This function sets up the receive and transmit ring of the socket and maps
+them into the address space of the process. Both rings use TPACKET_V2, so
+that every received frame is available without a block retire delay.
+
+\param[in,out]  pInstance_p         Pointer to the instance structure
+
+\return The function returns 0 on success, otherwise -1.
+*/
+//------------------------------------------------------------------------------
+static int setupRings(tEdrvInstance* pInstance_p)
+{
+    struct tpacket_req  rxReq;
+    struct tpacket_req  txReq;
+    int                 version = TPACKET_V2;
+    UINT                blockSize;
+    size_t              rxSize;
+
+    if (setsockopt(pInstance_p->sock, SOL_PACKET, PACKET_VERSION, &version, sizeof(version)) != 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() Couldn't set TPACKET_V2. Error = %s\n", __func__, strerror(errno));
+        return -1;
+    }
+
+    // A block has the page size and contains an integral number of slots
+    blockSize = (UINT)sysconf(_SC_PAGESIZE);
+    if (blockSize < EDRV_RING_FRAME_SIZE)
+        blockSize = EDRV_RING_FRAME_SIZE;
+
+    rxReq.tp_block_size = blockSize;
+    rxReq.tp_frame_size = EDRV_RING_FRAME_SIZE;
+    rxReq.tp_block_nr = (EDRV_RX_RING_FRAMES * EDRV_RING_FRAME_SIZE + blockSize - 1) / blockSize;
+    rxReq.tp_frame_nr = rxReq.tp_block_nr * (blockSize / EDRV_RING_FRAME_SIZE);
+
+    txReq = rxReq;
+    txReq.tp_block_nr = (EDRV_TX_RING_FRAMES * EDRV_RING_FRAME_SIZE + blockSize - 1) / blockSize;
+    txReq.tp_frame_nr = txReq.tp_block_nr * (blockSize / EDRV_RING_FRAME_SIZE);
+
+    if (setsockopt(pInstance_p->sock, SOL_PACKET, PACKET_RX_RING, &rxReq, sizeof(rxReq)) != 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() Couldn't set up Rx ring. Error = %s\n", __func__, strerror(errno));
+        return -1;
+    }
+
+    if (setsockopt(pInstance_p->sock, SOL_PACKET, PACKET_TX_RING, &txReq, sizeof(txReq)) != 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() Couldn't set up Tx ring. Error = %s\n", __func__, strerror(errno));
+        return -1;
+    }
+
+    // The Rx ring is followed by the Tx ring in the mapped area
+    rxSize = (size_t)rxReq.tp_block_size * rxReq.tp_block_nr;
+    pInstance_p->ringMemSize = rxSize + ((size_t)txReq.tp_block_size * txReq.tp_block_nr);
+    pInstance_p->pRingMem = mmap(NULL, pInstance_p->ringMemSize, PROT_READ | PROT_WRITE,
+                                 MAP_SHARED | MAP_LOCKED, pInstance_p->sock, 0);
+    if (pInstance_p->pRingMem == MAP_FAILED)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() Couldn't map packet rings. Error = %s\n", __func__, strerror(errno));
+        pInstance_p->pRingMem = NULL;
+        return -1;
+    }
+
+    pInstance_p->rxRing.pBase = (UINT8*)pInstance_p->pRingMem;
+    pInstance_p->rxRing.frameCount = rxReq.tp_frame_nr;
+    pInstance_p->rxRing.index = 0;
+
+    pInstance_p->txRing.pBase = (UINT8*)pInstance_p->pRingMem + rxSize;
+    pInstance_p->txRing.frameCount = txReq.tp_frame_nr;
+    pInstance_p->txRing.index = 0;
+
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Release the packet rings
+
+This function unmaps the receive and transmit ring.
+
+\param[in,out]  pInstance_p         Pointer to the instance structure
+*/
+//------------------------------------------------------------------------------
+static void freeRings(tEdrvInstance* pInstance_p)
+{
+    if (pInstance_p->pRingMem != NULL)
+    {
+        munmap(pInstance_p->pRingMem, pInstance_p->ringMemSize);
+        pInstance_p->pRingMem = NULL;
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get Edrv MAC address
+
+This function gets the interface's MAC address.
+
+\param[in]      pIfName_p           Ethernet interface device name
+\param[out]     pMacAddr_p          Pointer to store MAC address
+*/
+//------------------------------------------------------------------------------
+static void getMacAdrs(const char* pIfName_p, UINT8* pMacAddr_p)
+{
+    int             fd;
+    struct ifreq    ifr;
+
+    fd = socket(AF_INET, SOCK_DGRAM, 0);
+
+    ifr.ifr_addr.sa_family = AF_INET;
+    strncpy(ifr.ifr_name, pIfName_p, IFNAMSIZ - 1);
+
+    ioctl(fd, SIOCGIFHWADDR, &ifr);
+
+    close(fd);
+
+    OPLK_MEMCPY(pMacAddr_p, ifr.ifr_hwaddr.sa_data, 6);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get link status
+
+This function returns the interface link status. It uses the driver's packet
+socket, so no additional socket has to be opened per call.
+
+\param[in]      pIfName_p           Ethernet interface device name
+
+\return The function returns the link status.
+\retval TRUE    The link is up.
+\retval FALSE   The link is down.
+*/
+//------------------------------------------------------------------------------
+static BOOL getLinkStatus(const char* pIfName_p)
+{
+    struct ifreq    ethreq;
+
+    OPLK_MEMSET(&ethreq, 0, sizeof(ethreq));
+
+    // Set the name of the interface we wish to check
+    strncpy(ethreq.ifr_name, pIfName_p, IFNAMSIZ - 1);
+
+    // Grab flags associated with this interface
+    if (ioctl(edrvInstance_l.sock, SIOCGIFFLAGS, &ethreq) != 0)
+        return FALSE;
+
+    return ((ethreq.ifr_flags & IFF_RUNNING) != 0) ? TRUE : FALSE;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get monotonic time
+
+This function returns the current time of the monotonic clock.
+
+\return The function returns the time in milliseconds.
+*/
+//------------------------------------------------------------------------------
+static UINT64 getMonotonicTimeMs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((UINT64)ts.tv_sec * 1000ULL) + ((UINT64)ts.tv_nsec / 1000000ULL);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Trigger transmission
+
+This function triggers the transmission of all slots in the transmit ring
+which are marked with TP_STATUS_SEND_REQUEST. It doesn't wait for completion.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError kickTxRing(void)
+{
+    int sockRet;
+
+    sockRet = send(edrvInstance_l.sock, NULL, 0, MSG_DONTWAIT);
+    if ((sockRet < 0) && (errno != EAGAIN))
+    {
+        DEBUG_LVL_EDRV_TRACE("%s() send() returned %d\n", __func__, sockRet);
+        return kErrorInvalidOperation;
+    }
+
+    return kErrorOk;
+}
+
+/// \}
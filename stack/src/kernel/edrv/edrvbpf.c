@@ -0,0 +1,629 @@
+/**
+********************************************************************************
+\file   edrvbpf.c
+
+\brief  BPF Rx filter compiler for the Linux Ethernet drivers
+
+This file contains the implementation of the BPF Rx filter compiler. It
+translates the Rx filter table which is passed to edrv_changeRxFilter() into
+a classic BPF program. The Linux user space Ethernet drivers attach this
+program to their socket, so that the kernel already discards all frames which
+are not needed by the data link layer instead of copying them to user space.
+
+\ingroup module_edrv
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2017, B&R Industrial Automation GmbH
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <common/oplkinc.h>
+#include <common/ami.h>
+#include <kernel/edrvbpf.h>
+#include <oplk/frame.h>
+
+#include <string.h>
+#include <errno.h>
+#include <sys/socket.h>
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+// Maximum number of instructions generated for a single filter entry
+// (load, and, compare per byte plus the return instruction)
+#define EDRV_BPF_MAX_ENTRY_INSN     ((3 * EDRV_BPF_FILTER_SIZE) + 1)
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static BOOL isFilterRequired(const tEdrvFilter* pFilter_p);
+static BOOL isFilterDuplicate(const tEdrvFilter* pFilter_p,
+                              const tEdrvFilter* pFilterList_p,
+                              UINT count_p);
+static void compileFilter(const tEdrvFilter* pFilter_p,
+                          tEdrvBpfProgram* pProgram_p);
+static UINT getCompareWidth(const UINT8* pMask_p,
+                            UINT offset_p);
+static void emitInsn(tEdrvBpfProgram* pProgram_p,
+                     UINT16 code_p,
+                     UINT8 jt_p,
+                     UINT8 jf_p,
+                     UINT32 k_p);
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Compile Rx filter table
+
+The function translates the given Rx filter table into a classic BPF program.
+The program accepts a frame as soon as one of the required filter entries
+matches and rejects it otherwise.
+
+A filter entry is required if it is enabled or if it carries an auto-response
+Tx buffer. The Linux Ethernet drivers do not support auto-response, therefore
+the data link layer has to see these frames in software regardless of the
+enable flag.
+
+\param[in]      pFilter_p           Pointer to the Rx filter table.
+\param[in]      count_p             Number of entries in the Rx filter table.
+\param[in]      pSrcMacAddr_p       If not NULL, frames with this source MAC
+                                    address are accepted as well. This is
+                                    needed by drivers which detect the Tx
+                                    completion by capturing their own frames.
+\param[out]     pProgram_p          Pointer to the program to be generated.
+
+\return The function returns a tOplkError error code.
+\retval kErrorOk                    The program has been generated.
+\retval kErrorNoResource            The program exceeds EDRV_BPF_MAX_INSN_COUNT.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tOplkError edrvbpf_compileFilters(const tEdrvFilter* pFilter_p,
+                                  UINT count_p,
+                                  const UINT8* pSrcMacAddr_p,
+                                  tEdrvBpfProgram* pProgram_p)
+{
+    UINT        entry;
+    tEdrvFilter filter;
+
+    if ((pProgram_p == NULL) || ((pFilter_p == NULL) && (count_p != 0)))
+        return kErrorEdrvInvalidParam;
+
+    pProgram_p->insnCount = 0;
+
+    if (pSrcMacAddr_p != NULL)
+    {
+        // Accept own frames which are captured for the Tx completion
+        OPLK_MEMSET(&filter, 0, sizeof(filter));
+        OPLK_MEMCPY(&filter.aFilterValue[6], pSrcMacAddr_p, 6);
+        OPLK_MEMSET(&filter.aFilterMask[6], 0xFF, 6);
+        compileFilter(&filter, pProgram_p);
+    }
+
+#if (defined(CONFIG_INCLUDE_NMT_MN) || defined(CONFIG_INCLUDE_PRES_FORWARD))
+    // The MN evaluates the PRes frames of all isochronous CNs,
+    // independently of the PRes filter used for the PDO module.
+    OPLK_MEMSET(&filter, 0, sizeof(filter));
+    ami_setUint16Be(&filter.aFilterValue[12], C_DLL_ETHERTYPE_EPL);
+    ami_setUint16Be(&filter.aFilterMask[12], 0xFFFF);
+    ami_setUint8Be(&filter.aFilterValue[14], kMsgTypePres);
+    ami_setUint8Be(&filter.aFilterMask[14], 0xFF);
+    compileFilter(&filter, pProgram_p);
+#endif
+
+    for (entry = 0; entry < count_p; entry++)
+    {
+        if (!isFilterRequired(&pFilter_p[entry]) ||
+            isFilterDuplicate(&pFilter_p[entry], pFilter_p, entry))
+            continue;
+
+        // Keep space for the final reject instruction
+        if ((pProgram_p->insnCount + EDRV_BPF_MAX_ENTRY_INSN) >= EDRV_BPF_MAX_INSN_COUNT)
+            return kErrorNoResource;
+
+        compileFilter(&pFilter_p[entry], pProgram_p);
+    }
+
+    emitInsn(pProgram_p, BPF_RET | BPF_K, 0, 0, EDRV_BPF_REJECT);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Compare two BPF programs
+
+The function checks whether two BPF programs are identical. It is used by the
+Ethernet drivers to skip the reattachment of an unchanged program, e.g. if only
+the auto-response state of a filter entry has been changed.
+
+\param[in]      pProgram1_p         Pointer to the first program.
+\param[in]      pProgram2_p         Pointer to the second program.
+
+\return The function returns TRUE if both programs are identical.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+BOOL edrvbpf_isEqual(const tEdrvBpfProgram* pProgram1_p,
+                     const tEdrvBpfProgram* pProgram2_p)
+{
+    if (pProgram1_p->insnCount != pProgram2_p->insnCount)
+        return FALSE;
+
+    return (memcmp(pProgram1_p->aInsn,
+                   pProgram2_p->aInsn,
+                   pProgram1_p->insnCount * sizeof(struct sock_filter)) == 0);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Update Rx filter cache
+
+The function compares the given Rx filter table with the cached one and stores
+it in the cache. Only the properties which are relevant for the BPF program
+are considered, i.e. whether an entry is required and its masked value. A
+change of an auto-response Tx buffer which doesn't change the set of required
+entries therefore doesn't require a new program. Tables with more than
+\ref EDRV_BPF_MAX_FILTER_COUNT entries are not cached and always reported as
+changed.
+
+\param[in,out]  pCache_p            Pointer to the Rx filter cache.
+\param[in]      pFilter_p           Pointer to the Rx filter table (may be NULL).
+\param[in]      count_p             Number of entries in the Rx filter table.
+
+\return The function returns TRUE if the BPF program has to be regenerated.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+BOOL edrvbpf_updateFilterCache(tEdrvBpfFilterCache* pCache_p,
+                               const tEdrvFilter* pFilter_p,
+                               UINT count_p)
+{
+    BOOL                    fChanged;
+    UINT                    entry;
+    UINT                    offset;
+    tEdrvBpfFilterEntry*    pEntry;
+    BOOL                    fRequired;
+    UINT8                   value;
+
+    if (pFilter_p == NULL)
+        count_p = 0;
+
+    if (count_p > EDRV_BPF_MAX_FILTER_COUNT)
+    {
+        pCache_p->fValid = FALSE;
+        return TRUE;
+    }
+
+    fChanged = (!pCache_p->fValid || (pCache_p->filterCount != count_p));
+
+    for (entry = 0; entry < count_p; entry++)
+    {
+        pEntry = &pCache_p->aFilter[entry];
+        fRequired = isFilterRequired(&pFilter_p[entry]);
+        if (fRequired != pEntry->fRequired)
+            fChanged = TRUE;
+
+        pEntry->fRequired = fRequired;
+        if (!fRequired)
+            continue;
+
+        for (offset = 0; offset < EDRV_BPF_FILTER_SIZE; offset++)
+        {
+            value = pFilter_p[entry].aFilterValue[offset] & pFilter_p[entry].aFilterMask[offset];
+            if ((pEntry->aValue[offset] != value) ||
+                (pEntry->aMask[offset] != pFilter_p[entry].aFilterMask[offset]))
+            {
+                fChanged = TRUE;
+                pEntry->aValue[offset] = value;
+                pEntry->aMask[offset] = pFilter_p[entry].aFilterMask[offset];
+            }
+        }
+    }
+
+    pCache_p->filterCount = count_p;
+    pCache_p->fValid = TRUE;
+
+    return fChanged;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Attach BPF program to socket
+
+The function attaches the given BPF program to a socket. An already attached
+program is replaced atomically by the kernel, so no frame is evaluated by a
+partially updated filter.
+
+\param[in]      sock_p              Socket handle.
+\param[in]      pProgram_p          Pointer to the program to be attached.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tOplkError edrvbpf_attachToSocket(int sock_p,
+                                  const tEdrvBpfProgram* pProgram_p)
+{
+    struct sock_fprog   fprog;
+
+    fprog.len = (unsigned short)pProgram_p->insnCount;
+    fprog.filter = (struct sock_filter*)pProgram_p->aInsn;
+
+    if (setsockopt(sock_p, SOL_SOCKET, SO_ATTACH_FILTER, &fprog, sizeof(fprog)) != 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() SO_ATTACH_FILTER failed (%s)\n",
+                              __func__,
+                              strerror(errno));
+        return kErrorEdrvInit;
+    }
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Detach BPF program from socket
+
+The function removes an attached BPF program from a socket, so that all frames
+are passed to user space again.
+
+\param[in]      sock_p              Socket handle.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tOplkError edrvbpf_detachFromSocket(int sock_p)
+{
+    int dummy = 0;
+
+    if ((setsockopt(sock_p, SOL_SOCKET, SO_DETACH_FILTER, &dummy, sizeof(dummy)) != 0) &&
+        (errno != ENOENT))
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() SO_DETACH_FILTER failed (%s)\n",
+                              __func__,
+                              strerror(errno));
+        return kErrorEdrvInit;
+    }
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Update Rx filter of socket
+
+The function regenerates the BPF program of a socket from the given Rx filter
+table. The program is only regenerated if the table has changed in a way that
+is relevant for the program (see edrvbpf_updateFilterCache()), and only
+reattached if it differs from the currently attached one. If no filter table
+is given or the table cannot be compiled, the program is detached and all
+frames are passed to user space.
+
+\param[in]      sock_p              Socket handle.
+\param[in]      pFilter_p           Pointer to the Rx filter table (may be NULL).
+\param[in]      count_p             Number of entries in the Rx filter table.
+\param[in]      pSrcMacAddr_p       Source MAC address of frames which are
+                                    accepted additionally (may be NULL).
+\param[in,out]  pCache_p            Pointer to the Rx filter cache of the
+                                    socket. An instruction count of 0 of the
+                                    cached program denotes that no program is
+                                    attached.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tOplkError edrvbpf_updateSocketFilter(int sock_p,
+                                      const tEdrvFilter* pFilter_p,
+                                      UINT count_p,
+                                      const UINT8* pSrcMacAddr_p,
+                                      tEdrvBpfFilterCache* pCache_p)
+{
+    tOplkError          ret = kErrorOk;
+    tEdrvBpfProgram*    pProgram = &pCache_p->newProgram;
+
+    if (!edrvbpf_updateFilterCache(pCache_p, pFilter_p, count_p))
+        return kErrorOk;
+
+    if ((pFilter_p != NULL) && (count_p != 0))
+    {
+        ret = edrvbpf_compileFilters(pFilter_p, count_p, pSrcMacAddr_p, pProgram);
+        if (ret != kErrorOk)
+        {
+            DEBUG_LVL_EDRV_TRACE("%s() Rx filter table too large (0x%X), pass all frames\n",
+                                 __func__,
+                                 ret);
+            pProgram->insnCount = 0;
+        }
+    }
+    else
+        pProgram->insnCount = 0;
+
+    if (edrvbpf_isEqual(pProgram, &pCache_p->program))
+        return kErrorOk;
+
+    if (pProgram->insnCount != 0)
+        ret = edrvbpf_attachToSocket(sock_p, pProgram);
+    else
+        ret = edrvbpf_detachFromSocket(sock_p);
+
+    if (ret == kErrorOk)
+    {
+        pCache_p->program.insnCount = pProgram->insnCount;
+        OPLK_MEMCPY(pCache_p->program.aInsn,
+                    pProgram->aInsn,
+                    pProgram->insnCount * sizeof(struct sock_filter));
+    }
+    else
+    {
+        // Force the regeneration with the next change
+        pCache_p->fValid = FALSE;
+    }
+
+    return ret;
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Check if filter entry is required
+
+\param[in]      pFilter_p           Pointer to the filter entry.
+
+\return The function returns TRUE if the frames matching the entry have to be
+        passed to the data link layer.
+*/
+//------------------------------------------------------------------------------
+static BOOL isFilterRequired(const tEdrvFilter* pFilter_p)
+{
+    return ((pFilter_p->fEnable != FALSE) || (pFilter_p->pTxBuffer != NULL));
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Check if filter entry is a duplicate
+
+The function checks whether a required filter entry with the same mask and
+masked value precedes the given entry in the filter table.
+
+\param[in]      pFilter_p           Pointer to the filter entry.
+\param[in]      pFilterList_p       Pointer to the filter table.
+\param[in]      count_p             Number of preceding entries to be checked.
+
+\return The function returns TRUE if the entry is a duplicate.
+*/
+//------------------------------------------------------------------------------
+static BOOL isFilterDuplicate(const tEdrvFilter* pFilter_p,
+                              const tEdrvFilter* pFilterList_p,
+                              UINT count_p)
+{
+    UINT    entry;
+    UINT    offset;
+
+    for (entry = 0; entry < count_p; entry++)
+    {
+        if (!isFilterRequired(&pFilterList_p[entry]))
+            continue;
+
+        for (offset = 0; offset < EDRV_BPF_FILTER_SIZE; offset++)
+        {
+            if ((pFilter_p->aFilterMask[offset] != pFilterList_p[entry].aFilterMask[offset]) ||
+                ((pFilter_p->aFilterValue[offset] & pFilter_p->aFilterMask[offset]) !=
+                 (pFilterList_p[entry].aFilterValue[offset] & pFilterList_p[entry].aFilterMask[offset])))
+                break;
+        }
+
+        if (offset == EDRV_BPF_FILTER_SIZE)
+            return TRUE;
+    }
+
+    return FALSE;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Compile single filter entry
+
+The function appends the instructions for one filter entry to the program.
+The masked bytes are compared with as few word, half-word and byte loads as
+possible. If all compares succeed, the frame is accepted. Otherwise the
+execution continues with the instructions of the next filter entry.
+
+\param[in]      pFilter_p           Pointer to the filter entry.
+\param[in,out]  pProgram_p          Pointer to the program.
+*/
+//------------------------------------------------------------------------------
+static void compileFilter(const tEdrvFilter* pFilter_p,
+                          tEdrvBpfProgram* pProgram_p)
+{
+    UINT    aJumpInsn[EDRV_BPF_FILTER_SIZE];
+    UINT    jumpCount = 0;
+    UINT    offset = 0;
+    UINT    width;
+    UINT    i;
+    UINT32  value;
+    UINT32  mask;
+    UINT32  fullMask;
+    UINT16  loadSize;
+
+    while (offset < EDRV_BPF_FILTER_SIZE)
+    {
+        if (pFilter_p->aFilterMask[offset] == 0)
+        {
+            offset++;
+            continue;
+        }
+
+        width = getCompareWidth(pFilter_p->aFilterMask, offset);
+        value = 0;
+        mask = 0;
+        for (i = 0; i < width; i++)
+        {
+            // BPF loads are performed in network byte order
+            value = (value << 8) | pFilter_p->aFilterValue[offset + i];
+            mask = (mask << 8) | pFilter_p->aFilterMask[offset + i];
+        }
+
+        switch (width)
+        {
+            case 4:
+                loadSize = BPF_W;
+                fullMask = 0xFFFFFFFF;
+                break;
+
+            case 2:
+                loadSize = BPF_H;
+                fullMask = 0xFFFF;
+                break;
+
+            default:
+                loadSize = BPF_B;
+                fullMask = 0xFF;
+                break;
+        }
+
+        emitInsn(pProgram_p, BPF_LD | loadSize | BPF_ABS, 0, 0, offset);
+        if (mask != fullMask)
+            emitInsn(pProgram_p, BPF_ALU | BPF_AND | BPF_K, 0, 0, mask);
+
+        aJumpInsn[jumpCount++] = pProgram_p->insnCount;
+        emitInsn(pProgram_p, BPF_JMP | BPF_JEQ | BPF_K, 0, 0, value & mask);
+
+        offset += width;
+    }
+
+    emitInsn(pProgram_p, BPF_RET | BPF_K, 0, 0, EDRV_BPF_ACCEPT);
+
+    // A mismatch continues with the first instruction after the accept
+    for (i = 0; i < jumpCount; i++)
+        pProgram_p->aInsn[aJumpInsn[i]].jf = (UINT8)(pProgram_p->insnCount - aJumpInsn[i] - 1);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get compare width
+
+The function determines the number of bytes which are compared with a single
+load instruction at the given offset. Trailing bytes without mask bits are
+not included.
+
+\param[in]      pMask_p             Pointer to the filter mask.
+\param[in]      offset_p            Offset of the first byte to be compared.
+                                    Its mask must not be zero.
+
+\return The function returns the compare width in bytes (1, 2 or 4).
+*/
+//------------------------------------------------------------------------------
+static UINT getCompareWidth(const UINT8* pMask_p,
+                            UINT offset_p)
+{
+    UINT    width = EDRV_BPF_FILTER_SIZE - offset_p;
+
+    if (width > 4)
+        width = 4;
+
+    while (pMask_p[offset_p + width - 1] == 0)
+        width--;
+
+    if (width == 3)
+        width = ((offset_p + 4) <= EDRV_BPF_FILTER_SIZE) ? 4 : 2;
+
+    return width;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Append instruction to program
+
+\param[in,out]  pProgram_p          Pointer to the program.
+\param[in]      code_p              Instruction code.
+\param[in]      jt_p                Jump offset if condition is true.
+\param[in]      jf_p                Jump offset if condition is false.
+\param[in]      k_p                 Generic constant of the instruction.
+*/
+//------------------------------------------------------------------------------
+static void emitInsn(tEdrvBpfProgram* pProgram_p,
+                     UINT16 code_p,
+                     UINT8 jt_p,
+                     UINT8 jf_p,
+                     UINT32 k_p)
+{
+    struct sock_filter* pInsn = &pProgram_p->aInsn[pProgram_p->insnCount++];
+
+    pInsn->code = code_p;
+    pInsn->jt = jt_p;
+    pInsn->jf = jf_p;
+    pInsn->k = k_p;
+}
+
+/// \}
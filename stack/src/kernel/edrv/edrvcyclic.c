@@ -46,7 +46,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <kernel/edrv.h>
 #include <kernel/hrestimer.h>
 
-#if (CONFIG_EDRV_CYCLIC_USE_DIAGNOSTICS != FALSE)
+#if ((CONFIG_EDRV_CYCLIC_USE_DIAGNOSTICS != FALSE) || (CONFIG_EDRV_CYCLIC_USE_STATISTICS != FALSE))
 #include <common/target.h>
 #endif
 
@@ -120,6 +120,12 @@ typedef struct
     ULONGLONG               lastSlotTimeStamp;              ///< Timestamp of the last slot
     tEdrvCyclicDiagnostics  diagnostics;                    ///< Diagnose data
 #endif
+#if (CONFIG_EDRV_CYCLIC_USE_STATISTICS != FALSE)
+    ULONGLONG               statCycleTimeStamp;             ///< Timestamp of the cycle start
+    ULONGLONG               statLastTxTimeStamp;            ///< Timestamp of the last timer triggered transmission
+    volatile BOOL           fStatisticsResetReq;            ///< Reset of the statistics is requested
+    tOplkApiCycleStatistics statistics;                     ///< Cycle timing histograms
+#endif
 } tEdrvcyclicInstance;
 
 //------------------------------------------------------------------------------
@@ -135,6 +141,13 @@ static tOplkError timerHdlCycleCb(const tTimerEventArg* pEventArg_p);
 static tOplkError timerHdlSlotCb(const tTimerEventArg* pEventArg_p);
 #endif
 static tOplkError processTxBufferList(BOOL fCallSyncCb_p);
+#if (CONFIG_EDRV_CYCLIC_USE_STATISTICS != FALSE)
+static void       clearStatistics(void);
+static void       recordValue(tOplkApiHistogram* pHistogram_p, UINT32 value_p);
+static tOplkError callSyncCb(void);
+#else
+#define callSyncCb()    edrvcyclicInstance_l.pfnSyncCb()
+#endif
 
 //============================================================================//
 //            P U B L I C   F U N C T I O N S                                 //
@@ -162,6 +175,10 @@ tOplkError edrvcyclic_init(void)
     edrvcyclicInstance_l.diagnostics.spareCycleTimeMin   = 0xFFFFFFFF;
 #endif
 
+#if (CONFIG_EDRV_CYCLIC_USE_STATISTICS != FALSE)
+    clearStatistics();
+#endif
+
     return kErrorOk;
 }
 
@@ -301,6 +318,9 @@ tOplkError edrvcyclic_setCycleTime(UINT32 cycleTimeUs_p, UINT32 minSyncTime_p)
     UNUSED_PARAMETER(minSyncTime_p);
 
     edrvcyclicInstance_l.cycleTimeUs = cycleTimeUs_p;
+#if (CONFIG_EDRV_CYCLIC_USE_STATISTICS != FALSE)
+    edrvcyclicInstance_l.statistics.cycleTimeNs = cycleTimeUs_p * 1000;
+#endif
 
     return kErrorOk;
 }
@@ -347,6 +367,10 @@ tOplkError edrvcyclic_startCycle(BOOL fContinuousMode_p)
     edrvcyclicInstance_l.lastSlotTimeStamp = 0;
 #endif
 
+#if (CONFIG_EDRV_CYCLIC_USE_STATISTICS != FALSE)
+    edrvcyclicInstance_l.statCycleTimeStamp = 0;
+#endif
+
 Exit:
     return ret;
 }
@@ -466,6 +490,57 @@ tOplkError edrvcyclic_getDiagnostics(const tEdrvCyclicDiagnostics** ppDiagnostic
 }
 #endif /* (CONFIG_EDRV_CYCLIC_USE_DIAGNOSTICS != FALSE) */
 
+#if (CONFIG_EDRV_CYCLIC_USE_STATISTICS != FALSE)
+//------------------------------------------------------------------------------
+/**
+\brief  Obtain cycle statistics
+
+This function copies the cycle timing histograms to the provided buffer.
+The histograms are updated by the cycle and slot timer callbacks while they
+are copied. Therefore, the counters of a histogram may differ by the values
+recorded during the copy operation.
+
+\param[out]     pStatistics_p       Pointer to store the cycle statistics.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tOplkError edrvcyclic_getStatistics(tOplkApiCycleStatistics* pStatistics_p)
+{
+    // Check parameter validity
+    ASSERT(pStatistics_p != NULL);
+
+    OPLK_MEMCPY(pStatistics_p, &edrvcyclicInstance_l.statistics, sizeof(*pStatistics_p));
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Reset cycle statistics
+
+This function resets the cycle timing histograms. If the cycle is running,
+the reset is executed at the start of the next cycle by the cycle timer
+callback, so that it does not interfere with the recording.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tOplkError edrvcyclic_resetStatistics(void)
+{
+    if (edrvcyclicInstance_l.timerHdlCycle == 0)
+        clearStatistics();
+    else
+        edrvcyclicInstance_l.fStatisticsResetReq = TRUE;
+
+    return kErrorOk;
+}
+#endif /* (CONFIG_EDRV_CYCLIC_USE_STATISTICS != FALSE) */
+
 //============================================================================//
 //            P R I V A T E   F U N C T I O N S                               //
 //============================================================================//
@@ -492,6 +567,10 @@ static tOplkError timerHdlCycleCb(const tTimerEventArg* pEventArg_p)
     UINT32          spareCycleTime;
     ULONGLONG       startNewCycleTimeStamp;
 #endif
+#if (CONFIG_EDRV_CYCLIC_USE_STATISTICS != FALSE)
+    ULONGLONG       statCycleTimeStamp;
+    UINT32          cycleTimeNs;
+#endif
 
     if (pEventArg_p->timerHdl.handle != edrvcyclicInstance_l.timerHdlCycle)
     {   // zombie callback
@@ -503,6 +582,29 @@ static tOplkError timerHdlCycleCb(const tTimerEventArg* pEventArg_p)
     startNewCycleTimeStamp = target_getCurrentTimestamp();
 #endif
 
+#if (CONFIG_EDRV_CYCLIC_USE_STATISTICS != FALSE)
+    statCycleTimeStamp = target_getCurrentTimestamp();
+
+    if (edrvcyclicInstance_l.fStatisticsResetReq)
+    {
+        clearStatistics();
+        edrvcyclicInstance_l.fStatisticsResetReq = FALSE;
+    }
+    else if (edrvcyclicInstance_l.statCycleTimeStamp != 0)
+    {
+        cycleTimeNs = (UINT32)(statCycleTimeStamp - edrvcyclicInstance_l.statCycleTimeStamp);
+        if (cycleTimeNs >= edrvcyclicInstance_l.statistics.cycleTimeNs)
+            recordValue(&edrvcyclicInstance_l.statistics.cycleJitter,
+                        cycleTimeNs - edrvcyclicInstance_l.statistics.cycleTimeNs);
+        else
+            recordValue(&edrvcyclicInstance_l.statistics.cycleJitter,
+                        edrvcyclicInstance_l.statistics.cycleTimeNs - cycleTimeNs);
+    }
+
+    edrvcyclicInstance_l.statCycleTimeStamp = statCycleTimeStamp;
+    edrvcyclicInstance_l.statLastTxTimeStamp = statCycleTimeStamp;
+#endif
+
     if (edrvcyclicInstance_l.ppTxBufferList[edrvcyclicInstance_l.curTxBufferEntry] != NULL)
     {
         ret = kErrorEdrvTxListNotFinishedYet;
@@ -648,6 +750,16 @@ static tOplkError timerHdlSlotCb(const tTimerEventArg* pEventArg_p)
     edrvcyclicInstance_l.lastSlotTimeStamp = target_getCurrentTimestamp();
 #endif
 
+#if (CONFIG_EDRV_CYCLIC_USE_STATISTICS != FALSE)
+    {
+        ULONGLONG   slotTimeStamp = target_getCurrentTimestamp();
+
+        recordValue(&edrvcyclicInstance_l.statistics.txSlotSpacing,
+                    (UINT32)(slotTimeStamp - edrvcyclicInstance_l.statLastTxTimeStamp));
+        edrvcyclicInstance_l.statLastTxTimeStamp = slotTimeStamp;
+    }
+#endif
+
     pTxBuffer = edrvcyclicInstance_l.ppTxBufferList[edrvcyclicInstance_l.curTxBufferEntry];
     ret = edrv_sendTxBuffer(pTxBuffer);
     if (ret != kErrorOk)
@@ -692,6 +804,8 @@ static tOplkError processTxBufferList(BOOL fCallSyncCb_p)
     UINT64              cycleMin;
     UINT64              cycleMax;
     UINT64              currentMacTime = 0;
+#elif (EDRV_USE_TX_BATCH != FALSE)
+    tOplkError          batchRet;
 #endif
 
 #if (EDRV_USE_TTTX != FALSE)
@@ -755,7 +869,7 @@ static tOplkError processTxBufferList(BOOL fCallSyncCb_p)
         {
             if (edrvcyclicInstance_l.pfnSyncCb != NULL)
             {
-                ret = edrvcyclicInstance_l.pfnSyncCb();
+                ret = callSyncCb();
             }
             fCallSyncCb_p = FALSE;
         }
@@ -763,6 +877,11 @@ static tOplkError processTxBufferList(BOOL fCallSyncCb_p)
 
 #else /* (EDRV_USE_TTTX != FALSE) */
 
+#if (EDRV_USE_TX_BATCH != FALSE)
+    // Frames without time offset are handed to the driver as one batch
+    edrv_beginTxBatch();
+#endif
+
     while ((pTxBuffer = edrvcyclicInstance_l.ppTxBufferList[edrvcyclicInstance_l.curTxBufferEntry]) != NULL)
     {
         if (pTxBuffer->timeOffsetNs == 0)
@@ -788,9 +907,17 @@ static tOplkError processTxBufferList(BOOL fCallSyncCb_p)
 
         if (fCallSyncCb_p)
         {
+#if (EDRV_USE_TX_BATCH != FALSE)
+            // The first frame of the cycle must not wait for the sync callback
+            ret = edrv_endTxBatch();
+            if (ret != kErrorOk)
+                goto Exit;
+
+            edrv_beginTxBatch();
+#endif
             if (edrvcyclicInstance_l.pfnSyncCb != NULL)
             {
-                ret = edrvcyclicInstance_l.pfnSyncCb();
+                ret = callSyncCb();
             }
             fCallSyncCb_p = FALSE;
         }
@@ -798,6 +925,12 @@ static tOplkError processTxBufferList(BOOL fCallSyncCb_p)
 #endif /* (EDRV_USE_TTTX != FALSE) */
 
 Exit:
+#if ((EDRV_USE_TTTX == FALSE) && (EDRV_USE_TX_BATCH != FALSE))
+    batchRet = edrv_endTxBatch();
+    if (ret == kErrorOk)
+        ret = batchRet;
+#endif
+
     if (ret != kErrorOk)
     {
         if (edrvcyclicInstance_l.pfnErrorCb != NULL)
@@ -808,4 +941,94 @@ Exit:
     return ret;
 }
 
+#if (CONFIG_EDRV_CYCLIC_USE_STATISTICS != FALSE)
+//------------------------------------------------------------------------------
+/**
+\brief  Clear cycle statistics
+
+This function clears all histograms of the cycle statistics.
+*/
+//------------------------------------------------------------------------------
+static void clearStatistics(void)
+{
+    UINT32  cycleTimeNs = edrvcyclicInstance_l.statistics.cycleTimeNs;
+
+    OPLK_MEMSET(&edrvcyclicInstance_l.statistics, 0, sizeof(edrvcyclicInstance_l.statistics));
+    edrvcyclicInstance_l.statistics.cycleTimeNs = cycleTimeNs;
+    edrvcyclicInstance_l.statistics.cycleJitter.minValue = 0xFFFFFFFF;
+    edrvcyclicInstance_l.statistics.txSlotSpacing.minValue = 0xFFFFFFFF;
+    edrvcyclicInstance_l.statistics.syncCbExecTime.minValue = 0xFFFFFFFF;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Record value in histogram
+
+This function counts a value in the log-linear histogram. The bucket index is
+derived from the position of the most significant bit and the following
+OPLK_HISTOGRAM_SUB_BUCKET_BITS bits of the value (see \ref tOplkApiHistogram).
+
+\param[in,out]  pHistogram_p        Pointer to the histogram.
+\param[in]      value_p             Value to be recorded.
+*/
+//------------------------------------------------------------------------------
+static void recordValue(tOplkApiHistogram* pHistogram_p, UINT32 value_p)
+{
+    UINT    msb = 0;
+    UINT    shift;
+    UINT32  value = value_p;
+    UINT    bucket;
+
+    if (value_p < (1U << OPLK_HISTOGRAM_SUB_BUCKET_BITS))
+    {
+        bucket = value_p;
+    }
+    else
+    {
+        // determine most significant bit by binary search
+        for (shift = 16; shift > 0; shift >>= 1)
+        {
+            if (value >= (1UL << shift))
+            {
+                value >>= shift;
+                msb += shift;
+            }
+        }
+
+        bucket = ((msb - OPLK_HISTOGRAM_SUB_BUCKET_BITS + 1) << OPLK_HISTOGRAM_SUB_BUCKET_BITS) +
+                 ((value_p >> (msb - OPLK_HISTOGRAM_SUB_BUCKET_BITS)) & ((1U << OPLK_HISTOGRAM_SUB_BUCKET_BITS) - 1));
+    }
+
+    pHistogram_p->aBucket[bucket]++;
+    pHistogram_p->sampleCount++;
+    pHistogram_p->sum += value_p;
+    if (value_p < pHistogram_p->minValue)
+        pHistogram_p->minValue = value_p;
+    if (value_p > pHistogram_p->maxValue)
+        pHistogram_p->maxValue = value_p;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Call sync callback
+
+This function calls the sync callback and records its execution time.
+
+\return The function returns the tOplkError error code of the sync callback.
+*/
+//------------------------------------------------------------------------------
+static tOplkError callSyncCb(void)
+{
+    tOplkError  ret;
+    ULONGLONG   startTimeStamp = target_getCurrentTimestamp();
+
+    ret = edrvcyclicInstance_l.pfnSyncCb();
+
+    recordValue(&edrvcyclicInstance_l.statistics.syncCbExecTime,
+                (UINT32)(target_getCurrentTimestamp() - startTimeStamp));
+
+    return ret;
+}
+#endif /* (CONFIG_EDRV_CYCLIC_USE_STATISTICS != FALSE) */
+
 /// \}
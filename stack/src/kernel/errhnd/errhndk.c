@@ -82,6 +82,13 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // const defines
 //------------------------------------------------------------------------------
+// Number of CN Loss of PRes threshold counters which are checked per cycle for
+// values written through the object dictionary (0 disables the check)
+#ifndef CONFIG_ERRHNDK_MNCN_SCRUB_COUNT
+#define CONFIG_ERRHNDK_MNCN_SCRUB_COUNT         1
+#endif
+
+#define ERRHNDK_MNCN_ACTIVE_WORDS               ((NUM_DLL_MNCN_LOSSPRES_OBJS + 31) / 32)
 
 //------------------------------------------------------------------------------
 // local types
@@ -96,6 +103,11 @@ typedef struct
 {
     UINT32              dllErrorEvents;                                 ///< Variable stores detected error events
     UINT8               aMnCnLossPresEvent[NUM_DLL_MNCN_LOSSPRES_OBJS]; ///< Variable stores detected error events from CNs
+#if defined(CONFIG_INCLUDE_NMT_MN)
+    UINT32              aMnCnLossPresActive[ERRHNDK_MNCN_ACTIVE_WORDS]; ///< Bitmap of CNs with a pending event or a non-zero threshold counter
+    UINT                mnCnLossPresActiveCount;                        ///< Number of bits set in aMnCnLossPresActive
+    UINT                mnCnLossPresScrubIdx;                           ///< Next CN to be checked for a threshold counter written by the OD
+#endif
     tErrHndObjects      errorObjects;                                   ///< Error objects (counters and thresholds)
 } tErrHndkInstance;
 
@@ -116,6 +128,11 @@ static tOplkError handleDllErrors(const tEvent* pEvent_p);
 
 #if defined(CONFIG_INCLUDE_NMT_MN)
 static tOplkError decrementMnCounters(void);
+static void       decrementMnCnLossPresCounter(UINT nodeIdx_p);
+static void       scrubMnCnLossPresCounters(void);
+static void       setMnCnLossPresActive(UINT nodeIdx_p);
+static void       clearMnCnLossPresActive(UINT nodeIdx_p);
+static BOOL       isMnCnLossPresActive(UINT nodeIdx_p);
 static tOplkError postHeartbeatEvent(UINT nodeId_p, tNmtState state_p, UINT16 errorCode_p);
 static tOplkError generateHistoryEntryWithError(UINT16 errorCode_p, tNetTime netTime_p, UINT16 oplkError_p);
 #endif
@@ -140,6 +157,11 @@ tOplkError errhndk_init(void)
     tOplkError  ret;
 
     instance_l.dllErrorEvents = 0L;
+#if defined(CONFIG_INCLUDE_NMT_MN)
+    OPLK_MEMSET(instance_l.aMnCnLossPresActive, 0, sizeof(instance_l.aMnCnLossPresActive));
+    instance_l.mnCnLossPresActiveCount = 0;
+    instance_l.mnCnLossPresScrubIdx = 0;
+#endif
     ret = errhndkcal_init();
 
     return ret;
@@ -290,7 +312,9 @@ tOplkError errhndk_postError(const tEventDllError* pErrEvent_p)
 /**
 \brief    Reset error flag for specified CN
 
-The function resets the error flag for the specified CN.
+The function resets the error flag for the specified CN. If the Loss of PRes
+threshold counter of the CN is non-zero, the CN is added to the active set, so
+that the counter is decremented again from the next cycle on.
 
 \param[in]      nodeId_p            Node ID of CN for which error flag will be reset.
 
@@ -302,12 +326,17 @@ The function resets the error flag for the specified CN.
 tOplkError errhndk_resetCnError(UINT nodeId_p)
 {
     UINT    nodeIdx = nodeId_p - 1;
+    UINT32  thresholdCnt;
 
     if (nodeIdx >= NUM_DLL_MNCN_LOSSPRES_OBJS)
         return kErrorInvalidNodeId;
 
     instance_l.aMnCnLossPresEvent[nodeIdx] = ERRORHANDLERK_CN_LOSS_PRES_EVENT_NONE;
 
+    errhndkcal_getMnCnLossPresThresholdCnt(nodeIdx, &thresholdCnt);
+    if (thresholdCnt > 0)
+        setMnCnLossPresActive(nodeIdx);
+
     return kErrorOk;
 }
 #endif
@@ -323,7 +352,9 @@ tOplkError errhndk_resetCnError(UINT nodeId_p)
 /**
 \brief    Decrement MN error counters
 
-The function decrements the error counters used by a MN node.
+The function decrements the error counters used by a MN node. Only the CNs
+with a pending Loss of PRes event or a non-zero threshold counter are
+processed, thus, the threshold counters of error-free CNs are not accessed.
 
 \return Returns kErrorOk or error code
 */
@@ -334,35 +365,23 @@ static tOplkError decrementMnCounters(void)
     UINT    nodeIdx;
     UINT32  thresholdCnt;
 
-    dllk_getCurrentCnNodeIdList(&pCnNodeId);
+    scrubMnCnLossPresCounters();
 
-    // iterate through node info structure list
-    while (*pCnNodeId != C_ADR_INVALID)
+    if (instance_l.mnCnLossPresActiveCount > 0)
     {
-        nodeIdx = *pCnNodeId - 1;
-        if (nodeIdx < NUM_DLL_MNCN_LOSSPRES_OBJS)
+        dllk_getCurrentCnNodeIdList(&pCnNodeId);
+
+        // iterate through node info structure list
+        while (*pCnNodeId != C_ADR_INVALID)
         {
-            if (instance_l.aMnCnLossPresEvent[nodeIdx] ==
-                ERRORHANDLERK_CN_LOSS_PRES_EVENT_NONE)
-            {
-                errhndkcal_getMnCnLossPresThresholdCnt(nodeIdx, &thresholdCnt);
-                if (thresholdCnt > 0)
-                {
-                    thresholdCnt--;
-                    errhndkcal_setMnCnLossPresThresholdCnt(nodeIdx, thresholdCnt);
-                }
-            }
-            else
+            nodeIdx = *pCnNodeId - 1;
+            if ((nodeIdx < NUM_DLL_MNCN_LOSSPRES_OBJS) &&
+                (isMnCnLossPresActive(nodeIdx) != FALSE))
             {
-                if (instance_l.aMnCnLossPresEvent[nodeIdx] ==
-                    ERRORHANDLERK_CN_LOSS_PRES_EVENT_OCC)
-                {
-                    instance_l.aMnCnLossPresEvent[nodeIdx] =
-                                          ERRORHANDLERK_CN_LOSS_PRES_EVENT_NONE;
-                }
+                decrementMnCnLossPresCounter(nodeIdx);
             }
+            pCnNodeId++;
         }
-        pCnNodeId++;
     }
 
     if ((instance_l.dllErrorEvents & DLL_ERR_MN_CRC) == 0)
@@ -387,6 +406,130 @@ static tOplkError decrementMnCounters(void)
 
     return kErrorOk;
 }
+
+//------------------------------------------------------------------------------
+/**
+\brief    Decrement Loss of PRes threshold counter of a CN
+
+The function decrements the Loss of PRes threshold counter of the specified CN
+if no error occurred in the last cycle. The CN is removed from the active set
+if there is nothing left to decrement.
+
+\param[in]      nodeIdx_p           Index of the CN (node ID - 1).
+*/
+//------------------------------------------------------------------------------
+static void decrementMnCnLossPresCounter(UINT nodeIdx_p)
+{
+    UINT32  thresholdCnt;
+
+    switch (instance_l.aMnCnLossPresEvent[nodeIdx_p])
+    {
+        case ERRORHANDLERK_CN_LOSS_PRES_EVENT_NONE:
+            errhndkcal_getMnCnLossPresThresholdCnt(nodeIdx_p, &thresholdCnt);
+            if (thresholdCnt > 0)
+            {
+                thresholdCnt--;
+                errhndkcal_setMnCnLossPresThresholdCnt(nodeIdx_p, thresholdCnt);
+            }
+
+            if (thresholdCnt == 0)
+                clearMnCnLossPresActive(nodeIdx_p);
+            break;
+
+        case ERRORHANDLERK_CN_LOSS_PRES_EVENT_OCC:
+            instance_l.aMnCnLossPresEvent[nodeIdx_p] = ERRORHANDLERK_CN_LOSS_PRES_EVENT_NONE;
+            break;
+
+        default:
+            // Threshold exceeded, the counter is not decremented until
+            // errhndk_resetCnError() is called.
+            clearMnCnLossPresActive(nodeIdx_p);
+            break;
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief    Check Loss of PRes threshold counters written by the OD
+
+The threshold counters can be written through the object dictionary (0x1C08)
+without notice of the kernel error handler. Therefore, the function checks
+CONFIG_ERRHNDK_MNCN_SCRUB_COUNT inactive CNs per cycle and adds them to the
+active set if their threshold counter is non-zero.
+*/
+//------------------------------------------------------------------------------
+static void scrubMnCnLossPresCounters(void)
+{
+#if (CONFIG_ERRHNDK_MNCN_SCRUB_COUNT > 0)
+    UINT    count;
+    UINT    nodeIdx;
+    UINT32  thresholdCnt;
+
+    for (count = CONFIG_ERRHNDK_MNCN_SCRUB_COUNT; count > 0; count--)
+    {
+        nodeIdx = instance_l.mnCnLossPresScrubIdx;
+        instance_l.mnCnLossPresScrubIdx = (nodeIdx + 1) % NUM_DLL_MNCN_LOSSPRES_OBJS;
+
+        if (isMnCnLossPresActive(nodeIdx) == FALSE)
+        {
+            errhndkcal_getMnCnLossPresThresholdCnt(nodeIdx, &thresholdCnt);
+            if (thresholdCnt > 0)
+                setMnCnLossPresActive(nodeIdx);
+        }
+    }
+#endif
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief    Add CN to the Loss of PRes active set
+
+\param[in]      nodeIdx_p           Index of the CN (node ID - 1).
+*/
+//------------------------------------------------------------------------------
+static void setMnCnLossPresActive(UINT nodeIdx_p)
+{
+    UINT32  mask = (UINT32)1 << (nodeIdx_p & 31);
+
+    if ((instance_l.aMnCnLossPresActive[nodeIdx_p >> 5] & mask) == 0)
+    {
+        instance_l.aMnCnLossPresActive[nodeIdx_p >> 5] |= mask;
+        instance_l.mnCnLossPresActiveCount++;
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief    Remove CN from the Loss of PRes active set
+
+\param[in]      nodeIdx_p           Index of the CN (node ID - 1).
+*/
+//------------------------------------------------------------------------------
+static void clearMnCnLossPresActive(UINT nodeIdx_p)
+{
+    UINT32  mask = (UINT32)1 << (nodeIdx_p & 31);
+
+    if ((instance_l.aMnCnLossPresActive[nodeIdx_p >> 5] & mask) != 0)
+    {
+        instance_l.aMnCnLossPresActive[nodeIdx_p >> 5] &= ~mask;
+        instance_l.mnCnLossPresActiveCount--;
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief    Check if CN is in the Loss of PRes active set
+
+\param[in]      nodeIdx_p           Index of the CN (node ID - 1).
+
+\return The function returns TRUE if the CN is in the active set.
+*/
+//------------------------------------------------------------------------------
+static BOOL isMnCnLossPresActive(UINT nodeIdx_p)
+{
+    return ((instance_l.aMnCnLossPresActive[nodeIdx_p >> 5] &
+             ((UINT32)1 << (nodeIdx_p & 31))) != 0);
+}
 #endif
 
 //------------------------------------------------------------------------------
@@ -864,6 +1007,8 @@ static tOplkError handleMnCnLossPres(const tEvent* pEvent_p)
         }
     }
     errhndkcal_setMnCnLossPresCounters(nodeIdx, cumulativeCnt, thresholdCnt);
+    if (thresholdCnt > 0)
+        setMnCnLossPresActive(nodeIdx);
 
     return kErrorOk;
 }
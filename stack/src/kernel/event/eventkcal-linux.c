@@ -106,6 +106,8 @@ static tEventkCalInstance   instance_l;             ///< Instance variable of ke
 // local function prototypes
 //------------------------------------------------------------------------------
 static void* eventThread(void* arg);
+static int   waitForSignal(sem_t* pSem_p);
+static BOOL  processEventBatch(void);
 static void  signalKernelEvent(void);
 static void  signalUserEvent(void);
 
@@ -128,7 +130,6 @@ The function initializes the kernel event CAL module on Linux.
 //------------------------------------------------------------------------------
 tOplkError eventkcal_init(void)
 {
-    struct sched_param  schedParam;
 
     OPLK_MEMSET(&instance_l, 0, sizeof(tEventkCalInstance));
 
@@ -158,18 +159,17 @@ tOplkError eventkcal_init(void)
     if (pthread_create(&instance_l.threadId, NULL, eventThread, (void*)&instance_l) != 0)
         goto Exit;
 
-    schedParam.sched_priority = KERNEL_EVENT_THREAD_PRIORITY;
-    if (pthread_setschedparam(instance_l.threadId, SCHED_FIFO, &schedParam) != 0)
+    if (target_registerThread(kOplkThreadRoleEventKernel,
+                              instance_l.threadId,
+                              kOplkThreadPolicyFifo,
+                              KERNEL_EVENT_THREAD_PRIORITY,
+                              "oplk-eventk") != kErrorOk)
     {
         DEBUG_LVL_ERROR_TRACE("%s(): couldn't set thread scheduling parameters! %d\n",
                               __func__,
-                              schedParam.sched_priority);
+                              KERNEL_EVENT_THREAD_PRIORITY);
     }
 
-#if (defined(__GLIBC__) && __GLIBC__ >= 2 && __GLIBC_MINOR__ >= 12)
-    pthread_setname_np(instance_l.threadId, "oplk-eventk");
-#endif
-
     instance_l.fInitialized = TRUE;
     return kErrorOk;
 
@@ -208,6 +208,7 @@ tOplkError eventkcal_exit(void)
 
     if (instance_l.fInitialized != FALSE)
     {
+        target_unregisterThread(kOplkThreadRoleEventKernel, instance_l.threadId);
         instance_l.fStopThread = TRUE;
         while (instance_l.fStopThread != FALSE)
         {
@@ -316,37 +317,103 @@ This function contains the main function for the event handler thread.
 //------------------------------------------------------------------------------
 static void* eventThread(void* arg)
 {
-    struct timespec         curTime, timeout;
     tEventkCalInstance*     pInstance = (tEventkCalInstance*)arg;
+    BOOL                    fEventsPending = FALSE;
 
     while (!pInstance->fStopThread)
     {
-        clock_gettime(CLOCK_REALTIME, &curTime);
-        timeout.tv_sec = 0;
-        timeout.tv_nsec = 50000 * 1000;
-        TIMESPECADD(&timeout, &curTime);
+        // Leftovers of the previous batch are processed without waiting
+        if (!fEventsPending && (waitForSignal(pInstance->semKernelData) != 0))
+            continue;
 
-        if (sem_timedwait(pInstance->semKernelData, &timeout) == 0)
-        {
-            /* first handle kernel internal events --> higher priority! */
-            if (eventkcal_getEventCountCircbuf(kEventQueueKInt) > 0)
-            {
-                eventkcal_processEventCircbuf(kEventQueueKInt);
-            }
-            else
-            {
-                if (eventkcal_getEventCountCircbuf(kEventQueueU2K) > 0)
-                {
-                    eventkcal_processEventCircbuf(kEventQueueU2K);
-                }
-            }
-        }
+        // A wakeup covers all events posted so far, so consume all pending signals
+        while (sem_trywait(pInstance->semKernelData) == 0)
+            ;
+
+        fEventsPending = processEventBatch();
     }
 
     pInstance->fStopThread = FALSE;
     return 0;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Wait for an event signal
+
+This function waits until an event is signaled or the timeout of 50 ms expires.
+The timeout is based on CLOCK_MONOTONIC if the C library supports it.
+
+\param[in]      pSem_p              Semaphore to wait for.
+
+\return The function returns 0 if a signal was received, otherwise -1.
+*/
+//------------------------------------------------------------------------------
+static int waitForSignal(sem_t* pSem_p)
+{
+    struct timespec         curTime, timeout;
+
+    timeout.tv_sec = 0;
+    timeout.tv_nsec = 50000 * 1000;
+
+#if (defined(__GLIBC__) && ((__GLIBC__ > 2) || (__GLIBC_MINOR__ >= 30)))
+    clock_gettime(CLOCK_MONOTONIC, &curTime);
+    TIMESPECADD(&timeout, &curTime);
+
+    return sem_clockwait(pSem_p, CLOCK_MONOTONIC, &timeout);
+#else
+    clock_gettime(CLOCK_REALTIME, &curTime);
+    TIMESPECADD(&timeout, &curTime);
+
+    return sem_timedwait(pSem_p, &timeout);
+#endif
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Process a batch of events
+
+This function processes up to \ref CONFIG_EVENT_DRAIN_MAX_EVENTS events. The
+kernel-internal queue and the user-to-kernel queue are served in a weighted
+round-robin manner, so the kernel-internal events keep their priority without
+starving the user-to-kernel queue.
+
+\return The function returns TRUE if the batch limit was reached and events
+        may still be pending, otherwise FALSE.
+*/
+//------------------------------------------------------------------------------
+static BOOL processEventBatch(void)
+{
+    UINT    processedCount = 0;
+    UINT    highCount;
+    UINT    lowCount;
+    UINT    i;
+
+    while (processedCount < CONFIG_EVENT_DRAIN_MAX_EVENTS)
+    {
+        highCount = eventkcal_getEventCountCircbuf(kEventQueueKInt);
+        lowCount = eventkcal_getEventCountCircbuf(kEventQueueU2K);
+        if ((highCount == 0) && (lowCount == 0))
+            return FALSE;
+
+        for (i = 0; (i < CONFIG_EVENT_DRAIN_WEIGHT_HIGH) && (i < highCount) &&
+                    (processedCount < CONFIG_EVENT_DRAIN_MAX_EVENTS); i++)
+        {
+            eventkcal_processEventCircbuf(kEventQueueKInt);
+            processedCount++;
+        }
+
+        for (i = 0; (i < CONFIG_EVENT_DRAIN_WEIGHT_LOW) && (i < lowCount) &&
+                    (processedCount < CONFIG_EVENT_DRAIN_MAX_EVENTS); i++)
+        {
+            eventkcal_processEventCircbuf(kEventQueueU2K);
+            processedCount++;
+        }
+    }
+
+    return TRUE;
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  Signal a user event
@@ -400,14 +400,17 @@ The function processes a received RxPDO.
 //------------------------------------------------------------------------------
 tOplkError pdok_processRxPdo(const tPlkFrame* pFrame_p, UINT frameSize_p)
 {
-    tOplkError      ret = kErrorOk;
-    UINT8           frameData;
-    UINT            nodeId;
-    tMsgType        msgType;
-    tPdoChannel*    pPdoChannel;
-    UINT8           channelId;
-    UINT8           index;
-    UINT16          pdoPayloadSize;
+    tOplkError          ret = kErrorOk;
+    UINT8               frameData;
+    UINT                nodeId;
+    tMsgType            msgType;
+    tPdoChannel*        pPdoChannel;
+    UINT8               channelId;
+    UINT8               index;
+    UINT16              pdoPayloadSize;
+    UINT8               pdoVersion;
+    tPdokcalRxPdoDesc   aRxPdo[PDOKLUT_MAX_CHANNELS_PER_NODE];
+    UINT                rxPdoCount = 0;
 
     // Check parameter validity
     ASSERT(pFrame_p != NULL);
@@ -437,43 +440,42 @@ tOplkError pdok_processRxPdo(const tPlkFrame* pFrame_p, UINT frameSize_p)
 
     if (pdokInstance_g.fRunning)
     {
-        // Get PDO channel reference
+        // retrieve PDO version and payload size from frame
+        pdoVersion = ami_getUint8Le(&pFrame_p->data.pres.pdoVersion);
+        pdoPayloadSize = ami_getUint16Le(&pFrame_p->data.pres.sizeLe);
+
+        // Collect all PDO channels of the node and publish them together
         index = 0;
         while ((channelId = pdoklut_getChannel(pdokInstance_g.aRxPdoLut, index, nodeId)) != PDOKLUT_INVALID_CHANNEL)
         {
             index++;
             pPdoChannel = &pdokInstance_g.pdoChannels.pRxPdoChannel[channelId];
 
-            // retrieve PDO version from frame
-            frameData = ami_getUint8Le(&pFrame_p->data.pres.pdoVersion);
-            if ((pPdoChannel->mappingVersion & PLK_VERSION_MAIN) != (frameData & PLK_VERSION_MAIN))
+            if ((pPdoChannel->mappingVersion & PLK_VERSION_MAIN) != (pdoVersion & PLK_VERSION_MAIN))
             {   // PDO versions do not match
                 // $$$ raise PDO error E_PDO_MAP_VERS
-                // terminate processing of this RPDO
-                goto Exit;
+                // terminate processing of this RPDO, the frame is not
+                // published partially
+                rxPdoCount = 0;
+                break;
             }
 
             // valid RPDO found
-            pdoPayloadSize = ami_getUint16Le(&pFrame_p->data.pres.sizeLe);
             if (pPdoChannel->nextChannelOffset > pdoPayloadSize)
             {   // RPDO is too short
                 // $$$ raise PDO error E_PDO_SHORT_RX, set Ret
-                goto Exit;
+                rxPdoCount = 0;
+                break;
             }
 
-            /*
-            TRACE("%s() Channel:%d Node:%d MapObjectCnt:%d PdoSize:%d\n",
-                  __func__,
-                  channelId,
-                  nodeId,
-                  pPdoChannel->mappObjectCount,
-                  pPdoChannel->pdoSize);
-            */
-
-            pdokcal_writeRxPdo(channelId,
-                               &pFrame_p->data.pres.aPayload[0] + pPdoChannel->offset,
-                               pPdoChannel->nextChannelOffset - pPdoChannel->offset);
+            aRxPdo[rxPdoCount].pPayload = &pFrame_p->data.pres.aPayload[0] + pPdoChannel->offset;
+            aRxPdo[rxPdoCount].pdoSize = pPdoChannel->nextChannelOffset - pPdoChannel->offset;
+            aRxPdo[rxPdoCount].channelId = channelId;
+            rxPdoCount++;
         }
+
+        if (rxPdoCount > 0)
+            pdokcal_writeRxPdoChannels(aRxPdo, rxPdoCount);
     }
 
 Exit:
@@ -208,56 +208,81 @@ void pdokcal_cleanupPdoMem(void)
 
 //------------------------------------------------------------------------------
 /**
-\brief  Write RXPDO to PDO memory
+\brief  Write the RXPDOs of a frame to PDO memory
 
-The function writes a received RXPDO into the PDO memory range.
+The function writes all received RXPDO channels of one frame into the PDO
+memory range. All channels of a frame share the buffer indices of their frame
+channel. Therefore, the PDO data of all channels is copied into the same write
+buffer and the data cache is maintained once over the written range.
+Afterwards the frame is published with a single buffer exchange, so that the
+consumer always sees the channels of one frame consistently.
 
-\param[in]      channelId_p         Channel ID of PDO to write.
-\param[in]      pPayload_p          Pointer to received PDO payload.
-\param[in]      pdoSize_p           Size of received PDO.
+\param[in]      pRxPdo_p            Pointer to array of RXPDO descriptors. All
+                                    descriptors must belong to the same frame.
+\param[in]      rxPdoCount_p        Number of RXPDO descriptors.
 
 \return Returns an error code
 
 \ingroup module_pdokcal
 */
 //------------------------------------------------------------------------------
-tOplkError pdokcal_writeRxPdo(UINT8 channelId_p, const void* pPayload_p, UINT16 pdoSize_p)
+tOplkError pdokcal_writeRxPdoChannels(const tPdokcalRxPdoDesc* pRxPdo_p,
+                                      UINT rxPdoCount_p)
 {
-    void*           pPdo;
-    OPLK_ATOMIC_T   temp;
+    UINT8*              pRangeStart = NULL;
+    UINT8*              pRangeEnd = NULL;
+    UINT8*              pPdo;
+    UINT8*              pWriteBuf;
+    OPLK_ATOMIC_T       temp;
+    tPdoBufferInfo*     pFrameInfo;
+    UINT8               frameChannelId;
+    UINT                i;
 
     // Check parameter validity
-    ASSERT(pPayload_p != NULL);
+    ASSERT(pRxPdo_p != NULL);
+
+    if (rxPdoCount_p == 0)
+        return kErrorOk;
+
+    frameChannelId = pPdoMem_l->rxChannelInfo[pRxPdo_p[0].channelId].frameChannelId;
+    pFrameInfo = &pPdoMem_l->rxChannelInfo[frameChannelId];
+
+    // Invalidate data cache for the buffer indices of the frame
+    OPLK_DCACHE_INVALIDATE(pFrameInfo, sizeof(tPdoBufferInfo));
+
+    pWriteBuf = (UINT8*)pTripleBuf_l[pFrameInfo->writeBuf];
 
-    // Invalidate data cache for addressed rxChannelInfo
-    OPLK_DCACHE_INVALIDATE(&(pPdoMem_l->rxChannelInfo[channelId_p]), sizeof(tPdoBufferInfo));
+    // Copy the PDO data of all channels into the write buffer of the frame
+    for (i = 0; i < rxPdoCount_p; i++)
+    {
+        ASSERT(pPdoMem_l->rxChannelInfo[pRxPdo_p[i].channelId].frameChannelId == frameChannelId);
+
+        pPdo = pWriteBuf + pPdoMem_l->rxChannelInfo[pRxPdo_p[i].channelId].channelOffset;
+
+        OPLK_MEMCPY(pPdo, pRxPdo_p[i].pPayload, pRxPdo_p[i].pdoSize);
 
-    pPdo = (UINT8*)pTripleBuf_l[pPdoMem_l->rxChannelInfo[channelId_p].writeBuf] +
-           pPdoMem_l->rxChannelInfo[channelId_p].channelOffset;
-    //TRACE("%s() chan:%d wi:%d\n", __func__, channelId_p, pPdoMem_l->rxChannelInfo[channelId_p].writeBuf);
+        if ((pRangeStart == NULL) || (pPdo < pRangeStart))
+            pRangeStart = pPdo;
 
-    OPLK_MEMCPY(pPdo, pPayload_p, pdoSize_p);
+        if ((pPdo + pRxPdo_p[i].pdoSize) > pRangeEnd)
+            pRangeEnd = pPdo + pRxPdo_p[i].pdoSize;
+    }
 
-    OPLK_DCACHE_FLUSH(pPdo, pdoSize_p);
+    OPLK_DCACHE_FLUSH(pRangeStart, (size_t)(pRangeEnd - pRangeStart));
 
-    // Invalidate the cache again, as the previous cache invalidation is
-    // not under the lock context, and also the value of .cleanBuf may
+    // Invalidate the cache again, as the value of .cleanBuf may
     // be changed on the physical memory.
-    OPLK_DCACHE_INVALIDATE(&(pPdoMem_l->rxChannelInfo[channelId_p]),
-                           sizeof(tPdoBufferInfo));
-    temp = pPdoMem_l->rxChannelInfo[channelId_p].writeBuf;
-    OPLK_ATOMIC_EXCHANGE(&pPdoMem_l->rxChannelInfo[channelId_p].cleanBuf,
+    OPLK_DCACHE_INVALIDATE(pFrameInfo, sizeof(tPdoBufferInfo));
+    temp = pFrameInfo->writeBuf;
+    OPLK_ATOMIC_EXCHANGE(&pFrameInfo->cleanBuf,
                          temp,
-                         pPdoMem_l->rxChannelInfo[channelId_p].writeBuf);
+                         pFrameInfo->writeBuf);
 
-    pPdoMem_l->rxChannelInfo[channelId_p].newData = 1;
+    pFrameInfo->newData = 1;
 
     // Flush data cache for variables changed in this function
-    OPLK_DCACHE_FLUSH(&(pPdoMem_l->rxChannelInfo[channelId_p]),
-                      sizeof(tPdoBufferInfo));
+    OPLK_DCACHE_FLUSH(pFrameInfo, sizeof(tPdoBufferInfo));
 
-    //TRACE("%s() chan:%d new wi:%d\n", __func__, channelId_p, pPdoMem_l->rxChannelInfo[channelId_p].writeBuf);
-    //TRACE("%s() *pPayload_p:%02x\n", __func__, *pPayload_p);
     return kErrorOk;
 }
 
@@ -326,7 +351,8 @@ tOplkError pdokcal_readTxPdo(UINT8 channelId_p, void* pPayload_p, UINT16 pdoSize
 \brief  Setup PDO memory info
 
 The function sets up the PDO memory info. For each channel the offset in the
-shared buffer and the size are stored.
+shared buffer and the size are stored. Each RXPDO channel is assigned to the
+frame channel of its node, i.e. the channel of the node with the lowest ID.
 
 \param[in]      pPdoChannels_p      Pointer to PDO channel setup.
 \param[in,out]  pPdoMemRegion_p     Pointer to shared PDO memory region.
@@ -336,6 +362,7 @@ static void setupPdoMemInfo(const tPdoChannelSetup* pPdoChannels_p,
                             tPdoMemRegion* pPdoMemRegion_p)
 {
     UINT8               channelId;
+    UINT8               frameChannelId;
     UINT                offset;
     const tPdoChannel*  pPdoChannel;
 
@@ -350,6 +377,19 @@ static void setupPdoMemInfo(const tPdoChannelSetup* pPdoChannels_p,
         pPdoMemRegion_p->rxChannelInfo[channelId].writeBuf = 1;
         pPdoMemRegion_p->rxChannelInfo[channelId].cleanBuf = 2;
         pPdoMemRegion_p->rxChannelInfo[channelId].newData = 0;
+
+        // Find the first channel of the same node
+        frameChannelId = channelId;
+        if (pPdoChannel->nodeId != PDO_INVALID_NODE_ID)
+        {
+            for (frameChannelId = 0; frameChannelId < channelId; frameChannelId++)
+            {
+                if (pPdoChannels_p->pRxPdoChannel[frameChannelId].nodeId == pPdoChannel->nodeId)
+                    break;
+            }
+        }
+        pPdoMemRegion_p->rxChannelInfo[channelId].frameChannelId = frameChannelId;
+
         offset += pPdoChannel->nextChannelOffset - pPdoChannel->offset;
     }
 
@@ -363,6 +403,7 @@ static void setupPdoMemInfo(const tPdoChannelSetup* pPdoChannels_p,
         pPdoMemRegion_p->txChannelInfo[channelId].writeBuf = 1;
         pPdoMemRegion_p->txChannelInfo[channelId].cleanBuf = 2;
         pPdoMemRegion_p->txChannelInfo[channelId].newData = 0;
+        pPdoMemRegion_p->txChannelInfo[channelId].frameChannelId = channelId;
         offset += pPdoChannel->nextChannelOffset - pPdoChannel->offset;
     }
     pPdoMemRegion_p->pdoMemSize = offset;
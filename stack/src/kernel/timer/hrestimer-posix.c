@@ -43,6 +43,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // includes
 //------------------------------------------------------------------------------
 #include <common/oplkinc.h>
+#include <common/target.h>
 #include <kernel/hrestimer.h>
 
 #include <time.h>
@@ -143,7 +144,6 @@ tOplkError hrestimer_init(void)
 {
     tOplkError          ret = kErrorOk;
     UINT                index;
-    struct sched_param  schedParam;
     tHresTimerInfo*     pTimerInfo;
     struct sigevent     sev;
 
@@ -170,18 +170,18 @@ tOplkError hrestimer_init(void)
         return kErrorNoResource;
     }
 
-    schedParam.sched_priority = CONFIG_THREAD_PRIORITY_HIGH;
-    if (pthread_setschedparam(hresTimerInstance_l.threadId, SCHED_FIFO, &schedParam) != 0)
+    if (target_registerThread(kOplkThreadRoleHresTimer,
+                              hresTimerInstance_l.threadId,
+                              kOplkThreadPolicyFifo,
+                              CONFIG_THREAD_PRIORITY_HIGH,
+                              "oplk-hrtimer") != kErrorOk)
     {
         DEBUG_LVL_ERROR_TRACE("%s() Couldn't set thread scheduling parameters!\n", __func__);
+        target_unregisterThread(kOplkThreadRoleHresTimer, hresTimerInstance_l.threadId);
         pthread_cancel(hresTimerInstance_l.threadId);
         return kErrorNoResource;
     }
 
-#if (defined(__GLIBC__) && (__GLIBC__ >= 2) && (__GLIBC_MINOR__ >= 12))
-    pthread_setname_np(hresTimerInstance_l.threadId, "oplk-hrtimer");
-#endif
-
     return ret;
 }
 
@@ -210,6 +210,8 @@ tOplkError hrestimer_exit(void)
         pTimerInfo->pfnCallback = NULL;
     }
 
+    target_unregisterThread(kOplkThreadRoleHresTimer, hresTimerInstance_l.threadId);
+
     /* send exit signal to thread */
     pthread_cancel(hresTimerInstance_l.threadId);
     /* wait until thread terminates */
@@ -0,0 +1,722 @@
+/**
+********************************************************************************
+\file   hrestimer-posix_hybrid.c
+
+\brief  High-resolution timer module for Linux using a hybrid sleep/spin thread
+
+This module is the target specific implementation of the high-resolution
+timer module for Linux userspace. All timers are served by a single timer
+thread. The thread sleeps until a configurable margin before the next
+deadline and then polls CLOCK_MONOTONIC until the deadline is reached.
+The wake-up latency of every expiry is recorded in the timer statistics.
+
+\ingroup module_hrestimer
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2012, SYSTEC electronic GmbH
+Copyright (c) 2016, B&R Industrial Automation GmbH
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <common/oplkinc.h>
+#include <common/target.h>
+#include <kernel/hrestimer.h>
+
+#include <time.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sched.h>
+#include <pthread.h>
+#include <sys/syscall.h>
+
+#if (CONFIG_HRESTIMER_USE_STATISTICS == FALSE)
+#error "The hybrid high-resolution timer requires CONFIG_HRESTIMER_USE_STATISTICS!"
+#endif
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define TIMER_COUNT             2           ///< number of high-resolution timers
+#define TIMER_MIN_VAL_SINGLE    20000       ///< minimum timer interval for single timeouts
+#define TIMER_MIN_VAL_CYCLE     100000      ///< minimum timer interval for continuous timeouts
+
+/* macros for timer handles */
+#define TIMERHDL_MASK           0x0FFFFFFF
+#define TIMERHDL_SHIFT          28
+#define HDL_TO_IDX(hdl)         ((hdl >> TIMERHDL_SHIFT) - 1)
+#define HDL_INIT(idx)           ((idx + 1) << TIMERHDL_SHIFT)
+#define HDL_INC(hdl)            (((hdl + 1) & TIMERHDL_MASK) | (hdl & ~TIMERHDL_MASK))
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//          P R I V A T E   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+// Time in ns before a deadline at which the timer thread stops sleeping and
+// starts polling the clock
+#ifndef CONFIG_HRESTIMER_SPIN_MARGIN
+#define CONFIG_HRESTIMER_SPIN_MARGIN        50000
+#endif
+
+// CPU the timer thread is pinned to (-1 = no pinning)
+#ifndef CONFIG_HRESTIMER_THREAD_CPU
+#define CONFIG_HRESTIMER_THREAD_CPU         -1
+#endif
+
+#define HRESTIMER_NS_PER_SEC                1000000000ULL
+#define HRESTIMER_DEADLINE_NONE             (~(ULONGLONG)0)
+#define HRESTIMER_LATENCY_MAX               0xFFFFFFFFUL
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+/**
+\brief  High-resolution timer information structure
+
+The structure contains all necessary information for a high-resolution timer.
+*/
+typedef struct
+{
+    tTimerEventArg      eventArg;           ///< Event argument
+    tTimerkCallback     pfnCallback;        ///< Pointer to timer callback function
+    ULONGLONG           deadline;           ///< Next expiry time (CLOCK_MONOTONIC) in nanoseconds
+    ULONGLONG           period;             ///< Timer period in nanoseconds
+    BOOL                fActive;            ///< Flag determines if timer is running
+    BOOL                fContinue;          ///< Flag determines if timer will be restarted continuously
+} tHresTimerInfo;
+
+/**
+\brief  High-resolution timer instance
+
+The structure defines a high-resolution timer module instance.
+*/
+typedef struct
+{
+    tHresTimerInfo          aTimerInfo[TIMER_COUNT];    ///< Array with timer information for a set of timers
+    pthread_t               threadId;                   ///< Timer thread Id
+    pthread_mutex_t         mutex;                      ///< Mutex protecting the timer information
+    pthread_cond_t          timerCond;                  ///< Condition signaling a timer change to the thread
+    UINT                    changeCount;                ///< Counter of timer changes
+    BOOL                    fTerminate;                 ///< Thread termination flag
+    tOplkApiTimerStatistics statistics;                 ///< Wake-up latency statistics
+} tHresTimerInstance;
+
+//------------------------------------------------------------------------------
+// module local vars
+//------------------------------------------------------------------------------
+static tHresTimerInstance    hresTimerInstance_l;
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static void*                timerThread(void* pArgument_p);
+static ULONGLONG            getCurrentTime(void);
+static tHresTimerInfo*      getNextTimer(void);
+static void                 waitUntil(ULONGLONG time_p);
+static void                 updateStatistics(ULONGLONG latency_p);
+static void                 resetStatistics(void);
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief    Initialize high-resolution timer module
+
+The function initializes the high-resolution timer module
+
+\return Returns a tOplkError error code.
+
+\ingroup module_hrestimer
+*/
+//------------------------------------------------------------------------------
+tOplkError hrestimer_init(void)
+{
+    pthread_condattr_t  condAttr;
+#if (CONFIG_HRESTIMER_THREAD_CPU >= 0)
+    cpu_set_t           cpuSet;
+#endif
+
+    OPLK_MEMSET(&hresTimerInstance_l, 0, sizeof(hresTimerInstance_l));
+    resetStatistics();
+
+    if (pthread_mutex_init(&hresTimerInstance_l.mutex, NULL) != 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() Couldn't init mutex!\n", __func__);
+        return kErrorNoResource;
+    }
+
+    // the thread waits for absolute CLOCK_MONOTONIC times
+    pthread_condattr_init(&condAttr);
+    pthread_condattr_setclock(&condAttr, CLOCK_MONOTONIC);
+    if (pthread_cond_init(&hresTimerInstance_l.timerCond, &condAttr) != 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() Couldn't init condition variable!\n", __func__);
+        pthread_condattr_destroy(&condAttr);
+        pthread_mutex_destroy(&hresTimerInstance_l.mutex);
+        return kErrorNoResource;
+    }
+    pthread_condattr_destroy(&condAttr);
+
+    if (pthread_create(&hresTimerInstance_l.threadId, NULL, timerThread, NULL) != 0)
+    {
+        pthread_cond_destroy(&hresTimerInstance_l.timerCond);
+        pthread_mutex_destroy(&hresTimerInstance_l.mutex);
+        return kErrorNoResource;
+    }
+
+#if (CONFIG_HRESTIMER_THREAD_CPU >= 0)
+    // pin the thread before the role parameters are applied, which may override it
+    CPU_ZERO(&cpuSet);
+    CPU_SET(CONFIG_HRESTIMER_THREAD_CPU, &cpuSet);
+    if (pthread_setaffinity_np(hresTimerInstance_l.threadId, sizeof(cpuSet), &cpuSet) != 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() Couldn't pin timer thread to CPU %d!\n",
+                              __func__,
+                              CONFIG_HRESTIMER_THREAD_CPU);
+    }
+#endif
+
+    if (target_registerThread(kOplkThreadRoleHresTimer,
+                              hresTimerInstance_l.threadId,
+                              kOplkThreadPolicyFifo,
+                              CONFIG_THREAD_PRIORITY_HIGH,
+                              "oplk-hrtimer") != kErrorOk)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() Couldn't set thread scheduling parameters!\n", __func__);
+        hrestimer_exit();
+        return kErrorNoResource;
+    }
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief    Shut down high-resolution timer module
+
+The function shuts down the high-resolution timer module.
+
+\return Returns a tOplkError error code.
+
+\ingroup module_hrestimer
+*/
+//------------------------------------------------------------------------------
+tOplkError hrestimer_exit(void)
+{
+    UINT    index;
+
+    /* send exit signal to thread */
+    pthread_mutex_lock(&hresTimerInstance_l.mutex);
+    for (index = 0; index < TIMER_COUNT; index++)
+    {
+        hresTimerInstance_l.aTimerInfo[index].fActive = FALSE;
+        hresTimerInstance_l.aTimerInfo[index].eventArg.timerHdl.handle = 0;
+        hresTimerInstance_l.aTimerInfo[index].pfnCallback = NULL;
+    }
+    hresTimerInstance_l.fTerminate = TRUE;
+    pthread_cond_signal(&hresTimerInstance_l.timerCond);
+    pthread_mutex_unlock(&hresTimerInstance_l.mutex);
+
+    /* wait until thread terminates */
+    target_unregisterThread(kOplkThreadRoleHresTimer, hresTimerInstance_l.threadId);
+    pthread_join(hresTimerInstance_l.threadId, NULL);
+
+    /* clean up */
+    pthread_cond_destroy(&hresTimerInstance_l.timerCond);
+    pthread_mutex_destroy(&hresTimerInstance_l.mutex);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief    Modify a high-resolution timer
+
+The function modifies the timeout of the timer with the specified handle.
+If the handle to which the pointer points to is zero, the timer must be created
+first. If it is not possible to stop the old timer, this function always assures
+that the old timer does not trigger the callback function with the same handle
+as the new timer. That means the callback function must check the passed handle
+with the one returned by this function. If these are unequal, the call can be
+discarded.
+
+\param[in,out]  pTimerHdl_p         Pointer to timer handle.
+\param[in]      time_p              Relative timeout in [ns].
+\param[in]      pfnCallback_p       Callback function, which is called when timer expires.
+                                    (The function is called mutually exclusive with
+                                    the Edrv callback functions (Rx and Tx)).
+\param[in]      argument_p          User-specific argument.
+\param[in]      fContinue_p         If TRUE, the callback function will be called continuously.
+                                    Otherwise, it is a one-shot timer.
+
+\return Returns a tOplkError error code.
+
+\ingroup module_hrestimer
+*/
+//------------------------------------------------------------------------------
+tOplkError hrestimer_modifyTimer(tTimerHdl* pTimerHdl_p,
+                                 ULONGLONG time_p,
+                                 tTimerkCallback pfnCallback_p,
+                                 ULONG argument_p,
+                                 BOOL fContinue_p)
+{
+    tOplkError          ret = kErrorOk;
+    UINT                index;
+    tHresTimerInfo*     pTimerInfo;
+
+    if (pTimerHdl_p == NULL)
+        return kErrorTimerInvalidHandle;
+
+    pthread_mutex_lock(&hresTimerInstance_l.mutex);
+
+    if (*pTimerHdl_p == 0)
+    {   // no timer created yet
+        // search free timer info structure
+        pTimerInfo = &hresTimerInstance_l.aTimerInfo[0];
+        for (index = 0; index < TIMER_COUNT; index++, pTimerInfo++)
+        {
+            if (pTimerInfo->eventArg.timerHdl.handle == 0)
+            {   // free structure found
+                break;
+            }
+        }
+        if (index >= TIMER_COUNT)
+        {   // no free structure found
+            ret = kErrorTimerNoTimerCreated;
+            goto Exit;
+        }
+
+        pTimerInfo->eventArg.timerHdl.handle = HDL_INIT(index);
+    }
+    else
+    {
+        index = HDL_TO_IDX(*pTimerHdl_p);
+        if (index >= TIMER_COUNT)
+        {   // invalid handle
+            ret = kErrorTimerInvalidHandle;
+            goto Exit;
+        }
+
+        pTimerInfo = &hresTimerInstance_l.aTimerInfo[index];
+    }
+
+    // increase too small time values
+    if (fContinue_p != FALSE)
+    {
+        if (time_p < TIMER_MIN_VAL_CYCLE)
+            time_p = TIMER_MIN_VAL_CYCLE;
+    }
+    else
+    {
+        if (time_p < TIMER_MIN_VAL_SINGLE)
+            time_p = TIMER_MIN_VAL_SINGLE;
+    }
+
+    /* increment timer handle
+     * (if timer expires right after this statement, the user
+     * would detect an unknown timer handle and discard it) */
+    pTimerInfo->eventArg.timerHdl.handle = HDL_INC(pTimerInfo->eventArg.timerHdl.handle);
+    *pTimerHdl_p = pTimerInfo->eventArg.timerHdl.handle;
+
+    /* initialize timer info */
+    pTimerInfo->eventArg.argument.value = argument_p;
+    pTimerInfo->pfnCallback = pfnCallback_p;
+    pTimerInfo->fContinue = fContinue_p;
+    pTimerInfo->period = time_p;
+    pTimerInfo->deadline = getCurrentTime() + time_p;
+    pTimerInfo->fActive = TRUE;
+
+    /* signal timer change to thread */
+    hresTimerInstance_l.changeCount++;
+    pthread_cond_signal(&hresTimerInstance_l.timerCond);
+
+Exit:
+    pthread_mutex_unlock(&hresTimerInstance_l.mutex);
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief    Delete a high-resolution timer
+
+The function deletes a created high-resolution timer. The timer is specified
+by its timer handle. After deleting, the handle is reset to zero.
+
+\param[in,out]  pTimerHdl_p         Pointer to timer handle.
+
+\return Returns a tOplkError error code.
+
+\ingroup module_hrestimer
+*/
+//------------------------------------------------------------------------------
+tOplkError hrestimer_deleteTimer(tTimerHdl* pTimerHdl_p)
+{
+    UINT                index;
+    tHresTimerInfo*     pTimerInfo;
+
+    // check pointer to handle
+    if (pTimerHdl_p == NULL)
+        return kErrorTimerInvalidHandle;
+
+    if (*pTimerHdl_p == 0)
+    {   // no timer created yet
+        return kErrorOk;
+    }
+
+    index = HDL_TO_IDX(*pTimerHdl_p);
+    if (index >= TIMER_COUNT)
+    {   // invalid handle
+        return kErrorTimerInvalidHandle;
+    }
+
+    pTimerInfo = &hresTimerInstance_l.aTimerInfo[index];
+
+    pthread_mutex_lock(&hresTimerInstance_l.mutex);
+    if (pTimerInfo->eventArg.timerHdl.handle == *pTimerHdl_p)
+    {
+        pTimerInfo->fActive = FALSE;
+        pTimerInfo->fContinue = FALSE;
+        pTimerInfo->eventArg.timerHdl.handle = 0;
+        pTimerInfo->pfnCallback = NULL;
+
+        hresTimerInstance_l.changeCount++;
+        pthread_cond_signal(&hresTimerInstance_l.timerCond);
+    }
+    pthread_mutex_unlock(&hresTimerInstance_l.mutex);
+
+    *pTimerHdl_p = 0;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Control external synchronization interrupt
+
+This function enables/disables the external synchronization interrupt. If the
+external synchronization interrupt is not supported, the call is ignored.
+
+\param[in]      fEnable_p           Flag determines if sync should be enabled or disabled.
+
+\ingroup module_hrestimer
+*/
+//------------------------------------------------------------------------------
+void hrestimer_controlExtSyncIrq(BOOL fEnable_p)
+{
+    UNUSED_PARAMETER(fEnable_p);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Set external synchronization interrupt time
+
+This function sets the time when the external synchronization interrupt shall
+be triggered to synchronize the host processor. If the external synchronization
+interrupt is not supported, the call is ignored.
+
+\param[in]      time_p              Time when the sync shall be triggered
+
+\ingroup module_hrestimer
+*/
+//------------------------------------------------------------------------------
+void hrestimer_setExtSyncIrqTime(tTimestamp time_p)
+{
+    UNUSED_PARAMETER(time_p);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get timer statistics
+
+This function returns a snapshot of the wake-up latency statistics of the
+high-resolution timers.
+
+\param[out]     pStatistics_p       Pointer to store the statistics.
+
+\return Returns a tOplkError error code.
+
+\ingroup module_hrestimer
+*/
+//------------------------------------------------------------------------------
+tOplkError hrestimer_getStatistics(tOplkApiTimerStatistics* pStatistics_p)
+{
+    if (pStatistics_p == NULL)
+        return kErrorInvalidInstanceParam;
+
+    pthread_mutex_lock(&hresTimerInstance_l.mutex);
+    OPLK_MEMCPY(pStatistics_p, &hresTimerInstance_l.statistics, sizeof(tOplkApiTimerStatistics));
+    pthread_mutex_unlock(&hresTimerInstance_l.mutex);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Reset timer statistics
+
+This function resets the wake-up latency statistics of the high-resolution
+timers.
+
+\return Returns a tOplkError error code.
+
+\ingroup module_hrestimer
+*/
+//------------------------------------------------------------------------------
+tOplkError hrestimer_resetStatistics(void)
+{
+    pthread_mutex_lock(&hresTimerInstance_l.mutex);
+    resetStatistics();
+    pthread_mutex_unlock(&hresTimerInstance_l.mutex);
+
+    return kErrorOk;
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief    Timer thread function
+
+The function provides the main function of the timer thread. It determines the
+timer with the earliest deadline and waits on the condition variable until the
+spin margin before this deadline is reached or a timer is changed. Within the
+spin margin, the thread polls the clock until the deadline is reached and calls
+the callback function of the timer. Continuous timers are restarted with their
+period based on the previous deadline.
+
+\param[in,out]  pArgument_p         Thread parameter. Not used!
+
+\return Returns a void* as specified by the pthread interface but it is not used!
+*/
+//------------------------------------------------------------------------------
+static void* timerThread(void* pArgument_p)
+{
+    tHresTimerInfo*     pTimerInfo;
+    tTimerEventArg      eventArg;
+    tTimerkCallback     pfnCallback;
+    ULONGLONG           deadline;
+    ULONGLONG           now;
+    UINT                changeCount;
+    struct timespec     wakeupTime;
+
+    UNUSED_PARAMETER(pArgument_p);
+
+    DEBUG_LVL_TIMERH_TRACE("%s(): ThreadId:%ld\n", __func__, syscall(SYS_gettid));
+
+    pthread_mutex_lock(&hresTimerInstance_l.mutex);
+
+    while (!hresTimerInstance_l.fTerminate)
+    {
+        pTimerInfo = getNextTimer();
+        if (pTimerInfo == NULL)
+        {   // no timer running, wait for a timer change
+            pthread_cond_wait(&hresTimerInstance_l.timerCond, &hresTimerInstance_l.mutex);
+            continue;
+        }
+
+        deadline = pTimerInfo->deadline;
+        now = getCurrentTime();
+        if ((deadline > now) && ((deadline - now) > CONFIG_HRESTIMER_SPIN_MARGIN))
+        {   // sleep until the spin margin is reached or a timer is changed
+            wakeupTime.tv_sec = (time_t)((deadline - CONFIG_HRESTIMER_SPIN_MARGIN) / HRESTIMER_NS_PER_SEC);
+            wakeupTime.tv_nsec = (long)((deadline - CONFIG_HRESTIMER_SPIN_MARGIN) % HRESTIMER_NS_PER_SEC);
+            pthread_cond_timedwait(&hresTimerInstance_l.timerCond,
+                                   &hresTimerInstance_l.mutex,
+                                   &wakeupTime);
+            continue;
+        }
+
+        // poll the clock without holding the mutex until the deadline is reached
+        changeCount = hresTimerInstance_l.changeCount;
+        pthread_mutex_unlock(&hresTimerInstance_l.mutex);
+        waitUntil(deadline);
+        now = getCurrentTime();
+        pthread_mutex_lock(&hresTimerInstance_l.mutex);
+
+        if (changeCount != hresTimerInstance_l.changeCount)
+        {   // timers were changed meanwhile, determine next timer again
+            continue;
+        }
+
+        updateStatistics(now - deadline);
+
+        OPLK_MEMCPY(&eventArg, &pTimerInfo->eventArg, sizeof(tTimerEventArg));
+        pfnCallback = pTimerInfo->pfnCallback;
+        if (pTimerInfo->fContinue)
+        {   // calculate timeout value for next timer cycle
+            pTimerInfo->deadline += pTimerInfo->period;
+        }
+        else
+        {
+            pTimerInfo->fActive = FALSE;
+        }
+
+        // the callback may modify or delete timers
+        pthread_mutex_unlock(&hresTimerInstance_l.mutex);
+        if (pfnCallback != NULL)
+            pfnCallback(&eventArg);
+        pthread_mutex_lock(&hresTimerInstance_l.mutex);
+    }
+
+    pthread_mutex_unlock(&hresTimerInstance_l.mutex);
+
+    DEBUG_LVL_TIMERH_TRACE("%s() Exiting!\n", __func__);
+    return NULL;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief    Get current time
+
+The function returns the current time of CLOCK_MONOTONIC.
+
+\return Returns the current time in nanoseconds.
+*/
+//------------------------------------------------------------------------------
+static ULONGLONG getCurrentTime(void)
+{
+    struct timespec currentTime;
+
+    clock_gettime(CLOCK_MONOTONIC, &currentTime);
+
+    return ((ULONGLONG)currentTime.tv_sec * HRESTIMER_NS_PER_SEC) + (ULONGLONG)currentTime.tv_nsec;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief    Get timer with the earliest deadline
+
+The function searches the running timer with the earliest deadline. The caller
+must hold the instance mutex.
+
+\return Returns a pointer to the timer info structure or NULL if no timer
+        is running.
+*/
+//------------------------------------------------------------------------------
+static tHresTimerInfo* getNextTimer(void)
+{
+    tHresTimerInfo*     pNextTimer = NULL;
+    ULONGLONG           deadline = HRESTIMER_DEADLINE_NONE;
+    UINT                index;
+
+    for (index = 0; index < TIMER_COUNT; index++)
+    {
+        if (hresTimerInstance_l.aTimerInfo[index].fActive &&
+            (hresTimerInstance_l.aTimerInfo[index].deadline < deadline))
+        {
+            pNextTimer = &hresTimerInstance_l.aTimerInfo[index];
+            deadline = pNextTimer->deadline;
+        }
+    }
+
+    return pNextTimer;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief    Busy-wait until a point in time
+
+The function polls CLOCK_MONOTONIC until the given time is reached.
+
+\param[in]      time_p              Time (CLOCK_MONOTONIC) in nanoseconds to wait for.
+*/
+//------------------------------------------------------------------------------
+static void waitUntil(ULONGLONG time_p)
+{
+    while (getCurrentTime() < time_p)
+        ;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief    Update timer statistics
+
+The function adds a wake-up latency to the timer statistics. The caller must
+hold the instance mutex.
+
+\param[in]      latency_p           Wake-up latency in nanoseconds.
+*/
+//------------------------------------------------------------------------------
+static void updateStatistics(ULONGLONG latency_p)
+{
+    tOplkApiTimerStatistics*    pStatistics = &hresTimerInstance_l.statistics;
+    UINT32                      latency;
+    ULONGLONG                   bucket;
+
+    latency = (latency_p > HRESTIMER_LATENCY_MAX) ? HRESTIMER_LATENCY_MAX : (UINT32)latency_p;
+
+    pStatistics->expiryCount++;
+    pStatistics->latencySum += latency;
+    if (latency < pStatistics->minLatency)
+        pStatistics->minLatency = latency;
+    if (latency > pStatistics->maxLatency)
+        pStatistics->maxLatency = latency;
+
+    bucket = latency / OPLK_TIMER_LATENCY_HISTOGRAM_RESOLUTION;
+    if (bucket >= OPLK_TIMER_LATENCY_HISTOGRAM_SIZE)
+        bucket = OPLK_TIMER_LATENCY_HISTOGRAM_SIZE - 1;
+    pStatistics->aHistogram[bucket]++;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief    Reset timer statistics
+
+The function resets the timer statistics. The caller must hold the instance
+mutex.
+*/
+//------------------------------------------------------------------------------
+static void resetStatistics(void)
+{
+    OPLK_MEMSET(&hresTimerInstance_l.statistics, 0, sizeof(tOplkApiTimerStatistics));
+    hresTimerInstance_l.statistics.minLatency = HRESTIMER_LATENCY_MAX;
+}
+
+/// \}
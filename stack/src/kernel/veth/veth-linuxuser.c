@@ -41,6 +41,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // includes
 //------------------------------------------------------------------------------
 #include <common/oplkinc.h>
+#include <common/target.h>
 #include <kernel/veth.h>
 #include <kernel/dllk.h>
 #include <kernel/dllkcal.h>
@@ -57,8 +58,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <sys/types.h>
 #include <sys/ioctl.h>
 #include <sys/stat.h>
-#include <sys/select.h>
-#include <sys/time.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
 #include <arpa/inet.h>
 #include <linux/if.h>
 #include <linux/if_tun.h>
@@ -87,11 +88,40 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // const defines
 //------------------------------------------------------------------------------
+// Maximum number of frames read from the TAP device per wakeup
+#ifndef CONFIG_VETH_BATCH_SIZE
+#define CONFIG_VETH_BATCH_SIZE              16
+#endif
+
+// Retry interval in ms while the asynchronous Tx queue of the DLL is full
+#ifndef CONFIG_VETH_TX_RETRY_INTERVAL
+#define CONFIG_VETH_TX_RETRY_INTERVAL       1
+#endif
+
+#if (CONFIG_VETH_BATCH_SIZE < 1)
+#error "CONFIG_VETH_BATCH_SIZE must be at least 1!"
+#endif
 
+#define VETH_MAX_FRAME_SIZE                 C_DLL_MAX_ETH_FRAME
+#define VETH_EPOLL_EVENT_COUNT              2
 
 //------------------------------------------------------------------------------
 // local types
 //------------------------------------------------------------------------------
+/**
+\brief Batch of frames read from the TAP device
+
+This structure holds the frames which have been read from the TAP device but
+have not yet been inserted into the asynchronous Tx queue of the DLL.
+*/
+typedef struct
+{
+    UINT8               aaBuffer[CONFIG_VETH_BATCH_SIZE][VETH_MAX_FRAME_SIZE];  ///< Frame buffers
+    tFrameInfo          aFrameInfo[CONFIG_VETH_BATCH_SIZE];                     ///< Frame info of the read frames
+    UINT                frameCount;                                             ///< Number of frames read
+    UINT                sentCount;                                              ///< Number of frames already forwarded to the DLL
+} tVethFrameBatch;
+
 /**
 \brief Structure describing an instance of the Virtual Ethernet driver
 
@@ -103,8 +133,11 @@ typedef struct
     UINT8               macAdrs[6];         ///< MAC address of the VEth interface
     UINT8               tapMacAdrs[6];      ///< MAC address of the TAP device
     int                 fd;                 ///< File descriptor of the tunnel device
-    BOOL                fStop;              ///< Flag indicating whether the receive thread shall be stopped
+    int                 epollFd;            ///< epoll instance of the receive thread
+    int                 stopEventFd;        ///< Event file descriptor to stop the receive thread
+    BOOL                fTapPaused;         ///< Flag indicating whether reading from the TAP device is paused
     pthread_t           threadHandle;       ///< Handle of the receive thread
+    tVethFrameBatch     rxBatch;            ///< Frames read from the TAP device
 } tVethInstance;
 
 //------------------------------------------------------------------------------
@@ -118,6 +151,11 @@ static tVethInstance        vethInstance_l;
 static void       getMacAdrs(UINT8* pMac_p);
 static tOplkError receiveFrameCb(tFrameInfo* pFrameInfo_p,
                                  tEdrvReleaseRxBuffer* pReleaseRxBuffer_p);
+static tOplkError createEpoll(tVethInstance* pInstance_p);
+static void       closeEpoll(tVethInstance* pInstance_p);
+static void       pauseTap(tVethInstance* pInstance_p, BOOL fPause_p);
+static void       readTapFrames(tVethInstance* pInstance_p);
+static void       forwardTapFrames(tVethInstance* pInstance_p);
 static void*      vethRecvThread(void* pArg_p);
 
 //------------------------------------------------------------------------------
@@ -164,19 +202,41 @@ tOplkError veth_init(const UINT8 aSrcMac_p[6])
         return err;
     }
 
+    // The receive thread drains the TAP device until it would block
+    if (fcntl(vethInstance_l.fd, F_SETFL, fcntl(vethInstance_l.fd, F_GETFL) | O_NONBLOCK) < 0)
+    {
+        DEBUG_LVL_VETH_TRACE("Error setting TAP device non-blocking: %s\n", strerror(errno));
+        close(vethInstance_l.fd);
+        return kErrorNoFreeInstance;
+    }
+
     // save MAC address of TAP device and Ethernet device to be able to
     // exchange them
     OPLK_MEMCPY(vethInstance_l.macAdrs, aSrcMac_p, 6);
     getMacAdrs(vethInstance_l.tapMacAdrs);
 
+    ret = createEpoll(&vethInstance_l);
+    if (ret != kErrorOk)
+    {
+        close(vethInstance_l.fd);
+        return ret;
+    }
+
     // start tap receive thread
-    vethInstance_l.fStop = FALSE;
+    vethInstance_l.rxBatch.frameCount = 0;
+    vethInstance_l.rxBatch.sentCount = 0;
     if (pthread_create(&vethInstance_l.threadHandle, NULL, vethRecvThread, (void*)&vethInstance_l) != 0)
+    {
+        closeEpoll(&vethInstance_l);
+        close(vethInstance_l.fd);
         return kErrorNoFreeInstance;
+    }
 
-#if (defined(__GLIBC__) && (__GLIBC__ >= 2) && (__GLIBC_MINOR__ >= 12))
-    pthread_setname_np(vethInstance_l.threadHandle, "oplk-veth");
-#endif
+    target_registerThread(kOplkThreadRoleVeth,
+                          vethInstance_l.threadHandle,
+                          kOplkThreadPolicyDefault,
+                          0,
+                          "oplk-veth");
 
     // register callback function in DLL
     ret = dllk_regAsyncHandler(receiveFrameCb);
@@ -197,14 +257,21 @@ The function shuts down the virtual Ethernet module.
 //------------------------------------------------------------------------------
 tOplkError veth_exit(void)
 {
-    tOplkError ret;
+    tOplkError  ret;
+    UINT64      stopEvent = 1;
 
     // Unregister the receive callback function
     ret = dllk_deregAsyncHandler(receiveFrameCb);
 
-    // stop receive thread by setting its stop flag
-    vethInstance_l.fStop = TRUE;
+    // stop receive thread by signaling its stop event
+    if (write(vethInstance_l.stopEventFd, &stopEvent, sizeof(stopEvent)) != sizeof(stopEvent))
+    {
+        DEBUG_LVL_VETH_TRACE("%s(): signaling stop event failed\n", __func__);
+    }
+
+    target_unregisterThread(kOplkThreadRoleVeth, vethInstance_l.threadHandle);
     pthread_join(vethInstance_l.threadHandle, NULL);
+    closeEpoll(&vethInstance_l);
     close(vethInstance_l.fd);
 
     return ret;
@@ -298,12 +365,203 @@ static tOplkError receiveFrameCb(tFrameInfo* pFrameInfo_p,
     return kErrorOk;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Create epoll instance of the receive thread
+
+The function creates the epoll instance of the receive thread and registers
+the TAP device and the stop event.
+
+\param[in,out]  pInstance_p         Pointer to virtual Ethernet instance.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError createEpoll(tVethInstance* pInstance_p)
+{
+    struct epoll_event  event;
+
+    pInstance_p->epollFd = epoll_create1(0);
+    if (pInstance_p->epollFd < 0)
+    {
+        DEBUG_LVL_VETH_TRACE("%s(): epoll_create1 failed: %s\n", __func__, strerror(errno));
+        return kErrorNoFreeInstance;
+    }
+
+    pInstance_p->stopEventFd = eventfd(0, 0);
+    if (pInstance_p->stopEventFd < 0)
+    {
+        DEBUG_LVL_VETH_TRACE("%s(): eventfd failed: %s\n", __func__, strerror(errno));
+        close(pInstance_p->epollFd);
+        return kErrorNoFreeInstance;
+    }
+
+    OPLK_MEMSET(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.fd = pInstance_p->stopEventFd;
+    if (epoll_ctl(pInstance_p->epollFd, EPOLL_CTL_ADD, pInstance_p->stopEventFd, &event) < 0)
+        goto Exit;
+
+    event.events = EPOLLIN;
+    event.data.fd = pInstance_p->fd;
+    if (epoll_ctl(pInstance_p->epollFd, EPOLL_CTL_ADD, pInstance_p->fd, &event) < 0)
+        goto Exit;
+
+    pInstance_p->fTapPaused = FALSE;
+
+    return kErrorOk;
+
+Exit:
+    DEBUG_LVL_VETH_TRACE("%s(): epoll_ctl failed: %s\n", __func__, strerror(errno));
+    closeEpoll(pInstance_p);
+    return kErrorNoFreeInstance;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Close epoll instance of the receive thread
+
+The function closes the epoll instance and the stop event of the receive thread.
+
+\param[in,out]  pInstance_p         Pointer to virtual Ethernet instance.
+*/
+//------------------------------------------------------------------------------
+static void closeEpoll(tVethInstance* pInstance_p)
+{
+    close(pInstance_p->stopEventFd);
+    close(pInstance_p->epollFd);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Pause or resume reading from the TAP device
+
+The function removes the TAP device from or adds it back to the events the
+receive thread waits for. While reading is paused, frames stay queued in the
+TAP device and the Linux network stack throttles the senders instead of the
+frames being dropped here.
+
+\param[in,out]  pInstance_p         Pointer to virtual Ethernet instance.
+\param[in]      fPause_p            TRUE to pause, FALSE to resume reading.
+*/
+//------------------------------------------------------------------------------
+static void pauseTap(tVethInstance* pInstance_p, BOOL fPause_p)
+{
+    struct epoll_event  event;
+
+    if (pInstance_p->fTapPaused == fPause_p)
+        return;
+
+    OPLK_MEMSET(&event, 0, sizeof(event));
+    event.events = (fPause_p != FALSE) ? 0 : EPOLLIN;
+    event.data.fd = pInstance_p->fd;
+    if (epoll_ctl(pInstance_p->epollFd, EPOLL_CTL_MOD, pInstance_p->fd, &event) < 0)
+    {
+        DEBUG_LVL_VETH_TRACE("%s(): epoll_ctl failed: %s\n", __func__, strerror(errno));
+        return;
+    }
+
+    pInstance_p->fTapPaused = fPause_p;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Read a batch of frames from the TAP device
+
+The function reads up to \ref CONFIG_VETH_BATCH_SIZE frames from the TAP
+device until it would block. The source MAC address of each frame is replaced
+by the MAC address of the virtual Ethernet interface.
+
+\param[in,out]  pInstance_p         Pointer to virtual Ethernet instance.
+*/
+//------------------------------------------------------------------------------
+static void readTapFrames(tVethInstance* pInstance_p)
+{
+    tVethFrameBatch*    pBatch = &pInstance_p->rxBatch;
+    UINT8*              pBuffer;
+    ssize_t             nread;
+
+    pBatch->frameCount = 0;
+    pBatch->sentCount = 0;
+
+    while (pBatch->frameCount < CONFIG_VETH_BATCH_SIZE)
+    {
+        pBuffer = pBatch->aaBuffer[pBatch->frameCount];
+        nread = read(pInstance_p->fd, pBuffer, VETH_MAX_FRAME_SIZE);
+        if (nread < 0)
+        {
+            if ((errno != EAGAIN) && (errno != EWOULDBLOCK) && (errno != EINTR))
+            {
+                DEBUG_LVL_VETH_TRACE("%s(): read error: %s\n", __func__, strerror(errno));
+            }
+            break;
+        }
+
+        if (nread < ETH_HLEN)
+            continue;
+
+        DEBUG_LVL_VETH_TRACE("VETH: Read %d bytes from the tap interface\n", (int)nread);
+
+        // replace src MAC address with MAC address of virtual Ethernet interface
+        OPLK_MEMCPY(&pBuffer[ETH_ALEN], pInstance_p->macAdrs, ETH_ALEN);
+
+        pBatch->aFrameInfo[pBatch->frameCount].frame.pBuffer = (tPlkFrame*)pBuffer;
+        pBatch->aFrameInfo[pBatch->frameCount].frameSize = (UINT)nread;
+        pBatch->frameCount++;
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Forward frames read from the TAP device to the DLL
+
+The function inserts the pending frames of the current batch into the
+asynchronous Tx queue of the DLL. If the queue is full, the remaining frames
+are kept and reading from the TAP device is paused until they could be
+forwarded.
+
+\param[in,out]  pInstance_p         Pointer to virtual Ethernet instance.
+*/
+//------------------------------------------------------------------------------
+static void forwardTapFrames(tVethInstance* pInstance_p)
+{
+    tVethFrameBatch*    pBatch = &pInstance_p->rxBatch;
+    tOplkError          ret;
+    UINT                sentCount;
+
+    while (pBatch->sentCount < pBatch->frameCount)
+    {
+        ret = dllkcal_sendAsyncFrames(&pBatch->aFrameInfo[pBatch->sentCount],
+                                      pBatch->frameCount - pBatch->sentCount,
+                                      kDllAsyncReqPrioGeneric,
+                                      &sentCount);
+        pBatch->sentCount += sentCount;
+
+        if (ret == kErrorDllAsyncTxBufferFull)
+        {
+            pauseTap(pInstance_p, TRUE);
+            return;
+        }
+
+        if ((ret != kErrorOk) && (pBatch->sentCount < pBatch->frameCount))
+        {
+            DEBUG_LVL_VETH_TRACE("%s(): dllkcal_sendAsyncFrames returned 0x%04X\n", __func__, ret);
+            // Drop the frame which could not be inserted
+            pBatch->sentCount++;
+        }
+    }
+
+    pauseTap(pInstance_p, FALSE);
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  Receive frame from virtual Ethernet interface
 
-The function receives a frame from the virtual Ethernet interface. It is implemented
-to be used as a thread which does a blocking read in a while loop.
+The function receives frames from the virtual Ethernet interface. It is
+implemented to be used as a thread which waits for frames of the TAP device
+and forwards them in batches to the DLL. The thread is stopped by signaling
+its stop event.
 
 \param[in,out]  pArg_p              Thread argument. Pointer to virtual Ethernet instance.
 
@@ -312,65 +570,49 @@ to be used as a thread which does a blocking read in a while loop.
 //------------------------------------------------------------------------------
 static void* vethRecvThread(void* pArg_p)
 {
-    UINT8               buffer[ETH_DATA_LEN];
-    UINT                nread;
-    tFrameInfo          frameInfo;
-    tOplkError          ret = kErrorOk;
     tVethInstance*      pInstance = (tVethInstance*)pArg_p;
-    fd_set              readFds;
-    int                 result;
-    struct timeval      timeout;
-
-    while (!pInstance->fStop)
+    struct epoll_event  aEvents[VETH_EPOLL_EVENT_COUNT];
+    int                 timeout;
+    int                 count;
+    int                 i;
+    BOOL                fStop = FALSE;
+    BOOL                fTapReadable;
+
+    while (!fStop)
     {
-        timeout.tv_sec = 0;
-        timeout.tv_usec = 400000;
+        // Wait without timeout unless frames are waiting for space in the Tx queue
+        timeout = (pInstance->fTapPaused != FALSE) ? CONFIG_VETH_TX_RETRY_INTERVAL : -1;
 
-        FD_ZERO(&readFds);
-        FD_SET(pInstance->fd, &readFds);
+        count = epoll_wait(pInstance->epollFd, aEvents, VETH_EPOLL_EVENT_COUNT, timeout);
+        if (count < 0)
+        {
+            if (errno != EINTR)
+            {
+                DEBUG_LVL_VETH_TRACE("epoll_wait error: %s\n", strerror(errno));
+            }
+            continue;
+        }
+
+        fTapReadable = FALSE;
+        for (i = 0; i < count; i++)
+        {
+            if (aEvents[i].data.fd == pInstance->stopEventFd)
+                fStop = TRUE;
+            else
+                fTapReadable = TRUE;
+        }
 
-        result = select(pInstance->fd + 1, &readFds, NULL, NULL, &timeout);
-        switch (result)
+        if (fStop)
+            break;
+
+        if (pInstance->fTapPaused != FALSE)
+        {
+            forwardTapFrames(pInstance);
+        }
+        else if (fTapReadable)
         {
-            case 0:     // timeout
-                //DEBUG_LVL_VETH_TRACE("select timeout\n");
-                break;
-
-            case -1:    // error
-                DEBUG_LVL_VETH_TRACE("select error: %s\n", strerror(errno));
-                break;
-
-            default:    // data from tun/tap ready for read
-                nread = read(pInstance->fd, buffer, ETH_DATA_LEN);
-                if (nread > 0)
-                {
-                    DEBUG_LVL_VETH_TRACE("VETH: Read %d bytes from the tap interface\n", nread);
-                    DEBUG_LVL_VETH_TRACE("SRC MAC: %02X:%02X:%02x:%02X:%02X:%02x\n",
-                                         buffer[6],
-                                         buffer[7],
-                                         buffer[8],
-                                         buffer[9],
-                                         buffer[10],
-                                         buffer[11]);
-                    DEBUG_LVL_VETH_TRACE("DST MAC: %02X:%02X:%02x:%02X:%02X:%02x\n",
-                                         buffer[0],
-                                         buffer[1],
-                                         buffer[2],
-                                         buffer[3],
-                                         buffer[4],
-                                         buffer[5]);
-                    // replace src MAC address with MAC address of virtual Ethernet interface
-                    OPLK_MEMCPY(&buffer[6], pInstance->macAdrs, ETH_ALEN);
-
-                    frameInfo.frame.pBuffer = (tPlkFrame*)buffer;
-                    frameInfo.frameSize = nread;
-                    ret = dllkcal_sendAsyncFrame(&frameInfo, kDllAsyncReqPrioGeneric);
-                    if (ret != kErrorOk)
-                    {
-                        DEBUG_LVL_VETH_TRACE("%s(): dllkcal_sendAsyncFrame returned 0x%04X\n", __func__, ret);
-                    }
-                }
-                break;
+            readTapFrames(pInstance);
+            forwardTapFrames(pInstance);
         }
     }
 
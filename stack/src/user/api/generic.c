@@ -67,6 +67,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <user/sdocom.h>
 #endif
 
+#if (defined(CONFIG_INCLUDE_SDOS) || defined(CONFIG_INCLUDE_SDOC))
+#include <user/sdoseq.h>
+#endif
+
 #if defined(CONFIG_INCLUDE_NMT_MN)
 #include <user/nmtmnu.h>
 #include <user/identu.h>
@@ -1015,6 +1019,48 @@ tOplkError oplk_abortSdo(tSdoComConHdl sdoComConHdl_p,
     return ret;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Set the SDO sequence layer window size
+
+The function sets the number of SDO frames which may be sent on an SDO
+connection before an acknowledge of the receiver is required. Larger windows
+speed up segmented transfers. The window size is applied to SDO connections
+which are established afterwards.
+
+\param[in]      windowSize_p        Number of frames in the window. The valid range
+                                    is [2 .. CONFIG_SDO_SEQ_HISTORY_SIZE].
+
+\return The function returns a \ref tOplkError error code.
+\retval kErrorOk                    The window size was successfully set.
+\retval kErrorApiInvalidParam       The window size is out of range.
+\retval kErrorIllegalInstance       No SDO stack implemented.
+
+\ingroup module_api
+*/
+//------------------------------------------------------------------------------
+tOplkError oplk_setSdoWindowSize(UINT windowSize_p)
+{
+    tOplkError  ret = kErrorOk;
+
+#if (!defined(CONFIG_INCLUDE_SDOS) && !defined(CONFIG_INCLUDE_SDOC))
+    // Ignore unused parameters
+    UNUSED_PARAMETER(windowSize_p);
+#endif
+
+    if (!ctrlu_stackIsInitialized())
+        return kErrorApiNotInitialized;
+
+#if (defined(CONFIG_INCLUDE_SDOS) || defined(CONFIG_INCLUDE_SDOC))
+    ret = sdoseq_setWindowSize(windowSize_p);
+#else
+    // no SDO stack implemented
+    ret = kErrorIllegalInstance;
+#endif
+
+    return ret;
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  Read entry from local object dictionary
@@ -1667,6 +1713,207 @@ tOplkError oplk_getSocTime(tOplkApiSocTimeInfo* pTimeInfo_p)
 #endif
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Get cycle statistics
+
+The function obtains the cycle timing histograms collected by the cyclic
+Ethernet driver of an MN. The statistics are only collected if the kernel stack
+has been compiled with CONFIG_EDRV_CYCLIC_USE_STATISTICS.
+
+\param[out]     pStatistics_p       Pointer to memory where the cycle statistics
+                                    should be stored.
+
+\return The function returns a \ref tOplkError error code.
+\retval kErrorOk                    The cycle statistics were obtained successfully.
+\retval kErrorApiNotInitialized     openPOWERLINK stack is not initialized.
+\retval kErrorApiInvalidParam       The statistics pointer is invalid.
+\retval kErrorApiNotSupported       The cycle statistics are not supported by the
+                                    kernel stack.
+\retval kErrorNoResource            The control CAL can't transfer the statistics
+                                    to the user stack.
+
+\ingroup module_api
+*/
+//------------------------------------------------------------------------------
+tOplkError oplk_getCycleStatistics(tOplkApiCycleStatistics* pStatistics_p)
+{
+    if (pStatistics_p == NULL)
+        return kErrorApiInvalidParam;
+
+    if (!ctrlu_stackIsInitialized())
+        return kErrorApiNotInitialized;
+
+    return ctrlu_getCycleStatistics(pStatistics_p);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Reset cycle statistics
+
+The function resets the cycle timing histograms collected by the cyclic
+Ethernet driver of an MN (see \ref oplk_getCycleStatistics).
+
+\return The function returns a \ref tOplkError error code.
+\retval kErrorOk                    The cycle statistics were reset successfully.
+\retval kErrorApiNotInitialized     openPOWERLINK stack is not initialized.
+\retval kErrorApiNotSupported       The cycle statistics are not supported by the
+                                    kernel stack.
+
+\ingroup module_api
+*/
+//------------------------------------------------------------------------------
+tOplkError oplk_resetCycleStatistics(void)
+{
+    if (!ctrlu_stackIsInitialized())
+        return kErrorApiNotInitialized;
+
+    return ctrlu_resetCycleStatistics();
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get high-resolution timer statistics
+
+The function obtains the wake-up latency statistics collected by the
+high-resolution timer module of the kernel stack. They are only collected by
+high-resolution timer implementations compiled with
+CONFIG_HRESTIMER_USE_STATISTICS.
+
+\param[out]     pStatistics_p       Pointer to memory where the timer statistics
+                                    should be stored.
+
+\return The function returns a \ref tOplkError error code.
+\retval kErrorOk                    The timer statistics were obtained successfully.
+\retval kErrorApiInvalidParam       The statistics pointer is invalid.
+\retval kErrorApiNotInitialized     openPOWERLINK stack is not initialized.
+\retval kErrorApiNotSupported       The timer statistics are not supported by the
+                                    kernel stack.
+\retval kErrorNoResource            The control CAL can't transfer the statistics
+                                    to the user stack.
+
+\ingroup module_api
+*/
+//------------------------------------------------------------------------------
+tOplkError oplk_getTimerStatistics(tOplkApiTimerStatistics* pStatistics_p)
+{
+    if (pStatistics_p == NULL)
+        return kErrorApiInvalidParam;
+
+    if (!ctrlu_stackIsInitialized())
+        return kErrorApiNotInitialized;
+
+    return ctrlu_getTimerStatistics(pStatistics_p);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Reset high-resolution timer statistics
+
+The function resets the wake-up latency statistics collected by the
+high-resolution timer module of the kernel stack
+(see \ref oplk_getTimerStatistics).
+
+\return The function returns a \ref tOplkError error code.
+\retval kErrorOk                    The timer statistics were reset successfully.
+\retval kErrorApiNotInitialized     openPOWERLINK stack is not initialized.
+\retval kErrorApiNotSupported       The timer statistics are not supported by the
+                                    kernel stack.
+
+\ingroup module_api
+*/
+//------------------------------------------------------------------------------
+tOplkError oplk_resetTimerStatistics(void)
+{
+    if (!ctrlu_stackIsInitialized())
+        return kErrorApiNotInitialized;
+
+    return ctrlu_resetTimerStatistics();
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Set thread parameters of a stack thread role
+
+The function sets the CPU affinity, the scheduling policy, the priority and the
+name of all threads of the given role. The parameters are applied immediately
+to threads which are already running and are stored for threads which are
+created later on (e.g. by \ref oplk_initialize()).
+
+Only threads of the calling process are affected. If the kernel part of the
+stack runs in a separate process (e.g. the Linux PCAP daemon), the kernel
+threads must be configured by the command line or the configuration file of
+this process.
+
+\param[in]      role_p              The thread role to be configured.
+\param[in]      pThreadParam_p      Pointer to the thread parameters.
+
+\return The function returns a \ref tOplkError error code.
+\retval kErrorOk                    The thread parameters were set successfully.
+\retval kErrorApiInvalidParam       An invalid parameter was passed.
+\retval kErrorNoResource            The parameters could not be applied to a
+                                    running thread.
+\retval kErrorApiNotSupported       The thread configuration is not supported
+                                    on this target.
+
+\ingroup module_api
+*/
+//------------------------------------------------------------------------------
+tOplkError oplk_setThreadParameters(tOplkThreadRole role_p,
+                                    const tOplkThreadParameters* pThreadParam_p)
+{
+#if ((TARGET_SYSTEM == _LINUX_) && !defined(__KERNEL__))
+    if ((pThreadParam_p == NULL) || (role_p >= kOplkThreadRoleCount))
+        return kErrorApiInvalidParam;
+
+    return target_setThreadParameters(role_p, pThreadParam_p);
+#else
+    UNUSED_PARAMETER(role_p);
+    UNUSED_PARAMETER(pThreadParam_p);
+
+    return kErrorApiNotSupported;
+#endif
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get achieved thread parameters of a stack thread role
+
+The function reads back the CPU affinity, the scheduling policy, the priority
+and the name which were actually achieved by the first running thread of the
+given role. Only threads of the calling process can be reported (see
+\ref oplk_setThreadParameters).
+
+\param[in]      role_p              The thread role to be reported.
+\param[out]     pThreadParam_p      Pointer to store the achieved thread
+                                    parameters.
+
+\return The function returns a \ref tOplkError error code.
+\retval kErrorOk                    The thread parameters were read successfully.
+\retval kErrorApiInvalidParam       An invalid parameter was passed.
+\retval kErrorIllegalInstance       No thread of the role is running.
+\retval kErrorApiNotSupported       The thread configuration is not supported
+                                    on this target.
+
+\ingroup module_api
+*/
+//------------------------------------------------------------------------------
+tOplkError oplk_getThreadParameters(tOplkThreadRole role_p,
+                                    tOplkThreadParameters* pThreadParam_p)
+{
+#if ((TARGET_SYSTEM == _LINUX_) && !defined(__KERNEL__))
+    if ((pThreadParam_p == NULL) || (role_p >= kOplkThreadRoleCount))
+        return kErrorApiInvalidParam;
+
+    return target_getThreadParameters(role_p, pThreadParam_p);
+#else
+    UNUSED_PARAMETER(role_p);
+    UNUSED_PARAMETER(pThreadParam_p);
+
+    return kErrorApiNotSupported;
+#endif
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  Exchange input application process data
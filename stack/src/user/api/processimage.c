@@ -83,6 +83,8 @@ typedef struct
 {
     tOplkApiProcessImage        inputImage;     ///< Input process image
     tOplkApiProcessImage        outputImage;    ///< Output process image
+    BOOL                        fZeroCopyOut;   ///< Output process image is provided directly from the RXPDO buffer
+    void*                       pZeroCopyOut;   ///< Current RXPDO buffer used as output process image
 } tApiProcessImageInstance;
 
 //------------------------------------------------------------------------------
@@ -91,7 +93,9 @@ typedef struct
 static tApiProcessImageInstance instance_l =
 {
     { NULL, 0 },
-    { NULL, 0 }
+    { NULL, 0 },
+    FALSE,
+    NULL
 };
 
 //------------------------------------------------------------------------------
@@ -205,6 +209,9 @@ tOplkError oplk_freeProcessImage(void)
         instance_l.outputImage.imageSize = 0;
     }
 
+    instance_l.fZeroCopyOut = FALSE;
+    instance_l.pZeroCopyOut = NULL;
+
     return ret;
 }
 
@@ -342,10 +349,22 @@ tOplkError oplk_exchangeProcessImageOut(void)
     if (!ctrlu_stackIsInitialized())
         return kErrorApiNotInitialized;
 
-    if (instance_l.outputImage.pImage != NULL)
-        ret = pdou_copyRxPdoToPi();
-    else
-        ret = kErrorApiPINotAllocated;
+    if (instance_l.outputImage.pImage == NULL)
+        return kErrorApiPINotAllocated;
+
+    if (instance_l.fZeroCopyOut)
+    {
+        ret = pdou_getRxPdoImage(instance_l.outputImage.pImage,
+                                 instance_l.outputImage.imageSize,
+                                 &instance_l.pZeroCopyOut);
+        if (ret != kErrorApiNotSupported)
+            return ret;
+
+        // PDO layout does not match the process image, fall back to copying
+        instance_l.pZeroCopyOut = NULL;
+    }
+
+    ret = pdou_copyRxPdoToPi();
 
     return ret;
 }
@@ -387,9 +406,53 @@ void* oplk_getProcessImageOut(void)
     if (!ctrlu_stackIsInitialized())
         return NULL;
 
+    if (instance_l.pZeroCopyOut != NULL)
+        return instance_l.pZeroCopyOut;
+
     return instance_l.outputImage.pImage;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Enable zero-copy output process image
+
+The function enables or disables the zero-copy mode of the output process
+image. In this mode oplk_exchangeProcessImageOut() does not copy the RXPDOs
+into the output process image but only switches to the newest RXPDO buffer.
+oplk_getProcessImageOut() then returns a pointer directly into this buffer.
+The pointer is valid until the next call of oplk_exchangeProcessImageOut(),
+therefore the application must fetch it after every exchange.
+
+The zero-copy mode is only used if a single RPDO channel is active and its
+objects are linked to the output process image at the offsets they have in the
+PDO. Otherwise the process image is copied as usual. In zero-copy mode the
+objects linked to the output process image are not updated.
+
+\param[in]      fEnable_p           Enable (TRUE) or disable (FALSE) the
+                                    zero-copy mode.
+
+\return The function returns a \ref tOplkError error code.
+\retval kErrorOk                    Zero-copy mode is successfully changed.
+\retval kErrorApiPINotAllocated     Memory for process images is not allocated.
+\retval kErrorApiNotInitialized     openPOWERLINK stack is not initialized.
+
+\ingroup module_api
+*/
+//------------------------------------------------------------------------------
+tOplkError oplk_enableProcessImageZeroCopy(BOOL fEnable_p)
+{
+    if (!ctrlu_stackIsInitialized())
+        return kErrorApiNotInitialized;
+
+    if (instance_l.outputImage.pImage == NULL)
+        return kErrorApiPINotAllocated;
+
+    instance_l.fZeroCopyOut = fEnable_p;
+    instance_l.pZeroCopyOut = NULL;
+
+    return kErrorOk;
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  Setup process image
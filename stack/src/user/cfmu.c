@@ -47,6 +47,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <common/ami.h>
 #include <user/cfmu.h>
 #include <user/sdocom.h>
+#include <user/sdocomint.h>
 #include <user/identu.h>
 #include <user/nmtu.h>
 #include <user/obdu.h>
@@ -70,10 +71,55 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define CONFIG_CFM_CONFIGURE_CYCLE_LENGTH   FALSE
 #endif
 
+// download only the changed ConciseDCF entries to CNs which still hold the
+// configuration stored by the last download
+#ifndef CONFIG_CFM_DIFFERENTIAL_DOWNLOAD
+#define CONFIG_CFM_DIFFERENTIAL_DOWNLOAD    FALSE
+#endif
+
 // return pointer to node info structure for specified node ID
 // d.k. may be replaced by special (hash) function if node ID array is smaller than 254
 #define CFM_GET_NODEINFO(nodeId_p)  (cfmInstance_g.apNodeInfo[nodeId_p - 1])
 
+// size of the header of one sub-entry in a WriteMultipleParamByIndex request
+#define CFM_MULTI_WRITE_SUB_HDR_SIZE    8
+
+// maximum number of objects in one WriteMultipleParamByIndex request
+// (each sub-entry occupies at least the header and 4 bytes of padded data)
+#define CFM_MULTI_WRITE_MAX_ENTRIES     (SDO_CMD_SEGM_TX_MAX_SIZE / (CFM_MULTI_WRITE_SUB_HDR_SIZE + 4))
+
+// maximum number of configuration downloads which run concurrently
+// (further CNs are queued). Every running download keeps SDO frames in the
+// asynchronous Tx queue of the MN, which is served by one asynchronous phase
+// per cycle. More downloads do not finish the boot sooner, they only fill the
+// queue until it overflows.
+#ifndef CONFIG_CFM_MAX_CONCURRENT_DOWNLOADS
+#if (CONFIG_SDO_MAX_CONNECTION_COM < 8)
+#define CONFIG_CFM_MAX_CONCURRENT_DOWNLOADS CONFIG_SDO_MAX_CONNECTION_COM
+#else
+#define CONFIG_CFM_MAX_CONCURRENT_DOWNLOADS 8
+#endif
+#endif
+
+#if (CONFIG_CFM_MAX_CONCURRENT_DOWNLOADS < 1)
+#error "CONFIG_CFM_MAX_CONCURRENT_DOWNLOADS must be at least 1!"
+#endif
+
+#if (CONFIG_CFM_DIFFERENTIAL_DOWNLOAD != FALSE)
+// PDO mapping objects, which must be disabled while their entries or the
+// entries of the corresponding communication objects are changed
+#define CFM_OBD_IDX_RX_COMM_PARAM       0x1400
+#define CFM_OBD_IDX_TX_COMM_PARAM       0x1800
+#define CFM_OBD_IDX_RX_MAPP_PARAM       0x1600
+#define CFM_OBD_IDX_TX_MAPP_PARAM       0x1A00
+#define CFM_OBD_IDX_MAPP_PARAM          0x0200
+#define CFM_OBD_IDX_MASK                0xFF00
+
+// FNV-1a parameters for the entry value digests
+#define CFM_DIGEST_FNV_OFFSET_BASIS     0xCBF29CE484222325ULL
+#define CFM_DIGEST_FNV_PRIME            0x00000100000001B3ULL
+#endif
+
 //------------------------------------------------------------------------------
 // module global vars
 //------------------------------------------------------------------------------
@@ -108,6 +154,7 @@ typedef enum
     kCfmStateWaitStore,                                     ///< The CFM has issued a store command and is awaiting the acknowledge
     kCfmStateUpToDate,                                      ///< The CN is up-to-date (no configuration download is required)
     kCfmStateInternalAbort,                                 ///< The CFM has aborted due to an internal failure
+    kCfmStateQueued,                                        ///< The CFM waits for a free download slot
 } eCfmState;
 
 /**
@@ -117,6 +164,35 @@ Data type for the enumerator \ref eCfmState.
 */
 typedef UINT32 tCfmState;
 
+#if (CONFIG_CFM_DIFFERENTIAL_DOWNLOAD != FALSE)
+/**
+\brief ConciseDCF entry digest
+
+The following structure defines the digest of one ConciseDCF entry.
+*/
+typedef struct
+{
+    UINT32                  key;                            ///< Object index (bits 8-23) and subindex (bits 0-7)
+    UINT32                  entryNum;                       ///< Position of the entry in the ConciseDCF
+    UINT64                  valueHash;                      ///< Hash over the size and value of the entry
+} tCfmEntryDigest;
+
+/**
+\brief ConciseDCF digest
+
+The following structure defines the digest of a ConciseDCF. It contains the
+digest of the final value of every object entry, sorted by object index and
+subindex.
+*/
+typedef struct
+{
+    UINT32                  confDate;                       ///< Expected configuration date of the ConciseDCF (0x1F26)
+    UINT32                  confTime;                       ///< Expected configuration time of the ConciseDCF (0x1F27)
+    UINT                    entryCount;                     ///< Number of entry digests
+    tCfmEntryDigest*        paEntries;                      ///< Entry digests (NULL if the digest is invalid)
+} tCfmDcfDigest;
+#endif
+
 /**
 \brief CFM node information structure
 
@@ -134,6 +210,19 @@ typedef struct
     tCfmState               cfmState;                       ///< Current CFM state for the CN
     UINT                    curDataSize;                    ///< Size of the current entry to be written via SDO
     BOOL                    fDoStore;                       ///< Flag indicating whether a store command shall be issued
+    BOOL                    fDownloadSlot;                  ///< Flag indicating that the CN occupies a download slot
+    tCfmState               startState;                     ///< State in which the queued download will be started
+    UINT32                  queueTicket;                    ///< Queue position of the download (lowest is started first)
+#if (CONFIG_CFM_DIFFERENTIAL_DOWNLOAD != FALSE)
+    tCfmDcfDigest           storedDigest;                   ///< Digest of the configuration last stored on the CN
+    tCfmDcfDigest           pendingDigest;                  ///< Digest of the configuration of the active download
+    UINT8*                  pSendFlags;                     ///< Bitmap of the entries to be downloaded (NULL: download all entries)
+    UINT32                  entryCount;                     ///< Number of entries of the active download
+#endif
+    BOOL                    fMultiWrite;                    ///< Flag indicating whether entries are downloaded with WriteMultipleParamByIndex
+    BOOL                    fMultiWriteSubAborted;          ///< Flag indicating that the CN rejected an object of the current multi-write request
+    tSdoMultiAccEntry       aMultiAcc[CFM_MULTI_WRITE_MAX_ENTRIES]; ///< Objects of the current multi-write request
+    UINT8                   aMultiBuffer[SDO_MAX_TX_FRAME_SIZE];    ///< Command layer buffer of the current multi-write request
 } tCfmNodeInfo;
 
 /**
@@ -150,6 +239,10 @@ typedef struct
 #endif
     tCfmCbEventCnProgress   pfnCbEventCnProgress;           ///< Pointer to the CN progress callback function
     tCfmCbEventCnResult     pfnCbEventCnResult;             ///< Pointer to the CN result callback function
+    UINT                    activeDownloads;                ///< Number of occupied download slots
+    UINT                    queuedDownloads;                ///< Number of queued downloads
+    UINT32                  queueTicket;                    ///< Queue position for the next queued download
+    BOOL                    fProcessingQueue;               ///< Flag indicating that the download queue is being processed
 } tCfmInstance;
 
 //------------------------------------------------------------------------------
@@ -167,11 +260,47 @@ static tOplkError    finishConfig(tCfmNodeInfo* pNodeInfo_p,
                                   tNmtNodeCommand nmtNodeCommand_p);
 static tOplkError    downloadCycleLength(tCfmNodeInfo* pNodeInfo_p);
 static tOplkError    downloadObject(tCfmNodeInfo* pNodeInfo_p);
+static tOplkError    downloadMultipleObjects(tCfmNodeInfo* pNodeInfo_p);
+static UINT          packMultipleObjects(tCfmNodeInfo* pNodeInfo_p);
 static tOplkError    sdoWriteObject(tCfmNodeInfo* pNodeInfo_p,
                                     const void* pLeSrcData_p,
                                     UINT size_p);
+static tOplkError    sdoInitTransfer(tCfmNodeInfo* pNodeInfo_p,
+                                     tSdoComTransParamByIndex* pTransParam_p);
 static tOplkError    cbSdoCon(const tSdoComFinished* pSdoComFinished_p);
+static tOplkError    cbSdoConMultiWrite(tCfmNodeInfo* pNodeInfo_p,
+                                        const tSdoComFinished* pSdoComFinished_p);
 static tOplkError    finishDownload(tCfmNodeInfo* pNodeInfo_p);
+static tOplkError    scheduleDownload(tCfmNodeInfo* pNodeInfo_p,
+                                      tCfmState startState_p);
+static tOplkError    startDownload(tCfmNodeInfo* pNodeInfo_p);
+static void          queueDownload(tCfmNodeInfo* pNodeInfo_p,
+                                   tCfmState startState_p);
+static void          releaseDownloadSlot(tCfmNodeInfo* pNodeInfo_p);
+static void          processDownloadQueue(void);
+static BOOL          isNoFreeSdoHandle(tOplkError ret_p);
+static BOOL          isEntryRequired(const tCfmNodeInfo* pNodeInfo_p,
+                                     UINT entryOffset_p);
+
+#if (CONFIG_CFM_DIFFERENTIAL_DOWNLOAD != FALSE)
+static BOOL          prepareDigest(tCfmNodeInfo* pNodeInfo_p,
+                                   const tIdentResponse* pIdentResponse_p);
+static tOplkError    calcEntryDigests(const tCfmNodeInfo* pNodeInfo_p,
+                                      tCfmEntryDigest** ppaEntries_p);
+static UINT64        calcEntryHash(const UINT8* pEntry_p,
+                                   UINT32 dataSize_p);
+static void          sortEntryDigests(tCfmEntryDigest* paEntries_p,
+                                      UINT count_p);
+static BOOL          selectChangedEntries(tCfmNodeInfo* pNodeInfo_p,
+                                          const tCfmEntryDigest* paEntries_p,
+                                          UINT count_p);
+static BOOL          selectMappingSwitches(const tCfmEntryDigest* paEntries_p,
+                                           UINT count_p,
+                                           UINT8* pSendFlags_p);
+static void          skipUnchangedEntries(tCfmNodeInfo* pNodeInfo_p);
+static void          commitDigest(tCfmNodeInfo* pNodeInfo_p);
+static void          freeDigest(tCfmDcfDigest* pDigest_p);
+#endif
 
 #if defined(CONFIG_INCLUDE_NMT_RMN)
 static tOplkError    downloadNetConf(tCfmNodeInfo* pNodeInfo_p);
@@ -203,22 +332,15 @@ tOplkError cfmu_init(tCfmCbEventCnProgress pfnCbEventCnProgress_p,
 {
     tOplkError  ret = kErrorOk;
     UINT        subindex;
-    tVarParam   varParam;
 
     OPLK_MEMSET(&cfmInstance_g, 0, sizeof(tCfmInstance));
 
     cfmInstance_g.pfnCbEventCnProgress = pfnCbEventCnProgress_p;
     cfmInstance_g.pfnCbEventCnResult = pfnCbEventCnResult_p;
 
-    // link domain with 4 zero-bytes to object 0x1F22 CFM_ConciseDcfList_ADOM
-    varParam.pData = &cfmInstance_g.leDomainSizeNull;
-    varParam.size = (tObdSize)sizeof(cfmInstance_g.leDomainSizeNull);
-    varParam.index = 0x1F22;    // CFM_ConciseDcfList_ADOM
     for (subindex = 1; subindex <= NMT_MAX_NODE_ID; subindex++)
     {
-        varParam.subindex = subindex;
-        varParam.validFlag = kVarValidAll;
-        ret = obdu_defineVar(&varParam);
+        ret = cfmu_linkDefaultConciseDcf(subindex);
         if ((ret != kErrorOk) &&
             (ret != kErrorObdIndexNotExist) &&
             (ret != kErrorObdSubindexNotExist))
@@ -230,6 +352,36 @@ tOplkError cfmu_init(tCfmCbEventCnProgress pfnCbEventCnProgress_p,
     return ret;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Link the default ConciseDCF of a node
+
+The function links the sub-index of object 0x1F22 (CFM_ConciseDcfList_ADOM)
+which belongs to the specified node to an empty ConciseDCF. Modules which link
+their own memory to object 0x1F22 restore the default with this function before
+the memory is released.
+
+\param[in]      nodeId_p            Node ID for which the default is linked.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_cfmu
+*/
+//------------------------------------------------------------------------------
+tOplkError cfmu_linkDefaultConciseDcf(UINT nodeId_p)
+{
+    tVarParam   varParam;
+
+    // link domain with 4 zero-bytes to object 0x1F22 CFM_ConciseDcfList_ADOM
+    varParam.pData = &cfmInstance_g.leDomainSizeNull;
+    varParam.size = (tObdSize)sizeof(cfmInstance_g.leDomainSizeNull);
+    varParam.index = 0x1F22;    // CFM_ConciseDcfList_ADOM
+    varParam.subindex = nodeId_p;
+    varParam.validFlag = kVarValidAll;
+
+    return obdu_defineVar(&varParam);
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  Exit CFM module
@@ -271,6 +423,12 @@ tOplkError cfmu_exit(void)
                 OPLK_FREE(pBuffer);
                 pNodeInfo->pObdBufferConciseDcf = NULL;
             }
+#if (CONFIG_CFM_DIFFERENTIAL_DOWNLOAD != FALSE)
+            freeDigest(&pNodeInfo->storedDigest);
+            freeDigest(&pNodeInfo->pendingDigest);
+            if (pNodeInfo->pSendFlags != NULL)
+                OPLK_FREE(pNodeInfo->pSendFlags);
+#endif
             OPLK_FREE(pNodeInfo);
             CFM_GET_NODEINFO(nodeId) = NULL;
         }
@@ -305,7 +463,6 @@ tOplkError cfmu_processNodeEvent(UINT nodeId_p,
                                  tNmtState nmtState_p)
 {
     tOplkError              ret = kErrorOk;
-    static UINT32           leSignature;
     tCfmNodeInfo*           pNodeInfo = NULL;
     tObdSize                obdSize;
     UINT32                  expConfTime = 0;
@@ -325,6 +482,9 @@ tOplkError cfmu_processNodeEvent(UINT nodeId_p,
 
     if (pNodeInfo->cfmState != kCfmStateIdle)
     {
+        if (pNodeInfo->cfmState == kCfmStateQueued)
+            cfmInstance_g.queuedDownloads--;
+
         // Send abort if SDO command is not undefined
         if (pNodeInfo->sdoComConHdl != UINT_MAX)
         {
@@ -347,6 +507,10 @@ tOplkError cfmu_processNodeEvent(UINT nodeId_p,
 
         // Set node CFM state to idle
         pNodeInfo->cfmState = kCfmStateIdle;
+
+        // pass the download slot on to the next queued CN
+        releaseDownloadSlot(pNodeInfo);
+        processDownloadQueue();
     }
 
     if ((nodeEvent_p == kNmtNodeEventFound) ||
@@ -370,6 +534,7 @@ tOplkError cfmu_processNodeEvent(UINT nodeId_p,
     pNodeInfo->eventCnProgress.totalNumberOfBytes += sizeof(UINT32);
 #endif
     pNodeInfo->eventCnProgress.bytesDownloaded = 0;
+    pNodeInfo->eventCnProgress.bytesSkipped = 0;
     pNodeInfo->eventCnProgress.error = kErrorOk;
     if (obdSize < sizeof(UINT32))
     {
@@ -405,6 +570,10 @@ tOplkError cfmu_processNodeEvent(UINT nodeId_p,
     }
 #endif
 
+    // download consecutive entries in one request if the CN supports it
+    pNodeInfo->fMultiWrite = ((ami_getUint32Le(&pIdentResponse->featureFlagsLe) &
+                               NMT_FEATUREFLAGS_SDO_RW_MULTIPLE) != 0);
+
     pNodeInfo->entriesRemaining = ami_getUint32Le(pNodeInfo->pDataConciseDcf);
     pNodeInfo->pDataConciseDcf += sizeof(UINT32);
     pNodeInfo->bytesRemaining -= sizeof(UINT32);
@@ -478,17 +647,21 @@ tOplkError cfmu_processNodeEvent(UINT nodeId_p,
     }
     else if (nodeEvent_p == kNmtNodeEventUpdateConf)
     {
-        pNodeInfo->cfmState = kCfmStateDownload;
-        ret = downloadObject(pNodeInfo);
-        if (ret == kErrorOk)
-        {   // SDO transfer started
-            ret = kErrorReject;
-        }
+#if (CONFIG_CFM_DIFFERENTIAL_DOWNLOAD != FALSE)
+        // the CN has been restored, so the complete ConciseDCF is downloaded
+        prepareDigest(pNodeInfo, NULL);
+#endif
+        ret = scheduleDownload(pNodeInfo, kCfmStateDownload);
     }
+#if (CONFIG_CFM_DIFFERENTIAL_DOWNLOAD != FALSE)
+    else if (prepareDigest(pNodeInfo, (fDoNetConf ? NULL : pIdentResponse)))
+    {
+        DEBUG_LVL_CFM_TRACE("CN%x - Cfg Mismatch | Downloading changed entries only\n", nodeId_p);
+        ret = scheduleDownload(pNodeInfo, kCfmStateDownload);
+    }
+#endif
     else
     {
-        pNodeInfo->cfmState = kCfmStateWaitRestore;
-
 #if defined(CONFIG_INCLUDE_NMT_RMN)
         if (pNodeInfo->entriesRemaining == 0)
         {
@@ -504,21 +677,8 @@ tOplkError cfmu_processNodeEvent(UINT nodeId_p,
         }
 
         //Restore Default Parameters
-        pNodeInfo->eventCnProgress.totalNumberOfBytes += sizeof(leSignature);
-        ami_setUint32Le(&leSignature, 0x64616F6C);
-
-        pNodeInfo->eventCnProgress.objectIndex = 0x1011;
-        pNodeInfo->eventCnProgress.objectSubIndex = 0x01;
-        ret = sdoWriteObject(pNodeInfo, &leSignature, sizeof(leSignature));
-        if (ret == kErrorOk)
-        {   // SDO transfer started
-            ret = kErrorReject;
-        }
-        else
-        {
-            // error occurred
-            DEBUG_LVL_CFM_TRACE("CfmCbEvent(Node): sdoWriteObject() returned 0x%02X\n", ret);
-        }
+        pNodeInfo->eventCnProgress.totalNumberOfBytes += sizeof(UINT32);
+        ret = scheduleDownload(pNodeInfo, kCfmStateWaitRestore);
     }
 
     return ret;
@@ -583,6 +743,11 @@ tOplkError cfmu_cbObdAccess(tObdCbParam* pParam_p)
     pNodeInfo = CFM_GET_NODEINFO(pParam_p->subIndex);
     if ((pNodeInfo != NULL) && (pNodeInfo->sdoComConHdl != UINT_MAX))
         ret = sdocom_abortTransfer(pNodeInfo->sdoComConHdl, SDO_AC_DATA_NOT_TRANSF_DUE_DEVICE_STATE);
+    else if ((pNodeInfo != NULL) && (pNodeInfo->cfmState == kCfmStateQueued))
+    {   // a queued download must not use the replaced ConciseDCF
+        cfmInstance_g.queuedDownloads--;
+        ret = finishConfig(pNodeInfo, kNmtNodeCommandConfErr);
+    }
 
     pMemVStringDomain = (tObdVStringDomain*)pParam_p->pArg;
     if ((pMemVStringDomain->objSize != pMemVStringDomain->downloadSize) ||
@@ -698,6 +863,18 @@ static tOplkError finishConfig(tCfmNodeInfo* pNodeInfo_p,
 {
     tOplkError  ret = kErrorOk;
 
+    releaseDownloadSlot(pNodeInfo_p);
+
+#if (CONFIG_CFM_DIFFERENTIAL_DOWNLOAD != FALSE)
+    // the digest of a successful download has already been committed
+    freeDigest(&pNodeInfo_p->pendingDigest);
+    if (pNodeInfo_p->pSendFlags != NULL)
+    {
+        OPLK_FREE(pNodeInfo_p->pSendFlags);
+        pNodeInfo_p->pSendFlags = NULL;
+    }
+#endif
+
     if (pNodeInfo_p->sdoComConHdl != UINT_MAX)
     {
         ret = sdocom_undefineConnection(pNodeInfo_p->sdoComConHdl);
@@ -713,6 +890,9 @@ static tOplkError finishConfig(tCfmNodeInfo* pNodeInfo_p,
     if (cfmInstance_g.pfnCbEventCnResult != NULL)
         ret = cfmInstance_g.pfnCbEventCnResult(pNodeInfo_p->eventCnProgress.nodeId, nmtNodeCommand_p);
 
+    // start the next queued download
+    processDownloadQueue();
+
     return ret;
 }
 
@@ -737,6 +917,9 @@ static tOplkError cbSdoCon(const tSdoComFinished* pSdoComFinished_p)
     if (pNodeInfo == NULL)
         return kErrorInvalidNodeId;
 
+    if (pSdoComFinished_p->sdoAccessType == kSdoAccessTypeMultiWrite)
+        return cbSdoConMultiWrite(pNodeInfo, pSdoComFinished_p);
+
     pNodeInfo->eventCnProgress.sdoAbortCode = pSdoComFinished_p->abortCode;
     pNodeInfo->eventCnProgress.bytesDownloaded += pSdoComFinished_p->transferredBytes;
 
@@ -796,6 +979,10 @@ static tOplkError cbSdoCon(const tSdoComFinished* pSdoComFinished_p)
             break;
 
         case kCfmStateWaitStore:
+#if (CONFIG_CFM_DIFFERENTIAL_DOWNLOAD != FALSE)
+            if (pSdoComFinished_p->sdoComConState == kSdoComTransferFinished)
+                commitDigest(pNodeInfo);
+#endif
             ret = downloadCycleLength(pNodeInfo);
             if (ret == kErrorReject)
             {
@@ -814,6 +1001,85 @@ static tOplkError cbSdoCon(const tSdoComFinished* pSdoComFinished_p)
     return ret;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  SDO finished callback function for multi-write transfers
+
+The function processes the result of a WriteMultipleParamByIndex request. For
+every object of a confirmed request the progress is reported and the ConciseDCF
+position is forwarded. Objects rejected by the CN are reported with their abort
+code and cause a configuration error. If the CN rejects the whole request, the
+objects are downloaded again one by one.
+
+\param[in,out]  pNodeInfo_p         Node info of the node which has been written to.
+\param[in]      pSdoComFinished_p   Pointer to SDO COM finished structure.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError cbSdoConMultiWrite(tCfmNodeInfo* pNodeInfo_p,
+                                     const tSdoComFinished* pSdoComFinished_p)
+{
+    tOplkError                  ret = kErrorOk;
+    const tSdoMultiAccEntry*    pMultiAcc;
+    UINT                        multiAccCnt;
+
+    if (pSdoComFinished_p->sdoComConState == kSdoComTransferRxSubAborted)
+    {   // single object rejected by the CN, the transfer is finished afterwards
+        pNodeInfo_p->fMultiWriteSubAborted = TRUE;
+        pNodeInfo_p->eventCnProgress.objectIndex = pSdoComFinished_p->targetIndex;
+        pNodeInfo_p->eventCnProgress.objectSubIndex = pSdoComFinished_p->targetSubIndex;
+        pNodeInfo_p->eventCnProgress.sdoAbortCode = pSdoComFinished_p->abortCode;
+        return callCbProgress(pNodeInfo_p);
+    }
+
+    if (pNodeInfo_p->cfmState == kCfmStateInternalAbort)
+        return ret;     // configuration was aborted
+
+    if ((pNodeInfo_p->cfmState == kCfmStateDownload) &&
+        (pSdoComFinished_p->sdoComConState == kSdoComTransferRxAborted))
+    {   // CN does not support the command, continue with single transfers
+        DEBUG_LVL_CFM_TRACE("CN%x rejected multi-write with 0x%08X\n",
+                            pNodeInfo_p->eventCnProgress.nodeId,
+                            pSdoComFinished_p->abortCode);
+        pNodeInfo_p->fMultiWrite = FALSE;
+        return downloadObject(pNodeInfo_p);
+    }
+
+    if ((pNodeInfo_p->cfmState != kCfmStateDownload) ||
+        (pSdoComFinished_p->sdoComConState != kSdoComTransferFinished) ||
+        (pSdoComFinished_p->abortCode != 0) ||
+        pNodeInfo_p->fMultiWriteSubAborted)
+    {   // configuration was not successful
+        pNodeInfo_p->eventCnProgress.sdoAbortCode = pSdoComFinished_p->abortCode;
+        ret = callCbProgress(pNodeInfo_p);
+        if (ret != kErrorOk)
+            return ret;
+
+        return finishConfig(pNodeInfo_p, kNmtNodeCommandConfErr);
+    }
+
+    // report progress for every written object
+    pMultiAcc = pNodeInfo_p->aMultiAcc;
+    for (multiAccCnt = pSdoComFinished_p->multiSubAccCnt; multiAccCnt > 0; multiAccCnt--)
+    {
+        pNodeInfo_p->eventCnProgress.objectIndex = pMultiAcc->index;
+        pNodeInfo_p->eventCnProgress.objectSubIndex = pMultiAcc->subIndex;
+        pNodeInfo_p->eventCnProgress.bytesDownloaded += CDC_OFFSET_DATA + pMultiAcc->dataSize;
+        pNodeInfo_p->pDataConciseDcf += CDC_OFFSET_DATA + pMultiAcc->dataSize;
+        pNodeInfo_p->bytesRemaining -= (UINT32)(CDC_OFFSET_DATA + pMultiAcc->dataSize);
+        pNodeInfo_p->entriesRemaining--;
+
+        ret = callCbProgress(pNodeInfo_p);
+        if (ret != kErrorOk)
+            return ret;
+
+        pMultiAcc++;
+    }
+
+    return downloadObject(pNodeInfo_p);
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  Download cycle length
@@ -871,9 +1137,24 @@ static tOplkError downloadObject(tCfmNodeInfo* pNodeInfo_p)
     // forward data pointer for last transfer
     pNodeInfo_p->pDataConciseDcf += pNodeInfo_p->curDataSize;
     pNodeInfo_p->bytesRemaining -= pNodeInfo_p->curDataSize;
+    pNodeInfo_p->curDataSize = 0;
+
+#if (CONFIG_CFM_DIFFERENTIAL_DOWNLOAD != FALSE)
+    skipUnchangedEntries(pNodeInfo_p);
+#endif
 
     if (pNodeInfo_p->entriesRemaining > 0)
     {
+        if (pNodeInfo_p->fMultiWrite)
+        {
+            ret = downloadMultipleObjects(pNodeInfo_p);
+            if (ret != kErrorReject)
+                return ret;
+
+            // the following entry is downloaded on its own
+            ret = kErrorOk;
+        }
+
         if (pNodeInfo_p->bytesRemaining < CDC_OFFSET_DATA)
         {
             // not enough bytes left in ConciseDCF
@@ -926,6 +1207,104 @@ static tOplkError downloadObject(tCfmNodeInfo* pNodeInfo_p)
     return ret;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Download multiple objects
+
+The function downloads the next consecutive objects from the ConciseDCF to the
+specified node with a single WriteMultipleParamByIndex request.
+
+\param[in,out]  pNodeInfo_p         Node info of the node for which to download the
+                                    next objects.
+
+\return The function returns a tOplkError error code.
+\retval kErrorReject                Less than two objects fit into one request,
+                                    the next object shall be downloaded on its own.
+*/
+//------------------------------------------------------------------------------
+static tOplkError downloadMultipleObjects(tCfmNodeInfo* pNodeInfo_p)
+{
+    tSdoComTransParamByIndex    transParamByIndex;
+    UINT                        multiAccCnt;
+
+    multiAccCnt = packMultipleObjects(pNodeInfo_p);
+    if (multiAccCnt < 2)
+        return kErrorReject;
+
+    pNodeInfo_p->fMultiWriteSubAborted = FALSE;
+
+    // the first object is also used by the command layer for its parameter check
+    transParamByIndex.pData = pNodeInfo_p->aMultiAcc[0].pData_le;
+    transParamByIndex.dataSize = pNodeInfo_p->aMultiAcc[0].dataSize;
+    transParamByIndex.index = (UINT16)pNodeInfo_p->aMultiAcc[0].index;
+    transParamByIndex.subindex = (UINT8)pNodeInfo_p->aMultiAcc[0].subIndex;
+    transParamByIndex.sdoAccessType = kSdoAccessTypeMultiWrite;
+    transParamByIndex.paMultiAcc = pNodeInfo_p->aMultiAcc;
+    transParamByIndex.multiAccCnt = multiAccCnt;
+    transParamByIndex.pMultiBuffer = pNodeInfo_p->aMultiBuffer;
+    transParamByIndex.multiBufSize = sizeof(pNodeInfo_p->aMultiBuffer);
+
+    return sdoInitTransfer(pNodeInfo_p, &transParamByIndex);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Pack objects for a multi-write request
+
+The function collects the next consecutive objects of the ConciseDCF which fit
+into one WriteMultipleParamByIndex request. The ConciseDCF position is not
+changed, it is forwarded when the request has been confirmed. The collection
+stops at the first invalid entry, which is then reported by the single object
+download.
+
+\param[in,out]  pNodeInfo_p         Node info of the node for which to pack the
+                                    objects.
+
+\return The function returns the number of packed objects.
+*/
+//------------------------------------------------------------------------------
+static UINT packMultipleObjects(tCfmNodeInfo* pNodeInfo_p)
+{
+    UINT8*              pData = pNodeInfo_p->pDataConciseDcf;
+    UINT32              bytesRemaining = pNodeInfo_p->bytesRemaining;
+    size_t              cmdSegmSize = 0;
+    UINT                dataSize;
+    UINT                multiAccCnt = 0;
+    tSdoMultiAccEntry*  pMultiAcc = pNodeInfo_p->aMultiAcc;
+
+    while ((multiAccCnt < CFM_MULTI_WRITE_MAX_ENTRIES) &&
+           (multiAccCnt < pNodeInfo_p->entriesRemaining))
+    {
+        if (bytesRemaining < CDC_OFFSET_DATA)
+            break;
+
+        // stop at entries which are skipped by a differential download
+        if (!isEntryRequired(pNodeInfo_p, multiAccCnt))
+            break;
+
+        dataSize = (UINT)ami_getUint32Le(&pData[CDC_OFFSET_SIZE]);
+        if ((dataSize == 0) || ((bytesRemaining - CDC_OFFSET_DATA) < dataSize))
+            break;
+
+        // sub-entry header and data padded to 4 bytes
+        cmdSegmSize += CFM_MULTI_WRITE_SUB_HDR_SIZE + ((dataSize + 3) & ~3U);
+        if (cmdSegmSize > SDO_CMD_SEGM_TX_MAX_SIZE)
+            break;
+
+        pMultiAcc->index = ami_getUint16Le(&pData[CDC_OFFSET_INDEX]);
+        pMultiAcc->subIndex = ami_getUint8Le(&pData[CDC_OFFSET_SUBINDEX]);
+        pMultiAcc->pData_le = &pData[CDC_OFFSET_DATA];
+        pMultiAcc->dataSize = dataSize;
+
+        pData += CDC_OFFSET_DATA + dataSize;
+        bytesRemaining -= CDC_OFFSET_DATA + dataSize;
+        pMultiAcc++;
+        multiAccCnt++;
+    }
+
+    return multiAccCnt;
+}
+
 #if defined(CONFIG_INCLUDE_NMT_RMN)
 //------------------------------------------------------------------------------
 /**
@@ -1063,12 +1442,39 @@ static tOplkError sdoWriteObject(tCfmNodeInfo* pNodeInfo_p,
                                  const void* pLeSrcData_p,
                                  UINT size_p)
 {
-    tOplkError                  ret = kErrorOk;
     tSdoComTransParamByIndex    transParamByIndex;
 
     if ((pLeSrcData_p == NULL) || (size_p == 0))
         return kErrorApiInvalidParam;
 
+    transParamByIndex.pData = (void*)pLeSrcData_p;
+    transParamByIndex.sdoAccessType = kSdoAccessTypeWrite;
+    transParamByIndex.dataSize = size_p;
+    transParamByIndex.index = (UINT16)pNodeInfo_p->eventCnProgress.objectIndex;
+    transParamByIndex.subindex = (UINT8)pNodeInfo_p->eventCnProgress.objectSubIndex;
+
+    return sdoInitTransfer(pNodeInfo_p, &transParamByIndex);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Initialize SDO transfer
+
+The function starts the prepared SDO write transfer to the specified node. It
+sets up the command layer connection if necessary.
+
+\param[in,out]  pNodeInfo_p         Node info of the node to write to.
+\param[in,out]  pTransParam_p       Transfer parameters with the data and the access
+                                    type already set.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError sdoInitTransfer(tCfmNodeInfo* pNodeInfo_p,
+                                  tSdoComTransParamByIndex* pTransParam_p)
+{
+    tOplkError  ret = kErrorOk;
+
     if (pNodeInfo_p->sdoComConHdl == UINT_MAX)
     {
         // init command layer connection
@@ -1076,24 +1482,22 @@ static tOplkError sdoWriteObject(tCfmNodeInfo* pNodeInfo_p,
                                       pNodeInfo_p->eventCnProgress.nodeId,
                                       kSdoTypeAsnd);
         if ((ret != kErrorOk) && (ret != kErrorSdoComHandleExists))
+        {
+            pNodeInfo_p->sdoComConHdl = UINT_MAX;
             return ret;
+        }
     }
 
-    transParamByIndex.pData = (void*)pLeSrcData_p;
-    transParamByIndex.sdoAccessType = kSdoAccessTypeWrite;
-    transParamByIndex.sdoComConHdl = pNodeInfo_p->sdoComConHdl;
-    transParamByIndex.dataSize = size_p;
-    transParamByIndex.index = (UINT16)pNodeInfo_p->eventCnProgress.objectIndex;
-    transParamByIndex.subindex = (UINT8)pNodeInfo_p->eventCnProgress.objectSubIndex;
-    transParamByIndex.pfnSdoFinishedCb = cbSdoCon;
-    transParamByIndex.pUserArg = pNodeInfo_p;
+    pTransParam_p->sdoComConHdl = pNodeInfo_p->sdoComConHdl;
+    pTransParam_p->pfnSdoFinishedCb = cbSdoCon;
+    pTransParam_p->pUserArg = pNodeInfo_p;
 
-    ret = sdocom_initTransferByIndex(&transParamByIndex);
+    ret = sdocom_initTransferByIndex(pTransParam_p);
     if (ret == kErrorSdoComHandleBusy)
     {
         ret = sdocom_abortTransfer(pNodeInfo_p->sdoComConHdl, SDO_AC_DATA_NOT_TRANSF_DUE_LOCAL_CONTROL);
         if (ret == kErrorOk)
-            ret = sdocom_initTransferByIndex(&transParamByIndex);
+            ret = sdocom_initTransferByIndex(pTransParam_p);
     }
     else if (ret == kErrorSdoSeqConnectionBusy)
     {
@@ -1114,11 +1518,742 @@ static tOplkError sdoWriteObject(tCfmNodeInfo* pNodeInfo_p,
             return ret;
 
         // retry transfer
-        transParamByIndex.sdoComConHdl = pNodeInfo_p->sdoComConHdl;
-        ret = sdocom_initTransferByIndex(&transParamByIndex);
+        pTransParam_p->sdoComConHdl = pNodeInfo_p->sdoComConHdl;
+        ret = sdocom_initTransferByIndex(pTransParam_p);
     }
 
     return ret;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Schedule configuration download
+
+The function starts the configuration download of the specified node if a
+download slot is free. Otherwise the download is queued and started as soon as
+the download of another CN has finished. This allows configuring all booting
+CNs concurrently while at most CONFIG_CFM_MAX_CONCURRENT_DOWNLOADS SDO
+connections compete for the asynchronous phases of the MN.
+
+\param[in,out]  pNodeInfo_p         Node info of the node to be configured.
+\param[in]      startState_p        CFM state in which the download is started
+                                    (kCfmStateWaitRestore or kCfmStateDownload).
+
+\return The function returns a tOplkError error code.
+\retval kErrorReject                The download was started or queued.
+*/
+//------------------------------------------------------------------------------
+static tOplkError scheduleDownload(tCfmNodeInfo* pNodeInfo_p,
+                                   tCfmState startState_p)
+{
+    tOplkError  ret = kErrorOk;
+
+    if (cfmInstance_g.activeDownloads >= CONFIG_CFM_MAX_CONCURRENT_DOWNLOADS)
+    {
+        queueDownload(pNodeInfo_p, startState_p);
+        return kErrorReject;
+    }
+
+    // the SDO connection is defined in advance, so that the download can be
+    // queued again if all connections are occupied by other downloads
+    if (pNodeInfo_p->sdoComConHdl == UINT_MAX)
+    {
+        ret = sdocom_defineConnection(&pNodeInfo_p->sdoComConHdl,
+                                      pNodeInfo_p->eventCnProgress.nodeId,
+                                      kSdoTypeAsnd);
+        if (ret == kErrorSdoComHandleExists)
+            ret = kErrorOk;
+        else if (ret != kErrorOk)
+        {
+            pNodeInfo_p->sdoComConHdl = UINT_MAX;
+            if (isNoFreeSdoHandle(ret) && (cfmInstance_g.activeDownloads > 0))
+            {
+                queueDownload(pNodeInfo_p, startState_p);
+                return kErrorReject;
+            }
+        }
+    }
+
+    if (pNodeInfo_p->cfmState == kCfmStateQueued)
+        cfmInstance_g.queuedDownloads--;
+
+    pNodeInfo_p->cfmState = startState_p;
+    if (ret == kErrorOk)
+    {
+        pNodeInfo_p->fDownloadSlot = TRUE;
+        cfmInstance_g.activeDownloads++;
+
+        ret = startDownload(pNodeInfo_p);
+        if (ret == kErrorOk)
+        {   // SDO transfer started
+            return kErrorReject;
+        }
+
+        releaseDownloadSlot(pNodeInfo_p);
+    }
+
+    // error occurred
+    DEBUG_LVL_CFM_TRACE("CN%x - Starting download returned 0x%02X\n",
+                        pNodeInfo_p->eventCnProgress.nodeId,
+                        ret);
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Start configuration download
+
+The function issues the first SDO transfer of the configuration download of
+the specified node depending on its CFM state.
+
+\param[in,out]  pNodeInfo_p         Node info of the node to be configured.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError startDownload(tCfmNodeInfo* pNodeInfo_p)
+{
+    static UINT32   leSignature;
+
+    if (pNodeInfo_p->cfmState == kCfmStateDownload)
+        return downloadObject(pNodeInfo_p);
+
+    // restore default parameters
+    ami_setUint32Le(&leSignature, 0x64616F6C);
+
+    pNodeInfo_p->eventCnProgress.objectIndex = 0x1011;
+    pNodeInfo_p->eventCnProgress.objectSubIndex = 0x01;
+    return sdoWriteObject(pNodeInfo_p, &leSignature, sizeof(leSignature));
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Queue configuration download
+
+The function queues the configuration download of the specified node. A node
+which is queued again keeps its queue position.
+
+\param[in,out]  pNodeInfo_p         Node info of the node to be configured.
+\param[in]      startState_p        CFM state in which the download is started.
+*/
+//------------------------------------------------------------------------------
+static void queueDownload(tCfmNodeInfo* pNodeInfo_p,
+                          tCfmState startState_p)
+{
+    if (pNodeInfo_p->cfmState != kCfmStateQueued)
+    {
+        pNodeInfo_p->queueTicket = cfmInstance_g.queueTicket++;
+        pNodeInfo_p->cfmState = kCfmStateQueued;
+        cfmInstance_g.queuedDownloads++;
+    }
+
+    pNodeInfo_p->startState = startState_p;
+
+    DEBUG_LVL_CFM_TRACE("CN%x - Download queued (%u active, %u queued)\n",
+                        pNodeInfo_p->eventCnProgress.nodeId,
+                        cfmInstance_g.activeDownloads,
+                        cfmInstance_g.queuedDownloads);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Release download slot
+
+The function releases the download slot occupied by the specified node.
+
+\param[in,out]  pNodeInfo_p         Node info of the node.
+*/
+//------------------------------------------------------------------------------
+static void releaseDownloadSlot(tCfmNodeInfo* pNodeInfo_p)
+{
+    if (pNodeInfo_p->fDownloadSlot)
+    {
+        pNodeInfo_p->fDownloadSlot = FALSE;
+        cfmInstance_g.activeDownloads--;
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Process download queue
+
+The function starts queued downloads in queue order as long as download slots
+are free. Downloads which cannot be started are finished with a configuration
+error, because the boot process of the CN waits for the CFM result.
+*/
+//------------------------------------------------------------------------------
+static void processDownloadQueue(void)
+{
+    tOplkError      ret;
+    tCfmNodeInfo*   pNodeInfo;
+    tCfmNodeInfo*   pNextNodeInfo;
+    UINT            nodeId;
+
+    // downloads finished while processing the queue are picked up by the loop
+    if (cfmInstance_g.fProcessingQueue)
+        return;
+
+    cfmInstance_g.fProcessingQueue = TRUE;
+
+    while ((cfmInstance_g.queuedDownloads > 0) &&
+           (cfmInstance_g.activeDownloads < CONFIG_CFM_MAX_CONCURRENT_DOWNLOADS))
+    {
+        pNextNodeInfo = NULL;
+        for (nodeId = 1; nodeId <= NMT_MAX_NODE_ID; nodeId++)
+        {
+            pNodeInfo = CFM_GET_NODEINFO(nodeId);
+            if ((pNodeInfo != NULL) &&
+                (pNodeInfo->cfmState == kCfmStateQueued) &&
+                ((pNextNodeInfo == NULL) ||
+                 ((INT32)(pNodeInfo->queueTicket - pNextNodeInfo->queueTicket) < 0)))
+                pNextNodeInfo = pNodeInfo;
+        }
+
+        if (pNextNodeInfo == NULL)
+        {   // the counter is out of sync, which must not happen
+            cfmInstance_g.queuedDownloads = 0;
+            break;
+        }
+
+        ret = scheduleDownload(pNextNodeInfo, pNextNodeInfo->startState);
+        if (pNextNodeInfo->cfmState == kCfmStateQueued)
+        {   // no free SDO connection, wait for the next finished download
+            break;
+        }
+
+        if ((ret != kErrorReject) && (pNextNodeInfo->cfmState != kCfmStateIdle))
+            finishConfig(pNextNodeInfo, kNmtNodeCommandConfErr);
+    }
+
+    cfmInstance_g.fProcessingQueue = FALSE;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Check for missing SDO connection
+
+The function determines if an error code signals that no SDO connection is
+available in one of the SDO layers.
+
+\param[in]      ret_p               Error code to check.
+
+\return The function returns TRUE if no SDO connection is available.
+*/
+//------------------------------------------------------------------------------
+static BOOL isNoFreeSdoHandle(tOplkError ret_p)
+{
+    return ((ret_p == kErrorSdoComNoFreeHandle) ||
+            (ret_p == kErrorSdoSeqNoFreeHandle) ||
+            (ret_p == kErrorSdoAsndNoFreeHandle));
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Check if ConciseDCF entry has to be downloaded
+
+The function determines if a ConciseDCF entry has to be downloaded. All
+entries are downloaded unless a differential download is active.
+
+\param[in]      pNodeInfo_p         Node info of the node.
+\param[in]      entryOffset_p       Offset of the entry relative to the next
+                                    entry to be downloaded.
+
+\return The function returns TRUE if the entry has to be downloaded.
+*/
+//------------------------------------------------------------------------------
+static BOOL isEntryRequired(const tCfmNodeInfo* pNodeInfo_p,
+                            UINT entryOffset_p)
+{
+#if (CONFIG_CFM_DIFFERENTIAL_DOWNLOAD != FALSE)
+    UINT32  entryNum;
+
+    if (pNodeInfo_p->pSendFlags == NULL)
+        return TRUE;
+
+    entryNum = pNodeInfo_p->entryCount - pNodeInfo_p->entriesRemaining + entryOffset_p;
+    return ((pNodeInfo_p->pSendFlags[entryNum >> 3] & (1 << (entryNum & 7))) != 0);
+#else
+    UNUSED_PARAMETER(pNodeInfo_p);
+    UNUSED_PARAMETER(entryOffset_p);
+
+    return TRUE;
+#endif
+}
+
+#if (CONFIG_CFM_DIFFERENTIAL_DOWNLOAD != FALSE)
+//------------------------------------------------------------------------------
+/**
+\brief  Prepare ConciseDCF digest for a download
+
+The function calculates the digest of the ConciseDCF which is about to be
+downloaded. It is committed as digest of the stored CN configuration when the
+CN has acknowledged the store command.
+
+If the CN reports the configuration date and time of the stored digest, the
+CN still holds the configuration of the last download. In this case only the
+entries whose final value differs from the stored digest are selected for the
+download. If an entry of a PDO mapping or of its communication parameter is
+downloaded, the writes of subindex 0 which disable and re-enable the mapping
+are included.
+
+\param[in,out]  pNodeInfo_p         Node info of the node to be configured.
+\param[in]      pIdentResponse_p    IdentResponse of the CN. If it is NULL, the
+                                    complete ConciseDCF is downloaded.
+
+\return The function returns TRUE if a differential download shall be
+        performed, and FALSE if the complete ConciseDCF shall be downloaded.
+*/
+//------------------------------------------------------------------------------
+static BOOL prepareDigest(tCfmNodeInfo* pNodeInfo_p,
+                          const tIdentResponse* pIdentResponse_p)
+{
+    tOplkError          ret;
+    tCfmEntryDigest*    paEntries = NULL;
+    tCfmDcfDigest*      pPending = &pNodeInfo_p->pendingDigest;
+    tObdSize            obdSize;
+    BOOL                fDifferential = FALSE;
+    UINT                count;
+    UINT                entryCount;
+
+    freeDigest(pPending);
+    if (pNodeInfo_p->pSendFlags != NULL)
+    {
+        OPLK_FREE(pNodeInfo_p->pSendFlags);
+        pNodeInfo_p->pSendFlags = NULL;
+    }
+    pNodeInfo_p->entryCount = pNodeInfo_p->entriesRemaining;
+
+    // the configuration of the CN is about to change
+    if (pNodeInfo_p->fDoStore && (pNodeInfo_p->entriesRemaining > 0))
+        ret = calcEntryDigests(pNodeInfo_p, &paEntries);
+    else
+        ret = kErrorCfmNoConfigData;
+
+    if (ret != kErrorOk)
+    {
+        freeDigest(&pNodeInfo_p->storedDigest);
+        return FALSE;
+    }
+
+    if ((pIdentResponse_p != NULL) &&
+        (pNodeInfo_p->storedDigest.paEntries != NULL) &&
+        (ami_getUint32Le(&pIdentResponse_p->verifyConfigurationDateLe) == pNodeInfo_p->storedDigest.confDate) &&
+        (ami_getUint32Le(&pIdentResponse_p->verifyConfigurationTimeLe) == pNodeInfo_p->storedDigest.confTime))
+    {
+        fDifferential = selectChangedEntries(pNodeInfo_p, paEntries, pNodeInfo_p->entryCount);
+    }
+
+    freeDigest(&pNodeInfo_p->storedDigest);
+
+    // keep the digest of the final value of every object entry
+    entryCount = 0;
+    for (count = 0; count < pNodeInfo_p->entryCount; count++)
+    {
+        if ((count + 1 < pNodeInfo_p->entryCount) &&
+            (paEntries[count + 1].key == paEntries[count].key))
+            continue;
+
+        paEntries[entryCount++] = paEntries[count];
+    }
+
+    pPending->paEntries = paEntries;
+    pPending->entryCount = entryCount;
+
+    obdSize = sizeof(pPending->confDate);
+    ret = obdu_readEntry(0x1F26, pNodeInfo_p->eventCnProgress.nodeId, &pPending->confDate, &obdSize);
+    if (ret != kErrorOk)
+        pPending->confDate = 0;
+
+    obdSize = sizeof(pPending->confTime);
+    ret = obdu_readEntry(0x1F27, pNodeInfo_p->eventCnProgress.nodeId, &pPending->confTime, &obdSize);
+    if (ret != kErrorOk)
+        pPending->confTime = 0;
+
+    return fDifferential;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Calculate ConciseDCF entry digests
+
+The function calculates the digests of all entries of the ConciseDCF which is
+about to be downloaded and sorts them by object index, subindex and position.
+
+\param[in]      pNodeInfo_p         Node info of the node to be configured.
+\param[out]     ppaEntries_p        Pointer to store the allocated entry digests.
+
+\return The function returns a tOplkError error code.
+\retval kErrorCfmInvalidDcf         The ConciseDCF is invalid.
+*/
+//------------------------------------------------------------------------------
+static tOplkError calcEntryDigests(const tCfmNodeInfo* pNodeInfo_p,
+                                   tCfmEntryDigest** ppaEntries_p)
+{
+    tCfmEntryDigest*    paEntries;
+    const UINT8*        pData = pNodeInfo_p->pDataConciseDcf;
+    UINT32              bytesRemaining = pNodeInfo_p->bytesRemaining;
+    UINT32              dataSize;
+    UINT32              count;
+
+    paEntries = (tCfmEntryDigest*)OPLK_MALLOC(pNodeInfo_p->entryCount * sizeof(tCfmEntryDigest));
+    if (paEntries == NULL)
+        return kErrorNoResource;
+
+    for (count = 0; count < pNodeInfo_p->entryCount; count++)
+    {
+        if (bytesRemaining < CDC_OFFSET_DATA)
+            break;
+
+        dataSize = ami_getUint32Le(&pData[CDC_OFFSET_SIZE]);
+        if ((dataSize == 0) || ((bytesRemaining - CDC_OFFSET_DATA) < dataSize))
+            break;
+
+        paEntries[count].key = ((UINT32)ami_getUint16Le(&pData[CDC_OFFSET_INDEX]) << 8) |
+                               ami_getUint8Le(&pData[CDC_OFFSET_SUBINDEX]);
+        paEntries[count].entryNum = count;
+        paEntries[count].valueHash = calcEntryHash(pData, dataSize);
+
+        pData += CDC_OFFSET_DATA + dataSize;
+        bytesRemaining -= CDC_OFFSET_DATA + dataSize;
+    }
+
+    if (count < pNodeInfo_p->entryCount)
+    {   // invalid entries are reported by the download
+        OPLK_FREE(paEntries);
+        return kErrorCfmInvalidDcf;
+    }
+
+    sortEntryDigests(paEntries, pNodeInfo_p->entryCount);
+
+    *ppaEntries_p = paEntries;
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Calculate hash of a ConciseDCF entry
+
+The function calculates the FNV-1a hash over the size and value of a ConciseDCF
+entry.
+
+\param[in]      pEntry_p            Pointer to the ConciseDCF entry.
+\param[in]      dataSize_p          Data size of the entry.
+
+\return The function returns the hash of the entry.
+*/
+//------------------------------------------------------------------------------
+static UINT64 calcEntryHash(const UINT8* pEntry_p,
+                            UINT32 dataSize_p)
+{
+    UINT64  hash = CFM_DIGEST_FNV_OFFSET_BASIS;
+    UINT32  byteCount;
+
+    for (byteCount = CDC_OFFSET_SIZE; byteCount < CDC_OFFSET_DATA + dataSize_p; byteCount++)
+    {
+        hash ^= pEntry_p[byteCount];
+        hash *= CFM_DIGEST_FNV_PRIME;
+    }
+
+    return hash;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Sort ConciseDCF entry digests
+
+The function sorts the entry digests by object index and subindex. Entries of
+the same object entry are kept in ConciseDCF order.
+
+\param[in,out]  paEntries_p         Entry digests to be sorted.
+\param[in]      count_p             Number of entry digests.
+*/
+//------------------------------------------------------------------------------
+static void sortEntryDigests(tCfmEntryDigest* paEntries_p,
+                             UINT count_p)
+{
+    UINT            gap;
+    UINT            count;
+    UINT            pos;
+    tCfmEntryDigest entry;
+
+    // Shell sort, the ConciseDCF is mostly sorted already
+    for (gap = count_p / 2; gap > 0; gap /= 2)
+    {
+        for (count = gap; count < count_p; count++)
+        {
+            entry = paEntries_p[count];
+            for (pos = count; pos >= gap; pos -= gap)
+            {
+                if ((paEntries_p[pos - gap].key < entry.key) ||
+                    ((paEntries_p[pos - gap].key == entry.key) &&
+                     (paEntries_p[pos - gap].entryNum < entry.entryNum)))
+                    break;
+
+                paEntries_p[pos] = paEntries_p[pos - gap];
+            }
+            paEntries_p[pos] = entry;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Select changed ConciseDCF entries
+
+The function compares the entry digests of the new ConciseDCF with the stored
+digest and marks the entries which have to be downloaded.
+
+\param[in,out]  pNodeInfo_p         Node info of the node to be configured.
+\param[in]      paEntries_p         Sorted entry digests of the new ConciseDCF.
+\param[in]      count_p             Number of entry digests.
+
+\return The function returns TRUE if a differential download is possible.
+        It returns FALSE if an object entry of the stored configuration is
+        not contained in the new ConciseDCF, because only a restore of the
+        default configuration resets such entries. It also returns FALSE if
+        a changed PDO communication parameter cannot be written while the
+        corresponding mapping is disabled (see selectMappingSwitches()).
+*/
+//------------------------------------------------------------------------------
+static BOOL selectChangedEntries(tCfmNodeInfo* pNodeInfo_p,
+                                 const tCfmEntryDigest* paEntries_p,
+                                 UINT count_p)
+{
+    const tCfmDcfDigest*    pStored = &pNodeInfo_p->storedDigest;
+    UINT8*                  pSendFlags;
+    UINT                    storedPos = 0;
+    UINT                    count = 0;
+    UINT                    indexFirst;
+    UINT                    keyFirst;
+    UINT                    pos;
+    UINT32                  index;
+    UINT32                  key;
+    BOOL                    fChanged;
+    BOOL                    fIndexChanged;
+
+    pSendFlags = (UINT8*)OPLK_MALLOC((count_p + 7) / 8);
+    if (pSendFlags == NULL)
+        return FALSE;
+
+    OPLK_MEMSET(pSendFlags, 0, (count_p + 7) / 8);
+
+    while (count < count_p)
+    {
+        index = paEntries_p[count].key >> 8;
+        indexFirst = count;
+        fIndexChanged = FALSE;
+
+        while ((count < count_p) && ((paEntries_p[count].key >> 8) == index))
+        {
+            key = paEntries_p[count].key;
+            keyFirst = count;
+            while ((count < count_p) && (paEntries_p[count].key == key))
+                count++;
+
+            if ((storedPos < pStored->entryCount) && (pStored->paEntries[storedPos].key < key))
+            {   // stored object entry is no longer configured
+                OPLK_FREE(pSendFlags);
+                return FALSE;
+            }
+
+            if ((storedPos < pStored->entryCount) && (pStored->paEntries[storedPos].key == key))
+            {   // compare the final value of the object entry
+                fChanged = (pStored->paEntries[storedPos].valueHash != paEntries_p[count - 1].valueHash);
+                storedPos++;
+            }
+            else
+                fChanged = TRUE;
+
+            if (fChanged)
+            {
+                fIndexChanged = TRUE;
+                for (pos = keyFirst; pos < count; pos++)
+                    pSendFlags[paEntries_p[pos].entryNum >> 3] |= (UINT8)(1 << (paEntries_p[pos].entryNum & 7));
+            }
+        }
+
+        if (fIndexChanged &&
+            (((index & CFM_OBD_IDX_MASK) == CFM_OBD_IDX_RX_MAPP_PARAM) ||
+             ((index & CFM_OBD_IDX_MASK) == CFM_OBD_IDX_TX_MAPP_PARAM)))
+        {   // disable and re-enable the changed mapping
+            for (pos = indexFirst; (pos < count) && ((paEntries_p[pos].key & 0xFF) == 0); pos++)
+                pSendFlags[paEntries_p[pos].entryNum >> 3] |= (UINT8)(1 << (paEntries_p[pos].entryNum & 7));
+        }
+    }
+
+    if ((storedPos < pStored->entryCount) ||
+        !selectMappingSwitches(paEntries_p, count_p, pSendFlags))
+    {   // stored object entry is no longer configured or PDO cannot be changed
+        OPLK_FREE(pSendFlags);
+        return FALSE;
+    }
+
+    pNodeInfo_p->pSendFlags = pSendFlags;
+    return TRUE;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Select PDO mapping switches of changed communication parameters
+
+A CN rejects writes to a PDO communication parameter object (0x14xx/0x18xx)
+while the corresponding mapping (0x16xx/0x1Axx) is enabled. For every changed
+communication parameter the function selects the subindex 0 entries of the
+corresponding mapping object, i.e. the write which disables the mapping before
+the communication parameter is written and the write which enables it again.
+
+\param[in]      paEntries_p         Sorted entry digests of the new ConciseDCF.
+\param[in]      count_p             Number of entry digests.
+\param[in,out]  pSendFlags_p        Bitmap of the entries to be downloaded.
+
+\return The function returns FALSE if the ConciseDCF does not disable the
+        mapping before a changed communication parameter is written. Such a
+        ConciseDCF only works with the default configuration of the CN, thus,
+        the complete ConciseDCF has to be downloaded after a restore.
+*/
+//------------------------------------------------------------------------------
+static BOOL selectMappingSwitches(const tCfmEntryDigest* paEntries_p,
+                                  UINT count_p,
+                                  UINT8* pSendFlags_p)
+{
+    UINT8       aDisableEntry[CDC_OFFSET_DATA + 1];
+    UINT64      disableHash;
+    UINT        count = 0;
+    UINT        pos;
+    UINT        low;
+    UINT        high;
+    UINT32      index;
+    UINT32      mappKey;
+    UINT32      entryNum;
+    UINT32      firstChanged;
+    BOOL        fChanged;
+    BOOL        fDisabled;
+
+    // digest of a subindex 0 entry which disables the mapping
+    OPLK_MEMSET(aDisableEntry, 0, sizeof(aDisableEntry));
+    ami_setUint32Le(&aDisableEntry[CDC_OFFSET_SIZE], 1);
+    disableHash = calcEntryHash(aDisableEntry, 1);
+
+    while (count < count_p)
+    {
+        index = paEntries_p[count].key >> 8;
+        fChanged = FALSE;
+        firstChanged = 0;
+
+        for (; (count < count_p) && ((paEntries_p[count].key >> 8) == index); count++)
+        {
+            entryNum = paEntries_p[count].entryNum;
+            if (((pSendFlags_p[entryNum >> 3] & (1 << (entryNum & 7))) != 0) &&
+                (!fChanged || (entryNum < firstChanged)))
+            {
+                firstChanged = entryNum;
+                fChanged = TRUE;
+            }
+        }
+
+        if (!fChanged ||
+            (((index & CFM_OBD_IDX_MASK) != CFM_OBD_IDX_RX_COMM_PARAM) &&
+             ((index & CFM_OBD_IDX_MASK) != CFM_OBD_IDX_TX_COMM_PARAM)))
+            continue;
+
+        // find the subindex 0 entries of the mapping object
+        mappKey = (index | CFM_OBD_IDX_MAPP_PARAM) << 8;
+        low = count;
+        high = count_p;
+        while (low < high)
+        {
+            pos = low + ((high - low) / 2);
+            if (paEntries_p[pos].key < mappKey)
+                low = pos + 1;
+            else
+                high = pos;
+        }
+
+        // the last write before the communication parameter must disable the mapping
+        fDisabled = FALSE;
+        for (pos = low; (pos < count_p) && (paEntries_p[pos].key == mappKey); pos++)
+        {
+            if (paEntries_p[pos].entryNum < firstChanged)
+                fDisabled = (paEntries_p[pos].valueHash == disableHash);
+
+            pSendFlags_p[paEntries_p[pos].entryNum >> 3] |= (UINT8)(1 << (paEntries_p[pos].entryNum & 7));
+        }
+
+        if (!fDisabled)
+            return FALSE;
+    }
+
+    return TRUE;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Skip unchanged ConciseDCF entries
+
+The function forwards the ConciseDCF position over all entries which are not
+downloaded by a differential download and reports the skipped bytes.
+
+\param[in,out]  pNodeInfo_p         Node info of the node to be configured.
+*/
+//------------------------------------------------------------------------------
+static void skipUnchangedEntries(tCfmNodeInfo* pNodeInfo_p)
+{
+    UINT32  entrySize;
+    size_t  bytesSkipped = 0;
+
+    // the entries have been validated when the digest was calculated
+    while ((pNodeInfo_p->entriesRemaining > 0) && !isEntryRequired(pNodeInfo_p, 0))
+    {
+        entrySize = CDC_OFFSET_DATA + ami_getUint32Le(&pNodeInfo_p->pDataConciseDcf[CDC_OFFSET_SIZE]);
+        pNodeInfo_p->pDataConciseDcf += entrySize;
+        pNodeInfo_p->bytesRemaining -= entrySize;
+        pNodeInfo_p->entriesRemaining--;
+        bytesSkipped += entrySize;
+    }
+
+    if (bytesSkipped > 0)
+    {
+        pNodeInfo_p->eventCnProgress.bytesSkipped += bytesSkipped;
+        callCbProgress(pNodeInfo_p);
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Commit ConciseDCF digest
+
+The function commits the digest of the active download as digest of the
+configuration stored on the CN.
+
+\param[in,out]  pNodeInfo_p         Node info of the node.
+*/
+//------------------------------------------------------------------------------
+static void commitDigest(tCfmNodeInfo* pNodeInfo_p)
+{
+    freeDigest(&pNodeInfo_p->storedDigest);
+    pNodeInfo_p->storedDigest = pNodeInfo_p->pendingDigest;
+    pNodeInfo_p->pendingDigest.paEntries = NULL;
+    pNodeInfo_p->pendingDigest.entryCount = 0;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Free ConciseDCF digest
+
+The function frees the entry digests of a ConciseDCF digest.
+
+\param[in,out]  pDigest_p           ConciseDCF digest to be freed.
+*/
+//------------------------------------------------------------------------------
+static void freeDigest(tCfmDcfDigest* pDigest_p)
+{
+    if (pDigest_p->paEntries != NULL)
+        OPLK_FREE(pDigest_p->paEntries);
+
+    pDigest_p->paEntries = NULL;
+    pDigest_p->entryCount = 0;
+}
+#endif
+
 /// \}
@@ -876,6 +876,117 @@ size_t ctrlu_getMaxFileChunkSize(void)
     return ctrlucal_getFileBufferSize();
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Get high-resolution timer statistics
+
+This function requests the high-resolution timer statistics from the kernel
+stack and reads them from the statistics transfer buffer.
+
+\param[out]     pStatistics_p       Pointer to store the timer statistics.
+
+\return The function returns a \ref tOplkError error code.
+
+\ingroup module_ctrlu
+*/
+//------------------------------------------------------------------------------
+tOplkError ctrlu_getTimerStatistics(tOplkApiTimerStatistics* pStatistics_p)
+{
+    tOplkError      ret;
+    UINT16          retval;
+
+    // Check parameter validity
+    ASSERT(pStatistics_p != NULL);
+
+    ret = ctrlucal_executeCmd(kCtrlGetTimerStatistics, &retval);
+    if (ret != kErrorOk)
+        return ret;
+
+    if (retval != kErrorOk)
+        return (tOplkError)retval;
+
+    return ctrlucal_readStatistics(pStatistics_p, sizeof(tOplkApiTimerStatistics));
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Reset high-resolution timer statistics
+
+This function resets the high-resolution timer statistics of the kernel stack.
+
+\return The function returns a \ref tOplkError error code.
+
+\ingroup module_ctrlu
+*/
+//------------------------------------------------------------------------------
+tOplkError ctrlu_resetTimerStatistics(void)
+{
+    tOplkError      ret;
+    UINT16          retval;
+
+    ret = ctrlucal_executeCmd(kCtrlResetTimerStatistics, &retval);
+    if (ret != kErrorOk)
+        return ret;
+
+    return (tOplkError)retval;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get cycle statistics
+
+This function requests the cycle statistics of the cyclic Ethernet driver from
+the kernel stack and reads them from the statistics transfer buffer.
+
+\param[out]     pStatistics_p       Pointer to store the cycle statistics.
+
+\return The function returns a \ref tOplkError error code.
+
+\ingroup module_ctrlu
+*/
+//------------------------------------------------------------------------------
+tOplkError ctrlu_getCycleStatistics(tOplkApiCycleStatistics* pStatistics_p)
+{
+    tOplkError      ret;
+    UINT16          retval;
+
+    // Check parameter validity
+    ASSERT(pStatistics_p != NULL);
+
+    ret = ctrlucal_executeCmd(kCtrlGetCycleStatistics, &retval);
+    if (ret != kErrorOk)
+        return ret;
+
+    if (retval != kErrorOk)
+        return (tOplkError)retval;
+
+    return ctrlucal_readStatistics(pStatistics_p, sizeof(tOplkApiCycleStatistics));
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Reset cycle statistics
+
+This function resets the cycle statistics of the cyclic Ethernet driver of the
+kernel stack.
+
+\return The function returns a \ref tOplkError error code.
+
+\ingroup module_ctrlu
+*/
+//------------------------------------------------------------------------------
+tOplkError ctrlu_resetCycleStatistics(void)
+{
+    tOplkError      ret;
+    UINT16          retval;
+
+    ret = ctrlucal_executeCmd(kCtrlResetCycleStatistics, &retval);
+    if (ret != kErrorOk)
+        return ret;
+
+    return (tOplkError)retval;
+}
+
 //============================================================================//
 //            P R I V A T E   F U N C T I O N S                               //
 //============================================================================//
@@ -79,6 +79,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // local vars
 //------------------------------------------------------------------------------
 extern tCtrlInitParam   kernelInitParam_g;
+extern tCtrlStatistics  kernelStatistics_g;
 static UINT16           dummyHeartbeat_l;
 
 //------------------------------------------------------------------------------
@@ -280,6 +281,35 @@ tOplkError ctrlucal_readInitParam(tCtrlInitParam* pInitParam_p)
     return kErrorOk;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Read statistics from kernel
+
+The function reads statistics stored by the kernel stack from the statistics
+transfer buffer.
+
+\param[out]     pStatistics_p       Pointer to store the read statistics.
+\param[in]      size_p              Size of the statistics.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_ctrlucal
+*/
+//------------------------------------------------------------------------------
+tOplkError ctrlucal_readStatistics(void* pStatistics_p,
+                                   size_t size_p)
+{
+    // Check parameter validity
+    ASSERT(pStatistics_p != NULL);
+
+    if (size_p > sizeof(tCtrlStatistics))
+        return kErrorInvalidInstanceParam;
+
+    OPLK_MEMCPY(pStatistics_p, &kernelStatistics_g, size_p);
+
+    return kErrorOk;
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  Write file chunk
@@ -455,6 +455,31 @@ Exit:
     return ret;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Read statistics from kernel
+
+The function reads statistics stored by the kernel stack from the statistics
+transfer buffer.
+
+\param[out]     pStatistics_p       Pointer to store the read statistics.
+\param[in]      size_p              Size of the statistics.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_ctrlucal
+*/
+//------------------------------------------------------------------------------
+tOplkError ctrlucal_readStatistics(void* pStatistics_p,
+                                   size_t size_p)
+{
+    UNUSED_PARAMETER(pStatistics_p);
+    UNUSED_PARAMETER(size_p);
+
+    // This CAL is not supporting that feature -> return no resource available.
+    return kErrorNoResource;
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  Write file chunk
@@ -339,6 +339,35 @@ tOplkError ctrlucal_readInitParam(tCtrlInitParam* pInitParam_p)
                             sizeof(tCtrlInitParam));
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Read statistics from kernel
+
+The function reads statistics stored by the kernel stack from the statistics
+transfer buffer.
+
+\param[out]     pStatistics_p       Pointer to store the read statistics.
+\param[in]      size_p              Size of the statistics.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_ctrlucal
+*/
+//------------------------------------------------------------------------------
+tOplkError ctrlucal_readStatistics(void* pStatistics_p,
+                                   size_t size_p)
+{
+    // Check parameter validity
+    ASSERT(pStatistics_p != NULL);
+
+    if (size_p > sizeof(tCtrlStatistics))
+        return kErrorInvalidInstanceParam;
+
+    return ctrlcal_readData(pStatistics_p,
+                            offsetof(tCtrlBuf, statistics),
+                            size_p);
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  Write file chunk
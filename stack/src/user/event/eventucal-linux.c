@@ -105,6 +105,8 @@ static tEventuCalInstance       instance_l;             ///< Instance variable o
 // local function prototypes
 //------------------------------------------------------------------------------
 static void* eventThread(void* arg);
+static int   waitForSignal(sem_t* pSem_p);
+static BOOL  processEventBatch(void);
 static void  signalUserEvent(void);
 static void  signalKernelEvent(void);
 
@@ -128,7 +130,6 @@ CAL module.
 //------------------------------------------------------------------------------
 tOplkError eventucal_init(void)
 {
-    struct sched_param  schedParam;
 
     OPLK_MEMSET(&instance_l, 0, sizeof(tEventuCalInstance));
 
@@ -155,18 +156,17 @@ tOplkError eventucal_init(void)
     if (pthread_create(&instance_l.threadId, NULL, eventThread, (void*)&instance_l) != 0)
         goto Exit;
 
-    schedParam.sched_priority = USER_EVENT_THREAD_PRIORITY;
-    if (pthread_setschedparam(instance_l.threadId, SCHED_FIFO, &schedParam) != 0)
+    if (target_registerThread(kOplkThreadRoleEventUser,
+                              instance_l.threadId,
+                              kOplkThreadPolicyFifo,
+                              USER_EVENT_THREAD_PRIORITY,
+                              "oplk-eventu") != kErrorOk)
     {
         DEBUG_LVL_ERROR_TRACE("%s(): couldn't set thread scheduling parameters! %d\n",
                               __func__,
-                              schedParam.sched_priority);
+                              USER_EVENT_THREAD_PRIORITY);
     }
 
-#if (defined(__GLIBC__) && (__GLIBC__ >= 2) && (__GLIBC_MINOR__ >= 12))
-    pthread_setname_np(instance_l.threadId, "oplk-eventu");
-#endif
-
     instance_l.fInitialized = TRUE;
     return kErrorOk;
 
@@ -204,6 +204,7 @@ tOplkError eventucal_exit(void)
 
     if (instance_l.fInitialized != FALSE)
     {
+        target_unregisterThread(kOplkThreadRoleEventUser, instance_l.threadId);
         instance_l.fStopThread = TRUE;
         while (instance_l.fStopThread != FALSE)
         {
@@ -319,31 +320,101 @@ This function contains the main function for the event handler thread.
 //------------------------------------------------------------------------------
 static void* eventThread(void* arg)
 {
-    struct timespec         curTime, timeout;
     tEventuCalInstance*     pInstance = (tEventuCalInstance*)arg;
+    BOOL                    fEventsPending = FALSE;
 
     while (!pInstance->fStopThread)
     {
-        clock_gettime(CLOCK_REALTIME, &curTime);
-        timeout.tv_sec = 0;
-        timeout.tv_nsec = 50000 * 1000;
-        TIMESPECADD(&timeout, &curTime);
+        // Leftovers of the previous batch are processed without waiting
+        if (!fEventsPending && (waitForSignal(pInstance->semUserData) != 0))
+            continue;
+
+        // A wakeup covers all events posted so far, so consume all pending signals
+        while (sem_trywait(pInstance->semUserData) == 0)
+            ;
+
+        fEventsPending = processEventBatch();
+    }
+
+    pInstance->fStopThread = FALSE;
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Wait for an event signal
+
+This function waits until an event is signaled or the timeout of 50 ms expires.
+The timeout is based on CLOCK_MONOTONIC if the C library supports it.
+
+\param[in]      pSem_p              Semaphore to wait for.
+
+\return The function returns 0 if a signal was received, otherwise -1.
+*/
+//------------------------------------------------------------------------------
+static int waitForSignal(sem_t* pSem_p)
+{
+    struct timespec         curTime, timeout;
+
+    timeout.tv_sec = 0;
+    timeout.tv_nsec = 50000 * 1000;
+
+#if (defined(__GLIBC__) && ((__GLIBC__ > 2) || (__GLIBC_MINOR__ >= 30)))
+    clock_gettime(CLOCK_MONOTONIC, &curTime);
+    TIMESPECADD(&timeout, &curTime);
 
-        if (sem_timedwait(pInstance->semUserData, &timeout) == 0)
+    return sem_clockwait(pSem_p, CLOCK_MONOTONIC, &timeout);
+#else
+    clock_gettime(CLOCK_REALTIME, &curTime);
+    TIMESPECADD(&timeout, &curTime);
+
+    return sem_timedwait(pSem_p, &timeout);
+#endif
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Process a batch of events
+
+This function processes up to \ref CONFIG_EVENT_DRAIN_MAX_EVENTS events. The
+kernel-to-user queue and the user-internal queue are served in a weighted
+round-robin manner, so the kernel-to-user events keep their priority without
+starving the user-internal queue.
+
+\return The function returns TRUE if the batch limit was reached and events
+        may still be pending, otherwise FALSE.
+*/
+//------------------------------------------------------------------------------
+static BOOL processEventBatch(void)
+{
+    UINT    processedCount = 0;
+    UINT    highCount;
+    UINT    lowCount;
+    UINT    i;
+
+    while (processedCount < CONFIG_EVENT_DRAIN_MAX_EVENTS)
+    {
+        highCount = eventucal_getEventCountCircbuf(kEventQueueK2U);
+        lowCount = eventucal_getEventCountCircbuf(kEventQueueUInt);
+        if ((highCount == 0) && (lowCount == 0))
+            return FALSE;
+
+        for (i = 0; (i < CONFIG_EVENT_DRAIN_WEIGHT_HIGH) && (i < highCount) &&
+                    (processedCount < CONFIG_EVENT_DRAIN_MAX_EVENTS); i++)
         {
-            /* first handle all user to kernel events --> higher priority! */
-            if (eventucal_getEventCountCircbuf(kEventQueueK2U) > 0)
-                eventucal_processEventCircbuf(kEventQueueK2U);
-            else
-            {
-                if (eventucal_getEventCountCircbuf(kEventQueueUInt) > 0)
-                    eventucal_processEventCircbuf(kEventQueueUInt);
-            }
+            eventucal_processEventCircbuf(kEventQueueK2U);
+            processedCount++;
+        }
+
+        for (i = 0; (i < CONFIG_EVENT_DRAIN_WEIGHT_LOW) && (i < lowCount) &&
+                    (processedCount < CONFIG_EVENT_DRAIN_MAX_EVENTS); i++)
+        {
+            eventucal_processEventCircbuf(kEventQueueUInt);
+            processedCount++;
         }
     }
-    pInstance->fStopThread = FALSE;
 
-    return 0;
+    return TRUE;
 }
 
 //------------------------------------------------------------------------------
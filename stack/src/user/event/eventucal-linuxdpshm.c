@@ -140,7 +140,6 @@ implementations and calls the appropriate init functions.
 tOplkError eventucal_init(void)
 {
     tOplkError          ret = kErrorOk;
-    struct sched_param  schedParam;
 
     OPLK_MEMSET(&instance_l, 0, sizeof(tEventuCalInstance));
 
@@ -163,33 +162,31 @@ tOplkError eventucal_init(void)
     if (pthread_create(&instance_l.kernelEventThreadId, NULL, k2uEventFetchThread, NULL) != 0)
         goto Exit;
 
-    schedParam.sched_priority = KERNEL_EVENT_FETCH_THREAD_PRIORITY;
-    if (pthread_setschedparam(instance_l.kernelEventThreadId, SCHED_FIFO, &schedParam) != 0)
+    if (target_registerThread(kOplkThreadRoleEventUser,
+                              instance_l.kernelEventThreadId,
+                              kOplkThreadPolicyFifo,
+                              KERNEL_EVENT_FETCH_THREAD_PRIORITY,
+                              "oplk-eventufetch") != kErrorOk)
     {
         DEBUG_LVL_ERROR_TRACE("%s(): couldn't set K2U thread scheduling parameters! %d\n",
                               __func__,
-                              schedParam.sched_priority);
+                              KERNEL_EVENT_FETCH_THREAD_PRIORITY);
     }
 
-#if (defined(__GLIBC__) && (__GLIBC__ >= 2) && (__GLIBC_MINOR__ >= 12))
-    pthread_setname_np(instance_l.kernelEventThreadId, "oplk-eventufetch");
-#endif
-
     // Create thread for processing pending user data
     if (pthread_create(&instance_l.processEventThreadId, NULL, eventProcessThread, NULL) != 0)
         goto Exit;
 
-    schedParam.sched_priority = EVENT_PROCESS_THREAD_PRIORITY;
-    if (pthread_setschedparam(instance_l.processEventThreadId, SCHED_FIFO, &schedParam) != 0)
+    if (target_registerThread(kOplkThreadRoleEventUser,
+                              instance_l.processEventThreadId,
+                              kOplkThreadPolicyFifo,
+                              EVENT_PROCESS_THREAD_PRIORITY,
+                              "oplk-eventuprocess") != kErrorOk)
     {
         DEBUG_LVL_ERROR_TRACE("%s(): couldn't set event process thread scheduling parameters! %d\n",
                               __func__,
-                              schedParam.sched_priority);
+                              EVENT_PROCESS_THREAD_PRIORITY);
     }
-
-#if (defined(__GLIBC__) && (__GLIBC__ >= 2) && (__GLIBC_MINOR__ >= 12))
-    pthread_setname_np(instance_l.processEventThreadId, "oplk-eventuprocess");
-#endif
     instance_l.fInitialized = TRUE;
     return kErrorOk;
 
@@ -218,6 +215,7 @@ tOplkError eventucal_exit(void)
 
     if (instance_l.kernelEventThreadId != 0)
     {
+        target_unregisterThread(kOplkThreadRoleEventUser, instance_l.kernelEventThreadId);
         instance_l.fStopKernelThread = TRUE;
         while (instance_l.fStopKernelThread != FALSE)
         {
@@ -234,6 +232,7 @@ tOplkError eventucal_exit(void)
     timeout = 0;
     if (instance_l.processEventThreadId != 0)
     {
+        target_unregisterThread(kOplkThreadRoleEventUser, instance_l.processEventThreadId);
         instance_l.fStopProcessThread = TRUE;
         while (instance_l.fStopProcessThread != FALSE)
         {
@@ -133,7 +133,6 @@ implementations and calls the appropriate init functions.
 tOplkError eventucal_init(void)
 {
     tOplkError          ret = kErrorOk;
-    struct sched_param  schedParam;
 
     OPLK_MEMSET(&instance_l, 0, sizeof(tEventuCalInstance));
 
@@ -144,18 +143,17 @@ tOplkError eventucal_init(void)
     if (pthread_create(&instance_l.threadId, NULL, eventThread, NULL) != 0)
         goto Exit;
 
-    schedParam.sched_priority = USER_EVENT_THREAD_PRIORITY;
-    if (pthread_setschedparam(instance_l.threadId, SCHED_FIFO, &schedParam) != 0)
+    if (target_registerThread(kOplkThreadRoleEventUser,
+                              instance_l.threadId,
+                              kOplkThreadPolicyFifo,
+                              USER_EVENT_THREAD_PRIORITY,
+                              "oplk-eventu") != kErrorOk)
     {
         DEBUG_LVL_ERROR_TRACE("%s(): couldn't set thread scheduling parameters! %d\n",
                               __func__,
-                              schedParam.sched_priority);
+                              USER_EVENT_THREAD_PRIORITY);
     }
 
-#if (defined(__GLIBC__) && (__GLIBC__ >= 2) && (__GLIBC_MINOR__ >= 12))
-    pthread_setname_np(instance_l.threadId, "oplk-eventu");
-#endif
-
 Exit:
     return ret;
 }
@@ -180,6 +178,7 @@ tOplkError eventucal_exit(void)
 
     if (instance_l.threadId != 0)
     {
+        target_unregisterThread(kOplkThreadRoleEventUser, instance_l.threadId);
         instance_l.fStopThread = TRUE;
         while (instance_l.fStopThread != FALSE)
         {
@@ -46,11 +46,20 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <user/obdu.h>
 #include <common/ami.h>
 #include <user/eventu.h>
+#include <user/cfmu.h>
 
 #if defined(CONFIG_INCLUDE_CFM)
 
 #include <errno.h>
 
+#if (TARGET_SYSTEM == _LINUX_)
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
 //============================================================================//
 //            G L O B A L   D E F I N I T I O N S                             //
 //============================================================================//
@@ -91,6 +100,41 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define OBDCDC_DISABLE_FILE_SUPPORT     FALSE
 #endif
 
+#if ((OBDCDC_DISABLE_FILE_SUPPORT == FALSE) && (TARGET_SYSTEM == _LINUX_))
+#define OBDCDC_USE_FILE_MAPPING         TRUE
+#else
+#define OBDCDC_USE_FILE_MAPPING         FALSE
+#endif
+
+#define OBDCDC_IDX_CONCISEDCF_LIST      0x1F22      // CFM_ConciseDcfList_ADOM
+
+#ifndef OBDCDC_INDEX_FILENAME_EXTENSION
+#define OBDCDC_INDEX_FILENAME_EXTENSION ".idx"
+#endif
+
+#ifndef OBDCDC_INDEX_TMP_EXTENSION
+#define OBDCDC_INDEX_TMP_EXTENSION      ".tmp"
+#endif
+
+// Layout of the CDC index file (all values little endian)
+#define OBDCDC_INDEX_SIGNATURE              0x58444943      // "CIDX"
+#define OBDCDC_INDEX_VERSION                1
+#define OBDCDC_INDEX_OFFSET_SIGNATURE       0               // UINT32 index file signature
+#define OBDCDC_INDEX_OFFSET_VERSION         4               // UINT32 index file version
+#define OBDCDC_INDEX_OFFSET_DEVICE          8               // UINT64 device of the CDC file
+#define OBDCDC_INDEX_OFFSET_INODE           16              // UINT64 inode of the CDC file
+#define OBDCDC_INDEX_OFFSET_SIZE            24              // UINT64 size of the CDC file
+#define OBDCDC_INDEX_OFFSET_MTIME_SEC       32              // UINT64 modification time of the CDC file (s)
+#define OBDCDC_INDEX_OFFSET_MTIME_NSEC      40              // UINT32 modification time of the CDC file (ns)
+#define OBDCDC_INDEX_OFFSET_COUNT           44              // UINT32 number of entries
+#define OBDCDC_INDEX_HEADER_SIZE            48
+#define OBDCDC_INDEX_ENTRY_OFFSET_INDEX     0               // UINT16 object index
+#define OBDCDC_INDEX_ENTRY_OFFSET_SUBINDEX  2               // UINT8 object sub-index
+#define OBDCDC_INDEX_ENTRY_OFFSET_SIZE      4               // UINT32 size of the object data
+#define OBDCDC_INDEX_ENTRY_OFFSET_DATA      8               // UINT64 offset of the object data in the CDC file
+#define OBDCDC_INDEX_ENTRY_SIZE             16
+#define OBDCDC_INDEX_CHECKSUM_SIZE          4               // UINT32 FNV-1a checksum of the preceding data
+
 //------------------------------------------------------------------------------
 // local types
 //------------------------------------------------------------------------------
@@ -125,11 +169,48 @@ typedef struct
     UINT8*              pCurBuffer;
 } tObdCdcInfo;
 
+#if (OBDCDC_USE_FILE_MAPPING != FALSE)
+/**
+\brief Parsed CDC entry
+
+The structure describes an entry of a memory mapped CDC file.
+*/
+typedef struct
+{
+    UINT16              index;              ///< Object index
+    UINT8               subIndex;           ///< Object sub-index
+    size_t              dataOffset;         ///< Offset of the object data in the CDC file
+    size_t              dataSize;           ///< Size of the object data
+} tObdCdcEntry;
+
+/**
+\brief Parsed CDC file
+
+The structure describes the entries which have been parsed from a CDC file and
+the ConciseDCFs which have been copied from it. The parsed entries are reused as
+long as the file is not modified.
+*/
+typedef struct
+{
+    size_t              cdcSize;            ///< Size of the parsed CDC file
+    dev_t               device;             ///< Device of the parsed CDC file
+    ino_t               inode;              ///< Inode of the parsed CDC file
+    struct timespec     modificationTime;   ///< Modification time of the parsed CDC file
+    tObdCdcEntry*       paEntries;          ///< Parsed entries of the CDC file
+    UINT32              entryCount;         ///< Number of parsed entries
+    UINT8*              pDcfData;           ///< ConciseDCFs of 0x1F22 which are linked into the OD
+    size_t              dcfDataSize;        ///< Size of the linked ConciseDCFs
+} tObdCdcMapping;
+#endif
+
 typedef struct
 {
     const void*         pCdcBuffer;
     size_t              cdcBufSize;
     const char*         pCdcFilename;
+#if (OBDCDC_USE_FILE_MAPPING != FALSE)
+    tObdCdcMapping      mapping;
+#endif
 } tObdCdcInstance;
 
 //------------------------------------------------------------------------------
@@ -141,9 +222,38 @@ static tObdCdcInstance         cdcInstance_l;
 // local function prototypes
 //------------------------------------------------------------------------------
 static tOplkError processCdc(tObdCdcInfo* pCdcInfo_p);
+static tOplkError writeCdcEntry(UINT index_p,
+                                UINT subIndex_p,
+                                const void* pData_p,
+                                size_t size_p);
 static tOplkError loadNextBuffer(tObdCdcInfo* pCdcInfo_p, size_t bufferSize_p);
 static tOplkError loadCdcBuffer(const void* pCdc_p, size_t cdcSize_p);
 static tOplkError loadCdcFile(const char* pCdcFilename_p);
+#if (OBDCDC_USE_FILE_MAPPING != FALSE)
+static tOplkError mapCdcFile(const char* pCdcFilename_p);
+static tOplkError parseCdcEntries(const UINT8* pCdc_p,
+                                  size_t cdcSize_p,
+                                  tObdCdcEntry** ppaEntries_p,
+                                  UINT32* pEntryCount_p);
+static tOplkError loadCdcIndex(const char* pCdcFilename_p,
+                               const struct stat* pCdcStat_p,
+                               const UINT8* pCdc_p,
+                               tObdCdcEntry** ppaEntries_p,
+                               UINT32* pEntryCount_p);
+static void       storeCdcIndex(const char* pCdcFilename_p,
+                                const struct stat* pCdcStat_p,
+                                const tObdCdcEntry* paEntries_p,
+                                UINT32 entryCount_p);
+static UINT32     calcIndexChecksum(const UINT8* pData_p, size_t size_p);
+static BOOL       isLinkableEntry(const tObdCdcEntry* pEntry_p);
+static tOplkError linkCdcEntries(const UINT8* pCdc_p,
+                                 const tObdCdcEntry* paEntries_p,
+                                 UINT32 entryCount_p,
+                                 UINT8** ppDcfData_p,
+                                 size_t* pDcfDataSize_p);
+static void       unlinkCdcEntries(const tObdCdcMapping* pMapping_p);
+static void       releaseCdcMapping(void);
+#endif
 
 //============================================================================//
 //            P U B L I C   F U N C T I O N S                                 //
@@ -178,6 +288,10 @@ The function exits and cleans up the OBD CDC module.
 //------------------------------------------------------------------------------
 void obdcdc_exit(void)
 {
+#if (OBDCDC_USE_FILE_MAPPING != FALSE)
+    releaseCdcMapping();
+#endif
+
     OPLK_MEMSET(&cdcInstance_l, 0, sizeof(tObdCdcInstance));
 }
 
@@ -267,7 +381,9 @@ file and writes its contents into the OD.
 static tOplkError loadCdcFile(const char* pCdcFilename_p)
 {
     tOplkError  ret = kErrorOk;
-#if (OBDCDC_DISABLE_FILE_SUPPORT == FALSE)
+#if (OBDCDC_USE_FILE_MAPPING != FALSE)
+    ret = mapCdcFile(pCdcFilename_p);
+#elif (OBDCDC_DISABLE_FILE_SUPPORT == FALSE)
     tObdCdcInfo cdcInfo;
     UINT32      error;
 
@@ -398,26 +514,49 @@ static tOplkError processCdc(tObdCdcInfo* pCdcInfo_p)
             return ret;
         }
 
-        ret = obdu_writeEntryFromLe(objectIndex,
-                                    objectSubIndex,
-                                    pCdcInfo_p->pCurBuffer,
-                                    (tObdSize)curDataSize);
+        ret = writeCdcEntry(objectIndex, objectSubIndex, pCdcInfo_p->pCurBuffer, curDataSize);
         if (ret != kErrorOk)
-        {
-            tEventObdError  obdError;
+            return ret;
+    }
 
-            obdError.index = objectIndex;
-            obdError.subIndex = objectSubIndex;
+    return ret;
+}
 
-            DEBUG_LVL_OBD_TRACE("%s: Writing object 0x%04X/%u to local OBD failed with 0x%02X\n",
-                                __func__,
-                                objectIndex,
-                                objectSubIndex,
-                                ret);
-            ret = eventu_postError(kEventSourceObdu, ret, sizeof(tEventObdError), &obdError);
-            if (ret != kErrorOk)
-                return ret;
-        }
+//------------------------------------------------------------------------------
+/**
+\brief  Write CDC entry
+
+The function writes the data of a CDC entry into the OD. If the write fails,
+an error event is posted.
+
+\param[in]      index_p             Object index.
+\param[in]      subIndex_p          Object sub-index.
+\param[in]      pData_p             Pointer to the object data.
+\param[in]      size_p              Size of the object data.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError writeCdcEntry(UINT index_p,
+                                UINT subIndex_p,
+                                const void* pData_p,
+                                size_t size_p)
+{
+    tOplkError      ret;
+    tEventObdError  obdError;
+
+    ret = obdu_writeEntryFromLe(index_p, subIndex_p, pData_p, (tObdSize)size_p);
+    if (ret != kErrorOk)
+    {
+        obdError.index = index_p;
+        obdError.subIndex = subIndex_p;
+
+        DEBUG_LVL_OBD_TRACE("%s: Writing object 0x%04X/%u to local OBD failed with 0x%02X\n",
+                            __func__,
+                            index_p,
+                            subIndex_p,
+                            ret);
+        ret = eventu_postError(kEventSourceObdu, ret, sizeof(tEventObdError), &obdError);
     }
 
     return ret;
@@ -497,6 +636,592 @@ static tOplkError loadNextBuffer(tObdCdcInfo* pCdcInfo_p, size_t bufferSize_p)
     return ret;
 }
 
+#if (OBDCDC_USE_FILE_MAPPING != FALSE)
+//------------------------------------------------------------------------------
+/**
+\brief  Load a memory mapped CDC file
+
+The function maps the CDC file into memory and writes its entries into the OD.
+The entries are taken from the entries parsed before or from the index file
+next to the CDC file if the file has not been modified. Otherwise, the entries
+are parsed and the index file is updated. The ConciseDCFs of object 0x1F22 are
+copied into a single buffer which is linked into the OD. The previous buffer is
+released after the new ConciseDCFs have been linked. The CDC file is unmapped
+after it has been loaded.
+
+\param[in]      pCdcFilename_p      The filename of the CDC file to load.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError mapCdcFile(const char* pCdcFilename_p)
+{
+    tOplkError      ret;
+    tObdCdcMapping* pMapping = &cdcInstance_l.mapping;
+    struct stat     fileStat;
+    int             fd;
+    void*           pCdc;
+    UINT8*          pDcfData = NULL;
+    size_t          dcfDataSize = 0;
+    UINT32          error;
+
+    fd = open(pCdcFilename_p, O_RDONLY);
+    if ((fd < 0) || (fstat(fd, &fileStat) != 0))
+    {   // error occurred
+        error = (UINT32)errno;
+        if (fd >= 0)
+            close(fd);
+
+        DEBUG_LVL_OBD_TRACE("%s: failed to open '%s'\n", __func__, pCdcFilename_p);
+        return eventu_postError(kEventSourceObdu, kErrorObdErrnoSet, sizeof(UINT32), &error);
+    }
+
+    if (fileStat.st_size <= 0)
+    {
+        close(fd);
+        ret = eventu_postError(kEventSourceObdu, kErrorObdInvalidDcf, 0, NULL);
+        if (ret != kErrorOk)
+            return ret;
+
+        return kErrorReject;
+    }
+
+    pCdc = mmap(NULL, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (pCdc == MAP_FAILED)
+    {
+        error = (UINT32)errno;
+        return eventu_postError(kEventSourceObdu, kErrorObdErrnoSet, sizeof(UINT32), &error);
+    }
+
+    // Parse the CDC again only if it was modified
+    if ((pMapping->paEntries == NULL) ||
+        (pMapping->device != fileStat.st_dev) ||
+        (pMapping->inode != fileStat.st_ino) ||
+        (pMapping->cdcSize != (size_t)fileStat.st_size) ||
+        (pMapping->modificationTime.tv_sec != fileStat.st_mtim.tv_sec) ||
+        (pMapping->modificationTime.tv_nsec != fileStat.st_mtim.tv_nsec))
+    {
+        if (pMapping->paEntries != NULL)
+        {
+            OPLK_FREE(pMapping->paEntries);
+            pMapping->paEntries = NULL;
+            pMapping->entryCount = 0;
+        }
+
+        ret = loadCdcIndex(pCdcFilename_p,
+                           &fileStat,
+                           (const UINT8*)pCdc,
+                           &pMapping->paEntries,
+                           &pMapping->entryCount);
+        if (ret != kErrorOk)
+        {
+            ret = parseCdcEntries((const UINT8*)pCdc,
+                                  (size_t)fileStat.st_size,
+                                  &pMapping->paEntries,
+                                  &pMapping->entryCount);
+            if (ret != kErrorOk)
+            {
+                munmap(pCdc, (size_t)fileStat.st_size);
+                return ret;
+            }
+
+            storeCdcIndex(pCdcFilename_p, &fileStat, pMapping->paEntries, pMapping->entryCount);
+        }
+
+        pMapping->device = fileStat.st_dev;
+        pMapping->inode = fileStat.st_ino;
+        pMapping->cdcSize = (size_t)fileStat.st_size;
+        pMapping->modificationTime = fileStat.st_mtim;
+    }
+
+    // Link the new ConciseDCFs before the old ones are released
+    ret = linkCdcEntries((const UINT8*)pCdc,
+                         pMapping->paEntries,
+                         pMapping->entryCount,
+                         &pDcfData,
+                         &dcfDataSize);
+    munmap(pCdc, (size_t)fileStat.st_size);
+
+    unlinkCdcEntries(pMapping);
+    if (pMapping->pDcfData != NULL)
+        OPLK_FREE(pMapping->pDcfData);
+
+    pMapping->pDcfData = pDcfData;
+    pMapping->dcfDataSize = dcfDataSize;
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Parse CDC entries
+
+The function parses the entries of a CDC located in memory. The data of the
+entries is not copied, only its location is stored.
+
+\param[in]      pCdc_p              Pointer to the CDC.
+\param[in]      cdcSize_p           Size of the CDC.
+\param[out]     ppaEntries_p        Pointer to store the allocated entry array.
+\param[out]     pEntryCount_p       Pointer to store the number of entries.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError parseCdcEntries(const UINT8* pCdc_p,
+                                  size_t cdcSize_p,
+                                  tObdCdcEntry** ppaEntries_p,
+                                  UINT32* pEntryCount_p)
+{
+    tOplkError      ret;
+    tObdCdcEntry*   paEntries;
+    UINT32          entryCount;
+    UINT32          entry;
+    size_t          offset;
+
+    if (cdcSize_p < sizeof(UINT32))
+        goto InvalidDcf;
+
+    entryCount = ami_getUint32Le(pCdc_p);
+    if (entryCount == 0)
+        return eventu_postError(kEventSourceObdu, kErrorObdNoConfigData, 0, NULL);
+
+    // every entry needs at least its header
+    if (entryCount > ((cdcSize_p - sizeof(UINT32)) / CDC_OFFSET_DATA))
+        goto InvalidDcf;
+
+    paEntries = (tObdCdcEntry*)OPLK_MALLOC(entryCount * sizeof(tObdCdcEntry));
+    if (paEntries == NULL)
+    {
+        ret = eventu_postError(kEventSourceObdu, kErrorObdOutOfMemory, 0, NULL);
+        if (ret != kErrorOk)
+            return ret;
+
+        return kErrorReject;
+    }
+
+    offset = sizeof(UINT32);
+    for (entry = 0; entry < entryCount; entry++)
+    {
+        if ((cdcSize_p - offset) < CDC_OFFSET_DATA)
+            break;
+
+        paEntries[entry].index = ami_getUint16Le(&pCdc_p[offset + CDC_OFFSET_INDEX]);
+        paEntries[entry].subIndex = ami_getUint8Le(&pCdc_p[offset + CDC_OFFSET_SUBINDEX]);
+        paEntries[entry].dataSize = (size_t)ami_getUint32Le(&pCdc_p[offset + CDC_OFFSET_SIZE]);
+        offset += CDC_OFFSET_DATA;
+
+        if ((cdcSize_p - offset) < paEntries[entry].dataSize)
+            break;
+
+        paEntries[entry].dataOffset = offset;
+        offset += paEntries[entry].dataSize;
+    }
+
+    if (entry < entryCount)
+    {
+        OPLK_FREE(paEntries);
+        goto InvalidDcf;
+    }
+
+    *ppaEntries_p = paEntries;
+    *pEntryCount_p = entryCount;
+    return kErrorOk;
+
+InvalidDcf:
+    ret = eventu_postError(kEventSourceObdu, kErrorObdInvalidDcf, 0, NULL);
+    if (ret != kErrorOk)
+        return ret;
+
+    return kErrorReject;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Load the CDC index file
+
+The function loads the entries of a CDC file from its index file. The index
+file is only used if it matches the device, inode, size and modification time
+of the CDC file, if its checksum is valid and if all entries are located within
+the CDC file.
+
+\param[in]      pCdcFilename_p      The filename of the CDC file.
+\param[in]      pCdcStat_p          File status of the CDC file.
+\param[in]      pCdc_p              Pointer to the mapped CDC file.
+\param[out]     ppaEntries_p        Pointer to store the allocated entry array.
+\param[out]     pEntryCount_p       Pointer to store the number of entries.
+
+\return The function returns a tOplkError error code.
+\retval kErrorOk                    The entries have been loaded from the index file.
+\retval kErrorObdInvalidDcf         No valid index file exists for the CDC file.
+\retval kErrorNoResource            The entry array could not be allocated.
+*/
+//------------------------------------------------------------------------------
+static tOplkError loadCdcIndex(const char* pCdcFilename_p,
+                               const struct stat* pCdcStat_p,
+                               const UINT8* pCdc_p,
+                               tObdCdcEntry** ppaEntries_p,
+                               UINT32* pEntryCount_p)
+{
+    char            aIndexPath[PATH_MAX];
+    struct stat     indexStat;
+    int             fd;
+    void*           pIndex;
+    const UINT8*    pData;
+    size_t          indexSize;
+    size_t          cdcSize = (size_t)pCdcStat_p->st_size;
+    tObdCdcEntry*   paEntries;
+    UINT32          entryCount;
+    UINT32          entry;
+    UINT64          dataOffset;
+
+    if ((strlen(pCdcFilename_p) + sizeof(OBDCDC_INDEX_FILENAME_EXTENSION)) > sizeof(aIndexPath))
+        return kErrorObdInvalidDcf;
+
+    strcpy(aIndexPath, pCdcFilename_p);
+    strcat(aIndexPath, OBDCDC_INDEX_FILENAME_EXTENSION);
+
+    fd = open(aIndexPath, O_RDONLY);
+    if (fd < 0)
+        return kErrorObdInvalidDcf;
+
+    if ((fstat(fd, &indexStat) != 0) ||
+        (indexStat.st_size < (OBDCDC_INDEX_HEADER_SIZE + OBDCDC_INDEX_CHECKSUM_SIZE)))
+    {
+        close(fd);
+        return kErrorObdInvalidDcf;
+    }
+
+    indexSize = (size_t)indexStat.st_size;
+    pIndex = mmap(NULL, indexSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (pIndex == MAP_FAILED)
+        return kErrorObdInvalidDcf;
+
+    pData = (const UINT8*)pIndex;
+    entryCount = ami_getUint32Le(&pData[OBDCDC_INDEX_OFFSET_COUNT]);
+    if ((ami_getUint32Le(&pData[OBDCDC_INDEX_OFFSET_SIGNATURE]) != OBDCDC_INDEX_SIGNATURE) ||
+        (ami_getUint32Le(&pData[OBDCDC_INDEX_OFFSET_VERSION]) != OBDCDC_INDEX_VERSION) ||
+        (ami_getUint64Le(&pData[OBDCDC_INDEX_OFFSET_DEVICE]) != (UINT64)pCdcStat_p->st_dev) ||
+        (ami_getUint64Le(&pData[OBDCDC_INDEX_OFFSET_INODE]) != (UINT64)pCdcStat_p->st_ino) ||
+        (ami_getUint64Le(&pData[OBDCDC_INDEX_OFFSET_SIZE]) != (UINT64)cdcSize) ||
+        (ami_getUint64Le(&pData[OBDCDC_INDEX_OFFSET_MTIME_SEC]) != (UINT64)pCdcStat_p->st_mtim.tv_sec) ||
+        (ami_getUint32Le(&pData[OBDCDC_INDEX_OFFSET_MTIME_NSEC]) != (UINT32)pCdcStat_p->st_mtim.tv_nsec) ||
+        (cdcSize < sizeof(UINT32)) ||
+        (entryCount == 0) ||
+        (entryCount != ami_getUint32Le(pCdc_p)) ||
+        (entryCount > ((indexSize - OBDCDC_INDEX_HEADER_SIZE - OBDCDC_INDEX_CHECKSUM_SIZE) / OBDCDC_INDEX_ENTRY_SIZE)) ||
+        (indexSize != (OBDCDC_INDEX_HEADER_SIZE + (entryCount * OBDCDC_INDEX_ENTRY_SIZE) + OBDCDC_INDEX_CHECKSUM_SIZE)) ||
+        (ami_getUint32Le(&pData[indexSize - OBDCDC_INDEX_CHECKSUM_SIZE]) !=
+         calcIndexChecksum(pData, indexSize - OBDCDC_INDEX_CHECKSUM_SIZE)))
+    {
+        munmap(pIndex, indexSize);
+        return kErrorObdInvalidDcf;
+    }
+
+    paEntries = (tObdCdcEntry*)OPLK_MALLOC(entryCount * sizeof(tObdCdcEntry));
+    if (paEntries == NULL)
+    {
+        munmap(pIndex, indexSize);
+        return kErrorNoResource;
+    }
+
+    pData += OBDCDC_INDEX_HEADER_SIZE;
+    for (entry = 0; entry < entryCount; entry++, pData += OBDCDC_INDEX_ENTRY_SIZE)
+    {
+        dataOffset = ami_getUint64Le(&pData[OBDCDC_INDEX_ENTRY_OFFSET_DATA]);
+        paEntries[entry].index = ami_getUint16Le(&pData[OBDCDC_INDEX_ENTRY_OFFSET_INDEX]);
+        paEntries[entry].subIndex = ami_getUint8Le(&pData[OBDCDC_INDEX_ENTRY_OFFSET_SUBINDEX]);
+        paEntries[entry].dataSize = (size_t)ami_getUint32Le(&pData[OBDCDC_INDEX_ENTRY_OFFSET_SIZE]);
+
+        // the entry must be located within the CDC file
+        if ((dataOffset < (sizeof(UINT32) + CDC_OFFSET_DATA)) ||
+            (dataOffset > (UINT64)cdcSize) ||
+            (paEntries[entry].dataSize > (cdcSize - (size_t)dataOffset)))
+            break;
+
+        paEntries[entry].dataOffset = (size_t)dataOffset;
+    }
+
+    munmap(pIndex, indexSize);
+
+    if (entry < entryCount)
+    {
+        OPLK_FREE(paEntries);
+        return kErrorObdInvalidDcf;
+    }
+
+    *ppaEntries_p = paEntries;
+    *pEntryCount_p = entryCount;
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Store the CDC index file
+
+The function stores the parsed entries of a CDC file in its index file. The
+index file is written into a temporary file which replaces the index file
+afterwards. Errors are ignored, because the index file is only an optimization
+and the directory of the CDC file may be read-only.
+
+\param[in]      pCdcFilename_p      The filename of the CDC file.
+\param[in]      pCdcStat_p          File status of the CDC file.
+\param[in]      paEntries_p         Parsed CDC entries.
+\param[in]      entryCount_p        Number of parsed CDC entries.
+*/
+//------------------------------------------------------------------------------
+static void storeCdcIndex(const char* pCdcFilename_p,
+                          const struct stat* pCdcStat_p,
+                          const tObdCdcEntry* paEntries_p,
+                          UINT32 entryCount_p)
+{
+    char    aIndexPath[PATH_MAX];
+    char    aTmpPath[PATH_MAX];
+    UINT8*  pIndex;
+    UINT8*  pData;
+    size_t  indexSize;
+    UINT32  entry;
+    FILE*   pFile;
+    BOOL    fError;
+
+    if ((strlen(pCdcFilename_p) + sizeof(OBDCDC_INDEX_FILENAME_EXTENSION) +
+         sizeof(OBDCDC_INDEX_TMP_EXTENSION)) > sizeof(aTmpPath))
+        return;
+
+    strcpy(aIndexPath, pCdcFilename_p);
+    strcat(aIndexPath, OBDCDC_INDEX_FILENAME_EXTENSION);
+    strcpy(aTmpPath, aIndexPath);
+    strcat(aTmpPath, OBDCDC_INDEX_TMP_EXTENSION);
+
+    indexSize = OBDCDC_INDEX_HEADER_SIZE + (entryCount_p * OBDCDC_INDEX_ENTRY_SIZE) + OBDCDC_INDEX_CHECKSUM_SIZE;
+    pIndex = (UINT8*)OPLK_MALLOC(indexSize);
+    if (pIndex == NULL)
+        return;
+
+    OPLK_MEMSET(pIndex, 0, indexSize);
+    ami_setUint32Le(&pIndex[OBDCDC_INDEX_OFFSET_SIGNATURE], OBDCDC_INDEX_SIGNATURE);
+    ami_setUint32Le(&pIndex[OBDCDC_INDEX_OFFSET_VERSION], OBDCDC_INDEX_VERSION);
+    ami_setUint64Le(&pIndex[OBDCDC_INDEX_OFFSET_DEVICE], (UINT64)pCdcStat_p->st_dev);
+    ami_setUint64Le(&pIndex[OBDCDC_INDEX_OFFSET_INODE], (UINT64)pCdcStat_p->st_ino);
+    ami_setUint64Le(&pIndex[OBDCDC_INDEX_OFFSET_SIZE], (UINT64)pCdcStat_p->st_size);
+    ami_setUint64Le(&pIndex[OBDCDC_INDEX_OFFSET_MTIME_SEC], (UINT64)pCdcStat_p->st_mtim.tv_sec);
+    ami_setUint32Le(&pIndex[OBDCDC_INDEX_OFFSET_MTIME_NSEC], (UINT32)pCdcStat_p->st_mtim.tv_nsec);
+    ami_setUint32Le(&pIndex[OBDCDC_INDEX_OFFSET_COUNT], entryCount_p);
+
+    pData = &pIndex[OBDCDC_INDEX_HEADER_SIZE];
+    for (entry = 0; entry < entryCount_p; entry++, pData += OBDCDC_INDEX_ENTRY_SIZE)
+    {
+        ami_setUint16Le(&pData[OBDCDC_INDEX_ENTRY_OFFSET_INDEX], paEntries_p[entry].index);
+        ami_setUint8Le(&pData[OBDCDC_INDEX_ENTRY_OFFSET_SUBINDEX], paEntries_p[entry].subIndex);
+        ami_setUint32Le(&pData[OBDCDC_INDEX_ENTRY_OFFSET_SIZE], (UINT32)paEntries_p[entry].dataSize);
+        ami_setUint64Le(&pData[OBDCDC_INDEX_ENTRY_OFFSET_DATA], (UINT64)paEntries_p[entry].dataOffset);
+    }
+
+    ami_setUint32Le(pData, calcIndexChecksum(pIndex, indexSize - OBDCDC_INDEX_CHECKSUM_SIZE));
+
+    pFile = fopen(aTmpPath, "wb");
+    if (pFile == NULL)
+    {
+        DEBUG_LVL_OBD_TRACE("%s: failed to create '%s'\n", __func__, aTmpPath);
+        OPLK_FREE(pIndex);
+        return;
+    }
+
+    fError = (fwrite(pIndex, indexSize, 1, pFile) != 1);
+    fError |= (fclose(pFile) != 0);
+    OPLK_FREE(pIndex);
+
+    if (fError || (rename(aTmpPath, aIndexPath) != 0))
+        remove(aTmpPath);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Calculate the checksum of a CDC index file
+
+The function calculates the FNV-1a checksum of the data of a CDC index file.
+
+\param[in]      pData_p             Pointer to the index file data.
+\param[in]      size_p              Size of the index file data.
+
+\return The function returns the checksum.
+*/
+//------------------------------------------------------------------------------
+static UINT32 calcIndexChecksum(const UINT8* pData_p, size_t size_p)
+{
+    UINT32  checksum = 0x811C9DC5;
+    size_t  i;
+
+    for (i = 0; i < size_p; i++)
+    {
+        checksum ^= pData_p[i];
+        checksum *= 0x01000193;
+    }
+
+    return checksum;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Check if a CDC entry is linked into the OD
+
+The function checks whether a CDC entry is a ConciseDCF of object 0x1F22 which
+is linked into the OD instead of being written.
+
+\param[in]      pEntry_p            Pointer to the CDC entry.
+
+\return The function returns TRUE if the entry is linked into the OD.
+*/
+//------------------------------------------------------------------------------
+static BOOL isLinkableEntry(const tObdCdcEntry* pEntry_p)
+{
+    return ((pEntry_p->index == OBDCDC_IDX_CONCISEDCF_LIST) &&
+            (pEntry_p->subIndex != 0) &&
+            (pEntry_p->subIndex <= NMT_MAX_NODE_ID));
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Link CDC entries into the OD
+
+The function writes the parsed CDC entries into the OD. The ConciseDCFs of
+object 0x1F22 are copied into a single allocated buffer which is linked into
+the OD. Entries which cannot be linked are written into the OD.
+
+\param[in]      pCdc_p              Pointer to the CDC.
+\param[in]      paEntries_p         Parsed CDC entries.
+\param[in]      entryCount_p        Number of parsed CDC entries.
+\param[out]     ppDcfData_p         Pointer to store the allocated buffer of the
+                                    linked ConciseDCFs. It is set to NULL if no
+                                    ConciseDCF has been linked.
+\param[out]     pDcfDataSize_p      Pointer to store the size of the buffer.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError linkCdcEntries(const UINT8* pCdc_p,
+                                 const tObdCdcEntry* paEntries_p,
+                                 UINT32 entryCount_p,
+                                 UINT8** ppDcfData_p,
+                                 size_t* pDcfDataSize_p)
+{
+    tOplkError          ret = kErrorOk;
+    const tObdCdcEntry* pEntry;
+    tVarParam           varParam;
+    UINT32              entry;
+    UINT8*              pDcfData = NULL;
+    size_t              dcfDataSize = 0;
+    size_t              dcfOffset = 0;
+
+    for (entry = 0; entry < entryCount_p; entry++)
+    {
+        if (isLinkableEntry(&paEntries_p[entry]))
+            dcfDataSize += paEntries_p[entry].dataSize;
+    }
+
+    // if the buffer cannot be allocated, the ConciseDCFs are written into the OD
+    if (dcfDataSize > 0)
+        pDcfData = (UINT8*)OPLK_MALLOC(dcfDataSize);
+
+    for (entry = 0; entry < entryCount_p; entry++)
+    {
+        pEntry = &paEntries_p[entry];
+
+        if ((pDcfData != NULL) && isLinkableEntry(pEntry))
+        {
+            OPLK_MEMCPY(&pDcfData[dcfOffset], &pCdc_p[pEntry->dataOffset], pEntry->dataSize);
+            varParam.pData = &pDcfData[dcfOffset];
+            varParam.size = (tObdSize)pEntry->dataSize;
+            varParam.index = pEntry->index;
+            varParam.subindex = pEntry->subIndex;
+            varParam.validFlag = kVarValidAll;
+            if (obdu_defineVar(&varParam) == kErrorOk)
+            {
+                dcfOffset += pEntry->dataSize;
+                continue;
+            }
+        }
+
+        ret = writeCdcEntry(pEntry->index, pEntry->subIndex, &pCdc_p[pEntry->dataOffset], pEntry->dataSize);
+        if (ret != kErrorOk)
+            break;
+    }
+
+    if ((pDcfData != NULL) && (dcfOffset == 0))
+    {
+        OPLK_FREE(pDcfData);
+        pDcfData = NULL;
+        dcfDataSize = 0;
+    }
+
+    *ppDcfData_p = pDcfData;
+    *pDcfDataSize_p = dcfDataSize;
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Unlink CDC entries from the OD
+
+The function links the sub-indices of object 0x1F22 which still refer to the
+ConciseDCFs copied from a CDC file to the default ConciseDCF of the CFM.
+Sub-indices which have been relinked in the meantime (e.g. by an SDO write) are
+not changed.
+
+\param[in]      pMapping_p          Pointer to the parsed CDC file.
+*/
+//------------------------------------------------------------------------------
+static void unlinkCdcEntries(const tObdCdcMapping* pMapping_p)
+{
+    UINT            subIndex;
+    const UINT8*    pData;
+
+    if (pMapping_p->pDcfData == NULL)
+        return;
+
+    for (subIndex = 1; subIndex <= NMT_MAX_NODE_ID; subIndex++)
+    {
+        pData = (const UINT8*)obdu_getObjectDataPtr(OBDCDC_IDX_CONCISEDCF_LIST, subIndex);
+        if ((pData >= pMapping_p->pDcfData) &&
+            (pData < (pMapping_p->pDcfData + pMapping_p->dcfDataSize)))
+        {
+            cfmu_linkDefaultConciseDcf(subIndex);
+            // ignore return code, because the buffer is released anyway
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Release CDC mapping
+
+The function unlinks the OD from the ConciseDCFs copied from the CDC file and
+frees them together with the parsed entries.
+*/
+//------------------------------------------------------------------------------
+static void releaseCdcMapping(void)
+{
+    tObdCdcMapping* pMapping = &cdcInstance_l.mapping;
+
+    unlinkCdcEntries(pMapping);
+
+    if (pMapping->pDcfData != NULL)
+    {
+        OPLK_FREE(pMapping->pDcfData);
+        pMapping->pDcfData = NULL;
+        pMapping->dcfDataSize = 0;
+    }
+
+    if (pMapping->paEntries != NULL)
+    {
+        OPLK_FREE(pMapping->paEntries);
+        pMapping->paEntries = NULL;
+        pMapping->entryCount = 0;
+    }
+}
+#endif
+
 /// \}
 
 #endif
@@ -51,6 +51,15 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #if (TARGET_SYSTEM == _LINUX_)
 
 #include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#elif (TARGET_SYSTEM == _WIN32_)
+
+#include <io.h>
+#include <windows.h>
 
 #endif
 
@@ -94,15 +103,29 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define OBD_ARCHIVE_FILENAME_EXTENSION      ".bin"
 #endif
 
+#ifndef OBD_ARCHIVE_TMP_EXTENSION
+#define OBD_ARCHIVE_TMP_EXTENSION           ".tmp"
+#endif
+
+#ifndef OBD_ARCHIVE_INITIAL_BUFFER_SIZE
+#define OBD_ARCHIVE_INITIAL_BUFFER_SIZE     1024
+#endif
+
+#define OBD_ARCHIVE_HEADER_SIZE             (2 * sizeof(UINT32))    // target signature + OD signature
+#define OBD_ARCHIVE_CRC_SIZE                2
+
 //------------------------------------------------------------------------------
 // local types
 //------------------------------------------------------------------------------
 typedef struct
 {
-    FILE*       pFdBkupArchiveFile;     ///< Handle for the opened OD part archive
+    UINT8*      pArchive;               ///< Write buffer or mapped archive of the opened OD part
+    size_t      archiveSize;            ///< Size of the archive data in bytes
+    size_t      bufferSize;             ///< Size of the allocated write buffer in bytes
+    size_t      readOffset;             ///< Read position in the opened archive
+    BOOL        fMapped;                ///< Flag to indicate whether the archive is mapped into memory
     const char* pBackupPath;            ///< The parent directory for the archives
     BOOL        fOpenForWrite;          ///< Flag to indicate whether the archive is opened for a write operation
-    UINT16      odDataCrc;              ///< 2 Byte CRC for the last opened archive
     tObdType    curOdPart;              ///< Currently opened OD part archive
 } tObdConfInstance;
 
@@ -118,6 +141,20 @@ static tObdConfInstance aObdConfInstance_l[1];
 static tOplkError getOdPartArchivePath(tObdPart odPart_p,
                                        const char* pBkupPath_p,
                                        char* pFilePathName_p);
+static tOplkError appendArchiveData(tObdConfInstance* pInstEntry_p,
+                                    const void* pData_p,
+                                    size_t size_p);
+static tOplkError writeArchiveFile(const char* pFilePath_p,
+                                   const UINT8* pData_p,
+                                   size_t size_p);
+#if (TARGET_SYSTEM == _LINUX_)
+static tOplkError syncParentDirectory(const char* pFilePath_p);
+#endif
+static tOplkError mapArchiveFile(const char* pFilePath_p,
+                                 tObdConfInstance* pInstEntry_p);
+static tOplkError validateArchive(const tObdConfInstance* pInstEntry_p,
+                                  UINT32 odPartSignature_p);
+static void       releaseArchive(tObdConfInstance* pInstEntry_p);
 
 /***************************************************************************/
 /*          C L A S S  <Store/Load>                                        */
@@ -163,6 +200,11 @@ static tOplkError getOdPartArchivePath(tObdPart odPart_p,
           +----------------------+
   0xNNNN  | OD data CRC          | (2 Bytes)
           +----------------------+
+
+  An archive is collected in a RAM buffer and written with a single write
+  operation into a temporary file when it is closed. The temporary file
+  replaces the archive by renaming it, therefore an interrupted store
+  operation leaves the previous archive intact.
 */
 
 //============================================================================//
@@ -188,7 +230,7 @@ tOplkError obdconf_init(void)
 
     // Get current instance entry and initialize all members
     OPLK_MEMSET(pInstEntry, 0, sizeof(tObdConfInstance));
-    pInstEntry->pFdBkupArchiveFile = NULL;
+    pInstEntry->pArchive = NULL;
     pInstEntry->curOdPart = kObdPartNo;
 
     return ret;
@@ -210,6 +252,8 @@ tOplkError obdconf_exit(void)
     tOplkError        ret = kErrorOk;
     tObdConfInstance* pInstEntry = &aObdConfInstance_l[0];
 
+    releaseArchive(pInstEntry);
+
     OPLK_MEMSET(pInstEntry, 0, sizeof(tObdConfInstance));
     obdConfSignature_l = (UINT32)~0U;
 
@@ -220,8 +264,9 @@ tOplkError obdconf_exit(void)
 /**
 \brief  Create an archive for the OD part
 
-The function creates an archive for the selected OD part.
-Existing archive is set invalid.
+The function creates an archive for the selected OD part. The archive is
+collected in memory and written to the file system when it is closed.
+Therefore, an existing archive stays valid until the new archive is complete.
 
 \param[in]      odPart_p            OD part specifier
 \param[in]      odPartSignature_p   Signature for the specified OD part.
@@ -237,58 +282,35 @@ tOplkError obdconf_createPart(tObdPart odPart_p, UINT32 odPartSignature_p)
     char                aFilePath[MAX_PATH_LEN];
     tObdConfInstance*   pInstEntry = &aObdConfInstance_l[0];
 
-    // Get the file path for current OD part and instance
+    // Check the OD part by getting its file path
     ret = getOdPartArchivePath(odPart_p, pInstEntry->pBackupPath, &aFilePath[0]);
     if (ret != kErrorOk)
         goto Exit;
 
-    // Is the file already opened?
-    if (pInstEntry->pFdBkupArchiveFile != NULL)
+    // Is the archive already opened?
+    if (pInstEntry->pArchive != NULL)
     {
         ret = kErrorObdStoreInvalidState;
         goto Exit;
     }
 
-    // Open file for writing
     pInstEntry->fOpenForWrite = TRUE;
-    pInstEntry->curOdPart = odPart_p;
-    pInstEntry->pFdBkupArchiveFile = fopen(aFilePath, "wb");
-    if (pInstEntry->pFdBkupArchiveFile == NULL)
-    {
-        pInstEntry->curOdPart = kObdPartNo;
-        ret = kErrorObdStoreHwError;
-        goto Exit;
-    }
+    pInstEntry->fMapped = FALSE;
+    pInstEntry->archiveSize = 0;
+    pInstEntry->bufferSize = 0;
 
-    // Write target signature and calculate CRC for it
-    pInstEntry->odDataCrc = obdconf_calculateCrc16(0,
-                                                   &obdConfSignature_l,
-                                                   sizeof(obdConfSignature_l));
-    fwrite(&obdConfSignature_l,
-           sizeof(obdConfSignature_l),
-           1,
-           pInstEntry->pFdBkupArchiveFile);
-    if (ferror(pInstEntry->pFdBkupArchiveFile))
-    {
-        ret = kErrorObdStoreHwError;
-        goto Exit;
-    }
+    // Write target signature and OD signature
+    ret = appendArchiveData(pInstEntry, &obdConfSignature_l, sizeof(obdConfSignature_l));
+    if (ret == kErrorOk)
+        ret = appendArchiveData(pInstEntry, &odPartSignature_p, sizeof(odPartSignature_p));
 
-    // Write OD signature and calculate CRC for it
-    pInstEntry->odDataCrc = obdconf_calculateCrc16(pInstEntry->odDataCrc,
-                                                   &odPartSignature_p,
-                                                   sizeof(odPartSignature_p));
-    fwrite(&odPartSignature_p,
-           sizeof(odPartSignature_p),
-           1,
-           pInstEntry->pFdBkupArchiveFile);
-    if (ferror(pInstEntry->pFdBkupArchiveFile))
+    if (ret != kErrorOk)
     {
-        ret = kErrorObdStoreHwError;
+        releaseArchive(pInstEntry);
         goto Exit;
     }
 
-    ret = kErrorOk;
+    pInstEntry->curOdPart = odPart_p;
 
 Exit:
     return ret;
@@ -309,54 +331,14 @@ The function deletes the archive for the selected OD part or sets it invalid.
 //------------------------------------------------------------------------------
 tOplkError obdconf_deletePart(tObdPart odPart_p)
 {
-    tOplkError          ret = kErrorObdStoreHwError;
-    char                aFilePath[MAX_PATH_LEN];
-    tObdConfInstance*   pInstEntry = &aObdConfInstance_l[0];
-    UINT32              data = (UINT32)~0U;
+    tOplkError  ret;
 
-    // Get the file path for current OD part and instance
-    ret = getOdPartArchivePath(odPart_p, pInstEntry->pBackupPath, &aFilePath[0]);
+    // Replace the archive by an archive with an invalid OD signature and a valid CRC
+    ret = obdconf_createPart(odPart_p, (UINT32)~0U);
     if (ret != kErrorOk)
-        goto Exit;
-
-    // Use the local file handle to avoid race condition
-    if (pInstEntry->pFdBkupArchiveFile != NULL)
-    {
-        ret = kErrorObdStoreInvalidState;
-        goto Exit;
-    }
-
-    pInstEntry->pFdBkupArchiveFile = fopen(aFilePath, "wb");
-    if (pInstEntry->pFdBkupArchiveFile == NULL)
-    {
-        ret = kErrorObdStoreHwError;
-        goto Exit;
-    }
-
-    // Set file position to OD part signature
-    fseek(pInstEntry->pFdBkupArchiveFile, sizeof(obdConfSignature_l), SEEK_SET);
-
-    // Mark the signature as invalid
-    fwrite(&data, sizeof(data), 1, pInstEntry->pFdBkupArchiveFile);
-    if (ferror(pInstEntry->pFdBkupArchiveFile))
-    {
-        ret = kErrorObdStoreHwError;
-        goto Exit;
-    }
-
-    // $$ Ideally recalculate the CRC and write to make the file as uncorrupted
-
-    ret = kErrorOk;
+        return ret;
 
-Exit:
-    // Close archive file and set file handle invalid
-    if (pInstEntry->pFdBkupArchiveFile != NULL)
-    {
-        fclose(pInstEntry->pFdBkupArchiveFile);
-        pInstEntry->pFdBkupArchiveFile = NULL;
-    }
-
-    return ret;
+    return obdconf_closePart(odPart_p);
 }
 
 //------------------------------------------------------------------------------
@@ -376,7 +358,7 @@ to calling this function.
 //------------------------------------------------------------------------------
 tOplkError obdconf_openReadPart(tObdPart odPart_p)
 {
-    UINT8               ret = kErrorObdStoreHwError;
+    tOplkError          ret = kErrorObdStoreHwError;
     char                aFilePath[MAX_PATH_LEN];
     tObdConfInstance*   pInstEntry = &aObdConfInstance_l[0];
 
@@ -385,30 +367,29 @@ tOplkError obdconf_openReadPart(tObdPart odPart_p)
     if (ret != kErrorOk)
         goto Exit;
 
-    // Is the file already opened?
-    if (pInstEntry->pFdBkupArchiveFile != NULL)
+    // Is the archive already opened?
+    if (pInstEntry->pArchive != NULL)
     {
         ret = kErrorObdStoreInvalidState;
         goto Exit;
     }
 
-    // Open backup archive file for read
+    // Map backup archive file for read
     pInstEntry->fOpenForWrite = FALSE;
-    pInstEntry->curOdPart = odPart_p;
-    pInstEntry->pFdBkupArchiveFile = fopen(aFilePath, "rb");
+    ret = mapArchiveFile(aFilePath, pInstEntry);
+    if (ret != kErrorOk)
+        goto Exit;
 
-    if (pInstEntry->pFdBkupArchiveFile == NULL)
+    if (pInstEntry->archiveSize < (OBD_ARCHIVE_HEADER_SIZE + OBD_ARCHIVE_CRC_SIZE))
     {
-        // Backup archive file could not be opened
-        pInstEntry->curOdPart = kObdPartNo;
+        releaseArchive(pInstEntry);
         ret = kErrorObdStoreHwError;
         goto Exit;
     }
 
-    // Set file position to the object data part
-    fseek(pInstEntry->pFdBkupArchiveFile, 2 * sizeof(UINT32), SEEK_SET);
-
-    ret = kErrorOk;
+    // Set read position to the object data part
+    pInstEntry->readOffset = OBD_ARCHIVE_HEADER_SIZE;
+    pInstEntry->curOdPart = odPart_p;
 
 Exit:
     return ret;
@@ -423,7 +404,8 @@ operation to load/store the OD configuration. The OD part archive must exist
 prior to calling this function.
 
 For a write operation, the function appends the calculated CRC to the end of
-archive.
+the archive and writes the archive to a temporary file. The temporary file is
+then renamed to the archive file.
 
 \param[in]      odPart_p            OD part specifier
 
@@ -435,7 +417,9 @@ archive.
 tOplkError obdconf_closePart(tObdPart odPart_p)
 {
     tOplkError          ret = kErrorOk;
-    UINT8               data;
+    UINT8               aCrc[OBD_ARCHIVE_CRC_SIZE];
+    UINT16              dataCrc;
+    char                aFilePath[MAX_PATH_LEN];
     tObdConfInstance*   pInstEntry = &aObdConfInstance_l[0];
 
     if (odPart_p != pInstEntry->curOdPart)
@@ -444,39 +428,35 @@ tOplkError obdconf_closePart(tObdPart odPart_p)
         goto Exit;
     }
 
-    // Is the file not opened?
-    if (pInstEntry->pFdBkupArchiveFile == NULL)
+    // Is the archive not opened?
+    if (pInstEntry->pArchive == NULL)
     {
         ret = kErrorObdStoreInvalidState;
         goto Exit;
     }
 
-    // If file was opened for write we have to add the OD data CRC at the end of the file
+    // If archive was opened for write we have to add the OD data CRC and write the file
     if (pInstEntry->fOpenForWrite != FALSE)
     {
-        // Write CRC16 to end of the file (in big endian format)
-        data = (UINT8)((pInstEntry->odDataCrc >> 8) & 0xFF);
-        fwrite(&data, sizeof(data), 1, pInstEntry->pFdBkupArchiveFile);
-        if (ferror(pInstEntry->pFdBkupArchiveFile))
-        {   // Save error code and close the file
-            ret = kErrorObdStoreHwError;
+        // Append CRC16 to end of the archive (in big endian format)
+        dataCrc = obdconf_calculateCrc16(0, pInstEntry->pArchive, pInstEntry->archiveSize);
+        aCrc[0] = (UINT8)((dataCrc >> 8) & 0xFF);
+        aCrc[1] = (UINT8)((dataCrc >> 0) & 0xFF);
+        ret = appendArchiveData(pInstEntry, aCrc, sizeof(aCrc));
+        if (ret != kErrorOk)
             goto CloseExit;
-        }
 
-        data = (UINT8)((pInstEntry->odDataCrc >> 0) & 0xFF);
-        fwrite(&data, sizeof(data), 1, pInstEntry->pFdBkupArchiveFile);
-        if (ferror(pInstEntry->pFdBkupArchiveFile))
-        {   // Save error code and close the file
-            ret = kErrorObdStoreHwError;
+        ret = getOdPartArchivePath(odPart_p, pInstEntry->pBackupPath, &aFilePath[0]);
+        if (ret != kErrorOk)
             goto CloseExit;
-        }
+
+        ret = writeArchiveFile(aFilePath, pInstEntry->pArchive, pInstEntry->archiveSize);
     }
 
 CloseExit:
-    // Close archive file and set file handle invalid
-    fclose(pInstEntry->pFdBkupArchiveFile);
+    // Release archive and set it invalid
+    releaseArchive(pInstEntry);
     pInstEntry->curOdPart = kObdPartNo;
-    pInstEntry->pFdBkupArchiveFile = NULL;
 
 Exit:
     return ret;
@@ -510,23 +490,15 @@ tOplkError obdconf_storePart(tObdPart odPart_p, const void* pData_p, size_t size
         goto Exit;
     }
 
-    // Is the file not opened?
-    if (pInstEntry->pFdBkupArchiveFile == NULL)
+    // Is the archive not opened for write?
+    if ((pInstEntry->pArchive == NULL) || (pInstEntry->fOpenForWrite == FALSE))
     {
         ret = kErrorObdStoreInvalidState;
         goto Exit;
     }
 
-    // Write current OD data to the file and calculate the CRC for it
-    pInstEntry->odDataCrc = obdconf_calculateCrc16(pInstEntry->odDataCrc, pData_p, size_p);
-    fwrite(pData_p, size_p, 1, pInstEntry->pFdBkupArchiveFile);
-    if (ferror(pInstEntry->pFdBkupArchiveFile))
-    {
-        ret = kErrorObdStoreHwError;
-        goto Exit;
-    }
-
-    ret = kErrorOk;
+    // Append current OD data to the archive, the CRC is calculated when the archive is closed
+    ret = appendArchiveData(pInstEntry, pData_p, size_p);
 
 Exit:
     return ret;
@@ -555,7 +527,6 @@ tOplkError obdconf_loadPart(tObdPart odPart_p,
 {
     tOplkError          ret = kErrorObdStoreHwError;
     tObdConfInstance*   pInstEntry = &aObdConfInstance_l[0];
-    size_t              count;
 
     if (odPart_p != pInstEntry->curOdPart)
     {
@@ -563,27 +534,24 @@ tOplkError obdconf_loadPart(tObdPart odPart_p,
         goto Exit;
     }
 
-    // Is the file not opened?
-    if (pInstEntry->pFdBkupArchiveFile == NULL)
+    // Is the archive not opened for read?
+    if ((pInstEntry->pArchive == NULL) || (pInstEntry->fOpenForWrite != FALSE))
     {
         ret = kErrorObdStoreInvalidState;
         goto Exit;
     }
 
-    // Read OD data from current file position
-    count = fread(pData_p, size_p, 1, pInstEntry->pFdBkupArchiveFile);
-    if (ferror(pInstEntry->pFdBkupArchiveFile) || (count == 0))
-    {
-        ret = kErrorObdStoreHwError;
-        goto Exit;
-    }
-
-    if (feof(pInstEntry->pFdBkupArchiveFile))
+    // The OD data must not exceed the data part of the archive
+    if (size_p > (pInstEntry->archiveSize - OBD_ARCHIVE_CRC_SIZE - pInstEntry->readOffset))
     {
         ret = kErrorObdStoreDataLimitExceeded;
         goto Exit;
     }
 
+    // Read OD data from current position
+    OPLK_MEMCPY(pData_p, &pInstEntry->pArchive[pInstEntry->readOffset], size_p);
+    pInstEntry->readOffset += size_p;
+
     ret = kErrorOk;
 
 Exit:
@@ -673,9 +641,7 @@ Exit:
 This function checks the data integrity and signature of the specified
 OD part archive and returns if the archive is valid or invalid.
 
-The OD part archive has to opened prior to calling this function.
-The function resets the read pointer for the archive to the beginning
-of the configuration data.
+The archive is mapped into memory and validated in a single pass.
 
 \param[in]      odPart_p            OD part specifier.
 \param[in]      odPartSignature_p   Signature for the specified OD part.
@@ -690,11 +656,6 @@ of the configuration data.
 tOplkError obdconf_getPartArchiveState(tObdPart odPart_p, UINT32 odPartSignature_p)
 {
     tOplkError          ret = kErrorOk;
-    UINT32              readTargetSign;
-    UINT32              readOdSign;
-    UINT8               aTempBuffer[8];
-    size_t              count;
-    UINT16              dataCrc;
     tObdConfInstance*   pInstEntry = &aObdConfInstance_l[0];
     char                aFilePath[MAX_PATH_LEN];
 
@@ -703,74 +664,22 @@ tOplkError obdconf_getPartArchiveState(tObdPart odPart_p, UINT32 odPartSignature
     if (ret != kErrorOk)
         goto Exit;
 
-    // Use the local file handle to avoid race conditions
-    if (pInstEntry->pFdBkupArchiveFile != NULL)
+    // Use the instance archive to avoid race conditions
+    if (pInstEntry->pArchive != NULL)
     {
         ret = kErrorObdStoreInvalidState;
         goto Exit;
     }
 
-    // Open backup archive file for read
-    pInstEntry->pFdBkupArchiveFile = fopen(aFilePath, "rb");
-    if (pInstEntry->pFdBkupArchiveFile == NULL)
-    {
-        // Backup archive file could not be opened
-        ret = kErrorObdStoreHwError;
-        goto Exit;
-    }
-
-    // Set file position to the begin of the file
-    fseek(pInstEntry->pFdBkupArchiveFile, 0, SEEK_SET);
-
-    // Read target signature and calculate the CRC for it
-    count = fread(&readTargetSign, sizeof(readTargetSign), 1, pInstEntry->pFdBkupArchiveFile);
-    dataCrc = obdconf_calculateCrc16(0, &readTargetSign, sizeof(readTargetSign));
-    if (ferror(pInstEntry->pFdBkupArchiveFile) || feof(pInstEntry->pFdBkupArchiveFile) || (count == 0))
-    {
-        ret = kErrorObdStoreHwError;
-        goto Exit;
-    }
-
-    // Read OD signature and calculate the CRC for it
-    count = fread(&readOdSign, sizeof(readOdSign), 1, pInstEntry->pFdBkupArchiveFile);
-    dataCrc = obdconf_calculateCrc16(dataCrc, &readOdSign, sizeof(readOdSign));
-    if (ferror(pInstEntry->pFdBkupArchiveFile) || feof(pInstEntry->pFdBkupArchiveFile) || (count == 0))
-    {
-        ret = kErrorObdStoreHwError;
-        goto Exit;
-    }
-
-    // Check if both target signature and OD signature are correct
-    if ((readTargetSign != obdConfSignature_l) || (readOdSign  != odPartSignature_p))
-    {
-        ret = kErrorObdStoreDataObsolete;
+    // Map backup archive file and validate it
+    ret = mapArchiveFile(aFilePath, pInstEntry);
+    if (ret != kErrorOk)
         goto Exit;
-    }
 
-    // Calculate OD data CRC over all data bytes
-    while (!feof(pInstEntry->pFdBkupArchiveFile))
-    {
-        count = fread(&aTempBuffer[0], 1, sizeof(aTempBuffer), pInstEntry->pFdBkupArchiveFile);
-        if (!ferror(pInstEntry->pFdBkupArchiveFile) && (count > 0))
-            dataCrc = obdconf_calculateCrc16(dataCrc, &aTempBuffer[0], count);
-        else
-            break;
-    }
-
-    // Check OD data CRC (always zero because CRC has to be set at the end of the file in big endian format)
-    if (dataCrc != 0)
-    {
-        ret = kErrorObdStoreHwError;
-        goto Exit;
-    }
+    ret = validateArchive(pInstEntry, odPartSignature_p);
+    releaseArchive(pInstEntry);
 
 Exit:
-    if (pInstEntry->pFdBkupArchiveFile != NULL)
-    {
-        fclose(pInstEntry->pFdBkupArchiveFile);
-        pInstEntry->pFdBkupArchiveFile = NULL;
-    }
-
     return ret;
 }
 
@@ -878,6 +787,309 @@ Exit:
     return ret;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Append data to the archive
+
+The function appends data to the write buffer of the archive. The buffer is
+enlarged if necessary.
+
+\param[in,out]  pInstEntry_p        Pointer to the instance entry.
+\param[in]      pData_p             Pointer to the data to append.
+\param[in]      size_p              Size of the data in bytes.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError appendArchiveData(tObdConfInstance* pInstEntry_p,
+                                    const void* pData_p,
+                                    size_t size_p)
+{
+    UINT8*  pBuffer;
+    size_t  bufferSize;
+
+    if ((pInstEntry_p->archiveSize + size_p) > pInstEntry_p->bufferSize)
+    {
+        bufferSize = (pInstEntry_p->bufferSize != 0) ? pInstEntry_p->bufferSize : OBD_ARCHIVE_INITIAL_BUFFER_SIZE;
+        while (bufferSize < (pInstEntry_p->archiveSize + size_p))
+            bufferSize <<= 1;
+
+        pBuffer = (UINT8*)OPLK_MALLOC(bufferSize);
+        if (pBuffer == NULL)
+            return kErrorNoResource;
+
+        if (pInstEntry_p->pArchive != NULL)
+        {
+            OPLK_MEMCPY(pBuffer, pInstEntry_p->pArchive, pInstEntry_p->archiveSize);
+            OPLK_FREE(pInstEntry_p->pArchive);
+        }
+
+        pInstEntry_p->pArchive = pBuffer;
+        pInstEntry_p->bufferSize = bufferSize;
+    }
+
+    OPLK_MEMCPY(&pInstEntry_p->pArchive[pInstEntry_p->archiveSize], pData_p, size_p);
+    pInstEntry_p->archiveSize += size_p;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Write an archive file
+
+The function writes the archive data with a single write operation into a
+temporary file and flushes it to the storage medium. Afterwards, the temporary
+file atomically replaces the archive file and the replacement is flushed to the
+storage medium as well.
+
+\param[in]      pFilePath_p         Path of the archive file.
+\param[in]      pData_p             Pointer to the archive data.
+\param[in]      size_p              Size of the archive data in bytes.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError writeArchiveFile(const char* pFilePath_p,
+                                   const UINT8* pData_p,
+                                   size_t size_p)
+{
+    FILE*   pFile;
+    char    aTmpFilePath[MAX_PATH_LEN + sizeof(OBD_ARCHIVE_TMP_EXTENSION)];
+    BOOL    fError;
+
+    strcpy(aTmpFilePath, pFilePath_p);
+    strcat(aTmpFilePath, OBD_ARCHIVE_TMP_EXTENSION);
+
+    pFile = fopen(aTmpFilePath, "wb");
+    if (pFile == NULL)
+        return kErrorObdStoreHwError;
+
+    fError = (fwrite(pData_p, size_p, 1, pFile) != 1);
+    fError |= (fflush(pFile) != 0);
+
+    // Make sure that the data is on the medium before the archive is replaced
+#if (TARGET_SYSTEM == _LINUX_)
+    fError |= (fsync(fileno(pFile)) != 0);
+#elif (TARGET_SYSTEM == _WIN32_)
+    fError |= (_commit(_fileno(pFile)) != 0);
+#endif
+
+    fError |= (fclose(pFile) != 0);
+    if (fError)
+    {
+        remove(aTmpFilePath);
+        return kErrorObdStoreHwError;
+    }
+
+#if (TARGET_SYSTEM == _WIN32_)
+    // rename() does not replace an existing file on Windows
+    if (!MoveFileEx(aTmpFilePath, pFilePath_p,
+                    MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH))
+#else
+    if (rename(aTmpFilePath, pFilePath_p) != 0)
+#endif
+    {
+        remove(aTmpFilePath);
+        return kErrorObdStoreHwError;
+    }
+
+#if (TARGET_SYSTEM == _LINUX_)
+    // The new directory entry is only durable after the directory is flushed
+    return syncParentDirectory(pFilePath_p);
+#else
+    return kErrorOk;
+#endif
+}
+
+#if (TARGET_SYSTEM == _LINUX_)
+//------------------------------------------------------------------------------
+/**
+\brief  Flush the parent directory of a file
+
+The function flushes the directory which contains the given file to the storage
+medium.
+
+\param[in]      pFilePath_p         Path of the file.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError syncParentDirectory(const char* pFilePath_p)
+{
+    char        aDirPath[MAX_PATH_LEN];
+    const char* pSeparator;
+    int         fd;
+    BOOL        fError;
+
+    pSeparator = strrchr(pFilePath_p, '/');
+    if (pSeparator == NULL)
+        strcpy(aDirPath, ".");
+    else if (pSeparator == pFilePath_p)
+        strcpy(aDirPath, "/");
+    else
+    {
+        if ((size_t)(pSeparator - pFilePath_p) >= sizeof(aDirPath))
+            return kErrorObdStoreHwError;
+
+        OPLK_MEMCPY(aDirPath, pFilePath_p, pSeparator - pFilePath_p);
+        aDirPath[pSeparator - pFilePath_p] = '\0';
+    }
+
+    fd = open(aDirPath, O_RDONLY | O_DIRECTORY);
+    if (fd < 0)
+        return kErrorObdStoreHwError;
+
+    fError = (fsync(fd) != 0);
+    fError |= (close(fd) != 0);
+
+    return fError ? kErrorObdStoreHwError : kErrorOk;
+}
+#endif
+
+//------------------------------------------------------------------------------
+/**
+\brief  Map an archive file
+
+The function maps an archive file into memory. If memory mapping is not
+available, the file is read into a buffer.
+
+\param[in]      pFilePath_p         Path of the archive file.
+\param[in,out]  pInstEntry_p        Pointer to the instance entry.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError mapArchiveFile(const char* pFilePath_p,
+                                 tObdConfInstance* pInstEntry_p)
+{
+#if (TARGET_SYSTEM == _LINUX_)
+    int             fd;
+    struct stat     fileStat;
+    void*           pMap;
+
+    fd = open(pFilePath_p, O_RDONLY);
+    if (fd < 0)
+        return kErrorObdStoreHwError;
+
+    if ((fstat(fd, &fileStat) != 0) || (fileStat.st_size <= 0))
+    {
+        close(fd);
+        return kErrorObdStoreHwError;
+    }
+
+    pMap = mmap(NULL, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (pMap == MAP_FAILED)
+        return kErrorObdStoreHwError;
+
+    pInstEntry_p->pArchive = (UINT8*)pMap;
+    pInstEntry_p->archiveSize = (size_t)fileStat.st_size;
+    pInstEntry_p->fMapped = TRUE;
+#else
+    FILE*   pFile;
+    long    fileSize;
+    UINT8*  pBuffer;
+
+    pFile = fopen(pFilePath_p, "rb");
+    if (pFile == NULL)
+        return kErrorObdStoreHwError;
+
+    fseek(pFile, 0, SEEK_END);
+    fileSize = ftell(pFile);
+    fseek(pFile, 0, SEEK_SET);
+    if (fileSize <= 0)
+    {
+        fclose(pFile);
+        return kErrorObdStoreHwError;
+    }
+
+    pBuffer = (UINT8*)OPLK_MALLOC((size_t)fileSize);
+    if (pBuffer == NULL)
+    {
+        fclose(pFile);
+        return kErrorNoResource;
+    }
+
+    if (fread(pBuffer, (size_t)fileSize, 1, pFile) != 1)
+    {
+        OPLK_FREE(pBuffer);
+        fclose(pFile);
+        return kErrorObdStoreHwError;
+    }
+
+    fclose(pFile);
+
+    pInstEntry_p->pArchive = pBuffer;
+    pInstEntry_p->archiveSize = (size_t)fileSize;
+    pInstEntry_p->fMapped = FALSE;
+#endif
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Validate a mapped archive
+
+The function checks the signatures and the CRC of a mapped archive.
+
+\param[in]      pInstEntry_p        Pointer to the instance entry.
+\param[in]      odPartSignature_p   Signature for the OD part.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError validateArchive(const tObdConfInstance* pInstEntry_p,
+                                  UINT32 odPartSignature_p)
+{
+    UINT32  readTargetSign;
+    UINT32  readOdSign;
+
+    if (pInstEntry_p->archiveSize < (OBD_ARCHIVE_HEADER_SIZE + OBD_ARCHIVE_CRC_SIZE))
+        return kErrorObdStoreHwError;
+
+    // Check if both target signature and OD signature are correct
+    OPLK_MEMCPY(&readTargetSign, &pInstEntry_p->pArchive[0], sizeof(readTargetSign));
+    OPLK_MEMCPY(&readOdSign, &pInstEntry_p->pArchive[sizeof(readTargetSign)], sizeof(readOdSign));
+    if ((readTargetSign != obdConfSignature_l) || (readOdSign != odPartSignature_p))
+        return kErrorObdStoreDataObsolete;
+
+    // Check OD data CRC (always zero because CRC has to be set at the end of the file in big endian format)
+    if (obdconf_calculateCrc16(0, pInstEntry_p->pArchive, pInstEntry_p->archiveSize) != 0)
+        return kErrorObdStoreHwError;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Release the archive
+
+The function unmaps or frees the archive of the instance entry.
+
+\param[in,out]  pInstEntry_p        Pointer to the instance entry.
+*/
+//------------------------------------------------------------------------------
+static void releaseArchive(tObdConfInstance* pInstEntry_p)
+{
+    if (pInstEntry_p->pArchive == NULL)
+        return;
+
+#if (TARGET_SYSTEM == _LINUX_)
+    if (pInstEntry_p->fMapped != FALSE)
+        munmap(pInstEntry_p->pArchive, pInstEntry_p->archiveSize);
+    else
+#endif
+        OPLK_FREE(pInstEntry_p->pArchive);
+
+    pInstEntry_p->pArchive = NULL;
+    pInstEntry_p->archiveSize = 0;
+    pInstEntry_p->bufferSize = 0;
+    pInstEntry_p->readOffset = 0;
+    pInstEntry_p->fMapped = FALSE;
+}
+
 /// \}
 
 #endif // if (CONFIG_OBD_USE_STORE_RESTORE != FALSE)
@@ -71,6 +71,15 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // const defines
 //------------------------------------------------------------------------------
+#ifndef CONFIG_OBD_USE_LOOKUP_TABLE
+#define CONFIG_OBD_USE_LOOKUP_TABLE             FALSE
+#endif
+
+#if (CONFIG_OBD_USE_LOOKUP_TABLE != FALSE)
+#define OBD_LOOKUP_PAGE_SHIFT                   8
+#define OBD_LOOKUP_PAGE_SIZE                    (1 << OBD_LOOKUP_PAGE_SHIFT)
+#define OBD_LOOKUP_PAGE_COUNT                   (0x10000 >> OBD_LOOKUP_PAGE_SHIFT)
+#endif
 
 //------------------------------------------------------------------------------
 // local types
@@ -88,6 +97,34 @@ typedef struct
     tObdSize        (*pfnGetObjSize)(const tObdSubEntry* pSubIndexEntry_p);
 } tObdDataTypeSize;
 
+#if (CONFIG_OBD_USE_LOOKUP_TABLE != FALSE)
+/**
+\brief Lookup table entry of an OD index
+
+The lookup table maps every index of the OD directly to its OD entry. For array
+objects it additionally contains a private copy of the array sub-index entry for
+every array element. Therefore, array elements can be addressed directly without
+updating the sub-index number of the shared array sub-index entry.
+*/
+typedef struct
+{
+    const tObdEntry*    pObdEntry;          ///< Pointer to the OD entry of the index
+    BOOL                fDirectSubIndex;    ///< Sub-index n is located at position n of the sub-index table
+    tObdSubEntry*       paArraySubEntry;    ///< Sub-index entries of the array elements 1..count-1 (NULL if no array)
+} tObdLookupEntry;
+
+/**
+\brief Lookup table page
+
+A lookup table page contains the lookup entries of 256 consecutive indices.
+Pages are only allocated if at least one of their indices exists in the OD.
+*/
+typedef struct
+{
+    tObdLookupEntry     aEntry[OBD_LOOKUP_PAGE_SIZE];
+} tObdLookupPage;
+#endif
+
 typedef struct
 {
     tObdInitParam                   initParam;
@@ -97,6 +134,9 @@ typedef struct
     UINT32                          aOdSignature[3];
 #endif
     UINT8                           obdTrashObject[8];
+#if (CONFIG_OBD_USE_LOOKUP_TABLE != FALSE)
+    tObdLookupPage*                 apLookupPage[OBD_LOOKUP_PAGE_COUNT];
+#endif
 } tObdInstance;
 
 //------------------------------------------------------------------------------
@@ -164,6 +204,9 @@ static void*        getObjectDataPtr(const tObdSubEntry* pSubIndexEntry_p);
 static tObdEntry*   searchIndex(const tObdEntry* pObdEntry_p,
                                 UINT32 numEntries_p,
                                 UINT index_p);
+static tOplkError   searchOdIndex(const tObdInitParam* pInitParam_p,
+                                  UINT index_p,
+                                  const tObdEntry** ppObdEntry_p);
 static tOplkError   getIndex(const tObdInitParam* pInitParam_p,
                              UINT index_p,
                              const tObdEntry** ppObdEntry_p);
@@ -187,6 +230,15 @@ static tOplkError   isNumerical(const tObdSubEntry* pObdSubEntry_p,
 static UINT32       calcPartitionIndexNum(const tObdEntry* pObdEntry_p);
 static void         calcOdIndexNum(tObdInitParam* pInitParam_p);
 
+#if (CONFIG_OBD_USE_LOOKUP_TABLE != FALSE)
+static tOplkError   buildLookupTable(const tObdInitParam* pInitParam_p);
+static tOplkError   addPartitionToLookupTable(const tObdInitParam* pInitParam_p,
+                                              const tObdEntry* pObdEntry_p);
+static tOplkError   addLookupEntry(const tObdEntry* pObdEntry_p);
+static void         freeLookupTable(void);
+static const tObdLookupEntry* getLookupEntry(UINT index_p);
+#endif
+
 #if (CONFIG_OBD_CHECK_OBJECT_RANGE != FALSE)
 static tOplkError   checkObjectRange(const tObdSubEntry* pSubIndexEntry_p,
                                      const void* pData_p);
@@ -286,6 +338,12 @@ tOplkError obdu_init(const tObdInitParam* pInitParam_p,
 
     calcOdIndexNum(&obdInstance_l.initParam);
 
+#if (CONFIG_OBD_USE_LOOKUP_TABLE != FALSE)
+    ret = buildLookupTable(&obdInstance_l.initParam);
+    if (ret != kErrorOk)
+        return ret;
+#endif
+
     // initialize object dictionary
     // so all all VarEntries will be initialized to trash object and default values will be set to current data
     ret = obdu_accessOdPart(kObdPartAll, kObdDirInit);
@@ -306,6 +364,10 @@ The function shuts down the OD module.
 //------------------------------------------------------------------------------
 tOplkError obdu_exit(void)
 {
+#if (CONFIG_OBD_USE_LOOKUP_TABLE != FALSE)
+    freeLookupTable();
+#endif
+
     return kErrorOk;
 }
 
@@ -613,9 +675,17 @@ The function registers a user object dictionary.
 //------------------------------------------------------------------------------
 tOplkError obdu_registerUserOd(const tObdEntry* pUserOd_p)
 {
-    obdInitParam_l.pUserPart = (tObdEntry*)pUserOd_p;
+    tOplkError  ret = kErrorOk;
 
-    return kErrorOk;
+    obdInstance_l.initParam.pUserPart = (tObdEntry*)pUserOd_p;
+    obdInstance_l.initParam.numUser = (pUserOd_p != NULL) ? calcPartitionIndexNum(pUserOd_p) : 0;
+
+#if (CONFIG_OBD_USE_LOOKUP_TABLE != FALSE)
+    // the user OD changes the result of index searches, therefore the lookup table must be rebuilt
+    ret = buildLookupTable(&obdInstance_l.initParam);
+#endif
+
+    return ret;
 }
 #endif
 
@@ -2382,6 +2452,8 @@ static tObdEntry* searchIndex(const tObdEntry* pObdEntry_p,
             return (tObdEntry*)&pObdEntry_p[middle];
         else if (pObdEntry_p[middle].index < index_p)
             first = middle + 1;
+        else if (middle == 0)
+            break;                          // index is lower than the first entry
         else
             last = middle - 1;
     }
@@ -2449,7 +2521,9 @@ static void calcOdIndexNum(tObdInitParam* pInitParam_p)
 /**
 \brief  Get an index entry from the OD
 
-The function searches for an index entry in the OD.
+The function gets an index entry from the OD. If the lookup table is available,
+the entry is taken directly from it. Otherwise, or if the index is not contained
+in the lookup table, the OD partitions are searched.
 
 \param[in]      pInitParam_p        Pointer to the OD initialization parameters.
 \param[in]      index_p             Index to search.
@@ -2461,6 +2535,38 @@ The function searches for an index entry in the OD.
 static tOplkError getIndex(const tObdInitParam* pInitParam_p,
                            UINT index_p,
                            const tObdEntry** ppObdEntry_p)
+{
+#if (CONFIG_OBD_USE_LOOKUP_TABLE != FALSE)
+    const tObdLookupEntry*  pLookupEntry;
+
+    pLookupEntry = getLookupEntry(index_p);
+    if ((pLookupEntry != NULL) && (pLookupEntry->pObdEntry != NULL))
+    {
+        *ppObdEntry_p = pLookupEntry->pObdEntry;
+        return kErrorOk;
+    }
+    // The index does not exist, the search provides the correct error code
+#endif
+
+    return searchOdIndex(pInitParam_p, index_p, ppObdEntry_p);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Search an index entry in the OD
+
+The function searches for an index entry in the OD partitions.
+
+\param[in]      pInitParam_p        Pointer to the OD initialization parameters.
+\param[in]      index_p             Index to search.
+\param[out]     ppObdEntry_p        Pointer to store OD entry.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError searchOdIndex(const tObdInitParam* pInitParam_p,
+                                UINT index_p,
+                                const tObdEntry** ppObdEntry_p)
 {
     const tObdEntry*    pObdEntry;
     UINT32              numEntries;
@@ -2572,6 +2678,34 @@ static tOplkError getSubindex(const tObdEntry* pObdEntry_p,
     pSubEntry = pObdEntry_p->pSubIndex;
     nSubIndexCount = pObdEntry_p->count;
 
+#if (CONFIG_OBD_USE_LOOKUP_TABLE != FALSE)
+    if (subIndex_p < nSubIndexCount)
+    {
+        const tObdLookupEntry*  pLookupEntry;
+
+        pLookupEntry = getLookupEntry(pObdEntry_p->index);
+        if ((pLookupEntry != NULL) && (pLookupEntry->pObdEntry == pObdEntry_p))
+        {
+            // sub-index tables without gaps can be addressed directly
+            if (pLookupEntry->fDirectSubIndex)
+            {
+                *ppObdSubEntry_p = &pSubEntry[subIndex_p];
+                return kErrorOk;
+            }
+
+            // array elements are taken from the private sub-index entries of the lookup table
+            if (pLookupEntry->paArraySubEntry != NULL)
+            {
+                if (subIndex_p == 0)
+                    *ppObdSubEntry_p = &pSubEntry[0];
+                else
+                    *ppObdSubEntry_p = &pLookupEntry->paArraySubEntry[subIndex_p - 1];
+                return kErrorOk;
+            }
+        }
+    }
+#endif
+
     // search sub-index in sub-index table
     while (nSubIndexCount > 0)
     {
@@ -2584,6 +2718,9 @@ static tOplkError getSubindex(const tObdEntry* pObdEntry_p,
                 *ppObdSubEntry_p = pSubEntry;
                 return kErrorOk;
             }
+
+            // the array entry is the last entry of the sub-index table
+            break;
         }
         else if (subIndex_p == pSubEntry->subIndex)
         {
@@ -2604,6 +2741,207 @@ static tOplkError getSubindex(const tObdEntry* pObdEntry_p,
     return kErrorObdSubindexNotExist;
 }
 
+#if (CONFIG_OBD_USE_LOOKUP_TABLE != FALSE)
+//------------------------------------------------------------------------------
+/**
+\brief  Build the OD lookup table
+
+The function builds the lookup table which maps every index of the OD to its
+OD entry. An existing lookup table is freed before.
+
+\param[in]      pInitParam_p        Pointer to the OD initialization parameters.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError buildLookupTable(const tObdInitParam* pInitParam_p)
+{
+    tOplkError  ret;
+
+    freeLookupTable();
+
+    ret = addPartitionToLookupTable(pInitParam_p, pInitParam_p->pGenericPart);
+    if (ret == kErrorOk)
+        ret = addPartitionToLookupTable(pInitParam_p, pInitParam_p->pManufacturerPart);
+
+    if (ret == kErrorOk)
+        ret = addPartitionToLookupTable(pInitParam_p, pInitParam_p->pDevicePart);
+
+#if (defined(OBD_USER_OD) && (OBD_USER_OD != FALSE))
+    if ((ret == kErrorOk) && (pInitParam_p->pUserPart != NULL))
+        ret = addPartitionToLookupTable(pInitParam_p, pInitParam_p->pUserPart);
+#endif
+
+    if (ret != kErrorOk)
+        freeLookupTable();
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Add an OD partition to the lookup table
+
+The function adds all entries of an OD partition to the lookup table. An entry
+is only added if a search of its index in the OD returns this entry. Therefore,
+the lookup table returns exactly the same entries as the search.
+
+\param[in]      pInitParam_p        Pointer to the OD initialization parameters.
+\param[in]      pObdEntry_p         Pointer to the first entry of the OD partition.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError addPartitionToLookupTable(const tObdInitParam* pInitParam_p,
+                                            const tObdEntry* pObdEntry_p)
+{
+    tOplkError          ret;
+    const tObdEntry*    pFoundEntry;
+
+    while (pObdEntry_p->index != OBD_TABLE_INDEX_END)
+    {
+        if ((searchOdIndex(pInitParam_p, pObdEntry_p->index, &pFoundEntry) == kErrorOk) &&
+            (pFoundEntry == pObdEntry_p))
+        {
+            ret = addLookupEntry(pObdEntry_p);
+            if (ret != kErrorOk)
+                return ret;
+        }
+
+        pObdEntry_p++;
+    }
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Add an OD entry to the lookup table
+
+The function adds an OD entry to the lookup table. The page of the index is
+allocated if necessary. If all sub-indices of the entry are located at the
+position of their sub-index number, the entry is marked for direct sub-index
+addressing. For array objects consisting of sub-index 0 and the array
+sub-index entry, a sub-index entry is created for every array element.
+
+\param[in]      pObdEntry_p         Pointer to the OD entry.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError addLookupEntry(const tObdEntry* pObdEntry_p)
+{
+    tObdLookupPage*     pPage;
+    tObdLookupEntry*    pLookupEntry;
+    const tObdSubEntry* pSubEntry;
+    UINT                pageIndex;
+    UINT                subIndex;
+
+    pageIndex = pObdEntry_p->index >> OBD_LOOKUP_PAGE_SHIFT;
+    pPage = obdInstance_l.apLookupPage[pageIndex];
+    if (pPage == NULL)
+    {
+        pPage = (tObdLookupPage*)OPLK_MALLOC(sizeof(tObdLookupPage));
+        if (pPage == NULL)
+            return kErrorNoResource;
+
+        OPLK_MEMSET(pPage, 0, sizeof(tObdLookupPage));
+        obdInstance_l.apLookupPage[pageIndex] = pPage;
+    }
+
+    pLookupEntry = &pPage->aEntry[pObdEntry_p->index & (OBD_LOOKUP_PAGE_SIZE - 1)];
+    pLookupEntry->pObdEntry = pObdEntry_p;
+    pLookupEntry->fDirectSubIndex = TRUE;
+    pLookupEntry->paArraySubEntry = NULL;
+
+    pSubEntry = pObdEntry_p->pSubIndex;
+    for (subIndex = 0; subIndex < pObdEntry_p->count; subIndex++, pSubEntry++)
+    {
+        if ((pSubEntry->access & kObdAccArray) != 0)
+        {
+            pLookupEntry->fDirectSubIndex = FALSE;
+
+            // only the standard array layout is supported, other objects are searched
+            if ((subIndex != 1) || (pObdEntry_p->pSubIndex->subIndex != 0))
+                break;
+
+            pLookupEntry->paArraySubEntry = (tObdSubEntry*)OPLK_MALLOC((pObdEntry_p->count - 1) *
+                                                                       sizeof(tObdSubEntry));
+            if (pLookupEntry->paArraySubEntry == NULL)
+                return kErrorNoResource;
+
+            for (subIndex = 1; subIndex < pObdEntry_p->count; subIndex++)
+            {
+                pLookupEntry->paArraySubEntry[subIndex - 1] = *pSubEntry;
+                pLookupEntry->paArraySubEntry[subIndex - 1].subIndex = subIndex;
+            }
+            break;
+        }
+
+        if (pSubEntry->subIndex != subIndex)
+            pLookupEntry->fDirectSubIndex = FALSE;
+    }
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Free the OD lookup table
+
+The function frees all pages and array sub-index entries of the lookup table.
+*/
+//------------------------------------------------------------------------------
+static void freeLookupTable(void)
+{
+    tObdLookupPage* pPage;
+    UINT            pageIndex;
+    UINT            entryIndex;
+
+    for (pageIndex = 0; pageIndex < OBD_LOOKUP_PAGE_COUNT; pageIndex++)
+    {
+        pPage = obdInstance_l.apLookupPage[pageIndex];
+        if (pPage == NULL)
+            continue;
+
+        for (entryIndex = 0; entryIndex < OBD_LOOKUP_PAGE_SIZE; entryIndex++)
+        {
+            if (pPage->aEntry[entryIndex].paArraySubEntry != NULL)
+                OPLK_FREE(pPage->aEntry[entryIndex].paArraySubEntry);
+        }
+
+        OPLK_FREE(pPage);
+        obdInstance_l.apLookupPage[pageIndex] = NULL;
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get the lookup table entry of an index
+
+The function returns the lookup table entry of an index.
+
+\param[in]      index_p             Index to get.
+
+\return The function returns the pointer to the lookup entry or NULL if the
+        page of the index is not allocated.
+*/
+//------------------------------------------------------------------------------
+static const tObdLookupEntry* getLookupEntry(UINT index_p)
+{
+    const tObdLookupPage*   pPage;
+
+    if (index_p > 0xFFFF)
+        return NULL;
+
+    pPage = obdInstance_l.apLookupPage[index_p >> OBD_LOOKUP_PAGE_SHIFT];
+    if (pPage == NULL)
+        return NULL;
+
+    return &pPage->aEntry[index_p & (OBD_LOOKUP_PAGE_SIZE - 1)];
+}
+#endif
+
 //------------------------------------------------------------------------------
 /**
 \brief  Execute a job in an OD partition
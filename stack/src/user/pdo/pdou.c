@@ -118,6 +118,9 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
                 pPdoMappObject_p->byteSizeOrType = obdType_p; \
             }
 
+#if (CONFIG_PDO_USE_COMPILED_MAPPING != FALSE)
+#define PDOU_COPYOP_MAX_SIZE            USHRT_MAX
+#endif
 
 //------------------------------------------------------------------------------
 // local types
@@ -134,6 +137,42 @@ typedef struct
     UINT16                  byteSizeOrType;         ///< The size of the data in bytes
 } tPdoMappObject;
 
+#if (CONFIG_PDO_USE_COMPILED_MAPPING != FALSE)
+/**
+\brief PDO copy operation type
+
+This enumeration lists the types of the operations in a compiled PDO mapping.
+*/
+typedef enum
+{
+    kPdoCopyOpMemcpy = 0,                               ///< Plain memory copy without conversion
+    kPdoCopyOpConvert,                                  ///< Copy of a single object with byte order conversion
+} ePdoCopyOpType;
+
+/**
+\brief PDO copy operation type data type
+
+Data type for the enumerator \ref ePdoCopyOpType.
+*/
+typedef UINT8 tPdoCopyOpType;
+
+/**
+\brief PDO copy operation
+
+This structure describes a single operation of a compiled PDO mapping. A memcpy
+operation may cover several mapped objects which are adjacent in the PDO as
+well as in the object dictionary.
+*/
+typedef struct
+{
+    void*                   pVar;                   ///< Pointer to the first variable
+    const tPdoMappObject*   pMappObject;            ///< Mapping object (only for conversion operations)
+    UINT16                  pdoOffset;              ///< Offset in the PDO buffer of the channel
+    UINT16                  size;                   ///< Number of bytes to copy
+    tPdoCopyOpType          type;                   ///< Type of the copy operation
+} tPdoCopyOp;
+#endif
+
 /**
 \brief User PDO module instance
 
@@ -146,6 +185,15 @@ typedef struct
     tPdoChannelSetup        pdoChannels;                ///< PDO channel setup
     tPdoMappObject*         paRxObject;                 ///< Pointer to RX channel objects
     tPdoMappObject*         paTxObject;                 ///< Pointer to TX channel objects
+#if (CONFIG_PDO_USE_COMPILED_MAPPING != FALSE)
+    tPdoCopyOp*             paRxCopyOp;                 ///< Pointer to compiled RX channel copy operations
+    tPdoCopyOp*             paTxCopyOp;                 ///< Pointer to compiled TX channel copy operations
+    UINT16*                 paRxCopyOpCount;            ///< Number of copy operations per RX channel
+    UINT16*                 paTxCopyOpCount;            ///< Number of copy operations per TX channel
+    BOOL                    fRxZeroCopyChecked;         ///< Flag determines if the RX zero-copy layout check is up to date
+    BOOL                    fRxZeroCopyPossible;        ///< Flag determines if the RX PDO layout matches the output process image
+    UINT8                   rxZeroCopyChannelId;        ///< RX channel used for the zero-copy output process image
+#endif
     BOOL                    fAllocated;                 ///< Flag determines if PDOs are allocated
     BOOL                    fRunning;                   ///< Flag determines if PDO engine is running
     BOOL                    fInitialized;               ///< Flag determines if PDO module is initialized
@@ -215,6 +263,24 @@ static tOplkError copyVarToPdo(void* pPayload_p,
 static tOplkError copyVarFromPdo(const void* pPayload_p,
                                  const tPdoMappObject* pMappObject_p,
                                  UINT16 offsetInFrame_p);
+#if (CONFIG_PDO_USE_COMPILED_MAPPING != FALSE)
+static void compileCopyOps(const tPdoChannel* pPdoChannel_p,
+                           const tPdoMappObject* pMappObject_p,
+                           tPdoCopyOp* pCopyOp_p,
+                           UINT16* pCopyOpCount_p);
+static UINT16 getPlainCopySize(const tPdoMappObject* pMappObject_p);
+static tOplkError executeRxCopyOps(const void* pPdo_p,
+                                   const tPdoCopyOp* pCopyOp_p,
+                                   UINT copyOpCount_p,
+                                   UINT16 offsetInFrame_p);
+static tOplkError executeTxCopyOps(void* pPdo_p,
+                                   const tPdoCopyOp* pCopyOp_p,
+                                   UINT copyOpCount_p,
+                                   UINT16 offsetInFrame_p);
+static BOOL checkRxZeroCopyLayout(const void* pImage_p,
+                                  size_t imageSize_p,
+                                  UINT8* pChannelId_p);
+#endif
 
 //============================================================================//
 //            P U B L I C   F U N C T I O N S                                 //
@@ -480,9 +546,11 @@ The function copies RXPDOs into the process image
 tOplkError pdou_copyRxPdoToPi(void)
 {
     tOplkError              ret;
+#if (CONFIG_PDO_USE_COMPILED_MAPPING == FALSE)
     UINT                    mappObjectCount;
-    const tPdoChannel*      pPdoChannel;
     const tPdoMappObject*   pMappObject;
+#endif
+    const tPdoChannel*      pPdoChannel;
     UINT8                   channelId;
     void*                   pPdo;
 
@@ -519,6 +587,17 @@ tOplkError pdou_copyRxPdoToPi(void)
                             pPdoChannel->nodeId,
                             pPdo);
 
+#if (CONFIG_PDO_USE_COMPILED_MAPPING != FALSE)
+        ret = executeRxCopyOps(pPdo,
+                               pdouInstance_g.paRxCopyOp + (channelId * D_PDO_RPDOChannelObjects_U8),
+                               pdouInstance_g.paRxCopyOpCount[channelId],
+                               pPdoChannel->offset);
+        if (ret != kErrorOk)
+        {   // other fatal error occurred
+            target_unlockMutex(pdouInstance_g.lockMutex);
+            return ret;
+        }
+#else
         for (mappObjectCount = pPdoChannel->mappObjectCount,
              pMappObject = pdouInstance_g.paRxObject + (channelId * D_PDO_RPDOChannelObjects_U8);
              mappObjectCount > 0;
@@ -531,6 +610,7 @@ tOplkError pdou_copyRxPdoToPi(void)
                 return ret;
             }
         }
+#endif
     }
 
     target_unlockMutex(pdouInstance_g.lockMutex);
@@ -553,9 +633,11 @@ The function copies the TXPDOs from the process image into the PDO buffers.
 tOplkError pdou_copyTxPdoFromPi(void)
 {
     tOplkError              ret = kErrorOk;
+#if (CONFIG_PDO_USE_COMPILED_MAPPING == FALSE)
     UINT                    mappObjectCount;
-    const tPdoChannel*      pPdoChannel;
     const tPdoMappObject*   pMappObject;
+#endif
+    const tPdoChannel*      pPdoChannel;
     UINT8                   channelId;
     void*                   pPdo;
 
@@ -587,6 +669,17 @@ tOplkError pdou_copyTxPdoFromPi(void)
                             channelId,
                             pPdo);
 
+#if (CONFIG_PDO_USE_COMPILED_MAPPING != FALSE)
+        ret = executeTxCopyOps(pPdo,
+                               pdouInstance_g.paTxCopyOp + (channelId * D_PDO_TPDOChannelObjects_U8),
+                               pdouInstance_g.paTxCopyOpCount[channelId],
+                               pPdoChannel->offset);
+        if (ret != kErrorOk)
+        {   // other fatal error occurred
+            target_unlockMutex(pdouInstance_g.lockMutex);
+            return ret;
+        }
+#else
         for (mappObjectCount = pPdoChannel->mappObjectCount,
              pMappObject = pdouInstance_g.paTxObject + (channelId * D_PDO_TPDOChannelObjects_U8);
              mappObjectCount > 0;
@@ -599,6 +692,7 @@ tOplkError pdou_copyTxPdoFromPi(void)
                 return ret;
             }
         }
+#endif
 
         // send PDO data to kernel layer
         ret = pdoucal_setTxPdo(channelId,
@@ -611,6 +705,82 @@ tOplkError pdou_copyTxPdoFromPi(void)
     return ret;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Get RXPDO buffer as output process image
+
+The function provides direct access to the RXPDO buffer instead of copying the
+RXPDOs into the process image. This is only possible if a single RPDO channel
+is active and its objects are linked to the output process image with exactly
+the layout of the PDO. The function releases the previously returned buffer
+and returns the buffer containing the newest RXPDO data. The buffer stays valid
+until the next call of this function.
+
+\param[in]      pImage_p            Pointer to the output process image the
+                                    mapped objects are linked to.
+\param[in]      imageSize_p         Size of the output process image.
+\param[out]     ppPdo_p             Pointer to store the address of the RXPDO
+                                    buffer. It is set to NULL if the PDOs are
+                                    not running.
+
+\return The function returns a tOplkError error code.
+\retval kErrorOk                    The RXPDO buffer is returned successfully.
+\retval kErrorApiNotSupported       The PDO layout does not allow direct access.
+
+\ingroup module_pdou
+*/
+//------------------------------------------------------------------------------
+tOplkError pdou_getRxPdoImage(const void* pImage_p,
+                              size_t imageSize_p,
+                              void** ppPdo_p)
+{
+#if (CONFIG_PDO_USE_COMPILED_MAPPING != FALSE)
+    tOplkError          ret;
+    const tPdoChannel*  pPdoChannel;
+
+    *ppPdo_p = NULL;
+
+    if (target_lockMutex(pdouInstance_g.lockMutex) != kErrorOk)
+        return kErrorIllegalInstance;
+
+    if (!pdouInstance_g.fRunning)
+    {
+        target_unlockMutex(pdouInstance_g.lockMutex);
+        return kErrorOk;
+    }
+
+    if (!pdouInstance_g.fRxZeroCopyChecked)
+    {
+        pdouInstance_g.fRxZeroCopyPossible = checkRxZeroCopyLayout(pImage_p,
+                                                                   imageSize_p,
+                                                                   &pdouInstance_g.rxZeroCopyChannelId);
+        pdouInstance_g.fRxZeroCopyChecked = TRUE;
+    }
+
+    if (!pdouInstance_g.fRxZeroCopyPossible)
+    {
+        target_unlockMutex(pdouInstance_g.lockMutex);
+        return kErrorApiNotSupported;
+    }
+
+    pPdoChannel = &pdouInstance_g.pdoChannels.pRxPdoChannel[pdouInstance_g.rxZeroCopyChannelId];
+    ret = pdoucal_getRxPdo(ppPdo_p,
+                           pdouInstance_g.rxZeroCopyChannelId,
+                           pPdoChannel->nextChannelOffset - pPdoChannel->offset);
+
+    target_unlockMutex(pdouInstance_g.lockMutex);
+
+    return ret;
+#else
+    UNUSED_PARAMETER(pImage_p);
+    UNUSED_PARAMETER(imageSize_p);
+
+    *ppPdo_p = NULL;
+
+    return kErrorApiNotSupported;
+#endif
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  Register PDO change callback function
@@ -862,6 +1032,20 @@ static tOplkError allocatePdoChannels(const tPdoAllocationParam* pAllocationPara
             pdouInstance_g.paRxObject = NULL;
         }
 
+#if (CONFIG_PDO_USE_COMPILED_MAPPING != FALSE)
+        if (pdouInstance_g.paRxCopyOp != NULL)
+        {
+            OPLK_FREE(pdouInstance_g.paRxCopyOp);
+            pdouInstance_g.paRxCopyOp = NULL;
+        }
+
+        if (pdouInstance_g.paRxCopyOpCount != NULL)
+        {
+            OPLK_FREE(pdouInstance_g.paRxCopyOpCount);
+            pdouInstance_g.paRxCopyOpCount = NULL;
+        }
+#endif
+
         if (pAllocationParam_p->rxPdoChannelCount > 0)
         {
             pdouInstance_g.pdoChannels.pRxPdoChannel =
@@ -883,6 +1067,26 @@ static tOplkError allocatePdoChannels(const tPdoAllocationParam* pAllocationPara
                 ret = kErrorPdoInitError;
                 goto Exit;
             }
+
+#if (CONFIG_PDO_USE_COMPILED_MAPPING != FALSE)
+            pdouInstance_g.paRxCopyOp =
+                    (tPdoCopyOp*)OPLK_MALLOC(sizeof(tPdoCopyOp)
+                               * pAllocationParam_p->rxPdoChannelCount
+                               * D_PDO_RPDOChannelObjects_U8);
+            if (pdouInstance_g.paRxCopyOp == NULL)
+            {
+                ret = kErrorPdoInitError;
+                goto Exit;
+            }
+
+            pdouInstance_g.paRxCopyOpCount =
+                    (UINT16*)OPLK_MALLOC(sizeof(UINT16) * pAllocationParam_p->rxPdoChannelCount);
+            if (pdouInstance_g.paRxCopyOpCount == NULL)
+            {
+                ret = kErrorPdoInitError;
+                goto Exit;
+            }
+#endif
         }
     }
 
@@ -890,8 +1094,15 @@ static tOplkError allocatePdoChannels(const tPdoAllocationParam* pAllocationPara
     for (index = 0; index < pAllocationParam_p->rxPdoChannelCount; index++)
     {
         pdouInstance_g.pdoChannels.pRxPdoChannel[index].nodeId = PDO_INVALID_NODE_ID;
+#if (CONFIG_PDO_USE_COMPILED_MAPPING != FALSE)
+        pdouInstance_g.paRxCopyOpCount[index] = 0;
+#endif
     }
 
+#if (CONFIG_PDO_USE_COMPILED_MAPPING != FALSE)
+    pdouInstance_g.fRxZeroCopyChecked = FALSE;
+#endif
+
     //--------------------------------------------------------------------------
     if (pdouInstance_g.pdoChannels.allocation.txPdoChannelCount != pAllocationParam_p->txPdoChannelCount)
     {   // allocation should be changedconfigureChannel
@@ -908,6 +1119,20 @@ static tOplkError allocatePdoChannels(const tPdoAllocationParam* pAllocationPara
             pdouInstance_g.paTxObject = NULL;
         }
 
+#if (CONFIG_PDO_USE_COMPILED_MAPPING != FALSE)
+        if (pdouInstance_g.paTxCopyOp != NULL)
+        {
+            OPLK_FREE(pdouInstance_g.paTxCopyOp);
+            pdouInstance_g.paTxCopyOp = NULL;
+        }
+
+        if (pdouInstance_g.paTxCopyOpCount != NULL)
+        {
+            OPLK_FREE(pdouInstance_g.paTxCopyOpCount);
+            pdouInstance_g.paTxCopyOpCount = NULL;
+        }
+#endif
+
         if (pAllocationParam_p->txPdoChannelCount > 0)
         {
             pdouInstance_g.pdoChannels.pTxPdoChannel =
@@ -927,6 +1152,26 @@ static tOplkError allocatePdoChannels(const tPdoAllocationParam* pAllocationPara
                 ret = kErrorPdoInitError;
                 goto Exit;
             }
+
+#if (CONFIG_PDO_USE_COMPILED_MAPPING != FALSE)
+            pdouInstance_g.paTxCopyOp =
+                    (tPdoCopyOp*)OPLK_MALLOC(sizeof(tPdoCopyOp)
+                               * pAllocationParam_p->txPdoChannelCount
+                               * D_PDO_TPDOChannelObjects_U8);
+            if (pdouInstance_g.paTxCopyOp == NULL)
+            {
+                ret = kErrorPdoInitError;
+                goto Exit;
+            }
+
+            pdouInstance_g.paTxCopyOpCount =
+                    (UINT16*)OPLK_MALLOC(sizeof(UINT16) * pAllocationParam_p->txPdoChannelCount);
+            if (pdouInstance_g.paTxCopyOpCount == NULL)
+            {
+                ret = kErrorPdoInitError;
+                goto Exit;
+            }
+#endif
         }
     }
 
@@ -934,6 +1179,9 @@ static tOplkError allocatePdoChannels(const tPdoAllocationParam* pAllocationPara
     for (index = 0; index < pAllocationParam_p->txPdoChannelCount; index++)
     {
         pdouInstance_g.pdoChannels.pTxPdoChannel[index].nodeId = PDO_INVALID_NODE_ID;
+#if (CONFIG_PDO_USE_COMPILED_MAPPING != FALSE)
+        pdouInstance_g.paTxCopyOpCount[index] = 0;
+#endif
     }
 
 Exit:
@@ -966,6 +1214,20 @@ static tOplkError freePdoChannels(void)
         pdouInstance_g.paRxObject = NULL;
     }
 
+#if (CONFIG_PDO_USE_COMPILED_MAPPING != FALSE)
+    if (pdouInstance_g.paRxCopyOp != NULL)
+    {
+        OPLK_FREE(pdouInstance_g.paRxCopyOp);
+        pdouInstance_g.paRxCopyOp = NULL;
+    }
+
+    if (pdouInstance_g.paRxCopyOpCount != NULL)
+    {
+        OPLK_FREE(pdouInstance_g.paRxCopyOpCount);
+        pdouInstance_g.paRxCopyOpCount = NULL;
+    }
+#endif
+
     if (pdouInstance_g.pdoChannels.pTxPdoChannel != NULL)
     {
         OPLK_FREE(pdouInstance_g.pdoChannels.pTxPdoChannel);
@@ -978,6 +1240,20 @@ static tOplkError freePdoChannels(void)
         pdouInstance_g.paTxObject = NULL;
     }
 
+#if (CONFIG_PDO_USE_COMPILED_MAPPING != FALSE)
+    if (pdouInstance_g.paTxCopyOp != NULL)
+    {
+        OPLK_FREE(pdouInstance_g.paTxCopyOp);
+        pdouInstance_g.paTxCopyOp = NULL;
+    }
+
+    if (pdouInstance_g.paTxCopyOpCount != NULL)
+    {
+        OPLK_FREE(pdouInstance_g.paTxCopyOpCount);
+        pdouInstance_g.paTxCopyOpCount = NULL;
+    }
+#endif
+
     return ret;
 }
 
@@ -1282,6 +1558,27 @@ static tOplkError configurePdoChannel(const tPdoChannelConf* pChannelConf_p)
         // Setup user channel configuration
         OPLK_MEMCPY(pDestPdoChannel, &pChannelConf_p->pdoChannel, sizeof(tPdoChannel));
 
+#if (CONFIG_PDO_USE_COMPILED_MAPPING != FALSE)
+        if (!pChannelConf_p->fTx)
+            pdouInstance_g.fRxZeroCopyChecked = FALSE;
+
+        // Lower the mapping of the channel to its list of copy operations
+        if (pChannelConf_p->fTx)
+        {
+            compileCopyOps(pDestPdoChannel,
+                           &pdouInstance_g.paTxObject[pChannelConf_p->channelId * D_PDO_TPDOChannelObjects_U8],
+                           &pdouInstance_g.paTxCopyOp[pChannelConf_p->channelId * D_PDO_TPDOChannelObjects_U8],
+                           &pdouInstance_g.paTxCopyOpCount[pChannelConf_p->channelId]);
+        }
+        else
+        {
+            compileCopyOps(pDestPdoChannel,
+                           &pdouInstance_g.paRxObject[pChannelConf_p->channelId * D_PDO_RPDOChannelObjects_U8],
+                           &pdouInstance_g.paRxCopyOp[pChannelConf_p->channelId * D_PDO_RPDOChannelObjects_U8],
+                           &pdouInstance_g.paRxCopyOpCount[pChannelConf_p->channelId]);
+        }
+#endif
+
         DEBUG_LVL_PDO_TRACE("%s(): pdoucal_postConfigureChannel(): TX:%d channel:%d offset:%d\n",
                             __func__,
                             pChannelConf_p->fTx,
@@ -1947,6 +2244,283 @@ static tOplkError copyVarFromPdo(const void* pPayload_p,
     return ret;
 }
 
+#if (CONFIG_PDO_USE_COMPILED_MAPPING != FALSE)
+//------------------------------------------------------------------------------
+/**
+\brief  Compile the copy operations of a PDO channel
+
+The function lowers the mapping objects of a PDO channel to a flat list of
+copy operations. Objects which can be copied without conversion are merged into
+a single memcpy operation if they are adjacent in the PDO as well as in memory.
+Objects which need a byte order conversion on this host remain single
+conversion operations.
+
+\param[in]      pPdoChannel_p       Pointer to the PDO channel.
+\param[in]      pMappObject_p       Pointer to the first mapping object of the channel.
+\param[out]     pCopyOp_p           Pointer to store the copy operations.
+\param[out]     pCopyOpCount_p      Pointer to store the number of copy operations.
+**/
+//------------------------------------------------------------------------------
+static void compileCopyOps(const tPdoChannel* pPdoChannel_p,
+                           const tPdoMappObject* pMappObject_p,
+                           tPdoCopyOp* pCopyOp_p,
+                           UINT16* pCopyOpCount_p)
+{
+    UINT        mappObjectCount;
+    UINT16      copyOpCount = 0;
+    tPdoCopyOp* pLastCopyOp = NULL;
+    UINT16      pdoOffset;
+    UINT16      size;
+
+    if (pPdoChannel_p->nodeId == PDO_INVALID_NODE_ID)
+    {
+        *pCopyOpCount_p = 0;
+        return;
+    }
+
+    for (mappObjectCount = pPdoChannel_p->mappObjectCount;
+         mappObjectCount > 0;
+         mappObjectCount--, pMappObject_p++)
+    {
+        pdoOffset = (UINT16)((PDO_MAPPOBJECT_GET_BITOFFSET(pMappObject_p) >> 3) - pPdoChannel_p->offset);
+        size = getPlainCopySize(pMappObject_p);
+
+        if ((size != 0) &&
+            (pLastCopyOp != NULL) &&
+            (pLastCopyOp->type == kPdoCopyOpMemcpy) &&
+            ((UINT)(pLastCopyOp->pdoOffset + pLastCopyOp->size) == pdoOffset) &&
+            (((UINT8*)pLastCopyOp->pVar + pLastCopyOp->size) == (UINT8*)PDO_MAPPOBJECT_GET_VAR(pMappObject_p)) &&
+            (((UINT)pLastCopyOp->size + size) <= PDOU_COPYOP_MAX_SIZE))
+        {   // object continues the previous run
+            pLastCopyOp->size += size;
+            continue;
+        }
+
+        pLastCopyOp = &pCopyOp_p[copyOpCount];
+        pLastCopyOp->pVar = PDO_MAPPOBJECT_GET_VAR(pMappObject_p);
+        pLastCopyOp->pMappObject = pMappObject_p;
+        pLastCopyOp->pdoOffset = pdoOffset;
+        pLastCopyOp->size = size;
+        pLastCopyOp->type = (size != 0) ? kPdoCopyOpMemcpy : kPdoCopyOpConvert;
+        copyOpCount++;
+    }
+
+    DEBUG_LVL_PDO_TRACE("%s() node:%d objects:%d copy operations:%d\n",
+                        __func__,
+                        pPdoChannel_p->nodeId,
+                        pPdoChannel_p->mappObjectCount,
+                        copyOpCount);
+
+    *pCopyOpCount_p = copyOpCount;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get the plain copy size of a mapping object
+
+The function determines whether the PDO representation of the mapped object is
+identical to its representation in memory. This is the case for strings and
+domains and for numerical objects of native size on little endian hosts.
+
+\param[in]      pMappObject_p       Pointer to mapping object.
+
+\return The function returns the number of bytes which can be copied by memcpy
+        or 0 if the object needs a conversion.
+**/
+//------------------------------------------------------------------------------
+static UINT16 getPlainCopySize(const tPdoMappObject* pMappObject_p)
+{
+    switch (PDO_MAPPOBJECT_GET_TYPE(pMappObject_p))
+    {
+        // 8 bit values
+        case kObdTypeBool:
+        case kObdTypeInt8:
+        case kObdTypeUInt8:
+            return 1;
+
+#if !CHECK_IF_BIG_ENDIAN()
+        // 16 bit values
+        case kObdTypeInt16:
+        case kObdTypeUInt16:
+            return 2;
+
+        // 32 bit values
+        case kObdTypeInt32:
+        case kObdTypeUInt32:
+        case kObdTypeReal32:
+            return 4;
+
+        // 64 bit values
+        case kObdTypeInt64:
+        case kObdTypeUInt64:
+        case kObdTypeReal64:
+            return 8;
+#else
+        case kObdTypeInt16:
+        case kObdTypeUInt16:
+        case kObdTypeInt32:
+        case kObdTypeUInt32:
+        case kObdTypeReal32:
+        case kObdTypeInt64:
+        case kObdTypeUInt64:
+        case kObdTypeReal64:
+#endif
+        // values without native size and time of day
+        case kObdTypeInt24:
+        case kObdTypeUInt24:
+        case kObdTypeInt40:
+        case kObdTypeUInt40:
+        case kObdTypeInt48:
+        case kObdTypeUInt48:
+        case kObdTypeInt56:
+        case kObdTypeUInt56:
+        case kObdTypeTimeOfDay:
+        case kObdTypeTimeDiff:
+            return 0;
+
+        // types without ami
+        case kObdTypeVString:
+        case kObdTypeOString:
+        case kObdTypeDomain:
+        default:
+            return (UINT16)PDO_MAPPOBJECT_GET_BYTESIZE(pMappObject_p);
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Execute the compiled copy operations of an RPDO channel
+
+\param[in]      pPdo_p              Pointer to PDO buffer of the channel.
+\param[in]      pCopyOp_p           Pointer to the copy operations.
+\param[in]      copyOpCount_p       Number of copy operations.
+\param[in]      offsetInFrame_p     Offset of the PDO data in the frame.
+
+\return The function returns a tOplkError error code.
+**/
+//------------------------------------------------------------------------------
+static tOplkError executeRxCopyOps(const void* pPdo_p,
+                                   const tPdoCopyOp* pCopyOp_p,
+                                   UINT copyOpCount_p,
+                                   UINT16 offsetInFrame_p)
+{
+    tOplkError  ret = kErrorOk;
+
+    for (; copyOpCount_p > 0; copyOpCount_p--, pCopyOp_p++)
+    {
+        if (pCopyOp_p->type == kPdoCopyOpMemcpy)
+        {
+            OPLK_MEMCPY(pCopyOp_p->pVar,
+                        (const UINT8*)pPdo_p + pCopyOp_p->pdoOffset,
+                        pCopyOp_p->size);
+        }
+        else
+        {
+            ret = copyVarFromPdo(pPdo_p, pCopyOp_p->pMappObject, offsetInFrame_p);
+            if (ret != kErrorOk)
+                break;
+        }
+    }
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Execute the compiled copy operations of a TPDO channel
+
+\param[out]     pPdo_p              Pointer to PDO buffer of the channel.
+\param[in]      pCopyOp_p           Pointer to the copy operations.
+\param[in]      copyOpCount_p       Number of copy operations.
+\param[in]      offsetInFrame_p     Offset of the PDO data in the frame.
+
+\return The function returns a tOplkError error code.
+**/
+//------------------------------------------------------------------------------
+static tOplkError executeTxCopyOps(void* pPdo_p,
+                                   const tPdoCopyOp* pCopyOp_p,
+                                   UINT copyOpCount_p,
+                                   UINT16 offsetInFrame_p)
+{
+    tOplkError  ret = kErrorOk;
+
+    for (; copyOpCount_p > 0; copyOpCount_p--, pCopyOp_p++)
+    {
+        if (pCopyOp_p->type == kPdoCopyOpMemcpy)
+        {
+            OPLK_MEMCPY((UINT8*)pPdo_p + pCopyOp_p->pdoOffset,
+                        pCopyOp_p->pVar,
+                        pCopyOp_p->size);
+        }
+        else
+        {
+            ret = copyVarToPdo(pPdo_p, pCopyOp_p->pMappObject, offsetInFrame_p);
+            if (ret != kErrorOk)
+                break;
+        }
+    }
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Check if RXPDOs can be accessed directly as output process image
+
+The function checks whether exactly one RPDO channel is active and all its
+copy operations are plain copies into the given process image at the PDO
+offset of the respective object. In this case the RXPDO buffer of the channel
+has the same layout as the output process image.
+
+\param[in]      pImage_p            Pointer to the output process image.
+\param[in]      imageSize_p         Size of the output process image.
+\param[out]     pChannelId_p        Pointer to store the ID of the channel.
+
+\return The function returns TRUE if the RXPDO buffer can be used directly.
+**/
+//------------------------------------------------------------------------------
+static BOOL checkRxZeroCopyLayout(const void* pImage_p,
+                                  size_t imageSize_p,
+                                  UINT8* pChannelId_p)
+{
+    UINT                channelId;
+    UINT                activeChannelCount = 0;
+    const tPdoChannel*  pPdoChannel;
+    const tPdoCopyOp*   pCopyOp;
+    UINT                copyOpCount;
+
+    for (channelId = 0;
+         channelId < pdouInstance_g.pdoChannels.allocation.rxPdoChannelCount;
+         channelId++)
+    {
+        if (pdouInstance_g.pdoChannels.pRxPdoChannel[channelId].nodeId == PDO_INVALID_NODE_ID)
+            continue;
+
+        activeChannelCount++;
+        *pChannelId_p = (UINT8)channelId;
+    }
+
+    if (activeChannelCount != 1)
+        return FALSE;
+
+    pPdoChannel = &pdouInstance_g.pdoChannels.pRxPdoChannel[*pChannelId_p];
+    if (imageSize_p > (size_t)(pPdoChannel->nextChannelOffset - pPdoChannel->offset))
+        return FALSE;
+
+    for (copyOpCount = pdouInstance_g.paRxCopyOpCount[*pChannelId_p],
+         pCopyOp = &pdouInstance_g.paRxCopyOp[*pChannelId_p * D_PDO_RPDOChannelObjects_U8];
+         copyOpCount > 0;
+         copyOpCount--, pCopyOp++)
+    {
+        if ((pCopyOp->type != kPdoCopyOpMemcpy) ||
+            ((const UINT8*)pCopyOp->pVar != ((const UINT8*)pImage_p + pCopyOp->pdoOffset)))
+            return FALSE;
+    }
+
+    return TRUE;
+}
+#endif
+
 //------------------------------------------------------------------------------
 /**
 \brief  Calculate PDO memory size
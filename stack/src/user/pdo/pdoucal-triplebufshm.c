@@ -265,7 +265,11 @@ tOplkError pdoucal_setTxPdo(UINT8 channelId_p,
 /**
 \brief  Read RXPDO from PDO memory
 
-The function reads an RXPDO from the PDO buffer.
+The function reads an RXPDO from the PDO buffer. All RXPDO channels of a frame
+share the buffer indices of their frame channel. New data of the frame is taken
+when the frame channel, i.e. the channel of the frame with the lowest ID, is
+read. The other channels of the frame are read from the same buffer, therefore
+the channels of a frame must be read in ascending order of their IDs.
 
 \param[out]     ppPdo_p             Pointer to store the RXPDO data address.
 \param[in]      channelId_p         Channel ID of PDO to read.
@@ -280,31 +284,33 @@ tOplkError pdoucal_getRxPdo(void** ppPdo_p,
                             UINT8 channelId_p,
                             size_t pdoSize_p)
 {
-    OPLK_ATOMIC_T    readBuf;
+    OPLK_ATOMIC_T       readBuf;
+    tPdoBufferInfo*     pFrameInfo;
 
     UNUSED_PARAMETER(pdoSize_p);    // Used to avoid compiler warning if OPLK_DCACHE_INVALIDATE is not set
 
     // Check parameter validity
     ASSERT(ppPdo_p != NULL);
 
-    // Invalidate data cache for addressed txChannelInfo
-    OPLK_DCACHE_INVALIDATE(&(pPdoMem_l->rxChannelInfo[channelId_p]),
-                           sizeof(tPdoBufferInfo));
+    pFrameInfo = &pPdoMem_l->rxChannelInfo[pPdoMem_l->rxChannelInfo[channelId_p].frameChannelId];
+
+    // Invalidate data cache for the buffer indices of the frame
+    OPLK_DCACHE_INVALIDATE(pFrameInfo, sizeof(tPdoBufferInfo));
 
-    if (pPdoMem_l->rxChannelInfo[channelId_p].newData)
+    if ((pPdoMem_l->rxChannelInfo[channelId_p].frameChannelId == channelId_p) &&
+        pFrameInfo->newData)
     {
-        readBuf = pPdoMem_l->rxChannelInfo[channelId_p].readBuf;
-        OPLK_ATOMIC_EXCHANGE(&pPdoMem_l->rxChannelInfo[channelId_p].cleanBuf,
+        readBuf = pFrameInfo->readBuf;
+        OPLK_ATOMIC_EXCHANGE(&pFrameInfo->cleanBuf,
                              readBuf,
-                             pPdoMem_l->rxChannelInfo[channelId_p].readBuf);
-        pPdoMem_l->rxChannelInfo[channelId_p].newData = 0;
+                             pFrameInfo->readBuf);
+        pFrameInfo->newData = 0;
 
         // Flush data cache for variables changed in this function
-        OPLK_DCACHE_FLUSH(&(pPdoMem_l->rxChannelInfo[channelId_p]),
-                          sizeof(tPdoBufferInfo));
+        OPLK_DCACHE_FLUSH(pFrameInfo, sizeof(tPdoBufferInfo));
     }
 
-    *ppPdo_p = (UINT8*)pTripleBuf_l[pPdoMem_l->rxChannelInfo[channelId_p].readBuf] +
+    *ppPdo_p = (UINT8*)pTripleBuf_l[pFrameInfo->readBuf] +
                 pPdoMem_l->rxChannelInfo[channelId_p].channelOffset;
 
     OPLK_DCACHE_INVALIDATE(*ppPdo_p, pdoSize_p);
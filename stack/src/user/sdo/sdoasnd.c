@@ -82,6 +82,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 typedef struct
 {
     UINT                aSdoAsndConnection[CONFIG_SDO_MAX_CONNECTION_ASND];
+    UINT16              aConIndex[C_ADR_BROADCAST];         ///< Last used connection index for each node ID (validated on use)
     tSequLayerReceiveCb pfnSdoAsySeqCb;
 } tSdoAsndInstance;
 
@@ -95,6 +96,7 @@ static tSdoAsndInstance  sdoAsndInstance_l;
 // local function prototypes
 //------------------------------------------------------------------------------
 static tOplkError sdoAsndCb(const tFrameInfo* pFrameInfo_p);
+static UINT       findConnection(UINT nodeId_p, UINT* pFreeCon_p);
 
 //============================================================================//
 //            P U B L I C   F U N C T I O N S                                 //
@@ -180,25 +182,13 @@ tOplkError sdoasnd_initCon(tSdoConHdl* pSdoConHandle_p, UINT targetNodeId_p)
         (targetNodeId_p >= C_ADR_BROADCAST))
         return kErrorSdoAsndInvalidNodeId;
 
-    // get free entry in control structure
-    count = 0;
-    freeCon = CONFIG_SDO_MAX_CONNECTION_ASND;
-    pConnection = &sdoAsndInstance_l.aSdoAsndConnection[0];
-    while (count < CONFIG_SDO_MAX_CONNECTION_ASND)
-    {
-        if (*pConnection == targetNodeId_p)
-        {   // existing connection to target node found
-            // save handle for higher layer
-            *pSdoConHandle_p = (tSdoConHdl)(count | SDO_ASND_HANDLE);
-            return ret;
-        }
-        else if (*pConnection == 0)
-        {   // free entry-> save target nodeId
-            freeCon = count;
-        }
-
-        count++;
-        pConnection++;
+    // get existing or free entry in control structure
+    count = findConnection(targetNodeId_p, &freeCon);
+    if (count < CONFIG_SDO_MAX_CONNECTION_ASND)
+    {   // existing connection to target node found
+        // save handle for higher layer
+        *pSdoConHandle_p = (tSdoConHdl)(count | SDO_ASND_HANDLE);
+        return ret;
     }
 
     if (freeCon == CONFIG_SDO_MAX_CONNECTION_ASND)
@@ -210,6 +200,7 @@ tOplkError sdoasnd_initCon(tSdoConHdl* pSdoConHandle_p, UINT targetNodeId_p)
     {
         pConnection = &sdoAsndInstance_l.aSdoAsndConnection[freeCon];
         *pConnection = targetNodeId_p;
+        sdoAsndInstance_l.aConIndex[targetNodeId_p] = (UINT16)freeCon;
         // save handle for higher layer
         *pSdoConHandle_p = (tSdoConHdl)(freeCon | SDO_ASND_HANDLE);
     }
@@ -313,7 +304,7 @@ static tOplkError sdoAsndCb(const tFrameInfo* pFrameInfo_p)
     UINT            count;
     UINT*           pConnection;
     UINT            nodeId;
-    UINT            freeEntry = 0xFFFF;
+    UINT            freeEntry;
     tSdoConHdl      sdoConHdl;
     tPlkFrame*      pFrame;
 
@@ -321,27 +312,14 @@ static tOplkError sdoAsndCb(const tFrameInfo* pFrameInfo_p)
     nodeId = ami_getUint8Le(&pFrame->srcNodeId);
 
     // search corresponding entry in control structure
-    count = 0;
-    pConnection = &sdoAsndInstance_l.aSdoAsndConnection[0];
-    while (count < CONFIG_SDO_MAX_CONNECTION_ASND)
-    {
-        if (nodeId == *pConnection)
-            break;
-        else if ((*pConnection == 0) && (freeEntry == 0xFFFF))
-        {   // free entry
-            freeEntry = count;
-        }
-
-        count++;
-        pConnection++;
-    }
-
+    count = findConnection(nodeId, &freeEntry);
     if (count == CONFIG_SDO_MAX_CONNECTION_ASND)
     {
-        if (freeEntry != 0xFFFF)
+        if (freeEntry != CONFIG_SDO_MAX_CONNECTION_ASND)
         {
             pConnection = &sdoAsndInstance_l.aSdoAsndConnection[freeEntry];
             *pConnection = nodeId;
+            sdoAsndInstance_l.aConIndex[nodeId] = (UINT16)freeEntry;
             count = freeEntry;
         }
         else
@@ -359,6 +337,54 @@ static tOplkError sdoAsndCb(const tFrameInfo* pFrameInfo_p)
     return ret;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Find connection to a node
+
+The function searches the connection to the specified node. The connection
+index which was last used for the node ID is checked first, so that the
+connection is found in constant time for every received frame. Only if the
+node has no valid connection, the table is searched for a free entry.
+
+\param[in]      nodeId_p            Node ID of the communication partner.
+\param[out]     pFreeCon_p          Pointer to store the index of the first free
+                                    connection. It is only valid if no connection
+                                    to the node exists.
+
+\return The function returns the index of the connection or
+        CONFIG_SDO_MAX_CONNECTION_ASND if no connection to the node exists.
+*/
+//------------------------------------------------------------------------------
+static UINT findConnection(UINT nodeId_p, UINT* pFreeCon_p)
+{
+    UINT    count;
+
+    *pFreeCon_p = CONFIG_SDO_MAX_CONNECTION_ASND;
+
+    if ((nodeId_p == C_ADR_INVALID) || (nodeId_p >= C_ADR_BROADCAST))
+        return CONFIG_SDO_MAX_CONNECTION_ASND;
+
+    count = sdoAsndInstance_l.aConIndex[nodeId_p];
+    if ((count < CONFIG_SDO_MAX_CONNECTION_ASND) &&
+        (sdoAsndInstance_l.aSdoAsndConnection[count] == nodeId_p))
+        return count;
+
+    for (count = 0; count < CONFIG_SDO_MAX_CONNECTION_ASND; count++)
+    {
+        if (sdoAsndInstance_l.aSdoAsndConnection[count] == nodeId_p)
+        {
+            sdoAsndInstance_l.aConIndex[nodeId_p] = (UINT16)count;
+            return count;
+        }
+
+        if ((sdoAsndInstance_l.aSdoAsndConnection[count] == 0) &&
+            (*pFreeCon_p == CONFIG_SDO_MAX_CONNECTION_ASND))
+            *pFreeCon_p = count;
+    }
+
+    return CONFIG_SDO_MAX_CONNECTION_ASND;
+}
+
 /// \}
 
 #endif
@@ -412,6 +412,16 @@ tOplkError sdocomint_processCmdLayerConnection(tSdoSeqConHdl sdoSeqConHdl_p,
     tSdoComCon*     pSdoComCon;
     tSdoComConHdl   hdlCount;
     tSdoComConHdl   hdlFree;
+    tSdoComConHdl*  pCachedHdl;
+
+    // check the command layer handle which was last used with this sequence
+    // layer handle first, so that frames of established connections are
+    // dispatched without searching the connection table
+    pCachedHdl = &sdoComInstance_g.aConHdlCache[((UINT)sdoSeqConHdl_p & ~SDO_SEQ_HANDLE_MASK) %
+                                                SDO_COM_CON_CACHE_SIZE];
+    if ((*pCachedHdl < CONFIG_SDO_MAX_CONNECTION_COM) &&
+        (sdoComInstance_g.sdoComCon[*pCachedHdl].sdoSeqConHdl == sdoSeqConHdl_p))
+        return sdocomint_processState(*pCachedHdl, sdoComConEvent_p, pSdoCom_p);
 
     // get pointer to first element of the array
     pSdoComCon = &sdoComInstance_g.sdoComCon[0];
@@ -421,6 +431,7 @@ tOplkError sdocomint_processCmdLayerConnection(tSdoSeqConHdl sdoSeqConHdl_p,
     {
         if (pSdoComCon->sdoSeqConHdl == sdoSeqConHdl_p)
         {   // matching command layer handle found
+            *pCachedHdl = hdlCount;
             ret = sdocomint_processState(hdlCount, sdoComConEvent_p, pSdoCom_p);
         }
         else if ((pSdoComCon->sdoSeqConHdl == 0) && (hdlFree == 0xFFFF))
@@ -444,6 +455,7 @@ tOplkError sdocomint_processCmdLayerConnection(tSdoSeqConHdl sdoSeqConHdl_p,
             hdlCount = hdlFree;
             pSdoComCon = &sdoComInstance_g.sdoComCon[hdlCount];
             pSdoComCon->sdoSeqConHdl = sdoSeqConHdl_p;
+            *pCachedHdl = hdlCount;
             ret = sdocomint_processState(hdlCount, sdoComConEvent_p, pSdoCom_p);
         }
     }
@@ -59,15 +59,19 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // const defines
 //------------------------------------------------------------------------------
-#define SDO_HISTORY_SIZE                5
-
 #ifndef CONFIG_SDO_MAX_CONNECTION_SEQ
 #define CONFIG_SDO_MAX_CONNECTION_SEQ   5
 #endif
 
+#ifndef CONFIG_SDO_SEQ_HISTORY_SIZE
+#define CONFIG_SDO_SEQ_HISTORY_SIZE     5                       // maximum number of Tx history frames (window size) per connection
+#endif
+
 #define SDO_SEQ_RETRY_COUNT             2                       // number of ack requests before close (final timeout)
 #define SDO_SEQ_CMDL_INACTIVE_THLD      2                       // number of seq. layer sub timeouts before close if command layer is not active
-#define SDO_SEQ_NUM_THRESHOLD           100                     // threshold which distinguishes between old and new sequence numbers
+#define SDO_SEQ_NUM_THRESHOLD           128                     // threshold which distinguishes between old and new sequence numbers (half of the range)
+#define SDO_SEQ_MIN_HISTORY_SIZE        2                       // an ack is requested if only one history entry is left
+#define SDO_SEQ_MAX_HISTORY_SIZE        ((SDO_SEQ_NUM_THRESHOLD >> 2) - 1)  // window must stay below half of the 6 bit sequence number range
 #define SDO_SEQ_FRAME_SIZE              24                      // frame with size of Asnd-Header-, SDO Sequence header size, SDO Command header and Ethernet-header size
 #define SDO_SEQ_HEADER_SIZE             4                       // size of the header of the SDO Sequence layer
 #define SDO_SEQ_TX_HISTORY_FRAME_SIZE   SDO_MAX_TX_FRAME_SIZE   // buffersize for one frame in history
@@ -75,6 +79,12 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #define SEQ_NUM_MASK                    0xFC
 
+#define SDO_SEQ_CON_CACHE_SIZE          (2 * CONFIG_SDO_MAX_CONNECTION_SEQ)   // number of entries of the lower layer handle cache
+
+#if ((CONFIG_SDO_SEQ_HISTORY_SIZE < SDO_SEQ_MIN_HISTORY_SIZE) || (CONFIG_SDO_SEQ_HISTORY_SIZE > SDO_SEQ_MAX_HISTORY_SIZE))
+#error "CONFIG_SDO_SEQ_HISTORY_SIZE must be within [2 .. 31]!"
+#endif
+
 static const UINT32 SDO_SEQU_MAX_TIMEOUT_MS = 86400000UL;       // [ms], 86400000 ms = 1 day
 
 //------------------------------------------------------------------------------
@@ -126,13 +136,16 @@ This structure defines the SDO sequence layer connection history buffer.
 */
 typedef struct
 {
+    UINT8   historySize;    ///< Number of used history entries (window size of the connection)
     UINT8   freeEntries;    ///< Number of free history entries
     UINT8   writeIndex;     ///< Index of the next free buffer entry
     UINT8   ackIndex;       ///< Index of the next message which should become acknowledged
     UINT8   readIndex;      ///< Index between ackIndex and writeIndex to the next message for retransmission
-    UINT8   aHistoryFrame[SDO_HISTORY_SIZE][SDO_SEQ_TX_HISTORY_FRAME_SIZE];    ///< Array of the history frames
-    size_t  aFrameSize[SDO_HISTORY_SIZE];           ///< Array of sizes of the history frames
-    BOOL    afFrameFirstTxFailed[SDO_HISTORY_SIZE]; ///< Array of flags tagging frame as unsent
+    UINT8   retransmitSeqNum;           ///< Acknowledged sequence number of the last served retransmission request
+    UINT8   retransmitSuppressCount;    ///< Number of repeated retransmission requests for retransmitSeqNum to be ignored
+    UINT8   aHistoryFrame[CONFIG_SDO_SEQ_HISTORY_SIZE][SDO_SEQ_TX_HISTORY_FRAME_SIZE];  ///< Array of the history frames
+    size_t  aFrameSize[CONFIG_SDO_SEQ_HISTORY_SIZE];            ///< Array of sizes of the history frames
+    BOOL    afFrameFirstTxFailed[CONFIG_SDO_SEQ_HISTORY_SIZE];  ///< Array of flags tagging frame as unsent
                                                     /**< Array of flags indicating that the first attempt to
                                                          forward a frame to a lower layer send function failed
                                                          due to buffer overflow e.g. and should be repeated later */
@@ -193,6 +206,8 @@ typedef struct
     tSdoComReceiveCb        pfnSdoComRecvCb;                            ///< Pointer to receive callback function
     tSdoComConCb            pfnSdoComConCb;                             ///< Pointer to connection callback function
     UINT32                  sdoSeqTimeout;                              ///< Configured Sequence layer sub-timeout
+    UINT8                   historySize;                                ///< Configured Tx history size (window) for new connections
+    UINT16                  aConIndexCache[SDO_SEQ_CON_CACHE_SIZE];     ///< Last used connection index for lower layer handles (validated on use)
 
 #if (defined(WIN32) || defined(_WIN32))
     LPCRITICAL_SECTION      pCriticalSection;
@@ -259,6 +274,9 @@ static tOplkError addFrameToHistory(tSdoSeqCon* pSdoSeqCon_p,
                                     size_t size_p,
                                     BOOL fTxFailed_p);
 static tOplkError sendAllTxHistory(tSdoSeqCon* pSdoSeqCon_p);
+static tOplkError retransmitTxHistory(tSdoSeqCon* pSdoSeqCon_p,
+                                      UINT8 recvSeqNumber_p);
+static void       markReadFrameSent(tSdoSeqCon* pSdoSeqCon_p);
 static tOplkError deleteAckedFrameFromHistory(tSdoSeqCon* pSdoSeqCon_p,
                                               UINT8 recvSeqNumber_p);
 static tOplkError readFromHistory(tSdoSeqCon* pSdoSeqCon_p,
@@ -281,6 +299,9 @@ static tOplkError sendHistoryOldestSegm(tSdoSeqCon* pSdoSeqCon_p,
                                         UINT8 recvSeqNumber_p);
 static void       forceRetransmissionRequest(tSdoSeqCon* pSdoSeqCon_p,
                                              BOOL fEnable_p);
+static UINT       findConnection(tSdoConHdl conHdl_p,
+                                 UINT* pFreeCon_p);
+static UINT       getConIndexCacheSlot(tSdoConHdl conHdl_p);
 
 //============================================================================//
 //            P U B L I C   F U N C T I O N S                                 //
@@ -318,6 +339,8 @@ tOplkError sdoseq_init(tSdoComReceiveCb pfnSdoComRecvCb_p,
         sdoSeqInstance_l.pfnSdoComConCb = pfnSdoComConCb_p;
 
     OPLK_MEMSET(&sdoSeqInstance_l.aSdoSeqCon[0], 0x00, sizeof(sdoSeqInstance_l.aSdoSeqCon));
+    OPLK_MEMSET(&sdoSeqInstance_l.aConIndexCache[0], 0x00, sizeof(sdoSeqInstance_l.aConIndexCache));
+    sdoSeqInstance_l.historySize = CONFIG_SDO_SEQ_HISTORY_SIZE;
 
 #if (defined(WIN32) || defined(_WIN32))
     // create critical section for process function
@@ -461,21 +484,7 @@ tOplkError sdoseq_initCon(tSdoSeqConHdl* pSdoSeqConHdl_p,
     }
 
     // find existing connection to the same node or find empty entry for connection
-    count = 0;
-    freeCon = CONFIG_SDO_MAX_CONNECTION_SEQ;
-    pSdoSeqCon = &sdoSeqInstance_l.aSdoSeqCon[0];
-
-    while (count < CONFIG_SDO_MAX_CONNECTION_SEQ)
-    {
-        if (pSdoSeqCon->conHandle == conHandle)
-            break;
-
-        if (pSdoSeqCon->conHandle == 0)
-            freeCon = count;
-
-        count++;
-        pSdoSeqCon++;
-    }
+    count = findConnection(conHandle, &freeCon);
 
     if (count == CONFIG_SDO_MAX_CONNECTION_SEQ)
     {
@@ -513,6 +522,7 @@ tOplkError sdoseq_initCon(tSdoSeqConHdl* pSdoSeqConHdl_p,
             pSdoSeqCon->conHandle = conHandle;
             pSdoSeqCon->useCount++;     // increment use counter
             count = freeCon;
+            sdoSeqInstance_l.aConIndexCache[getConIndexCacheSlot(conHandle)] = (UINT16)count;
         }
     }
 
@@ -613,13 +623,11 @@ tOplkError sdoseq_processEvent(const tEvent* pEvent_p)
     timeru_deleteTimer(&pSdoSeqCon->timerHandle);
 
     // get index number of control structure
-    count = 0;
-    while (&sdoSeqInstance_l.aSdoSeqCon[count] != pSdoSeqCon)
-    {
-        count++;
-        if (count > CONFIG_SDO_MAX_CONNECTION_SEQ)
-            return ret;
-    }
+    if ((pSdoSeqCon < &sdoSeqInstance_l.aSdoSeqCon[0]) ||
+        (pSdoSeqCon >= &sdoSeqInstance_l.aSdoSeqCon[CONFIG_SDO_MAX_CONNECTION_SEQ]))
+        return ret;
+
+    count = (UINT)(pSdoSeqCon - &sdoSeqInstance_l.aSdoSeqCon[0]);
 
     // process event and call process function if needed
     ret = processState(count, 0, NULL, NULL, kSdoSeqEventTimeout);
@@ -693,6 +701,34 @@ tOplkError sdoseq_setTimeout(UINT32 timeout_p)
     return kErrorOk;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Set sequence layer window size
+
+The function sets the number of frames which may be sent on a sequence layer
+connection without being acknowledged by the receiver (size of the Tx history
+buffer). The new size is applied to connections which are initialized
+afterwards.
+
+\param[in]      windowSize_p        Number of history frames. It must be within
+                                    [2 .. CONFIG_SDO_SEQ_HISTORY_SIZE].
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_sdo_seq
+*/
+//------------------------------------------------------------------------------
+tOplkError sdoseq_setWindowSize(UINT windowSize_p)
+{
+    if ((windowSize_p < SDO_SEQ_MIN_HISTORY_SIZE) ||
+        (windowSize_p > CONFIG_SDO_SEQ_HISTORY_SIZE))
+        return kErrorApiInvalidParam;
+
+    sdoSeqInstance_l.historySize = (UINT8)windowSize_p;
+
+    return kErrorOk;
+}
+
 //============================================================================//
 //            P R I V A T E   F U N C T I O N S                               //
 //============================================================================//
@@ -1277,7 +1313,7 @@ static tOplkError processStateConnected(tSdoSeqCon* pSdoSeqCon_p,
 
                         // reset timeout counter
                         pSdoSeqCon_p->retryCount = 0;
-                        ret = sendAllTxHistory(pSdoSeqCon_p);
+                        ret = retransmitTxHistory(pSdoSeqCon_p, recvSeqNumCon & SEQ_NUM_MASK);
                         if (ret != kErrorOk)
                             return ret;
                     }
@@ -1577,8 +1613,8 @@ static tOplkError processStateWaitAck(tSdoSeqCon* pSdoSeqCon_p,
                     }
                 }
                 else
-                {   // retransmit all frames from history
-                    ret= sendAllTxHistory(pSdoSeqCon_p);
+                {   // retransmit all frames following the acknowledged one
+                    ret = retransmitTxHistory(pSdoSeqCon_p, recvSeqNumCon & SEQ_NUM_MASK);
                     if (ret != kErrorOk)
                         return ret;
                 }
@@ -1782,6 +1818,8 @@ static tOplkError sendFrame(tSdoSeqCon* pSdoSeqCon_p,
                 }
                 if (ret != kErrorOk)
                     goto Exit;
+
+                markReadFrameSent(pSdoSeqCon_p);
             }
             // read next frame
             ret = readFromHistory(pSdoSeqCon_p, &pFrameResend, &frameSizeResend, FALSE);
@@ -1873,9 +1911,6 @@ static tOplkError receiveCb(tSdoConHdl conHdl_p,
 
     do
     {
-        count = 0;
-        freeEntry = CONFIG_SDO_MAX_CONNECTION_SEQ;
-
 #if (defined(WIN32) || defined(_WIN32))
         EnterCriticalSection(sdoSeqInstance_l.pCriticalSectionReceive);
 #endif
@@ -1885,17 +1920,7 @@ static tOplkError receiveCb(tSdoConHdl conHdl_p,
                             ((const UINT8*)pSdoSeqData_p)[0]);
 
         // search control structure for this connection
-        pSdoSeqCon = &sdoSeqInstance_l.aSdoSeqCon[count];
-        while (count < CONFIG_SDO_MAX_CONNECTION_SEQ)
-        {
-            if (pSdoSeqCon->conHandle == conHdl_p)
-                break;
-            else if ((pSdoSeqCon->conHandle == 0) && (freeEntry == CONFIG_SDO_MAX_CONNECTION_SEQ))
-                freeEntry = count;   // free entry
-
-            count++;
-            pSdoSeqCon++;
-        }
+        count = findConnection(conHdl_p, &freeEntry);
 
         if (count == CONFIG_SDO_MAX_CONNECTION_SEQ)
         {   // new connection
@@ -1913,6 +1938,7 @@ static tOplkError receiveCb(tSdoConHdl conHdl_p,
                 pSdoSeqCon->conHandle = conHdl_p;    // save handle from lower layer
                 pSdoSeqCon->useCount++;
                 count = freeEntry;
+                sdoSeqInstance_l.aConIndexCache[getConIndexCacheSlot(conHdl_p)] = (UINT16)count;
             }
         }
 
@@ -1940,9 +1966,11 @@ The function initializes the history buffer of a SDO connection.
 //------------------------------------------------------------------------------
 static tOplkError initHistory(tSdoSeqCon* pSdoSeqCon_p)
 {
-    pSdoSeqCon_p->sdoSeqConHistory.freeEntries = SDO_HISTORY_SIZE;
+    pSdoSeqCon_p->sdoSeqConHistory.historySize = sdoSeqInstance_l.historySize;
+    pSdoSeqCon_p->sdoSeqConHistory.freeEntries = sdoSeqInstance_l.historySize;
     pSdoSeqCon_p->sdoSeqConHistory.ackIndex = 0;
     pSdoSeqCon_p->sdoSeqConHistory.writeIndex = 0;
+    pSdoSeqCon_p->sdoSeqConHistory.retransmitSuppressCount = 0;
 
     return kErrorOk;
 }
@@ -1990,7 +2018,7 @@ static tOplkError addFrameToHistory(tSdoSeqCon* pSdoSeqCon_p,
         pHistory->afFrameFirstTxFailed[pHistory->writeIndex] = fTxFailed_p;
         pHistory->freeEntries--;
         pHistory->writeIndex++;
-        if (pHistory->writeIndex == SDO_HISTORY_SIZE)    // check if write-index ran over array-border
+        if (pHistory->writeIndex == pHistory->historySize)  // check if write-index ran over array-border
             pHistory->writeIndex = 0;
     }
     else
@@ -2034,6 +2062,8 @@ static tOplkError sendAllTxHistory(tSdoSeqCon* pSdoSeqCon_p)
         if (ret != kErrorOk)
             return ret;
 
+        markReadFrameSent(pSdoSeqCon_p);
+
         ret = readFromHistory(pSdoSeqCon_p, &pFrame, &frameSize, FALSE);
         if (ret == kErrorRetry)
             ret = kErrorOk; // ignore unsent frames info
@@ -2045,6 +2075,74 @@ static tOplkError sendAllTxHistory(tSdoSeqCon* pSdoSeqCon_p)
     return ret;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Retransmit the history buffer on a retransmission request
+
+The function serves a retransmission request of the receiver. All frames
+following the acknowledged one are still stored in the history buffer and are
+sent again. The receiver issues a retransmission request for every out of order
+frame, therefore the frames which were already on their way when the history
+has been retransmitted cause repeated requests with the same acknowledged
+sequence number. These requests are ignored. Further requests indicate that the
+retransmitted frames got lost as well and the history is sent again.
+
+\param[in,out]  pSdoSeqCon_p        Pointer to sequence layer connection information.
+\param[in]      recvSeqNumber_p     Acknowledged sequence number of the
+                                    retransmission request.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError retransmitTxHistory(tSdoSeqCon* pSdoSeqCon_p,
+                                      UINT8 recvSeqNumber_p)
+{
+    tSdoSeqConHistory*  pHistory;
+    UINT8               pendingEntries;
+
+    pHistory = &pSdoSeqCon_p->sdoSeqConHistory;
+
+    if ((pHistory->retransmitSuppressCount > 0) &&
+        (pHistory->retransmitSeqNum == recvSeqNumber_p))
+    {   // repeated request caused by frames sent before the retransmission
+        pHistory->retransmitSuppressCount--;
+        return kErrorOk;
+    }
+
+    // all frames but the lost one may trigger another request
+    pendingEntries = pHistory->historySize - pHistory->freeEntries;
+    pHistory->retransmitSeqNum = recvSeqNumber_p;
+    pHistory->retransmitSuppressCount = (pendingEntries > 0) ? (pendingEntries - 1) : 0;
+
+    return sendAllTxHistory(pSdoSeqCon_p);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Mark the frame last read from the history buffer as sent
+
+The function clears the unsent flag of the frame which has been returned by
+the last call of readFromHistory(), after it was successfully forwarded to the
+lower layer. Thus, it is not sent again together with the next new frame.
+
+\param[in,out]  pSdoSeqCon_p        Pointer to connection control structure.
+*/
+//------------------------------------------------------------------------------
+static void markReadFrameSent(tSdoSeqCon* pSdoSeqCon_p)
+{
+    tSdoSeqConHistory*  pHistory;
+    UINT8               index;
+
+    pHistory = &pSdoSeqCon_p->sdoSeqConHistory;
+
+    if (pHistory->readIndex == 0)
+        index = pHistory->historySize - 1;
+    else
+        index = pHistory->readIndex - 1;
+
+    pHistory->afFrameFirstTxFailed[index] = FALSE;
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  Delete acknowledged frame from the history buffer
@@ -2072,7 +2170,7 @@ static tOplkError deleteAckedFrameFromHistory(tSdoSeqCon* pSdoSeqCon_p,
     // release all acknowledged frames from history buffer
 
     // check if there are entries in history
-    if (pHistory->freeEntries < SDO_HISTORY_SIZE)
+    if (pHistory->freeEntries < pHistory->historySize)
     {
         ackIndex = pHistory->ackIndex;
         do
@@ -2084,9 +2182,11 @@ static tOplkError deleteAckedFrameFromHistory(tSdoSeqCon* pSdoSeqCon_p,
             {
                 pHistory->aFrameSize[ackIndex] = 0;
                 pHistory->afFrameFirstTxFailed[ackIndex] = FALSE;
+                // an advancing acknowledge ends the pending retransmission
+                pHistory->retransmitSuppressCount = 0;
                 ackIndex++;
                 pHistory->freeEntries++;
-                if (ackIndex == SDO_HISTORY_SIZE)
+                if (ackIndex == pHistory->historySize)
                     ackIndex = 0;
             }
             else
@@ -2141,7 +2241,7 @@ static tOplkError readFromHistory(tSdoSeqCon* pSdoSeqCon_p,
     }
 
     // history buffer not empty and end of read iteration not yet reached
-    if ((pHistory->freeEntries < SDO_HISTORY_SIZE) &&
+    if ((pHistory->freeEntries < pHistory->historySize) &&
         ((pHistory->writeIndex != pHistory->readIndex) ||
          ((pHistory->freeEntries == 0) && fInitRead_p)))
     {
@@ -2166,7 +2266,7 @@ static tOplkError readFromHistory(tSdoSeqCon* pSdoSeqCon_p,
         *ppFrame_p = (tPlkFrame*)pHistory->aHistoryFrame[pHistory->readIndex];
         *pSize_p = pHistory->aFrameSize[pHistory->readIndex];   // save size
         pHistory->readIndex++;
-        if (pHistory->readIndex == SDO_HISTORY_SIZE)
+        if (pHistory->readIndex == pHistory->historySize)
             pHistory->readIndex = 0;
     }
     else
@@ -2428,7 +2528,7 @@ static tOplkError deleteLowLayerConnection(tSdoSeqCon* pSdoSeqCon_p)
 
     // cleanup control structure
     OPLK_MEMSET(pSdoSeqCon_p, 0x00, sizeof(tSdoSeqCon));
-    pSdoSeqCon_p->sdoSeqConHistory.freeEntries = SDO_HISTORY_SIZE;
+    initHistory(pSdoSeqCon_p);
 
 Exit:
     return ret;
@@ -2499,8 +2599,9 @@ static BOOL checkConnectionAckValid(const tSdoSeqCon* pSdoSeqCon_p,
 /**
 \brief  Send one frame (oldest) of the Tx history buffer
 
-This function transmits the oldest frame of the Tx history buffer, if
-it exists. If the history buffer is empty, nothing happens.
+This function transmits the oldest frame of the Tx history buffer, if it
+exists and has not been forwarded to the lower layer successfully yet.
+Otherwise nothing happens.
 
 \param[in,out]  pSdoSeqCon_p        Pointer to connection control structure.
 \param[in]      recvSeqNumber_p     Receive sequence number of frame to delete.
@@ -2522,22 +2623,27 @@ static tOplkError sendHistoryOldestSegm(tSdoSeqCon* pSdoSeqCon_p,
         // Use this as trigger for last segments, since they
         // don't get a trigger otherwise, except a timeout.
 
-        // send oldest history frame
+        // send oldest history frame, if it has not been sent yet
+        // Frames which have been sent already are repeated on a retransmission
+        // request or a timeout, otherwise every old acknowledge would queue
+        // another copy of the frame.
         ret = readFromHistory(pSdoSeqCon_p, &pFrame, &frameSize, TRUE);
-        if (ret == kErrorRetry)
-            ret = kErrorOk; // ignore unsent frames info
-        if (ret != kErrorOk)
+        if (ret != kErrorRetry)
             return ret;
 
         if ((pFrame != NULL) && (frameSize != 0))
         {
             ret = sendToLowerLayer(pSdoSeqCon_p, frameSize, pFrame);
             if (ret == kErrorDllAsyncTxBufferFull)
-                ret = kErrorOk; // ignore unsent frame
+                return kErrorOk; // ignore unsent frame
 
             if (ret != kErrorOk)
                 return ret;
+
+            markReadFrameSent(pSdoSeqCon_p);
         }
+        else
+            ret = kErrorOk;
     }
 
     return ret;
@@ -2567,4 +2673,75 @@ static void forceRetransmissionRequest(tSdoSeqCon* pSdoSeqCon_p, BOOL fEnable_p)
     pSdoSeqCon_p->fForceFlowControl = fEnable_p;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Find connection by lower layer handle
+
+The function searches the sequence layer connection which belongs to the
+specified lower layer connection handle. The connection index which was last
+used for the handle is checked first, so that the connection of a received
+frame is found in constant time. Only if this index is no longer valid, the
+connection table is searched.
+
+\param[in]      conHdl_p            Lower layer connection handle.
+\param[out]     pFreeCon_p          Pointer to store the index of the first free
+                                    connection. It is only valid if no connection
+                                    with the handle exists.
+
+\return The function returns the index of the connection or
+        CONFIG_SDO_MAX_CONNECTION_SEQ if no connection with the handle exists.
+*/
+//------------------------------------------------------------------------------
+static UINT findConnection(tSdoConHdl conHdl_p, UINT* pFreeCon_p)
+{
+    UINT    slot;
+    UINT    count;
+
+    *pFreeCon_p = CONFIG_SDO_MAX_CONNECTION_SEQ;
+
+    slot = getConIndexCacheSlot(conHdl_p);
+    count = sdoSeqInstance_l.aConIndexCache[slot];
+    if ((count < CONFIG_SDO_MAX_CONNECTION_SEQ) &&
+        (sdoSeqInstance_l.aSdoSeqCon[count].conHandle == conHdl_p))
+        return count;
+
+    for (count = 0; count < CONFIG_SDO_MAX_CONNECTION_SEQ; count++)
+    {
+        if (sdoSeqInstance_l.aSdoSeqCon[count].conHandle == conHdl_p)
+        {
+            sdoSeqInstance_l.aConIndexCache[slot] = (UINT16)count;
+            return count;
+        }
+
+        if ((sdoSeqInstance_l.aSdoSeqCon[count].conHandle == 0) &&
+            (*pFreeCon_p == CONFIG_SDO_MAX_CONNECTION_SEQ))
+            *pFreeCon_p = count;
+    }
+
+    return CONFIG_SDO_MAX_CONNECTION_SEQ;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get cache slot of a lower layer handle
+
+The function maps a lower layer connection handle to its slot in the connection
+index cache. ASnd and UDP handles with the same index use different slots.
+
+\param[in]      conHdl_p            Lower layer connection handle.
+
+\return The function returns the cache slot.
+*/
+//------------------------------------------------------------------------------
+static UINT getConIndexCacheSlot(tSdoConHdl conHdl_p)
+{
+    UINT    slot;
+
+    slot = ((UINT)conHdl_p & ~SDO_ASY_HANDLE_MASK) << 1;
+    if (((UINT)conHdl_p & SDO_UDP_HANDLE) != 0)
+        slot |= 1;
+
+    return slot % SDO_SEQ_CON_CACHE_SIZE;
+}
+
 /// \}
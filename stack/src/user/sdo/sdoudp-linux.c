@@ -41,13 +41,17 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // includes
 //------------------------------------------------------------------------------
 #include <common/oplkinc.h>
+#include <common/target.h>
 #include <user/sdoudp.h>
 
 #include <unistd.h>
 #include <sys/types.h>
 #include <sys/socket.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
 #include <netinet/in.h>
 #include <pthread.h>
+#include <time.h>
 
 #include <errno.h>
 
@@ -78,6 +82,23 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 #define INVALID_SOCKET  0
 
+// Maximum number of datagrams received or sent with a single system call
+#ifndef CONFIG_SDO_UDP_BATCH_SIZE
+#define CONFIG_SDO_UDP_BATCH_SIZE               16
+#endif
+
+// Interval of the datagram statistics report in seconds (0 = disabled). The
+// report is printed on the console, therefore it is disabled by default.
+#ifndef CONFIG_SDO_UDP_STATISTICS_INTERVAL
+#define CONFIG_SDO_UDP_STATISTICS_INTERVAL      0
+#endif
+
+#if (CONFIG_SDO_UDP_BATCH_SIZE < 1)
+#error "CONFIG_SDO_UDP_BATCH_SIZE must be at least 1!"
+#endif
+
+#define SDOUDP_EPOLL_EVENT_COUNT                2       // UDP socket and stop event
+
 //------------------------------------------------------------------------------
 // local types
 //------------------------------------------------------------------------------
@@ -86,11 +107,51 @@ typedef int SOCKET;
 typedef void* tThreadResult;
 typedef void* tThreadArg;
 
+/**
+\brief Datagram buffers
+
+The structure contains the message headers and buffers for a batch of
+datagrams which are received or sent with a single system call.
+*/
+typedef struct
+{
+    struct mmsghdr              aMsg[CONFIG_SDO_UDP_BATCH_SIZE];        ///< Message headers
+    struct iovec                aIov[CONFIG_SDO_UDP_BATCH_SIZE];        ///< Data vectors
+    struct sockaddr_in          aAddr[CONFIG_SDO_UDP_BATCH_SIZE];       ///< Remote addresses
+    UINT8                       aaBuffer[CONFIG_SDO_UDP_BATCH_SIZE][SDO_MAX_RX_FRAME_SIZE_UDP];    ///< Datagram data
+    UINT                        count;                                  ///< Number of queued datagrams (Tx only)
+} tSdoUdpBatch;
+
+/**
+\brief Datagram statistics
+
+The structure contains the datagram and batch counters of the current
+statistics interval.
+*/
+typedef struct
+{
+    struct timespec             startTime;          ///< Start time of the interval
+    UINT32                      rxDatagrams;        ///< Number of received datagrams
+    UINT32                      rxBatches;          ///< Number of receive system calls which returned data
+    UINT32                      maxRxBatchSize;     ///< Maximum number of datagrams received at once
+    UINT32                      txDatagrams;        ///< Number of sent datagrams
+    UINT32                      txBatches;          ///< Number of send system calls
+    UINT32                      maxTxBatchSize;     ///< Maximum number of datagrams sent at once
+} tSdoUdpStatistics;
+
 typedef struct
 {
     SOCKET                      udpSocket;
+    int                         epollFd;
+    int                         stopEventFd;
     pthread_t                   threadHandle;
     BOOL                        fStopThread;
+    BOOL                        fTxBatchOpen;       ///< Frames sent by the UDP thread are collected in txBatch
+    tSdoUdpBatch                rxBatch;
+    pthread_mutex_t             txMutex;            ///< Serializes all sends through txBatch
+    tSdoUdpBatch                txBatch;
+    pthread_mutex_t             statisticsMutex;
+    tSdoUdpStatistics           statistics;
 } tSdoUdpSocketInstance;
 
 //------------------------------------------------------------------------------
@@ -101,7 +162,11 @@ static tSdoUdpSocketInstance    instance_l;
 //------------------------------------------------------------------------------
 // local function prototypes
 //------------------------------------------------------------------------------
-static void          receiveFromSocket(const tSdoUdpSocketInstance* pInstance_p);
+static void          receiveFromSocket(tSdoUdpSocketInstance* pInstance_p);
+static tOplkError    flushTxBatch(tSdoUdpSocketInstance* pInstance_p);
+static void          updateStatistics(tSdoUdpSocketInstance* pInstance_p,
+                                      UINT rxCount_p,
+                                      UINT txCount_p);
 static tThreadResult sdoUdpThread(tThreadArg pArg_p);
 
 //============================================================================//
@@ -121,10 +186,39 @@ The function initializes the SDO over UDP socket module.
 //------------------------------------------------------------------------------
 tOplkError sdoudp_initSocket(void)
 {
+    UINT    i;
+
     OPLK_MEMSET(&instance_l, 0x00, sizeof(instance_l));
 
     instance_l.threadHandle = 0;
     instance_l.udpSocket = INVALID_SOCKET;
+    instance_l.epollFd = -1;
+    instance_l.stopEventFd = -1;
+
+    // The message headers point to the static buffers of the instance
+    for (i = 0; i < CONFIG_SDO_UDP_BATCH_SIZE; i++)
+    {
+        instance_l.rxBatch.aIov[i].iov_base = instance_l.rxBatch.aaBuffer[i];
+        instance_l.rxBatch.aIov[i].iov_len = sizeof(instance_l.rxBatch.aaBuffer[i]);
+        instance_l.rxBatch.aMsg[i].msg_hdr.msg_iov = &instance_l.rxBatch.aIov[i];
+        instance_l.rxBatch.aMsg[i].msg_hdr.msg_iovlen = 1;
+        instance_l.rxBatch.aMsg[i].msg_hdr.msg_name = &instance_l.rxBatch.aAddr[i];
+
+        instance_l.txBatch.aIov[i].iov_base = instance_l.txBatch.aaBuffer[i];
+        instance_l.txBatch.aMsg[i].msg_hdr.msg_iov = &instance_l.txBatch.aIov[i];
+        instance_l.txBatch.aMsg[i].msg_hdr.msg_iovlen = 1;
+        instance_l.txBatch.aMsg[i].msg_hdr.msg_name = &instance_l.txBatch.aAddr[i];
+        instance_l.txBatch.aMsg[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_in);
+    }
+
+    if (pthread_mutex_init(&instance_l.txMutex, NULL) != 0)
+        return kErrorNoResource;
+
+    if (pthread_mutex_init(&instance_l.statisticsMutex, NULL) != 0)
+    {
+        pthread_mutex_destroy(&instance_l.txMutex);
+        return kErrorNoResource;
+    }
 
     return kErrorOk;
 }
@@ -140,14 +234,16 @@ The function shuts down the SDO over UDP socket module.
 //------------------------------------------------------------------------------
 void sdoudp_exitSocket(void)
 {
-
+    pthread_mutex_destroy(&instance_l.statisticsMutex);
+    pthread_mutex_destroy(&instance_l.txMutex);
 }
 
 //------------------------------------------------------------------------------
 /**
 \brief  Create socket for SDO over UDP
 
-The function creates a socket for the SDO over UDP connection.
+The function creates a socket for the SDO over UDP connection. If the socket
+cannot be created, all resources allocated so far are released.
 
 \param[in,out]  pSdoUdpCon_p        UDP connection for which a socket shall be created.
 
@@ -158,16 +254,19 @@ The function creates a socket for the SDO over UDP connection.
 //------------------------------------------------------------------------------
 tOplkError sdoudp_createSocket(tSdoUdpCon* pSdoUdpCon_p)
 {
+    tOplkError          ret = kErrorOk;
     struct sockaddr_in  addr;
+    struct epoll_event  event;
     int                 error;
 
     // Check parameter validity
     ASSERT(pSdoUdpCon_p != NULL);
 
     instance_l.udpSocket = socket(PF_INET, SOCK_DGRAM, IPPROTO_UDP);
-    if (instance_l.udpSocket == INVALID_SOCKET)
+    if (instance_l.udpSocket < 0)
     {
         DEBUG_LVL_SDO_TRACE("%s(): socket() failed\n", __func__);
+        instance_l.udpSocket = INVALID_SOCKET;
         return kErrorSdoUdpNoSocket;
     }
 
@@ -182,20 +281,60 @@ tOplkError sdoudp_createSocket(tSdoUdpCon* pSdoUdpCon_p)
     if (error < 0)
     {
         DEBUG_LVL_SDO_TRACE("%s(): bind() finished with %i\n", __func__, error);
-        return kErrorSdoUdpNoSocket;
+        ret = kErrorSdoUdpNoSocket;
+        goto Exit;
+    }
+
+    // The listen thread waits for the socket and for the stop event
+    instance_l.epollFd = epoll_create1(EPOLL_CLOEXEC);
+    instance_l.stopEventFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if ((instance_l.epollFd < 0) || (instance_l.stopEventFd < 0))
+    {
+        DEBUG_LVL_SDO_TRACE("%s(): creating epoll instance failed: %s\n", __func__, strerror(errno));
+        ret = kErrorSdoUdpNoSocket;
+        goto Exit;
     }
 
+    OPLK_MEMSET(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.fd = instance_l.udpSocket;
+    error = epoll_ctl(instance_l.epollFd, EPOLL_CTL_ADD, instance_l.udpSocket, &event);
+    if (error == 0)
+    {
+        event.data.fd = instance_l.stopEventFd;
+        error = epoll_ctl(instance_l.epollFd, EPOLL_CTL_ADD, instance_l.stopEventFd, &event);
+    }
+
+    if (error < 0)
+    {
+        DEBUG_LVL_SDO_TRACE("%s(): epoll_ctl() failed: %s\n", __func__, strerror(errno));
+        ret = kErrorSdoUdpNoSocket;
+        goto Exit;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &instance_l.statistics.startTime);
+
     // create Listen-Thread
     instance_l.fStopThread = FALSE;
 
     if (pthread_create(&instance_l.threadHandle, NULL, sdoUdpThread, &instance_l) != 0)
-        return kErrorSdoUdpThreadError;
+    {
+        instance_l.threadHandle = 0;
+        ret = kErrorSdoUdpThreadError;
+        goto Exit;
+    }
 
-#if (defined(__GLIBC__) && (__GLIBC__ >= 2) && (__GLIBC_MINOR__ >= 12))
-    pthread_setname_np(instance_l.threadHandle, "oplk-sdoudp");
-#endif
+    target_registerThread(kOplkThreadRoleSdoUdp,
+                          instance_l.threadHandle,
+                          kOplkThreadPolicyDefault,
+                          0,
+                          "oplk-sdoudp");
 
-    return kErrorOk;
+Exit:
+    if (ret != kErrorOk)
+        sdoudp_closeSocket();       // closes the file descriptors created so far
+
+    return ret;
 }
 
 //------------------------------------------------------------------------------
@@ -211,18 +350,37 @@ The function closes the created socket for the SDO over UDP connection.
 //------------------------------------------------------------------------------
 tOplkError sdoudp_closeSocket(void)
 {
-    int error;
+    int         error;
+    UINT64      stopEvent = 1;
 
     if (instance_l.threadHandle != 0)
     {   // listen thread was started -> close old thread
 
         instance_l.fStopThread = TRUE;
+        if (write(instance_l.stopEventFd, &stopEvent, sizeof(stopEvent)) != sizeof(stopEvent))
+        {
+            DEBUG_LVL_SDO_TRACE("%s(): signaling stop event failed\n", __func__);
+        }
+
+        target_unregisterThread(kOplkThreadRoleSdoUdp, instance_l.threadHandle);
         if (pthread_join(instance_l.threadHandle, NULL) != 0)
             return kErrorSdoUdpThreadError;
 
         instance_l.threadHandle = 0;
     }
 
+    if (instance_l.epollFd >= 0)
+    {
+        close(instance_l.epollFd);
+        instance_l.epollFd = -1;
+    }
+
+    if (instance_l.stopEventFd >= 0)
+    {
+        close(instance_l.stopEventFd);
+        instance_l.stopEventFd = -1;
+    }
+
     if (instance_l.udpSocket != INVALID_SOCKET)
     {
         error = close(instance_l.udpSocket);
@@ -240,6 +398,12 @@ tOplkError sdoudp_closeSocket(void)
 
 The function sends an SDO frame to the given UDP connection.
 
+Frames which are sent by the UDP thread while it processes received datagrams
+(e.g. acknowledges and responses) are collected and sent with a single
+sendmmsg() call after all received datagrams have been processed. All other
+frames are sent immediately together with the collected frames, so frames are
+always sent in the order of the calls.
+
 \param[in]      pSdoUdpCon_p        UDP connection to send the frame to.
 \param[in]      pSrcData_p          Pointer to frame data which should be sent.
 \param[in]      dataSize_p          Size of data to be send.
@@ -253,30 +417,61 @@ tOplkError sdoudp_sendToSocket(const tSdoUdpCon* pSdoUdpCon_p,
                                const tPlkFrame* pSrcData_p,
                                size_t dataSize_p)
 {
+    tOplkError          ret = kErrorOk;
     struct sockaddr_in  addr;
     int                 error;
+    tSdoUdpBatch*       pTxBatch = &instance_l.txBatch;
+    BOOL                fCollect;
 
     // Check parameter validity
     ASSERT(pSdoUdpCon_p != NULL);
     ASSERT(pSrcData_p != NULL);
 
-    addr.sin_family = AF_INET;
-    addr.sin_port = pSdoUdpCon_p->port;
-    addr.sin_addr.s_addr = pSdoUdpCon_p->ipAddr;
-
-    error = sendto(instance_l.udpSocket,
-                   (const char*)&pSrcData_p->messageType,
-                   dataSize_p,
-                   0,
-                   (struct sockaddr*)&addr,
-                   sizeof(struct sockaddr_in));
-    if (error < 0)
+    fCollect = pthread_equal(pthread_self(), instance_l.threadHandle) && instance_l.fTxBatchOpen;
+
+    pthread_mutex_lock(&instance_l.txMutex);
+
+    if (dataSize_p <= sizeof(pTxBatch->aaBuffer[0]))
     {
-        DEBUG_LVL_SDO_TRACE("%s(): sendto() finished with %i\n", __func__, error);
-        return kErrorSdoUdpSendError;
+        if (pTxBatch->count == CONFIG_SDO_UDP_BATCH_SIZE)
+            flushTxBatch(&instance_l);
+
+        pTxBatch->aAddr[pTxBatch->count].sin_family = AF_INET;
+        pTxBatch->aAddr[pTxBatch->count].sin_port = pSdoUdpCon_p->port;
+        pTxBatch->aAddr[pTxBatch->count].sin_addr.s_addr = pSdoUdpCon_p->ipAddr;
+        OPLK_MEMCPY(pTxBatch->aaBuffer[pTxBatch->count], &pSrcData_p->messageType, dataSize_p);
+        pTxBatch->aIov[pTxBatch->count].iov_len = dataSize_p;
+        pTxBatch->count++;
+
+        if (!fCollect)
+            ret = flushTxBatch(&instance_l);
+    }
+    else
+    {   // frames which do not fit into the batch are sent after the collected frames
+        flushTxBatch(&instance_l);
+
+        addr.sin_family = AF_INET;
+        addr.sin_port = pSdoUdpCon_p->port;
+        addr.sin_addr.s_addr = pSdoUdpCon_p->ipAddr;
+
+        error = sendto(instance_l.udpSocket,
+                       (const char*)&pSrcData_p->messageType,
+                       dataSize_p,
+                       0,
+                       (struct sockaddr*)&addr,
+                       sizeof(struct sockaddr_in));
+        if (error < 0)
+        {
+            DEBUG_LVL_SDO_TRACE("%s(): sendto() finished with %i\n", __func__, error);
+            ret = kErrorSdoUdpSendError;
+        }
+        else
+            updateStatistics(&instance_l, 0, 1);
     }
 
-    return kErrorOk;
+    pthread_mutex_unlock(&instance_l.txMutex);
+
+    return ret;
 }
 
 //------------------------------------------------------------------------------
@@ -335,53 +530,178 @@ tOplkError sdoudp_arpQuery(UINT32 remoteIpAddr_p)
 /**
 \brief  Receive data from socket
 
-The function receives data from the UDP socket.
+The function receives a batch of datagrams from the UDP socket with a single
+recvmmsg() call and forwards them to the SDO UDP layer. Frames which are sent
+while the datagrams are processed are collected and sent afterwards.
 
-\param[in]      pInstance_p         Pointer to SDO instance.
+\param[in,out]  pInstance_p         Pointer to SDO instance.
 
 */
 //------------------------------------------------------------------------------
-static void receiveFromSocket(const tSdoUdpSocketInstance* pInstance_p)
+static void receiveFromSocket(tSdoUdpSocketInstance* pInstance_p)
 {
-    struct sockaddr_in  remoteAddr;
-    int                 error;
-    UINT8               aBuffer[SDO_MAX_RX_FRAME_SIZE_UDP];
-    size_t              size;
+    tSdoUdpBatch*       pRxBatch = &pInstance_p->rxBatch;
+    int                 count;
+    int                 i;
     tSdoUdpCon          sdoUdpCon;
+    const tAsySdoSeq*   pSdoSeqData;
+    size_t              dataSize;
+
+    for (i = 0; i < CONFIG_SDO_UDP_BATCH_SIZE; i++)
+        pRxBatch->aMsg[i].msg_hdr.msg_namelen = sizeof(pRxBatch->aAddr[i]);
+
+    count = recvmmsg(pInstance_p->udpSocket,
+                     pRxBatch->aMsg,
+                     CONFIG_SDO_UDP_BATCH_SIZE,
+                     MSG_DONTWAIT,
+                     NULL);
+    if (count <= 0)
+    {
+        if ((count < 0) && (errno != EAGAIN) && (errno != EWOULDBLOCK))
+        {
+            DEBUG_LVL_SDO_TRACE("%s() error=%s\n", __func__, strerror(errno));
+        }
 
-    OPLK_MEMSET(&remoteAddr, 0, sizeof(remoteAddr));
+        return;
+    }
 
-    size = sizeof(struct sockaddr);
+    pInstance_p->fTxBatchOpen = TRUE;
 
-    error = recvfrom(pInstance_p->udpSocket,
-                     (char*)&aBuffer[0],
-                     sizeof(aBuffer),
-                     0,
-                     (struct sockaddr*)&remoteAddr,
-                     (socklen_t*)&size);
-    if (error > 0)
+    for (i = 0; i < count; i++)
     {
-        const tAsySdoSeq*   pSdoSeqData;
-        size_t              dataSize = (size_t)error - ASND_HEADER_SIZE;
+        if (pRxBatch->aMsg[i].msg_len <= ASND_HEADER_SIZE)
+            continue;
 
-        pSdoSeqData = (const tAsySdoSeq*)&aBuffer[ASND_HEADER_SIZE];
-        sdoUdpCon.ipAddr = remoteAddr.sin_addr.s_addr;
-        sdoUdpCon.port = remoteAddr.sin_port;
+        dataSize = (size_t)pRxBatch->aMsg[i].msg_len - ASND_HEADER_SIZE;
+        pSdoSeqData = (const tAsySdoSeq*)&pRxBatch->aaBuffer[i][ASND_HEADER_SIZE];
+        sdoUdpCon.ipAddr = pRxBatch->aAddr[i].sin_addr.s_addr;
+        sdoUdpCon.port = pRxBatch->aAddr[i].sin_port;
 
         sdoudp_receiveData(&sdoUdpCon, pSdoSeqData, dataSize);
     }
-    else
+
+    pInstance_p->fTxBatchOpen = FALSE;
+
+    pthread_mutex_lock(&pInstance_p->txMutex);
+    flushTxBatch(pInstance_p);
+    pthread_mutex_unlock(&pInstance_p->txMutex);
+
+    updateStatistics(pInstance_p, (UINT)count, 0);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Send collected frames
+
+The function sends the collected frames with sendmmsg(). The caller must hold
+the Tx mutex.
+
+\param[in,out]  pInstance_p         Pointer to SDO instance.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError flushTxBatch(tSdoUdpSocketInstance* pInstance_p)
+{
+    tSdoUdpBatch*   pTxBatch = &pInstance_p->txBatch;
+    UINT            sent = 0;
+    int             count;
+
+    while (sent < pTxBatch->count)
     {
-        DEBUG_LVL_SDO_TRACE("%s() error=%d\n", __func__, error);
+        count = sendmmsg(pInstance_p->udpSocket,
+                         &pTxBatch->aMsg[sent],
+                         pTxBatch->count - sent,
+                         0);
+        if (count <= 0)
+        {   // the frames are lost, the sequence layer will repeat them
+            DEBUG_LVL_SDO_TRACE("%s(): sendmmsg() failed: %s\n", __func__, strerror(errno));
+            pTxBatch->count = 0;
+            return kErrorSdoUdpSendError;
+        }
+
+        updateStatistics(pInstance_p, 0, (UINT)count);
+        sent += (UINT)count;
     }
+
+    pTxBatch->count = 0;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Update datagram statistics
+
+The function updates the datagram statistics with a received or sent batch of
+datagrams. At the end of each statistics interval with datagram traffic, the
+datagram rates and the batch sizes are reported.
+
+\param[in,out]  pInstance_p         Pointer to SDO instance.
+\param[in]      rxCount_p           Number of datagrams received with one system call.
+\param[in]      txCount_p           Number of datagrams sent with one system call.
+*/
+//------------------------------------------------------------------------------
+static void updateStatistics(tSdoUdpSocketInstance* pInstance_p,
+                             UINT rxCount_p,
+                             UINT txCount_p)
+{
+#if (CONFIG_SDO_UDP_STATISTICS_INTERVAL != 0)
+    tSdoUdpStatistics*  pStatistics = &pInstance_p->statistics;
+    struct timespec     now;
+    UINT64              elapsedMs;
+
+    pthread_mutex_lock(&pInstance_p->statisticsMutex);
+
+    if (rxCount_p > 0)
+    {
+        pStatistics->rxDatagrams += rxCount_p;
+        pStatistics->rxBatches++;
+        if (rxCount_p > pStatistics->maxRxBatchSize)
+            pStatistics->maxRxBatchSize = rxCount_p;
+    }
+
+    if (txCount_p > 0)
+    {
+        pStatistics->txDatagrams += txCount_p;
+        pStatistics->txBatches++;
+        if (txCount_p > pStatistics->maxTxBatchSize)
+            pStatistics->maxTxBatchSize = txCount_p;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    elapsedMs = (UINT64)(now.tv_sec - pStatistics->startTime.tv_sec) * 1000 +
+                (UINT64)((now.tv_nsec - pStatistics->startTime.tv_nsec) / 1000000);
+    if (elapsedMs >= (CONFIG_SDO_UDP_STATISTICS_INTERVAL * 1000ULL))
+    {
+        DEBUG_LVL_ALWAYS_TRACE("SDO/UDP: rx %lu datagrams/s (avg batch %lu, max %lu), "
+                               "tx %lu datagrams/s (avg batch %lu, max %lu)\n",
+                               (ULONG)((UINT64)pStatistics->rxDatagrams * 1000 / elapsedMs),
+                               (ULONG)((pStatistics->rxBatches != 0) ? pStatistics->rxDatagrams / pStatistics->rxBatches : 0),
+                               (ULONG)pStatistics->maxRxBatchSize,
+                               (ULONG)((UINT64)pStatistics->txDatagrams * 1000 / elapsedMs),
+                               (ULONG)((pStatistics->txBatches != 0) ? pStatistics->txDatagrams / pStatistics->txBatches : 0),
+                               (ULONG)pStatistics->maxTxBatchSize);
+
+        OPLK_MEMSET(pStatistics, 0, sizeof(*pStatistics));
+        pStatistics->startTime = now;
+    }
+
+    pthread_mutex_unlock(&pInstance_p->statisticsMutex);
+#else
+    UNUSED_PARAMETER(pInstance_p);
+    UNUSED_PARAMETER(rxCount_p);
+    UNUSED_PARAMETER(txCount_p);
+#endif
 }
 
 //------------------------------------------------------------------------------
 /**
 \brief  UDP Receiving thread function
 
-The function implements the UDP receive thread. It waits for packets on the
-UDP socket and calls receiveFromSocket() if data is available.
+The function implements the UDP receive thread. It waits with epoll for
+datagrams on the UDP socket and calls receiveFromSocket() if data is available.
+The thread is woken up by an event file descriptor when it shall stop.
 
 \param[in]      pArg_p              Thread argument. The pointer to the SDO instance is
                                     transferred to the thread as thread argument.
@@ -391,38 +711,30 @@ UDP socket and calls receiveFromSocket() if data is available.
 //------------------------------------------------------------------------------
 static tThreadResult sdoUdpThread(tThreadArg pArg_p)
 {
-    const tSdoUdpSocketInstance*    pInstance;
-    fd_set                          readFds;
-    int                             result;
-    struct timeval                  timeout;
+    tSdoUdpSocketInstance*  pInstance;
+    struct epoll_event      aEvents[SDOUDP_EPOLL_EVENT_COUNT];
+    int                     result;
+    int                     i;
 
-    pInstance = (const tSdoUdpSocketInstance*)pArg_p;
+    pInstance = (tSdoUdpSocketInstance*)pArg_p;
 
     while (!pInstance->fStopThread)
     {
-        timeout.tv_sec = 0;
-        timeout.tv_usec = 400000;
-
-        FD_ZERO(&readFds);
-        FD_SET(pInstance->udpSocket, &readFds);
-
-        result = select(pInstance->udpSocket + 1,
-                        &readFds,
-                        NULL,
-                        NULL,
-                        &timeout);
-        switch (result)
+        result = epoll_wait(pInstance->epollFd, aEvents, SDOUDP_EPOLL_EVENT_COUNT, -1);
+        if (result < 0)
         {
-            case 0:     // timeout
-                break;
+            if (errno != EINTR)
+            {
+                DEBUG_LVL_SDO_TRACE("epoll_wait error: %s\n", strerror(errno));
+            }
 
-            case -1:    // error
-                DEBUG_LVL_SDO_TRACE("select error: %s\n", strerror(errno));
-                break;
+            continue;
+        }
 
-            default:    // data available
+        for (i = 0; i < result; i++)
+        {
+            if ((aEvents[i].data.fd == pInstance->udpSocket) && !pInstance->fStopThread)
                 receiveFromSocket(pInstance);
-                break;
         }
     }
 
@@ -5,7 +5,9 @@
 \brief  Implementation of user timer module for Linux userspace
 
 This file contains the implementation of the user timer module for Linux
-userspace. This implementation uses the posix timer interface.
+userspace. All user timers are kept in a hierarchical timer wheel with a
+resolution of one millisecond. A single timerfd wakes up the timer thread
+when the next wheel slot is due.
 
 \ingroup module_timeru
 *******************************************************************************/
@@ -42,14 +44,17 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // includes
 //------------------------------------------------------------------------------
 #include <common/oplkinc.h>
+#include <common/target.h>
 #include <user/timeru.h>
 #include <user/eventu.h>
 
 #include <stdio.h>
 #include <unistd.h>
+#include <errno.h>
+#include <string.h>
+#include <time.h>
 #include <pthread.h>
-#include <semaphore.h>
-#include <signal.h>
+#include <sys/timerfd.h>
 
 // Needed for debugging to extract thread ID on Linux
 #include <sys/syscall.h>
@@ -77,27 +82,63 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // const defines
 //------------------------------------------------------------------------------
+// The first wheel level has 256 slots of 1 ms, each further level has 64 slots
+// covering a whole rotation of the level below. Four levels cover 2^26 ms
+// (about 18 hours), longer timeouts are cascaded from the last level.
+#define TIMERU_WHEEL_ROOT_BITS          8
+#define TIMERU_WHEEL_ROOT_SIZE          (1 << TIMERU_WHEEL_ROOT_BITS)
+#define TIMERU_WHEEL_ROOT_MASK          (TIMERU_WHEEL_ROOT_SIZE - 1)
+#define TIMERU_WHEEL_LEVEL_BITS         6
+#define TIMERU_WHEEL_LEVEL_SIZE         (1 << TIMERU_WHEEL_LEVEL_BITS)
+#define TIMERU_WHEEL_LEVEL_MASK         (TIMERU_WHEEL_LEVEL_SIZE - 1)
+#define TIMERU_WHEEL_LEVEL_COUNT        3
+#define TIMERU_WHEEL_MAX_TICKS          ((UINT64)1 << (TIMERU_WHEEL_ROOT_BITS + \
+                                                       (TIMERU_WHEEL_LEVEL_COUNT * TIMERU_WHEEL_LEVEL_BITS)))
+#define TIMERU_WHEEL_LEVEL_SHIFT(level) (TIMERU_WHEEL_ROOT_BITS + ((level) * TIMERU_WHEEL_LEVEL_BITS))
+
+#define TIMERU_TICK_NONE                (~(UINT64)0)
 
 //------------------------------------------------------------------------------
 // local types
 //------------------------------------------------------------------------------
 typedef struct sTimeruData tTimeruData;
 
+/**
+\brief User timer
+
+The structure describes a user timer. It is linked into the list of all
+allocated timers and, while it is running, into a slot of the timer wheel.
+*/
 struct sTimeruData
 {
-    timer_t             timer;
-    tTimerArg           timerArgument;
-    tTimeruData*        pNextTimer;
-    tTimeruData*        pPrevTimer;
+    tTimerArg           timerArgument;  ///< Argument of the timer event
+    UINT64              expiryTick;     ///< Tick (ms of CLOCK_MONOTONIC) at which the timer expires
+    BOOL                fActive;        ///< Flag indicating whether the timer is running
+    tTimeruData**       ppSlot;         ///< Wheel slot the timer is linked into
+    tTimeruData*        pNextInSlot;    ///< Next timer in the same wheel slot
+    tTimeruData*        pPrevInSlot;    ///< Previous timer in the same wheel slot
+    tTimeruData*        pNextTimer;     ///< Next allocated timer
+    tTimeruData*        pPrevTimer;     ///< Previous allocated timer
 };
 
+/**
+\brief User timer instance
+
+The structure describes the instance of the user timer module.
+*/
 typedef struct
 {
-    pthread_t           processThread;
-    pthread_mutex_t     mutex;
-    tTimeruData*        pFirstTimer;
-    tTimeruData*        pLastTimer;
-    tTimeruData*        pCurrentTimer;
+    pthread_t           processThread;                  ///< Handle of the timer thread
+    pthread_mutex_t     mutex;                          ///< Mutex protecting the timer wheel
+    int                 timerFd;                        ///< timerfd waking up the timer thread
+    BOOL                fStop;                          ///< Flag indicating whether the timer thread shall be stopped
+    UINT64              currentTick;                    ///< Next tick to be processed by the wheel
+    UINT64              armedTick;                      ///< Tick the timerfd is armed for
+    UINT                activeCount;                    ///< Number of running timers
+    tTimeruData*        apRootSlot[TIMERU_WHEEL_ROOT_SIZE];                                 ///< Slots of the first wheel level
+    UINT32              aRootSlotUsed[TIMERU_WHEEL_ROOT_SIZE / 32];                         ///< Bitmap of non-empty slots of the first level
+    tTimeruData*        aapLevelSlot[TIMERU_WHEEL_LEVEL_COUNT][TIMERU_WHEEL_LEVEL_SIZE];    ///< Slots of the further wheel levels
+    tTimeruData*        pFirstTimer;                    ///< First allocated timer
 } tTimeruInstance;
 
 //------------------------------------------------------------------------------
@@ -108,12 +149,19 @@ static tTimeruInstance timeruInstance_g;
 //------------------------------------------------------------------------------
 // local function prototypes
 //------------------------------------------------------------------------------
-static void         cbTimer(const tTimeruData* pData_p);
+static void         cbTimer(tTimerHdl timerHdl_p, const tTimerArg* pArgument_p);
 static void*        processThread(void* pArgument_p);
 static void         addTimer(tTimeruData* pData_p);
 static void         removeTimer(tTimeruData* pData_p);
-static void         resetTimerList(void);
-static tTimeruData* getNextTimer(void);
+static UINT64       getCurrentTick(BOOL fRoundUp_p);
+static void         startTimer(tTimeruData* pData_p, ULONG timeInMs_p);
+static void         stopTimer(tTimeruData* pData_p);
+static void         insertTimer(tTimeruData* pData_p);
+static void         unlinkTimer(tTimeruData* pData_p);
+static void         cascadeLevel(UINT level_p);
+static void         processTick(void);
+static UINT64       getNextTick(void);
+static void         armTimerFd(UINT64 tick_p);
 
 //============================================================================//
 //            P U B L I C   F U N C T I O N S                                 //
@@ -132,17 +180,26 @@ The function initializes the user timer module.
 //------------------------------------------------------------------------------
 tOplkError timeru_init(void)
 {
-    struct sched_param  schedParam;
     int                 retVal;
 
     // reset instance structure
-    timeruInstance_g.processThread = 0;
-    timeruInstance_g.pFirstTimer = NULL;
-    timeruInstance_g.pLastTimer = NULL;
+    OPLK_MEMSET(&timeruInstance_g, 0, sizeof(timeruInstance_g));
+    timeruInstance_g.currentTick = getCurrentTick(FALSE);
+    timeruInstance_g.armedTick = TIMERU_TICK_NONE;
+
+    timeruInstance_g.timerFd = timerfd_create(CLOCK_MONOTONIC, 0);
+    if (timeruInstance_g.timerFd < 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() couldn't create timerfd! (%s)\n",
+                              __func__,
+                              strerror(errno));
+        return kErrorNoResource;
+    }
 
     if (pthread_mutex_init(&timeruInstance_g.mutex, NULL) != 0)
     {
         DEBUG_LVL_ERROR_TRACE("%s() couldn't init mutex!\n", __func__);
+        close(timeruInstance_g.timerFd);
         return kErrorNoResource;
     }
 
@@ -156,22 +213,21 @@ tOplkError timeru_init(void)
                               __func__,
                               retVal);
         pthread_mutex_destroy(&timeruInstance_g.mutex);
+        close(timeruInstance_g.timerFd);
+        timeruInstance_g.processThread = 0;
         return kErrorNoResource;
     }
 
-    schedParam.sched_priority = CONFIG_THREAD_PRIORITY_LOW;
-    if (pthread_setschedparam(timeruInstance_g.processThread,
-                              SCHED_RR,
-                              &schedParam) != 0)
+    if (target_registerThread(kOplkThreadRoleTimerUser,
+                              timeruInstance_g.processThread,
+                              kOplkThreadPolicyRr,
+                              CONFIG_THREAD_PRIORITY_LOW,
+                              "oplk-timeru") != kErrorOk)
     {
         DEBUG_LVL_ERROR_TRACE("%s() couldn't set thread scheduling parameters!\n",
                               __func__);
     }
 
-#if (defined(__GLIBC__) && (__GLIBC__ >= 2) && (__GLIBC_MINOR__ >= 12))
-    pthread_setname_np(timeruInstance_g.processThread, "oplk-timeru");
-#endif
-
     return kErrorOk;
 }
 
@@ -188,32 +244,37 @@ The function shuts down the user timer instance.
 //------------------------------------------------------------------------------
 tOplkError timeru_exit(void)
 {
-    tTimeruData*    pTimer;
+    tTimeruData*        pTimer;
+    struct itimerspec   wakeup;
 
     /* Check if the processThread exist */
     if (timeruInstance_g.processThread != 0)
     {
-        /* cancel thread */
-        pthread_cancel(timeruInstance_g.processThread);
+        /* let the thread wake up immediately and exit */
+        pthread_mutex_lock(&timeruInstance_g.mutex);
+        timeruInstance_g.fStop = TRUE;
+        OPLK_MEMSET(&wakeup, 0, sizeof(wakeup));
+        wakeup.it_value.tv_nsec = 1;
+        timerfd_settime(timeruInstance_g.timerFd, 0, &wakeup, NULL);
+        pthread_mutex_unlock(&timeruInstance_g.mutex);
         DEBUG_LVL_TIMERU_TRACE("%s() Waiting for thread to exit...\n", __func__);
 
         /* wait for thread to terminate */
+        target_unregisterThread(kOplkThreadRoleTimerUser, timeruInstance_g.processThread);
         pthread_join(timeruInstance_g.processThread, NULL);
         DEBUG_LVL_TIMERU_TRACE("%s()Thread exited\n", __func__);
+        timeruInstance_g.processThread = 0;
     }
 
     /* free up timer list */
-    resetTimerList();
-    while ((pTimer = getNextTimer()) != NULL)
+    while ((pTimer = timeruInstance_g.pFirstTimer) != NULL)
     {
         removeTimer(pTimer);
         OPLK_FREE(pTimer);
     }
 
     pthread_mutex_destroy(&timeruInstance_g.mutex);
-
-    timeruInstance_g.pFirstTimer = NULL;
-    timeruInstance_g.pLastTimer = NULL;
+    close(timeruInstance_g.timerFd);
 
     return kErrorOk;
 }
@@ -257,10 +318,7 @@ tOplkError timeru_setTimer(tTimerHdl* pTimerHdl_p,
                            ULONG timeInMs_p,
                            const tTimerArg* pArgument_p)
 {
-    tTimeruData*        pData;
-    struct itimerspec   relTime;
-    struct itimerspec   curTime;
-    struct sigevent     sev;
+    tTimeruData*    pData;
 
     if (pTimerHdl_p == NULL)
         return kErrorTimerInvalidHandle;
@@ -270,43 +328,17 @@ tOplkError timeru_setTimer(tTimerHdl* pTimerHdl_p,
         return kErrorNoResource;
 
     OPLK_MEMCPY(&pData->timerArgument, pArgument_p, sizeof(tTimerArg));
-
-    addTimer(pData);
-
-    sev.sigev_notify = SIGEV_SIGNAL;
-    sev.sigev_signo = SIGRTMIN;
-    sev.sigev_value.sival_ptr = pData;
-    if (timer_create(CLOCK_MONOTONIC, &sev, &pData->timer) == -1)
-    {
-        DEBUG_LVL_ERROR_TRACE("%s() Error creating timer!\n", __func__);
-        OPLK_FREE(pData);
-        return kErrorNoResource;
-    }
-
-    if (timeInMs_p >= 1000)
-    {
-        relTime.it_value.tv_sec = (timeInMs_p / 1000);
-        relTime.it_value.tv_nsec = (timeInMs_p % 1000) * 1000000;
-    }
-    else
-    {
-        relTime.it_value.tv_sec = 0;
-        relTime.it_value.tv_nsec = timeInMs_p * 1000000;
-    }
+    pData->fActive = FALSE;
 
     DEBUG_LVL_TIMERU_TRACE("%s() Set timer: %p, timeInMs_p=%ld\n",
                            __func__,
                            (void*)pData,
                            timeInMs_p);
 
-    relTime.it_interval.tv_sec = 0;
-    relTime.it_interval.tv_nsec = 0;
-
-    if (timer_settime(pData->timer, 0, &relTime, &curTime) < 0)
-    {
-        DEBUG_LVL_ERROR_TRACE("%s() Error timer_settime!\n", __func__);
-        return kErrorTimerNoTimerCreated;
-    }
+    pthread_mutex_lock(&timeruInstance_g.mutex);
+    addTimer(pData);
+    startTimer(pData, timeInMs_p);
+    pthread_mutex_unlock(&timeruInstance_g.mutex);
 
     *pTimerHdl_p = (tTimerHdl)pData;
     return kErrorOk;
@@ -332,8 +364,7 @@ tOplkError timeru_modifyTimer(tTimerHdl* pTimerHdl_p,
                               ULONG timeInMs_p,
                               const tTimerArg* pArgument_p)
 {
-    tTimeruData*        pData;
-    struct itimerspec   relTime, curTime;
+    tTimeruData*    pData;
 
     if (pTimerHdl_p == NULL)
         return kErrorTimerInvalidHandle;
@@ -344,36 +375,18 @@ tOplkError timeru_modifyTimer(tTimerHdl* pTimerHdl_p,
 
     pData = (tTimeruData*)*pTimerHdl_p;
 
-    if (timeInMs_p >= 1000)
-    {
-        relTime.it_value.tv_sec = (timeInMs_p / 1000);
-        relTime.it_value.tv_nsec = (timeInMs_p % 1000) * 1000000;
-    }
-    else
-    {
-        relTime.it_value.tv_sec = 0;
-        relTime.it_value.tv_nsec = timeInMs_p * 1000000;
-    }
-
     DEBUG_LVL_TIMERU_TRACE("%s() Modify timer:%08x timeInMs_p=%ld\n",
                            __func__,
                            *pTimerHdl_p,
                            timeInMs_p);
 
-    relTime.it_interval.tv_sec = 0;
-    relTime.it_interval.tv_nsec = 0;
-    if (timer_settime(pData->timer, 0, &relTime, &curTime) != 0)
-    {
-        DEBUG_LVL_ERROR_TRACE("%s() Error timer_settime!\n", __func__);
-        return kErrorTimerNoTimerCreated;
-    }
-
-    // copy the TimerArg after the timer is restarted,
-    // so that a timer occurred immediately before timer_settime
-    // won't use the new timerArg and
-    // therefore the old timer cannot be distinguished from the new one.
-    // But if the new timer is too fast, it may get lost.
+    // An expiry which has already been taken from the wheel but not yet been
+    // posted still carries the old argument, as the argument is copied when
+    // the timer expires.
+    pthread_mutex_lock(&timeruInstance_g.mutex);
     OPLK_MEMCPY(&pData->timerArgument, pArgument_p, sizeof(tTimerArg));
+    startTimer(pData, timeInMs_p);
+    pthread_mutex_unlock(&timeruInstance_g.mutex);
 
     return kErrorOk;
 }
@@ -406,8 +419,11 @@ tOplkError timeru_deleteTimer(tTimerHdl* pTimerHdl_p)
 
     pData = (tTimeruData*)*pTimerHdl_p;
 
-    timer_delete(pData->timer);
+    pthread_mutex_lock(&timeruInstance_g.mutex);
+    stopTimer(pData);
     removeTimer(pData);
+    pthread_mutex_unlock(&timeruInstance_g.mutex);
+
     OPLK_FREE(pData);
 
     // uninitialize handle
@@ -432,7 +448,7 @@ This function checks if a timer is active (is running).
 BOOL timeru_isActive(tTimerHdl timerHdl_p)
 {
     const tTimeruData*  pData;
-    struct itimerspec   remaining;
+    BOOL                fActive;
 
     // check handle itself, i.e. was the handle initialized before
     if (timerHdl_p == 0)
@@ -441,13 +457,11 @@ BOOL timeru_isActive(tTimerHdl timerHdl_p)
     }
     pData = (const tTimeruData*)timerHdl_p;
 
-    // check if timer is running
-    timer_gettime(pData->timer, &remaining);
+    pthread_mutex_lock(&timeruInstance_g.mutex);
+    fActive = pData->fActive;
+    pthread_mutex_unlock(&timeruInstance_g.mutex);
 
-    if ((remaining.it_value.tv_sec == 0) && (remaining.it_value.tv_nsec == 0))
-        return FALSE;
-    else
-        return TRUE;
+    return fActive;
 }
 
 //============================================================================//
@@ -461,7 +475,9 @@ BOOL timeru_isActive(tTimerHdl timerHdl_p)
 \brief  Timer thread function
 
 This function implements the timer thread function which will be started as
-thread and is responsible for processing expired timers.
+thread and is responsible for processing expired timers. It waits on the
+timerfd, advances the timer wheel up to the current time and re-arms the
+timerfd for the next due slot.
 
 \param[in,out]  pArgument_p         Thread argument. Not used!
 
@@ -470,36 +486,49 @@ thread and is responsible for processing expired timers.
 //------------------------------------------------------------------------------
 static void* processThread(void* pArgument_p)
 {
-    tTimeruData*    pTimer;
-    sigset_t        awaitedSignal;
-    siginfo_t       signalInfo;
+    UINT64  expirations;
+    UINT64  now;
+    UINT64  nextTick;
 
     UNUSED_PARAMETER(pArgument_p);
 
     DEBUG_LVL_TIMERU_TRACE("%s() ThreadId:%d\n", __func__, syscall(SYS_gettid));
 
-    sigemptyset(&awaitedSignal);
-    sigaddset(&awaitedSignal, SIGRTMIN);
-    pthread_sigmask(SIG_BLOCK, &awaitedSignal, NULL);
+    pthread_mutex_lock(&timeruInstance_g.mutex);
 
-    /* loop forever until thread will be canceled */
-    while (1)
+    while (!timeruInstance_g.fStop)
     {
-        if (sigwaitinfo(&awaitedSignal, &signalInfo) > 0)
+        pthread_mutex_unlock(&timeruInstance_g.mutex);
+
+        if (read(timeruInstance_g.timerFd, &expirations, sizeof(expirations)) < 0)
         {
-            pTimer = (tTimeruData*)signalInfo.si_value.sival_ptr;
-            if (pTimer != NULL)
-                /* call callback function of timer */
-                cbTimer(pTimer);
-            else
+            if (errno != EINTR)
             {
-                DEBUG_LVL_ERROR_TRACE("%s() sival_ptr==NULL code=%d\n",
+                DEBUG_LVL_ERROR_TRACE("%s() timerfd read failed! (%s)\n",
                                       __func__,
-                                      signalInfo.si_code);
+                                      strerror(errno));
             }
         }
+
+        pthread_mutex_lock(&timeruInstance_g.mutex);
+        timeruInstance_g.armedTick = TIMERU_TICK_NONE;
+
+        now = getCurrentTick(FALSE);
+        while (!timeruInstance_g.fStop && (timeruInstance_g.currentTick <= now))
+        {
+            processTick();
+
+            // skip empty slots up to the next slot to be processed
+            nextTick = getNextTick();
+            timeruInstance_g.currentTick = (nextTick > now) ? (now + 1) : nextTick;
+        }
+
+        if (!timeruInstance_g.fStop)
+            armTimerFd(getNextTick());
     }
 
+    pthread_mutex_unlock(&timeruInstance_g.mutex);
+
     DEBUG_LVL_TIMERU_TRACE("%s() Exiting!\n", __func__);
     return NULL;
 }
@@ -508,25 +537,26 @@ static void* processThread(void* pArgument_p)
 /**
 \brief  Timer callback function
 
-This function is registered if a timer is started and therefore will be called
-by the timer when it expires.
+This function is called by the timer thread for every expired timer and posts
+the timer event.
 
-\param[in]      pData_p             The user defined parameter supplied when starting
+\param[in]      timerHdl_p          Handle of the expired timer.
+\param[in]      pArgument_p         The user defined parameter supplied when starting
                                     the timer.
 */
 //------------------------------------------------------------------------------
-static void cbTimer(const tTimeruData* pData_p)
+static void cbTimer(tTimerHdl timerHdl_p, const tTimerArg* pArgument_p)
 {
     tEvent          event;
     tTimerEventArg  timerEventArg;
 
     // call event function
-    timerEventArg.timerHdl.handle = (tTimerHdl)pData_p;
+    timerEventArg.timerHdl.handle = timerHdl_p;
     OPLK_MEMCPY(&timerEventArg.argument,
-                &pData_p->timerArgument.argument,
+                &pArgument_p->argument,
                 sizeof(timerEventArg.argument));
 
-    event.eventSink = pData_p->timerArgument.eventSink;
+    event.eventSink = pArgument_p->eventSink;
     event.eventType = kEventTypeTimer;
     OPLK_MEMSET(&event.netTime, 0x00, sizeof(tNetTime));
     event.eventArg.pEventArg = &timerEventArg;
@@ -539,103 +569,350 @@ static void cbTimer(const tTimeruData* pData_p)
 /**
 \brief  Add a timer to the timer list
 
-This function adds a new timer to the timer list.
+This function adds a new timer to the list of allocated timers. The caller
+must hold the instance mutex.
 
 \param[in,out]  pData_p             Pointer to the timer structure.
 */
 //------------------------------------------------------------------------------
 static void addTimer(tTimeruData* pData_p)
 {
-    tTimeruData*    pTimerData;
+    pData_p->pPrevTimer = NULL;
+    pData_p->pNextTimer = timeruInstance_g.pFirstTimer;
+    if (timeruInstance_g.pFirstTimer != NULL)
+        timeruInstance_g.pFirstTimer->pPrevTimer = pData_p;
+    timeruInstance_g.pFirstTimer = pData_p;
+}
 
-    pthread_mutex_lock(&timeruInstance_g.mutex);
+//------------------------------------------------------------------------------
+/**
+\brief  Remove a timer from the timer list
+
+This function removes a timer from the list of allocated timers. The caller
+must hold the instance mutex.
+
+\param[in,out]  pData_p             Pointer to the timer structure.
+*/
+//------------------------------------------------------------------------------
+static void removeTimer(tTimeruData* pData_p)
+{
+    if (pData_p->pPrevTimer == NULL)
+        timeruInstance_g.pFirstTimer = pData_p->pNextTimer;
+    else
+        pData_p->pPrevTimer->pNextTimer = pData_p->pNextTimer;
+
+    if (pData_p->pNextTimer != NULL)
+        pData_p->pNextTimer->pPrevTimer = pData_p->pPrevTimer;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get current tick
+
+This function returns the current time of CLOCK_MONOTONIC in milliseconds,
+which is the tick unit of the timer wheel.
+
+\param[in]      fRoundUp_p          If TRUE, a partial millisecond is rounded up.
+
+\return The function returns the current tick.
+*/
+//------------------------------------------------------------------------------
+static UINT64 getCurrentTick(BOOL fRoundUp_p)
+{
+    struct timespec currentTime;
+    UINT64          tick;
+
+    clock_gettime(CLOCK_MONOTONIC, &currentTime);
+
+    tick = ((UINT64)currentTime.tv_sec * 1000) + (currentTime.tv_nsec / 1000000);
+    if (fRoundUp_p && ((currentTime.tv_nsec % 1000000) != 0))
+        tick++;
 
-    if (timeruInstance_g.pFirstTimer == NULL)
+    return tick;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Start a timer
+
+This function (re)starts a timer with the given timeout. The expiry tick is
+rounded up, so that the timer never expires before the timeout elapsed. The
+caller must hold the instance mutex.
+
+\param[in,out]  pData_p             Pointer to the timer structure.
+\param[in]      timeInMs_p          Timeout in milliseconds.
+*/
+//------------------------------------------------------------------------------
+static void startTimer(tTimeruData* pData_p, ULONG timeInMs_p)
+{
+    UINT64  nextTick;
+
+    stopTimer(pData_p);
+
+    // an empty wheel may lag behind the current time while the thread sleeps
+    if (timeruInstance_g.activeCount == 0)
+        timeruInstance_g.currentTick = getCurrentTick(FALSE);
+
+    pData_p->expiryTick = getCurrentTick(TRUE) + timeInMs_p;
+    insertTimer(pData_p);
+    pData_p->fActive = TRUE;
+    timeruInstance_g.activeCount++;
+
+    // wake up the timer thread earlier if the new timer is due first
+    nextTick = getNextTick();
+    if (nextTick < timeruInstance_g.armedTick)
+        armTimerFd(nextTick);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stop a timer
+
+This function removes a timer from the timer wheel if it is running. The
+caller must hold the instance mutex.
+
+\param[in,out]  pData_p             Pointer to the timer structure.
+*/
+//------------------------------------------------------------------------------
+static void stopTimer(tTimeruData* pData_p)
+{
+    if (!pData_p->fActive)
+        return;
+
+    unlinkTimer(pData_p);
+    pData_p->fActive = FALSE;
+    timeruInstance_g.activeCount--;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Insert a timer into the timer wheel
+
+This function links a timer into the wheel slot of its expiry tick. Timers
+which are already overdue are linked into the slot of the current tick.
+
+\param[in,out]  pData_p             Pointer to the timer structure.
+*/
+//------------------------------------------------------------------------------
+static void insertTimer(tTimeruData* pData_p)
+{
+    UINT64          currentTick = timeruInstance_g.currentTick;
+    UINT64          expiryTick = pData_p->expiryTick;
+    UINT64          delta;
+    UINT            level;
+    UINT            index;
+    tTimeruData**   ppSlot;
+
+    if (expiryTick < currentTick)
+        expiryTick = currentTick;
+
+    delta = expiryTick - currentTick;
+    if (delta < TIMERU_WHEEL_ROOT_SIZE)
     {
-        timeruInstance_g.pFirstTimer = pData_p;
-        timeruInstance_g.pLastTimer = pData_p;
-        pData_p->pPrevTimer = NULL;
-        pData_p->pNextTimer = NULL;
+        index = (UINT)(expiryTick & TIMERU_WHEEL_ROOT_MASK);
+        ppSlot = &timeruInstance_g.apRootSlot[index];
+        timeruInstance_g.aRootSlotUsed[index / 32] |= (UINT32)1 << (index % 32);
     }
     else
     {
-        pTimerData = timeruInstance_g.pLastTimer;
-        pTimerData->pNextTimer = pData_p;
-        pData_p->pPrevTimer = pTimerData;
-        pData_p->pNextTimer = NULL;
-        timeruInstance_g.pLastTimer = pData_p;
+        // timeouts beyond the range of the wheel are cascaded again from the last level
+        if (delta >= TIMERU_WHEEL_MAX_TICKS)
+            expiryTick = currentTick + TIMERU_WHEEL_MAX_TICKS - 1;
+
+        for (level = 0; level < TIMERU_WHEEL_LEVEL_COUNT - 1; level++)
+        {
+            if (delta < ((UINT64)1 << TIMERU_WHEEL_LEVEL_SHIFT(level + 1)))
+                break;
+        }
+
+        index = (UINT)((expiryTick >> TIMERU_WHEEL_LEVEL_SHIFT(level)) & TIMERU_WHEEL_LEVEL_MASK);
+        ppSlot = &timeruInstance_g.aapLevelSlot[level][index];
     }
 
-    pthread_mutex_unlock(&timeruInstance_g.mutex);
+    pData_p->ppSlot = ppSlot;
+    pData_p->pPrevInSlot = NULL;
+    pData_p->pNextInSlot = *ppSlot;
+    if (*ppSlot != NULL)
+        (*ppSlot)->pPrevInSlot = pData_p;
+    *ppSlot = pData_p;
 }
 
 //------------------------------------------------------------------------------
 /**
-\brief  Remove a timer from the timer list
+\brief  Unlink a timer from the timer wheel
 
-This function removes a new timer from the timer list.
+This function removes a timer from its wheel slot.
 
 \param[in,out]  pData_p             Pointer to the timer structure.
 */
 //------------------------------------------------------------------------------
-static void removeTimer(tTimeruData* pData_p)
+static void unlinkTimer(tTimeruData* pData_p)
 {
-    tTimeruData*    pTimerData;
+    tTimeruData**   ppSlot = pData_p->ppSlot;
+    UINT            index;
 
-    pthread_mutex_lock(&timeruInstance_g.mutex);
+    if (pData_p->pPrevInSlot == NULL)
+        *ppSlot = pData_p->pNextInSlot;
+    else
+        pData_p->pPrevInSlot->pNextInSlot = pData_p->pNextInSlot;
 
-    if (pData_p->pPrevTimer == NULL)          // first one
+    if (pData_p->pNextInSlot != NULL)
+        pData_p->pNextInSlot->pPrevInSlot = pData_p->pPrevInSlot;
+
+    if ((*ppSlot == NULL) &&
+        (ppSlot >= &timeruInstance_g.apRootSlot[0]) &&
+        (ppSlot < &timeruInstance_g.apRootSlot[TIMERU_WHEEL_ROOT_SIZE]))
     {
-        timeruInstance_g.pFirstTimer = pData_p->pNextTimer;
-        pTimerData = pData_p->pNextTimer;
-        if (pTimerData != NULL)
-            pTimerData->pPrevTimer = NULL;
+        index = (UINT)(ppSlot - &timeruInstance_g.apRootSlot[0]);
+        timeruInstance_g.aRootSlotUsed[index / 32] &= ~((UINT32)1 << (index % 32));
     }
-    else if (pData_p->pNextTimer == NULL)     // last one
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Cascade timers of a wheel level
+
+This function moves all timers of the current slot of the given level to the
+levels below. If the slot index wrapped around, the next level is cascaded
+as well.
+
+\param[in]      level_p             Wheel level to be cascaded.
+*/
+//------------------------------------------------------------------------------
+static void cascadeLevel(UINT level_p)
+{
+    UINT            index;
+    tTimeruData*    pTimer;
+    tTimeruData*    pNextTimer;
+
+    index = (UINT)((timeruInstance_g.currentTick >> TIMERU_WHEEL_LEVEL_SHIFT(level_p)) &
+                   TIMERU_WHEEL_LEVEL_MASK);
+
+    // detach the slot first, timers may be inserted into the same slot again
+    pTimer = timeruInstance_g.aapLevelSlot[level_p][index];
+    timeruInstance_g.aapLevelSlot[level_p][index] = NULL;
+
+    while (pTimer != NULL)
     {
-        timeruInstance_g.pLastTimer = pData_p->pPrevTimer;
-        pTimerData = pData_p->pPrevTimer;
-        pTimerData->pNextTimer = NULL;
+        pNextTimer = pTimer->pNextInSlot;
+        insertTimer(pTimer);
+        pTimer = pNextTimer;
     }
-    else
+
+    if ((index == 0) && (level_p + 1 < TIMERU_WHEEL_LEVEL_COUNT))
+        cascadeLevel(level_p + 1);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Process current tick of the timer wheel
+
+This function cascades the higher wheel levels if the first level wrapped
+around and posts the timer events of all timers of the current slot. The
+mutex is released while an event is posted. The caller must hold the instance
+mutex.
+*/
+//------------------------------------------------------------------------------
+static void processTick(void)
+{
+    UINT            index;
+    tTimeruData*    pTimer;
+    tTimerArg       timerArgument;
+
+    index = (UINT)(timeruInstance_g.currentTick & TIMERU_WHEEL_ROOT_MASK);
+    if (index == 0)
+        cascadeLevel(0);
+
+    while ((pTimer = timeruInstance_g.apRootSlot[index]) != NULL)
     {
-        pData_p->pPrevTimer->pNextTimer = pData_p->pNextTimer;
-        pData_p->pNextTimer->pPrevTimer = pData_p->pPrevTimer;
+        stopTimer(pTimer);
+
+        // post a copy of the argument, the timer may be deleted while the
+        // mutex is released
+        OPLK_MEMCPY(&timerArgument, &pTimer->timerArgument, sizeof(tTimerArg));
+        pthread_mutex_unlock(&timeruInstance_g.mutex);
+        cbTimer((tTimerHdl)pTimer, &timerArgument);
+        pthread_mutex_lock(&timeruInstance_g.mutex);
     }
 
-    pthread_mutex_unlock(&timeruInstance_g.mutex);
+    timeruInstance_g.currentTick++;
 }
 
 //------------------------------------------------------------------------------
 /**
-\brief  Reset the timer list
+\brief  Get next tick to be processed
 
-This function resets the timer list.
+This function determines the next tick at which the timer wheel must be
+processed. This is either the next non-empty slot of the first level or the
+next wrap-around of the first level, where the higher levels are cascaded.
+
+\return The function returns the next tick to be processed or
+        TIMERU_TICK_NONE if no timer is running.
 */
 //------------------------------------------------------------------------------
-static void resetTimerList(void)
+static UINT64 getNextTick(void)
 {
-    timeruInstance_g.pCurrentTimer = timeruInstance_g.pFirstTimer;
+    UINT64  currentTick = timeruInstance_g.currentTick;
+    UINT    startIndex;
+    UINT    word;
+    UINT    bit;
+    UINT32  used;
+
+    if (timeruInstance_g.activeCount == 0)
+        return TIMERU_TICK_NONE;
+
+    // the first tick of a rotation cascades the higher levels
+    startIndex = (UINT)(currentTick & TIMERU_WHEEL_ROOT_MASK);
+    if (startIndex == 0)
+        return currentTick;
+
+    for (word = startIndex / 32; word < (TIMERU_WHEEL_ROOT_SIZE / 32); word++)
+    {
+        used = timeruInstance_g.aRootSlotUsed[word];
+        if (word == startIndex / 32)
+            used &= ~(((UINT32)1 << (startIndex % 32)) - 1);
+
+        if (used == 0)
+            continue;
+
+        for (bit = 0; (used & ((UINT32)1 << bit)) == 0; bit++)
+            ;
+
+        return currentTick + ((word * 32) + bit) - startIndex;
+    }
+
+    return (currentTick | TIMERU_WHEEL_ROOT_MASK) + 1;
 }
 
 //------------------------------------------------------------------------------
 /**
-\brief  Get next timer from the list
+\brief  Arm the timerfd
 
-This function gets the next timer from the timer list.
+This function arms the timerfd for the given tick or disarms it.
 
-\return     The function returns a pointer to the next timer in the timer list.
+\param[in]      tick_p              Tick at which the timer thread shall wake up,
+                                    or TIMERU_TICK_NONE to disarm the timerfd.
 */
 //------------------------------------------------------------------------------
-static tTimeruData* getNextTimer(void)
+static void armTimerFd(UINT64 tick_p)
 {
-    tTimeruData*    pTimer;
+    struct itimerspec   expiryTime;
 
-    pTimer = timeruInstance_g.pCurrentTimer;
-    if (pTimer != NULL)
-        timeruInstance_g.pCurrentTimer = pTimer->pNextTimer;
+    OPLK_MEMSET(&expiryTime, 0, sizeof(expiryTime));
+    if (tick_p != TIMERU_TICK_NONE)
+    {
+        expiryTime.it_value.tv_sec = (time_t)(tick_p / 1000);
+        expiryTime.it_value.tv_nsec = (long)(tick_p % 1000) * 1000000;
+    }
+
+    if (timerfd_settime(timeruInstance_g.timerFd, TFD_TIMER_ABSTIME, &expiryTime, NULL) != 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() Error timerfd_settime! (%s)\n",
+                              __func__,
+                              strerror(errno));
+    }
 
-    return pTimer;
+    timeruInstance_g.armedTick = tick_p;
 }
 
 /// \}
@@ -0,0 +1,188 @@
+/**
+********************************************************************************
+\file   stubs.c
+
+\brief  Stubs for the unit tests of the configuration manager
+
+The file contains the stubs of the modules used by the configuration manager.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2017, B&R Industrial Automation GmbH
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <common/oplkinc.h>
+#include <user/sdocom.h>
+#include <user/obdu.h>
+#include <user/identu.h>
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define TEST_CONF_DATE              0x3124      // expected configuration date (0x1F26)
+#define TEST_CONF_TIME              0x03735955  // expected configuration time (0x1F27)
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+tOplkError identu_getIdentResponse(UINT nodeId_p,
+                                   const tIdentResponse** ppIdentResponse_p)
+{
+    UNUSED_PARAMETER(nodeId_p);
+    *ppIdentResponse_p = NULL;
+    return kErrorOk;
+}
+
+tOplkError obdu_readEntry(UINT index_p,
+                          UINT subIndex_p,
+                          void* pDstData_p,
+                          tObdSize* pSize_p)
+{
+    UNUSED_PARAMETER(subIndex_p);
+
+    if (*pSize_p < sizeof(UINT32))
+        return kErrorObdValueLengthError;
+
+    switch (index_p)
+    {
+        case 0x1F26:
+            *(UINT32*)pDstData_p = TEST_CONF_DATE;
+            break;
+
+        case 0x1F27:
+            *(UINT32*)pDstData_p = TEST_CONF_TIME;
+            break;
+
+        default:
+            return kErrorObdIndexNotExist;
+    }
+
+    *pSize_p = sizeof(UINT32);
+    return kErrorOk;
+}
+
+tOplkError obdu_readEntryToLe(UINT index_p,
+                              UINT subIndex_p,
+                              void* pDstData_p,
+                              tObdSize* pSize_p)
+{
+    UNUSED_PARAMETER(index_p);
+    UNUSED_PARAMETER(subIndex_p);
+    UNUSED_PARAMETER(pDstData_p);
+    UNUSED_PARAMETER(pSize_p);
+    return kErrorObdIndexNotExist;
+}
+
+tOplkError obdu_defineVar(const tVarParam* pVarParam_p)
+{
+    UNUSED_PARAMETER(pVarParam_p);
+    return kErrorOk;
+}
+
+void* obdu_getObjectDataPtr(UINT index_p, UINT subIndex_p)
+{
+    UNUSED_PARAMETER(index_p);
+    UNUSED_PARAMETER(subIndex_p);
+    return NULL;
+}
+
+tObdSize obdu_getDataSize(UINT index_p, UINT subIndex_p)
+{
+    UNUSED_PARAMETER(index_p);
+    UNUSED_PARAMETER(subIndex_p);
+    return 0;
+}
+
+tOplkError sdocom_defineConnection(tSdoComConHdl* pSdoComConHdl_p,
+                                   UINT targetNodeId_p,
+                                   tSdoType sdoType_p)
+{
+    UNUSED_PARAMETER(pSdoComConHdl_p);
+    UNUSED_PARAMETER(targetNodeId_p);
+    UNUSED_PARAMETER(sdoType_p);
+    return kErrorSdoComNoFreeHandle;
+}
+
+tOplkError sdocom_initTransferByIndex(const tSdoComTransParamByIndex* pSdoComTransParam_p)
+{
+    UNUSED_PARAMETER(pSdoComTransParam_p);
+    return kErrorSdoComInvalidHandle;
+}
+
+tOplkError sdocom_undefineConnection(tSdoComConHdl sdoComConHdl_p)
+{
+    UNUSED_PARAMETER(sdoComConHdl_p);
+    return kErrorOk;
+}
+
+tOplkError sdocom_abortTransfer(tSdoComConHdl sdoComConHdl_p,
+                                UINT32 abortCode_p)
+{
+    UNUSED_PARAMETER(sdoComConHdl_p);
+    UNUSED_PARAMETER(abortCode_p);
+    return kErrorOk;
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
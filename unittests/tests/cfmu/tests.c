@@ -0,0 +1,367 @@
+/**
+********************************************************************************
+\file   tests.c
+
+\brief  Unit tests for the differential download of the configuration manager
+
+The file contains the unit tests for the selection of the ConciseDCF entries
+which are downloaded by a differential download.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2017, B&R Industrial Automation GmbH
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <CUnit/CUnit.h>
+
+#include <user/cfmu.c>
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define TEST_NODE_ID                1
+#define TEST_CONF_DATE              0x3124      // reported by the stub of obdu_readEntry()
+#define TEST_CONF_TIME              0x03735955  // reported by the stub of obdu_readEntry()
+#define TEST_MAX_ENTRIES            16
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+typedef struct
+{
+    UINT16      index;
+    UINT8       subIndex;
+    UINT8       size;
+    UINT64      value;
+} tTestEntry;
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static BOOL  prepareDownload(const tTestEntry* paEntries_p,
+                             UINT count_p,
+                             BOOL fDifferential_p);
+static BOOL  isEntrySent(UINT entryNum_p);
+static UINT  getSentEntryCount(void);
+static void  cleanupNodeInfo(void);
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+
+// ConciseDCF in the order of openCONFIGURATOR, which disables the mappings
+// before the PDOs are configured
+static const tTestEntry aDcf_l[] =
+{
+    { 0x1006, 0x00, 4, 10000 },                     // 0
+    { 0x1600, 0x00, 1, 0 },                         // 1: disable RPDO mapping
+    { 0x1A00, 0x00, 1, 0 },                         // 2: disable TPDO mapping
+    { 0x1400, 0x01, 1, 0xF0 },                      // 3
+    { 0x1800, 0x01, 1, 0x00 },                      // 4
+    { 0x1600, 0x01, 8, 0x0008000000016200ULL },     // 5
+    { 0x1A00, 0x01, 8, 0x0008000000016000ULL },     // 6
+    { 0x1600, 0x00, 1, 1 },                         // 7: enable RPDO mapping
+    { 0x1A00, 0x00, 1, 1 },                         // 8: enable TPDO mapping
+    { 0x2000, 0x01, 4, 0x12345678 },                // 9
+};
+
+// ConciseDCF which writes the RPDO communication parameter before the mapping
+// is disabled
+static const tTestEntry aDcfCommFirst_l[] =
+{
+    { 0x1006, 0x00, 4, 10000 },                     // 0
+    { 0x1400, 0x01, 1, 0xF0 },                      // 1
+    { 0x1600, 0x00, 1, 0 },                         // 2: disable RPDO mapping
+    { 0x1600, 0x01, 8, 0x0008000000016200ULL },     // 3
+    { 0x1600, 0x00, 1, 1 },                         // 4: enable RPDO mapping
+};
+
+static tCfmNodeInfo     nodeInfo_l;
+static UINT8            aDcfBuffer_l[TEST_MAX_ENTRIES * (CDC_OFFSET_DATA + 8)];
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test unchanged ConciseDCF
+
+The test checks that no entry is downloaded if the ConciseDCF is unchanged.
+*/
+//------------------------------------------------------------------------------
+void test_cfmu_diffUnchanged(void)
+{
+    CU_ASSERT_FALSE(prepareDownload(aDcf_l, tabentries(aDcf_l), FALSE));
+    CU_ASSERT_EQUAL(getSentEntryCount(), tabentries(aDcf_l));
+
+    CU_ASSERT_TRUE(prepareDownload(aDcf_l, tabentries(aDcf_l), TRUE));
+    CU_ASSERT_EQUAL(getSentEntryCount(), 0);
+
+    cleanupNodeInfo();
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test changed PDO mapping
+
+The test checks that a changed mapping entry is downloaded together with the
+writes which disable and enable the mapping.
+*/
+//------------------------------------------------------------------------------
+void test_cfmu_diffMapping(void)
+{
+    tTestEntry  aDcf[tabentries(aDcf_l)];
+
+    OPLK_MEMCPY(aDcf, aDcf_l, sizeof(aDcf));
+    aDcf[5].value = 0x0008000000026200ULL;
+
+    prepareDownload(aDcf_l, tabentries(aDcf_l), FALSE);
+    CU_ASSERT_TRUE(prepareDownload(aDcf, tabentries(aDcf), TRUE));
+
+    CU_ASSERT_EQUAL(getSentEntryCount(), 3);
+    CU_ASSERT_TRUE(isEntrySent(1));
+    CU_ASSERT_TRUE(isEntrySent(5));
+    CU_ASSERT_TRUE(isEntrySent(7));
+
+    cleanupNodeInfo();
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test changed PDO communication parameter
+
+The test checks that a changed communication parameter is downloaded together
+with the writes which disable and enable the corresponding mapping, because
+the CN rejects the communication parameter while the mapping is enabled.
+*/
+//------------------------------------------------------------------------------
+void test_cfmu_diffCommParam(void)
+{
+    tTestEntry  aDcf[tabentries(aDcf_l)];
+
+    OPLK_MEMCPY(aDcf, aDcf_l, sizeof(aDcf));
+    aDcf[4].value = 0x20;
+
+    prepareDownload(aDcf_l, tabentries(aDcf_l), FALSE);
+    CU_ASSERT_TRUE(prepareDownload(aDcf, tabentries(aDcf), TRUE));
+
+    CU_ASSERT_EQUAL(getSentEntryCount(), 3);
+    CU_ASSERT_TRUE(isEntrySent(2));
+    CU_ASSERT_TRUE(isEntrySent(4));
+    CU_ASSERT_TRUE(isEntrySent(8));
+
+    // the changes of both PDOs are combined
+    OPLK_MEMCPY(aDcf, aDcf_l, sizeof(aDcf));
+    aDcf[3].value = 0x20;
+    aDcf[9].value = 0;
+    CU_ASSERT_TRUE(prepareDownload(aDcf, tabentries(aDcf), TRUE));
+
+    CU_ASSERT_EQUAL(getSentEntryCount(), 7);
+    CU_ASSERT_TRUE(isEntrySent(1));
+    CU_ASSERT_TRUE(isEntrySent(2));
+    CU_ASSERT_TRUE(isEntrySent(3));
+    CU_ASSERT_TRUE(isEntrySent(4));
+    CU_ASSERT_TRUE(isEntrySent(7));
+    CU_ASSERT_TRUE(isEntrySent(8));
+    CU_ASSERT_TRUE(isEntrySent(9));
+
+    cleanupNodeInfo();
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test PDO communication parameter written while enabled
+
+The test checks that the complete ConciseDCF is downloaded if it writes a
+changed communication parameter before it disables the mapping.
+*/
+//------------------------------------------------------------------------------
+void test_cfmu_diffCommParamEnabled(void)
+{
+    tTestEntry  aDcf[tabentries(aDcfCommFirst_l)];
+
+    OPLK_MEMCPY(aDcf, aDcfCommFirst_l, sizeof(aDcf));
+
+    prepareDownload(aDcf, tabentries(aDcf), FALSE);
+
+    // other changes are downloaded differentially
+    aDcf[3].value = 0x0008000000026200ULL;
+    CU_ASSERT_TRUE(prepareDownload(aDcf, tabentries(aDcf), TRUE));
+    CU_ASSERT_EQUAL(getSentEntryCount(), 3);
+
+    aDcf[1].value = 0x20;
+    CU_ASSERT_FALSE(prepareDownload(aDcf, tabentries(aDcf), TRUE));
+    CU_ASSERT_EQUAL(getSentEntryCount(), tabentries(aDcf));
+
+    cleanupNodeInfo();
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test removed ConciseDCF entry
+
+The test checks that the complete ConciseDCF is downloaded if an entry of the
+stored configuration has been removed.
+*/
+//------------------------------------------------------------------------------
+void test_cfmu_diffRemovedEntry(void)
+{
+    prepareDownload(aDcf_l, tabentries(aDcf_l), FALSE);
+    CU_ASSERT_FALSE(prepareDownload(aDcf_l, tabentries(aDcf_l) - 1, TRUE));
+
+    cleanupNodeInfo();
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Prepare download of a ConciseDCF
+
+The function creates the ConciseDCF of the test node and prepares its download.
+The digest of the ConciseDCF is committed as if the CN had stored it.
+
+\param[in]      paEntries_p         Entries of the ConciseDCF.
+\param[in]      count_p             Number of entries.
+\param[in]      fDifferential_p     The CN reports the configuration of the
+                                    last download.
+
+\return The function returns the result of prepareDigest().
+*/
+//------------------------------------------------------------------------------
+static BOOL prepareDownload(const tTestEntry* paEntries_p,
+                            UINT count_p,
+                            BOOL fDifferential_p)
+{
+    tIdentResponse  identResponse;
+    UINT8*          pData = aDcfBuffer_l;
+    UINT            count;
+    BOOL            fResult;
+
+    for (count = 0; count < count_p; count++)
+    {
+        ami_setUint16Le(&pData[CDC_OFFSET_INDEX], paEntries_p[count].index);
+        ami_setUint8Le(&pData[CDC_OFFSET_SUBINDEX], paEntries_p[count].subIndex);
+        ami_setUint32Le(&pData[CDC_OFFSET_SIZE], paEntries_p[count].size);
+        OPLK_MEMSET(&pData[CDC_OFFSET_DATA], 0, 8);
+        ami_setUint64Le(&pData[CDC_OFFSET_DATA], paEntries_p[count].value);
+        pData += CDC_OFFSET_DATA + paEntries_p[count].size;
+    }
+
+    nodeInfo_l.eventCnProgress.nodeId = TEST_NODE_ID;
+    nodeInfo_l.pDataConciseDcf = aDcfBuffer_l;
+    nodeInfo_l.bytesRemaining = (UINT32)(pData - aDcfBuffer_l);
+    nodeInfo_l.entriesRemaining = count_p;
+    nodeInfo_l.fDoStore = TRUE;
+
+    OPLK_MEMSET(&identResponse, 0, sizeof(identResponse));
+    ami_setUint32Le(&identResponse.verifyConfigurationDateLe, TEST_CONF_DATE);
+    ami_setUint32Le(&identResponse.verifyConfigurationTimeLe, TEST_CONF_TIME);
+
+    fResult = prepareDigest(&nodeInfo_l, (fDifferential_p ? &identResponse : NULL));
+    commitDigest(&nodeInfo_l);
+
+    return fResult;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Check whether entry is downloaded
+
+\param[in]      entryNum_p          Position of the entry in the ConciseDCF.
+
+\return The function returns TRUE if the entry is downloaded.
+*/
+//------------------------------------------------------------------------------
+static BOOL isEntrySent(UINT entryNum_p)
+{
+    return isEntryRequired(&nodeInfo_l, entryNum_p);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get number of downloaded entries
+
+\return The function returns the number of entries which are downloaded.
+*/
+//------------------------------------------------------------------------------
+static UINT getSentEntryCount(void)
+{
+    UINT    entryNum;
+    UINT    count = 0;
+
+    for (entryNum = 0; entryNum < nodeInfo_l.entryCount; entryNum++)
+    {
+        if (isEntrySent(entryNum))
+            count++;
+    }
+
+    return count;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Clean up node info
+
+The function frees the digests of the test node.
+*/
+//------------------------------------------------------------------------------
+static void cleanupNodeInfo(void)
+{
+    freeDigest(&nodeInfo_l.storedDigest);
+    freeDigest(&nodeInfo_l.pendingDigest);
+    if (nodeInfo_l.pSendFlags != NULL)
+        OPLK_FREE(nodeInfo_l.pSendFlags);
+
+    OPLK_MEMSET(&nodeInfo_l, 0, sizeof(nodeInfo_l));
+}
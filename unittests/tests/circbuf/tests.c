@@ -0,0 +1,598 @@
+/**
+********************************************************************************
+\file   tests.c
+
+\brief  Unit test functions for circular buffer library
+
+This file contains the unit test functions for the circular buffer library. The
+transfer tests and the benchmark run a producer and a consumer thread on the
+POSIX shared memory implementation. Waiting threads yield the CPU, so that the
+tests also run on single core machines. The benchmark compares a locked buffer with
+a buffer selected for the lock-free mode by CONFIG_CIRCBUF_LOCKFREE_BUFFERS.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2017, B&R Industrial Automation GmbH
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <CUnit/CUnit.h>
+
+#include <common/oplkinc.h>
+#include <common/circbuffer.h>
+
+#include <pthread.h>
+#include <sched.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define TEST_LOCKED_BUFFER          CIRCBUF_DLLCAL_TXGEN
+#define TEST_LOCKFREE_BUFFER        CIRCBUF_DLLCAL_CN_REQ_IDENT
+#define TEST_BUFFER_SIZE            32768
+
+#define TRANSFER_BLOCK_COUNT        200000
+#define TRANSFER_MAX_BLOCK_SIZE     64
+
+#define BENCH_EVENT_COUNT           500000
+#define BENCH_LATENCY_COUNT         20000
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+/**
+\brief Test event
+
+The structure is transferred through the buffer by the benchmark. Its size
+matches a small stack event.
+*/
+typedef struct
+{
+    UINT32              sequence;                   ///< Sequence number of the event
+    UINT32              reserved;
+    ULONGLONG           postTime;                   ///< Time when the event was posted [ns]
+    UINT8               aArg[16];                   ///< Event argument
+} tTestEvent;
+
+/**
+\brief Producer/consumer test
+
+The structure describes a producer/consumer run on one circular buffer.
+*/
+typedef struct
+{
+    UINT8               bufferId;                   ///< ID of the tested buffer
+    UINT                blockCount;                 ///< Number of blocks to transfer
+    BOOL                fPaced;                     ///< Producer waits until each event is consumed
+    volatile UINT       consumedCount;              ///< Number of blocks consumed
+    UINT                errorCount;                 ///< Number of corrupt blocks
+    ULONGLONG*          paLatency;                  ///< Latencies of the paced events [ns]
+} tTransferTest;
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static void      runTransfer(UINT8 bufferId_p);
+static void      runBenchmark(UINT8 bufferId_p, const char* pName_p);
+static void*     transferProducer(void* pArg_p);
+static void*     transferConsumer(void* pArg_p);
+static void*     eventProducer(void* pArg_p);
+static void*     eventConsumer(void* pArg_p);
+static void      runThreads(tTransferTest* pTest_p,
+                            void* (*pfnProducer_p)(void*),
+                            void* (*pfnConsumer_p)(void*));
+static UINT      getBlockSize(UINT sequence_p);
+static ULONGLONG getTimeNs(void);
+static int       compareLatency(const void* pA_p, const void* pB_p);
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test the layout of the buffer header
+
+The producer position and the consumer position must occupy cache lines of
+their own.
+*/
+//------------------------------------------------------------------------------
+void test_circbuf_headerLayout(void)
+{
+    CU_ASSERT_EQUAL(sizeof(tCircBufPosition), CIRCBUF_CACHE_LINE_SIZE);
+    CU_ASSERT_EQUAL(offsetof(tCircBufHeader, writePos), CIRCBUF_CACHE_LINE_SIZE);
+    CU_ASSERT_EQUAL(offsetof(tCircBufHeader, readPos), 2 * CIRCBUF_CACHE_LINE_SIZE);
+    CU_ASSERT_EQUAL(sizeof(tCircBufHeader), 3 * CIRCBUF_CACHE_LINE_SIZE);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test the selection of the lock-free mode
+
+Only the buffers selected by CONFIG_CIRCBUF_LOCKFREE_BUFFERS are accessed
+lock-free. A connected instance takes over the mode of the buffer.
+*/
+//------------------------------------------------------------------------------
+void test_circbuf_lockFreeSelection(void)
+{
+    tCircBufInstance*   pLocked = NULL;
+    tCircBufInstance*   pLockFree = NULL;
+    tCircBufInstance*   pConnected = NULL;
+
+    CU_ASSERT_EQUAL(circbuf_alloc(TEST_LOCKED_BUFFER, TEST_BUFFER_SIZE, &pLocked), kCircBufOk);
+    CU_ASSERT_EQUAL(circbuf_alloc(TEST_LOCKFREE_BUFFER, TEST_BUFFER_SIZE, &pLockFree), kCircBufOk);
+    if ((pLocked == NULL) || (pLockFree == NULL))
+        return;
+
+    CU_ASSERT_FALSE(pLocked->fLockFree);
+    CU_ASSERT_TRUE(pLockFree->fLockFree);
+
+    CU_ASSERT_EQUAL(circbuf_connect(TEST_LOCKFREE_BUFFER, &pConnected), kCircBufOk);
+    if (pConnected != NULL)
+    {
+        CU_ASSERT_TRUE(pConnected->fLockFree);
+        circbuf_disconnect(pConnected);
+    }
+
+    circbuf_free(pLocked);
+    circbuf_free(pLockFree);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test the reset of a lock-free buffer
+
+The consumer resets a lock-free buffer by discarding the blocks written so far.
+The buffer is used normally afterwards, also across its end.
+*/
+//------------------------------------------------------------------------------
+void test_circbuf_resetLockFree(void)
+{
+    tCircBufInstance*   pInstance = NULL;
+    UINT32              aBlock[TRANSFER_MAX_BLOCK_SIZE / sizeof(UINT32)];
+    size_t              size;
+    UINT                round;
+    UINT                i;
+
+    CU_ASSERT_EQUAL(circbuf_alloc(TEST_LOCKFREE_BUFFER, TEST_BUFFER_SIZE, &pInstance), kCircBufOk);
+    if (pInstance == NULL)
+        return;
+
+    // the discarded blocks wrap around the end of the buffer in later rounds
+    for (round = 0; round < 2 * TEST_BUFFER_SIZE / sizeof(aBlock); round++)
+    {
+        for (i = 0; i < 3; i++)
+        {
+            aBlock[0] = (round * 4) + i;
+            CU_ASSERT_EQUAL(circbuf_writeData(pInstance, aBlock, sizeof(aBlock) - (i * sizeof(UINT32))), kCircBufOk);
+        }
+
+        circbuf_reset(pInstance);
+        CU_ASSERT_EQUAL(circbuf_getDataCount(pInstance), 0);
+        CU_ASSERT_EQUAL(circbuf_readData(pInstance, aBlock, sizeof(aBlock), &size), kCircBufNoReadableData);
+
+        aBlock[0] = (round * 4) + 3;
+        CU_ASSERT_EQUAL(circbuf_writeData(pInstance, aBlock, sizeof(UINT32)), kCircBufOk);
+        aBlock[0] = 0;
+        CU_ASSERT_EQUAL(circbuf_readData(pInstance, aBlock, sizeof(aBlock), &size), kCircBufOk);
+        CU_ASSERT_EQUAL(size, sizeof(UINT32));
+        CU_ASSERT_EQUAL(aBlock[0], (round * 4) + 3);
+    }
+
+    circbuf_free(pInstance);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test the transfer through a locked buffer
+*/
+//------------------------------------------------------------------------------
+void test_circbuf_transferLocked(void)
+{
+    runTransfer(TEST_LOCKED_BUFFER);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test the transfer through a lock-free buffer
+*/
+//------------------------------------------------------------------------------
+void test_circbuf_transferLockFree(void)
+{
+    runTransfer(TEST_LOCKFREE_BUFFER);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Benchmark locked and lock-free buffers
+
+The benchmark measures the event throughput of a saturated buffer and the
+post-to-dispatch latency of single events for both modes.
+*/
+//------------------------------------------------------------------------------
+void test_circbuf_benchmark(void)
+{
+    printf("\n");
+    runBenchmark(TEST_LOCKED_BUFFER, "locked");
+    runBenchmark(TEST_LOCKFREE_BUFFER, "lock-free");
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Run a transfer test
+
+The producer writes blocks of varying size, so that the buffer wraps around at
+all offsets. The consumer checks the size, order and contents of the blocks.
+
+\param[in]      bufferId_p          ID of the tested buffer.
+*/
+//------------------------------------------------------------------------------
+static void runTransfer(UINT8 bufferId_p)
+{
+    tTransferTest   test;
+
+    OPLK_MEMSET(&test, 0, sizeof(test));
+    test.bufferId = bufferId_p;
+    test.blockCount = TRANSFER_BLOCK_COUNT;
+
+    runThreads(&test, transferProducer, transferConsumer);
+
+    CU_ASSERT_EQUAL(test.consumedCount, TRANSFER_BLOCK_COUNT);
+    CU_ASSERT_EQUAL(test.errorCount, 0);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Run the benchmark of a buffer
+
+\param[in]      bufferId_p          ID of the tested buffer.
+\param[in]      pName_p             Name of the buffer mode to be printed.
+*/
+//------------------------------------------------------------------------------
+static void runBenchmark(UINT8 bufferId_p, const char* pName_p)
+{
+    tTransferTest   test;
+    ULONGLONG       startTime;
+    ULONGLONG       duration;
+    ULONGLONG*      paLatency;
+
+    // Throughput of a saturated buffer
+    OPLK_MEMSET(&test, 0, sizeof(test));
+    test.bufferId = bufferId_p;
+    test.blockCount = BENCH_EVENT_COUNT;
+
+    startTime = getTimeNs();
+    runThreads(&test, eventProducer, eventConsumer);
+    duration = getTimeNs() - startTime;
+
+    CU_ASSERT_EQUAL(test.consumedCount, BENCH_EVENT_COUNT);
+    CU_ASSERT_EQUAL(test.errorCount, 0);
+
+    // Latency of single events
+    paLatency = (ULONGLONG*)malloc(sizeof(ULONGLONG) * BENCH_LATENCY_COUNT);
+    CU_ASSERT_PTR_NOT_NULL(paLatency);
+    if (paLatency == NULL)
+        return;
+
+    OPLK_MEMSET(&test, 0, sizeof(test));
+    test.bufferId = bufferId_p;
+    test.blockCount = BENCH_LATENCY_COUNT;
+    test.fPaced = TRUE;
+    test.paLatency = paLatency;
+
+    runThreads(&test, eventProducer, eventConsumer);
+    CU_ASSERT_EQUAL(test.consumedCount, BENCH_LATENCY_COUNT);
+    CU_ASSERT_EQUAL(test.errorCount, 0);
+
+    qsort(paLatency, BENCH_LATENCY_COUNT, sizeof(ULONGLONG), compareLatency);
+
+    printf("    %-10s %10.0f events/s   latency p50 %6llu ns   p99 %6llu ns\n",
+           pName_p,
+           (double)BENCH_EVENT_COUNT * 1e9 / (double)duration,
+           paLatency[BENCH_LATENCY_COUNT / 2],
+           paLatency[(BENCH_LATENCY_COUNT * 99) / 100]);
+
+    free(paLatency);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Run producer and consumer threads
+
+The function allocates the buffer, connects the consumer and runs the producer
+and the consumer in threads of their own until both are finished.
+
+\param[in,out]  pTest_p             Pointer to the test description.
+\param[in]      pfnProducer_p       Producer thread function.
+\param[in]      pfnConsumer_p       Consumer thread function.
+*/
+//------------------------------------------------------------------------------
+static void runThreads(tTransferTest* pTest_p,
+                       void* (*pfnProducer_p)(void*),
+                       void* (*pfnConsumer_p)(void*))
+{
+    tCircBufInstance*   pProducer = NULL;
+    tCircBufInstance*   pConsumer = NULL;
+    pthread_t           producerThread;
+    pthread_t           consumerThread;
+    void*               aProducerArg[2];
+    void*               aConsumerArg[2];
+
+    CU_ASSERT_EQUAL(circbuf_alloc(pTest_p->bufferId, TEST_BUFFER_SIZE, &pProducer), kCircBufOk);
+    CU_ASSERT_EQUAL(circbuf_connect(pTest_p->bufferId, &pConsumer), kCircBufOk);
+    if ((pProducer == NULL) || (pConsumer == NULL))
+    {
+        if (pProducer != NULL)
+            circbuf_free(pProducer);
+        return;
+    }
+
+    aProducerArg[0] = pTest_p;
+    aProducerArg[1] = pProducer;
+    aConsumerArg[0] = pTest_p;
+    aConsumerArg[1] = pConsumer;
+    CU_ASSERT_EQUAL(pthread_create(&producerThread, NULL, pfnProducer_p, aProducerArg), 0);
+    CU_ASSERT_EQUAL(pthread_create(&consumerThread, NULL, pfnConsumer_p, aConsumerArg), 0);
+    pthread_join(producerThread, NULL);
+    pthread_join(consumerThread, NULL);
+
+    circbuf_disconnect(pConsumer);
+    circbuf_free(pProducer);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Producer of the transfer test
+
+\param[in]      pArg_p              Pointer to the test and the buffer instance.
+
+\return The function returns NULL.
+*/
+//------------------------------------------------------------------------------
+static void* transferProducer(void* pArg_p)
+{
+    tTransferTest*      pTest = (tTransferTest*)((void**)pArg_p)[0];
+    tCircBufInstance*   pInstance = (tCircBufInstance*)((void**)pArg_p)[1];
+    UINT8               aBlock[TRANSFER_MAX_BLOCK_SIZE];
+    UINT                sequence;
+    UINT                size;
+    UINT                i;
+
+    for (sequence = 0; sequence < pTest->blockCount; sequence++)
+    {
+        size = getBlockSize(sequence);
+        for (i = 0; i < size; i++)
+            aBlock[i] = (UINT8)(sequence + i);
+
+        while (circbuf_writeData(pInstance, aBlock, size) == kCircBufBufferFull)
+            sched_yield();
+    }
+
+    return NULL;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Consumer of the transfer test
+
+\param[in]      pArg_p              Pointer to the test and the buffer instance.
+
+\return The function returns NULL.
+*/
+//------------------------------------------------------------------------------
+static void* transferConsumer(void* pArg_p)
+{
+    tTransferTest*      pTest = (tTransferTest*)((void**)pArg_p)[0];
+    tCircBufInstance*   pInstance = (tCircBufInstance*)((void**)pArg_p)[1];
+    UINT8               aBlock[TRANSFER_MAX_BLOCK_SIZE];
+    size_t              size;
+    UINT                sequence;
+    UINT                i;
+
+    for (sequence = 0; sequence < pTest->blockCount; sequence++)
+    {
+        while (circbuf_readData(pInstance, aBlock, sizeof(aBlock), &size) == kCircBufNoReadableData)
+            sched_yield();
+
+        if (size != getBlockSize(sequence))
+        {
+            pTest->errorCount++;
+            continue;
+        }
+
+        for (i = 0; i < size; i++)
+        {
+            if (aBlock[i] != (UINT8)(sequence + i))
+            {
+                pTest->errorCount++;
+                break;
+            }
+        }
+
+        pTest->consumedCount++;
+    }
+
+    return NULL;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Producer of the benchmark
+
+The producer posts time stamped events. In paced mode it waits until each event
+is consumed before the next event is posted.
+
+\param[in]      pArg_p              Pointer to the test and the buffer instance.
+
+\return The function returns NULL.
+*/
+//------------------------------------------------------------------------------
+static void* eventProducer(void* pArg_p)
+{
+    tTransferTest*      pTest = (tTransferTest*)((void**)pArg_p)[0];
+    tCircBufInstance*   pInstance = (tCircBufInstance*)((void**)pArg_p)[1];
+    tTestEvent          event;
+    UINT                sequence;
+
+    OPLK_MEMSET(&event, 0, sizeof(event));
+
+    for (sequence = 0; sequence < pTest->blockCount; sequence++)
+    {
+        event.sequence = sequence;
+        event.postTime = getTimeNs();
+        while (circbuf_writeData(pInstance, &event, sizeof(event)) == kCircBufBufferFull)
+            sched_yield();
+
+        if (pTest->fPaced)
+        {
+            while (pTest->consumedCount <= sequence)
+                sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Consumer of the benchmark
+
+\param[in]      pArg_p              Pointer to the test and the buffer instance.
+
+\return The function returns NULL.
+*/
+//------------------------------------------------------------------------------
+static void* eventConsumer(void* pArg_p)
+{
+    tTransferTest*      pTest = (tTransferTest*)((void**)pArg_p)[0];
+    tCircBufInstance*   pInstance = (tCircBufInstance*)((void**)pArg_p)[1];
+    tTestEvent          event;
+    size_t              size;
+    UINT                sequence;
+
+    for (sequence = 0; sequence < pTest->blockCount; sequence++)
+    {
+        while (circbuf_readData(pInstance, &event, sizeof(event), &size) == kCircBufNoReadableData)
+            sched_yield();
+
+        if (pTest->paLatency != NULL)
+            pTest->paLatency[sequence] = getTimeNs() - event.postTime;
+
+        if ((size != sizeof(event)) || (event.sequence != sequence))
+            pTest->errorCount++;
+
+        __sync_synchronize();
+        pTest->consumedCount++;
+    }
+
+    return NULL;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get the block size of a sequence number
+
+\param[in]      sequence_p          Sequence number of the block.
+
+\return The function returns the block size in bytes.
+*/
+//------------------------------------------------------------------------------
+static UINT getBlockSize(UINT sequence_p)
+{
+    return 1 + ((sequence_p * 7) % TRANSFER_MAX_BLOCK_SIZE);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get a monotonic time stamp
+
+\return The function returns the time stamp in nanoseconds.
+*/
+//------------------------------------------------------------------------------
+static ULONGLONG getTimeNs(void)
+{
+    struct timespec time;
+
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return ((ULONGLONG)time.tv_sec * 1000000000ULL) + (ULONGLONG)time.tv_nsec;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Compare two latencies for qsort()
+
+\param[in]      pA_p                Pointer to the first latency.
+\param[in]      pB_p                Pointer to the second latency.
+
+\return The function returns the order of the latencies.
+*/
+//------------------------------------------------------------------------------
+static int compareLatency(const void* pA_p, const void* pB_p)
+{
+    ULONGLONG   a = *(const ULONGLONG*)pA_p;
+    ULONGLONG   b = *(const ULONGLONG*)pB_p;
+
+    return (a > b) - (a < b);
+}
+
+/// \}
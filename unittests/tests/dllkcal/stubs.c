@@ -0,0 +1,208 @@
+/**
+********************************************************************************
+\file   stubs.c
+
+\brief  Stubs for the unit tests of the kernel DLL CAL module
+
+The file contains the stubs of the modules used by the kernel DLL CAL module.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2017, B&R Industrial Automation GmbH
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <common/oplkinc.h>
+#include <common/dllcal.h>
+#include <kernel/dllk.h>
+#include <kernel/eventk.h>
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static tOplkError addInstance(tDllCalQueueInstance* ppDllCalQueue_p, tDllCalQueue dllCalQueue_p);
+static tOplkError delInstance(tDllCalQueueInstance pDllCalQueue_p);
+static tOplkError insertDataBlock(tDllCalQueueInstance pDllCalQueue_p, const void* pData_p, size_t dataSize_p);
+static tOplkError getDataBlock(tDllCalQueueInstance pDllCalQueue_p, void* pData_p, size_t* pDataSize_p);
+static tOplkError getDataBlockCount(tDllCalQueueInstance pDllCalQueue_p, UINT* pDataBlockCount_p);
+static tOplkError resetDataBlockQueue(tDllCalQueueInstance pDllCalQueue_p);
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+// The asynchronous Tx queues of the MN are always empty
+static tDllCalFuncIntf funcIntf_l =
+{
+    addInstance,
+    delInstance,
+    insertDataBlock,
+    getDataBlock,
+    getDataBlockCount,
+    resetDataBlockQueue
+};
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+tDllCalFuncIntf* dllkcalcircbuf_getInterface(void)
+{
+    return &funcIntf_l;
+}
+
+tOplkError dllk_config(const tDllConfigParam* pDllConfigParam_p)
+{
+    UNUSED_PARAMETER(pDllConfigParam_p);
+    return kErrorOk;
+}
+
+tOplkError dllk_setIdentity(const tDllIdentParam* pDllIdentParam_p)
+{
+    UNUSED_PARAMETER(pDllIdentParam_p);
+    return kErrorOk;
+}
+
+tOplkError dllk_setAsndServiceIdFilter(tDllAsndServiceId serviceId_p, tDllAsndFilter filter_p)
+{
+    UNUSED_PARAMETER(serviceId_p);
+    UNUSED_PARAMETER(filter_p);
+    return kErrorOk;
+}
+
+tOplkError dllk_configNode(const tDllNodeInfo* pNodeInfo_p)
+{
+    UNUSED_PARAMETER(pNodeInfo_p);
+    return kErrorOk;
+}
+
+tOplkError dllk_addNode(const tDllNodeOpParam* pNodeOpParam_p)
+{
+    UNUSED_PARAMETER(pNodeOpParam_p);
+    return kErrorOk;
+}
+
+tOplkError dllk_deleteNode(const tDllNodeOpParam* pNodeOpParam_p)
+{
+    UNUSED_PARAMETER(pNodeOpParam_p);
+    return kErrorOk;
+}
+
+tOplkError dllk_setFlag1OfNode(UINT nodeId_p, UINT8 soaFlag1_p)
+{
+    UNUSED_PARAMETER(nodeId_p);
+    UNUSED_PARAMETER(soaFlag1_p);
+    return kErrorOk;
+}
+
+tOplkError dllk_getCnMacAddress(UINT nodeId_p, UINT8* pCnMacAddress_p)
+{
+    UNUSED_PARAMETER(nodeId_p);
+    UNUSED_PARAMETER(pCnMacAddress_p);
+    return kErrorOk;
+}
+
+tOplkError eventk_postEvent(const tEvent* pEvent_p)
+{
+    UNUSED_PARAMETER(pEvent_p);
+    return kErrorOk;
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+
+static tOplkError addInstance(tDllCalQueueInstance* ppDllCalQueue_p, tDllCalQueue dllCalQueue_p)
+{
+    UNUSED_PARAMETER(dllCalQueue_p);
+    *ppDllCalQueue_p = NULL;
+    return kErrorOk;
+}
+
+static tOplkError delInstance(tDllCalQueueInstance pDllCalQueue_p)
+{
+    UNUSED_PARAMETER(pDllCalQueue_p);
+    return kErrorOk;
+}
+
+static tOplkError insertDataBlock(tDllCalQueueInstance pDllCalQueue_p, const void* pData_p, size_t dataSize_p)
+{
+    UNUSED_PARAMETER(pDllCalQueue_p);
+    UNUSED_PARAMETER(pData_p);
+    UNUSED_PARAMETER(dataSize_p);
+    return kErrorDllAsyncTxBufferFull;
+}
+
+static tOplkError getDataBlock(tDllCalQueueInstance pDllCalQueue_p, void* pData_p, size_t* pDataSize_p)
+{
+    UNUSED_PARAMETER(pDllCalQueue_p);
+    UNUSED_PARAMETER(pData_p);
+    *pDataSize_p = 0;
+    return kErrorDllAsyncTxBufferEmpty;
+}
+
+static tOplkError getDataBlockCount(tDllCalQueueInstance pDllCalQueue_p, UINT* pDataBlockCount_p)
+{
+    UNUSED_PARAMETER(pDllCalQueue_p);
+    *pDataBlockCount_p = 0;
+    return kErrorOk;
+}
+
+static tOplkError resetDataBlockQueue(tDllCalQueueInstance pDllCalQueue_p)
+{
+    UNUSED_PARAMETER(pDllCalQueue_p);
+    return kErrorOk;
+}
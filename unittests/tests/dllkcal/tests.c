@@ -0,0 +1,516 @@
+/**
+********************************************************************************
+\file   tests.c
+
+\brief  Unit tests for the asynchronous scheduler of the kernel DLL CAL module
+
+The file contains the unit tests for the deficit round-robin scheduler which
+assigns the asynchronous phases of the MN.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2017, B&R Industrial Automation GmbH
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <CUnit/CUnit.h>
+
+// Serve each CN for two consecutive asynchronous phases so that the quantum is
+// distinguishable from the plain round-robin among the CNs
+#define CONFIG_DLLKCAL_ASYNC_SCHED_NODE_QUANTUM     2
+
+#include <kernel/dll/dllkcal.c>
+
+#include <pthread.h>
+#include <sched.h>
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define TEST_REQUEST_COUNT          1000    // pending requests of a busy CN
+#define TEST_STRESS_NODE_COUNT      8       // CNs used by the stress test
+#define TEST_STRESS_LOOP_COUNT      200000  // request rounds of the stress test
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static BOOL  getNextRequest(tDllReqServiceId* pReqServiceId_p, UINT* pNodeId_p);
+static void* stressProducer(void* pArg_p);
+static void* stressConsumer(void* pArg_p);
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static volatile BOOL    fStressDone_l;
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test weights of the request queues
+
+The test keeps the CN generic queue and the StatusRequest queue busy and checks
+that the asynchronous phases are shared according to the queue weights.
+*/
+//------------------------------------------------------------------------------
+void test_dllkcal_schedWeights(void)
+{
+    tDllkCalAsyncSchedStatistics*   pStatistics;
+    tDllReqServiceId                reqServiceId;
+    UINT                            nodeId;
+    UINT                            slot;
+    UINT                            genCount = 0;
+    UINT                            statusCount = 0;
+
+    CU_ASSERT_EQUAL_FATAL(dllkcal_init(), kErrorOk);
+
+    CU_ASSERT_EQUAL(dllkcal_setAsyncSchedWeight(kDllkCalAsyncSchedQueueCnGen, 0), kErrorDllInvalidParam);
+    CU_ASSERT_EQUAL(dllkcal_setAsyncSchedWeight(kDllkCalAsyncSchedQueueCount, 1), kErrorDllInvalidParam);
+    CU_ASSERT_EQUAL(dllkcal_setAsyncSchedWeight(kDllkCalAsyncSchedQueueCnGen, 3), kErrorOk);
+
+    dllkcal_setAsyncPendingRequests(1, kDllAsyncReqPrioGeneric, TEST_REQUEST_COUNT);
+    for (nodeId = 1; nodeId <= 20; nodeId++)
+        CU_ASSERT_EQUAL(dllkcal_issueRequest(kDllReqServiceStatus, nodeId, 0xFF), kErrorOk);
+
+    // One round grants three phases to the CN generic queue and one to the
+    // StatusRequest queue, all other queues are empty.
+    for (slot = 0; slot < 40; slot++)
+    {
+        CU_ASSERT_FATAL(getNextRequest(&reqServiceId, &nodeId));
+        if (reqServiceId == kDllReqServiceUnspecified)
+        {
+            CU_ASSERT_EQUAL(nodeId, 1);
+            CU_ASSERT_NOT_EQUAL(slot % 4, 3);
+            genCount++;
+        }
+        else
+        {
+            CU_ASSERT_EQUAL(reqServiceId, kDllReqServiceStatus);
+            CU_ASSERT_EQUAL(nodeId, (slot / 4) + 1);
+            CU_ASSERT_EQUAL(slot % 4, 3);
+            statusCount++;
+        }
+    }
+
+    CU_ASSERT_EQUAL(genCount, 30);
+    CU_ASSERT_EQUAL(statusCount, 10);
+
+    CU_ASSERT_EQUAL(dllkcal_getAsyncSchedStatistics(&pStatistics), kErrorOk);
+    CU_ASSERT_EQUAL(pStatistics->slotCount, 40);
+    CU_ASSERT_EQUAL(pStatistics->idleCount, 0);
+    CU_ASSERT_EQUAL(pStatistics->aQueue[kDllkCalAsyncSchedQueueCnGen].weight, 3);
+    CU_ASSERT_EQUAL(pStatistics->aQueue[kDllkCalAsyncSchedQueueCnGen].grantCount, 30);
+    CU_ASSERT_EQUAL(pStatistics->aQueue[kDllkCalAsyncSchedQueueMnStatus].grantCount, 10);
+    CU_ASSERT_EQUAL(pStatistics->aQueue[kDllkCalAsyncSchedQueueMnStatus].maxWait, 3);
+    CU_ASSERT_EQUAL(pStatistics->aQueue[kDllkCalAsyncSchedQueueMnStatus].curDepth, 10);
+    CU_ASSERT_EQUAL(pStatistics->aQueue[kDllkCalAsyncSchedQueueMnStatus].forcedGrantCount, 0);
+
+    CU_ASSERT_EQUAL(dllkcal_exit(), kErrorOk);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test node quantum of the CN request queues
+
+The test checks that the CNs of a request queue are served round-robin with
+CONFIG_DLLKCAL_ASYNC_SCHED_NODE_QUANTUM consecutive phases each, and that a CN
+leaves the rotation when its requests have been served.
+*/
+//------------------------------------------------------------------------------
+void test_dllkcal_schedNodeQuantum(void)
+{
+    static const UINT               aExpectedNodeId[] = { 1, 1, 2, 2, 3, 3, 1, 1, 3, 3, 1, 1 };
+    tDllkCalAsyncSchedStatistics*   pStatistics;
+    tDllReqServiceId                reqServiceId;
+    UINT                            nodeId;
+    UINT                            slot;
+
+    CU_ASSERT_EQUAL_FATAL(dllkcal_init(), kErrorOk);
+
+    dllkcal_setAsyncPendingRequests(1, kDllAsyncReqPrioNmt, TEST_REQUEST_COUNT);
+    dllkcal_setAsyncPendingRequests(2, kDllAsyncReqPrioNmt, 2);
+    dllkcal_setAsyncPendingRequests(3, kDllAsyncReqPrioNmt, TEST_REQUEST_COUNT);
+
+    for (slot = 0; slot < tabentries(aExpectedNodeId); slot++)
+    {
+        CU_ASSERT_FATAL(getNextRequest(&reqServiceId, &nodeId));
+        CU_ASSERT_EQUAL(reqServiceId, kDllReqServiceNmtRequest);
+        CU_ASSERT_EQUAL(nodeId, aExpectedNodeId[slot]);
+
+        // the CN reports the served request in its next frame
+        dllkcal_ackAsyncRequest(nodeId, reqServiceId);
+    }
+
+    // node 3 reports the same requests again, it must not be queued twice
+    dllkcal_setAsyncPendingRequests(3, kDllAsyncReqPrioNmt, TEST_REQUEST_COUNT);
+    CU_ASSERT_TRUE(getNextRequest(&reqServiceId, &nodeId));
+    CU_ASSERT_EQUAL(nodeId, 3);
+    CU_ASSERT_TRUE(getNextRequest(&reqServiceId, &nodeId));
+    CU_ASSERT_EQUAL(nodeId, 3);
+    CU_ASSERT_TRUE(getNextRequest(&reqServiceId, &nodeId));
+    CU_ASSERT_EQUAL(nodeId, 1);
+
+    // an acknowledged request is no longer scheduled
+    dllkcal_setAsyncPendingRequests(1, kDllAsyncReqPrioNmt, 0);
+    dllkcal_setAsyncPendingRequests(3, kDllAsyncReqPrioNmt, 0);
+    CU_ASSERT_FALSE(getNextRequest(&reqServiceId, &nodeId));
+
+    CU_ASSERT_EQUAL(dllkcal_getAsyncSchedStatistics(&pStatistics), kErrorOk);
+    CU_ASSERT_EQUAL(pStatistics->aCnGrantCount[0], 7);
+    CU_ASSERT_EQUAL(pStatistics->aCnGrantCount[1], 2);
+    CU_ASSERT_EQUAL(pStatistics->aCnGrantCount[2], 6);
+    CU_ASSERT_EQUAL(pStatistics->idleCount, 1);
+
+    CU_ASSERT_EQUAL(dllkcal_exit(), kErrorOk);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test starvation limit of the request queues
+
+The test assigns a weight to the CN generic queue which would keep all other
+queues waiting and checks that a pending IdentRequest is forced once it has
+waited for more than CONFIG_DLLKCAL_ASYNC_SCHED_STARVATION_LIMIT phases.
+*/
+//------------------------------------------------------------------------------
+void test_dllkcal_schedStarvation(void)
+{
+    tDllkCalAsyncSchedStatistics*   pStatistics;
+    tDllkCalAsyncSchedQueueStatistics* pIdentStatistics;
+    tDllReqServiceId                reqServiceId;
+    UINT                            nodeId;
+    UINT                            slot;
+    UINT                            identSlot = 0;
+
+    CU_ASSERT_EQUAL_FATAL(dllkcal_init(), kErrorOk);
+
+    CU_ASSERT_EQUAL(dllkcal_setAsyncSchedWeight(kDllkCalAsyncSchedQueueCnGen, TEST_REQUEST_COUNT), kErrorOk);
+    dllkcal_setAsyncPendingRequests(1, kDllAsyncReqPrioGeneric, TEST_REQUEST_COUNT);
+    CU_ASSERT_EQUAL(dllkcal_issueRequest(kDllReqServiceIdent, 5, 0xFF), kErrorOk);
+
+    for (slot = 1; slot <= 4 * CONFIG_DLLKCAL_ASYNC_SCHED_STARVATION_LIMIT; slot++)
+    {
+        CU_ASSERT_FATAL(getNextRequest(&reqServiceId, &nodeId));
+        if (reqServiceId == kDllReqServiceIdent)
+        {
+            CU_ASSERT_EQUAL(nodeId, 5);
+            CU_ASSERT_EQUAL(identSlot, 0);
+            identSlot = slot;
+        }
+        else
+        {
+            CU_ASSERT_EQUAL(reqServiceId, kDllReqServiceUnspecified);
+        }
+    }
+
+    // The empty queues starve as well, but only one queue is checked per
+    // phase. Thus, the IdentRequest may be delayed by one phase per queue.
+    CU_ASSERT(identSlot > CONFIG_DLLKCAL_ASYNC_SCHED_STARVATION_LIMIT);
+    CU_ASSERT(identSlot <= CONFIG_DLLKCAL_ASYNC_SCHED_STARVATION_LIMIT + kDllkCalAsyncSchedQueueCount);
+
+    CU_ASSERT_EQUAL(dllkcal_getAsyncSchedStatistics(&pStatistics), kErrorOk);
+    pIdentStatistics = &pStatistics->aQueue[kDllkCalAsyncSchedQueueMnIdent];
+    CU_ASSERT_EQUAL(pIdentStatistics->grantCount, 1);
+    CU_ASSERT_EQUAL(pIdentStatistics->forcedGrantCount, 1);
+    CU_ASSERT_EQUAL(pIdentStatistics->maxWait, identSlot - 1);
+    CU_ASSERT_EQUAL(pStatistics->aQueue[kDllkCalAsyncSchedQueueCnGen].forcedGrantCount, 0);
+    CU_ASSERT_EQUAL(pStatistics->aQueue[kDllkCalAsyncSchedQueueCnGen].grantCount,
+                    (4 * CONFIG_DLLKCAL_ASYNC_SCHED_STARVATION_LIMIT) - 1);
+
+    CU_ASSERT_EQUAL(dllkcal_exit(), kErrorOk);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test Ident/StatusRequest queueing
+
+The test checks that a node is queued at most once for an IdentRequest or a
+StatusRequest and that it can be queued again after it has been served.
+*/
+//------------------------------------------------------------------------------
+void test_dllkcal_issueRequest(void)
+{
+    tDllkCalAsyncSchedStatistics*   pStatistics;
+    tDllReqServiceId                reqServiceId;
+    UINT                            nodeId;
+    UINT                            count;
+
+    CU_ASSERT_EQUAL_FATAL(dllkcal_init(), kErrorOk);
+
+    CU_ASSERT_EQUAL(dllkcal_issueRequest(kDllReqServiceStatus, C_ADR_BROADCAST, 0xFF), kErrorDllInvalidParam);
+    CU_ASSERT_EQUAL(dllkcal_issueRequest(kDllReqServiceNmtRequest, 1, 0xFF), kErrorDllInvalidParam);
+
+    // requests which are issued faster than served occupy one entry per node
+    for (count = 0; count < 1000; count++)
+    {
+        CU_ASSERT_EQUAL(dllkcal_issueRequest(kDllReqServiceStatus, 7, 0xFF), kErrorOk);
+        CU_ASSERT_EQUAL(dllkcal_issueRequest(kDllReqServiceIdent, 7, 0xFF), kErrorOk);
+        CU_ASSERT_EQUAL(dllkcal_issueRequest(kDllReqServiceIdent, 9, 0xFF), kErrorOk);
+    }
+
+    CU_ASSERT_EQUAL(dllkcal_getAsyncSchedStatistics(&pStatistics), kErrorOk);
+    CU_ASSERT_EQUAL(pStatistics->aQueue[kDllkCalAsyncSchedQueueMnStatus].curDepth, 1);
+    CU_ASSERT_EQUAL(pStatistics->aQueue[kDllkCalAsyncSchedQueueMnIdent].curDepth, 2);
+
+    CU_ASSERT_TRUE(getNextRequest(&reqServiceId, &nodeId));
+    CU_ASSERT_EQUAL(reqServiceId, kDllReqServiceIdent);
+    CU_ASSERT_EQUAL(nodeId, 7);
+
+    // a served node is queued again behind the waiting ones
+    CU_ASSERT_EQUAL(dllkcal_issueRequest(kDllReqServiceIdent, 7, 0xFF), kErrorOk);
+    CU_ASSERT_EQUAL(dllkcal_issueRequest(kDllReqServiceIdent, 9, 0xFF), kErrorOk);
+
+    CU_ASSERT_TRUE(getNextRequest(&reqServiceId, &nodeId));
+    CU_ASSERT_EQUAL(reqServiceId, kDllReqServiceStatus);
+    CU_ASSERT_EQUAL(nodeId, 7);
+    CU_ASSERT_TRUE(getNextRequest(&reqServiceId, &nodeId));
+    CU_ASSERT_EQUAL(reqServiceId, kDllReqServiceIdent);
+    CU_ASSERT_EQUAL(nodeId, 9);
+    CU_ASSERT_TRUE(getNextRequest(&reqServiceId, &nodeId));
+    CU_ASSERT_EQUAL(reqServiceId, kDllReqServiceIdent);
+    CU_ASSERT_EQUAL(nodeId, 7);
+    CU_ASSERT_FALSE(getNextRequest(&reqServiceId, &nodeId));
+
+    // clearing the queues releases the nodes as well
+    CU_ASSERT_EQUAL(dllkcal_issueRequest(kDllReqServiceStatus, 7, 0xFF), kErrorOk);
+    CU_ASSERT_EQUAL(dllkcal_issueRequest(kDllReqServiceIdent, 9, 0xFF), kErrorOk);
+    CU_ASSERT_EQUAL(dllkcal_clearAsyncQueues(), kErrorOk);
+    CU_ASSERT_EQUAL(dllkcal_issueRequest(kDllReqServiceStatus, 7, 0xFF), kErrorOk);
+    CU_ASSERT_TRUE(getNextRequest(&reqServiceId, &nodeId));
+    CU_ASSERT_EQUAL(reqServiceId, kDllReqServiceStatus);
+    CU_ASSERT_EQUAL(nodeId, 7);
+
+    // the requests issued before the queues were cleared are dropped
+    CU_ASSERT_FALSE(getNextRequest(&reqServiceId, &nodeId));
+    CU_ASSERT_FALSE(instance_l.aIdentReqQueued[9]);
+
+    CU_ASSERT_EQUAL(dllkcal_exit(), kErrorOk);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test concurrent request queueing
+
+The test issues requests in a producer thread while a consumer thread assigns
+the asynchronous phases like the SoA path does. After both threads have
+finished, no node may be left marked as queued without a queue entry, i.e. every
+node has to be served again when it issues new requests.
+*/
+//------------------------------------------------------------------------------
+void test_dllkcal_concurrentRequests(void)
+{
+    pthread_t           producerThread;
+    pthread_t           consumerThread;
+    tDllReqServiceId    reqServiceId;
+    UINT                nodeId;
+    UINT                count;
+    UINT                aGrantCount[TEST_STRESS_NODE_COUNT][3];
+
+    CU_ASSERT_EQUAL_FATAL(dllkcal_init(), kErrorOk);
+
+    fStressDone_l = FALSE;
+    CU_ASSERT_EQUAL_FATAL(pthread_create(&producerThread, NULL, stressProducer, NULL), 0);
+    CU_ASSERT_EQUAL_FATAL(pthread_create(&consumerThread, NULL, stressConsumer, NULL), 0);
+    pthread_join(producerThread, NULL);
+    pthread_join(consumerThread, NULL);
+
+    // the producer has withdrawn all CN requests, drain the remaining entries
+    for (count = 0; count < 1000; count++)
+    {
+        if (!getNextRequest(&reqServiceId, &nodeId))
+            break;
+    }
+    CU_ASSERT_FALSE(getNextRequest(&reqServiceId, &nodeId));
+
+    for (nodeId = 1; nodeId <= TEST_STRESS_NODE_COUNT; nodeId++)
+    {
+        CU_ASSERT_FALSE(instance_l.aIdentReqQueued[nodeId]);
+        CU_ASSERT_FALSE(instance_l.aStatusReqQueued[nodeId]);
+        CU_ASSERT_FALSE(instance_l.cnRequestGen.aScheduled[nodeId - 1]);
+    }
+
+    // every node is served again
+    for (nodeId = 1; nodeId <= TEST_STRESS_NODE_COUNT; nodeId++)
+    {
+        CU_ASSERT_EQUAL(dllkcal_issueRequest(kDllReqServiceIdent, nodeId, 0xFF), kErrorOk);
+        CU_ASSERT_EQUAL(dllkcal_issueRequest(kDllReqServiceStatus, nodeId, 0xFF), kErrorOk);
+        CU_ASSERT_EQUAL(dllkcal_setAsyncPendingRequests(nodeId, kDllAsyncReqPrioGeneric, 1), kErrorOk);
+    }
+
+    OPLK_MEMSET(aGrantCount, 0, sizeof(aGrantCount));
+    while (getNextRequest(&reqServiceId, &nodeId))
+    {
+        CU_ASSERT_FATAL((nodeId >= 1) && (nodeId <= TEST_STRESS_NODE_COUNT));
+        switch (reqServiceId)
+        {
+            case kDllReqServiceIdent:
+                aGrantCount[nodeId - 1][0]++;
+                break;
+
+            case kDllReqServiceStatus:
+                aGrantCount[nodeId - 1][1]++;
+                break;
+
+            default:
+                // dllkcal_ackAsyncRequest() is called by the Rx path
+                CU_ASSERT_EQUAL(dllkcal_ackAsyncRequest(nodeId, reqServiceId), kErrorOk);
+                aGrantCount[nodeId - 1][2]++;
+                break;
+        }
+    }
+
+    for (nodeId = 1; nodeId <= TEST_STRESS_NODE_COUNT; nodeId++)
+    {
+        CU_ASSERT_EQUAL(aGrantCount[nodeId - 1][0], 1);
+        CU_ASSERT_EQUAL(aGrantCount[nodeId - 1][1], 1);
+        CU_ASSERT_EQUAL(aGrantCount[nodeId - 1][2], 1);
+    }
+
+    CU_ASSERT_EQUAL(dllkcal_exit(), kErrorOk);
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Schedule next asynchronous phase
+
+The function assigns the next asynchronous phase like the DLL of the MN does
+without own pending frames.
+
+\param[out]     pReqServiceId_p     Pointer to store the granted request.
+\param[out]     pNodeId_p           Pointer to store the node ID of the request.
+
+\return The function returns TRUE if the phase has been assigned.
+*/
+//------------------------------------------------------------------------------
+static BOOL getNextRequest(tDllReqServiceId* pReqServiceId_p, UINT* pNodeId_p)
+{
+    tSoaPayload     soaPayload;
+
+    *pReqServiceId_p = kDllReqServiceNo;
+    *pNodeId_p = C_ADR_INVALID;
+    if (dllkcal_getSoaRequest(pReqServiceId_p, pNodeId_p, &soaPayload) != kErrorOk)
+        return FALSE;
+
+    return (*pReqServiceId_p != kDllReqServiceNo);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Producer thread of the stress test
+
+The thread issues Ident/StatusRequests like the event path and reports changing
+CN request counts like the Rx path. At the end it withdraws all CN requests.
+
+\param[in]      pArg_p              Unused thread argument.
+
+\return The function returns NULL.
+*/
+//------------------------------------------------------------------------------
+static void* stressProducer(void* pArg_p)
+{
+    UINT    loop;
+    UINT    nodeId;
+
+    UNUSED_PARAMETER(pArg_p);
+
+    for (loop = 0; loop < TEST_STRESS_LOOP_COUNT; loop++)
+    {
+        nodeId = (loop % TEST_STRESS_NODE_COUNT) + 1;
+        CU_ASSERT_EQUAL(dllkcal_issueRequest(kDllReqServiceIdent, nodeId, 0xFF), kErrorOk);
+        CU_ASSERT_EQUAL(dllkcal_issueRequest(kDllReqServiceStatus, nodeId, 0xFF), kErrorOk);
+        CU_ASSERT_EQUAL(dllkcal_setAsyncPendingRequests(nodeId,
+                                                        kDllAsyncReqPrioGeneric,
+                                                        (loop / TEST_STRESS_NODE_COUNT) % 3),
+                        kErrorOk);
+    }
+
+    for (nodeId = 1; nodeId <= TEST_STRESS_NODE_COUNT; nodeId++)
+        CU_ASSERT_EQUAL(dllkcal_setAsyncPendingRequests(nodeId, kDllAsyncReqPrioGeneric, 0), kErrorOk);
+
+    fStressDone_l = TRUE;
+    return NULL;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Consumer thread of the stress test
+
+The thread assigns asynchronous phases like the SoA path until the producer
+has finished.
+
+\param[in]      pArg_p              Unused thread argument.
+
+\return The function returns NULL.
+*/
+//------------------------------------------------------------------------------
+static void* stressConsumer(void* pArg_p)
+{
+    tDllReqServiceId    reqServiceId;
+    UINT                nodeId;
+
+    UNUSED_PARAMETER(pArg_p);
+
+    while (!fStressDone_l)
+    {
+        if (!getNextRequest(&reqServiceId, &nodeId))
+            sched_yield();
+    }
+
+    return NULL;
+}
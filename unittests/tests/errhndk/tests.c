@@ -0,0 +1,383 @@
+/**
+********************************************************************************
+\file   tests.c
+
+\brief  Unit tests for the MN Loss of PRes handling of the kernel error handler
+
+The file contains the unit tests for the Loss of PRes threshold counters
+(0x1C07 - 0x1C09) which are maintained by the kernel error handler of the MN.
+The counters are compared cycle by cycle with a reference model which processes
+every CN of the cycle's CN list, as the error handler did before it restricted
+the processing to the CNs with a pending event or a non-zero counter.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2017, B&R Industrial Automation GmbH
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <CUnit/CUnit.h>
+
+#include <kernel/errhnd/errhndk.c>
+
+#include "test-errhndk.h"
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define TEST_CN_COUNT               3       // CNs 1 - 3 are used by the tests
+#define TEST_THRESHOLD              15      // Loss of PRes threshold (0x1C09) of the CNs
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+/**
+\brief  Reference Loss of PRes state of a CN
+
+The structure contains the Loss of PRes state of a CN in the reference model.
+*/
+typedef struct
+{
+    UINT8               event;                  ///< Pending Loss of PRes event (ERRORHANDLERK_CN_LOSS_PRES_EVENT_*)
+    UINT32              cumulativeCnt;          ///< Cumulative counter (0x1C07)
+    UINT32              thresholdCnt;           ///< Threshold counter (0x1C08)
+} tRefCnLossPres;
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static void initTest(void);
+static void lossPres(UINT nodeId_p);
+static void resetCnError(UINT nodeId_p);
+static void writeCounters(UINT nodeId_p, UINT32 cumulativeCnt_p, UINT32 thresholdCnt_p);
+static void runCycles(UINT cycleCount_p);
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static const UINT8      aCnNodeIdList_l[TEST_CN_COUNT] = { 1, 2, 3 };
+static tRefCnLossPres   aRefCn_l[TEST_CN_COUNT];
+static UINT             refCnCount_l;
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test Loss of PRes threshold counter sequence
+
+The test runs a CN through Loss of PRes, exceeded threshold, reset of the error
+and recovery and checks that the counters follow the reference model in every
+cycle.
+*/
+//------------------------------------------------------------------------------
+void test_errhndk_mnCnLossPresSequence(void)
+{
+    initTest();
+
+    // CN 1 loses a single PRes and recovers
+    lossPres(1);
+    runCycles(10);
+
+    // CN 2 loses two consecutive PRes and exceeds the threshold
+    lossPres(2);
+    runCycles(1);
+    lossPres(2);
+    runCycles(1);
+    CU_ASSERT_EQUAL(instance_l.aMnCnLossPresEvent[1], ERRORHANDLERK_CN_LOSS_PRES_EVENT_THR);
+
+    // The threshold counter is written while the threshold is exceeded,
+    // it must not decay before the error is reset
+    writeCounters(2, aRefCn_l[1].cumulativeCnt, 5);
+    runCycles(5);
+    CU_ASSERT_EQUAL(errhndkcal_getMemPtr()->aMnCnLossPres[1].thresholdCnt, 5);
+
+    // After the reset the counter decays from the next cycle on
+    resetCnError(2);
+    runCycles(1);
+    CU_ASSERT_EQUAL(errhndkcal_getMemPtr()->aMnCnLossPres[1].thresholdCnt, 4);
+    runCycles(10);
+
+    // CN 2 loses a PRes again and recovers
+    lossPres(2);
+    runCycles(12);
+
+    // CN 3 is reset while a Loss of PRes event is pending
+    lossPres(3);
+    resetCnError(3);
+    runCycles(3);
+
+    // CN 3 is not polled for some cycles, its counter must not decay
+    refCnCount_l = 2;
+    stub_setCnNodeIdList(aCnNodeIdList_l, refCnCount_l);
+    runCycles(3);
+    refCnCount_l = TEST_CN_COUNT;
+    stub_setCnNodeIdList(aCnNodeIdList_l, refCnCount_l);
+    runCycles(10);
+
+    CU_ASSERT_EQUAL(instance_l.mnCnLossPresActiveCount, 0);
+
+    CU_ASSERT_EQUAL(errhndk_exit(), kErrorOk);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test Loss of PRes counters written by the OD
+
+The test writes the cumulative counter (0x1C07) and the threshold counter
+(0x1C08) as the object dictionary does and checks the counters against the
+reference model. A threshold counter written for a CN without pending event
+starts to decay at most NUM_DLL_MNCN_LOSSPRES_OBJS cycles later and then
+follows the reference sequence.
+*/
+//------------------------------------------------------------------------------
+void test_errhndk_mnCnLossPresOdWrite(void)
+{
+    UINT    cycle;
+
+    initTest();
+
+    // Cumulative counter written for a CN without pending event
+    writeCounters(1, 100, 0);
+    runCycles(3);
+    lossPres(1);
+    runCycles(10);
+    CU_ASSERT_EQUAL(errhndkcal_getMemPtr()->aMnCnLossPres[0].cumulativeCnt, 101);
+
+    // Threshold counter written for a CN with pending event
+    lossPres(2);
+    writeCounters(2, aRefCn_l[1].cumulativeCnt, 12);
+    runCycles(15);
+
+    // Threshold counter cleared for a CN with pending event
+    lossPres(2);
+    runCycles(2);
+    writeCounters(2, aRefCn_l[1].cumulativeCnt, 0);
+    runCycles(3);
+
+    // Threshold counter written for a CN without pending event
+    errhndkcal_getMemPtr()->aMnCnLossPres[2].thresholdCnt = 4;
+    for (cycle = 0; cycle < NUM_DLL_MNCN_LOSSPRES_OBJS; cycle++)
+    {
+        errhndk_decrementCounters(TRUE);
+        if (errhndkcal_getMemPtr()->aMnCnLossPres[2].thresholdCnt != 4)
+            break;
+    }
+
+    CU_ASSERT(cycle < NUM_DLL_MNCN_LOSSPRES_OBJS);
+    CU_ASSERT_EQUAL(errhndkcal_getMemPtr()->aMnCnLossPres[2].thresholdCnt, 3);
+
+    aRefCn_l[2].thresholdCnt = 3;
+    runCycles(5);
+
+    CU_ASSERT_EQUAL(instance_l.mnCnLossPresActiveCount, 0);
+
+    CU_ASSERT_EQUAL(errhndk_exit(), kErrorOk);
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Initialize the error handler and the reference model
+
+The function initializes the kernel error handler with the Loss of PRes
+threshold TEST_THRESHOLD for all test CNs and resets the reference model.
+*/
+//------------------------------------------------------------------------------
+static void initTest(void)
+{
+    UINT    nodeIdx;
+
+    CU_ASSERT_EQUAL_FATAL(errhndk_init(), kErrorOk);
+
+    for (nodeIdx = 0; nodeIdx < TEST_CN_COUNT; nodeIdx++)
+    {
+        OPLK_MEMSET(&aRefCn_l[nodeIdx], 0, sizeof(tRefCnLossPres));
+        instance_l.aMnCnLossPresEvent[nodeIdx] = ERRORHANDLERK_CN_LOSS_PRES_EVENT_NONE;
+        errhndkcal_getMemPtr()->aMnCnLossPres[nodeIdx].threshold = TEST_THRESHOLD;
+    }
+
+    refCnCount_l = TEST_CN_COUNT;
+    stub_setCnNodeIdList(aCnNodeIdList_l, refCnCount_l);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Report a Loss of PRes error
+
+The function reports a Loss of PRes error of a CN to the error handler and to
+the reference model.
+
+\param[in]      nodeId_p            Node ID of the CN.
+*/
+//------------------------------------------------------------------------------
+static void lossPres(UINT nodeId_p)
+{
+    tEvent              event;
+    tEventDllError      dllError;
+    tRefCnLossPres*     pRefCn = &aRefCn_l[nodeId_p - 1];
+
+    OPLK_MEMSET(&event, 0, sizeof(event));
+    OPLK_MEMSET(&dllError, 0, sizeof(dllError));
+    dllError.dllErrorEvents = DLL_ERR_MN_CN_LOSS_PRES;
+    dllError.nodeId = nodeId_p;
+    event.eventSink = kEventSinkErrk;
+    event.eventType = kEventTypeDllError;
+    event.eventArgSize = sizeof(dllError);
+    event.eventArg.pEventArg = &dllError;
+
+    CU_ASSERT_EQUAL(errhndk_process(&event), kErrorOk);
+
+    if (pRefCn->event != ERRORHANDLERK_CN_LOSS_PRES_EVENT_NONE)
+        return;
+
+    pRefCn->cumulativeCnt++;
+    pRefCn->thresholdCnt += 8;
+    if (pRefCn->thresholdCnt >= TEST_THRESHOLD)
+    {
+        pRefCn->event = ERRORHANDLERK_CN_LOSS_PRES_EVENT_THR;
+        pRefCn->thresholdCnt = 0;
+    }
+    else
+        pRefCn->event = ERRORHANDLERK_CN_LOSS_PRES_EVENT_OCC;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Reset the Loss of PRes error of a CN
+
+\param[in]      nodeId_p            Node ID of the CN.
+*/
+//------------------------------------------------------------------------------
+static void resetCnError(UINT nodeId_p)
+{
+    CU_ASSERT_EQUAL(errhndk_resetCnError(nodeId_p), kErrorOk);
+
+    aRefCn_l[nodeId_p - 1].event = ERRORHANDLERK_CN_LOSS_PRES_EVENT_NONE;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Write the Loss of PRes counters of a CN
+
+The function writes the counters of a CN in the shared error objects, as the
+object dictionary does, and in the reference model.
+
+\param[in]      nodeId_p            Node ID of the CN.
+\param[in]      cumulativeCnt_p     Cumulative counter (0x1C07).
+\param[in]      thresholdCnt_p      Threshold counter (0x1C08).
+*/
+//------------------------------------------------------------------------------
+static void writeCounters(UINT nodeId_p, UINT32 cumulativeCnt_p, UINT32 thresholdCnt_p)
+{
+    errhndkcal_getMemPtr()->aMnCnLossPres[nodeId_p - 1].cumulativeCnt = cumulativeCnt_p;
+    errhndkcal_getMemPtr()->aMnCnLossPres[nodeId_p - 1].thresholdCnt = thresholdCnt_p;
+
+    aRefCn_l[nodeId_p - 1].cumulativeCnt = cumulativeCnt_p;
+    aRefCn_l[nodeId_p - 1].thresholdCnt = thresholdCnt_p;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Run cycles and compare the counters
+
+The function finishes the given number of cycles in the error handler and in
+the reference model. After each cycle the counters of all test CNs are
+compared.
+
+\param[in]      cycleCount_p        Number of cycles to run.
+*/
+//------------------------------------------------------------------------------
+static void runCycles(UINT cycleCount_p)
+{
+    const tErrHndObjects*   pErrorObjects = errhndkcal_getMemPtr();
+    tRefCnLossPres*         pRefCn;
+    UINT                    i;
+
+    while (cycleCount_p-- > 0)
+    {
+        CU_ASSERT_EQUAL(errhndk_decrementCounters(TRUE), kErrorOk);
+
+        // The reference model processes every CN of the CN list
+        for (i = 0; i < refCnCount_l; i++)
+        {
+            pRefCn = &aRefCn_l[aCnNodeIdList_l[i] - 1];
+            switch (pRefCn->event)
+            {
+                case ERRORHANDLERK_CN_LOSS_PRES_EVENT_NONE:
+                    if (pRefCn->thresholdCnt > 0)
+                        pRefCn->thresholdCnt--;
+                    break;
+
+                case ERRORHANDLERK_CN_LOSS_PRES_EVENT_OCC:
+                    pRefCn->event = ERRORHANDLERK_CN_LOSS_PRES_EVENT_NONE;
+                    break;
+
+                default:
+                    break;
+            }
+        }
+
+        for (i = 0; i < TEST_CN_COUNT; i++)
+        {
+            CU_ASSERT_EQUAL(pErrorObjects->aMnCnLossPres[i].cumulativeCnt, aRefCn_l[i].cumulativeCnt);
+            CU_ASSERT_EQUAL(pErrorObjects->aMnCnLossPres[i].thresholdCnt, aRefCn_l[i].thresholdCnt);
+            CU_ASSERT_EQUAL(instance_l.aMnCnLossPresEvent[i], aRefCn_l[i].event);
+        }
+    }
+}
+
+/// \}
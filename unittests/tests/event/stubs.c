@@ -117,6 +117,12 @@ tOplkError pdokcal_process(const tEvent* pEvent_p)
     return kErrorOk;
 }
 
+tOplkError timesynck_process(const tEvent* pEvent_p)
+{
+    UNUSED_PARAMETER(pEvent_p);
+    return kErrorOk;
+}
+
 tOplkError eventkcal_postUserEvent(const tEvent* pEvent_p)
 {
     UNUSED_PARAMETER(pEvent_p);
@@ -0,0 +1,364 @@
+/**
+********************************************************************************
+\file   tests.c
+
+\brief  Unit tests for the object dictionary user module
+
+The file contains the unit tests for the OD lookup table and a benchmark of
+the OD entry reads. The tests use the object dictionary of the MN.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2017, B&R Industrial Automation GmbH
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <CUnit/CUnit.h>
+
+#include <user/obd/obdu.c>
+#include <obdcreate/obdcreate.h>
+
+#include <stdio.h>
+#include <time.h>
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define TEST_MAX_INDEX_COUNT        1024        // maximum number of indices of the OD
+#define TEST_MAX_RESULT_COUNT       (0x10000 + (TEST_MAX_INDEX_COUNT * 256))
+#define TEST_DATA_SIZE              1024        // size of the read buffer
+
+#define BENCH_ITERATIONS            200
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+typedef struct
+{
+    UINT16          index;
+    UINT8           subIndex;
+    tOplkError      ret;
+    tObdSize        size;
+    UINT32          dataHash;
+} tReadResult;
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static tOplkError initObd(void);
+static UINT       readAllEntries(tReadResult* paResult_p);
+static void       readEntry(UINT index_p, UINT subIndex_p, tReadResult* pResult_p);
+static ULONGLONG  benchmarkRead(const tReadResult* paEntry_p, UINT count_p);
+static tOplkError cbObdAccess(tObdCbParam* pParam_p, BOOL fUserEvent_p);
+static ULONGLONG  getTimeNs(void);
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static tObdInitParam    obdInitParam_l;
+static tReadResult      aResult_l[TEST_MAX_RESULT_COUNT];
+static tReadResult      aResultRef_l[TEST_MAX_RESULT_COUNT];
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test OD lookup table
+
+The test reads every index of the OD and every subindex of the existing
+indices with and without the lookup table and checks that the results are the
+same.
+*/
+//------------------------------------------------------------------------------
+void test_obdu_lookupTable(void)
+{
+    UINT    count;
+    UINT    refCount;
+    UINT    i;
+    UINT    mismatchCount = 0;
+
+    CU_ASSERT_EQUAL_FATAL(initObd(), kErrorOk);
+    CU_ASSERT_PTR_NOT_NULL(getLookupEntry(0x1000));
+
+    count = readAllEntries(aResult_l);
+    CU_ASSERT_FATAL(count < TEST_MAX_RESULT_COUNT);
+
+    // without the lookup table all entries are searched in the OD partitions
+    freeLookupTable();
+    CU_ASSERT_PTR_NULL(getLookupEntry(0x1000));
+    refCount = readAllEntries(aResultRef_l);
+
+    CU_ASSERT_EQUAL_FATAL(count, refCount);
+    for (i = 0; i < count; i++)
+    {
+        if ((aResult_l[i].index != aResultRef_l[i].index) ||
+            (aResult_l[i].subIndex != aResultRef_l[i].subIndex) ||
+            (aResult_l[i].ret != aResultRef_l[i].ret) ||
+            (aResult_l[i].size != aResultRef_l[i].size) ||
+            (aResult_l[i].dataHash != aResultRef_l[i].dataHash))
+            mismatchCount++;
+    }
+    CU_ASSERT_EQUAL(mismatchCount, 0);
+
+    // array elements are read through the private sub-index entries
+    CU_ASSERT_EQUAL(buildLookupTable(&obdInstance_l.initParam), kErrorOk);
+    CU_ASSERT_PTR_NOT_NULL(getLookupEntry(0x1F81));
+    if (getLookupEntry(0x1F81) != NULL)
+        CU_ASSERT_PTR_NOT_NULL(getLookupEntry(0x1F81)->paArraySubEntry);
+
+    CU_ASSERT_EQUAL(obdu_exit(), kErrorOk);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Benchmark OD entry reads
+
+The benchmark reads every existing entry of the OD with and without the lookup
+table.
+*/
+//------------------------------------------------------------------------------
+void test_obdu_benchmarkRead(void)
+{
+    static tReadResult  aEntry[TEST_MAX_RESULT_COUNT];
+    UINT                count;
+    UINT                entryCount = 0;
+    UINT                i;
+    ULONGLONG           lookupTime;
+    ULONGLONG           searchTime;
+
+    CU_ASSERT_EQUAL_FATAL(initObd(), kErrorOk);
+
+    count = readAllEntries(aResult_l);
+    for (i = 0; i < count; i++)
+    {
+        if (aResult_l[i].ret == kErrorOk)
+            aEntry[entryCount++] = aResult_l[i];
+    }
+    CU_ASSERT_FATAL(entryCount > 0);
+
+    lookupTime = benchmarkRead(aEntry, entryCount);
+
+    freeLookupTable();
+    searchTime = benchmarkRead(aEntry, entryCount);
+
+    printf("\n    %u OD entries, %u reads\n", entryCount, entryCount * BENCH_ITERATIONS);
+    printf("    partition search: %8.1f ns/read\n",
+           (double)searchTime / BENCH_ITERATIONS / entryCount);
+    printf("    lookup table:     %8.1f ns/read\n",
+           (double)lookupTime / BENCH_ITERATIONS / entryCount);
+
+    CU_ASSERT_EQUAL(obdu_exit(), kErrorOk);
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Initialize the OD
+
+The function initializes the OD module with the object dictionary of the MN.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError initObd(void)
+{
+    tOplkError  ret;
+
+    ret = obdcreate_initObd(&obdInitParam_l);
+    if (ret != kErrorOk)
+        return ret;
+
+    return obdu_init(&obdInitParam_l, cbObdAccess);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Read all OD entries
+
+The function reads subindex 0 of every index of the OD. For the existing
+indices all subindices are read.
+
+\param[out]     paResult_p          Array to store the read results.
+
+\return The function returns the number of stored read results.
+*/
+//------------------------------------------------------------------------------
+static UINT readAllEntries(tReadResult* paResult_p)
+{
+    UINT    index;
+    UINT    subIndex;
+    UINT    count = 0;
+
+    for (index = 0; (index < 0x10000) && (count < TEST_MAX_RESULT_COUNT); index++)
+    {
+        // indices outside of the OD parts are reported as illegal part
+        readEntry(index, 0, &paResult_p[count]);
+        if ((paResult_p[count].ret == kErrorObdIndexNotExist) ||
+            (paResult_p[count].ret == kErrorObdIllegalPart))
+        {
+            count++;
+            continue;
+        }
+        count++;
+
+        for (subIndex = 1; (subIndex < 256) && (count < TEST_MAX_RESULT_COUNT); subIndex++)
+            readEntry(index, subIndex, &paResult_p[count++]);
+    }
+
+    return count;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Read OD entry
+
+The function reads an OD entry and stores the result.
+
+\param[in]      index_p             Index of the entry.
+\param[in]      subIndex_p          Subindex of the entry.
+\param[out]     pResult_p           Pointer to store the read result.
+*/
+//------------------------------------------------------------------------------
+static void readEntry(UINT index_p, UINT subIndex_p, tReadResult* pResult_p)
+{
+    UINT8       aData[TEST_DATA_SIZE];
+    tObdSize    size = sizeof(aData);
+    tObdSize    i;
+    UINT32      hash = 0x811C9DC5;
+
+    OPLK_MEMSET(aData, 0, sizeof(aData));
+    pResult_p->index = (UINT16)index_p;
+    pResult_p->subIndex = (UINT8)subIndex_p;
+    pResult_p->ret = obdu_readEntry(index_p, subIndex_p, aData, &size);
+    pResult_p->size = size;
+
+    for (i = 0; (pResult_p->ret == kErrorOk) && (i < size) && (i < sizeof(aData)); i++)
+    {
+        hash ^= aData[i];
+        hash *= 0x01000193;
+    }
+    pResult_p->dataHash = hash;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Benchmark OD entry reads
+
+The function reads the given OD entries BENCH_ITERATIONS times.
+
+\param[in]      paEntry_p           Entries to be read.
+\param[in]      count_p             Number of entries.
+
+\return The function returns the time of all reads in ns.
+*/
+//------------------------------------------------------------------------------
+static ULONGLONG benchmarkRead(const tReadResult* paEntry_p, UINT count_p)
+{
+    UINT8       aData[TEST_DATA_SIZE];
+    tObdSize    size;
+    UINT        iteration;
+    UINT        i;
+    UINT        errorCount = 0;
+    ULONGLONG   startTime;
+
+    startTime = getTimeNs();
+    for (iteration = 0; iteration < BENCH_ITERATIONS; iteration++)
+    {
+        for (i = 0; i < count_p; i++)
+        {
+            size = sizeof(aData);
+            if (obdu_readEntry(paEntry_p[i].index, paEntry_p[i].subIndex, aData, &size) != kErrorOk)
+                errorCount++;
+        }
+    }
+
+    CU_ASSERT_EQUAL(errorCount, 0);
+
+    return getTimeNs() - startTime;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  OD access callback
+
+The function accepts all OD accesses.
+
+\param[in,out]  pParam_p            OD callback parameter.
+\param[in]      fUserEvent_p        Event is a user event.
+
+\return The function returns kErrorOk.
+*/
+//------------------------------------------------------------------------------
+static tOplkError cbObdAccess(tObdCbParam* pParam_p, BOOL fUserEvent_p)
+{
+    UNUSED_PARAMETER(pParam_p);
+    UNUSED_PARAMETER(fUserEvent_p);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get monotonic time
+
+\return The function returns the monotonic time in ns.
+*/
+//------------------------------------------------------------------------------
+static ULONGLONG getTimeNs(void)
+{
+    struct timespec time;
+
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return ((ULONGLONG)time.tv_sec * 1000000000ULL) + (ULONGLONG)time.tv_nsec;
+}
@@ -0,0 +1,228 @@
+/**
+********************************************************************************
+\file   stubs.c
+
+\brief  Stubs for PDO user module unit tests
+
+This file contains all stubs needed by the unit tests of the PDO user module.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2017, B&R Industrial Automation GmbH
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <common/oplkinc.h>
+#include <common/target.h>
+#include <user/pdoucal.h>
+#include <user/obdu.h>
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+tOplkError target_createMutex(const char* mutexName_p, OPLK_MUTEX_T* pMutex_p)
+{
+    UNUSED_PARAMETER(mutexName_p);
+    UNUSED_PARAMETER(pMutex_p);
+    return kErrorOk;
+}
+
+tOplkError target_lockMutex(OPLK_MUTEX_T mutexId_p)
+{
+    UNUSED_PARAMETER(mutexId_p);
+    return kErrorOk;
+}
+
+void target_unlockMutex(OPLK_MUTEX_T mutexId_p)
+{
+    UNUSED_PARAMETER(mutexId_p);
+}
+
+void target_destroyMutex(OPLK_MUTEX_T mutexId_p)
+{
+    UNUSED_PARAMETER(mutexId_p);
+}
+
+void target_msleep(UINT32 milliSeconds_p)
+{
+    UNUSED_PARAMETER(milliSeconds_p);
+}
+
+tOplkError obdu_readEntry(UINT index_p, UINT subIndex_p, void* pDstData_p, tObdSize* pSize_p)
+{
+    UNUSED_PARAMETER(index_p);
+    UNUSED_PARAMETER(subIndex_p);
+    UNUSED_PARAMETER(pDstData_p);
+    UNUSED_PARAMETER(pSize_p);
+    return kErrorObdIndexNotExist;
+}
+
+void* obdu_getObjectDataPtr(UINT index_p, UINT subIndex_p)
+{
+    UNUSED_PARAMETER(index_p);
+    UNUSED_PARAMETER(subIndex_p);
+    return NULL;
+}
+
+tObdSize obdu_getDataSize(UINT index_p, UINT subIndex_p)
+{
+    UNUSED_PARAMETER(index_p);
+    UNUSED_PARAMETER(subIndex_p);
+    return 0;
+}
+
+tOplkError obdu_isNumerical(UINT index_p, UINT subIndex_p, BOOL* pfEntryNumerical_p)
+{
+    UNUSED_PARAMETER(index_p);
+    UNUSED_PARAMETER(subIndex_p);
+    UNUSED_PARAMETER(pfEntryNumerical_p);
+    return kErrorObdIndexNotExist;
+}
+
+tOplkError obdu_getType(UINT index_p, UINT subIndex_p, tObdType* pType_p)
+{
+    UNUSED_PARAMETER(index_p);
+    UNUSED_PARAMETER(subIndex_p);
+    UNUSED_PARAMETER(pType_p);
+    return kErrorObdIndexNotExist;
+}
+
+tOplkError obdu_getAccessType(UINT index_p, UINT subIndex_p, tObdAccess* pAccessType_p)
+{
+    UNUSED_PARAMETER(index_p);
+    UNUSED_PARAMETER(subIndex_p);
+    UNUSED_PARAMETER(pAccessType_p);
+    return kErrorObdIndexNotExist;
+}
+
+tOplkError pdoucal_init(void)
+{
+    return kErrorOk;
+}
+
+tOplkError pdoucal_exit(void)
+{
+    return kErrorOk;
+}
+
+tOplkError pdoucal_postPdokChannelAlloc(const tPdoAllocationParam* pAllocationParam_p)
+{
+    UNUSED_PARAMETER(pAllocationParam_p);
+    return kErrorOk;
+}
+
+tOplkError pdoucal_postConfigureChannel(const tPdoChannelConf* pChannelConf_p)
+{
+    UNUSED_PARAMETER(pChannelConf_p);
+    return kErrorOk;
+}
+
+tOplkError pdoucal_postSetupPdoBuffers(size_t rxPdoMemSize_p, size_t txPdoMemSize_p)
+{
+    UNUSED_PARAMETER(rxPdoMemSize_p);
+    UNUSED_PARAMETER(txPdoMemSize_p);
+    return kErrorOk;
+}
+
+tOplkError pdoucal_initPdoMem(const tPdoChannelSetup* pPdoChannels_p,
+                              size_t rxPdoMemSize_p,
+                              size_t txPdoMemSize_p)
+{
+    UNUSED_PARAMETER(pPdoChannels_p);
+    UNUSED_PARAMETER(rxPdoMemSize_p);
+    UNUSED_PARAMETER(txPdoMemSize_p);
+    return kErrorOk;
+}
+
+void pdoucal_cleanupPdoMem(void)
+{
+}
+
+void* pdoucal_getTxPdoAdrs(UINT8 channelId_p)
+{
+    UNUSED_PARAMETER(channelId_p);
+    return NULL;
+}
+
+tOplkError pdoucal_setTxPdo(UINT8 channelId_p, void* pPdo_p, size_t pdoSize_p)
+{
+    UNUSED_PARAMETER(channelId_p);
+    UNUSED_PARAMETER(pPdo_p);
+    UNUSED_PARAMETER(pdoSize_p);
+    return kErrorOk;
+}
+
+tOplkError pdoucal_getRxPdo(void** ppPdo_p, UINT8 channelId_p, size_t pdoSize_p)
+{
+    UNUSED_PARAMETER(ppPdo_p);
+    UNUSED_PARAMETER(channelId_p);
+    UNUSED_PARAMETER(pdoSize_p);
+    return kErrorOk;
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
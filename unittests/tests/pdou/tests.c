@@ -0,0 +1,444 @@
+/**
+********************************************************************************
+\file   tests.c
+
+\brief  Unit test functions for PDO user module
+
+This file contains the unit test functions for the PDO user module. The module
+source is included, so that the compiled copy operations can be compared with
+the per-object copy functions which they replace.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2017, B&R Industrial Automation GmbH
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <CUnit/CUnit.h>
+
+#include <user/pdo/pdou.c>
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define TEST_CHANNEL_OFFSET         4       // offset of the tested channel in the frame
+#define TEST_VAR_SIZE               1024    // size of the variable memory of a channel
+#define TEST_PDO_SIZE               1024    // size of the PDO buffer of a channel
+
+#define BENCH_CHANNEL_COUNT         240     // one RPDO channel per CN
+#define BENCH_ITERATIONS            2000
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static UINT  setupMapping(tPdoChannel* pChannel_p,
+                          tPdoMappObject* pMappObject_p,
+                          UINT8* pVar_p,
+                          const tObdType* pType_p,
+                          UINT typeCount_p);
+static UINT  getTypeSize(tObdType type_p);
+static void  fillPattern(UINT8* pBuffer_p, size_t size_p, UINT seed_p);
+static ULONGLONG getTimeNs(void);
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+
+// A mapping with a 24 bit value in the middle of native sized values
+static const tObdType aMixedMapping_l[] =
+{
+    kObdTypeUInt8, kObdTypeUInt16, kObdTypeUInt32, kObdTypeUInt64,
+    kObdTypeUInt24,
+    kObdTypeInt8, kObdTypeInt16, kObdTypeInt32, kObdTypeReal32, kObdTypeReal64,
+    kObdTypeUInt48,
+    kObdTypeUInt16, kObdTypeUInt16
+};
+
+// A typical mapping of a CN with digital and analog channels
+static const tObdType aBenchMapping_l[] =
+{
+    kObdTypeUInt8, kObdTypeUInt8, kObdTypeUInt8, kObdTypeUInt8,
+    kObdTypeUInt8, kObdTypeUInt8, kObdTypeUInt8, kObdTypeUInt8,
+    kObdTypeUInt16, kObdTypeUInt16, kObdTypeUInt16, kObdTypeUInt16,
+    kObdTypeUInt16, kObdTypeUInt16, kObdTypeUInt16, kObdTypeUInt16,
+    kObdTypeInt32, kObdTypeInt32, kObdTypeInt32, kObdTypeInt32,
+    kObdTypeReal32, kObdTypeReal32, kObdTypeReal32, kObdTypeReal32,
+    kObdTypeUInt24,
+    kObdTypeUInt64, kObdTypeUInt64,
+    kObdTypeUInt8, kObdTypeUInt8, kObdTypeUInt8, kObdTypeUInt8
+};
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test the compilation of PDO copy operations
+
+The test checks that adjacent objects without conversion are merged and that
+objects with conversion and gaps in memory split the copy operations.
+*/
+//------------------------------------------------------------------------------
+void test_pdou_compileCopyOps(void)
+{
+    static const tObdType   aNativeMapping[] = {kObdTypeUInt8, kObdTypeUInt16, kObdTypeUInt32, kObdTypeUInt64};
+    tPdoChannel             channel;
+    tPdoMappObject          aMappObject[D_PDO_RPDOChannelObjects_U8];
+    tPdoCopyOp              aCopyOp[D_PDO_RPDOChannelObjects_U8];
+    UINT16                  copyOpCount;
+    UINT8                   aVar[TEST_VAR_SIZE];
+
+    // Native sized objects are merged into a single operation
+    setupMapping(&channel, aMappObject, aVar, aNativeMapping, tabentries(aNativeMapping));
+    compileCopyOps(&channel, aMappObject, aCopyOp, &copyOpCount);
+    CU_ASSERT_EQUAL(copyOpCount, 1);
+    CU_ASSERT_EQUAL(aCopyOp[0].type, kPdoCopyOpMemcpy);
+    CU_ASSERT_EQUAL(aCopyOp[0].pdoOffset, 0);
+    CU_ASSERT_EQUAL(aCopyOp[0].size, 15);
+    CU_ASSERT(aCopyOp[0].pVar == aVar);
+
+    // Values without native size split the operations
+    setupMapping(&channel, aMappObject, aVar, aMixedMapping_l, tabentries(aMixedMapping_l));
+    compileCopyOps(&channel, aMappObject, aCopyOp, &copyOpCount);
+    CU_ASSERT_EQUAL(copyOpCount, 5);
+    CU_ASSERT_EQUAL(aCopyOp[0].type, kPdoCopyOpMemcpy);
+    CU_ASSERT_EQUAL(aCopyOp[0].size, 15);
+    CU_ASSERT_EQUAL(aCopyOp[1].type, kPdoCopyOpConvert);
+    CU_ASSERT(aCopyOp[1].pMappObject == &aMappObject[4]);
+    CU_ASSERT_EQUAL(aCopyOp[2].type, kPdoCopyOpMemcpy);
+    CU_ASSERT_EQUAL(aCopyOp[2].pdoOffset, 18);
+    CU_ASSERT_EQUAL(aCopyOp[2].size, 19);
+    CU_ASSERT_EQUAL(aCopyOp[3].type, kPdoCopyOpConvert);
+    CU_ASSERT_EQUAL(aCopyOp[4].type, kPdoCopyOpMemcpy);
+    CU_ASSERT_EQUAL(aCopyOp[4].size, 4);
+
+    // A gap in memory splits a run of objects
+    setupMapping(&channel, aMappObject, aVar, aNativeMapping, tabentries(aNativeMapping));
+    PDO_MAPPOBJECT_SET_VAR((&aMappObject[2]), &aVar[512]);
+    compileCopyOps(&channel, aMappObject, aCopyOp, &copyOpCount);
+    CU_ASSERT_EQUAL(copyOpCount, 3);
+    CU_ASSERT_EQUAL(aCopyOp[0].size, 3);
+    CU_ASSERT_EQUAL(aCopyOp[1].size, 4);
+    CU_ASSERT_EQUAL(aCopyOp[2].size, 8);
+
+    // An unused channel has no operations
+    channel.nodeId = PDO_INVALID_NODE_ID;
+    compileCopyOps(&channel, aMappObject, aCopyOp, &copyOpCount);
+    CU_ASSERT_EQUAL(copyOpCount, 0);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test the compiled RXPDO copy
+
+The test checks that the compiled copy operations store the same variable
+values as the per-object copy.
+*/
+//------------------------------------------------------------------------------
+void test_pdou_copyRxCompiled(void)
+{
+    tPdoChannel             channel;
+    tPdoMappObject          aMappObject[D_PDO_RPDOChannelObjects_U8];
+    tPdoCopyOp              aCopyOp[D_PDO_RPDOChannelObjects_U8];
+    UINT16                  copyOpCount;
+    UINT8                   aPdo[TEST_PDO_SIZE];
+    UINT8                   aVar[TEST_VAR_SIZE];
+    UINT8                   aVarRef[TEST_VAR_SIZE];
+    UINT                    varSize;
+    UINT                    i;
+
+    varSize = setupMapping(&channel, aMappObject, aVar, aMixedMapping_l, tabentries(aMixedMapping_l));
+    compileCopyOps(&channel, aMappObject, aCopyOp, &copyOpCount);
+    fillPattern(aPdo, sizeof(aPdo), 1);
+
+    // Reference by the per-object copy
+    OPLK_MEMSET(aVar, 0, sizeof(aVar));
+    for (i = 0; i < channel.mappObjectCount; i++)
+        CU_ASSERT_EQUAL(copyVarFromPdo(aPdo, &aMappObject[i], channel.offset), kErrorOk);
+    OPLK_MEMCPY(aVarRef, aVar, sizeof(aVarRef));
+
+    OPLK_MEMSET(aVar, 0, sizeof(aVar));
+    CU_ASSERT_EQUAL(executeRxCopyOps(aPdo, aCopyOp, copyOpCount, channel.offset), kErrorOk);
+    CU_ASSERT(OPLK_MEMCMP(aVar, aVarRef, varSize) == 0);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test the compiled TXPDO copy
+
+The test checks that the compiled copy operations produce the same PDO as the
+per-object copy.
+*/
+//------------------------------------------------------------------------------
+void test_pdou_copyTxCompiled(void)
+{
+    tPdoChannel             channel;
+    tPdoMappObject          aMappObject[D_PDO_TPDOChannelObjects_U8];
+    tPdoCopyOp              aCopyOp[D_PDO_TPDOChannelObjects_U8];
+    UINT16                  copyOpCount;
+    UINT8                   aPdo[TEST_PDO_SIZE];
+    UINT8                   aPdoRef[TEST_PDO_SIZE];
+    UINT8                   aVar[TEST_VAR_SIZE];
+    UINT                    pdoSize;
+    UINT                    i;
+
+    pdoSize = setupMapping(&channel, aMappObject, aVar, aMixedMapping_l, tabentries(aMixedMapping_l));
+    compileCopyOps(&channel, aMappObject, aCopyOp, &copyOpCount);
+    fillPattern(aVar, sizeof(aVar), 2);
+
+    // Reference by the per-object copy
+    OPLK_MEMSET(aPdoRef, 0, sizeof(aPdoRef));
+    for (i = 0; i < channel.mappObjectCount; i++)
+        CU_ASSERT_EQUAL(copyVarToPdo(aPdoRef, &aMappObject[i], channel.offset), kErrorOk);
+
+    OPLK_MEMSET(aPdo, 0, sizeof(aPdo));
+    CU_ASSERT_EQUAL(executeTxCopyOps(aPdo, aCopyOp, copyOpCount, channel.offset), kErrorOk);
+    CU_ASSERT(OPLK_MEMCMP(aPdo, aPdoRef, pdoSize) == 0);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Benchmark the PDO copy of a large mapping
+
+The test copies the RXPDOs of 240 CNs with a typical mapping by the per-object
+copy and by the compiled copy operations and prints the time per cycle.
+*/
+//------------------------------------------------------------------------------
+void test_pdou_benchmarkCopy(void)
+{
+    static tPdoMappObject   aMappObject[BENCH_CHANNEL_COUNT][tabentries(aBenchMapping_l)];
+    static tPdoCopyOp       aCopyOp[BENCH_CHANNEL_COUNT][tabentries(aBenchMapping_l)];
+    static UINT8            aPdo[BENCH_CHANNEL_COUNT][TEST_PDO_SIZE];
+    static UINT8            aVar[BENCH_CHANNEL_COUNT][TEST_VAR_SIZE];
+    static UINT8            aVarRef[BENCH_CHANNEL_COUNT][TEST_VAR_SIZE];
+    tPdoChannel             aChannel[BENCH_CHANNEL_COUNT];
+    UINT16                  aCopyOpCount[BENCH_CHANNEL_COUNT];
+    UINT                    varSize = 0;
+    UINT                    opCount = 0;
+    UINT                    channel;
+    UINT                    iteration;
+    UINT                    i;
+    ULONGLONG               startTime;
+    ULONGLONG               perObjectTime;
+    ULONGLONG               compiledTime;
+
+    for (channel = 0; channel < BENCH_CHANNEL_COUNT; channel++)
+    {
+        varSize = setupMapping(&aChannel[channel], aMappObject[channel], aVar[channel],
+                               aBenchMapping_l, tabentries(aBenchMapping_l));
+        compileCopyOps(&aChannel[channel], aMappObject[channel], aCopyOp[channel], &aCopyOpCount[channel]);
+        opCount += aCopyOpCount[channel];
+        fillPattern(aPdo[channel], TEST_PDO_SIZE, channel);
+    }
+
+    startTime = getTimeNs();
+    for (iteration = 0; iteration < BENCH_ITERATIONS; iteration++)
+    {
+        for (channel = 0; channel < BENCH_CHANNEL_COUNT; channel++)
+        {
+            for (i = 0; i < aChannel[channel].mappObjectCount; i++)
+                copyVarFromPdo(aPdo[channel], &aMappObject[channel][i], aChannel[channel].offset);
+        }
+    }
+    perObjectTime = getTimeNs() - startTime;
+    OPLK_MEMCPY(aVarRef, aVar, sizeof(aVarRef));
+    OPLK_MEMSET(aVar, 0, sizeof(aVar));
+
+    startTime = getTimeNs();
+    for (iteration = 0; iteration < BENCH_ITERATIONS; iteration++)
+    {
+        for (channel = 0; channel < BENCH_CHANNEL_COUNT; channel++)
+        {
+            executeRxCopyOps(aPdo[channel], aCopyOp[channel], aCopyOpCount[channel],
+                             aChannel[channel].offset);
+        }
+    }
+    compiledTime = getTimeNs() - startTime;
+
+    for (channel = 0; channel < BENCH_CHANNEL_COUNT; channel++)
+        CU_ASSERT(OPLK_MEMCMP(aVar[channel], aVarRef[channel], varSize) == 0);
+
+    printf("\n    %u channels, %u objects, %u copy operations per cycle\n",
+           BENCH_CHANNEL_COUNT,
+           (UINT)(BENCH_CHANNEL_COUNT * tabentries(aBenchMapping_l)),
+           opCount);
+    printf("    per-object copy: %8.2f us/cycle\n", (double)perObjectTime / BENCH_ITERATIONS / 1000.0);
+    printf("    compiled copy:   %8.2f us/cycle\n", (double)compiledTime / BENCH_ITERATIONS / 1000.0);
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Set up a PDO mapping
+
+The function sets up a channel which maps the objects of the given types. The
+objects are adjacent in the PDO as well as in the variable memory.
+
+\param[out]     pChannel_p          Pointer to the channel to be set up.
+\param[out]     pMappObject_p       Pointer to the mapping objects of the channel.
+\param[in]      pVar_p              Pointer to the variable memory.
+\param[in]      pType_p             Pointer to the types of the mapped objects.
+\param[in]      typeCount_p         Number of mapped objects.
+
+\return The function returns the size of the mapped data in bytes.
+*/
+//------------------------------------------------------------------------------
+static UINT setupMapping(tPdoChannel* pChannel_p,
+                         tPdoMappObject* pMappObject_p,
+                         UINT8* pVar_p,
+                         const tObdType* pType_p,
+                         UINT typeCount_p)
+{
+    UINT    offset = 0;
+    UINT    size;
+    UINT    i;
+
+    OPLK_MEMSET(pChannel_p, 0, sizeof(*pChannel_p));
+    pChannel_p->nodeId = 1;
+    pChannel_p->offset = TEST_CHANNEL_OFFSET;
+    pChannel_p->mappObjectCount = typeCount_p;
+
+    for (i = 0; i < typeCount_p; i++, pMappObject_p++)
+    {
+        size = getTypeSize(pType_p[i]);
+        PDO_MAPPOBJECT_SET_VAR(pMappObject_p, pVar_p + offset);
+        PDO_MAPPOBJECT_SET_BITOFFSET(pMappObject_p, (UINT16)((TEST_CHANNEL_OFFSET + offset) * 8));
+        PDO_MAPPOBJECT_SET_BYTESIZE_OR_TYPE(pMappObject_p, size, pType_p[i]);
+        offset += size;
+    }
+
+    pChannel_p->nextChannelOffset = (UINT16)(TEST_CHANNEL_OFFSET + offset);
+
+    return offset;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get the size of an object type
+
+\param[in]      type_p              Object type.
+
+\return The function returns the size of the type in bytes.
+*/
+//------------------------------------------------------------------------------
+static UINT getTypeSize(tObdType type_p)
+{
+    switch (type_p)
+    {
+        case kObdTypeUInt16:
+        case kObdTypeInt16:
+            return 2;
+
+        case kObdTypeUInt24:
+            return 3;
+
+        case kObdTypeUInt32:
+        case kObdTypeInt32:
+        case kObdTypeReal32:
+            return 4;
+
+        case kObdTypeUInt48:
+            return 6;
+
+        case kObdTypeUInt64:
+        case kObdTypeReal64:
+            return 8;
+
+        default:
+            return 1;
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Fill a buffer with a test pattern
+
+\param[out]     pBuffer_p           Pointer to the buffer.
+\param[in]      size_p              Size of the buffer.
+\param[in]      seed_p              Seed of the pattern.
+*/
+//------------------------------------------------------------------------------
+static void fillPattern(UINT8* pBuffer_p, size_t size_p, UINT seed_p)
+{
+    size_t  i;
+
+    for (i = 0; i < size_p; i++)
+        pBuffer_p[i] = (UINT8)((i * 131) + (seed_p * 17) + 7);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get a monotonic time stamp
+
+\return The function returns the time stamp in nanoseconds.
+*/
+//------------------------------------------------------------------------------
+static ULONGLONG getTimeNs(void)
+{
+    struct timespec time;
+
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return ((ULONGLONG)time.tv_sec * 1000000000ULL) + (ULONGLONG)time.tv_nsec;
+}
+
+/// \}
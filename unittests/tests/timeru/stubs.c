@@ -0,0 +1,154 @@
+/**
+********************************************************************************
+\file   stubs.c
+
+\brief  Stubs for the unit tests of the Linux user timer module
+
+The file contains the stubs of the modules used by the Linux user timer module.
+The posted timer events are recorded for the tests.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2017, B&R Industrial Automation GmbH
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <common/oplkinc.h>
+#include <common/target.h>
+#include <user/eventu.h>
+
+#include <pthread.h>
+
+#include "test-timeru.h"
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static pthread_mutex_t  timerEventMutex_l = PTHREAD_MUTEX_INITIALIZER;
+static tStubTimerEvent  aTimerEvent_l[STUB_MAX_TIMER_EVENTS];
+static UINT             timerEventCount_l = 0;
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+tOplkError eventu_postEvent(const tEvent* pEvent_p)
+{
+    const tTimerEventArg*   pTimerEventArg = (const tTimerEventArg*)pEvent_p->eventArg.pEventArg;
+
+    pthread_mutex_lock(&timerEventMutex_l);
+    if (timerEventCount_l < STUB_MAX_TIMER_EVENTS)
+    {
+        aTimerEvent_l[timerEventCount_l].timerHdl = pTimerEventArg->timerHdl.handle;
+        aTimerEvent_l[timerEventCount_l].argument = pTimerEventArg->argument.value;
+    }
+    timerEventCount_l++;
+    pthread_mutex_unlock(&timerEventMutex_l);
+
+    return kErrorOk;
+}
+
+tOplkError target_registerThread(tOplkThreadRole role_p,
+                                 pthread_t thread_p,
+                                 tOplkThreadPolicy defaultPolicy_p,
+                                 UINT defaultPriority_p,
+                                 const char* pDefaultName_p)
+{
+    UNUSED_PARAMETER(role_p);
+    UNUSED_PARAMETER(thread_p);
+    UNUSED_PARAMETER(defaultPolicy_p);
+    UNUSED_PARAMETER(defaultPriority_p);
+    UNUSED_PARAMETER(pDefaultName_p);
+    return kErrorOk;
+}
+
+void target_unregisterThread(tOplkThreadRole role_p,
+                             pthread_t thread_p)
+{
+    UNUSED_PARAMETER(role_p);
+    UNUSED_PARAMETER(thread_p);
+}
+
+UINT stub_getTimerEvents(tStubTimerEvent* aTimerEvent_p,
+                         UINT maxCount_p)
+{
+    UINT    count;
+    UINT    i;
+
+    pthread_mutex_lock(&timerEventMutex_l);
+    count = timerEventCount_l;
+    for (i = 0; (i < count) && (i < maxCount_p) && (i < STUB_MAX_TIMER_EVENTS); i++)
+        aTimerEvent_p[i] = aTimerEvent_l[i];
+    pthread_mutex_unlock(&timerEventMutex_l);
+
+    return count;
+}
+
+void stub_resetTimerEvents(void)
+{
+    pthread_mutex_lock(&timerEventMutex_l);
+    timerEventCount_l = 0;
+    pthread_mutex_unlock(&timerEventMutex_l);
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
@@ -0,0 +1,84 @@
+/**
+********************************************************************************
+\file   test-timeru.h
+
+\brief  Definitions for unit tests of Linux user timer module
+
+The file contains the definitions for the unit tests of Linux user timer module.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2017, B&R Industrial Automation GmbH
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+#ifndef _INC_test_timeru_H_
+#define _INC_test_timeru_H_
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <common/oplkinc.h>
+#include <common/timer.h>
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define STUB_MAX_TIMER_EVENTS       16      // timer events recorded by the stub of eventu_postEvent()
+
+//------------------------------------------------------------------------------
+// typedef
+//------------------------------------------------------------------------------
+/**
+\brief Timer event recorded by the stub of eventu_postEvent()
+*/
+typedef struct
+{
+    tTimerHdl           timerHdl;           ///< Handle of the expired timer
+    UINT32              argument;           ///< Argument of the expired timer
+} tStubTimerEvent;
+
+//------------------------------------------------------------------------------
+// function prototypes
+//------------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void test_timeru_wheel(void);
+void test_timeru_expiry(void);
+void test_timeru_benchmark(void);
+
+UINT stub_getTimerEvents(tStubTimerEvent* aTimerEvent_p,
+                         UINT maxCount_p);
+void stub_resetTimerEvents(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _INC_test_timeru_H_ */
@@ -0,0 +1,379 @@
+/**
+********************************************************************************
+\file   tests.c
+
+\brief  Unit tests for the Linux user timer module
+
+The file contains the unit tests for the timer wheel of the Linux user timer
+module and a benchmark of setting, modifying and deleting timers.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2017, B&R Industrial Automation GmbH
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <CUnit/CUnit.h>
+
+#include <user/timer/timer-linuxuser.c>
+
+#include "test-timeru.h"
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define TEST_TIMER_COUNT            10000       // timers set by the wheel test and the benchmark
+#define TEST_MIN_TIMEOUT            1000        // [ms] no timer expires while the tests run
+#define TEST_TIMEOUT_RANGE          4000000     // [ms] timeouts are spread over all wheel levels
+#define TEST_EXPIRY_TIMEOUT         1000        // [ms] maximum time to wait for timer events
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static ULONG        getTimeout(UINT timer_p, UINT seed_p);
+static UINT         countWheelTimers(void);
+static ULONGLONG    getTimeNs(void);
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static tTimerHdl    aTimerHdl_l[TEST_TIMER_COUNT];
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test timer wheel
+
+The test sets, modifies and deletes timers with timeouts on all wheel levels
+and checks that every running timer is linked into exactly one wheel slot.
+*/
+//------------------------------------------------------------------------------
+void test_timeru_wheel(void)
+{
+    tTimerArg   timerArg;
+    tTimerHdl   timerHdl = 0;
+    UINT        i;
+    UINT        errorCount = 0;
+
+    CU_ASSERT_EQUAL_FATAL(timeru_init(), kErrorOk);
+
+    CU_ASSERT_EQUAL(timeru_setTimer(NULL, TEST_MIN_TIMEOUT, &timerArg), kErrorTimerInvalidHandle);
+    CU_ASSERT_EQUAL(timeru_modifyTimer(NULL, TEST_MIN_TIMEOUT, &timerArg), kErrorTimerInvalidHandle);
+    CU_ASSERT_EQUAL(timeru_deleteTimer(NULL), kErrorTimerInvalidHandle);
+    CU_ASSERT_EQUAL(timeru_deleteTimer(&timerHdl), kErrorOk);
+    CU_ASSERT_FALSE(timeru_isActive(timerHdl));
+
+    OPLK_MEMSET(&timerArg, 0, sizeof(timerArg));
+    timerArg.eventSink = kEventSinkApi;
+    for (i = 0; i < TEST_TIMER_COUNT; i++)
+    {
+        aTimerHdl_l[i] = 0;
+        timerArg.argument.value = i;
+        if (timeru_setTimer(&aTimerHdl_l[i], getTimeout(i, 1), &timerArg) != kErrorOk)
+            errorCount++;
+    }
+    CU_ASSERT_EQUAL_FATAL(errorCount, 0);
+    CU_ASSERT_EQUAL(timeruInstance_g.activeCount, TEST_TIMER_COUNT);
+    CU_ASSERT_EQUAL(countWheelTimers(), TEST_TIMER_COUNT);
+
+    // a modified timer moves to the slot of its new expiry time
+    for (i = 0; i < TEST_TIMER_COUNT; i++)
+    {
+        if ((timeru_modifyTimer(&aTimerHdl_l[i], getTimeout(i, 2), &timerArg) != kErrorOk) ||
+            !timeru_isActive(aTimerHdl_l[i]))
+            errorCount++;
+    }
+    CU_ASSERT_EQUAL(errorCount, 0);
+    CU_ASSERT_EQUAL(timeruInstance_g.activeCount, TEST_TIMER_COUNT);
+    CU_ASSERT_EQUAL(countWheelTimers(), TEST_TIMER_COUNT);
+
+    for (i = 0; i < TEST_TIMER_COUNT; i += 2)
+    {
+        if ((timeru_deleteTimer(&aTimerHdl_l[i]) != kErrorOk) || (aTimerHdl_l[i] != 0))
+            errorCount++;
+    }
+    CU_ASSERT_EQUAL(errorCount, 0);
+    CU_ASSERT_EQUAL(timeruInstance_g.activeCount, TEST_TIMER_COUNT / 2);
+    CU_ASSERT_EQUAL(countWheelTimers(), TEST_TIMER_COUNT / 2);
+
+    // timeouts beyond the range of the wheel are kept in the last level
+    CU_ASSERT_EQUAL(timeru_modifyTimer(&timerHdl, ~(ULONG)0 / 2, &timerArg), kErrorOk);
+    CU_ASSERT_TRUE(timeru_isActive(timerHdl));
+    CU_ASSERT_EQUAL(countWheelTimers(), (TEST_TIMER_COUNT / 2) + 1);
+    CU_ASSERT_EQUAL(timeru_deleteTimer(&timerHdl), kErrorOk);
+
+    for (i = 1; i < TEST_TIMER_COUNT; i += 2)
+    {
+        if (timeru_deleteTimer(&aTimerHdl_l[i]) != kErrorOk)
+            errorCount++;
+    }
+    CU_ASSERT_EQUAL(errorCount, 0);
+    CU_ASSERT_EQUAL(timeruInstance_g.activeCount, 0);
+    CU_ASSERT_EQUAL(countWheelTimers(), 0);
+    CU_ASSERT_PTR_NULL(timeruInstance_g.pFirstTimer);
+
+    CU_ASSERT_EQUAL(timeru_exit(), kErrorOk);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test timer expiry
+
+The test checks that the timer events are posted in the order of the expiry
+times, not before the timeouts elapsed, and that a deleted timer is not posted.
+*/
+//------------------------------------------------------------------------------
+void test_timeru_expiry(void)
+{
+    tStubTimerEvent aTimerEvent[STUB_MAX_TIMER_EVENTS];
+    tTimerArg       timerArg;
+    tTimerHdl       aTimerHdl[3] = { 0, 0, 0 };
+    ULONGLONG       startTime;
+    ULONGLONG       elapsedTime;
+    UINT            count;
+
+    CU_ASSERT_EQUAL_FATAL(timeru_init(), kErrorOk);
+    stub_resetTimerEvents();
+
+    OPLK_MEMSET(&timerArg, 0, sizeof(timerArg));
+    timerArg.eventSink = kEventSinkApi;
+    startTime = getTimeNs();
+
+    timerArg.argument.value = 0;
+    CU_ASSERT_EQUAL(timeru_setTimer(&aTimerHdl[0], 50, &timerArg), kErrorOk);
+    timerArg.argument.value = 1;
+    CU_ASSERT_EQUAL(timeru_setTimer(&aTimerHdl[1], 20, &timerArg), kErrorOk);
+    timerArg.argument.value = 2;
+    CU_ASSERT_EQUAL(timeru_setTimer(&aTimerHdl[2], 30, &timerArg), kErrorOk);
+    CU_ASSERT_EQUAL(timeru_deleteTimer(&aTimerHdl[2]), kErrorOk);
+
+    do
+    {
+        usleep(1000);
+        count = stub_getTimerEvents(aTimerEvent, STUB_MAX_TIMER_EVENTS);
+        elapsedTime = getTimeNs() - startTime;
+    } while ((count < 2) && (elapsedTime < TEST_EXPIRY_TIMEOUT * 1000000ULL));
+
+    // wait for a late event of the deleted timer
+    usleep(50000);
+    count = stub_getTimerEvents(aTimerEvent, STUB_MAX_TIMER_EVENTS);
+
+    CU_ASSERT_EQUAL_FATAL(count, 2);
+    CU_ASSERT_EQUAL(aTimerEvent[0].timerHdl, aTimerHdl[1]);
+    CU_ASSERT_EQUAL(aTimerEvent[0].argument, 1);
+    CU_ASSERT_EQUAL(aTimerEvent[1].timerHdl, aTimerHdl[0]);
+    CU_ASSERT_EQUAL(aTimerEvent[1].argument, 0);
+    CU_ASSERT(elapsedTime >= 50 * 1000000ULL);
+
+    CU_ASSERT_FALSE(timeru_isActive(aTimerHdl[0]));
+    CU_ASSERT_FALSE(timeru_isActive(aTimerHdl[1]));
+    CU_ASSERT_EQUAL(timeruInstance_g.activeCount, 0);
+
+    // an expired timer can be restarted
+    CU_ASSERT_EQUAL(timeru_modifyTimer(&aTimerHdl[1], 10, &timerArg), kErrorOk);
+    CU_ASSERT_TRUE(timeru_isActive(aTimerHdl[1]));
+
+    CU_ASSERT_EQUAL(timeru_deleteTimer(&aTimerHdl[0]), kErrorOk);
+    CU_ASSERT_EQUAL(timeru_deleteTimer(&aTimerHdl[1]), kErrorOk);
+    CU_ASSERT_EQUAL(timeru_exit(), kErrorOk);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Benchmark timer operations
+
+The benchmark sets, modifies and deletes TEST_TIMER_COUNT timers with
+timeouts on all wheel levels.
+*/
+//------------------------------------------------------------------------------
+void test_timeru_benchmark(void)
+{
+    tTimerArg   timerArg;
+    ULONGLONG   setTime;
+    ULONGLONG   modifyTime;
+    ULONGLONG   deleteTime;
+    UINT        i;
+    UINT        errorCount = 0;
+
+    CU_ASSERT_EQUAL_FATAL(timeru_init(), kErrorOk);
+
+    OPLK_MEMSET(&timerArg, 0, sizeof(timerArg));
+    timerArg.eventSink = kEventSinkApi;
+    for (i = 0; i < TEST_TIMER_COUNT; i++)
+        aTimerHdl_l[i] = 0;
+
+    setTime = getTimeNs();
+    for (i = 0; i < TEST_TIMER_COUNT; i++)
+    {
+        if (timeru_setTimer(&aTimerHdl_l[i], getTimeout(i, 1), &timerArg) != kErrorOk)
+            errorCount++;
+    }
+    setTime = getTimeNs() - setTime;
+
+    modifyTime = getTimeNs();
+    for (i = 0; i < TEST_TIMER_COUNT; i++)
+    {
+        if (timeru_modifyTimer(&aTimerHdl_l[i], getTimeout(i, 2), &timerArg) != kErrorOk)
+            errorCount++;
+    }
+    modifyTime = getTimeNs() - modifyTime;
+
+    deleteTime = getTimeNs();
+    for (i = 0; i < TEST_TIMER_COUNT; i++)
+    {
+        if (timeru_deleteTimer(&aTimerHdl_l[i]) != kErrorOk)
+            errorCount++;
+    }
+    deleteTime = getTimeNs() - deleteTime;
+
+    CU_ASSERT_EQUAL(errorCount, 0);
+    CU_ASSERT_EQUAL(timeruInstance_g.activeCount, 0);
+
+    printf("\n    %u timers\n", TEST_TIMER_COUNT);
+    printf("    set:    %8.1f ns/timer\n", (double)setTime / TEST_TIMER_COUNT);
+    printf("    modify: %8.1f ns/timer\n", (double)modifyTime / TEST_TIMER_COUNT);
+    printf("    delete: %8.1f ns/timer\n", (double)deleteTime / TEST_TIMER_COUNT);
+
+    CU_ASSERT_EQUAL(timeru_exit(), kErrorOk);
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get timeout of a test timer
+
+The function spreads the timeouts of the test timers pseudo-randomly over the
+range of the timer wheel.
+
+\param[in]      timer_p             Number of the timer.
+\param[in]      seed_p              Seed selecting the sequence of timeouts.
+
+\return The function returns the timeout in milliseconds.
+*/
+//------------------------------------------------------------------------------
+static ULONG getTimeout(UINT timer_p, UINT seed_p)
+{
+    UINT32  hash;
+
+    hash = ((UINT32)timer_p + 1) * 2654435761U * seed_p;
+
+    return TEST_MIN_TIMEOUT + (hash % TEST_TIMEOUT_RANGE);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Count timers of the timer wheel
+
+The function counts the timers linked into the slots of all wheel levels and
+checks that every timer refers to the slot it is linked into.
+
+\return The function returns the number of timers in the wheel.
+*/
+//------------------------------------------------------------------------------
+static UINT countWheelTimers(void)
+{
+    tTimeruData*    pTimer;
+    UINT            level;
+    UINT            index;
+    UINT            count = 0;
+
+    pthread_mutex_lock(&timeruInstance_g.mutex);
+
+    for (index = 0; index < TIMERU_WHEEL_ROOT_SIZE; index++)
+    {
+        for (pTimer = timeruInstance_g.apRootSlot[index]; pTimer != NULL; pTimer = pTimer->pNextInSlot)
+        {
+            CU_ASSERT(pTimer->fActive);
+            CU_ASSERT(pTimer->ppSlot == &timeruInstance_g.apRootSlot[index]);
+            count++;
+        }
+    }
+
+    for (level = 0; level < TIMERU_WHEEL_LEVEL_COUNT; level++)
+    {
+        for (index = 0; index < TIMERU_WHEEL_LEVEL_SIZE; index++)
+        {
+            for (pTimer = timeruInstance_g.aapLevelSlot[level][index]; pTimer != NULL; pTimer = pTimer->pNextInSlot)
+            {
+                CU_ASSERT(pTimer->fActive);
+                CU_ASSERT(pTimer->ppSlot == &timeruInstance_g.aapLevelSlot[level][index]);
+                count++;
+            }
+        }
+    }
+
+    pthread_mutex_unlock(&timeruInstance_g.mutex);
+
+    return count;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get current time
+
+\return The function returns the time of CLOCK_MONOTONIC in nanoseconds.
+*/
+//------------------------------------------------------------------------------
+static ULONGLONG getTimeNs(void)
+{
+    struct timespec time;
+
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return ((ULONGLONG)time.tv_sec * 1000000000ULL) + (ULONGLONG)time.tv_nsec;
+}